@@ -81,6 +81,42 @@ de._orig_init = de.__init__
 de.__init__ = _de_ctor
 
 
+def _de_async_ctor(
+        self,
+        gen=100,
+        f=0.8,
+        cr=0.9,
+        variant=2,
+        ftol=1e-6,
+        xtol=1e-6,
+        threads=0,
+        screen_output=False):
+    """
+    Constructs an asynchronous steady-state Differential Evolution algorithm. Trial vectors are evaluated
+    in parallel and each one replaces its parent as soon as its evaluation is over. Use this version for
+    problems whose evaluation is expensive and has a widely varying cost.
+
+    USAGE: algorithm.de_async(gen=100, f=0.8, cr=0.9, variant=2, ftol=1e-6, xtol=1e-6, threads=0, screen_output = False)
+
+    * gen: number of generations (function evaluations divided by the population size)
+    * f, cr, variant, ftol, xtol: as in algorithm.de
+    * threads: number of worker threads (0 uses all the hardware threads)
+    """
+    # We set the defaults or the kwargs
+    arg_list = []
+    arg_list.append(gen)
+    arg_list.append(f)
+    arg_list.append(cr)
+    arg_list.append(variant)
+    arg_list.append(ftol)
+    arg_list.append(xtol)
+    arg_list.append(threads)
+    self._orig_init(*arg_list)
+    self.screen_output = screen_output
+de_async._orig_init = de_async.__init__
+de_async.__init__ = _de_async_ctor
+
+
 def _jde_ctor(
         self,
         gen=100,
@@ -234,7 +270,9 @@ def _pso_ctor(
         vcoeff=0.5,
         variant=5,
         neighb_type=2,
-        neighb_param=4):
+        neighb_param=4,
+        synchronous=False,
+        threads=1):
     """
     Constructs a Particle Swarm Optimization (steady-state). The position update is applied
     immediately after the velocity update
@@ -243,7 +281,7 @@ def _pso_ctor(
 
     REF (for variants 1-4): Kennedy, J.; Eberhart, R. (1995). "Particle Swarm Optimization". Proceedings of IEEE International Conference on Neural Networks. IV. pp. 1942?1948.
 
-    USAGE: algorithm.pso(gen=1, omega = 0.7298, eta1 = 2.05, eta2 = 2.05, vcoeff = 0.5, variant = 5, neighb_type = 2, neighb_param = 4)
+    USAGE: algorithm.pso(gen=1, omega = 0.7298, eta1 = 2.05, eta2 = 2.05, vcoeff = 0.5, variant = 5, neighb_type = 2, neighb_param = 4, synchronous = False, threads = 1)
 
     * gen: number of generations
     * omega: constriction factor (or particle inertia weight) in [0,1]
@@ -271,6 +309,8 @@ def _pso_ctor(
             to a radius of k = neighb_param / 2 in the ring. If the Randomly-varying neighbourhood topology
             is selected, neighb_param represents each particle's maximum outdegree in the swarm topology.
             The minimum outdegree is 1 (the particle always connects back to itself).
+    * synchronous: if True, the whole swarm moves before being evaluated as a batch
+    * threads: number of threads evaluating the swarm in synchronous mode (0 uses all the hardware threads)
     """
     # We set the defaults or the kwargs
     arg_list = []
@@ -282,11 +322,51 @@ def _pso_ctor(
     arg_list.append(variant)
     arg_list.append(neighb_type)
     arg_list.append(neighb_param)
+    arg_list.append(synchronous)
+    arg_list.append(threads)
     self._orig_init(*arg_list)
 pso._orig_init = pso.__init__
 pso.__init__ = _pso_ctor
 
 
+def _pso_async_ctor(
+        self,
+        gen=1,
+        omega=0.7298,
+        eta1=2.05,
+        eta2=2.05,
+        vcoeff=0.5,
+        variant=5,
+        neighb_type=2,
+        neighb_param=4,
+        threads=0):
+    """
+    Constructs an asynchronous steady-state Particle Swarm Optimization. Particles' positions are evaluated
+    in parallel and each particle is moved again as soon as its evaluation is over. Use this version for
+    problems whose evaluation is expensive and has a widely varying cost.
+
+    USAGE: algorithm.pso_async(gen=1, omega = 0.7298, eta1 = 2.05, eta2 = 2.05, vcoeff = 0.5, variant = 5, neighb_type = 2, neighb_param = 4, threads = 0)
+
+    * gen: number of generations (function evaluations divided by the swarm size)
+    * omega, eta1, eta2, vcoeff, variant, neighb_type, neighb_param: as in algorithm.pso
+    * threads: number of worker threads (0 uses all the hardware threads)
+    """
+    # We set the defaults or the kwargs
+    arg_list = []
+    arg_list.append(gen)
+    arg_list.append(omega)
+    arg_list.append(eta1)
+    arg_list.append(eta2)
+    arg_list.append(vcoeff)
+    arg_list.append(variant)
+    arg_list.append(neighb_type)
+    arg_list.append(neighb_param)
+    arg_list.append(threads)
+    self._orig_init(*arg_list)
+pso_async._orig_init = pso_async.__init__
+pso_async.__init__ = _pso_async_ctor
+
+
 def _pso_gen_ctor(
         self,
         gen=1,
@@ -296,12 +376,13 @@ def _pso_gen_ctor(
         vcoeff=0.5,
         variant=5,
         neighb_type=2,
-        neighb_param=4):
+        neighb_param=4,
+        threads=1):
     """
     Constructs a Particle Swarm Optimization (generational). The position update is applied
     only at the end of an entire loop over the population (swarm). Use this version for stochastic problems.
 
-    USAGE: algorithm.pso_gen(gen=1, omega = 0.7298, eta1 = 2.05, eta2 = 2.05, vcoeff = 0.5, variant = 5, neighb_type = 2, neighb_param = 4)
+    USAGE: algorithm.pso_gen(gen=1, omega = 0.7298, eta1 = 2.05, eta2 = 2.05, vcoeff = 0.5, variant = 5, neighb_type = 2, neighb_param = 4, threads = 1)
 
     * gen: number of generations
     * omega: constriction factor (or particle inertia weight) in [0,1]
@@ -329,6 +410,7 @@ def _pso_gen_ctor(
             to a radius of k = neighb_param / 2 in the ring. If the Randomly-varying neighbourhood topology
             is selected, neighb_param represents each particle's maximum outdegree in the swarm topology.
             The minimum outdegree is 1 (the particle always connects back to itself).
+    * threads: number of threads evaluating the swarm (0 uses all the hardware threads)
     """
     # We set the defaults or the kwargs
     arg_list = []
@@ -340,6 +422,7 @@ def _pso_gen_ctor(
     arg_list.append(variant)
     arg_list.append(neighb_type)
     arg_list.append(neighb_param)
+    arg_list.append(threads)
     self._orig_init(*arg_list)
 pso_gen._orig_init = pso_gen.__init__
 pso_gen.__init__ = _pso_gen_ctor
@@ -800,11 +883,13 @@ def _sa_corana_ctor(
         Tf=.1,
         steps=1,
         bin_size=20,
-        range=1):
+        range=1,
+        chains=1,
+        threads=1):
     """
     Constructs Corana's Simulated Annealing
 
-    USAGE: algorithm.sa_corana(iter = 10000, Ts = 10, Tf = .1, steps = 1, bin_size = 20, range = 1)
+    USAGE: algorithm.sa_corana(iter = 10000, Ts = 10, Tf = .1, steps = 1, bin_size = 20, range = 1, chains = 1, threads = 1)
 
     NOTE: as this version of simulated annealing loops through the chromosome, the iter number needs to be selected
     large enough to allow the temperature schedule to actuallt make sense. For example if your problem has D dimensions
@@ -816,6 +901,9 @@ def _sa_corana_ctor(
     * steps: number of steps adjustments
     * bin_size: size of the bin used to evaluate the step adjustment
     * range: initial size of the neighbourhood (in [0,1])
+    * chains: number of chains. With more than one chain, the chains start from the best individuals and run
+      in parallel tempering mode, exchanging their states between neighbouring temperatures
+    * threads: number of threads running the chains (0 means as many as the hardware supports)
     """
     # We set the defaults or the kwargs
     arg_list = []
@@ -825,6 +913,8 @@ def _sa_corana_ctor(
     arg_list.append(steps)
     arg_list.append(bin_size)
     arg_list.append(range)
+    arg_list.append(chains)
+    arg_list.append(threads)
     self._orig_init(*arg_list)
 sa_corana._orig_init = sa_corana.__init__
 sa_corana.__init__ = _sa_corana_ctor
@@ -868,17 +958,19 @@ sea._orig_init = sea.__init__
 sea.__init__ = _sea_ctor
 
 
-def _ms_ctor(self, algorithm=None, iter=1):
+def _ms_ctor(self, algorithm=None, iter=1, threads=1):
     """
     Constructs a Multistart Algorithm
 
-    USAGE: algorithm.ms(algorithm = algorithm.de(), iter = 1)
+    USAGE: algorithm.ms(algorithm = algorithm.de(), iter = 1, threads = 1)
 
     NOTE: starting from pop1, at each iteration a random pop2 is evolved
     with the selected algorithm and its final best replaces the worst of pop1
 
     * algorithm: PyGMO algorithm to be multistarted
     * iter: number of multistarts
+    * threads: number of multistarts run at the same time (0 for as many as the hardware supports).
+            With more than one thread, the result does not depend on the number of threads
 
     """
     # We set the defaults or the kwargs
@@ -887,6 +979,7 @@ def _ms_ctor(self, algorithm=None, iter=1):
         algorithm = _algorithm.jde()
     arg_list.append(algorithm)
     arg_list.append(iter)
+    arg_list.append(threads)
     self._orig_init(*arg_list)
 ms._orig_init = ms.__init__
 ms.__init__ = _ms_ctor
@@ -921,11 +1014,18 @@ cs._orig_init = cs.__init__
 cs.__init__ = _cs_ctor
 
 
-def _mbh_ctor(self, algorithm=None, stop=5, perturb=5e-2, screen_output=False):
+def _mbh_ctor(
+        self,
+        algorithm=None,
+        stop=5,
+        perturb=5e-2,
+        chains=1,
+        threads=1,
+        screen_output=False):
     """
     Constructs a Monotonic Basin Hopping Algorithm (generalized to accept any algorithm)
 
-    USAGE: algorithm.mbh(algorithm = algorithm.cs(), stop = 5, perturb = 5e-2);
+    USAGE: algorithm.mbh(algorithm = algorithm.cs(), stop = 5, perturb = 5e-2, chains = 1, threads = 1);
 
     NOTE: Starting from pop, algorithm is applied to the perturbed pop returning pop2. If pop2 is better than
     pop then pop=pop2 and a counter is reset to zero. If pop2 is not better the counter is incremented. If
@@ -935,6 +1035,10 @@ def _mbh_ctor(self, algorithm=None, stop=5, perturb=5e-2, screen_output=False):
     * stop: number of no improvements before halting the optimization
     * perturb: non-dimentional perturbation width (can be a list, in which case
             it has to have the same dimension of the problem mbh will be applied to)
+    * chains: number of perturbed populations evolved at each iteration, the best one being
+            compared to pop
+    * threads: number of threads running the chains (0 for as many as the hardware supports).
+            With more than one thread, the result does not depend on the number of threads
     * screen_output: activates screen output of the algorithm (do not use in archipealgo, otherwise the screen will be flooded with
     * 		 different island outputs)
     """
@@ -945,6 +1049,8 @@ def _mbh_ctor(self, algorithm=None, stop=5, perturb=5e-2, screen_output=False):
     arg_list.append(algorithm)
     arg_list.append(stop)
     arg_list.append(perturb)
+    arg_list.append(chains)
+    arg_list.append(threads)
     self._orig_init(*arg_list)
     self.screen_output = screen_output
 mbh._orig_init = mbh.__init__
@@ -1181,11 +1287,15 @@ def _cmaes_ctor(
         ftol=1e-6,
         xtol=1e-6,
         memory=False,
+        variant="full",
+        n_paths=-1,
+        restart="none",
+        threads=1,
         screen_output=False):
     """
     Constructs a Covariance Matrix Adaptation Evolutionary Strategy (C++)
 
-    USAGE: algorithm.cmaes(gen = 500, cc = -1, cs = -1, c1 = -1, cmu = -1, sigma0=0.5, ftol = 1e-6, xtol = 1e-6, memory = False, screen_output = False)
+    USAGE: algorithm.cmaes(gen = 500, cc = -1, cs = -1, c1 = -1, cmu = -1, sigma0=0.5, ftol = 1e-6, xtol = 1e-6, memory = False, variant = "full", n_paths = -1, restart = "none", threads = 1, screen_output = False)
 
     NOTE: In our variant of the algorithm, particle memory is used to extract the elite and reinsertion
     is made aggressively ..... getting rid of the worst guy). Also, the bounds of the problem
@@ -1201,9 +1311,36 @@ def _cmaes_ctor(
     * xtol: stopping criteria on the x tolerance
     * ftol: stopping criteria on the f tolerance
     * memory: if True the algorithm internal state is saved and used for the next call
+    * variant: covariance model, one of
+           1. "full"	full covariance matrix (O(N^2) memory, O(N^3) eigen decompositions)
+           2. "separable"	diagonal covariance matrix (sep-CMA-ES, O(N) memory)
+           3. "limited_memory"	limited-memory matrix adaptation (LM-MA-ES, O(N n_paths) memory)
+    * n_paths: number of evolution paths of the "limited_memory" variant, if -1 it is set to 4 + floor(3 ln N)
+    * restart: restart strategy, one of
+           1. "none"	a single run of gen generations
+           2. "ipop"	restarts doubling the offspring size, for gen * pop size evaluations
+           3. "bipop"	restarts alternating large and small offspring sizes, for gen * pop size evaluations
+    * threads: number of threads evaluating the offspring (0 uses all the hardware threads)
     * screen_output: activates screen output of the algorithm (do not use in archipealgo, otherwise the screen will be flooded with
     * 		 different island outputs)
     """
+
+    from PyGMO.algorithm._algorithm import _cmaes_variant_type, _cmaes_restart_type
+
+    def variant_type(x):
+        return {
+            "full": _cmaes_variant_type.FULL,
+            "separable": _cmaes_variant_type.SEPARABLE,
+            "limited_memory": _cmaes_variant_type.LIMITED_MEMORY
+        }[x]
+
+    def restart_type(x):
+        return {
+            "none": _cmaes_restart_type.NONE,
+            "ipop": _cmaes_restart_type.IPOP,
+            "bipop": _cmaes_restart_type.BIPOP
+        }[x]
+
     # We set the defaults or the kwargs
     arg_list = []
     arg_list.append(gen)
@@ -1215,6 +1352,10 @@ def _cmaes_ctor(
     arg_list.append(ftol)
     arg_list.append(xtol)
     arg_list.append(memory)
+    arg_list.append(variant_type(variant))
+    arg_list.append(n_paths)
+    arg_list.append(restart_type(restart))
+    arg_list.append(threads)
     self._orig_init(*arg_list)
     self.screen_output = screen_output
 cmaes._orig_init = cmaes.__init__
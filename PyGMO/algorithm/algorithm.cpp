@@ -77,10 +77,7 @@ struct meta_algorithm_pickle_suite : boost::python::pickle_suite
 	}
 	static boost::python::tuple getstate(const Algorithm &algo)
 	{
-		std::stringstream ss;
-		boost::archive::text_oarchive oa(ss);
-		oa << algo;
-		return boost::python::make_tuple(ss.str(),algo.get_algorithm());
+		return boost::python::make_tuple(py_binary_dumps(algo),algo.get_algorithm());
 	}
 	static void setstate(Algorithm &algo, boost::python::tuple state)
 	{
@@ -89,10 +86,7 @@ struct meta_algorithm_pickle_suite : boost::python::pickle_suite
 			PyErr_SetObject(PyExc_ValueError,("expected 2-item tuple in call to __setstate__; got %s" % state).ptr());
 			throw_error_already_set();
 		}
-		const std::string str = extract<std::string>(state[0]);
-		std::stringstream ss(str);
-		boost::archive::text_iarchive ia(ss);
-		ia >> algo;
+		py_pickle_loads(algo,state[0]);
 		const algorithm::base_ptr internal_algo = boost::python::extract<algorithm::base_ptr>(state[1]);
 		algo.set_algorithm(*internal_algo);
 	}
@@ -196,6 +190,16 @@ BOOST_PYTHON_MODULE(_algorithm) {
 		.value("BEST20", algorithm::sga::selection::BEST20)
 		.value("ROULETTE", algorithm::sga::selection::ROULETTE);
 
+	enum_<algorithm::cmaes::variant::type>("_cmaes_variant_type")
+		.value("FULL", algorithm::cmaes::variant::FULL)
+		.value("SEPARABLE", algorithm::cmaes::variant::SEPARABLE)
+		.value("LIMITED_MEMORY", algorithm::cmaes::variant::LIMITED_MEMORY);
+
+	enum_<algorithm::cmaes::restart::type>("_cmaes_restart_type")
+		.value("NONE", algorithm::cmaes::restart::NONE)
+		.value("IPOP", algorithm::cmaes::restart::IPOP)
+		.value("BIPOP", algorithm::cmaes::restart::BIPOP);
+
 	enum_<algorithm::vega::mutation::type>("_vega_mutation_type")
 		.value("RANDOM", algorithm::vega::mutation::RANDOM)
 		.value("GAUSSIAN", algorithm::vega::mutation::GAUSSIAN);
@@ -248,7 +252,7 @@ BOOST_PYTHON_MODULE(_algorithm) {
 
 	// CMAES
 	algorithm_wrapper<algorithm::cmaes>("cmaes","Covariance Matrix Adaptation Evolutionary Startegy")
-		.def(init<optional<int, double, double, double, double, double, double, double, bool> >())
+		.def(init<optional<int, double, double, double, double, double, double, double, bool, algorithm::cmaes::variant::type, int, algorithm::cmaes::restart::type, unsigned int> >())
 		.add_property("gen",&algorithm::cmaes::get_gen,&algorithm::cmaes::set_gen)
 		.add_property("cc",&algorithm::cmaes::get_cc,&algorithm::cmaes::set_cc)
 		.add_property("cs",&algorithm::cmaes::get_cs,&algorithm::cmaes::set_cs)
@@ -256,7 +260,11 @@ BOOST_PYTHON_MODULE(_algorithm) {
 		.add_property("cmu",&algorithm::cmaes::get_cmu,&algorithm::cmaes::set_cmu)
 		.add_property("sigma",&algorithm::cmaes::get_sigma,&algorithm::cmaes::set_sigma)
 		.add_property("ftol",&algorithm::cmaes::get_ftol,&algorithm::cmaes::set_ftol)
-		.add_property("xtol",&algorithm::cmaes::get_xtol,&algorithm::cmaes::set_xtol);
+		.add_property("xtol",&algorithm::cmaes::get_xtol,&algorithm::cmaes::set_xtol)
+		.add_property("variant",&algorithm::cmaes::get_variant)
+		.add_property("n_paths",&algorithm::cmaes::get_n_paths)
+		.add_property("restart",&algorithm::cmaes::get_restart)
+		.add_property("threads",&algorithm::cmaes::get_threads,&algorithm::cmaes::set_threads);
 
 	// Monte-carlo.
 	algorithm_wrapper<algorithm::monte_carlo>("monte_carlo","Monte-Carlo search.")
@@ -285,8 +293,8 @@ BOOST_PYTHON_MODULE(_algorithm) {
 	
 	// Monotonic Basin Hopping.
 	algorithm_wrapper<algorithm::mbh>("mbh","Monotonic Basin Hopping.")
-		.def(init<optional<const algorithm::base &,int, double> >())
-		.def(init<optional<const algorithm::base &,int, const std::vector<double> &> >())
+		.def(init<optional<const algorithm::base &,int, double, unsigned int, unsigned int> >())
+		.def(init<optional<const algorithm::base &,int, const std::vector<double> &, unsigned int, unsigned int> >())
 		.add_property("algorithm",&algorithm::mbh::get_algorithm,&algorithm::mbh::set_algorithm);
 	
 	// Constraints immune system.
@@ -303,7 +311,7 @@ BOOST_PYTHON_MODULE(_algorithm) {
 	
 	// Multistart.
 	algorithm_wrapper<algorithm::ms>("ms","Multistart.")
-		.def(init<const algorithm::base &, int>())
+		.def(init<const algorithm::base &, int, optional<unsigned int> >())
 		.add_property("algorithm",&algorithm::ms::get_algorithm,&algorithm::ms::set_algorithm);
 
 	// Constraints Co-Evolution.
@@ -318,11 +326,15 @@ BOOST_PYTHON_MODULE(_algorithm) {
 
 	// Particle Swarm Optimization (Steady state)
 	algorithm_wrapper<algorithm::pso>("pso", "Particle Swarm Optimization (steady-state)")
-		.def(init<optional<int,double, double, double, double, int, int, int> >());
+		.def(init<optional<int,double, double, double, double, int, int, int, bool, unsigned int> >());
+
+	// Particle Swarm Optimization (asynchronous steady state)
+	algorithm_wrapper<algorithm::pso_async>("pso_async", "Particle Swarm Optimization (asynchronous steady-state)")
+		.def(init<optional<int,double, double, double, double, int, int, int, unsigned int> >());
 
 	// Particle Swarm Optimization (generational)
 	algorithm_wrapper<algorithm::pso_generational>("pso_gen", "Particle Swarm Optimization (generational)")
-		.def(init<optional<int,double, double, double, double, int, int, int> >());
+		.def(init<optional<int,double, double, double, double, int, int, int, unsigned int> >());
 
 	// Particle Swarm Optimization (generational with racing mechanism)
 	algorithm_wrapper<algorithm::pso_generational_racing>("pso_gen_racing", "Particle Swarm Optimization (generational with racing)")
@@ -400,6 +412,10 @@ BOOST_PYTHON_MODULE(_algorithm) {
 		.add_property("cr",&algorithm::de::get_cr,&algorithm::de::set_cr)
 		.add_property("f",&algorithm::de::get_f,&algorithm::de::set_f);
 
+	// Differential evolution (asynchronous steady state)
+	algorithm_wrapper<algorithm::de_async>("de_async", "Asynchronous steady-state differential evolution algorithm.\n")
+		.def(init<optional<int,const double &, const double &, int, double, double, unsigned int> >());
+
 	// Differential evolution (jDE)
 	algorithm_wrapper<algorithm::jde>("jde", "Self-Adaptive Differential Evolution Algorithm: jDE.\n")
 		.def( init<optional<int, int, int, double, double, bool> >());
@@ -414,7 +430,7 @@ BOOST_PYTHON_MODULE(_algorithm) {
 		
 	// Simulated annealing, Corana's version.
 	algorithm_wrapper<algorithm::sa_corana>("sa_corana","Simulated annealing, Corana's version with adaptive neighbourhood.")
-		.def(init<optional<int, const double &, const double &, int,int,const double &> >());
+		.def(init<optional<int, const double &, const double &, int,int,const double &, unsigned int, unsigned int> >());
 
 	// GSL algorithms.
 	#ifdef PAGMO_ENABLE_GSL
@@ -3,6 +3,7 @@ from PyGMO.core._core import *
 import threading as _threading
 import signal as _signal
 import os as _os
+import pickle as _pickle
 
 __doc__ = 'PyGMO core module.'
 __all__ = [
@@ -137,13 +138,15 @@ local_island.__original_init__ = local_island.__init__
 local_island.__init__ = _generic_island_ctor
 
 # This is the function that will be called by the separate process
-# spawned from py_island.
+# spawned from py_island. The evolved population is sent back already pickled
+# with the highest protocol, so that the binary state of the C++ objects is
+# not re-encoded by the queue.
 
 
 def _process_target(q, a, p):
     try:
         tmp = a.evolve(p)
-        q.put(tmp)
+        q.put(_pickle.dumps(tmp, _pickle.HIGHEST_PROTOCOL))
     except BaseException as e:
         q.put(e)
 
@@ -175,7 +178,7 @@ class py_island(base_island):
                 process.join()
             if isinstance(retval, BaseException):
                 raise retval
-            return retval
+            return _pickle.loads(retval)
         except BaseException as e:
             print('Exception caught during evolution:')
             print(e)
@@ -574,6 +577,59 @@ population._orig_race = population.race
 population.race = _pop_race
 
 
+
+def _pop_get_block(self, block):
+    from numpy import frombuffer, float64
+    buf, rows, cols = block
+    return frombuffer(buf, dtype=float64).reshape(rows, cols)
+
+
+def _pop_get_xs(self):
+    """
+    Returns the decision vectors of all individuals as a read-only numpy array (one row per individual)
+
+    USAGE: xs = pop.get_xs()
+
+    The vectors are copied once, into the memory the array is a view of. Prefer this to a loop over pop[i].cur_x when
+    accessing many individuals.
+    """
+    return _pop_get_block(self, self._get_x_block())
+
+
+def _pop_get_fs(self):
+    """
+    Returns the fitness vectors of all individuals as a read-only numpy array (one row per individual)
+
+    USAGE: fs = pop.get_fs()
+    """
+    return _pop_get_block(self, self._get_f_block())
+
+
+def _pop_get_cs(self):
+    """
+    Returns the constraint vectors of all individuals as a read-only numpy array (one row per individual)
+
+    USAGE: cs = pop.get_cs()
+    """
+    return _pop_get_block(self, self._get_c_block())
+
+
+def _pop_set_xs(self, xs):
+    """
+    Sets the decision vectors of all individuals, evaluating them with a single call to the batch objective function
+
+    USAGE: pop.set_xs(xs)
+
+    * xs: matrix (e.g., numpy array or list of lists) with one row per individual
+    """
+    from numpy import ascontiguousarray, float64
+    self._set_x_block(ascontiguousarray(xs, dtype=float64))
+
+population.get_xs = _pop_get_xs
+population.get_fs = _pop_get_fs
+population.get_cs = _pop_get_cs
+population.set_xs = _pop_set_xs
+
 def _pop_repair(self, idx, repair_algorithm):
     """
     Repairs the individual at the given position
@@ -43,7 +43,9 @@
 #include <boost/python/overloads.hpp>
 #include <boost/utility.hpp> // For boost::noncopyable.
 #include <boost/array.hpp>
+#include <algorithm>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include "../../src/algorithm/base.h"
@@ -135,6 +137,62 @@ inline static void population_set_x(population &pop, int n, const decision_vecto
 	pop.set_x(boost::numeric_cast<population::size_type>(n),x);
 }
 
+// Copy the vectors pointed to by Member of all individuals, each of size dim, in a single bytes object
+// holding a row-major matrix of doubles. Returns (bytes, rows, columns), to be viewed from Python with numpy.frombuffer()
+// (which does not copy and gives a read-only array, as bytes are immutable).
+template <std::vector<double> population::individual_type::*Member>
+static inline tuple population_get_block(const population &pop, std::vector<double>::size_type dim)
+{
+	const population::size_type n = pop.size();
+	handle<> buf(PyBytes_FromStringAndSize(NULL,boost::numeric_cast<Py_ssize_t>(n * dim * sizeof(double))));
+	double *data = reinterpret_cast<double *>(PyBytes_AsString(buf.get()));
+	for (population::size_type i = 0; i < n; ++i) {
+		const std::vector<double> &v = pop.get_individual(i).*Member;
+		pagmo_assert(v.size() == dim);
+		std::copy(v.begin(),v.end(),data + i * dim);
+	}
+	return make_tuple(object(buf),n,dim);
+}
+
+inline static tuple population_get_x_block(const population &pop)
+{
+	return population_get_block<&population::individual_type::cur_x>(pop,pop.problem().get_dimension());
+}
+
+inline static tuple population_get_f_block(const population &pop)
+{
+	return population_get_block<&population::individual_type::cur_f>(pop,pop.problem().get_f_dimension());
+}
+
+inline static tuple population_get_c_block(const population &pop)
+{
+	return population_get_block<&population::individual_type::cur_c>(pop,pop.problem().get_c_dimension());
+}
+
+// Set all the decision vectors from an object exporting a C-contiguous buffer of doubles (e.g., a NumPy array of floats),
+// holding a size() x dimension matrix.
+static inline void population_set_x_block(population &pop, object block)
+{
+	Py_buffer view;
+	if (PyObject_GetBuffer(block.ptr(),&view,PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+		throw_error_already_set();
+	}
+	const std::vector<double>::size_type dim = pop.problem().get_dimension();
+	if ((view.format && std::string(view.format) != "d") || view.itemsize != sizeof(double) ||
+		view.len != boost::numeric_cast<Py_ssize_t>(pop.size() * dim * sizeof(double)))
+	{
+		PyBuffer_Release(&view);
+		pagmo_throw(value_error,"the decision vectors must be a C-contiguous matrix of doubles with one row per individual");
+	}
+	const double *data = static_cast<const double *>(view.buf);
+	std::vector<decision_vector> xs(pop.size());
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		xs[i].assign(data + i * dim,data + (i + 1) * dim);
+	}
+	PyBuffer_Release(&view);
+	pop.set_xs(xs);
+}
+
 inline static void population_set_v(population &pop, int n, const decision_vector &v)
 {
 	pop.set_v(boost::numeric_cast<population::size_type>(n),v);
@@ -153,10 +211,7 @@ struct __PAGMO_VISIBLE population_pickle_suite : boost::python::pickle_suite
 	}
 	static boost::python::tuple getstate(const population &pop)
 	{
-		std::stringstream ss;
-		boost::archive::text_oarchive oa(ss);
-		oa << pop;
-		return boost::python::make_tuple(ss.str(),pop.problem().clone());
+		return boost::python::make_tuple(py_binary_dumps(pop),pop.problem().clone());
 	}
 	static void setstate(population &pop, boost::python::tuple state)
 	{
@@ -165,10 +220,7 @@ struct __PAGMO_VISIBLE population_pickle_suite : boost::python::pickle_suite
 			PyErr_SetObject(PyExc_ValueError,("expected 2-item tuple in call to __setstate__; got %s" % state).ptr());
 			throw_error_already_set();
 		}
-		const std::string str = extract<std::string>(state[0]);
-		std::stringstream ss(str);
-		boost::archive::text_iarchive ia(ss);
-		ia >> pop;
+		py_pickle_loads(pop,state[0]);
 		const problem::base_ptr prob = boost::python::extract<problem::base_ptr>(state[1]);
 		population_access::get_problem_ptr(pop) = prob->clone();
 	}
@@ -183,10 +235,7 @@ struct __PAGMO_VISIBLE island_pickle_suite : boost::python::pickle_suite
 	}
 	static boost::python::tuple getstate(const Island &isl)
 	{
-		std::stringstream ss;
-		boost::archive::text_oarchive oa(ss);
-		oa << isl;
-		return boost::python::make_tuple(ss.str(),isl.get_algorithm(),isl.get_population());
+		return boost::python::make_tuple(py_binary_dumps(isl),isl.get_algorithm(),isl.get_population());
 	}
 	static void setstate(Island &isl, boost::python::tuple state)
 	{
@@ -195,10 +244,7 @@ struct __PAGMO_VISIBLE island_pickle_suite : boost::python::pickle_suite
 			PyErr_SetObject(PyExc_ValueError,("expected 3-item tuple in call to __setstate__; got %s" % state).ptr());
 			throw_error_already_set();
 		}
-		const std::string str = extract<std::string>(state[0]);
-		std::stringstream ss(str);
-		boost::archive::text_iarchive ia(ss);
-		ia >> isl;
+		py_pickle_loads(isl,state[0]);
 		const algorithm::base_ptr algo = boost::python::extract<algorithm::base_ptr>(state[1]);
 		isl.set_algorithm(*algo);
 		const population pop = boost::python::extract<population>(state[2]);
@@ -214,10 +260,7 @@ struct __PAGMO_VISIBLE archipelago_pickle_suite : boost::python::pickle_suite
 	}
 	static boost::python::tuple getstate(const archipelago &archi)
 	{
-		std::stringstream ss;
-		boost::archive::text_oarchive oa(ss);
-		oa << archi;
-		return boost::python::make_tuple(ss.str(),archi.get_islands());
+		return boost::python::make_tuple(py_binary_dumps(archi),archi.get_islands());
 	}
 	static void setstate(archipelago &archi, boost::python::tuple state)
 	{
@@ -226,10 +269,7 @@ struct __PAGMO_VISIBLE archipelago_pickle_suite : boost::python::pickle_suite
 			PyErr_SetObject(PyExc_ValueError,("expected 2-item tuple in call to __setstate__; got %s" % state).ptr());
 			throw_error_already_set();
 		}
-		const std::string str = extract<std::string>(state[0]);
-		std::stringstream ss(str);
-		boost::archive::text_iarchive ia(ss);
-		ia >> archi;
+		py_pickle_loads(archi,state[0]);
 		// Recover seaparately the islands.
 		const std::vector<base_island_ptr> islands = extract<std::vector<base_island_ptr> >(state[1]);
 		pagmo_assert(islands.size() == archi.get_size());
@@ -275,6 +315,8 @@ BOOST_PYTHON_MODULE(_core)
 	REGISTER_CONVERTER(std::vector<base_island_ptr>, variable_capacity_policy);
 	REGISTER_CONVERTER(std::vector<pagmo::algorithm::base_ptr>, variable_capacity_policy);
 	REGISTER_CONVERTER(std::vector<pagmo::problem::base_ptr>, variable_capacity_policy);
+	REGISTER_CONVERTER(std::vector<archipelago::island_telemetry>, variable_capacity_policy);
+	REGISTER_CONVERTER(std::vector<archipelago::migr_edge_telemetry>, variable_capacity_policy);
 	
 #ifdef PAGMO_ENABLE_KEP_TOOLBOX
 	REGISTER_CONVERTER(std::vector<kep_toolbox::planet::planet_ptr>, variable_capacity_policy);
@@ -307,6 +349,10 @@ BOOST_PYTHON_MODULE(_core)
 		.def("get_worst_idx",&population::get_worst_idx,"Get index of worst individual.")
 		.def("set_x", &population_set_x,"Set decision vector of individual at position n.")
 		.def("set_v", &population_set_v,"Set velocity of individual at position n.")
+		.def("_get_x_block", &population_get_x_block)
+		.def("_get_f_block", &population_get_f_block)
+		.def("_get_c_block", &population_get_c_block)
+		.def("_set_x_block", &population_set_x_block)
 		.def("push_back", &population::push_back,"Append individual with given decision vector at the end of the population.")
 		.def("erase", &population::erase, "Erase individual at position")
 		.def("mean_velocity", &population::mean_velocity, "Calculates the mean velocity across particles")
@@ -397,6 +443,7 @@ BOOST_PYTHON_MODULE(_core)
 		.def("set_seeds", &archipelago::set_seeds)
 		.def("evolve", &archipelago::evolve,"Evolve archipelago *n* times.",boost::python::args("n"))
 		.def("evolve_batch", &archipelago::evolve_batch,"Evolve archipelago *n* times in batches of *b* islands.",boost::python::args("n","b"))
+		.def("evolve_pool", &archipelago::evolve_pool,"Evolve archipelago *n* times using a pool of *b* threads.",boost::python::args("n","b"))
 		.def("evolve_t", &archipelago::evolve_t,"Evolve archipelago for at least *n* milliseconds.",boost::python::args("n"))
 		.def("join", &archipelago::join,"Wait for evolution to complete.")
 		.def("interrupt", &archipelago::interrupt,"Interrupt evolution.")
@@ -405,6 +452,9 @@ BOOST_PYTHON_MODULE(_core)
 		.def("set_algorithm", &archipelago_set_algorithm,"Set algorithm on island.")
 		.def("dump_migr_history", &archipelago::dump_migr_history)
 		.def("clear_migr_history", &archipelago::clear_migr_history)
+		.add_property("migr_history_capacity", &archipelago::get_migr_history_capacity, &archipelago::set_migr_history_capacity,
+			"Maximum number of items kept in the migration history.")
+		.def("get_telemetry", &archipelago::get_telemetry,"Get a snapshot of the telemetry. Can be called while the archipelago is evolving.")
 		.def("cpp_loads", &py_cpp_loads<archipelago>,
 			"Load C++ serialized representation from string *str*.\n\n"
 			":Parameters:\n"
@@ -427,4 +477,28 @@ BOOST_PYTHON_MODULE(_core)
 	enum_<archipelago::migration_direction>("migration_direction")
 		.value("source",archipelago::source)
 		.value("destination",archipelago::destination);
+
+	// Archipelago's telemetry.
+	class_<archipelago::island_telemetry>("island_telemetry", "Telemetry of an island. Times are in milliseconds.", no_init)
+		.def_readonly("n_evolutions", &archipelago::island_telemetry::n_evolutions)
+		.def_readonly("fevals", &archipelago::island_telemetry::fevals)
+		.def_readonly("evolution_time", &archipelago::island_telemetry::evolution_time)
+		.def_readonly("last_evolution_time", &archipelago::island_telemetry::last_evolution_time)
+		.def_readonly("migr_accepted", &archipelago::island_telemetry::migr_accepted)
+		.def_readonly("migr_rejected", &archipelago::island_telemetry::migr_rejected)
+		.def_readonly("migr_lock_time", &archipelago::island_telemetry::migr_lock_time)
+		.def_readonly("barrier_time", &archipelago::island_telemetry::barrier_time)
+		.add_property("fevals_per_second", &archipelago::island_telemetry::get_fevals_per_second);
+
+	class_<archipelago::migr_edge_telemetry>("migr_edge_telemetry", "Aggregated migration counters of a topology edge.", no_init)
+		.def_readonly("src", &archipelago::migr_edge_telemetry::src)
+		.def_readonly("dest", &archipelago::migr_edge_telemetry::dest)
+		.def_readonly("n_migrations", &archipelago::migr_edge_telemetry::n_migrations)
+		.def_readonly("n_individuals", &archipelago::migr_edge_telemetry::n_individuals);
+
+	class_<archipelago::telemetry>("telemetry", "Snapshot of the telemetry of an archipelago.", no_init)
+		.add_property("islands", make_getter(&archipelago::telemetry::islands,return_value_policy<return_by_value>()))
+		.add_property("edges", make_getter(&archipelago::telemetry::edges,return_value_policy<return_by_value>()))
+		.def_readonly("migr_history_size", &archipelago::telemetry::migr_history_size)
+		.def_readonly("migr_history_total", &archipelago::telemetry::migr_history_total);
 }
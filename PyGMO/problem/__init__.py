@@ -12,6 +12,7 @@ except ImportError:
     pass
 from PyGMO.problem._problem import _base
 from PyGMO.problem._problem import _base_stochastic
+from PyGMO.problem._problem import _sampling_type as sampling_type
 from PyGMO.problem._example import py_example
 from PyGMO.problem._example import py_example_max
 from PyGMO.problem._example_stochastic import py_example_stochastic
@@ -20,7 +21,7 @@ from PyGMO.problem._mo import *
 from PyGMO.problem._tsp import *
 
 
-# If GSL support is active import mit_sphere
+# If GTOP database support is active import mit_sphere
 try:
     from PyGMO.problem._mit_spheres import visualize as _visualize
     mit_spheres.visualize = _visualize
@@ -68,7 +69,7 @@ try:
     mit_spheres.__init__ = _mit_spheres_ctor
 
     from PyGMO import __version__
-    __version__ = __version__ + "GTOP " + "GSL "
+    __version__ = __version__ + "GTOP "
 
 except:
     pass
@@ -217,19 +218,21 @@ lavor_maculan._orig_init = lavor_maculan.__init__
 lavor_maculan.__init__ = _lavor_maculan_ctor
 
 
-def _lennard_jones_ctor(self, n_atoms=4):
+def _lennard_jones_ctor(self, n_atoms=4, cutoff=0):
     """
     Constructs a Lennard-Jones problem (Box-Constrained Continuous Single-Objective)
 
-    USAGE: problem.lennard_jones(n_atoms=4)
+    USAGE: problem.lennard_jones(n_atoms=4, cutoff=0)
 
     * n_atoms: number of atoms
+    * cutoff: cutoff radius of the potential, which is then truncated and shifted (0 for the exact potential)
     """
 
     # We construct the arg list for the original constructor exposed by
     # boost_python
     arg_list = []
     arg_list.append(n_atoms)
+    arg_list.append(cutoff)
     self._orig_init(*arg_list)
 lennard_jones._orig_init = lennard_jones.__init__
 lennard_jones.__init__ = _lennard_jones_ctor
@@ -444,6 +447,8 @@ def _cec2013_ctor(self, prob_id=1, dim=10, path="input_data/"):
 
     NOTE: this problem requires two files to be put in the path indicated: "M_Dxx.txt" and "shift_data.txt".
     These files can be downloaded from the CEC2013 competition site: http://web.mysites.ntu.edu.sg/epnsugan/PublicSite/Shared%20Documents/CEC2013/cec13-c-code.zip
+    Alternatively, the binary file "cec2013_Dxx.bin" created by problem.cec2013.write_binary_data(path, dim) is
+    memory-mapped. The data is shared by all the problems constructed with the same path and dimension.
 
     USAGE: problem.cec2013(dim = 10, prob_id=1, path="input_data/")
 
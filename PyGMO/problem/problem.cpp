@@ -54,6 +54,14 @@ using namespace pagmo;
 
 
 // wrapper for the find_subsequence method of tsp_cs
+// Return the gradient of the objective function.
+static inline decision_vector objfun_gradient_wrapper(const problem::base &p, const decision_vector &x)
+{
+	decision_vector retval;
+	p.objfun_gradient(retval,x);
+	return retval;
+}
+
 static inline tuple find_subsequence_wrapper_cs(const problem::tsp_cs& p, const decision_vector& tour)
 {
 	double retval_p, retval_l;
@@ -89,6 +97,11 @@ static inline class_<Problem,bases<problem::base>,bases<problem::base_stochastic
 	retval.def("cpp_dumps", &py_cpp_dumps<Problem>);
 	retval.add_property("seed",&problem::base_stochastic::get_seed,&problem::base_stochastic::set_seed,
 		"Random seed used in the objective function evaluation.");
+	retval.def("set_sampling",&problem::base_stochastic::set_sampling,(arg("type"),arg("crn") = true,arg("n_threads") = 1u),
+		"Set the Monte-Carlo sampling scheme, the use of common random numbers and the number of threads running the trials.");
+	retval.add_property("sampling",&problem::base_stochastic::get_sampling,"Monte-Carlo sampling scheme.");
+	retval.add_property("common_random_numbers",&problem::base_stochastic::get_common_random_numbers,"True if the samples do not depend on the decision vector.");
+	retval.add_property("sampling_threads",&problem::base_stochastic::get_sampling_threads,"Number of threads running the trials.");
 	return retval;
 }
 
@@ -185,6 +198,7 @@ BOOST_PYTHON_MODULE(_problem) {
 		.def("feasibility_c",&problem::base::feasibility_c,"Determine feasibility of constraint vector.")
 		// Fitness.
 		.def("objfun",return_fitness(&problem::base::objfun),"Compute and return fitness vector.")
+		.def("objfun_gradient",&objfun_gradient_wrapper,"Compute and return the gradient of the objective function.")
 		.def("compare_fitness",&problem::base::compare_fitness,"Compare fitness vectors.")
 		// Virtual methods that can be (re)implemented.
 		.def("get_name",&problem::base::get_name,&problem::python_base::default_get_name)
@@ -285,7 +299,8 @@ BOOST_PYTHON_MODULE(_problem) {
 
 	// Lennard Jones problem.
 	problem_wrapper<problem::lennard_jones>("lennard_jones","Lennard Jones problem.")
-		.def(init<int>());
+		.def(init<int, optional<double> >())
+		.add_property("cutoff",&problem::lennard_jones::get_cutoff,"Cutoff radius of the potential (zero if exact).");
 
 	// Lavor Maculan Potential Energy of Molecules problem.
 	problem_wrapper<problem::lavor_maculan>("lavor_maculan", "Lavor Maculan problem.")
@@ -337,7 +352,8 @@ BOOST_PYTHON_MODULE(_problem) {
 	// CEC2013 Competition Problems.
 	problem_wrapper<problem::cec2013>("cec2013","CEC2013 Competition Problems.")
 		.def(init<unsigned int, problem::base::size_type, const std::string&>())
-		.add_property("origin_shift", &problem::cec2013::origin_shift, "Returns the origin shift used to define the problem");
+		.add_property("origin_shift", &problem::cec2013::origin_shift, "Returns the origin shift used to define the problem")
+		.def("write_binary_data", &problem::cec2013::write_binary_data, "Converts the text input files of the given folder and dimension into a memory-mappable binary file.").staticmethod("write_binary_data");
 
 	// SNOPT toy problem.
 	problem_wrapper<problem::snopt_toyprob>("snopt_toyprob","SNOPT toy problem.");
@@ -362,6 +378,12 @@ BOOST_PYTHON_MODULE(_problem) {
 		.def(init<const std::string &>())
 		.def("pretty", &problem::string_match::pretty);
 
+	// Monte-Carlo sampling schemes of stochastic problems.
+	enum_<problem::base_stochastic::sampling_type>("_sampling_type")
+		.value("SERIAL", problem::base_stochastic::SERIAL)
+		.value("PARALLEL", problem::base_stochastic::PARALLEL)
+		.value("SOBOL", problem::base_stochastic::SOBOL);
+
 	// Travelling salesman problem (TSP) encoding enums
 	enum_<problem::base_tsp::encoding_type>("_tsp_encoding")
 		.value("FULL", problem::base_tsp::FULL)
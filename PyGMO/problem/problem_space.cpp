@@ -95,6 +95,11 @@ static inline class_<Problem,bases<problem::base>,bases<problem::base_stochastic
 	retval.def("cpp_dumps", &py_cpp_dumps<Problem>);
 	retval.add_property("seed",&problem::base_stochastic::get_seed,&problem::base_stochastic::set_seed,
 		"Random seed used in the objective function evaluation.");
+	retval.def("set_sampling",&problem::base_stochastic::set_sampling,(arg("type"),arg("crn") = true,arg("n_threads") = 1u),
+		"Set the Monte-Carlo sampling scheme, the use of common random numbers and the number of threads running the trials.");
+	retval.add_property("sampling",&problem::base_stochastic::get_sampling,"Monte-Carlo sampling scheme.");
+	retval.add_property("common_random_numbers",&problem::base_stochastic::get_common_random_numbers,"True if the samples do not depend on the decision vector.");
+	retval.add_property("sampling_threads",&problem::base_stochastic::get_sampling_threads,"Number of threads running the trials.");
 	return retval;
 }
 
@@ -244,7 +249,6 @@ BOOST_PYTHON_MODULE(_problem_space) {
         .add_property("epochs", make_function(&problem::tsp_ds::get_epochs, return_value_policy<copy_const_reference>()), "epoch schedule")
         .add_property("max_DV", &problem::tsp_ds::get_max_DV );
 
-#ifdef PAGMO_ENABLE_GSL
 	// Spheres Problems
 	stochastic_problem_wrapper<problem::spheres>("mit_spheres", "Spheres problem, a neurocontroller for the MIT test-bed (absolute perception-action)")
 		.def(init< optional<int,int,double,unsigned int, bool, double, std::vector<double> > >())
@@ -257,5 +261,4 @@ BOOST_PYTHON_MODULE(_problem_space) {
 	//	.def(init< optional<int,int,double,unsigned int> >())
 	//	.def("post_evaluate", &problem::spheres_q::post_evaluate)
 	//	.def("simulate", &problem::spheres_q::simulate);
-#endif
 }
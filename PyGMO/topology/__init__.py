@@ -140,8 +140,7 @@ def _erdos_renyi_ctor(self, p=0.1, nodes=0):
     arg_list = []
     arg_list.append(p)
     self._orig_init(*arg_list)
-    for i in range(nodes):
-        self.push_back()
+    self.push_back(nodes)
 erdos_renyi._orig_init = erdos_renyi.__init__
 erdos_renyi.__init__ = _erdos_renyi_ctor
 
@@ -161,8 +160,7 @@ def _barabasi_albert_ctor(self, m0=3, m=3, nodes=0):
     arg_list.append(m0)
     arg_list.append(m)
     self._orig_init(*arg_list)
-    for i in range(nodes):
-        self.push_back()
+    self.push_back(nodes)
 barabasi_albert._orig_init = barabasi_albert.__init__
 barabasi_albert.__init__ = _barabasi_albert_ctor
 
@@ -184,8 +182,7 @@ def _clustered_ba_ctor(self, m0=3, m=3, p=0.5, nodes=0):
     arg_list.append(m)
     arg_list.append(p)
     self._orig_init(*arg_list)
-    for i in range(nodes):
-        self.push_back()
+    self.push_back(nodes)
 clustered_ba._orig_init = clustered_ba.__init__
 clustered_ba.__init__ = _clustered_ba_ctor
 
@@ -209,8 +206,7 @@ def _ageing_clustered_ba_ctor(self, m0=3, m=3, p=0.5, a=1000, nodes=0):
     arg_list.append(p)
     arg_list.append(a)
     self._orig_init(*arg_list)
-    for i in range(nodes):
-        self.push_back()
+    self.push_back(nodes)
 ageing_clustered_ba._orig_init = ageing_clustered_ba.__init__
 ageing_clustered_ba.__init__ = _ageing_clustered_ba_ctor
 
@@ -226,8 +222,7 @@ def _fully_connected_ctor(self, nodes=0):
     # We set the defaults or the kwargs
     arg_list = []
     self._orig_init(*arg_list)
-    for i in range(nodes):
-        self.push_back()
+    self.push_back(nodes)
 fully_connected._orig_init = fully_connected.__init__
 fully_connected.__init__ = _fully_connected_ctor
 
@@ -243,8 +238,7 @@ def _hypercube_ctor(self, nodes=0):
     # We set the defaults or the kwargs
     arg_list = []
     self._orig_init(*arg_list)
-    for i in range(nodes):
-        self.push_back()
+    self.push_back(nodes)
 hypercube._orig_init = hypercube.__init__
 hypercube.__init__ = _hypercube_ctor
 
@@ -260,8 +254,7 @@ def _one_way_ring_ctor(self, nodes=0):
     # We set the defaults or the kwargs
     arg_list = []
     self._orig_init(*arg_list)
-    for i in range(nodes):
-        self.push_back()
+    self.push_back(nodes)
 one_way_ring._orig_init = one_way_ring.__init__
 one_way_ring.__init__ = _one_way_ring_ctor
 
@@ -278,8 +271,7 @@ def _pan_ctor(self, nodes=0):
     # We set the defaults or the kwargs
     arg_list = []
     self._orig_init(*arg_list)
-    for i in range(nodes):
-        self.push_back()
+    self.push_back(nodes)
 pan._orig_init = pan.__init__
 pan.__init__ = _pan_ctor
 
@@ -295,8 +287,7 @@ def _rim_ctor(self, nodes=0):
     # We set the defaults or the kwargs
     arg_list = []
     self._orig_init(*arg_list)
-    for i in range(nodes):
-        self.push_back()
+    self.push_back(nodes)
 rim._orig_init = rim.__init__
 rim.__init__ = _rim_ctor
 
@@ -312,8 +303,7 @@ def _ring_ctor(self, nodes=0):
     # We set the defaults or the kwargs
     arg_list = []
     self._orig_init(*arg_list)
-    for i in range(nodes):
-        self.push_back()
+    self.push_back(nodes)
 ring._orig_init = ring.__init__
 ring.__init__ = _ring_ctor
 
@@ -329,8 +319,7 @@ def _unconnected_ctor(self, nodes=0):
     # We set the defaults or the kwargs
     arg_list = []
     self._orig_init(*arg_list)
-    for i in range(nodes):
-        self.push_back()
+    self.push_back(nodes)
 unconnected._orig_init = unconnected.__init__
 unconnected.__init__ = _unconnected_ctor
 
@@ -90,15 +90,33 @@ BOOST_PYTHON_MODULE(_topology) {
 	typedef void (topology::base::*set_weight_vertex)(const topology::base::vertices_size_type &, double);
 	typedef void (topology::base::*set_weight_all)(double);
 	typedef double (topology::base::*get_weight_double)(const topology::base::vertices_size_type &, const topology::base::vertices_size_type&) const;
+	typedef double (topology::base::*metric_exact)() const;
+	typedef double (topology::base::*metric_sampled)(const topology::base::vertices_size_type &, unsigned int) const;
+	typedef double (topology::base::*metric_seeded)(const topology::base::vertices_size_type &, unsigned int, unsigned int) const;
+	typedef void (topology::base::*push_back_one)();
+	typedef void (topology::base::*push_back_n)(const topology::base::vertices_size_type &);
 
 	class_<topology::base,boost::noncopyable>("_base",no_init)
 		.def("__repr__", &topology::base::human_readable)
 		.add_property("number_of_vertices",&topology::base::get_number_of_vertices)
 		.add_property("number_of_edges",&topology::base::get_number_of_edges)
-		.def("get_average_shortest_path_length",&topology::base::get_average_shortest_path_length,"Calculate average shortest path length.")
-		.def("get_clustering_coefficient",&topology::base::get_clustering_coefficient,"Calculate the clustering coefficient.")
+		.def("get_average_shortest_path_length",metric_exact(&topology::base::get_average_shortest_path_length),"Calculate average shortest path length.")
+		.def("get_average_shortest_path_length",metric_sampled(&topology::base::get_average_shortest_path_length),
+			"Estimate average shortest path length from n_samples source vertices (0 means all), using n_threads threads (0 means hardware concurrency).",
+			(arg("n_samples"),arg("n_threads") = 0u))
+		.def("get_average_shortest_path_length",metric_seeded(&topology::base::get_average_shortest_path_length),
+			"Estimate average shortest path length from n_samples source vertices (0 means all) chosen with the given seed, using n_threads threads (0 means hardware concurrency).",
+			(arg("n_samples"),arg("n_threads"),arg("seed")))
+		.def("get_clustering_coefficient",metric_exact(&topology::base::get_clustering_coefficient),"Calculate the clustering coefficient.")
+		.def("get_clustering_coefficient",metric_sampled(&topology::base::get_clustering_coefficient),
+			"Estimate the clustering coefficient from n_samples vertices (0 means all), using n_threads threads (0 means hardware concurrency).",
+			(arg("n_samples"),arg("n_threads") = 0u))
+		.def("get_clustering_coefficient",metric_seeded(&topology::base::get_clustering_coefficient),
+			"Estimate the clustering coefficient from n_samples vertices (0 means all) chosen with the given seed, using n_threads threads (0 means hardware concurrency).",
+			(arg("n_samples"),arg("n_threads"),arg("seed")))
 		.def("get_degree_distribution",&topology::base::get_degree_distribution,"Calculate the degree distribution.")
-		.def("push_back",&topology::base::push_back,"Add vertex to the topology and connect it.")
+		.def("push_back",push_back_one(&topology::base::push_back),"Add vertex to the topology and connect it.")
+		.def("push_back",push_back_n(&topology::base::push_back),"Add n vertices to the topology and connect them in a single pass.")
 		.def("set_weight",set_weight_edge(&topology::base::set_weight),"Set weight.")
 		.def("set_weight",set_weight_vertex(&topology::base::set_weight),"Set weight.")
 		.def("set_weight",set_weight_all(&topology::base::set_weight),"Set weight.")
@@ -478,7 +478,8 @@ def _bf_approx_ctor(
         gamma=0.25,
         delta_multiplier=0.775,
         initial_delta_coeff=0.1,
-        alpha=0.2):
+        alpha=0.2,
+        threads=1):
     """
     Hypervolume algorithm: Bringmann-Friedrich approximation.
 
@@ -496,6 +497,7 @@ def _bf_approx_ctor(
             * delta_multiplier - factor with which delta diminishes each round
             * initial_delta_coeff - initial coefficient multiplied by the delta at round 0
             * alpha - coefficicient stating how accurately current lowest contributor should be sampled
+            * threads - number of threads sampling the boxes (0 for all the hardware threads), the result does not depend on it
             hv = hypervolume(...) # see 'hypervolume?' for usage
             refpoint = [1.0]*7
             hv.least_contributor(r=refpoint, algorithm=hv_algorithm.bf_approx())
@@ -510,12 +512,13 @@ def _bf_approx_ctor(
     args.append(alpha)
     args.append(initial_delta_coeff)
     args.append(gamma)
+    args.append(threads)
     return self._original_init(*args)
 hv_algorithm.bf_approx._original_init = hv_algorithm.bf_approx.__init__
 hv_algorithm.bf_approx.__init__ = _bf_approx_ctor
 
 
-def _bf_fpras_ctor(self, eps=1e-2, delta=1e-2):
+def _bf_fpras_ctor(self, eps=1e-2, delta=1e-2, threads=1):
     """
     Hypervolume algorithm: Bringmann-Friedrich approximation.
 
@@ -527,6 +530,7 @@ def _bf_fpras_ctor(self, eps=1e-2, delta=1e-2):
     USAGE:
             * eps - accuracy of approximation
             * delta - confidence of approximation
+            * threads - number of threads drawing the samples (0 for all the hardware threads), the result does not depend on it
 
             hv = hypervolume(...) # see 'hypervolume?' for usage
             refpoint = [1.0]*7
@@ -536,6 +540,7 @@ def _bf_fpras_ctor(self, eps=1e-2, delta=1e-2):
     args = []
     args.append(eps)
     args.append(delta)
+    args.append(threads)
     return self._original_init(*args)
 hv_algorithm.bf_fpras._original_init = hv_algorithm.bf_fpras.__init__
 hv_algorithm.bf_fpras.__init__ = _bf_fpras_ctor
@@ -678,7 +683,7 @@ race_pop._orig_set_seed = race_pop.set_seed
 race_pop.set_seed = _race_pop_set_seed
 
 
-def _race_algo_ctor(self, algo_list, probs, pop_size=100, seed=0):
+def _race_algo_ctor(self, algo_list, probs, pop_size=100, seed=0, threads=1):
     """
     Construct the racing object responsible for racing algorithms
 
@@ -686,6 +691,7 @@ def _race_algo_ctor(self, algo_list, probs, pop_size=100, seed=0):
     * probs: Can be a single PyGMO problem or a list of them
     * pop_size: All the algorithms will be evolving internally some random population of this size
     * seed: Seed of the race
+    * threads: Number of threads running the trials of each round (0 to use all the available cores). The outcome of the race does not depend on it
     """
     # We set the defaults or the kwargs
     arg_list = []
@@ -704,6 +710,7 @@ def _race_algo_ctor(self, algo_list, probs, pop_size=100, seed=0):
 
     arg_list.append(pop_size)
     arg_list.append(seed)
+    arg_list.append(threads)
 
     self._orig_init(*arg_list)
 
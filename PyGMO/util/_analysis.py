@@ -216,8 +216,12 @@ class analysis:
             else:
                 raise ValueError(
                     "analysis.sample: method specified is not valid. choose 'sobol', 'lhs', 'faure','halton', 'montecarlo' or 'pop'")
+            # sample the whole set in the unit hypercube at once
+            if method == 'lhs':
+                first = 0
+            block = sampler.generate(first, npoints, 0)
             for i in range(npoints):
-                temp = list(sampler.next())  # sample in the unit hypercube
+                temp = list(block[i * self.dim:(i + 1) * self.dim])
                 for j in range(self.dim):
                     temp[j] = temp[j] * self.ub[j] + \
                         (1 - temp[j]) * self.lb[j]  # resize
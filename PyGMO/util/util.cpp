@@ -67,6 +67,12 @@ class __PAGMO_VISIBLE py_simplex
 		py_simplex(unsigned int dim, unsigned int count) : m_original_class(dim,count) {}
 		std::vector<double> operator ()() {return m_original_class();}
 		std::vector<double> operator ()(unsigned int n) {return m_original_class(n);}
+		std::vector<double> generate(unsigned long long first, unsigned long long n, unsigned int n_threads) const
+		{
+			std::vector<double> retval;
+			m_original_class.generate(retval,first,n,n_threads);
+			return retval;
+		}
 	private:
 		pagmo::util::discrepancy::simplex m_original_class;
 };
@@ -77,16 +83,44 @@ class __PAGMO_VISIBLE py_sobol
 		py_sobol(unsigned int dim, unsigned int count) : m_original_class(dim,count) {}
 		std::vector<double> operator ()() {return m_original_class();}
 		std::vector<double> operator ()(unsigned int n) {return m_original_class(n);}
+		std::vector<double> generate(unsigned long long first, unsigned long long n, unsigned int n_threads) const
+		{
+			std::vector<double> retval;
+			m_original_class.generate(retval,first,n,n_threads);
+			return retval;
+		}
 	private:
 		pagmo::util::discrepancy::sobol m_original_class;
 };
 
+class __PAGMO_VISIBLE py_scrambled_sobol
+{
+	public:
+		py_scrambled_sobol(unsigned int dim, unsigned int count, boost::uint32_t seed) : m_original_class(dim,count,seed) {}
+		std::vector<double> operator ()() {return m_original_class();}
+		std::vector<double> operator ()(unsigned int n) {return m_original_class(n);}
+		std::vector<double> generate(unsigned long long first, unsigned long long n, unsigned int n_threads) const
+		{
+			std::vector<double> retval;
+			m_original_class.generate(retval,first,n,n_threads);
+			return retval;
+		}
+	private:
+		pagmo::util::discrepancy::scrambled_sobol m_original_class;
+};
+
 class __PAGMO_VISIBLE py_lhs
 {
 	public:
 		py_lhs(unsigned int dim, unsigned int count) : m_original_class(dim,count) {}
 		std::vector<double> operator ()() {return m_original_class();}
 		std::vector<double> operator ()(unsigned int n) {return m_original_class(n);}
+		std::vector<double> generate(unsigned long long first, unsigned long long n, unsigned int n_threads) const
+		{
+			std::vector<double> retval;
+			m_original_class.generate(retval,first,n,n_threads);
+			return retval;
+		}
 	private:
 		pagmo::util::discrepancy::lhs m_original_class;
 };
@@ -97,6 +131,12 @@ class __PAGMO_VISIBLE py_halton
 		py_halton(unsigned int dim, unsigned int count) : m_original_class(dim,count) {}
 		std::vector<double> operator ()() {return m_original_class();}
 		std::vector<double> operator ()(unsigned int n) {return m_original_class(n);}
+		std::vector<double> generate(unsigned long long first, unsigned long long n, unsigned int n_threads) const
+		{
+			std::vector<double> retval;
+			m_original_class.generate(retval,first,n,n_threads);
+			return retval;
+		}
 	private:
 		pagmo::util::discrepancy::halton m_original_class;
 };
@@ -107,6 +147,12 @@ class __PAGMO_VISIBLE py_faure
 		py_faure(unsigned int dim, unsigned int count) : m_original_class(dim,count) {}
 		std::vector<double> operator ()() {return m_original_class();}
 		std::vector<double> operator ()(unsigned int n) {return m_original_class(n);}
+		std::vector<double> generate(unsigned long long first, unsigned long long n, unsigned int n_threads) const
+		{
+			std::vector<double> retval;
+			m_original_class.generate(retval,first,n,n_threads);
+			return retval;
+		}
 	private:
 		pagmo::util::discrepancy::faure m_original_class;
 };
@@ -133,8 +179,8 @@ void expose_hv_algorithm()
 	algorithm_wrapper<util::hv_algorithm::hoy>("hoy","HOY algorithm.");
 	class_<util::hv_algorithm::wfg, bases<util::hv_algorithm::base> >("wfg","WFG algorithm.", init<const unsigned int>());
 	class_<util::hv_algorithm::bf_approx, bases<util::hv_algorithm::base> >("bf_approx","Bringmann-Friedrich approximated algorithm.", 
-			init<const bool, const unsigned int, const double, const double, const double, const double, const double, const double>());
-	class_<util::hv_algorithm::bf_fpras, bases<util::hv_algorithm::base> >("bf_fpras","Hypervolume approximation based on FPRAS", init<const double, const double>());
+			init<const bool, const unsigned int, const double, const double, const double, const double, const double, const double, const unsigned int>());
+	class_<util::hv_algorithm::bf_fpras, bases<util::hv_algorithm::base> >("bf_fpras","Hypervolume approximation based on FPRAS", init<const double, const double, const unsigned int>());
 }
 
 void expose_hypervolume()
@@ -223,31 +269,43 @@ BOOST_PYTHON_MODULE(_util) {
 	typedef std::vector<double> (discrepancy::py_lhs::*my_second_overload_l)(unsigned int) ;
 	class_<discrepancy::py_lhs>("lhs", init<unsigned int , unsigned int>())
 		.def("next", my_first_overload_l(&discrepancy::py_lhs::operator()))
-		.def("next", my_second_overload_l(&discrepancy::py_lhs::operator()));
+		.def("next", my_second_overload_l(&discrepancy::py_lhs::operator()))
+		.def("generate", &discrepancy::py_lhs::generate, "generate(first, n, threads): points of indices first, ..., first + n - 1 as a flat list, row by row.");
 
 	typedef std::vector<double> (discrepancy::py_sobol::*my_first_overload_s)() ;
 	typedef std::vector<double> (discrepancy::py_sobol::*my_second_overload_s)(unsigned int) ;
 	class_<discrepancy::py_sobol>("sobol", init<unsigned int , unsigned int>())
 		.def("next", my_first_overload_s(&discrepancy::py_sobol::operator()))
-		.def("next", my_second_overload_s(&discrepancy::py_sobol::operator()));
+		.def("next", my_second_overload_s(&discrepancy::py_sobol::operator()))
+		.def("generate", &discrepancy::py_sobol::generate, "generate(first, n, threads): points of indices first, ..., first + n - 1 as a flat list, row by row.");
+
+	typedef std::vector<double> (discrepancy::py_scrambled_sobol::*my_first_overload_ss)() ;
+	typedef std::vector<double> (discrepancy::py_scrambled_sobol::*my_second_overload_ss)(unsigned int) ;
+	class_<discrepancy::py_scrambled_sobol>("scrambled_sobol", init<unsigned int , unsigned int, boost::uint32_t>())
+		.def("next", my_first_overload_ss(&discrepancy::py_scrambled_sobol::operator()))
+		.def("next", my_second_overload_ss(&discrepancy::py_scrambled_sobol::operator()))
+		.def("generate", &discrepancy::py_scrambled_sobol::generate, "generate(first, n, threads): points of indices first, ..., first + n - 1 as a flat list, row by row.");
 
 	typedef std::vector<double> (discrepancy::py_simplex::*my_first_overload)() ;
 	typedef std::vector<double> (discrepancy::py_simplex::*my_second_overload)(unsigned int) ;
 	class_<discrepancy::py_simplex>("simplex", init<unsigned int , unsigned int>())
 		.def("next", my_first_overload(&discrepancy::py_simplex::operator()))
-		.def("next", my_second_overload(&discrepancy::py_simplex::operator()));
+		.def("next", my_second_overload(&discrepancy::py_simplex::operator()))
+		.def("generate", &discrepancy::py_simplex::generate, "generate(first, n, threads): points of indices first, ..., first + n - 1 as a flat list, row by row.");
 		
 	typedef std::vector<double> (discrepancy::py_halton::*my_first_overload_h)() ;
 	typedef std::vector<double> (discrepancy::py_halton::*my_second_overload_h)(unsigned int) ;
 	class_<discrepancy::py_halton>("halton", init<unsigned int , unsigned int>())
 		.def("next", my_first_overload_h(&discrepancy::py_halton::operator()))
-		.def("next", my_second_overload_h(&discrepancy::py_halton::operator()));
+		.def("next", my_second_overload_h(&discrepancy::py_halton::operator()))
+		.def("generate", &discrepancy::py_halton::generate, "generate(first, n, threads): points of indices first, ..., first + n - 1 as a flat list, row by row.");
 
 	typedef std::vector<double> (discrepancy::py_faure::*my_first_overload_f)() ;
 	typedef std::vector<double> (discrepancy::py_faure::*my_second_overload_f)(unsigned int) ;
 	class_<discrepancy::py_faure>("faure", init<unsigned int , unsigned int>())
 		.def("next", my_first_overload_f(&discrepancy::py_faure::operator()))
-		.def("next", my_second_overload_f(&discrepancy::py_faure::operator()));
+		.def("next", my_second_overload_f(&discrepancy::py_faure::operator()))
+		.def("generate", &discrepancy::py_faure::generate, "generate(first, n, threads): points of indices first, ..., first + n - 1 as a flat list, row by row.");
 
 	// Racing
 	enum_<racing::race_pop::termination_condition>("_termination_condition")
@@ -270,8 +328,8 @@ BOOST_PYTHON_MODULE(_util) {
 	//class_<std::vector<pagmo::problem::base_ptr> >("vector_of_problem_base_ptr")
 	//	.def(vector_indexing_suite<std::vector<pagmo::problem::base_ptr>, true>());
 
-	class_<racing::race_algo>("race_algo", init<const std::vector<pagmo::algorithm::base_ptr> &, const pagmo::problem::base &, unsigned int, unsigned int>())
-	.def(init<const std::vector<pagmo::algorithm::base_ptr> &, const std::vector<pagmo::problem::base_ptr> &, unsigned int, unsigned int>())
+	class_<racing::race_algo>("race_algo", init<const std::vector<pagmo::algorithm::base_ptr> &, const pagmo::problem::base &, unsigned int, unsigned int, unsigned int>())
+	.def(init<const std::vector<pagmo::algorithm::base_ptr> &, const std::vector<pagmo::problem::base_ptr> &, unsigned int, unsigned int, unsigned int>())
 	.def("run", &race_algo_run_return_tuple, "Race the algorithms");
 	
 	// Hypervolumes
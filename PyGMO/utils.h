@@ -28,6 +28,8 @@
 #define PYGMO_UTILS_H
 
 #include <Python.h>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/serialization/serialization.hpp>
@@ -35,6 +37,8 @@
 #include <boost/python/dict.hpp>
 #include <boost/python/docstring_options.hpp>
 #include <boost/python/extract.hpp>
+#include <boost/python/handle.hpp>
+#include <boost/python/object.hpp>
 #include <boost/python/tuple.hpp>
 #include <csignal>
 #include <sstream>
@@ -63,6 +67,58 @@ void serialize(Archive &, boost::python::wrapper<T> &, const unsigned int)
 
 }}
 
+// Binary pickle protocol. The C++ part of the pickled state is stored as a (tag,version,bytes) tuple, where bytes
+// is the content of a binary archive. Binary archives write doubles as raw blocks and are much more compact and
+// faster than text archives, but they are not portable across platforms with different type sizes or endianness.
+#define PYGMO_BINARY_PICKLE_TAG "pagmo_binary"
+#define PYGMO_BINARY_PICKLE_VERSION 1
+
+template <class T>
+inline boost::python::tuple py_binary_dumps(const T &x)
+{
+	std::ostringstream ss;
+	{
+		boost::archive::binary_oarchive oa(ss);
+		oa << x;
+	}
+	const std::string str = ss.str();
+	boost::python::object bytes(boost::python::handle<>(PyBytes_FromStringAndSize(str.data(),static_cast<Py_ssize_t>(str.size()))));
+	return boost::python::make_tuple(PYGMO_BINARY_PICKLE_TAG,PYGMO_BINARY_PICKLE_VERSION,bytes);
+}
+
+// Restore the C++ part of a pickled state. States produced by py_binary_dumps() are read through a binary archive,
+// plain strings (i.e., pickles produced before the introduction of the binary protocol) through a text archive.
+template <class T>
+inline void py_pickle_loads(T &x, const boost::python::object &state)
+{
+	using namespace boost::python;
+	if (!PyTuple_Check(state.ptr())) {
+		const std::string str = extract<std::string>(state);
+		std::istringstream ss(str);
+		boost::archive::text_iarchive ia(ss);
+		ia >> x;
+		return;
+	}
+	const tuple t = extract<tuple>(state);
+	if (len(t) != 3 || extract<std::string>(t[0])() != PYGMO_BINARY_PICKLE_TAG || !PyBytes_Check(object(t[2]).ptr())) {
+		PyErr_SetString(PyExc_ValueError,"invalid binary state in call to __setstate__");
+		throw_error_already_set();
+	}
+	const int version = extract<int>(t[1]);
+	if (version < 1 || version > PYGMO_BINARY_PICKLE_VERSION) {
+		PyErr_SetString(PyExc_ValueError,"unsupported version of the binary state in call to __setstate__");
+		throw_error_already_set();
+	}
+	char *buffer = 0;
+	Py_ssize_t size = 0;
+	if (PyBytes_AsStringAndSize(object(t[2]).ptr(),&buffer,&size) == -1) {
+		throw_error_already_set();
+	}
+	std::istringstream ss(std::string(buffer,static_cast<std::string::size_type>(size)));
+	boost::archive::binary_iarchive ia(ss);
+	ia >> x;
+}
+
 // Generic pickle suite for C++ classes with default constructor extensible from Python.
 // Difference from above is that we need to take care of handling the derived class' dict.
 template <class T>
@@ -75,10 +131,7 @@ struct python_class_pickle_suite: boost::python::pickle_suite
 	static boost::python::tuple getstate(boost::python::object obj)
 	{
 		T const &x = boost::python::extract<T const &>(obj)();
-		std::stringstream ss;
-		boost::archive::text_oarchive oa(ss);
-		oa << x;
-		return boost::python::make_tuple(obj.attr("__dict__"),ss.str());
+		return boost::python::make_tuple(obj.attr("__dict__"),py_binary_dumps(x));
 	}
 	static void setstate(boost::python::object obj, boost::python::tuple state)
 	{
@@ -93,10 +146,7 @@ struct python_class_pickle_suite: boost::python::pickle_suite
 		dict d = extract<dict>(obj.attr("__dict__"))();
 		d.update(state[0]);
 		// Restore the internal state of the C++ object.
-		const std::string str = extract<std::string>(state[1]);
-		std::stringstream ss(str);
-		boost::archive::text_iarchive ia(ss);
-		ia >> x;
+		py_pickle_loads(x,state[1]);
 	}
 	static bool getstate_manages_dict()
 	{
@@ -78,29 +78,9 @@ double base_nlopt::objfun_wrapper(const std::vector<double> &x, std::vector<doub
 	nlopt_wrapper_data *d = (nlopt_wrapper_data *)data;
 	pagmo_assert(d->f.size() == 1);
 
-	// Compute the gradient by central diffs if necessary TODO: also ipopt has this code (or similar)
-	// It should be moved elswhere in PaGMO. Plus be aware that here a chromsome outside the bounds
-	// can be created, thus invaidating its compatibility with the problem (exception will be thrown)
-
+	// Compute the gradient if necessary (by central differences, unless the problem provides it).
 	if (!grad.empty()) {
-		std::copy(x.begin(),x.end(),d->dx.begin());
-		double central_diff;
-		const double h0=1e-8;
-		double h;
-		double mem;
-		for (size_t i =0; i < d->dx.size(); ++i)
-		{
-			h = h0 * std::max(1.,fabs(d->dx[i]));
-			mem = d->dx[i];
-			d->dx[i] += h;
-			d->prob->objfun(d->f,d->dx);
-			central_diff = d->f[0];
-			d->dx[i] -= 2*h;
-			d->prob->objfun(d->f,d->dx);
-			central_diff = (central_diff-d->f[0]) / 2 / h;
-			grad[i] = central_diff;
-			d->dx[i] = mem;
-		}
+		d->prob->objfun_gradient(grad,x);
 	}
 
 	// Calculate the objective function.
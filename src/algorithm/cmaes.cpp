@@ -32,6 +32,9 @@
 #include <boost/random/uniform_real.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <cstddef>
+#include <limits>
 
 
 #include "cmaes.h"
@@ -39,6 +42,7 @@
 #include "../population.h"
 #include "../problem/base_stochastic.h"
 #include "../types.h"
+#include "../util/async_evaluator.h"
 #include "../Eigen/Dense"
 
 namespace pagmo { namespace algorithm {
@@ -56,12 +60,18 @@ namespace pagmo { namespace algorithm {
  * @param[in] ftol stopping criteria on the x tolerance
  * @param[in] xtol stopping criteria on the f tolerance
  * @param[in] memory when true the algorithm preserves its memory of the parameter adaptation (C, p etc ....) at each call
- * @throws value_error if cc,cs,c1,cmu are not in [0,1] or not -1
+ * @param[in] var covariance model: full matrix, diagonal matrix (sep-CMA-ES) or limited-memory matrix adaptation (LM-MA-ES)
+ * @param[in] n_paths number of evolution paths used by the limited-memory variant, if -1 it is set to 4 + floor(3 ln N)
+ * @param[in] rst restart strategy: none, IPOP (increasing offspring size) or BIPOP (alternating large and small offspring sizes)
+ * @param[in] threads number of threads evaluating the offspring, if 0 the number of hardware threads is used
+ * @throws value_error if cc,cs,c1,cmu are not in [0,1] or not -1, or if n_paths is not positive or -1
  * 
  * */
-cmaes::cmaes(int gen, double cc, double cs, double c1, double cmu, double sigma0, double ftol, double xtol, bool memory):
+cmaes::cmaes(int gen, double cc, double cs, double c1, double cmu, double sigma0, double ftol, double xtol, bool memory, variant::type var, int n_paths,
+	restart::type rst, unsigned int threads):
 		base(), m_gen(boost::numeric_cast<std::size_t>(gen)), m_cc(cc), m_cs(cs), m_c1(c1), 
-		m_cmu(cmu), m_sigma(sigma0), m_ftol(ftol), m_xtol(xtol), m_memory(memory) {
+		m_cmu(cmu), m_sigma(sigma0), m_sigma0(sigma0), m_ftol(ftol), m_xtol(xtol), m_memory(memory), m_variant(var), m_n_paths(n_paths),
+		m_restart(rst), m_threads(threads) {
 	if (gen < 0) {
 		pagmo_throw(value_error,"number of generations must be nonnegative");
 	}
@@ -77,19 +87,28 @@ cmaes::cmaes(int gen, double cc, double cs, double c1, double cmu, double sigma0
 	if ( ((cmu < 0) || (cmu > 1)) && !(cmu==-1) ){
 		pagmo_throw(value_error,"cmu needs to be in [0,1] or -1 for auto value");
 	}
+	if ( (n_paths < 1) && !(n_paths==-1) ){
+		pagmo_throw(value_error,"n_paths needs to be positive or -1 for auto value");
+	}
 
 	//Initialize the algorithm memory
 	m_mean = Eigen::VectorXd::Zero(1);
 	m_variation = Eigen::VectorXd::Zero(1);
-	m_newpop = std::vector<Eigen::VectorXd>();
+	m_newpop = Eigen::MatrixXd();
 	m_B = Eigen::MatrixXd::Identity(1,1);
 	m_D = Eigen::MatrixXd::Identity(1,1);
 	m_C = Eigen::MatrixXd::Identity(1,1);
 	m_invsqrtC = Eigen::MatrixXd::Identity(1,1);
+	m_diagC = Eigen::VectorXd::Zero(1);
+	m_paths = Eigen::MatrixXd();
 	m_pc = Eigen::VectorXd::Zero(1);
 	m_ps = Eigen::VectorXd::Zero(1);
 	m_counteval = 0;
 	m_eigeneval = 0;
+	m_lambda = 0;
+	m_n_large = 0;
+	m_budget_small = 0;
+	m_budget_large = 0;
 
 }
 /// Clone method.
@@ -98,24 +117,23 @@ base_ptr cmaes::clone() const
 	return base_ptr(new cmaes(*this));
 }
 
-struct cmp_using_cur
+// Compare the offspring using their fitness
+struct cmp_using_fit
 {
-	cmp_using_cur(const population &pop):m_pop(pop) {}
+	cmp_using_fit(const problem::base &prob, const std::vector<fitness_vector> &f):m_prob(prob),m_f(f) {}
 	bool operator()(const population::size_type &i1, const population::size_type &i2) const
 	{
-		return (
-		m_pop.problem().compare_fc(
-		  m_pop.get_individual(i1).cur_f, m_pop.get_individual(i1).cur_c,
-		  m_pop.get_individual(i2).cur_f, m_pop.get_individual(i2).cur_c)
-		);
+		return m_prob.compare_fitness(m_f[i1],m_f[i2]);
 	}
-	const population &m_pop;
+	const problem::base &m_prob;
+	const std::vector<fitness_vector> &m_f;
 };
 
 
 /// Evolve implementation.
 /**
- * Run CMAES
+ * Run CMAES. Without restarts, m_gen generations are performed. With restarts, the run goes on as long as m_gen * pop.size()
+ * function evaluations are not exceeded, and the population contains the best individuals of the last generation.
  *
  * @param[in,out] pop input/output pagmo::population to be evolved.
  */
@@ -126,8 +144,7 @@ void cmaes::evolve(population &pop) const
 	const problem::base &prob = pop.problem();
 	const problem::base::size_type prob_i_dimension = prob.get_i_dimension(), dim = prob.get_dimension(), N = dim - prob_i_dimension, prob_c_dimension = prob.get_c_dimension();
 	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
-	const population::size_type lam = pop.size();
-	const population::size_type mu = boost::numeric_cast<population::size_type>(lam/2);
+	const population::size_type NP = pop.size();
 
 	//We perform some checks to determine whether the problem/population are suitable for Cross Entropy
 	if ( N == 0 ) {
@@ -146,7 +163,7 @@ void cmaes::evolve(population &pop) const
 		pagmo_throw(value_error,"The problem has an integer part and CE is not suitable to solve it");
 	}
 
-	if (lam < 5) {
+	if (NP < 5) {
 		pagmo_throw(value_error,"for CE at least 5 individuals in the population are required");
 	}
 
@@ -163,125 +180,230 @@ void cmaes::evolve(population &pop) const
 	boost::uniform_real<double> uniform(0.0,1.0);
 	boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_real<double> > randomly_distributed_number(m_drng,uniform);
 
-	// Setting coefficients for Selection
-	VectorXd weights(mu);
-	for (int i = 0; i < weights.rows(); ++i){
-		weights(i) = std::log(mu+0.5) - std::log(i+1.0);
+	// Stochastic problems change seed at each generation, and the offspring is evaluated in the population.
+	const problem::base_stochastic *stochastic_prob = dynamic_cast<const problem::base_stochastic *>(&prob);
+	// Otherwise the offspring is evaluated as a batch, in parallel if requested. The threads are kept for all the generations and restarts.
+	boost::scoped_ptr<util::async_evaluator> evaluator;
+	if (m_threads != 1 && !stochastic_prob) {
+		evaluator.reset(new util::async_evaluator(prob,m_threads));
 	}
-	weights /= weights.sum();					// weights for weighted recombination
-	double mueff = 1.0 / (weights.transpose()*weights);		// variance-effectiveness of sum w_i x_i
 
-	// Setting coefficients for Adaptation automatically or to user defined data
-	double cc(m_cc), cs(m_cs), c1(m_c1), cmu(m_cmu);
-	if (cc == -1) {
-		cc = (4 + mueff/N) / (N+4 + 2*mueff/N);			// t-const for cumulation for C
-	}
-	if (cs == -1) {
-		cs = (mueff+2) / (N+mueff+5);				// t-const for cumulation for sigma control
-	}
-	if (c1 == -1) {
-		c1 = 2.0 / ((N+1.3)*(N+1.3)+mueff);			// learning rate for rank-one update of C
+	// Number of evolution paths and their learning rates (LIMITED_MEMORY)
+	const int n_paths = (m_variant != variant::LIMITED_MEMORY) ? 0 :
+		((m_n_paths == -1) ? 4 + boost::numeric_cast<int>(std::floor(3 * std::log(double(N)))) : m_n_paths);
+	VectorXd cd(n_paths), cp(n_paths);
+	for (int j = 0; j < n_paths; ++j) {
+		cd(j) = 1.0 / (std::pow(1.5,j) * N);				// learning rate of the transformation
 	}
-	if (cmu == -1) {
-		cmu = 2.0 * (mueff-2+1/mueff) / ((N+2)*(N+2)+mueff);	// and for rank-mu update
-	}
-	
-	double damps = 1 + 2*std::max(0.0, std::sqrt((mueff-1)/(N+1))-1) + cs;	// damping for sigma
-	double chiN = std::sqrt(N) * (1-1.0/(4*N)+1.0/(21*N*N));		// expectation of ||N(0,I)|| == norm(randn(N,1))
-
-	// Initializing and allocating (here one could use mutable data member to avoid redefinition of non const data)
 
 	// Algorithm's Memory. This allows the algorithm to start from its last "state"
 	VectorXd mean(m_mean);
 	VectorXd variation(m_variation);
-	std::vector<VectorXd> newpop(m_newpop);
+	MatrixXd newpop(m_newpop);
 	MatrixXd B(m_B);
 	MatrixXd D(m_D);
 	MatrixXd C(m_C);
 	MatrixXd invsqrtC(m_invsqrtC);
+	VectorXd diagC(m_diagC);
+	MatrixXd paths(m_paths);
 	VectorXd pc(m_pc);
 	VectorXd ps(m_ps);
 	int counteval(m_counteval);
 	int eigeneval(m_eigeneval);
 	double sigma(m_sigma);
 	double var_norm = 0;
+	// Restarts' memory: offspring size, number of restarts with increasing offspring, evaluations spent with small and large offspring
+	population::size_type lam = (m_restart == restart::NONE || m_lambda < NP) ? NP : m_lambda;
+	int n_large(m_n_large);
+	std::size_t budget_small(m_budget_small), budget_large(m_budget_large);
+
+	// The search space is scaled by the width of the box. If this is too small... then 1e-6 is used
+	VectorXd width(N);
+	for (problem::base::size_type j=0; j<N; ++j){
+		width(j) = std::max((ub[j]-lb[j]),1e-6);
+	}
+
+	// Coefficients, depending on the offspring size
+	population::size_type mu = 0;
+	VectorXd weights;
+	double mueff = 0, cc = 0, cs = 0, c1 = 0, cmu = 0, damps = 0, chiN = 0;
 
-	// Some buffers
+	// Some buffers. Those sized on the offspring are only enlarged, so that restarts reuse them.
 	VectorXd meanold = VectorXd::Zero(N);
-	MatrixXd Dinv = MatrixXd::Identity(N,N);
-	MatrixXd Cold = MatrixXd::Identity(N,N);
-	VectorXd tmp = VectorXd::Zero(N);
-	std::vector<VectorXd> elite(mu,tmp);
+	MatrixXd Dinv, Cold;
+	if (m_variant == variant::FULL) {
+		Dinv = MatrixXd::Identity(N,N);
+		Cold = MatrixXd::Identity(N,N);
+	}
+	MatrixXd Z;			// standard normal samples, one per column
+	MatrixXd Y;			// their transformation, i.e. the steps of the offspring divided by sigma
+	MatrixXd elite, Zelite;
+	std::vector<bool> repaired;
+	std::vector<decision_vector> xs;
+	std::vector<fitness_vector> fs;
+	std::vector<population::size_type> best_idx;
+	const constraint_vector c;
 	decision_vector dumb(N,0);
+	util::async_evaluator::result r;
 
 	// If the algorithm is called for the first time on this problem dimension / pop size or if m_memory is false we erease the memory of past calls
-	if ( (m_newpop.size() != lam) || ((unsigned int)(m_newpop[0].rows() ) != N) || (m_memory==false) ) {
+	bool reset = ( (boost::numeric_cast<population::size_type>(m_newpop.cols()) != lam) || (boost::numeric_cast<problem::base::size_type>(m_newpop.rows()) != N) ||
+		(m_paths.cols() != n_paths) || (m_memory==false) );
+	if (reset) {
+		lam = NP;
 		mean.resize(N);
+		n_large = 0;
+		budget_small = 0;
+		budget_large = 0;
 		for (problem::base::size_type i=0;i<N;++i){
 			mean(i) = pop.champion().x[i];
 		}
-		newpop = std::vector<VectorXd>(lam,tmp);
-		variation.resize(N);
-
-		//We define the satrting B,D,C
-		B.resize(N,N); B = MatrixXd::Identity(N,N);			//B defines the coordinate system
-		D.resize(N,N); D = MatrixXd::Identity(N,N);			//diagonal D defines the scaling. By default this is the witdh of the box. 
-										//If this is too small... then 1e-6 is used
-		for (problem::base::size_type j=0; j<N; ++j){
-			D(j,j) = std::max((ub[j]-lb[j]),1e-6);
-		}
-		C.resize(N,N); C = MatrixXd::Identity(N,N);			//covariance matrix C
-		C = D*D;						
-		invsqrtC.resize(N,N); invsqrtC = MatrixXd::Identity(N,N);	//inverse of sqrt(C)
-		for (problem::base::size_type j=0; j<N; ++j){
-			invsqrtC(j,j) = 1 / D(j,j);
-		}
-		pc.resize(N); pc = VectorXd::Zero(N);
-		ps.resize(N); ps = VectorXd::Zero(N);
-		counteval = 0;
-		eigeneval = 0;
 	}
-	
+	bool setup = true, small_run = false;
+	// Evaluations performed during this call and during the current run, fitness range of the last offspring
+	std::size_t n_evals = 0, run_evals = 0;
+	double f_range = std::numeric_limits<double>::infinity();
+	const std::size_t max_evals = m_gen * NP;
+
 	// ----------------------------------------------//
 	// HERE WE START THE REAL ALGORITHM              //
 	// ----------------------------------------------//
 
-	if (m_screen_output) {
-		std::cout << "CMAES 4 PaGMO: " << std::endl;
-		std::cout << "mu: " << mu
-			<< " - lambda: " << lam
-			<< " - mueff: " << mueff
-			<< " - N: " << N << std::endl;
-
-		std::cout << "cc: " << cc
-			<< " - cs: " << cs
-			<< " - c1: " << c1
-			<< " - cmu: " << cmu
-			<< " - sigma: " << sigma
-			<< " - damps: " << damps
-			<< " - chiN: " << chiN << std::endl;
-	}
-	
-	SelfAdjointEigenSolver<MatrixXd> es(N);
-	for (std::size_t g = 0; g < m_gen; ++g) {
-		// 1 - We generate and evaluate lam new individuals
+	SelfAdjointEigenSolver<MatrixXd> es;
+	for (std::size_t g = 0; (m_restart == restart::NONE) ? g < m_gen : n_evals + lam <= max_evals; ++g) {
+		// 0 - Set up the coefficients and, if needed, the initial state of a run
+		if (setup) {
+			mu = boost::numeric_cast<population::size_type>(lam/2);
+			// Setting coefficients for Selection
+			weights.resize(mu);
+			for (int i = 0; i < weights.rows(); ++i){
+				weights(i) = std::log(mu+0.5) - std::log(i+1.0);
+			}
+			weights /= weights.sum();					// weights for weighted recombination
+			mueff = 1.0 / (weights.transpose()*weights);		// variance-effectiveness of sum w_i x_i
+
+			// Setting coefficients for Adaptation automatically or to user defined data
+			cc = m_cc; cs = m_cs; c1 = m_c1; cmu = m_cmu;
+			if (cc == -1) {
+				cc = (4 + mueff/N) / (N+4 + 2*mueff/N);			// t-const for cumulation for C
+			}
+			if (cs == -1) {
+				cs = (mueff+2) / (N+mueff+5);				// t-const for cumulation for sigma control
+				if (m_variant == variant::LIMITED_MEMORY && 2.0*lam < N) {
+					cs = 2.0*lam / N;				// LM-MA-ES uses a faster cumulation
+				}
+			}
+			if (c1 == -1) {
+				c1 = 2.0 / ((N+1.3)*(N+1.3)+mueff);			// learning rate for rank-one update of C
+				if (m_variant == variant::SEPARABLE) {
+					c1 *= (N+2) / 3.0;				// a diagonal C can be learnt faster
+				}
+			}
+			if (cmu == -1) {
+				cmu = 2.0 * (mueff-2+1/mueff) / ((N+2)*(N+2)+mueff);	// and for rank-mu update
+				if (m_variant == variant::SEPARABLE) {
+					cmu = std::min(1-c1, cmu * (N+2) / 3.0);
+				}
+			}
+			damps = 1 + 2*std::max(0.0, std::sqrt((mueff-1)/(N+1))-1) + cs;	// damping for sigma
+			chiN = std::sqrt(N) * (1-1.0/(4*N)+1.0/(21*N*N));		// expectation of ||N(0,I)|| == norm(randn(N,1))
+			for (int j = 0; j < n_paths; ++j) {
+				cp(j) = std::min(1.0, lam / (std::pow(4.0,j) * N));		// t-const for cumulation of the path
+			}
+
+			if (reset) {
+				newpop = MatrixXd::Zero(N,lam);
+				variation = VectorXd::Zero(N);
+				switch (m_variant) {
+					case variant::FULL:
+						//We define the satrting B,D,C
+						B = MatrixXd::Identity(N,N);				//B defines the coordinate system
+						D = width.asDiagonal();					//diagonal D defines the scaling. By default this is the witdh of the box.
+						C = D*D;						//covariance matrix C
+						invsqrtC = width.cwiseInverse().asDiagonal();		//inverse of sqrt(C)
+						break;
+					case variant::SEPARABLE:
+						diagC = width.cwiseAbs2();				//diagonal of the covariance matrix
+						break;
+					case variant::LIMITED_MEMORY:
+						paths = MatrixXd::Zero(N,n_paths);			//no path is used until it is defined
+						break;
+				}
+				pc = VectorXd::Zero(N);
+				ps = VectorXd::Zero(N);
+				counteval = 0;
+				eigeneval = 0;
+				run_evals = 0;
+				f_range = std::numeric_limits<double>::infinity();
+				reset = false;
+			}
+
+			if (Z.cols() < boost::numeric_cast<MatrixXd::Index>(lam)) {
+				Z.resize(N,lam);
+				Y.resize(N,lam);
+			}
+			elite.resize(N,mu);
+			Zelite.resize(N,mu);
+			repaired.resize(lam);
+			xs.resize(lam,dumb);
+			fs.resize(lam);
+			best_idx.resize(lam);
+
+			if (m_screen_output) {
+				std::cout << "CMAES 4 PaGMO: " << std::endl;
+				std::cout << "mu: " << mu
+					<< " - lambda: " << lam
+					<< " - mueff: " << mueff
+					<< " - N: " << N
+					<< " - variant: " << m_variant << std::endl;
+
+				std::cout << "cc: " << cc
+					<< " - cs: " << cs
+					<< " - c1: " << c1
+					<< " - cmu: " << cmu
+					<< " - sigma: " << sigma
+					<< " - damps: " << damps
+					<< " - chiN: " << chiN << std::endl;
+			}
+			setup = false;
+		}
+
+		// Number of evolution paths already defined (LIMITED_MEMORY)
+		const int n_used = std::min(n_paths, counteval / boost::numeric_cast<int>(lam));
 
+		// 1 - We generate lam new individuals
+
+		// 1a - we create lam randomly normal distributed vectors
 		for (population::size_type i = 0; i<lam; ++i ) {
-			// 1a - we create a randomly normal distributed vector
 			for (problem::base::size_type j=0; j<N; ++j){
-				tmp(j) = normally_distributed_number();
+				Z(j,i) = normally_distributed_number();
 			}
-			// 1b - and store its transformed value in the newpop
-			newpop[i] = mean + (sigma * B * D * tmp);
 		}
-		//This is evaluated here on the last generated tmp and will be used only as 
+		// 1b - and store their transformed values in the newpop
+		switch (m_variant) {
+			case variant::FULL:
+				Y.leftCols(lam).noalias() = B * (D.diagonal().asDiagonal() * Z.leftCols(lam));
+				break;
+			case variant::SEPARABLE:
+				Y.leftCols(lam).noalias() = diagC.cwiseSqrt().asDiagonal() * Z.leftCols(lam);
+				break;
+			case variant::LIMITED_MEMORY:
+				Y.leftCols(lam) = Z.leftCols(lam);
+				for (int j = 0; j < n_used; ++j) {
+					Y.leftCols(lam) = (1 - cd(j)) * Y.leftCols(lam) + cd(j) * paths.col(j) * (paths.col(j).transpose() * Y.leftCols(lam));
+				}
+				Y.leftCols(lam) = width.asDiagonal() * Y.leftCols(lam);
+				break;
+		}
+		newpop = (sigma * Y.leftCols(lam)).colwise() + mean;
+		//This is evaluated here on the last generated sample and will be used only as
 		//a stopping criteria
-		var_norm = (sigma * B * D * tmp).norm();
+		var_norm = sigma * Y.col(lam-1).norm();
 		
 		//1b - Check the exit conditions (every 5 generations) // we need to do it here as 
-		//termination is defined on tmp
-		if (g%5 == 0) {
-			if  ( (sigma*B*D*tmp).norm() < m_xtol ) {
+		//termination is defined on the last sample
+		if (m_restart == restart::NONE && g%5 == 0) {
+			if  ( var_norm < m_xtol ) {
 				if (m_screen_output) { 
 					std::cout << "Exit condition -- xtol < " <<  m_xtol << std::endl;
 				}
@@ -298,85 +420,167 @@ void cmaes::evolve(population &pop) const
 			}
 		}
 
+		//1b' - With restarts, the same conditions (on the last offspring fitness range) or an ill-conditioned
+		//covariance matrix end the current run, and a new one is started
+		if (m_restart != restart::NONE && (var_norm < m_xtol || f_range < m_ftol ||
+			(m_variant == variant::FULL && D.diagonal().maxCoeff() > 1e7 * D.diagonal().minCoeff())))
+		{
+			if (small_run) {
+				budget_small += run_evals;
+			} else {
+				budget_large += run_evals;
+			}
+			if (m_restart == restart::IPOP || budget_large <= budget_small) {
+				// IPOP: the offspring size is doubled at each restart
+				++n_large;
+				lam = NP << n_large;
+				sigma = m_sigma0;
+				small_run = false;
+			} else {
+				// BIPOP: small offspring sizes and step sizes are also tried
+				const double u = randomly_distributed_number();
+				lam = std::max(NP,boost::numeric_cast<population::size_type>(std::floor(NP * std::pow(0.5 * (1 << n_large), u*u))));
+				sigma = m_sigma0 * std::pow(10.0,-2*u);
+				small_run = true;
+			}
+			if (m_screen_output) {
+				std::cout << "Restart -- lambda: " << lam << " - sigma: " << sigma << std::endl;
+			}
+			// Stop if the budget does not allow a generation of the new run
+			if (lam > max_evals - n_evals) {
+				break;
+			}
+			for (problem::base::size_type j=0; j<N; ++j){
+				mean(j) = lb[j] + randomly_distributed_number() * (ub[j] - lb[j]);
+			}
+			setup = true;
+			reset = true;
+			continue;
+		}
+
 		// 1c - we fix the bounds 
 		for (population::size_type i = 0; i<lam; ++i ) {
+			repaired[i] = false;
 			for (decision_vector::size_type j = 0; j<N; ++j ) {
-				if ( (newpop[i](j) < lb[j]) || (newpop[i](j) > ub[j]) ) {
-					newpop[i](j) = lb[j] + randomly_distributed_number() * (ub[j] - lb[j]);
+				if ( (newpop(j,i) < lb[j]) || (newpop(j,i) > ub[j]) ) {
+					newpop(j,i) = lb[j] + randomly_distributed_number() * (ub[j] - lb[j]);
+					repaired[i] = true;
+				}
+			}
+		}
+		// LM-MA-ES adapts on the normal samples: for the repaired individuals these are recovered
+		// inverting the transformation (each factor is inverted with the Sherman-Morrison formula)
+		if (m_variant == variant::LIMITED_MEMORY) {
+			for (population::size_type i = 0; i<lam; ++i ) {
+				if (!repaired[i]) {
+					continue;
+				}
+				VectorXd d = (newpop.col(i) - mean).cwiseQuotient(width) / sigma;
+				for (int j = n_used - 1; j >= 0; --j) {
+					const double a = 1 - cd(j);
+					d = (d - (cd(j) / (a + cd(j) * paths.col(j).squaredNorm()) * paths.col(j).dot(d)) * paths.col(j)) / a;
 				}
+				Z.col(i) = d;
 			}
 		}
 
-		// 2 - We Evaluate the new population (if the problem is stochastic change seed first)
-		try
-		{	//TODO: check if it is really necessary to clear the pop, also
+		// 2 - We Evaluate the new population
+		for (population::size_type i = 0; i<lam; ++i ) {
+			VectorXd::Map(&xs[i][0],N) = newpop.col(i);
+		}
+		if (stochastic_prob) {
+			// If the problem is stochastic change seed first
+			//TODO: check if it is really necessary to clear the pop, also
 			//would it make sense to use best_x also?
-			dynamic_cast<const pagmo::problem::base_stochastic &>(prob).set_seed(m_urng());
+			stochastic_prob->set_seed(m_urng());
 			pop.clear(); // Removes memory based on different seeds (champion and best_x, best_f, best_c)
 			for (population::size_type i = 0; i<lam; ++i ) {
-			  	for (decision_vector::size_type j = 0; j<N; ++j ) {
-					dumb[j] = newpop[i](j);
-				}
-				pop.push_back(dumb);
+				pop.push_back(xs[i]);
+				fs[i] = pop.get_individual(i).cur_f;
 			}
-			counteval += lam;
-		}
-		catch (const std::bad_cast& e)
-		{
-			// Reinsertion (original method)
+		} else if (evaluator) {
 			for (population::size_type i = 0; i<lam; ++i ) {
-				for (decision_vector::size_type j = 0; j<N; ++j ) {
-					dumb[j] = newpop[i](j);
-				}
-				pop.set_x(i,dumb);
+				evaluator->submit(xs[i],i);
 			}
-			counteval += lam;
+			for (population::size_type i = 0; i<lam; ++i ) {
+				evaluator->get(r);
+				fs[r.tag].swap(r.f);
+			}
+		} else {
+			prob.objfun_batch(fs,xs);
 		}
-		
-		// 2 - We extract the elite from this generation. We use cur_f, equivalent to the
-		// original method
-		std::vector<population::size_type> best_idx;
-		best_idx.reserve(pop.size());
-		for (population::size_type i=0; i<pop.size(); ++i){
-			best_idx.push_back(i);
+		counteval += lam;
+		n_evals += lam;
+		run_evals += lam;
+
+		// 2 - We extract the elite from this generation.
+		for (population::size_type i=0; i<lam; ++i){
+			best_idx[i] = i;
 		}
-		cmp_using_cur cmp(pop);
+		cmp_using_fit cmp(prob,fs);
 		std::sort(best_idx.begin(),best_idx.end(),cmp);
-		best_idx.resize(mu);
 		for (population::size_type i = 0; i<mu; ++i ) {
-			for (decision_vector::size_type j = 0; j<N; ++j ) {
-				elite[i](j) = pop.get_individual(best_idx[i]).cur_x[j];
+			elite.col(i) = newpop.col(best_idx[i]);
+			Zelite.col(i) = Z.col(best_idx[i]);
+		}
+		f_range = std::fabs(fs[best_idx[lam-1]][0] - fs[best_idx[0]][0]);
+
+		// 2b - and we reinsert the offspring in the population (the best NP of them, if the offspring is larger)
+		if (stochastic_prob) {
+			std::vector<population::size_type> worst(best_idx.begin() + NP, best_idx.end());
+			std::sort(worst.begin(),worst.end());
+			for (std::vector<population::size_type>::reverse_iterator it = worst.rbegin(); it != worst.rend(); ++it) {
+				pop.erase(*it);
+			}
+		} else if (lam == NP) {
+			for (population::size_type i = 0; i<lam; ++i ) {
+				pop.set_x(i,xs[i],fs[i],c);
+			}
+		} else {
+			for (population::size_type i = 0; i<NP; ++i ) {
+				pop.set_x(i,xs[best_idx[i]],fs[best_idx[i]],c);
 			}
 		}
 
-
 		// 3 - Compute the new elite mean storing the old one
 		meanold=mean;
-		mean = elite[0]*weights(0);
-		for (population::size_type i = 1; i<mu; ++i ) {
-			mean += elite[i]*weights(i);
-		}
+		mean.noalias() = elite * weights;
+		// and the steps of the elite divided by sigma
+		elite.colwise() -= meanold;
+		elite /= sigma;
 
-		// 4 - Update evolution paths
-		ps = (1 - cs) * ps + std::sqrt(cs*(2-cs)*mueff) * invsqrtC * (mean-meanold) / sigma;
+		// 4 - Update evolution paths, 5 - Adapt Covariance Matrix and 6 - Adapt sigma
 		double hsig = 0;
-		hsig = (ps.squaredNorm() / N / (1-std::pow((1-cs),(2.0*counteval/lam))) ) < (2.0 + 4/(N+1));
-		pc = (1-cc) * pc + hsig * std::sqrt(cc*(2-cc)*mueff) * (mean-meanold) / sigma;
-
-		// 5 - Adapt Covariance Matrix
-		Cold = C;
-		C = (elite[0]-meanold)*(elite[0]-meanold).transpose()*weights(0);
-		for (population::size_type i = 1; i<mu; ++i ) {
-			C += (elite[i]-meanold)*(elite[i]-meanold).transpose()*weights(i);
+		switch (m_variant) {
+			case variant::FULL:
+				ps = (1 - cs) * ps + std::sqrt(cs*(2-cs)*mueff) * invsqrtC * (mean-meanold) / sigma;
+				hsig = (ps.squaredNorm() / N / (1-std::pow((1-cs),(2.0*counteval/lam))) ) < (2.0 + 4/(N+1));
+				pc = (1-cc) * pc + hsig * std::sqrt(cc*(2-cc)*mueff) * (mean-meanold) / sigma;
+				Cold = C;
+				C.noalias() = cmu * elite * weights.asDiagonal() * elite.transpose();
+				C += (1-c1-cmu) * Cold +
+					c1 * ((pc * pc.transpose()) + (1-hsig) * cc * (2-cc) * Cold);
+				sigma *= std::exp( std::min( 0.6, (cs/damps) * (ps.norm()/chiN - 1) ) );
+				break;
+			case variant::SEPARABLE:
+				ps = (1 - cs) * ps + std::sqrt(cs*(2-cs)*mueff) * ((mean-meanold) / sigma).cwiseQuotient(diagC.cwiseSqrt());
+				hsig = (ps.squaredNorm() / N / (1-std::pow((1-cs),(2.0*counteval/lam))) ) < (2.0 + 4/(N+1));
+				pc = (1-cc) * pc + hsig * std::sqrt(cc*(2-cc)*mueff) * (mean-meanold) / sigma;
+				diagC = (1-c1-cmu) * diagC +
+					cmu * elite.cwiseAbs2() * weights +
+					c1 * (pc.cwiseAbs2() + (1-hsig) * cc * (2-cc) * diagC);
+				sigma *= std::exp( std::min( 0.6, (cs/damps) * (ps.norm()/chiN - 1) ) );
+				break;
+			case variant::LIMITED_MEMORY:
+				variation.noalias() = Zelite * weights;
+				ps = (1 - cs) * ps + std::sqrt(cs*(2-cs)*mueff) * variation;
+				for (int j = 0; j < n_paths; ++j) {
+					paths.col(j) = (1 - cp(j)) * paths.col(j) + std::sqrt(cp(j)*(2-cp(j))*mueff) * variation;
+				}
+				sigma *= std::exp( std::min( 0.6, (cs/2) * (ps.squaredNorm()/N - 1) ) );
+				break;
 		}
-		C /= sigma*sigma;
-		C = (1-c1-cmu) * Cold +
-			cmu * C +
-			c1 * ((pc * pc.transpose()) + (1-hsig) * cc * (2-cc) * Cold);
-
-		//6 - Adapt sigma
-		sigma *= std::exp( std::min( 0.6, (cs/damps) * (ps.norm()/chiN - 1) ) );
-		if ( (boost::math::isnan)(sigma) || (boost::math::isnan)(sigma) || (boost::math::isinf)(var_norm) || (boost::math::isnan)(var_norm) ) {
+		if ( (boost::math::isnan)(sigma) || (boost::math::isinf)(sigma) || (boost::math::isinf)(var_norm) || (boost::math::isnan)(var_norm) ) {
 			std::cout << "eigen: " << es.info() << std::endl;
 			std::cout << "B: " << B << std::endl;
 			std::cout << "D: " << D << std::endl;
@@ -386,7 +590,7 @@ void cmaes::evolve(population &pop) const
 		}
 
 		//7 - Perform eigen-decomposition of C
-		if ( (counteval - eigeneval) > (lam/(c1+cmu)/N/10) ) {		//achieve O(N^2)
+		if ( m_variant == variant::FULL && (counteval - eigeneval) > (lam/(c1+cmu)/N/10) ) {		//achieve O(N^2)
 			eigeneval = counteval;
 			C = (C+C.transpose())/2;				//enforce symmetry
 			es.compute(C);						//eigen decomposition
@@ -435,11 +639,17 @@ void cmaes::evolve(population &pop) const
 		m_D = D;
 		m_C = C;
 		m_invsqrtC = invsqrtC;
+		m_diagC = diagC;
+		m_paths = paths;
 		m_pc = pc;
 		m_ps = ps;
 		m_counteval = counteval;
 		m_eigeneval = eigeneval;
 		m_sigma = sigma;
+		m_lambda = lam;
+		m_n_large = n_large;
+		m_budget_small = budget_small;
+		m_budget_large = budget_large;
 	}
 		
 	} // end loop on g
@@ -471,7 +681,7 @@ void cmaes::set_cmu(const double cmu) {m_cmu = cmu;}
 double cmaes::get_cmu() const {return m_cmu;}
 
 /// Setter for m_sigma
-void cmaes::set_sigma(const double sigma) {m_sigma = sigma;}
+void cmaes::set_sigma(const double sigma) {m_sigma = sigma; m_sigma0 = sigma;}
 /// Getter for m_sigma
 double cmaes::get_sigma() const {return m_sigma;}
 
@@ -485,6 +695,20 @@ void cmaes::set_xtol(const double xtol) {m_xtol = xtol;}
 /// Getter for m_xtol
 double cmaes::get_xtol() const {return m_xtol;}
 
+/// Getter for m_variant
+cmaes::variant::type cmaes::get_variant() const {return m_variant;}
+
+/// Getter for m_n_paths
+int cmaes::get_n_paths() const {return m_n_paths;}
+
+/// Getter for m_restart
+cmaes::restart::type cmaes::get_restart() const {return m_restart;}
+
+/// Setter for m_threads
+void cmaes::set_threads(const unsigned int threads) {m_threads = threads;}
+/// Getter for m_threads
+unsigned int cmaes::get_threads() const {return m_threads;}
+
 /// Algorithm name
 std::string cmaes::get_name() const
 {
@@ -507,7 +731,13 @@ std::string cmaes::human_readable_extra() const
 	  << "sigma0:" << m_sigma << ' '
 	  << "ftol:" << m_ftol << ' '
 	  << "xtol:" << m_xtol << ' ' 
-	  << "memory:" << m_memory;
+	  << "memory:" << m_memory << ' '
+	  << "variant:" << m_variant;
+	if (m_variant == variant::LIMITED_MEMORY) {
+		s << ' ' << "n_paths:" << m_n_paths;
+	}
+	s << ' ' << "restart:" << m_restart << ' '
+	  << "threads:" << m_threads;
 	return s.str();
 }
 
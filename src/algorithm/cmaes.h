@@ -25,7 +25,9 @@
 #ifndef PAGMO_ALGORITHM_CMAES_H
 #define PAGMO_ALGORITHM_CMAES_H
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 
 #include "../config.h"
@@ -42,13 +44,48 @@ namespace pagmo { namespace algorithm {
 
 /// Covariance Matrix Adaptation Evolutionary Strategy (CMAES)
 /**
-
+ * Besides the original algorithm, which adapts a full N x N covariance matrix, two variants suitable for large scale problems
+ * (thousands of variables) are available:
+ *
+ * - SEPARABLE (sep-CMA-ES): only the diagonal of the covariance matrix is adapted. Memory and time per sample are O(N),
+ *   and the learning rates are scaled by (N+2)/3 when set automatically.
+ * - LIMITED_MEMORY (LM-MA-ES): the covariance matrix is never formed. The samples are transformed by a product of n_paths
+ *   rank-one updates built from evolution paths having different time horizons. Memory and time per sample are O(N n_paths).
+ *
+ * In all cases the whole offspring is sampled at once as a N x lambda matrix, and the covariance updates are computed as blocked
+ * matrix products. The offspring is evaluated as a batch, on a pool of threads if requested (except for stochastic problems, which
+ * change seed at each generation).
+ *
+ * Two restart strategies are available. When a run meets the xtol/ftol conditions (computed on the last offspring), or the covariance
+ * matrix becomes ill-conditioned, a new run is started from a random point:
+ *
+ * - IPOP: the offspring size is doubled at each restart.
+ * - BIPOP: runs with doubling offspring size alternate with runs with small offspring size and initial step, chosen so that the
+ *   evaluations spent in the two regimes are balanced.
+ *
+ * With restarts, the offspring size may exceed the population size: the population then holds the best individuals of the
+ * last generation. The number of function evaluations is m_gen * pop.size(), and the internal buffers are kept across restarts.
+ *
+ * @see http://dx.doi.org/10.1007/978-3-540-87700-4_30 for sep-CMA-ES
+ * @see http://arxiv.org/abs/1705.06693 for LM-MA-ES
+ * @see http://dx.doi.org/10.1145/1570256.1570333 for BIPOP-CMA-ES
  */
 
 class __PAGMO_VISIBLE cmaes: public base
 {
 public:
-	cmaes(int gen = 500, double cc = -1, double cs = -1, double c1 = -1, double cmu = -1, double sigma0=0.5, double ftol = 1e-6, double xtol = 1e-6, bool memory = true);
+	/// Covariance model
+	struct variant {
+		/// Full covariance matrix, diagonal covariance matrix, or limited-memory matrix adaptation
+		enum type {FULL = 0, SEPARABLE = 1, LIMITED_MEMORY = 2};
+	};
+	/// Restart strategy
+	struct restart {
+		/// No restarts, restarts with increasing population size, or bi-population restarts
+		enum type {NONE = 0, IPOP = 1, BIPOP = 2};
+	};
+	cmaes(int gen = 500, double cc = -1, double cs = -1, double c1 = -1, double cmu = -1, double sigma0=0.5, double ftol = 1e-6, double xtol = 1e-6, bool memory = true,
+		variant::type var = variant::FULL, int n_paths = -1, restart::type rst = restart::NONE, unsigned int threads = 1);
 	base_ptr clone() const;
 	void evolve(population &) const;
 	std::string get_name() const;
@@ -78,35 +115,126 @@ public:
 	void   set_ftol(const double p);
 	double get_ftol() const;
 
+	variant::type get_variant() const;
+	int get_n_paths() const;
+	restart::type get_restart() const;
+
+	void         set_threads(const unsigned int p);
+	unsigned int get_threads() const;
+
 protected:
 	std::string human_readable_extra() const;
 private:
 	friend class boost::serialization::access;
-		template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	template <class Archive>
+	void save(Archive &ar, const unsigned int) const
+	{
+		ar << boost::serialization::base_object<base>(*this);
+		ar << m_gen;
+		ar << m_cc;
+		ar << m_cs;
+		ar << m_c1;
+		ar << m_cmu;
+		ar << m_sigma;
+		ar << m_sigma0;
+		ar << m_xtol;
+		ar << m_ftol;
+		ar << m_memory;
+		ar << m_variant;
+		ar << m_n_paths;
+		ar << m_restart;
+		ar << m_threads;
+		ar << m_mean;
+		ar << m_variation;
+		ar << m_newpop;
+		ar << m_B;
+		ar << m_D;
+		ar << m_C;
+		ar << m_invsqrtC;
+		ar << m_diagC;
+		ar << m_paths;
+		ar << m_pc;
+		ar << m_ps;
+		ar << m_counteval;
+		ar << m_eigeneval;
+		ar << m_lambda;
+		ar << m_n_large;
+		ar << m_budget_small;
+		ar << m_budget_large;
+	}
+	template <class Archive>
+	void load(Archive &ar, const unsigned int version)
 	{
-		ar & boost::serialization::base_object<base>(*this);
-		ar & const_cast<std::size_t &>(m_gen);
-		ar & m_cc;
-		ar & m_cs;
-		ar & m_c1;
-		ar & m_cmu;
-		ar & m_sigma;
-		ar & m_xtol;
-		ar & m_ftol;
-		ar & m_memory;
-		ar & m_mean;
-		ar & m_variation;
-		ar & m_newpop;
-		ar & m_B;
-		ar & m_D;
-		ar & m_C;
-		ar & m_invsqrtC;
-		ar & m_pc;
-		ar & m_ps;
-		ar & m_counteval;
-		ar & m_eigeneval;
+		ar >> boost::serialization::base_object<base>(*this);
+		ar >> m_gen;
+		ar >> m_cc;
+		ar >> m_cs;
+		ar >> m_c1;
+		ar >> m_cmu;
+		ar >> m_sigma;
+		// The covariance models, the restarts and the threads were added in version 1, along with
+		// the offspring stored as a matrix.
+		if (version >= 1) {
+			ar >> m_sigma0;
+		} else {
+			m_sigma0 = m_sigma;
+		}
+		ar >> m_xtol;
+		ar >> m_ftol;
+		ar >> m_memory;
+		if (version >= 1) {
+			ar >> m_variant;
+			ar >> m_n_paths;
+			ar >> m_restart;
+			ar >> m_threads;
+		} else {
+			m_variant = variant::FULL;
+			m_n_paths = -1;
+			m_restart = restart::NONE;
+			m_threads = 1;
+		}
+		ar >> m_mean;
+		ar >> m_variation;
+		if (version >= 1) {
+			ar >> m_newpop;
+		} else {
+			// Version 0 stored the offspring as a vector of columns.
+			std::vector<Eigen::VectorXd> newpop;
+			ar >> newpop;
+			m_newpop.resize(newpop.empty() ? 0 : newpop[0].size(),newpop.size());
+			for (std::vector<Eigen::VectorXd>::size_type i = 0; i < newpop.size(); ++i) {
+				m_newpop.col(i) = newpop[i];
+			}
+		}
+		ar >> m_B;
+		ar >> m_D;
+		ar >> m_C;
+		ar >> m_invsqrtC;
+		if (version >= 1) {
+			ar >> m_diagC;
+			ar >> m_paths;
+		} else {
+			m_diagC = Eigen::VectorXd::Zero(1);
+			m_paths = Eigen::MatrixXd();
+		}
+		ar >> m_pc;
+		ar >> m_ps;
+		ar >> m_counteval;
+		ar >> m_eigeneval;
+		// The restart state is that of an algorithm which has never restarted.
+		if (version >= 1) {
+			ar >> m_lambda;
+			ar >> m_n_large;
+			ar >> m_budget_small;
+			ar >> m_budget_large;
+		} else {
+			m_lambda = 0;
+			m_n_large = 0;
+			m_budget_small = 0;
+			m_budget_large = 0;
+		}
 	}
+	BOOST_SERIALIZATION_SPLIT_MEMBER()
 	// "Real" data members
 	std::size_t m_gen;
 	double m_cc;
@@ -114,26 +242,41 @@ private:
 	double m_c1;
 	double m_cmu;
 	mutable double m_sigma;
+	double m_sigma0;
 	double m_ftol;
 	double m_xtol;
 	bool m_memory;
+	variant::type m_variant;
+	int m_n_paths;
+	restart::type m_restart;
+	unsigned int m_threads;
 
 	// "Memory" data members (these are here as to enable control over each single generation)
 	mutable Eigen::VectorXd m_mean;
 	mutable Eigen::VectorXd m_variation;
-	mutable std::vector<Eigen::VectorXd> m_newpop;
+	mutable Eigen::MatrixXd m_newpop;
 	mutable Eigen::MatrixXd m_B;
 	mutable Eigen::MatrixXd m_D;
 	mutable Eigen::MatrixXd m_C;
 	mutable Eigen::MatrixXd m_invsqrtC;
+	// Diagonal of the covariance matrix (SEPARABLE)
+	mutable Eigen::VectorXd m_diagC;
+	// Evolution paths defining the transformation of the samples, one per column (LIMITED_MEMORY)
+	mutable Eigen::MatrixXd m_paths;
 	mutable Eigen::VectorXd m_pc;
 	mutable Eigen::VectorXd m_ps;
 	mutable int m_counteval;
 	mutable int m_eigeneval;
+	// Offspring size, number of restarts with increasing offspring size and evaluations spent in the two BIPOP regimes
+	mutable std::size_t m_lambda;
+	mutable int m_n_large;
+	mutable std::size_t m_budget_small;
+	mutable std::size_t m_budget_large;
 };
 
 }} //namespaces
 
 BOOST_CLASS_EXPORT_KEY(pagmo::algorithm::cmaes)
+BOOST_CLASS_VERSION(pagmo::algorithm::cmaes,1)
 
 #endif // PAGMO_ALGORITHM_CMAES_H
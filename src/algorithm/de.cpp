@@ -22,14 +22,17 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
+#include <functional>
 #include <string>
 #include <vector>
 
 #include "../exceptions.h"
 #include "../population.h"
 #include "../types.h"
+#include "../util/de_kernel.h"
 #include "base.h"
 #include "de.h"
 
@@ -78,7 +81,6 @@ void de::evolve(population &pop) const
 	// Let's store some useful variables.
 	const problem::base &prob = pop.problem();
 	const problem::base::size_type D = prob.get_dimension(), prob_i_dimension = prob.get_i_dimension(), prob_c_dimension = prob.get_c_dimension(), prob_f_dimension = prob.get_f_dimension();
-	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
 	const population::size_type NP = pop.size();
 	const problem::base::size_type Dc = D - prob_i_dimension;
 
@@ -104,219 +106,54 @@ void de::evolve(population &pop) const
 	if (m_gen == 0) {
 		return;
 	}
-	// Some vectors used during evolution are allocated here.
-	decision_vector dummy(D), tmp(D); //dummy is used for initialisation purposes, tmp to contain the mutated candidate
-	std::vector<decision_vector> popold(NP,dummy), popnew(NP,dummy);
-	decision_vector gbX(D),gbIter(D);
-	fitness_vector newfitness(prob_f_dimension);	//new fitness of the mutaded candidate
-	fitness_vector gbfit(prob_f_dimension);	//global best fitness
-	std::vector<fitness_vector> fit(NP,gbfit);
+	// The kernel holds the current population, and builds the trial vectors of a whole generation at once.
+	util::de_kernel kernel(NP,prob.get_lb(),prob.get_ub(),Dc);
+	const std::vector<const util::de_kernel::scheme *> schemes(NP,&util::de_kernel::get_variant(m_strategy));
+	const std::vector<double> F(NP,m_f), CR(NP,m_cr);
+	decision_vector tmp(D);
+	std::vector<fitness_vector> newfitness;	//new fitnesses of the mutated candidates
+	fitness_vector gbfit;	//global best fitness
+	decision_vector gbX;	//global best decision vector
+	std::vector<fitness_vector> fit(NP);
 
 	//We extract from pop the chromosomes and fitness associated
 	for (std::vector<double>::size_type i = 0; i < NP; ++i) {
-		popold[i] = pop.get_individual(i).cur_x;
+		kernel.set_x(i,pop.get_individual(i).cur_x);
 		fit[i] = pop.get_individual(i).cur_f;
 	}
-	popnew = popold;
 
 	// Initialise the global bests
 	gbX=pop.champion().x;
 	gbfit=pop.champion().f;
-	// container for the best decision vector of generation
-	gbIter = gbX;
 
 	// Main DE iterations
-	size_t r1,r2,r3,r4,r5;	//indexes to the selected population members
 	for (int gen = 0; gen < m_gen; ++gen) {
-		//Start of the loop through the deme
+		// The best member of the previous generation is used by the strategies involving the best member.
+		kernel.set_best(gbX);
+		kernel.draw_members(5,m_urng);
+		kernel.make_trials(schemes,F,CR,m_drng,m_urng);
+		const std::vector<decision_vector> &trials = kernel.get_trials();
+
+		// How good? The whole generation is evaluated at once.
+		prob.objfun_batch(newfitness,trials);
 		for (size_t i = 0; i < NP; ++i) {
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 2 !!!     */
-				r1 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while (r1==i);
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 3 !!!     */
-				r2 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while ((r2==i) || (r2==r1));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 4 !!!     */
-				r3 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while ((r3==i) || (r3==r1) || (r3==r2));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 5 !!!     */
-				r4 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while ((r4==i) || (r4==r1) || (r4==r2) || (r4==r3));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 6 !!!     */
-				r5 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while ((r5==i) || (r5==r1) || (r5==r2) || (r5==r3) || (r5==r4));
-
-
-			/*-------DE/best/1/exp--------------------------------------------------------------------*/
-			/*-------Our oldest strategy but still not bad. However, we have found several------------*/
-			/*-------optimization problems where misconvergence occurs.-------------------------------*/
-			if (m_strategy == 1) { /* strategy DE0 (not in our paper) */
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = gbIter[n] + m_f*(popold[r2][n]-popold[r3][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-
-			/*-------DE/rand/1/exp-------------------------------------------------------------------*/
-			/*-------This is one of my favourite strategies. It works especially well when the-------*/
-			/*-------"gbIter[]"-schemes experience misconvergence. Try e.g. m_f=0.7 and m_cr=0.5---------*/
-			/*-------as a first guess.---------------------------------------------------------------*/
-			else if (m_strategy == 2) { /* strategy DE1 in the techreport */
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = popold[r1][n] + m_f*(popold[r2][n]-popold[r3][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-
-			/*-------DE/rand-to-best/1/exp-----------------------------------------------------------*/
-			/*-------This strategy seems to be one of the best strategies. Try m_f=0.85 and m_cr=1.------*/
-			/*-------If you get misconvergence try to increase NP. If this doesn't help you----------*/
-			/*-------should play around with all three control variables.----------------------------*/
-			else if (m_strategy == 3) { /* similiar to DE2 but generally better */
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = tmp[n] + m_f*(gbIter[n] - tmp[n]) + m_f*(popold[r1][n]-popold[r2][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-			/*-------DE/best/2/exp is another powerful strategy worth trying--------------------------*/
-			else if (m_strategy == 4) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = gbIter[n] +
-						 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-			/*-------DE/rand/2/exp seems to be a robust optimizer for many functions-------------------*/
-			else if (m_strategy == 5) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = popold[r5][n] +
-						 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-
-			/*=======Essentially same strategies but BINOMIAL CROSSOVER===============================*/
-
-			/*-------DE/best/1/bin--------------------------------------------------------------------*/
-			else if (m_strategy == 6) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = gbIter[n] + m_f*(popold[r2][n]-popold[r3][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand/1/bin-------------------------------------------------------------------*/
-			else if (m_strategy == 7) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r1][n] + m_f*(popold[r2][n]-popold[r3][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand-to-best/1/bin-----------------------------------------------------------*/
-			else if (m_strategy == 8) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = tmp[n] + m_f*(gbIter[n] - tmp[n]) + m_f*(popold[r1][n]-popold[r2][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/best/2/bin--------------------------------------------------------------------*/
-			else if (m_strategy == 9) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = gbIter[n] +
-							 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand/2/bin--------------------------------------------------------------------*/
-			else if (m_strategy == 10) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r5][n] +
-							 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
-					}
-					n = (n+1)%Dc;
-				}
-			}
-
-
-			/*=======Trial mutation now in tmp[]. force feasibility and how good this choice really was.==================*/
-			// a) feasibility
-			size_t i2 = 0;
-			while (i2<Dc) {
-				if ((tmp[i2] < lb[i2]) || (tmp[i2] > ub[i2]))
-					tmp[i2] = boost::uniform_real<double>(lb[i2],ub[i2])(m_drng);
-				++i2;
-			}
-
-			//b) how good?
-			prob.objfun(newfitness, tmp);    /* Evaluate new vector in tmp[] */
-			if ( pop.problem().compare_fitness(newfitness,fit[i]) ) {  /* improved objective function value ? */
-				fit[i]=newfitness;
-				popnew[i] = tmp;
+			if ( prob.compare_fitness(newfitness[i],fit[i]) ) {  /* improved objective function value ? */
+				fit[i]=newfitness[i];
 				// As a fitness improvment occured we move the point
 				// and thus can evaluate a new velocity
-				std::transform(tmp.begin(), tmp.end(), pop.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
-				//updates x and v (cache avoids to recompute the objective function)
-				pop.set_x(i,popnew[i]);
+				std::transform(trials[i].begin(), trials[i].end(), pop.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
+				//updates x and v (with the known fitness, there are no constraints)
+				pop.set_x(i,trials[i],newfitness[i],constraint_vector());
 				pop.set_v(i,tmp);
-				if ( pop.problem().compare_fitness(newfitness,gbfit) ) {
+				// The new member enters the next generation.
+				kernel.set_x(i,trials[i]);
+				if ( prob.compare_fitness(newfitness[i],gbfit) ) {
 					/* if so...*/
-					gbfit=newfitness;          /* reset gbfit to new low...*/
-					gbX=popnew[i];
+					gbfit=newfitness[i];          /* reset gbfit to new low...*/
+					gbX=trials[i];
 				}
-			} else {
-				popnew[i] = popold[i];
 			}
-
-		}//End of the loop through the deme
-
-		/* Save best population member of current iteration */
-		gbIter = gbX;
-
-		/* swap population arrays. New generation becomes old one */
-		std::swap(popold, popnew);
-
+		}
 
 		//9 - Check the exit conditions (every 40 generations)
 		if (gen % 40 == 0) {
@@ -61,6 +61,9 @@ namespace pagmo { namespace algorithm {
  *
  * NOTE3: the velocity is also updated along DE whenever a new chromosome is accepted.
  *
+ * NOTE4: the trial vectors of a generation are all built by pagmo::util::de_kernel before being evaluated
+ * at once with pagmo::problem::base::objfun_batch().
+ *
  * @see http://www.icsi.berkeley.edu/~storn/code.html for the official DE web site
  * @see http://www.springerlink.com/content/x555692233083677/ for the paper that introduces Differential Evolution
  *
@@ -93,6 +96,7 @@ private:
 		ar & const_cast<double &>(m_xtol);
 		ar & const_cast<int &>(m_strategy);
 	}
+protected:
 	// Number of generations.
 	const int m_gen;
 	// Weighting factor
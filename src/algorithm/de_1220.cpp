@@ -22,16 +22,19 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
 #include <boost/random/normal_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
+#include <functional>
 #include <string>
 #include <vector>
 
 #include "../exceptions.h"
 #include "../population.h"
 #include "../types.h"
+#include "../util/de_kernel.h"
 #include "base.h"
 #include "de_1220.h"
 
@@ -112,36 +115,32 @@ void de_1220::evolve(population &pop) const
 	if (m_gen == 0) {
 		return;
 	}
-	// Some vectors used during evolution are allocated here.
-	decision_vector dummy(D), tmp(D); //dummy is used for initialisation purposes, tmp to contain the mutated candidate
-	std::vector<decision_vector> popold(NP,dummy), popnew(NP,dummy);
-	decision_vector gbX(D),gbIter(D);
-	fitness_vector newfitness(1);	//new fitness of the mutaded candidate
-	fitness_vector gbfit(1);	//global best fitness
-	std::vector<fitness_vector> fit(NP,gbfit);
+	// The kernel holds the current population, and builds the trial vectors of a whole generation at once.
+	util::de_kernel kernel(NP,lb,ub,Dc);
+	std::vector<const util::de_kernel::scheme *> schemes(NP);
+	std::vector<double> F(NP), CR(NP);
+	std::vector<int> VARIANT(NP);
+	decision_vector tmp(D);
+	std::vector<fitness_vector> newfitness;	//new fitnesses of the mutated candidates
+	fitness_vector gbfit;	//global best fitness
+	decision_vector gbX;	//global best decision vector
+	std::vector<fitness_vector> fit(NP);
 
 	//We extract from pop the chromosomes and fitness associated
 	for (std::vector<double>::size_type i = 0; i < NP; ++i) {
-		popold[i] = pop.get_individual(i).cur_x;
+		kernel.set_x(i,pop.get_individual(i).cur_x);
 		fit[i] = pop.get_individual(i).cur_f;
 	}
-	popnew = popold;
 
 	// Initialise the global bests
 	gbX=pop.champion().x;
 	gbfit=pop.champion().f;
-	// container for the best decision vector of generation
-	gbIter = gbX;
 	
 	// Initializing the random number generators
 	boost::normal_distribution<double> normal(0.0,1.0);
 	boost::variate_generator<boost::lagged_fibonacci607 &, boost::normal_distribution<double> > n_dist(m_drng,normal);
 	boost::uniform_real<double> uniform(0.0,1.0);
 	boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_real<double> > r_dist(m_drng,uniform);
-	boost::uniform_int<int> r_p_idx(0,NP-1);
-	boost::variate_generator<boost::mt19937 &, boost::uniform_int<int> > p_idx(m_urng,r_p_idx);
-	boost::uniform_int<int> r_c_idx(0,Dc-1);
-	boost::variate_generator<boost::mt19937 &, boost::uniform_int<int> > c_idx(m_urng,r_c_idx);
 	boost::uniform_int<int> r_v_idx(0,m_allowed_variants.size()-1);
 	boost::variate_generator<boost::mt19937 &, boost::uniform_int<int> > v_idx(m_urng,r_v_idx);
 
@@ -171,376 +170,59 @@ void de_1220::evolve(population &pop) const
 	double gbIterCR = m_cr[0];
 
 	// Main DE iterations
-	size_t r1,r2,r3,r4,r5,r6,r7;	//indexes to the selected population members
 	for (int gen = 0; gen < m_gen; ++gen) {
-		//Start of the loop through the deme
+		// The best member of the previous generation is used by the strategies involving the best member.
+		kernel.set_best(gbX);
+		kernel.draw_members(7,m_urng);
+
+		// Adapt amplification factor, crossover probability and variant
 		for (size_t i = 0; i < NP; ++i) {
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 2 !!!     */
-				r1 = p_idx();
-			} while (r1==i);
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 3 !!!     */
-				r2 = p_idx();
-			} while ((r2==i) || (r2==r1));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 4 !!!     */
-				r3 = p_idx();
-			} while ((r3==i) || (r3==r1) || (r3==r2));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 5 !!!     */
-				r4 = p_idx();
-			} while ((r4==i) || (r4==r1) || (r4==r2) || (r4==r3));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 6 !!!     */
-				r5 = p_idx();
-			} while ((r5==i) || (r5==r1) || (r5==r2) || (r5==r3) || (r5==r4));
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 7 !!!     */
-				r6 = p_idx();
-			} while ((r6==i) || (r6==r1) || (r6==r2) || (r6==r3) || (r6==r4) || (r6==r5));
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 8 !!!     */
-				r7 = p_idx();
-			} while ((r7==i) || (r7==r1) || (r7==r2) || (r7==r3) || (r7==r4) || (r7==r5) || (r7==r6));
-
-			// Adapt amplification factor and crossover probability
-			double F=0, CR=0;
-			int VARIANT=0;
 			if (m_variant_adptv==1) {
-				F =  (r_dist() < 0.9) ? m_f[i]  : r_dist() * 0.9 + 0.1;
-				CR = (r_dist() < 0.9) ? m_cr[i] : r_dist();
-			}
-			VARIANT = (r_dist() < 0.9) ? m_variants[i] : m_allowed_variants[v_idx()];
-				
-			/*-------DE/best/1/exp--------------------------------------------------------------------*/
-			/*-------Our oldest strategy but still not bad. However, we have found several------------*/
-			/*-------optimization problems where misconvergence occurs.-------------------------------*/
-			if (VARIANT == 1) { /* strategy DE0 (not in our paper) */
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 * (m_f[r2]-m_f[r3]);
-					CR = gbIterCR + n_dist() * 0.5 * (m_cr[r2]-m_cr[r3]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = gbIter[n] + F*(popold[r2][n]-popold[r3][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-
-			/*-------DE/rand/1/exp-------------------------------------------------------------------*/
-			/*-------This is one of my favourite strategies. It works especially well when the-------*/
-			/*-------"gbIter[]"-schemes experience misconvergence. Try e.g. m_f=0.7 and m_cr=0.5---------*/
-			/*-------as a first guess.---------------------------------------------------------------*/
-			else if (VARIANT == 2) { /* strategy DE1 in the techreport */
-				if (m_variant_adptv==2) {
-					F =  m_f[r1]  + n_dist() * 0.5 * (m_f[r2]-m_f[r3]);
-					CR = m_cr[r1] + n_dist() * 0.5 * (m_cr[r2]-m_cr[r3]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = popold[r1][n] + F*(popold[r2][n]-popold[r3][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-
-			/*-------DE/rand-to-best/1/exp-----------------------------------------------------------*/
-			/*-------This strategy seems to be one of the best strategies. Try m_f=0.85 and c=1.------*/
-			/*-------If you get misconvergence try to increase NP. If this doesn't help you----------*/
-			/*-------should play around with all three control variables.----------------------------*/
-			else if (VARIANT == 3) { /* similiar to DE2 but generally better */
-				if (m_variant_adptv==2) {
-					F =  m_f[i]  + n_dist() * 0.5 * (gbIterF-m_f[i]) +   n_dist() * 0.5 * (m_f[r1] - m_f[r2]);
-					CR = m_cr[i] + n_dist() * 0.5 * (gbIterCR-m_cr[i]) + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = tmp[n] + F*(gbIter[n] - tmp[n]) + F*(popold[r1][n]-popold[r2][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-			/*-------DE/best/2/exp is another powerful strategy worth trying--------------------------*/
-			else if (VARIANT == 4) {
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 *  (m_f[r1] - m_f[r3]) +   n_dist() * 0.5 * (m_f[r2] - m_f[r4]);
-					CR = gbIterCR  + n_dist() * 0.5 * (m_cr[r1] - m_cr[r3]) + n_dist() * 0.5 * (m_cr[r2] - m_cr[r4]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = gbIter[n] +
-						 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*F;
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-			/*-------DE/rand/2/exp seems to be a robust optimizer for many functions-------------------*/
-			else if (VARIANT == 5) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r5]  + n_dist() * 0.5 * (m_f[r1] - m_f[r3]) +   n_dist() * 0.5 * (m_f[r2] - m_f[r4]);
-					CR = m_cr[r5] + n_dist() * 0.5 * (m_cr[r1] - m_cr[r3]) + n_dist() * 0.5 * (m_cr[r2] - m_cr[r4]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = popold[r5][n] +
-						 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*F;
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-
-			/*=======Essentially same strategies but BINOMIAL CROSSOVER===============================*/
-
-			/*-------DE/best/1/bin--------------------------------------------------------------------*/
-			else if (VARIANT == 6) {
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 * (m_f[r2]-m_f[r3]);
-					CR = gbIterCR + n_dist() * 0.5 * (m_cr[r2]-m_cr[r3]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = gbIter[n] + F*(popold[r2][n]-popold[r3][n]);
-					}
-					n = (n+1)%Dc;
-				}
+				F[i] =  (r_dist() < 0.9) ? m_f[i]  : r_dist() * 0.9 + 0.1;
+				CR[i] = (r_dist() < 0.9) ? m_cr[i] : r_dist();
 			}
-			/*-------DE/rand/1/bin-------------------------------------------------------------------*/
-			else if (VARIANT == 7) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r1]  + n_dist() * 0.5 * (m_f[r2]-m_f[r3]);
-					CR = m_cr[r1] + n_dist() * 0.5 * (m_cr[r2]-m_cr[r3]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r1][n] + F*(popold[r2][n]-popold[r3][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand-to-best/1/bin-----------------------------------------------------------*/
-			else if (VARIANT == 8) {
-				if (m_variant_adptv==2) {
-					F =  m_f[i]  + n_dist() * 0.5 * (gbIterF-m_f[i]) +   n_dist() * 0.5 * (m_f[r1] - m_f[r2]);
-					CR = m_cr[i] + n_dist() * 0.5 * (gbIterCR-m_cr[i]) + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = tmp[n] + F*(gbIter[n] - tmp[n]) + F*(popold[r1][n]-popold[r2][n]);
-					}
-					n = (n+1)%Dc;
+			VARIANT[i] = (r_dist() < 0.9) ? m_variants[i] : m_allowed_variants[v_idx()];
+			schemes[i] = &util::de_kernel::get_variant(VARIANT[i]);
+			if (m_variant_adptv==2) {
+				F[i] = kernel.mutate_parameter(*schemes[i],i,m_f,gbIterF,n_dist);
+				CR[i] = kernel.mutate_parameter(*schemes[i],i,m_cr,gbIterCR,n_dist);
+				// The rand-to-current variants also use the difference between the fifth and sixth members.
+				if (VARIANT[i] == 15 || VARIANT[i] == 16) {
+					F[i] += n_dist() * 0.5 * (m_f[kernel.member(i,util::de_kernel::r5)] - m_f[kernel.member(i,util::de_kernel::r6)]);
+					CR[i] += n_dist() * 0.5 * (m_cr[kernel.member(i,util::de_kernel::r5)] - m_cr[kernel.member(i,util::de_kernel::r6)]);
 				}
 			}
-			/*-------DE/best/2/bin--------------------------------------------------------------------*/
-			else if (VARIANT == 9) {
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 *  (m_f[r1] - m_f[r3]) +   n_dist() * 0.5 * (m_f[r2] - m_f[r4]);
-					CR = gbIterCR  + n_dist() * 0.5 * (m_cr[r1] - m_cr[r3]) + n_dist() * 0.5 * (m_cr[r2] - m_cr[r4]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = gbIter[n] +
-							 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*F;
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand/2/bin--------------------------------------------------------------------*/
-			else if (VARIANT == 10) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r5]  + n_dist() * 0.5 * (m_f[r1] - m_f[r3]) +   n_dist() * 0.5 * (m_f[r2] - m_f[r4]);
-					CR = m_cr[r5] + n_dist() * 0.5 * (m_cr[r1] - m_cr[r3]) + n_dist() * 0.5 * (m_cr[r2] - m_cr[r4]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r5][n] +
-							 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*F;
-					}
-					n = (n+1)%Dc;
-				}
-			}
-
-			/*-------DE/best/3/exp--------------------------------------------------------------------*/
-			if (VARIANT == 11) {
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 * (m_f[r1] - m_f[r2]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = gbIterCR + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = gbIter[n] + F*(popold[r1][n]-popold[r2][n]) + F*(popold[r3][n]-popold[r4][n]) + F*(popold[r5][n]-popold[r6][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-			/*-------DE/best/3/bin--------------------------------------------------------------------*/
-			else if (VARIANT == 12) {
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 * (m_f[r1] - m_f[r2]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = gbIterCR + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = gbIter[n] + F*(popold[r1][n]-popold[r2][n]) + F*(popold[r3][n]-popold[r4][n]) + F*(popold[r5][n]-popold[r6][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand/3/exp--------------------------------------------------------------------*/
-			if (VARIANT == 13) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[r2]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[r2][n]) + F*(popold[r3][n]-popold[r4][n]) + F*(popold[r5][n]-popold[r6][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-			/*-------DE/rand/3/bin--------------------------------------------------------------------*/
-			else if (VARIANT == 14) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[r2]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[r2][n]) + F*(popold[r3][n]-popold[r4][n]) + F*(popold[r5][n]-popold[r6][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand-to-current/2/exp---------------------------------------------------------*/
-			if (VARIANT == 15) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[i]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[i]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[i][n]) + F*(popold[r3][n]-popold[r4][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-			/*-------DE/rand-to-current/2/bin---------------------------------------------------------*/
-			else if (VARIANT == 16) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[i]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[i]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[i][n]) + F*(popold[r3][n]-popold[r4][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand-to-best-and-current/2/exp------------------------------------------------*/
-			if (VARIANT == 17) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[i]) + n_dist() * 0.5 * (gbIterF - m_f[r4]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[i]) + n_dist() * 0.5 * (gbIterCR - m_cr[r4]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[i][n]) + F*(gbIter[n]-popold[r4][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-			/*-------DE/rand-to-best-and-current/2/bin------------------------------------------------*/
-			else if (VARIANT == 18) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[i]) + n_dist() * 0.5 * (gbIterF - m_f[r4]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[i]) + n_dist() * 0.5 * (gbIterCR - m_cr[r4]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[i][n]) + F*(gbIter[n]-popold[r4][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-
-			/*=======Trial mutation now in tmp[]. force feasibility and how good this choice really was.==================*/
-			// a) feasibility
-			size_t i2 = 0;
-			while (i2<Dc) {
-				if ((tmp[i2] < lb[i2]) || (tmp[i2] > ub[i2]))
-					tmp[i2] = r_dist() * (ub[i2]-lb[i2]) + lb[i2];
-				++i2;
-			}
+		}
+		kernel.make_trials(schemes,F,CR,m_drng,m_urng);
+		const std::vector<decision_vector> &trials = kernel.get_trials();
 
-			//b) how good?
-			prob.objfun(newfitness, tmp);    /* Evaluate new vector in tmp[] */
-			if ( pop.problem().compare_fitness(newfitness,fit[i]) ) {  /* improved objective function value ? */
-				fit[i]=newfitness;
-				popnew[i] = tmp;
+		// How good? The whole generation is evaluated at once.
+		prob.objfun_batch(newfitness,trials);
+		for (size_t i = 0; i < NP; ++i) {
+			if ( prob.compare_fitness(newfitness[i],fit[i]) ) {  /* improved objective function value ? */
+				fit[i]=newfitness[i];
 				
 				// Update the adapted parameters
-				m_cr[i] = CR;
-				m_f[i] = F;
-				m_variants[i] = VARIANT;
+				m_cr[i] = CR[i];
+				m_f[i] = F[i];
+				m_variants[i] = VARIANT[i];
 				
 				// As a fitness improvment occured we move the point
 				// and thus can evaluate a new velocity
-				std::transform(tmp.begin(), tmp.end(), pop.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
+				std::transform(trials[i].begin(), trials[i].end(), pop.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
 				
-				//updates x and v (cache avoids to recompute the objective function)
-				pop.set_x(i,popnew[i]);
+				//updates x and v (with the known fitness, there are no constraints)
+				pop.set_x(i,trials[i],newfitness[i],constraint_vector());
 				pop.set_v(i,tmp);
-				if ( pop.problem().compare_fitness(newfitness,gbfit) ) {
+				// The new member enters the next generation.
+				kernel.set_x(i,trials[i]);
+				if ( prob.compare_fitness(newfitness[i],gbfit) ) {
 					/* if so...*/
-					gbfit=newfitness;          /* reset gbfit to new low...*/
-					gbX=popnew[i];
+					gbfit=newfitness[i];          /* reset gbfit to new low...*/
+					gbX=trials[i];
 				}
-			} else {
-				popnew[i] = popold[i];
 			}
-
-		}//End of the loop through the deme
-
-		/* Save best population member of current iteration */
-		gbIter = gbX;
-
-		/* swap population arrays. New generation becomes old one */
-		std::swap(popold, popnew);
-
+		}
 
 		//9 - Check the exit conditions (every 40 generations)
 		if (gen%40) {
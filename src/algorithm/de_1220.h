@@ -49,6 +49,8 @@ namespace pagmo { namespace algorithm {
  *
  * NOTE3: the pagmo::population::individual_type::cur_v is also updated in DE 1220 as soon as a new chromosome is accepted.
  *
+ * NOTE4: each trial may use a different variant, all of them being described as schemes of pagmo::util::de_kernel.
+ *
  * @author Dario Izzo (dario.izzo@googlemail.com)
  */
 
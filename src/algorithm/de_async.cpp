@@ -0,0 +1,216 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../exceptions.h"
+#include "../population.h"
+#include "../types.h"
+#include "../util/async_evaluator.h"
+#include "../util/de_kernel.h"
+#include "base.h"
+#include "de.h"
+#include "de_async.h"
+
+namespace pagmo { namespace algorithm {
+
+/// Constructor.
+/**
+ * Allows to specify in detail all the parameters of the algorithm.
+ *
+ * @param[in] gen number of generations, i.e., the number of function evaluations divided by the population size.
+ * @param[in] f weight coefficient (dafault value is 0.8)
+ * @param[in] cr crossover probability (dafault value is 0.9)
+ * @param[in] strategy strategy (dafault strategy is 2: /rand/1/exp)
+ * @param[in] ftol stopping criteria on the f tolerance
+ * @param[in] xtol stopping criteria on the x tolerance
+ * @param[in] threads number of worker threads evaluating the trial vectors. If zero, the number of hardware threads is used.
+ * @throws value_error if f,cr are not in the [0,1] interval, strategy is not one of 1 .. 10, gen is negative
+ */
+de_async::de_async(int gen, double f, double cr, int strategy, double ftol, double xtol, unsigned int threads):
+	de(gen,f,cr,strategy,ftol,xtol),m_threads(threads) {}
+
+/// Clone method.
+base_ptr de_async::clone() const
+{
+	return base_ptr(new de_async(*this));
+}
+
+/// Evolve implementation.
+/**
+ * Run the steady-state DE algorithm until m_gen * pop.size() trial vectors have been evaluated, or one of the exit conditions is met.
+ * Whenever a trial vector replaces its parent the velocity is also updated.
+ *
+ * @param[in,out] pop input/output pagmo::population to be evolved.
+ *
+ * @throws std::runtime_error if the evaluation of a trial vector throws.
+ */
+void de_async::evolve(population &pop) const
+{
+	// Let's store some useful variables.
+	const problem::base &prob = pop.problem();
+	const problem::base::size_type D = prob.get_dimension(), prob_i_dimension = prob.get_i_dimension(), prob_c_dimension = prob.get_c_dimension(), prob_f_dimension = prob.get_f_dimension();
+	const population::size_type NP = pop.size();
+	const problem::base::size_type Dc = D - prob_i_dimension;
+
+	//We perform some checks to determine wether the problem/population are suitable for DE
+	if ( Dc == 0 ) {
+		pagmo_throw(value_error,"There is no continuous part in the problem decision vector for DE to optimise");
+	}
+
+	if ( prob_c_dimension != 0 ) {
+		pagmo_throw(value_error,"The problem is not box constrained and DE is not suitable to solve it");
+	}
+
+	if ( prob_f_dimension != 1 ) {
+		pagmo_throw(value_error,"The problem is not single objective and DE is not suitable to solve it");
+	}
+
+	if (NP < 6) {
+		pagmo_throw(value_error,"for DE at least 6 individuals in the population are needed");
+	}
+
+	// Get out if there is nothing to do.
+	if (m_gen == 0) {
+		return;
+	}
+
+	util::async_evaluator evaluator(prob,m_threads);
+	// Trial vectors being evaluated: enough to keep the workers busy while the results are processed, at most one per individual.
+	const std::size_t max_in_flight = std::min<std::size_t>(NP,2 * evaluator.get_n_threads());
+	const std::size_t max_evals = static_cast<std::size_t>(m_gen) * NP;
+
+	// The kernel holds the current population, and builds the trial vectors one at a time.
+	util::de_kernel kernel(NP,prob.get_lb(),prob.get_ub(),Dc);
+	const util::de_kernel::scheme &scheme = util::de_kernel::get_variant(m_strategy);
+	decision_vector tmp(D);
+	std::vector<fitness_vector> fit(NP);
+	for (population::size_type i = 0; i < NP; ++i) {
+		kernel.set_x(i,pop.get_individual(i).cur_x);
+		fit[i] = pop.get_individual(i).cur_f;
+	}
+	fitness_vector gbfit = pop.champion().f;
+	kernel.set_best(pop.champion().x);
+
+	// Individuals with no trial vector being evaluated, in the order they will be submitted.
+	std::deque<std::size_t> idle;
+	for (std::size_t i = 0; i < NP; ++i) {
+		idle.push_back(i);
+	}
+
+	util::async_evaluator::result r;
+	std::size_t n_submitted = 0, n_done = 0;
+	bool stop = false;
+	while (true) {
+		while (!stop && n_submitted < max_evals && !idle.empty() && evaluator.get_n_pending() < max_in_flight) {
+			const std::size_t i = idle.front();
+			idle.pop_front();
+			evaluator.submit(kernel.make_trial(i,5,scheme,m_f,m_cr,m_drng,m_urng),i);
+			++n_submitted;
+		}
+		if (!evaluator.get_n_pending()) {
+			break;
+		}
+		evaluator.get(r);
+		++n_done;
+		const std::size_t i = r.tag;
+		if (prob.compare_fitness(r.f,fit[i])) {
+			// As a fitness improvment occured we move the point and thus can evaluate a new velocity
+			std::transform(r.x.begin(), r.x.end(), kernel.get_x(i), tmp.begin(), std::minus<double>());
+			kernel.set_x(i,r.x);
+			fit[i] = r.f;
+			// The result of the evaluation is stored directly, without evaluating the objective function again.
+			pop.set_x(i,r.x,r.f,r.c);
+			pop.set_v(i,tmp);
+			if (prob.compare_fitness(r.f,gbfit)) {
+				gbfit = r.f;
+				kernel.set_best(r.x);
+			}
+		}
+		idle.push_back(i);
+
+		// Check the exit conditions (every 40 * NP evaluations). Once met, the trial vectors being evaluated are still collected.
+		if (stop || n_done % (40 * NP)) {
+			continue;
+		}
+		double dx = 0;
+		for (decision_vector::size_type k = 0; k < D; ++k) {
+			dx += std::fabs(pop.get_individual(pop.get_worst_idx()).best_x[k] - pop.get_individual(pop.get_best_idx()).best_x[k]);
+		}
+		if  ( dx < m_xtol ) {
+			if (m_screen_output) {
+				std::cout << "Exit condition -- xtol < " <<  m_xtol << std::endl;
+			}
+			stop = true;
+			continue;
+		}
+		double mah = std::fabs(pop.get_individual(pop.get_worst_idx()).best_f[0] - pop.get_individual(pop.get_best_idx()).best_f[0]);
+		if (mah < m_ftol) {
+			if (m_screen_output) {
+				std::cout << "Exit condition -- ftol < " <<  m_ftol << std::endl;
+			}
+			stop = true;
+			continue;
+		}
+		// outputs current values
+		if (m_screen_output) {
+			std::cout << "Evaluations " << n_done << " ***" << std::endl;
+			std::cout << "    Best global fitness: " << pop.champion().f << std::endl;
+			std::cout << "    xtol: " << dx << ", ftol: " << mah << std::endl;
+		}
+	}
+	if (!stop && m_screen_output) {
+		std::cout << "Exit condition -- generations > " <<  m_gen << std::endl;
+	}
+}
+
+/// Algorithm name
+std::string de_async::get_name() const
+{
+	return "Differential Evolution (asynchronous)";
+}
+
+/// Extra human readable algorithm info.
+/**
+ * @return a formatted string displaying the parameters of the algorithm.
+ */
+std::string de_async::human_readable_extra() const
+{
+	std::ostringstream s;
+	s << de::human_readable_extra() << ' ';
+	s << "threads:" << m_threads;
+	return s.str();
+}
+
+}} //namespaces
+
+BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::algorithm::de_async)
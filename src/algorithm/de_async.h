@@ -0,0 +1,82 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_ALGORITHM_DE_ASYNC_H
+#define PAGMO_ALGORITHM_DE_ASYNC_H
+
+#include <string>
+
+#include "../config.h"
+#include "../population.h"
+#include "../serialization.h"
+#include "base.h"
+#include "de.h"
+
+namespace pagmo { namespace algorithm {
+
+/// Asynchronous steady-state Differential Evolution
+/**
+ * Steady-state version of pagmo::algorithm::de, built on top of pagmo::util::async_evaluator. Trial vectors are submitted to
+ * a pool of worker threads and, as soon as the evaluation of a trial vector is over, it replaces its parent if it is better and a new
+ * trial vector is submitted for the same individual, so that no worker waits for the slowest evaluation of a generation.
+ * This is the variant of choice for problems whose evaluation is expensive and has a widely varying cost.
+ *
+ * Each individual has at most one trial vector being evaluated at any time. Trial vectors are built one at a time by
+ * pagmo::util::de_kernel, with the same strategies as pagmo::algorithm::de, from the current population and using its current
+ * best member as best member.
+ *
+ * At each call of the evolve method a number of function evaluations equal to m_gen * pop.size() is performed.
+ * The exit conditions on ftol and xtol are checked every 40 * pop.size() function evaluations.
+ *
+ * NOTE: the problem is cloned once per worker thread, and its objective function is called concurrently on the clones.
+ *
+ * @see pagmo::algorithm::de
+ */
+
+class __PAGMO_VISIBLE de_async: public de
+{
+public:
+	de_async(int = 100, double  = 0.8, double = 0.9, int = 2, double = 1e-6, double = 1e-6, unsigned int = 0);
+	base_ptr clone() const;
+	void evolve(population &) const;
+	std::string get_name() const;
+protected:
+	std::string human_readable_extra() const;
+private:
+	friend class boost::serialization::access;
+	template <class Archive>
+	void serialize(Archive &ar, const unsigned int)
+	{
+		ar & boost::serialization::base_object<de>(*this);
+		ar & const_cast<unsigned int &>(m_threads);
+	}
+	// Number of worker threads.
+	const unsigned int m_threads;
+};
+
+}}
+
+BOOST_CLASS_EXPORT_KEY(pagmo::algorithm::de_async)
+
+#endif // PAGMO_ALGORITHM_DE_ASYNC_H
@@ -53,6 +53,9 @@ namespace pagmo { namespace algorithm {
  *
  * NOTE3: the pagmo::population::individual_type::cur_v is also updated along DE as soon as a new chromosome is accepted.
  *
+ * NOTE4: F and CR are adapted for each individual, while the mutation and crossover of the whole generation are
+ * left to pagmo::util::de_kernel and the trials are evaluated as one batch.
+ *
  *
  * @see http://labraj.uni-mb.si/images/0/05/CEC09_slides_Brest.pdf  where m_variant_adptv = 1 is studied.
  * @see http://sci2s.ugr.es/EAMHCO/pdfs/contributionsCEC11/05949732.pdf for a paper where a similar apporach to m_variant_adptv=2 is described
@@ -22,8 +22,13 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
+#include <boost/ref.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
 #include <string>
 #include <vector>
 
@@ -45,9 +50,12 @@ namespace pagmo { namespace algorithm {
  * @param[in] perturb At the end of one iteration of mbh, each chromosome of each individual
  * will be perturbed within +-perturb*(ub-lb), the same for the velocity. The integer part is treated the same way.
  * rounding to the floor
- * @throws value_error if stop is negative or perturb is not in [0,1]
+ * @param[in] n_chains number of hopping chains run at each iteration
+ * @param[in] n_threads number of threads running the chains (0 means as many as the hardware supports)
+ * @throws value_error if stop is negative, perturb is not in [0,1] or n_chains is zero
  */
-mbh::mbh(const base & local, int stop, double perturb):base(),m_stop(stop),m_perturb(1,perturb)
+mbh::mbh(const base & local, int stop, double perturb, unsigned int n_chains, unsigned int n_threads):base(),m_stop(stop),m_perturb(1,perturb),
+	m_chains(n_chains),m_threads(n_threads)
 {
 	m_local = local.clone();
 	if (stop < 0) {
@@ -56,6 +64,9 @@ mbh::mbh(const base & local, int stop, double perturb):base(),m_stop(stop),m_per
 	if ((perturb < 0) || (perturb > 1)) {
 		pagmo_throw(value_error,"perturb must be positive");
 	}
+	if (n_chains == 0) {
+		pagmo_throw(value_error,"number of chains must be positive");
+	}
 }
 
 /// Constructor.
@@ -67,9 +78,12 @@ mbh::mbh(const base & local, int stop, double perturb):base(),m_stop(stop),m_per
  * @param[in] perturb At the end of one iteration of mbh, the i-th chromosome of each individual
  * will be perturbed within +-perturb[i]*(ub[i]-lb[i]), the same for the velocity. The integer part is treated the same way 
  * rounding to the floor
- * @throws value_error if stop is negative or perturb[i] is not in [0,1]
+ * @param[in] n_chains number of hopping chains run at each iteration
+ * @param[in] n_threads number of threads running the chains (0 means as many as the hardware supports)
+ * @throws value_error if stop is negative, perturb[i] is not in [0,1] or n_chains is zero
  */
-mbh::mbh(const base & local, int stop, const std::vector<double> &perturb):base(),m_stop(stop),m_perturb(perturb)
+mbh::mbh(const base & local, int stop, const std::vector<double> &perturb, unsigned int n_chains, unsigned int n_threads):base(),m_stop(stop),m_perturb(perturb),
+	m_chains(n_chains),m_threads(n_threads)
 {
 	m_local = local.clone();
 	if (stop < 0) {
@@ -82,10 +96,14 @@ mbh::mbh(const base & local, int stop, const std::vector<double> &perturb):base(
 		}
 	}
 	if (perturb.size()==0) pagmo_throw(value_error,"perturbation vector appears empty!!");
+	if (n_chains == 0) {
+		pagmo_throw(value_error,"number of chains must be positive");
+	}
 }
 
 /// Copy constructor.
-mbh::mbh(const mbh &algo):base(algo),m_local(algo.m_local->clone()),m_stop(algo.m_stop),m_perturb(algo.m_perturb)
+mbh::mbh(const mbh &algo):base(algo),m_local(algo.m_local->clone()),m_stop(algo.m_stop),m_perturb(algo.m_perturb),
+	m_chains(algo.m_chains),m_threads(algo.m_threads)
 {}
 
 /// Clone method.
@@ -94,21 +112,76 @@ base_ptr mbh::clone() const
 	return base_ptr(new mbh(*this));
 }
 
+// A hopping chain: the perturbed population is built on the copy of the problem, and evolved with the copy
+// of the algorithm.
+struct mbh::chain
+{
+	void operator()()
+	{
+		try {
+			pert_pop.reset(new population(*prob,0,seed));
+			for (std::vector<decision_vector>::size_type j = 0; j < x.size(); ++j) {
+				pert_pop->push_back(x[j]);
+				pert_pop->set_v(j,v[j]);
+			}
+			local->evolve(*pert_pop);
+		} catch (const std::exception &e) {
+			err = e.what();
+			if (err.empty()) {
+				err = "error while running a hopping chain";
+			}
+		}
+	}
+	base_ptr			local;
+	problem::base_ptr		prob;
+	unsigned int			seed;
+	std::vector<decision_vector>	x;
+	std::vector<decision_vector>	v;
+	boost::shared_ptr<population>	pert_pop;
+	std::string			err;
+};
+
+// Perturb the decision vector and the velocity of the individual j of pop within the selected neighbourhood.
+void mbh::perturb(decision_vector &tmp_x, decision_vector &tmp_v, const population &pop, population::size_type j) const
+{
+	const problem::base &prob = pop.problem();
+	const problem::base::size_type D = prob.get_dimension(), Dc = D - prob.get_i_dimension();
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+	double dummy, width;
+	for (decision_vector::size_type k=0; k < Dc; ++k)
+	{
+		dummy = pop.get_individual(j).best_x[k];
+		width = m_perturb[k];
+		tmp_x[k] = boost::uniform_real<double>(std::max(dummy-width*(ub[k]-lb[k]),lb[k]),std::min(dummy+width*(ub[k]-lb[k]),ub[k]))(m_drng);
+		dummy = pop.get_individual(j).cur_v[k];
+		tmp_v[k] = boost::uniform_real<double>(dummy-width*(ub[k]-lb[k]),dummy+width*(ub[k]-lb[k]))(m_drng);
+	}
+
+	for (decision_vector::size_type k=Dc; k < D; ++k)
+	{
+		dummy = pop.get_individual(j).best_x[k];
+		width = m_perturb[k];
+		tmp_x[k] = boost::uniform_int<int>(std::max(dummy-std::floor(width*(ub[k]-lb[k])),lb[k]),std::min(dummy+std::floor(width*(ub[k]-lb[k])),ub[k]))(m_urng);
+		dummy = pop.get_individual(j).cur_v[k];
+		tmp_v[k] = boost::uniform_int<int>(std::max(dummy-std::floor(width*(ub[k]-lb[k])),lb[k]),std::min(dummy+std::floor(width*(ub[k]-lb[k])),ub[k]))(m_urng);
+	}
+}
+
 /// Evolve implementation.
 /**
  * Run the MBH algorithm
  *
  * @param[in,out] pop input/output pagmo::population to be evolved.
+ *
+ * @throws value_error if a hopping chain throws
  */
 
 void mbh::evolve(population &pop) const
 {
 	// Let's store some useful variables.
 	const problem::base &prob = pop.problem();
-	const problem::base::size_type D = prob.get_dimension(), prob_i_dimension = prob.get_i_dimension();
-	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+	const problem::base::size_type D = prob.get_dimension();
 	const population::size_type NP = pop.size();
-	const problem::base::size_type Dc = D - prob_i_dimension;
 
 	//Check if the perturbation vector has size 1, in which case it fills up the whole vector with
 	//the same number
@@ -128,45 +201,93 @@ void mbh::evolve(population &pop) const
 		return;
 	}
 
+	unsigned int n_threads = m_threads;
+	if (n_threads == 0) {
+		n_threads = std::max(boost::thread::hardware_concurrency(), 1u);
+	}
+	n_threads = std::min(n_threads,m_chains);
+
 	// Some dummies and temporary variables
 	decision_vector tmp_x(D), tmp_v(D);
-	double dummy, width;
 
-	// Init the best fitness and constraint vector
-	population pert_pop(pop);
+	// Serial path: the chains are evolved one after the other with the local algorithm itself, on a single
+	// perturbed population.
+	boost::scoped_ptr<population> serial_pop, serial_best;
+	if (n_threads == 1) {
+		serial_pop.reset(new population(pop));
+	}
 
 	int i = 0;
 
 	//mbh main loop
 	while (i<m_stop){
+		// Result of the best chain (the first one, in case of ties), subject to the improvement criterion.
+		const population *best_pop = 0;
+		std::vector<chain> chains;
+		if (n_threads == 1) {
+			for (unsigned int c = 0; c < m_chains; ++c)
+			{
+				//1. Perturb the current population
+				serial_pop->clear();
+				for (population::size_type j =0; j < NP; ++j)
+				{
+					perturb(tmp_x,tmp_v,pop,j);
+					serial_pop->push_back(tmp_x);
+					pop.set_v(j,tmp_v);
+				}
 
-		//1. Perturb the current population
-		pert_pop.clear();
-		for (population::size_type j =0; j < NP; ++j)
-		{
-			for (decision_vector::size_type k=0; k < Dc; ++k)
+				//2. Evolve population with selected algorithm
+				m_local->evolve(*serial_pop);
+				if (m_chains == 1) {
+					best_pop = serial_pop.get();
+				} else if (!best_pop || prob.compare_fc(serial_pop->champion().f,serial_pop->champion().c,best_pop->champion().f,best_pop->champion().c)) {
+					serial_best.reset(new population(*serial_pop));
+					best_pop = serial_best.get();
+				}
+			}
+		} else {
+			//1. Perturb the current population, once per chain
+			chains.resize(m_chains);
+			for (unsigned int c = 0; c < m_chains; ++c)
 			{
-				dummy = pop.get_individual(j).best_x[k];
-				width = m_perturb[k];
-				tmp_x[k] = boost::uniform_real<double>(std::max(dummy-width*(ub[k]-lb[k]),lb[k]),std::min(dummy+width*(ub[k]-lb[k]),ub[k]))(m_drng);
-				dummy = pop.get_individual(j).cur_v[k];
-				tmp_v[k] = boost::uniform_real<double>(dummy-width*(ub[k]-lb[k]),dummy+width*(ub[k]-lb[k]))(m_drng);
+				for (population::size_type j =0; j < NP; ++j)
+				{
+					perturb(tmp_x,tmp_v,pop,j);
+					chains[c].x.push_back(tmp_x);
+					chains[c].v.push_back(tmp_v);
+				}
+				chains[c].local = m_local->clone();
+				chains[c].local->reset_rngs(m_urng());
+				chains[c].prob = prob.clone();
+				chains[c].seed = m_urng();
 			}
 
-			for (decision_vector::size_type k=Dc; k < D; ++k)
-			{
-				dummy = pop.get_individual(j).best_x[k];
-				width = m_perturb[k];
-				tmp_x[k] = boost::uniform_int<int>(std::max(dummy-std::floor(width*(ub[k]-lb[k])),lb[k]),std::min(dummy+std::floor(width*(ub[k]-lb[k])),ub[k]))(m_urng);
-				dummy = pop.get_individual(j).cur_v[k];
-				tmp_v[k] = boost::uniform_int<int>(std::max(dummy-std::floor(width*(ub[k]-lb[k])),lb[k]),std::min(dummy+std::floor(width*(ub[k]-lb[k])),ub[k]))(m_urng);
+			//2. Evolve the perturbed populations with selected algorithm, in rounds of n_threads concurrent chains,
+			// each round being joined before the next one starts.
+			for (unsigned int first = 0; first < m_chains; first += n_threads) {
+				boost::thread_group threads;
+				for (unsigned int c = first; c < std::min(first + n_threads,m_chains); ++c) {
+					threads.create_thread(boost::ref(chains[c]));
+				}
+				threads.join_all();
 			}
-			pert_pop.push_back(tmp_x);
-			pop.set_v(j,tmp_v);
+			for (unsigned int c = 0; c < m_chains; ++c) {
+				if (!chains[c].err.empty()) {
+					pagmo_throw(value_error,chains[c].err.c_str());
+				}
+			}
+			unsigned int best = 0;
+			for (unsigned int c = 1; c < m_chains; ++c) {
+				const population &p_c = *chains[c].pert_pop, &p_best = *chains[best].pert_pop;
+				if (prob.compare_fc(p_c.champion().f,p_c.champion().c,p_best.champion().f,p_best.champion().c)) {
+					best = c;
+				}
+			}
+			best_pop = chains[best].pert_pop.get();
 		}
+		i++;
 
-		//2. Evolve population with selected algorithm
-		m_local->evolve(pert_pop); i++;
+		const population &pert_pop = *best_pop;
 		if (m_screen_output)
 		{
 			std::cout << i << ". " << "\tLocal solution: " << pert_pop.champion().f << "\tGlobal best: " << pop.champion().f;
@@ -231,6 +352,12 @@ std::string mbh::human_readable_extra() const
 	s << "algorithm: " << m_local->get_name() << ' ';
 	s << "stop:" << m_stop << ' ';
 	s << "perturb:" << m_perturb << ' ';
+	if (m_chains != 1) {
+		s << "chains:" << m_chains << ' ';
+	}
+	if (m_threads != 1) {
+		s << "threads:" << m_threads << ' ';
+	}
 	return s.str();
 }
 
@@ -66,6 +66,12 @@ namespace pagmo { namespace algorithm {
 
 @endverbatim
  *
+ * Several hopping chains can be run at each iteration: each chain perturbs the current population in the
+ * selected neighbourhood and evolves it, and the best of the resulting populations is then subject to the improvement
+ * criterion above. With a single thread (the default), the chains are evolved one after the other with the algorithm
+ * itself. With more threads, each chain is evolved with its own copies of the algorithm and of the problem, on different
+ * threads: the perturbations and the seeds of the copies of the algorithm are drawn from the rngs of mbh, so that the
+ * results depend only on its seed (see base::reset_rngs()) and on the number of chains, not on the number of threads.
  *
  * @see http://arxiv.org/pdf/cond-mat/9803344 for the paper inroducing the basin hopping idea for a Lennard-Jones cluster optimization
  *
@@ -75,8 +81,8 @@ namespace pagmo { namespace algorithm {
 class __PAGMO_VISIBLE mbh: public base
 {
 public:
-	mbh(const base & = cs(), int stop = 5, double perturb = 5e-2);
-	mbh(const base &, int stop, const std::vector<double> &perturb);
+	mbh(const base & = cs(), int stop = 5, double perturb = 5e-2, unsigned int n_chains = 1, unsigned int n_threads = 1);
+	mbh(const base &, int stop, const std::vector<double> &perturb, unsigned int n_chains = 1, unsigned int n_threads = 1);
 	mbh(const mbh &);
 	base_ptr clone() const;
 	void evolve(population &) const;
@@ -86,24 +92,39 @@ public:
 protected:
 	std::string human_readable_extra() const;
 private:
+	struct chain;
+	void perturb(decision_vector &, decision_vector &, const population &, population::size_type) const;
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & boost::serialization::base_object<base>(*this);
 		ar & m_local;
 		ar & const_cast<int &>(m_stop);
 		ar & m_perturb;
+		// The chains and the threads were added in version 1.
+		if (version >= 1) {
+			ar & const_cast<unsigned int &>(m_chains);
+			ar & const_cast<unsigned int &>(m_threads);
+		} else {
+			const_cast<unsigned int &>(m_chains) = 1;
+			const_cast<unsigned int &>(m_threads) = 1;
+		}
 	}
 	base_ptr m_local;
 	// Consecutive non improving iterations
 	const int m_stop;
 	// Perturbation of the population
 	mutable std::vector<double> m_perturb;
+	// Number of hopping chains
+	const unsigned int m_chains;
+	// Number of threads running the chains
+	const unsigned int m_threads;
 };
 
 }} //namespaces
 
 BOOST_CLASS_EXPORT_KEY(pagmo::algorithm::mbh)
+BOOST_CLASS_VERSION(pagmo::algorithm::mbh,1)
 
 #endif // PAGMO_ALGORITHM_MBH_H
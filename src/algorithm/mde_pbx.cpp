@@ -32,10 +32,12 @@
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include <functional>
 
 #include "../exceptions.h"
 #include "../population.h"
 #include "../types.h"
+#include "../util/de_kernel.h"
 #include "base.h"
 #include "mde_pbx.h"
 
@@ -114,8 +116,21 @@ void mde_pbx::evolve(population &pop) const
 		return;
 	}
 	// Some vectors used during evolution are allocated here.
-	decision_vector dummy(D), tmp(D); 		//dummy is used for initialisation purposes, tmp to contain the mutated candidate
-	fitness_vector newfitness(1);			//new fitness of the mutated candidate
+	decision_vector tmp(D);
+	std::vector<fitness_vector> newfitness;		//new fitnesses of the mutated candidates
+
+	// The kernel holds the population at the beginning of the generation, and builds the trial vectors of the whole
+	// generation at once: current-to-gr_best/1 mutation, with the non-crossed components taken from a p-best individual.
+	util::de_kernel kernel(NP,lb,ub,D);
+	const util::de_kernel::scheme gr_best = {util::de_kernel::current,2,{util::de_kernel::r1,util::de_kernel::r2},
+		{util::de_kernel::current,util::de_kernel::r3},util::de_kernel::binomial};
+	const std::vector<const util::de_kernel::scheme *> schemes(NP,&gr_best);
+	std::vector<double> F(NP), CR(NP);
+	std::vector<fitness_vector> fit(NP);
+	for (population::size_type i = 0; i < NP; ++i) {
+		kernel.set_x(i,pop.get_individual(i).cur_x);
+		fit[i] = pop.get_individual(i).cur_f;
+	}
 
 	// reserve space for saving successful values for f and cr. This guarantees that no memory is allocated during
 	// the main loop
@@ -126,9 +141,6 @@ void mde_pbx::evolve(population &pop) const
 	boost::uniform_real<double> uniform(0.0,1.0);
 	boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_real<double> > r_dist(m_drng,uniform);
 
-	boost::uniform_int<decision_vector::size_type> r_c_idx(0,D-1);
-	boost::variate_generator<boost::mt19937 &, boost::uniform_int<decision_vector::size_type> > c_idx(m_urng,r_c_idx);
-	
 	boost::uniform_int<population::size_type> r_p_idx(0,NP-1);
 	boost::variate_generator<boost::mt19937 &, boost::uniform_int<population::size_type> > p_idx(m_urng,r_p_idx);
 	
@@ -137,17 +149,12 @@ void mde_pbx::evolve(population &pop) const
 	
 	// Declaring temporary variables used by the main-loop
 	population::size_type p;
-	population::size_type r1, r2, bestq_idx, bestp_idx, j_rand;
+	population::size_type r1, r2, bestq_idx, bestp_idx;
 	std::vector<population::size_type> a(NP-1,0);
-	double cri, fi; //, wcr, wf;
 
 	// **** Main Loop of MDE-pBX ****
 	for (int gen = 0; gen < m_gen; ++gen) {
 		
-		// make a snapshot of the current population
-		// as we loop over individuals pop will contain the new generation while pop_old remains unchanged
-		pagmo::population pop_old(pop);
-		
 		// clear the sets of successful scale factors and crossover probabilities
 		m_fsuccess.clear();
 		m_crsuccess.clear();
@@ -157,7 +164,7 @@ void mde_pbx::evolve(population &pop) const
 		p = ceil((NP / 2.0) * ( 1.0 - (double)(gen) / m_gen));
 
 		// get the p-best individuals
-		std::vector<population::size_type> pbest = pop_old.get_best_idx(p);
+		std::vector<population::size_type> pbest = pop.get_best_idx(p);
 		
 		// loop through all individuals
 		for (pagmo::population::size_type i = 0; i < NP; ++i) {
@@ -176,7 +183,7 @@ void mde_pbx::evolve(population &pop) const
 			// find index of individual from q% sample with best fitness
 			bestq_idx = a[0];
 			for (pagmo::population::size_type k = 1; k < NP_Part; ++k) {
-				if ( prob.compare_fitness(pop_old.get_individual(a[k]).cur_f, pop_old.get_individual(bestq_idx).cur_f) ) {
+				if ( prob.compare_fitness(fit[a[k]], fit[bestq_idx]) ) {
 					bestq_idx = a[k];
 				}
 			}
@@ -196,51 +203,45 @@ void mde_pbx::evolve(population &pop) const
 			
 			// sample scale factors
 			//do {
-				cri = 0.1 * gauss()+m_crm;
+				CR[i] = 0.1 * gauss()+m_crm;
 			//} while ((cri <= 0.0) || (cri >=1.0));
 
 // FIRST difference from the paper cri is not resampled, just trimmed
-			cri = std::min(1.0,std::max(0.0,cri));
+			CR[i] = std::min(1.0,std::max(0.0,CR[i]));
 			
 
 // SECOND difference from paper, fi is half trimmed and half resampled
 			do {
-				fi = m_fm + 0.1 * tan(boost::math::constants::pi<double>() * ( r_dist() - 0.5 ));
-				fi = std::min(1.0,fi);
-			} while (fi <= 0.0); // || (fi >=1.0));
-			
-			// fix a random dimension index
-			j_rand = c_idx();
-
-			// Mutation + Crossover
-			for (size_t j = 0; j < D; ++j) {
-				if (j == j_rand || r_dist() < cri) {
-					tmp[j] = pop_old.get_individual(i).cur_x[j] + fi * (pop_old.get_individual(bestq_idx).cur_x[j] - pop_old.get_individual(i).cur_x[j] + pop_old.get_individual(r1).cur_x[j] - pop_old.get_individual(r2).cur_x[j]);
-// The paper does not speak about constraint enforcing ....
-					if ((tmp[j] < lb[j]) || (tmp[j] > ub[j])) { // enforce box-bounds
-						tmp[j] = lb[j]+ r_dist()*(ub[j]-lb[j]);
-					}
-				} else {
-					tmp[j] = pop_old.get_individual(bestp_idx).cur_x[j];
-				}
-			}
-			
-			/*=======Trial mutation now in tmp[] and feasible. Test how good this choice really was.==========*/
+				F[i] = m_fm + 0.1 * tan(boost::math::constants::pi<double>() * ( r_dist() - 0.5 ));
+				F[i] = std::min(1.0,F[i]);
+			} while (F[i] <= 0.0); // || (fi >=1.0));
+
+			kernel.member(i,util::de_kernel::r1) = bestq_idx;
+			kernel.member(i,util::de_kernel::r2) = r1;
+			kernel.member(i,util::de_kernel::r3) = r2;
+			kernel.set_donor(i,bestp_idx);
+		}
 
+		// Mutation + Crossover (the paper does not speak about constraint enforcing, the components
+		// out of the bounds are re-initialised)
+		kernel.make_trials(schemes,F,CR,m_drng,m_urng);
+		const std::vector<decision_vector> &trials = kernel.get_trials();
 			
-			// b) Compare with the objective function
-			prob.objfun(newfitness, tmp);    /* Evaluate new vector in tmp[] and records it fitness in newfitness */
-			if ( pop.problem().compare_fitness(newfitness,pop_old.get_individual(i).cur_f) ) {  /* improved objective function value ? */
+		// Compare with the objective function, the whole generation being evaluated at once
+		prob.objfun_batch(newfitness,trials);
+		for (pagmo::population::size_type i = 0; i < NP; ++i) {
+			if ( prob.compare_fitness(newfitness[i],fit[i]) ) {  /* improved objective function value ? */
 				// As a fitness improvement occured we 
-				pop.set_x(i,tmp);
+				pop.set_x(i,trials[i],newfitness[i],constraint_vector());
 				// and thus can evaluate a new velocity
-				std::transform(tmp.begin(), tmp.end(), pop_old.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
-				// updates  v (cache avoids to recompute the objective function)
+				std::transform(trials[i].begin(), trials[i].end(), kernel.get_x(i), tmp.begin(),std::minus<double>());
 				pop.set_v(i,tmp);
-				// pop_old.set_x(i,tmp); (un-comment for a steady-state version)
+				// the improved individual enters the next generation
+				fit[i] = newfitness[i];
+				kernel.set_x(i,trials[i]);
 				// remember the successful scale factors
-				m_crsuccess.push_back(cri);
-				m_fsuccess.push_back(fi);
+				m_crsuccess.push_back(CR[i]);
+				m_fsuccess.push_back(F[i]);
 			}
 		} // end of one generation (loop over individuals)
 		
@@ -22,8 +22,12 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
+#include <boost/ref.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
 #include <string>
 #include <vector>
 
@@ -42,9 +46,10 @@ namespace pagmo { namespace algorithm {
  *
  * @param[in] algorithm pagmo::algorithm for the multistarts
  * @param[in] starts number of multistarts
+ * @param[in] n_threads number of starts run at a time on different threads (0 means as many as the hardware supports)
  * @throws value_error if starts is negative
  */
-ms::ms(const base &algorithm, int starts):base(),m_starts(starts)
+ms::ms(const base &algorithm, int starts, unsigned int n_threads):base(),m_starts(starts),m_threads(n_threads)
 {
 	m_algorithm = algorithm.clone();
 	if (starts < 0) {
@@ -53,7 +58,7 @@ ms::ms(const base &algorithm, int starts):base(),m_starts(starts)
 }
 
 /// Copy constructor (deep copy).
-ms::ms(const ms &other):base(other),m_algorithm(other.m_algorithm->clone()),m_starts(other.m_starts) {}
+ms::ms(const ms &other):base(other),m_algorithm(other.m_algorithm->clone()),m_starts(other.m_starts),m_threads(other.m_threads) {}
 
 /// Clone method.
 base_ptr ms::clone() const
@@ -61,11 +66,37 @@ base_ptr ms::clone() const
 	return base_ptr(new ms(*this));
 }
 
+// A single start: a random population of the given size is built on the copy of the problem, and evolved
+// with the copy of the algorithm.
+struct ms::local_search
+{
+	void operator()()
+	{
+		try {
+			result.reset(new population(*prob,size,seed));
+			algo->evolve(*result);
+		} catch (const std::exception &e) {
+			err = e.what();
+			if (err.empty()) {
+				err = "error while running a start";
+			}
+		}
+	}
+	base_ptr			algo;
+	problem::base_ptr		prob;
+	population::size_type		size;
+	unsigned int			seed;
+	boost::shared_ptr<population>	result;
+	std::string			err;
+};
+
 /// Evolve implementation.
 /**
  * Run the Multi-start algorithm
  *
  * @param[in,out] pop input/output pagmo::population to be evolved.
+ *
+ * @throws value_error if a start throws
  */
 
 void ms::evolve(population &pop) const
@@ -78,26 +109,67 @@ void ms::evolve(population &pop) const
 		return;
 	}
 
-	// Local population used in the algorithm iterations.
-	population working_pop(pop);
+	unsigned int n_threads = m_threads;
+	if (n_threads == 0) {
+		n_threads = std::max(boost::thread::hardware_concurrency(), 1u);
+	}
+
+	if (n_threads == 1) {
+		// Serial path: the starts run one after the other with the algorithm itself, on a single working population.
+		population working_pop(pop);
+		for (int i = 0; i < m_starts; ++i) {
+			working_pop.reinit();
+			m_algorithm->evolve(working_pop);
+			merge_start(pop,working_pop,i);
+		}
+		return;
+	}
 
-	//ms main loop
-	for (int i=0; i< m_starts; ++i)
+	//ms main loop, n_threads starts at a time
+	for (int first = 0; first < m_starts; first += n_threads)
 	{
-		working_pop.reinit();
-		m_algorithm->evolve(working_pop);
-		if (working_pop.problem().compare_fc(working_pop.get_individual(working_pop.get_best_idx()).cur_f,working_pop.get_individual(working_pop.get_best_idx()).cur_c,
-			pop.get_individual(pop.get_worst_idx()).cur_f,pop.get_individual(pop.get_worst_idx()).cur_c
-		) )
-		{
-			//update best population replacing its worst individual with the good one just produced.
-			pop.set_x(pop.get_worst_idx(),working_pop.get_individual(working_pop.get_best_idx()).cur_x);
-			pop.set_v(pop.get_worst_idx(),working_pop.get_individual(working_pop.get_best_idx()).cur_v);
+		std::vector<local_search> searches(std::min<int>(n_threads,m_starts - first));
+		for (std::vector<local_search>::size_type k = 0; k < searches.size(); ++k) {
+			searches[k].algo = m_algorithm->clone();
+			searches[k].algo->reset_rngs(m_urng());
+			searches[k].prob = pop.problem().clone();
+			searches[k].size = NP;
+			searches[k].seed = m_urng();
 		}
-		if (m_screen_output)
-		{
-			std::cout << i << ". " << "\tCurrent iteration best: " << working_pop.get_individual(working_pop.get_best_idx()).cur_f << "\tOverall champion: " << pop.champion().f << std::endl;
+		if (searches.size() == 1) {
+			searches[0]();
+		} else {
+			boost::thread_group threads;
+			for (std::vector<local_search>::size_type k = 0; k < searches.size(); ++k) {
+				threads.create_thread(boost::ref(searches[k]));
+			}
+			threads.join_all();
 		}
+		for (std::vector<local_search>::size_type k = 0; k < searches.size(); ++k) {
+			if (!searches[k].err.empty()) {
+				pagmo_throw(value_error,searches[k].err.c_str());
+			}
+		}
+		for (std::vector<local_search>::size_type k = 0; k < searches.size(); ++k) {
+			merge_start(pop,*searches[k].result,first + static_cast<int>(k));
+		}
+	}
+}
+
+// Replace the worst individual of pop with the best individual of the population evolved by start i, if better.
+void ms::merge_start(population &pop, const population &working_pop, int i) const
+{
+	if (working_pop.problem().compare_fc(working_pop.get_individual(working_pop.get_best_idx()).cur_f,working_pop.get_individual(working_pop.get_best_idx()).cur_c,
+		pop.get_individual(pop.get_worst_idx()).cur_f,pop.get_individual(pop.get_worst_idx()).cur_c
+	) )
+	{
+		//update best population replacing its worst individual with the good one just produced.
+		pop.set_x(pop.get_worst_idx(),working_pop.get_individual(working_pop.get_best_idx()).cur_x);
+		pop.set_v(pop.get_worst_idx(),working_pop.get_individual(working_pop.get_best_idx()).cur_v);
+	}
+	if (m_screen_output)
+	{
+		std::cout << i << ". " << "\tCurrent iteration best: " << working_pop.get_individual(working_pop.get_best_idx()).cur_f << "\tOverall champion: " << pop.champion().f << std::endl;
 	}
 }
 
@@ -137,6 +209,9 @@ std::string ms::human_readable_extra() const
 	std::ostringstream s;
 	s << "algorithm: " << m_algorithm->get_name() << ' ';
 	s << "iter:" << m_starts << ' ';
+	if (m_threads != 1) {
+		s << "threads:" << m_threads << ' ';
+	}
 	return s.str();
 }
 
@@ -51,6 +51,13 @@ namespace pagmo { namespace algorithm {
 > > Reset the population
 > > evolve the population with the pagmo::algorithm
 @endverbatim
+ *
+ * With a single thread (the default), the starts run one after the other with the algorithm itself. With more
+ * threads, the starts are independent: each one runs on its own copies of the algorithm and of the problem, with
+ * the rngs of the algorithm and of the random population seeded from the rng of ms. Several starts are then
+ * run at a time on different threads, and the results depend only on the seed of ms (see base::reset_rngs()),
+ * not on the number of threads. The populations of each batch of concurrent starts are merged into the
+ * input population in the order of the starts.
  *
  *
  * @author Dario Izzo (dario.izzo@googlemail.com)
@@ -59,7 +66,7 @@ namespace pagmo { namespace algorithm {
 class __PAGMO_VISIBLE ms: public base
 {
 public:
-	ms(const base & = de(), int = 1);
+	ms(const base & = de(), int = 1, unsigned int = 1);
 	ms(const ms &);
 	base_ptr clone() const;
 	void evolve(population &) const;
@@ -69,20 +76,31 @@ public:
 protected:
 	std::string human_readable_extra() const;
 private:
+	struct local_search;
+	void merge_start(population &, const population &, int) const;
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & boost::serialization::base_object<base>(*this);
 		ar & m_algorithm;
 		ar & m_starts;
+		// The number of threads was added in version 1.
+		if (version >= 1) {
+			ar & m_threads;
+		} else {
+			m_threads = 1;
+		}
 	}
 	base_ptr m_algorithm;
 	int m_starts;
+	// Number of starts run at a time.
+	unsigned int m_threads;
 };
 
 }} //namespaces
 
 BOOST_CLASS_EXPORT_KEY(pagmo::algorithm::ms)
+BOOST_CLASS_VERSION(pagmo::algorithm::ms,1)
 
 #endif // PAGMO_ALGORITHM_MS_H
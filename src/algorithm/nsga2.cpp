@@ -272,6 +272,7 @@ void nsga2::evolve(population &pop) const
 	std::vector<population::size_type> best_idx(NP), shuffle1(NP),shuffle2(NP);
 	population::size_type parent1_idx, parent2_idx;
 	decision_vector child1(D), child2(D);
+	std::vector<decision_vector> survivors(NP);
 
 	for (pagmo::population::size_type i=0; i< NP; i++) shuffle1[i] = i;
 	for (pagmo::population::size_type i=0; i< NP; i++) shuffle2[i] = i;
@@ -281,10 +282,11 @@ void nsga2::evolve(population &pop) const
 
 	// Main NSGA-II loop
 	for (int g = 0; g<m_gen; g++) {
-		//At each generation we make a copy of the population into popnew
-		// We compute the crowding distance and the pareto rank of pop
+		// We compute the crowding distance and the pareto rank of pop. The offsprings are then appended
+		// directly to pop: the ranks and crowding distances used by the tournament selection are not
+		// updated by push_back, so the selection only sees the NP parents. This avoids copying the
+		// population (and cloning its problem) at each generation.
 		pop.update_pareto_information();
-		population popnew(pop);
 
 		//We create some pseudo-random permutation of the poulation indexes
 		std::random_shuffle(shuffle1.begin(),shuffle1.end(),p_idx);
@@ -299,8 +301,8 @@ void nsga2::evolve(population &pop) const
 			crossover(child1, child2, parent1_idx,parent2_idx,pop);
 			mutate(child1,pop);
 			mutate(child2,pop);
-			popnew.push_back(child1);
-			popnew.push_back(child2);
+			pop.push_back(child1);
+			pop.push_back(child2);
 
 			// We repeat with the shuffled list 2
 			parent1_idx = tournament_selection(shuffle2[i], shuffle2[i+1],pop);
@@ -308,17 +310,18 @@ void nsga2::evolve(population &pop) const
 			crossover(child1, child2, parent1_idx,parent2_idx,pop);
 			mutate(child1,pop);
 			mutate(child2,pop);
-			popnew.push_back(child1);
-			popnew.push_back(child2);
-		} // popnew now contains 2NP individuals
+			pop.push_back(child1);
+			pop.push_back(child2);
+		} // pop now contains 2NP individuals
 
 		// This method returns the sorted N best individuals in the population according to the crowded comparison operator
 		// defined in population.cpp
-		best_idx = popnew.get_best_idx(NP);
+		best_idx = pop.get_best_idx(NP);
+		for (population::size_type i=0; i < NP; ++i) survivors[i] = pop.get_individual(best_idx[i]).cur_x;
 		// We completely cancel the population (NOTE: memory of all individuals and the notion of
 		// champion is thus destroyed)
 		pop.clear();
-		for (population::size_type i=0; i < NP; ++i) pop.push_back(popnew.get_individual(best_idx[i]).cur_x);
+		for (population::size_type i=0; i < NP; ++i) pop.push_back(survivors[i]);
 	} // end of main SGA loop
 }
 
@@ -344,10 +344,8 @@ void pade::evolve(population &pop) const
 	if(m_threads >= NP) { //asynchronous island evolution
 		arch.evolve(m_gen);
 		arch.join();
-	} else {
-		for(int g = 0; g < m_gen; ++g) { //batched island evolution
-			arch.evolve_batch(1, m_threads);
-		}
+	} else { //island evolution on a pool of m_threads threads
+		arch.evolve_pool(m_gen, m_threads);
 	}
 
 	// Finally, we assemble the evolved population selecting from the original one + the evolved one
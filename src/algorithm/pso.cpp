@@ -24,10 +24,13 @@
 
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <vector>
 #include <cmath>
 #include <iostream>
 
+#include "../problem/base_stochastic.h"
+#include "../util/async_evaluator.h"
 #include "pso.h"
 
 namespace pagmo { namespace algorithm {
@@ -48,10 +51,14 @@ namespace pagmo { namespace algorithm {
  * to a radius of k = neighb_param / 2 in the ring. If the Randomly-varying neighbourhood topology
  * is selected (neighb_type=4), neighb_param represents each particle's maximum outdegree in the swarm topology.
  * The minimum outdegree is 1 (the particle always connects back to itself).
+ * @param[in] synchronous if true, the whole swarm moves before being evaluated as a batch
+ * @param[in] threads number of threads evaluating the swarm in synchronous mode, if 0 the number of hardware threads is used
  * @throws value_error if m_omega is not in the [0,1] interval, eta1, eta2 are not in the [0,1] interval,
  * vcoeff is not in ]0,1], variant is not one of 1 .. 6, neighb_type is not one of 1 .. 4
  */
-pso::pso(int gen, double omega, double eta1, double eta2, double vcoeff, int variant, int neighb_type, int neighb_param):base(),m_gen(gen),m_omega(omega),m_eta1(eta1),m_eta2(eta2),m_vcoeff(vcoeff),m_variant(variant),m_neighb_type(neighb_type),m_neighb_param(neighb_param) {
+pso::pso(int gen, double omega, double eta1, double eta2, double vcoeff, int variant, int neighb_type, int neighb_param, bool synchronous, unsigned int threads):
+	base(),m_gen(gen),m_omega(omega),m_eta1(eta1),m_eta2(eta2),m_vcoeff(vcoeff),m_variant(variant),m_neighb_type(neighb_type),m_neighb_param(neighb_param),
+	m_synchronous(synchronous),m_threads(threads) {
 	if (gen < 0) {
 		pagmo_throw(value_error,"number of generations must be nonnegative");
 	}
@@ -146,10 +153,8 @@ void pso::evolve(population &pop) const
 	decision_vector minv(Dc), maxv(Dc);			// Maximum and minimum velocity allowed
 	
 	double vwidth;						// Temporary variable
-	double new_x;						// Temporary variable
 	
 	population::size_type    p;		// for iterating over particles
-	population::size_type    n;		// for iterating over particles's neighbours
 	problem::base::size_type d;		// for iterating over problem dimensions
 	
 	
@@ -185,12 +190,13 @@ void pso::evolve(population &pop) const
 	}
 	
 	
-	// auxiliary varibables specific to the Fully Informed Particle Swarm variant
-	double acceleration_coefficient = m_eta1 + m_eta2;
-	double sum_forces;
-	
-	double r1 = 0.0;
-	double r2 = 0.0;
+	// In synchronous mode the swarm is evaluated as a batch, in parallel if requested. The threads are kept for all the generations.
+	const population::size_type block = m_synchronous ? swarm_size : 1;
+	boost::scoped_ptr<util::async_evaluator> evaluator;
+	if (m_synchronous && m_threads != 1 && !dynamic_cast<const problem::base_stochastic *>(&prob)) {
+		evaluator.reset(new util::async_evaluator(prob,m_threads));
+	}
+	util::async_evaluator::result r;
 	
 	/* --- Main PSO loop ---
 	 */
@@ -199,144 +205,49 @@ void pso::evolve(population &pop) const
 		
 		best_fit_improved = false;
 		
-		// For each particle in the swarm
-		for( p = 0; p < swarm_size; p++ ){
+		// For each block of particles in the swarm (the whole swarm in synchronous mode, one particle otherwise)
+		for( population::size_type first = 0; first < swarm_size; first += block ){
 			
-			// identify the current particle's best neighbour
-			// . not needed if m_neighb_type == 1 (gbest): best_neighb directly tracked in this function
-			// . not needed if m_variant == 6 (FIPS): all neighbours are considered, no need to identify the best one
-			if( m_neighb_type != 1 && m_variant != 6)
-				best_neighb = particle__get_best_neighbor( p, neighb, lbX, lbfit, prob );
+			for( p = first; p < first + block; p++ ){
+				// identify the current particle's best neighbour
+				// . not needed if m_neighb_type == 1 (gbest): best_neighb directly tracked in this function
+				// . not needed if m_variant == 6 (FIPS): all neighbours are considered, no need to identify the best one
+				if( m_neighb_type != 1 && m_variant != 6)
+					best_neighb = particle__get_best_neighbor( p, neighb, lbX, lbfit, prob );
 				
-			
-			/*-------PSO canonical (with inertia weight) ---------------------------------------------*/
-			/*-------Original algorithm used in PaGMO paper-------------------------------------------*/
-			if( m_variant == 1 ){
-				for( d = 0; d < Dc; d++ ){
-					r1 = m_drng();
-					r2 = m_drng();
-					V[p][d] = m_omega * V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r2 * (best_neighb[d] - X[p][d]);
-				}
+				particle__move( p, X[p], V[p], lbX, best_neighb, neighb, minv, maxv, lb, ub );
 			}
 			
-			/*-------PSO canonical (with inertia weight) ---------------------------------------------*/
-			/*-------and with equal random weights of social and cognitive components-----------------*/
-			/*-------Check with Rastrigin-------------------------------------------------------------*/
-			else if( m_variant == 2 ){
-				for( d = 0; d < Dc; d++ ){
-					r1 = m_drng();
-					V[p][d] = m_omega * V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r1 * (best_neighb[d] - X[p][d]);
-				}
+			// We evaluate here the new fitness of the block, as to be able to update the global best in real time
+			if( block == 1 ){
+				prob.objfun( fit[first], X[first] );
 			}
-			
-			/*-------PSO variant (commonly mistaken in literature for the canonical)----------------*/
-			/*-------Same random number for all components------------------------------------------*/
-			else if( m_variant == 3 ){
-				r1 = m_drng();
-				r2 = m_drng();
-				for( d = 0; d < Dc; d++ ){
-					V[p][d] = m_omega * V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r2 * (best_neighb[d] - X[p][d]);
+			else if( evaluator ){
+				for( p = 0; p < swarm_size; p++ )
+					evaluator->submit( X[p], p );
+				for( p = 0; p < swarm_size; p++ ){
+					evaluator->get( r );
+					fit[r.tag].swap( r.f );
 				}
 			}
-			
-			/*-------PSO variant (commonly mistaken in literature for the canonical)----------------*/
-			/*-------Same random number for all components------------------------------------------*/
-			/*-------and with equal random weights of social and cognitive components---------------*/
-			else if( m_variant == 4 ){
-				r1 = m_drng();
-				for( d = 0; d < Dc; d++ ){
-					V[p][d] = m_omega * V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r1 * (best_neighb[d] - X[p][d]);
-				}
-			}
-			
-			/*-------PSO variant with constriction coefficients------------------------------------*/
-			/*  ''Clerc's analysis of the iterative system led him to propose a strategy for the
-			 *  placement of "constriction coefficients" on the terms of the formulas; these
-			 *  coefficients controlled the convergence of the particle and allowed an elegant and
-			 *  well-explained method for preventing explosion, ensuring convergence, and
-			 *  eliminating the arbitrary Vmax parameter. The analysis also takes the guesswork
-			 *  out of setting the values of phi_1 and phi_2.''
-			 *  ''this is the canonical particle swarm algorithm of today.''
-			 *  [Poli et al., 2007] http://dx.doi.org/10.1007/s11721-007-0002-0
-			 *  [Clerc and Kennedy, 2002] http://dx.doi.org/10.1109/4235.985692
-			 *  
-			 *  This being the canonical PSO of today, this variant is set as the default in PaGMO.
-			 *-------------------------------------------------------------------------------------*/
-			else if( m_variant == 5 ){
-				for( d = 0; d < Dc; d++ ){
-					r1 = m_drng();
-					r2 = m_drng();
-					V[p][d] = m_omega * ( V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r2 * (best_neighb[d] - X[p][d]) );
-				}
+			else {
+				prob.objfun_batch( fit, X );
 			}
+			m_fevals += block;
 			
-			/*-------Fully Informed Particle Swarm-------------------------------------------------*/
-			/*  ''Whereas in the traditional algorithm each particle is affected by its own
-			 *  previous performance and the single best success found in its neighborhood, in
-			 *  Mendes' fully informed particle swarm (FIPS), the particle is affected by all its
-			 *  neighbors, sometimes with no influence from its own previous success.'' 
-			 *  ''With good parameters, FIPS appears to find better solutions in fewer iterations
-			 *  than the canonical algorithm, but it is much more dependent on the population topology.''
-			 *  [Poli et al., 2007] http://dx.doi.org/10.1007/s11721-007-0002-0
-			 *  [Mendes et al., 2004] http://dx.doi.org/10.1109/TEVC.2004.826074
-			 *-------------------------------------------------------------------------------------*/
-			else if( m_variant == 6 ){
-				for( d = 0; d < Dc; d++ ){
-					sum_forces = 0.0;
-					for( n = 0; n < neighb[p].size(); n++ )
-						sum_forces += m_drng() * acceleration_coefficient * ( lbX[ neighb[p][n] ][d] - X[p][d] );
+			for( p = first; p < first + block; p++ ){
+				if( prob.compare_fitness( fit[p], lbfit[p] ) ){
+					// update the particle's previous best position
+					lbfit[p] = fit[p];
+					lbX[p] = X[p];
 					
-					V[p][d] = m_omega * ( V[p][d] + sum_forces / neighb[p].size() );
-				}
-			}
-			
-			// We now check that the velocity does not exceed the maximum allowed per component
-			// and we perform the position update and the feasibility correction
-			for( d = 0; d < Dc; d++ ){
-				
-				if( V[p][d] > maxv[d] )
-					V[p][d] = maxv[d];
-				
-				else if( V[p][d] < minv[d] )
-					V[p][d] = minv[d];
-				
-				// update position
-				new_x = X[p][d] + V[p][d];
-				
-				// feasibility correction
-				// (velocity updated to that which would have taken the previous position
-				// to the newly corrected feasible position)
-				if( new_x < lb[d] ){
-					new_x = lb[d];
-					V[p][d] = 0.0;
-//					new_x = boost::uniform_real<double>(lb[d],ub[d])(m_drng);
-//					V[p][d] = new_x - X[p][d];
-				}
-				else if( new_x > ub[d] ){
-					new_x = ub[d];
-					V[p][d] = 0.0;
-//					new_x = boost::uniform_real<double>(lb[d],ub[d])(m_drng);
-//					V[p][d] = new_x - X[p][d];
-				}
-				
-				X[p][d] = new_x;
-			}
-			
-			// We evaluate here the new individual fitness as to be able to update the global best in real time
-			prob.objfun( fit[p], X[p] );
-			m_fevals++;
-			
-			if( prob.compare_fitness( fit[p], lbfit[p] ) ){
-				// update the particle's previous best position
-				lbfit[p] = fit[p];
-				lbX[p] = X[p];
-				
-				// update the best position observed so far by any particle in the swarm
-				// (only performed if swarm topology is gbest)
-				if( ( m_neighb_type == 1 || m_neighb_type == 4 ) && prob.compare_fitness( fit[p], best_fit ) ){
-					best_neighb = X[p];
-					best_fit    = fit[p];
-					best_fit_improved = true;
+					// update the best position observed so far by any particle in the swarm
+					// (only performed if swarm topology is gbest)
+					if( ( m_neighb_type == 1 || m_neighb_type == 4 ) && prob.compare_fitness( fit[p], best_fit ) ){
+						best_neighb = X[p];
+						best_fit    = fit[p];
+						best_fit_improved = true;
+					}
 				}
 			}
 		
@@ -349,15 +260,161 @@ void pso::evolve(population &pop) const
 	} // end of main PSO loop
 	
 	
-	// copy particles' positions & velocities back to the main population
+	// copy particles' positions & velocities back to the main population, with their known fitness
+	pop.set_xs( lbX, lbfit );	// sets: cur_x, cur_f, best_x, best_f
+	pop.set_xs( X, fit );		// sets: cur_x, cur_f
 	for( p = 0; p < swarm_size; p++ ){
-		pop.set_x( p, lbX[p] );		// sets: cur_x, cur_f, best_x, best_f
-		pop.set_x( p, X[p] );		// sets: cur_x, cur_f
 		pop.set_v( p, V[p] );		// sets: cur_v
 	}
 }
 
 
+/**
+ *  @brief Update the velocity and the position of a particle
+ *  
+ *  The velocity is updated according to the selected variant and clamped to the maximum allowed velocity, then the position
+ *  is updated and brought back within the bounds.
+ *  
+ *  @param[in] p index to the particle under consideration
+ *  @param[in,out] X particle's position
+ *  @param[in,out] V particle's velocity
+ *  @param[in] lbX particles' previous best positions
+ *  @param[in] best_neighb best position already visited by the particle's neighbours (not used by FIPS)
+ *  @param[in] neighb definition of the swarm's topology
+ *  @param[in] minv minimum velocity allowed
+ *  @param[in] maxv maximum velocity allowed
+ *  @param[in] lb lower bounds
+ *  @param[in] ub upper bounds
+ */
+void pso::particle__move( population::size_type p, decision_vector &X, decision_vector &V, const std::vector<decision_vector> &lbX, const decision_vector &best_neighb, const std::vector< std::vector<int> > &neighb, const decision_vector &minv, const decision_vector &maxv, const decision_vector &lb, const decision_vector &ub ) const
+{
+	const problem::base::size_type Dc = minv.size();
+	problem::base::size_type d;		// for iterating over problem dimensions
+	population::size_type    n;		// for iterating over particles's neighbours
+	double new_x;				// Temporary variable
+	
+	// auxiliary varibables specific to the Fully Informed Particle Swarm variant
+	double acceleration_coefficient = m_eta1 + m_eta2;
+	double sum_forces;
+	
+	double r1 = 0.0;
+	double r2 = 0.0;
+	
+	/*-------PSO canonical (with inertia weight) ---------------------------------------------*/
+	/*-------Original algorithm used in PaGMO paper-------------------------------------------*/
+	if( m_variant == 1 ){
+		for( d = 0; d < Dc; d++ ){
+			r1 = m_drng();
+			r2 = m_drng();
+			V[d] = m_omega * V[d] + m_eta1 * r1 * (lbX[p][d] - X[d]) + m_eta2 * r2 * (best_neighb[d] - X[d]);
+		}
+	}
+	
+	/*-------PSO canonical (with inertia weight) ---------------------------------------------*/
+	/*-------and with equal random weights of social and cognitive components-----------------*/
+	/*-------Check with Rastrigin-------------------------------------------------------------*/
+	else if( m_variant == 2 ){
+		for( d = 0; d < Dc; d++ ){
+			r1 = m_drng();
+			V[d] = m_omega * V[d] + m_eta1 * r1 * (lbX[p][d] - X[d]) + m_eta2 * r1 * (best_neighb[d] - X[d]);
+		}
+	}
+	
+	/*-------PSO variant (commonly mistaken in literature for the canonical)----------------*/
+	/*-------Same random number for all components------------------------------------------*/
+	else if( m_variant == 3 ){
+		r1 = m_drng();
+		r2 = m_drng();
+		for( d = 0; d < Dc; d++ ){
+			V[d] = m_omega * V[d] + m_eta1 * r1 * (lbX[p][d] - X[d]) + m_eta2 * r2 * (best_neighb[d] - X[d]);
+		}
+	}
+	
+	/*-------PSO variant (commonly mistaken in literature for the canonical)----------------*/
+	/*-------Same random number for all components------------------------------------------*/
+	/*-------and with equal random weights of social and cognitive components---------------*/
+	else if( m_variant == 4 ){
+		r1 = m_drng();
+		for( d = 0; d < Dc; d++ ){
+			V[d] = m_omega * V[d] + m_eta1 * r1 * (lbX[p][d] - X[d]) + m_eta2 * r1 * (best_neighb[d] - X[d]);
+		}
+	}
+	
+	/*-------PSO variant with constriction coefficients------------------------------------*/
+	/*  ''Clerc's analysis of the iterative system led him to propose a strategy for the
+	 *  placement of "constriction coefficients" on the terms of the formulas; these
+	 *  coefficients controlled the convergence of the particle and allowed an elegant and
+	 *  well-explained method for preventing explosion, ensuring convergence, and
+	 *  eliminating the arbitrary Vmax parameter. The analysis also takes the guesswork
+	 *  out of setting the values of phi_1 and phi_2.''
+	 *  ''this is the canonical particle swarm algorithm of today.''
+	 *  [Poli et al., 2007] http://dx.doi.org/10.1007/s11721-007-0002-0
+	 *  [Clerc and Kennedy, 2002] http://dx.doi.org/10.1109/4235.985692
+	 *  
+	 *  This being the canonical PSO of today, this variant is set as the default in PaGMO.
+	 *-------------------------------------------------------------------------------------*/
+	else if( m_variant == 5 ){
+		for( d = 0; d < Dc; d++ ){
+			r1 = m_drng();
+			r2 = m_drng();
+			V[d] = m_omega * ( V[d] + m_eta1 * r1 * (lbX[p][d] - X[d]) + m_eta2 * r2 * (best_neighb[d] - X[d]) );
+		}
+	}
+	
+	/*-------Fully Informed Particle Swarm-------------------------------------------------*/
+	/*  ''Whereas in the traditional algorithm each particle is affected by its own
+	 *  previous performance and the single best success found in its neighborhood, in
+	 *  Mendes' fully informed particle swarm (FIPS), the particle is affected by all its
+	 *  neighbors, sometimes with no influence from its own previous success.'' 
+	 *  ''With good parameters, FIPS appears to find better solutions in fewer iterations
+	 *  than the canonical algorithm, but it is much more dependent on the population topology.''
+	 *  [Poli et al., 2007] http://dx.doi.org/10.1007/s11721-007-0002-0
+	 *  [Mendes et al., 2004] http://dx.doi.org/10.1109/TEVC.2004.826074
+	 *-------------------------------------------------------------------------------------*/
+	else if( m_variant == 6 ){
+		for( d = 0; d < Dc; d++ ){
+			sum_forces = 0.0;
+			for( n = 0; n < neighb[p].size(); n++ )
+				sum_forces += m_drng() * acceleration_coefficient * ( lbX[ neighb[p][n] ][d] - X[d] );
+			
+			V[d] = m_omega * ( V[d] + sum_forces / neighb[p].size() );
+		}
+	}
+	
+	// We now check that the velocity does not exceed the maximum allowed per component
+	// and we perform the position update and the feasibility correction
+	for( d = 0; d < Dc; d++ ){
+		
+		if( V[d] > maxv[d] )
+			V[d] = maxv[d];
+		
+		else if( V[d] < minv[d] )
+			V[d] = minv[d];
+		
+		// update position
+		new_x = X[d] + V[d];
+		
+		// feasibility correction
+		// (velocity updated to that which would have taken the previous position
+		// to the newly corrected feasible position)
+		if( new_x < lb[d] ){
+			new_x = lb[d];
+			V[d] = 0.0;
+//					new_x = boost::uniform_real<double>(lb[d],ub[d])(m_drng);
+//					V[d] = new_x - X[d];
+		}
+		else if( new_x > ub[d] ){
+			new_x = ub[d];
+			V[d] = 0.0;
+//					new_x = boost::uniform_real<double>(lb[d],ub[d])(m_drng);
+//					V[d] = new_x - X[d];
+		}
+		
+		X[d] = new_x;
+	}
+}
+
+
 /**
  *  @brief Get information on the best position already visited by any of a particle's neighbours
  *  
@@ -588,6 +645,8 @@ std::string pso::human_readable_extra() const
 	s << "topology:" << m_neighb_type << ' ';
 	if( m_neighb_type == 2 || m_neighb_type == 4 )
 		s << "topology param.:" << m_neighb_param << ' ';
+	if( m_synchronous )
+		s << "synchronous threads:" << m_threads << ' ';
 	return s.str();
 }
 
@@ -25,7 +25,10 @@
 #ifndef PAGMO_ALGORITHM_PSO_H
 #define PAGMO_ALGORITHM_PSO_H
 
+#include <vector>
+
 #include "../config.h"
+#include "../population.h"
 #include "../serialization.h"
 #include "base.h"
 
@@ -63,6 +66,11 @@ namespace pagmo { namespace algorithm {
  * is performed.
  * 
  * The algorithm is suitable for box-constrained single-objective continuous optimization.
+ *
+ * By default the particles are updated asynchronously: each particle is evaluated right after its move, and
+ * the best positions it finds are immediately visible to the particles moving after it. In synchronous mode all the
+ * particles move first, using the best positions of the previous generation, and the whole swarm is then evaluated as
+ * a batch (on a pool of threads if requested, see util::async_evaluator).
  * 
  * @see http://www.particleswarm.info/ for a repository of information related to PSO
  * @see http://dx.doi.org/10.1007/s11721-007-0002-0 for a recent survey
@@ -75,7 +83,8 @@ namespace pagmo { namespace algorithm {
 class __PAGMO_VISIBLE pso: public base
 {
 public:
-	pso(int gen=1, double omega = 0.7298, double eta1 = 2.05, double eta2 = 2.05, double vcoeff = 0.5, int variant = 5, int neighb_type = 2, int neighb_param = 4 );
+	pso(int gen=1, double omega = 0.7298, double eta1 = 2.05, double eta2 = 2.05, double vcoeff = 0.5, int variant = 5, int neighb_type = 2, int neighb_param = 4,
+		bool synchronous = false, unsigned int threads = 1 );
 	base_ptr clone() const;
 	void evolve(population &) const;
 	decision_vector particle__get_best_neighbor( population::size_type pidx, std::vector< std::vector<int> > &neighb, const std::vector<decision_vector> &lbX, const std::vector<fitness_vector> &lbfit, const problem::base &prob ) const;
@@ -86,10 +95,11 @@ public:
 	std::string get_name() const;
 protected:
 	std::string human_readable_extra() const;
+	void particle__move( population::size_type p, decision_vector &X, decision_vector &V, const std::vector<decision_vector> &lbX, const decision_vector &best_neighb, const std::vector< std::vector<int> > &neighb, const decision_vector &minv, const decision_vector &maxv, const decision_vector &lb, const decision_vector &ub ) const;
 private:
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & boost::serialization::base_object<base>(*this);
 		ar & const_cast<int &>(m_gen);
@@ -100,7 +110,16 @@ private:
 		ar & const_cast<int &>(m_variant);
 		ar & const_cast<int &>(m_neighb_type);
 		ar & const_cast<int &>(m_neighb_param);
+		// The synchronous mode and the threads were added in version 1.
+		if (version >= 1) {
+			ar & const_cast<bool &>(m_synchronous);
+			ar & const_cast<unsigned int &>(m_threads);
+		} else {
+			const_cast<bool &>(m_synchronous) = false;
+			const_cast<unsigned int &>(m_threads) = 1;
+		}
 	}  
+protected:
 	// Number of generations
 	const int m_gen;
 	// Particle Inertia weight, or alternatively the constriction coefficient
@@ -117,10 +136,15 @@ private:
 	const int m_neighb_type;
 	// parameterization of the swarm topology
 	const int m_neighb_param;
+	// Synchronous update of the swarm
+	const bool m_synchronous;
+	// Number of threads evaluating the swarm in synchronous mode (always used by pso_async)
+	const unsigned int m_threads;
 };
 
 }} //namespaces
 
 BOOST_CLASS_EXPORT_KEY(pagmo::algorithm::pso)
+BOOST_CLASS_VERSION(pagmo::algorithm::pso,1)
 
 #endif // PSO_H
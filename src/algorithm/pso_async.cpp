@@ -0,0 +1,223 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../exceptions.h"
+#include "../population.h"
+#include "../types.h"
+#include "../util/async_evaluator.h"
+#include "pso.h"
+#include "pso_async.h"
+
+namespace pagmo { namespace algorithm {
+
+/// Constructor.
+/**
+ * Allows to specify in detail all the parameters of the algorithm.
+ *
+ * @param[in] gen number of generations, i.e., the number of function evaluations divided by the swarm size
+ * @param[in] omega particles' inertia weight, or alternatively, the constriction coefficient (usage depends on the variant used)
+ * @param[in] eta1 magnitude of the force, applied to the particle's velocity, in the direction of its previous best position
+ * @param[in] eta2 magnitude of the force, applied to the particle's velocity, in the direction of the best position in its neighborhood
+ * @param[in] vcoeff velocity coefficient (determining the maximum allowed particle velocity)
+ * @param[in] variant algorithm variant to use
+ * @param[in] neighb_type swarm topology to use
+ * @param[in] neighb_param parameterization of the swarm topology (see pagmo::algorithm::pso)
+ * @param[in] threads number of worker threads evaluating the particles' positions. If zero, the number of hardware threads is used.
+ * @throws value_error if the parameters are not valid for pagmo::algorithm::pso
+ */
+pso_async::pso_async(int gen, double omega, double eta1, double eta2, double vcoeff, int variant, int neighb_type, int neighb_param, unsigned int threads):
+	pso(gen,omega,eta1,eta2,vcoeff,variant,neighb_type,neighb_param,false,threads) {}
+
+/// Clone method.
+base_ptr pso_async::clone() const
+{
+	return base_ptr(new pso_async(*this));
+}
+
+/// Evolve implementation.
+/**
+ * Run the steady-state PSO algorithm until m_gen * pop.size() positions have been evaluated.
+ *
+ * @param[in,out] pop input/output pagmo::population to be evolved.
+ *
+ * @throws std::runtime_error if the evaluation of a position throws.
+ */
+void pso_async::evolve(population &pop) const
+{
+	// Let's store some useful variables.
+	const problem::base             &prob = pop.problem();
+	const problem::base::size_type   D = prob.get_dimension(), prob_i_dimension = prob.get_i_dimension(), prob_c_dimension = prob.get_c_dimension(), prob_f_dimension = prob.get_f_dimension();
+	const problem::base::size_type   Dc = D - prob_i_dimension;
+	const decision_vector           &lb = prob.get_lb(), &ub = prob.get_ub();
+	const population::size_type      swarm_size = pop.size();
+	
+	//We perform some checks to determine wether the problem/population are suitable for PSO
+	if( Dc == 0 ){
+		pagmo_throw(value_error,"There is no continuous part in the problem decision vector for PSO to optimise");
+	}
+	
+	if( prob_c_dimension != 0 ){
+		pagmo_throw(value_error,"The problem is not box constrained and PSO is not suitable to solve it");
+	}
+	
+	if( prob_f_dimension != 1 ){
+		pagmo_throw(value_error,"The problem is not single objective and PSO is not suitable to solve it");
+	}
+	
+	// Get out if there is nothing to do.
+	if (swarm_size == 0 || m_gen == 0) {
+		return;
+	}
+
+	std::vector<decision_vector>  X(swarm_size);		// particles' current positions
+	std::vector<fitness_vector>   fit(swarm_size);		// particles' current fitness values
+	std::vector<decision_vector>  V(swarm_size);		// particles' velocities
+	std::vector<decision_vector>  lbX(swarm_size);		// particles' previous best positions
+	std::vector<fitness_vector>   lbfit(swarm_size);	// particles' fitness values at their previous best positions
+	std::vector< std::vector<int> > neighb(swarm_size);	// swarm topology
+	
+	decision_vector best_neighb(Dc);			// search space position of particles' best neighbor
+	fitness_vector best_fit;				// fitness at the best found search space position (tracked only when using topologies 1 or 4)
+	bool best_fit_improved = false;				// flag indicating whether the best solution's fitness improved (tracked only when using topologies 1 or 4)
+	
+	// Initialise the minimum and maximum velocity
+	decision_vector minv(Dc), maxv(Dc);
+	for( problem::base::size_type d = 0; d < Dc; d++ ){
+		const double vwidth = ( ub[d] - lb[d] ) * m_vcoeff;
+		minv[d] = -1.0 * vwidth;
+		maxv[d] = vwidth;
+	}
+	
+	for( population::size_type p = 0; p < swarm_size; p++ ){
+		X[p]     = pop.get_individual(p).cur_x;
+		V[p]     = pop.get_individual(p).cur_v;
+		fit[p]   = pop.get_individual(p).cur_f;
+		lbX[p]   = pop.get_individual(p).best_x;
+		lbfit[p] = pop.get_individual(p).best_f;
+	}
+	
+	// Initialize the Swarm's topology
+	switch( m_neighb_type ){
+		case 1:  initialize_topology__gbest( pop, best_neighb, best_fit, neighb ); break;
+		case 3:  initialize_topology__von( neighb ); break;
+		case 4:  initialize_topology__adaptive_random( neighb );
+			best_fit = pop.champion().f;	// need to track improvements in best found fitness, to know when to rewire
+			break;
+		case 2:
+		default: initialize_topology__lbest( neighb );
+	}
+
+	util::async_evaluator evaluator(prob,m_threads);
+	// Positions being evaluated: enough to keep the workers busy while the results are processed, at most one per particle.
+	const std::size_t max_in_flight = std::min<std::size_t>(swarm_size,2 * evaluator.get_n_threads());
+	const std::size_t max_evals = static_cast<std::size_t>(m_gen) * swarm_size;
+
+	// Particles with no position being evaluated, in the order they will be moved.
+	std::deque<population::size_type> idle;
+	for( population::size_type p = 0; p < swarm_size; p++ ){
+		idle.push_back(p);
+	}
+
+	util::async_evaluator::result r;
+	std::size_t n_submitted = 0, n_done = 0;
+	while (true) {
+		while (n_submitted < max_evals && !idle.empty() && evaluator.get_n_pending() < max_in_flight) {
+			const population::size_type p = idle.front();
+			idle.pop_front();
+			// identify the current particle's best neighbour (not needed for gbest, nor for FIPS)
+			decision_vector bn = best_neighb;
+			if( m_neighb_type != 1 && m_variant != 6 )
+				bn = particle__get_best_neighbor( p, neighb, lbX, lbfit, prob );
+			particle__move( p, X[p], V[p], lbX, bn, neighb, minv, maxv, lb, ub );
+			evaluator.submit(X[p],p);
+			++n_submitted;
+		}
+		if (!evaluator.get_n_pending()) {
+			break;
+		}
+		evaluator.get(r);
+		++n_done;
+		m_fevals++;
+		const population::size_type p = r.tag;
+		fit[p] = r.f;
+		if( prob.compare_fitness( fit[p], lbfit[p] ) ){
+			// update the particle's previous best position
+			lbfit[p] = fit[p];
+			lbX[p] = X[p];
+			
+			// update the best position observed so far by any particle in the swarm
+			if( ( m_neighb_type == 1 || m_neighb_type == 4 ) && prob.compare_fitness( fit[p], best_fit ) ){
+				best_neighb = X[p];
+				best_fit    = fit[p];
+				best_fit_improved = true;
+			}
+		}
+		idle.push_back(p);
+		
+		// reset swarm topology if no improvement was observed in the best found fitness value during the last swarm_size evaluations
+		if( !(n_done % swarm_size) ){
+			if( m_neighb_type == 4 && !best_fit_improved )
+				initialize_topology__adaptive_random( neighb );
+			best_fit_improved = false;
+		}
+	}
+	
+	// copy particles' positions & velocities back to the main population (the fitness values are known, no evaluation is needed)
+	const constraint_vector c;
+	for( population::size_type p = 0; p < swarm_size; p++ ){
+		pop.set_x( p, lbX[p], lbfit[p], c );	// sets: cur_x, cur_f, best_x, best_f
+		pop.set_x( p, X[p], fit[p], c );	// sets: cur_x, cur_f
+		pop.set_v( p, V[p] );			// sets: cur_v
+	}
+}
+
+/// Algorithm name
+std::string pso_async::get_name() const
+{
+	return "Particle Swarm optimization (asynchronous)";
+}
+
+/// Extra human readable algorithm info.
+/**
+ * Will return a formatted string displaying the parameters of the algorithm.
+ */
+std::string pso_async::human_readable_extra() const
+{
+	std::ostringstream s;
+	s << pso::human_readable_extra();
+	s << "threads:" << m_threads;
+	return s.str();
+}
+
+}} //namespaces
+
+BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::algorithm::pso_async)
@@ -0,0 +1,78 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_ALGORITHM_PSO_ASYNC_H
+#define PAGMO_ALGORITHM_PSO_ASYNC_H
+
+#include <string>
+
+#include "../config.h"
+#include "../population.h"
+#include "../serialization.h"
+#include "base.h"
+#include "pso.h"
+
+namespace pagmo { namespace algorithm {
+
+/// Asynchronous steady-state Particle Swarm Optimization
+/**
+ * Steady-state version of pagmo::algorithm::pso, built on top of pagmo::util::async_evaluator. Each particle is moved and submitted
+ * to a pool of worker threads and, as soon as the evaluation of its new position is over, its memory and the ones of its neighbours
+ * are updated and the particle is moved again, so that no worker waits for the slowest evaluation of a generation.
+ * This is the variant of choice for problems whose evaluation is expensive and has a widely varying cost.
+ *
+ * Each particle has at most one position being evaluated at any time. Particles are moved according to the current memory
+ * of the swarm, with the same variants and topologies as pagmo::algorithm::pso. When the randomly-varying topology is
+ * selected, the swarm is rewired after every pop.size() function evaluations not improving the best found fitness.
+ *
+ * At each call of the evolve method a number of function evaluations equal to m_gen * pop.size() is performed.
+ *
+ * NOTE: the problem is cloned once per worker thread, and its objective function is called concurrently on the clones.
+ *
+ * @see pagmo::algorithm::pso
+ */
+
+class __PAGMO_VISIBLE pso_async: public pso
+{
+public:
+	pso_async(int gen=1, double omega = 0.7298, double eta1 = 2.05, double eta2 = 2.05, double vcoeff = 0.5, int variant = 5, int neighb_type = 2, int neighb_param = 4, unsigned int threads = 0);
+	base_ptr clone() const;
+	void evolve(population &) const;
+	std::string get_name() const;
+protected:
+	std::string human_readable_extra() const;
+private:
+	friend class boost::serialization::access;
+	template <class Archive>
+	void serialize(Archive &ar, const unsigned int)
+	{
+		ar & boost::serialization::base_object<pso>(*this);
+	}
+};
+
+}} //namespaces
+
+BOOST_CLASS_EXPORT_KEY(pagmo::algorithm::pso_async)
+
+#endif // PAGMO_ALGORITHM_PSO_ASYNC_H
@@ -24,12 +24,14 @@
 
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <vector>
 #include <cmath>
 #include <iostream>
 
 #include "pso_generational.h"
 #include "../problem/base_stochastic.h"
+#include "../util/async_evaluator.h"
 
 
 
@@ -51,11 +53,14 @@ namespace pagmo { namespace algorithm {
  * to a radius of k = neighb_param / 2 in the ring. If the Randomly-varying neighbourhood topology
  * is selected (neighb_type=4), neighb_param represents each particle's maximum outdegree in the swarm topology.
  * The minimum outdegree is 1 (the particle always connects back to itself).
+ * @param[in] threads number of threads evaluating the swarm, if 0 the number of hardware threads is used
  * @throws value_error if m_omega is not in the [0,1] interval, eta1, eta2 are not in the [0,1] interval,
  * vcoeff is not in ]0,1], variant is not one of 1 .. 6, neighb_type is not one of 1 .. 4
  */
 
-pso_generational::pso_generational(int gen, double omega, double eta1, double eta2, double vcoeff, int variant, int neighb_type, int neighb_param):base(),m_gen(gen),m_omega(omega),m_eta1(eta1),m_eta2(eta2),m_vcoeff(vcoeff),m_variant(variant),m_neighb_type(neighb_type),m_neighb_param(neighb_param) {
+pso_generational::pso_generational(int gen, double omega, double eta1, double eta2, double vcoeff, int variant, int neighb_type, int neighb_param, unsigned int threads):
+	base(),m_gen(gen),m_omega(omega),m_eta1(eta1),m_eta2(eta2),m_vcoeff(vcoeff),m_variant(variant),m_neighb_type(neighb_type),m_neighb_param(neighb_param),
+	m_threads(threads) {
 	if (gen < 0) {
 		pagmo_throw(value_error,"number of generations must be nonnegative");
 	}
@@ -197,6 +202,13 @@ void pso_generational::evolve(population &pop) const
 	double r1 = 0.0;
 	double r2 = 0.0;
 
+	// The swarm of deterministic problems is evaluated in parallel if requested. The threads are kept for all the generations.
+	boost::scoped_ptr<util::async_evaluator> evaluator;
+	if( m_threads != 1 && !dynamic_cast<const problem::base_stochastic *>(&prob) ){
+		evaluator.reset(new util::async_evaluator(prob,m_threads));
+	}
+	util::async_evaluator::result r;
+
 	/* --- Main PSO loop ---
 	 */
 	// For each generation
@@ -360,11 +372,20 @@ void pso_generational::evolve(population &pop) const
 		}
 		catch (const std::bad_cast& e)
 		{
-			//Only evaluate new position
+			// Only evaluate new position, as a batch
+			if( evaluator ){
+				for( p = 0; p < swarm_size; p++ )
+					evaluator->submit( X[p], p );
+				for( p = 0; p < swarm_size; p++ ){
+					evaluator->get( r );
+					fit[r.tag].swap( r.f );
+				}
+			}
+			else {
+				prob.objfun_batch( fit, X );
+			}
+			pop.set_xs( X, fit );
 			for( p = 0; p < swarm_size; p++ ){
-				// We evaluate here the new individual fitness
-				prob.objfun( fit[p], X[p] );
-				pop.set_x(p,X[p]);
 				pop.set_v(p,V[p]);
 			}
 		}
@@ -627,6 +648,7 @@ std::string pso_generational::human_readable_extra() const
 	s << "topology:" << m_neighb_type << ' ';
 	if( m_neighb_type == 2 || m_neighb_type == 4 )
 		s << "topology param.:" << m_neighb_param << ' ';
+	s << "threads:" << m_threads << ' ';
 	return s.str();
 }
 
@@ -41,6 +41,9 @@ namespace pagmo { namespace algorithm {
  * NOTE: this PSO is suitable for stochastic optimization problems. The random seed is changed at the end
  * of each generation
  *
+ * Since the whole swarm moves before being evaluated, the new positions of the particles are evaluated as a batch,
+ * on a pool of threads if requested (see util::async_evaluator). Stochastic problems are evaluated sequentially.
+ *
  * @see http://www.particleswarm.info/ for a repository of information related to PSO
  * @see http://dx.doi.org/10.1007/s11721-007-0002-0 for a recent survey
  * @see http://www.engr.iupui.edu/~shi/Coference/psopap4.html for the first paper on this algorithm
@@ -52,7 +55,8 @@ namespace pagmo { namespace algorithm {
 class __PAGMO_VISIBLE pso_generational: public base
 {
 public:
-	pso_generational(int gen=1, double omega = 0.7298, double eta1 = 2.05, double eta2 = 2.05, double vcoeff = 0.5, int variant = 5, int neighb_type = 2, int neighb_param = 4 );
+	pso_generational(int gen=1, double omega = 0.7298, double eta1 = 2.05, double eta2 = 2.05, double vcoeff = 0.5, int variant = 5, int neighb_type = 2, int neighb_param = 4,
+		unsigned int threads = 1 );
 	base_ptr clone() const;
 	void evolve(population &) const;
 	std::string get_name() const;
@@ -67,7 +71,7 @@ private:
 private:
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & boost::serialization::base_object<base>(*this);
 		ar & const_cast<int &>(m_gen);
@@ -78,6 +82,12 @@ private:
 		ar & const_cast<int &>(m_variant);
 		ar & const_cast<int &>(m_neighb_type);
 		ar & const_cast<int &>(m_neighb_param);
+		// The number of threads was added in version 1.
+		if (version >= 1) {
+			ar & const_cast<unsigned int &>(m_threads);
+		} else {
+			const_cast<unsigned int &>(m_threads) = 1;
+		}
 	}
 	// Number of generations
 	const int m_gen;
@@ -95,10 +105,13 @@ private:
 	const int m_neighb_type;
 	// parameterization of the swarm topology
 	const int m_neighb_param;
+	// Number of threads evaluating the swarm
+	const unsigned int m_threads;
 };
 
 }} //namespaces
 
 BOOST_CLASS_EXPORT_KEY(pagmo::algorithm::pso_generational)
+BOOST_CLASS_VERSION(pagmo::algorithm::pso_generational,1)
 
 #endif // PAGMO_ALGORITHM_PSO_GENERATIONAL_H
@@ -22,9 +22,23 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
-#include "sa_corana.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "../exceptions.h"
+#include "../population.h"
+#include "../problem/base.h"
+#include "../rng.h"
+#include "../types.h"
+#include "base.h"
+#include "sa_corana.h"
 
 
 namespace pagmo { namespace algorithm {
@@ -39,11 +53,13 @@ namespace pagmo { namespace algorithm {
  * @param[in] niterT
  * @param[in] niterR
  * @param[in] range
+ * @param[in] n_chains number of chains (more than one chain activates the parallel tempering mode)
+ * @param[in] n_threads number of threads running the chains (0 means as many as the hardware supports)
  * @throws value_error niter is non positive, Ts is greater than Tf, Ts is non positive, Tf is non positive,
- * niterT or niterR are negative, range is not in the [0,1] interval
+ * niterT or niterR are negative, range is not in the [0,1] interval, n_chains is zero
  */
-sa_corana::sa_corana(int niter, const double &Ts, const double &Tf, int niterT, int niterR, const double &range):
-		base(),m_niter(niter),m_Ts(Ts),m_Tf(Tf),m_step_adj(niterT),m_bin_size(niterR),m_range(range)
+sa_corana::sa_corana(int niter, const double &Ts, const double &Tf, int niterT, int niterR, const double &range, unsigned int n_chains, unsigned int n_threads):
+		base(),m_niter(niter),m_Ts(Ts),m_Tf(Tf),m_step_adj(niterT),m_bin_size(niterR),m_range(range),m_chains(n_chains),m_threads(n_threads)
 {
 	if (niter < 0) {
 		pagmo_throw(value_error,"number of iterations must be nonnegative");
@@ -60,6 +76,9 @@ sa_corana::sa_corana(int niter, const double &Ts, const double &Tf, int niterT,
 	if (range < 0 || range >1) {
 		pagmo_throw(value_error,"Initial range must be between 0 and 1");
 	}
+	if (n_chains == 0) {
+		pagmo_throw(value_error,"number of chains must be positive");
+	}
 }
 /// Clone method.
 base_ptr sa_corana::clone() const
@@ -67,13 +86,149 @@ base_ptr sa_corana::clone() const
 	return base_ptr(new sa_corana(*this));
 }
 
+// State of an annealing chain. Each chain has its own random number generators and, when chains
+// run concurrently, its own copy of the problem.
+struct sa_corana::chain
+{
+	const problem::base	*prob;
+	problem::base_ptr	prob_copy;
+	decision_vector		x0;
+	decision_vector		xOLD;
+	decision_vector		xNEW;
+	fitness_vector		fOLD;
+	fitness_vector		fNEW;
+	//Stores the adaptive steps of each component (integer part included but not used)
+	decision_vector		step;
+	//Stores the number of accepted points per component (integer part included but not used)
+	std::vector<int>	acp;
+	rng_double		drng;
+	rng_uint32		urng;
+};
+
+// Run m_bin_size sweeps of the chain at temperature currentT, then adjust its neighbourhood.
+void sa_corana::anneal(chain &c, double currentT) const
+{
+	const problem::base &prob = *c.prob;
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+	const problem::base::size_type Dc = prob.get_dimension() - prob.get_i_dimension();
+	decision_vector &xNEW = c.xNEW, &xOLD = c.xOLD, &step = c.step;
+	fitness_vector &fNEW = c.fNEW, &fOLD = c.fOLD;
+	std::vector<int> &acp = c.acp;
+	double ratio = 0, probab = 0;
+
+	for (int kter = 0; kter < m_bin_size; ++kter) {
+		size_t nter = boost::uniform_int<int>(0,Dc-1)(c.urng);
+		for (size_t numb = 0; numb < Dc ; ++numb) {
+			nter = (nter + 1) % Dc;
+			//We modify the current point actsol by mutating its nter component within
+			//a step that we will later adapt
+			xNEW[nter] = xOLD[nter] + boost::uniform_real<double>(-1,1)(c.drng) * step[nter] * (ub[nter]-lb[nter]);
+
+			// If new solution produced is infeasible ignore it
+			if ((xNEW[nter] > ub[nter]) || (xNEW[nter] < lb[nter])) {
+				xNEW[nter]=xOLD[nter];
+				continue;
+			}
+			//And we valuate the objective function for the new point
+			prob.objfun(fNEW,xNEW);
+
+			// We decide wether to accept or discard the point
+			if (prob.compare_fitness(fNEW,fOLD) ) {
+				//accept
+				xOLD[nter] = xNEW[nter];
+				fOLD = fNEW;
+				acp[nter]++;	//Increase the number of accepted values
+			} else {
+				//test it with Boltzmann to decide the acceptance
+				probab = exp ( - fabs(fOLD[0] - fNEW[0] ) / currentT );
+
+				// we compare prob with a random probability.
+				if (probab > c.drng()) {
+					xOLD[nter] = xNEW[nter];
+					fOLD = fNEW;
+					acp[nter]++;	//Increase the number of accepted values
+				} else {
+					xNEW[nter] = xOLD[nter];
+				}
+			} // end if
+		} // end for(nter = 0; ...
+	} // end for(kter = 0; ...
+	// adjust the step (adaptively)
+	for (size_t iter = 0; iter < Dc; ++iter) {
+		ratio = (double)acp[iter]/(double)m_bin_size;
+		acp[iter] = 0;  //reset the counter
+		if (ratio > .6) {
+			//too many acceptances, increase the step by a factor 3 maximum
+			step[iter] = step [iter] * (1 + 2 *(ratio - .6)/.4);
+		} else {
+			if (ratio < .4) {
+				//too few acceptance, decrease the step by a factor 3 maximum
+				step [iter]= step [iter] / (1 + 2 * ((.4 - ratio)/.4));
+			};
+		};
+		//And if it becomes too large, reset it to its initial value
+		if ( step[iter] > m_range ) {
+			step [iter] = m_range;
+		};
+	}
+}
+
+// Replica exchange between chains at neighbouring temperatures. Pairs (k,k+1) are proposed starting
+// from an even or odd k at random, and the states are swapped with the Metropolis criterion on the
+// product of the fitness difference and of the difference of the inverse temperatures. The adaptive
+// steps stay with the temperatures.
+void sa_corana::exchange(std::vector<chain> &chains, const std::vector<double> &T) const
+{
+	const problem::base &prob = *chains[0].prob;
+	for (std::vector<chain>::size_type k = m_urng() % 2; k + 1 < chains.size(); k += 2) {
+		chain &cold = chains[k], &hot = chains[k + 1];
+		if (prob.compare_fitness(hot.fOLD,cold.fOLD) ||
+			exp( - fabs(cold.fOLD[0] - hot.fOLD[0]) * (1. / T[k] - 1. / T[k + 1]) ) > m_drng())
+		{
+			cold.xOLD.swap(hot.xOLD);
+			cold.xNEW.swap(hot.xNEW);
+			cold.fOLD.swap(hot.fOLD);
+		}
+	}
+}
+
+// Run the chains first, first + stride, ... of a round of parallel tempering.
+struct sa_corana::anneal_task
+{
+	void operator()() const
+	{
+		try {
+			for (std::vector<chain>::size_type k = first; k < chains->size(); k += stride) {
+				algo->anneal((*chains)[k],(*T)[k]);
+			}
+		} catch (const std::exception &e) {
+			*err = e.what();
+			if (err->empty()) {
+				*err = "error while annealing the chains";
+			}
+		}
+	}
+	const sa_corana			*algo;
+	std::vector<chain>		*chains;
+	const std::vector<double>	*T;
+	unsigned int			first;
+	unsigned int			stride;
+	std::string			*err;
+};
+
 /// Evolve implementation.
 /**
  * Run the sa_corana algorithm for the number of iterations specified in the constructors.
  * At each accepted point velocity is also updated.
  *
- * @param[in,out] pop input/output pagmo::population to be evolved. Best member only is evolved.
+ * With a single chain, the best member only is evolved. With m_chains chains, the m_chains best
+ * members are evolved by the chains of the parallel tempering, the best member by the coldest chain.
+ *
+ * @param[in,out] pop input/output pagmo::population to be evolved.
  * Velocity is evaluated at the end as difference between decision vector before and after evolution
+ *
+ * @throws value_error if the population has fewer individuals than chains, or if the evaluation of a
+ * chain throws
  */
 
 void sa_corana::evolve(population &pop) const {
@@ -81,7 +236,6 @@ void sa_corana::evolve(population &pop) const {
 	// Let's store some useful variables.
 	const problem::base &prob = pop.problem();
 	const problem::base::size_type D = prob.get_dimension(), prob_i_dimension = prob.get_i_dimension(), prob_c_dimension = prob.get_c_dimension(), prob_f_dimension = prob.get_f_dimension();
-	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
 	const population::size_type NP = pop.size();
 	const problem::base::size_type Dc = D - prob_i_dimension;
 
@@ -108,89 +262,97 @@ void sa_corana::evolve(population &pop) const {
 	if (n_T == 0) {
 		pagmo_throw(value_error,"n_T is zero, increase niter");
 	}
+	if (NP < m_chains) {
+		pagmo_throw(value_error,"the population must have at least as many individuals as the chains of sa_corana");
+	}
+
+	//Starting points are the best individuals
+	const std::vector<population::size_type> bestidx = (m_chains == 1) ? std::vector<population::size_type>(1,pop.get_best_idx()) : pop.get_best_idx(m_chains);
+	std::vector<chain> chains(m_chains);
+	const unsigned int fevals = prob.get_fevals();
+	for (unsigned int k = 0; k < m_chains; ++k) {
+		chain &c = chains[k];
+		c.x0 = pop.get_individual(bestidx[k]).cur_x;
+		c.xOLD = c.x0;
+		c.xNEW = c.x0;
+		c.fOLD = pop.get_individual(bestidx[k]).cur_f;
+		c.fNEW = c.fOLD;
+		c.step.assign(D,m_range);
+		c.acp.assign(D,0);
+		if (m_chains == 1) {
+			// A single chain is run by the calling thread, on the population problem and with the rngs of the algorithm.
+			c.prob = &prob;
+			c.drng = m_drng;
+			c.urng = m_urng;
+		} else {
+			c.prob_copy = prob.clone();
+			c.prob = c.prob_copy.get();
+			c.drng.seed(m_urng());
+			c.urng.seed(m_urng());
+		}
+	}
+
+	unsigned int n_threads = m_threads;
+	if (n_threads == 0) {
+		n_threads = std::max(boost::thread::hardware_concurrency(), 1u);
+	}
+	n_threads = std::min(n_threads,m_chains);
 
-	//Starting point is the best individual
-	const int bestidx = pop.get_best_idx();
-	const decision_vector &x0 = pop.get_individual(bestidx).cur_x;
-	const fitness_vector &fit0 = pop.get_individual(bestidx).cur_f;
 	//Determines the coefficient to dcrease the temperature
 	const double Tcoeff = std::pow(m_Tf/m_Ts,1.0/(double)(n_T));
-	//Stores the current and new points
-	decision_vector xNEW = x0, xOLD = xNEW;
-	fitness_vector fNEW = fit0, fOLD = fNEW;
-	//Stores the adaptive steps of each component (integer part included but not used)
-	decision_vector step(D,m_range);
-
-	//Stores the number of accepted points per component (integer part included but not used)
-	std::vector<int> acp(D,0) ;
-	double ratio = 0, currentT = m_Ts, probab = 0;
+	double currentT = m_Ts;
+	std::vector<double> T(m_chains);
 
 	//Main SA loops
 	for (size_t jter = 0; jter < n_T; ++jter) {
+		// Temperature ladder, from the current temperature of the schedule to the starting one
+		for (unsigned int k = 0; k < m_chains; ++k) {
+			T[k] = (k == 0) ? currentT : currentT * std::pow(m_Ts/currentT,(double)k/(m_chains - 1));
+		}
 		for (int mter = 0; mter < m_step_adj; ++mter) {
-			for (int kter = 0; kter < m_bin_size; ++kter) {
-				size_t nter = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t numb = 0; numb < Dc ; ++numb) {
-					nter = (nter + 1) % Dc;
-					//We modify the current point actsol by mutating its nter component within
-					//a step that we will later adapt
-					xNEW[nter] = xOLD[nter] + boost::uniform_real<double>(-1,1)(m_drng) * step[nter] * (ub[nter]-lb[nter]);
-
-					// If new solution produced is infeasible ignore it
-					if ((xNEW[nter] > ub[nter]) || (xNEW[nter] < lb[nter])) {
-						xNEW[nter]=xOLD[nter];
-						continue;
+			if (n_threads == 1) {
+				for (unsigned int k = 0; k < m_chains; ++k) {
+					anneal(chains[k],T[k]);
+				}
+			} else {
+				std::vector<std::string> err(n_threads);
+				boost::thread_group threads;
+				for (unsigned int t = 0; t < n_threads; ++t) {
+					anneal_task at = {this,&chains,&T,t,n_threads,&err[t]};
+					threads.create_thread(at);
+				}
+				threads.join_all();
+				for (unsigned int t = 0; t < n_threads; ++t) {
+					if (!err[t].empty()) {
+						pagmo_throw(value_error,err[t].c_str());
 					}
-					//And we valuate the objective function for the new point
-					prob.objfun(fNEW,xNEW);
-
-					// We decide wether to accept or discard the point
-					if (prob.compare_fitness(fNEW,fOLD) ) {
-						//accept
-						xOLD[nter] = xNEW[nter];
-						fOLD = fNEW;
-						acp[nter]++;	//Increase the number of accepted values
-					} else {
-						//test it with Boltzmann to decide the acceptance
-						probab = exp ( - fabs(fOLD[0] - fNEW[0] ) / currentT );
-
-						// we compare prob with a random probability.
-						if (probab > m_drng()) {
-							xOLD[nter] = xNEW[nter];
-							fOLD = fNEW;
-							acp[nter]++;	//Increase the number of accepted values
-						} else {
-							xNEW[nter] = xOLD[nter];
-						}
-					} // end if
-				} // end for(nter = 0; ...
-			} // end for(kter = 0; ...
-			// adjust the step (adaptively)
-			for (size_t iter = 0; iter < Dc; ++iter) {
-				ratio = (double)acp[iter]/(double)m_bin_size;
-				acp[iter] = 0;  //reset the counter
-				if (ratio > .6) {
-					//too many acceptances, increase the step by a factor 3 maximum
-					step[iter] = step [iter] * (1 + 2 *(ratio - .6)/.4);
-				} else {
-					if (ratio < .4) {
-						//too few acceptance, decrease the step by a factor 3 maximum
-						step [iter]= step [iter] / (1 + 2 * ((.4 - ratio)/.4));
-					};
-				};
-				//And if it becomes too large, reset it to its initial value
-				if ( step[iter] > m_range ) {
-					step [iter] = m_range;
-				};
+				}
+			}
+			if (m_chains > 1) {
+				exchange(chains,T);
 			}
 		}
 		// Cooling schedule
 		currentT *= Tcoeff;
 	}
-	if ( prob.compare_fitness(fOLD,fit0) ){
-		pop.set_x(bestidx,xOLD); //new evaluation is possible here......
-		std::transform(xOLD.begin(), xOLD.end(), pop.get_individual(bestidx).cur_x.begin(), xOLD.begin(),std::minus<double>());
-		pop.set_v(bestidx,xOLD);
+	if (m_chains == 1) {
+		m_drng = chains[0].drng;
+		m_urng = chains[0].urng;
+	} else {
+		// The clones started from the evaluation count of the population problem: add back what the chains did.
+		for (unsigned int k = 0; k < m_chains; ++k) {
+			prob.m_fevals += chains[k].prob_copy->get_fevals() - fevals;
+		}
+	}
+
+	// Each chain writes its state back to the slot it started from
+	for (unsigned int k = 0; k < m_chains; ++k) {
+		chain &c = chains[k];
+		if ( prob.compare_fitness(c.fOLD,pop.get_individual(bestidx[k]).cur_f) ){
+			pop.set_x(bestidx[k],c.xOLD); //new evaluation is possible here......
+			std::transform(c.xOLD.begin(), c.xOLD.end(), c.x0.begin(), c.xOLD.begin(),std::minus<double>());
+			pop.set_v(bestidx[k],c.xOLD);
+		}
 	}
 }
 
@@ -214,6 +376,10 @@ std::string sa_corana::human_readable_extra() const
 	s << "steps:" << m_step_adj << ' ';
 	s << "bin_size:" << m_bin_size << ' ';
 	s << "range:" << m_range << ' ';
+	if (m_chains > 1) {
+		s << "chains:" << m_chains << ' ';
+		s << "threads:" << m_threads << ' ';
+	}
 	return s.str();
 }
 
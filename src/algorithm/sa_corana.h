@@ -25,6 +25,8 @@
 #ifndef PAGMO_ALGORITHM_SA_CORANA_H
 #define PAGMO_ALGORITHM_SA_CORANA_H
 
+#include <vector>
+
 #include "../config.h"
 #include "../serialization.h"
 #include "base.h"
@@ -49,6 +51,13 @@ namespace pagmo { namespace algorithm {
  * At each call of the evolve method the number of function evaluations is guaranteed to be less
  * than the total iterations as if a point is produced out of the bounds the iteration is skipped
  *
+ * With more than one chain, the algorithm runs in parallel tempering mode: the chains start from the best
+ * individuals of the population and anneal concurrently, each on its own copy of the problem, at temperatures
+ * spaced geometrically between the current temperature of the schedule (coldest chain) and the starting
+ * temperature (hottest chain). After each adjustment of the neighbourhood, the states of chains at neighbouring
+ * temperatures are exchanged according to the Metropolis criterion, and at the end of the evolution each chain
+ * writes its state back to the slot of the population it started from. The total iterations are performed by each chain.
+ *
  * @see http://amcg.ese.ic.ac.uk/~jgomes/lasme/SA-corana.pdf for the original paper
  *
  * @author Dario Izzo (dario.izzo@googlemail.com)
@@ -57,16 +66,20 @@ namespace pagmo { namespace algorithm {
 class __PAGMO_VISIBLE sa_corana: public base
 {
 public:
-	sa_corana(int niter = 1, const double &Ts = 10, const double &Tf = .1, int m_step_adj = 1, int m_bin_size = 20, const double &range = 1);
+	sa_corana(int niter = 1, const double &Ts = 10, const double &Tf = .1, int m_step_adj = 1, int m_bin_size = 20, const double &range = 1, unsigned int n_chains = 1, unsigned int n_threads = 1);
 	base_ptr clone() const;
 	void evolve(population &) const;
 	std::string get_name() const;
 protected:
 	std::string human_readable_extra() const;
 private:
+	struct chain;
+	struct anneal_task;
+	void anneal(chain &, double) const;
+	void exchange(std::vector<chain> &, const std::vector<double> &) const;
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & boost::serialization::base_object<base>(*this);
 		ar & const_cast<int &>(m_niter);
@@ -75,7 +88,15 @@ private:
 		ar & const_cast<int &>(m_step_adj);
 		ar & const_cast<int &>(m_bin_size);
 		ar & const_cast<double &>(m_range);
-	}  
+		// The chains and the threads were added in version 1.
+		if (version >= 1) {
+			ar & const_cast<unsigned int &>(m_chains);
+			ar & const_cast<unsigned int &>(m_threads);
+		} else {
+			const_cast<unsigned int &>(m_chains) = 1;
+			const_cast<unsigned int &>(m_threads) = 1;
+		}
+	}
 	// Number of iterations.
 	const int m_niter;
 	// Starting temperature
@@ -88,10 +109,15 @@ private:
 	const int m_bin_size;
 	// Starting neighbourhood size
 	const double m_range;
+	// Number of chains
+	const unsigned int m_chains;
+	// Number of threads running the chains
+	const unsigned int m_threads;
 };
 
 }} //namespaces
 
 BOOST_CLASS_EXPORT_KEY(pagmo::algorithm::sa_corana)
+BOOST_CLASS_VERSION(pagmo::algorithm::sa_corana,1)
 
 #endif // PAGMO_ALGORITHM_SA_CORANA_H
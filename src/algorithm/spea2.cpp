@@ -36,7 +36,7 @@
 #include "../exceptions.h"
 #include "../population.h"
 #include "../problem/base.h"
-#include "../population.h"
+#include "../util/multi_objective.h"
 #include "../util/neighbourhood.h"
 #include "base.h"
 #include "spea2.h"
@@ -173,45 +173,18 @@ void spea2::evolve(population &pop) const
 				archive[i] = new_pop[ordered_by_fitness[i]];
 			}
 
-			//fitness vector of the non-dominated individuals
+			//fitness of the non-dominated individuals
 			std::vector<fitness_vector> fit_nd(n_non_dominated);
 			for ( population::size_type i = 0; i<n_non_dominated; i++ ) {
 				fit_nd[i]	=	archive[i].f;
 			}
 
-			//computing K-NN distances for K=0,...,n_non_dominated
-			std::vector<std::vector<pagmo::population::size_type> > neighbours_nd;
-			pagmo::util::neighbourhood::euclidian::compute_neighbours(neighbours_nd, fit_nd);
-			std::vector<population::size_type> rv(n_non_dominated);
-			for(unsigned int i=0; i<n_non_dominated; ++i) rv[i] = i;
-
-			while(archive.size() > archive_size) {
-
-				//Calculate which is the worst element according to the distance sorter
-				pagmo::population::size_type idx_to_delete = *(std::max_element(rv.begin(), rv.end(), distance_sorter(neighbours_nd, fit_nd)));
-
-				//Remove the element from rv, archive and fit_nd
-				rv.erase(rv.end()-1);
-				archive.erase(archive.begin() + idx_to_delete);
-				fit_nd.erase(fit_nd.begin() + idx_to_delete);
-
-				//Remove the row of neighbours_nd coresponding to idx_to_delete
-				neighbours_nd.erase(neighbours_nd.begin() + idx_to_delete);
-
-				for(unsigned int i=0; i < neighbours_nd.size(); ++i) {
-					for(unsigned int j=0; j < neighbours_nd[i].size(); ++j) {
-						//Remove all the occurencies of idx_to_delete
-						if (neighbours_nd[i][j] == idx_to_delete) {
-							neighbours_nd[i].erase(neighbours_nd[i].begin() + j);
-							j--;
-						//Adjust all the indexes after idx_to_delete
-						} else if (neighbours_nd[i][j] > idx_to_delete) {
-							neighbours_nd[i][j]--;
-						}
-					}
-				}
-
+			//remove one at a time the individuals closest to their K-th neighbours, for K=1,...,n_non_dominated
+			std::vector<util::multi_objective::size_type> survivors = util::multi_objective::spea2_truncation(util::multi_objective::fitness_matrix(fit_nd), archive_size);
+			for(unsigned int i = 0; i < archive_size; ++i) {
+				archive[i] = archive[survivors[i]];
 			}
+			archive.resize(archive_size);
 
 		} else { //fill with the best dominated individuals
 			for(unsigned int i = 0; i < archive_size; ++i) {
@@ -243,8 +216,10 @@ void spea2::evolve(population &pop) const
 				archive_cons[i]	=	archive[i].c;
 			}
 
-			std::vector<std::vector<population::size_type> > domination_list = compute_domination_list(prob, archive_fit,archive_cons);
-			std::vector<population::size_type> pareto_rank = compute_pareto_rank(domination_list);
+			std::vector<std::vector<population::size_type> > domination_list;
+			std::vector<population::size_type> domination_count, pareto_rank;
+			util::multi_objective::domination_lists(domination_list, domination_count, prob, archive_fit, archive_cons);
+			util::multi_objective::non_dominated_sort(pareto_rank, domination_list, domination_count);
 
 			population::size_type idx = 0;
 
@@ -314,25 +289,6 @@ std::string spea2::human_readable_extra() const
 	return s.str();
 }
 
-std::vector<std::vector<population::size_type> > spea2::compute_domination_list(const pagmo::problem::base &prob,
-																   const std::vector<fitness_vector> &fit,
-																   const std::vector<constraint_vector> &cons) const
-{
-	std::vector<population::size_type> dummy;
-	std::vector<std::vector<population::size_type> > domination_list(fit.size(), dummy);
-
-	for(unsigned int i=0; i<fit.size();++i) {
-		for(unsigned int j=0; j<fit.size(); ++j) {
-			// Check if individual in position i dominates individual in position n.
-			if(prob.compare_fc(fit[i],cons[i],fit[j],cons[j])) {
-				domination_list[i].push_back(j);
-			}
-		}
-	}
-
-	return domination_list;
-}
-
 void spea2::compute_spea2_fitness(std::vector<double> &F,
 			int K,
 			const std::vector<spea2_individual> &pop,
@@ -340,35 +296,32 @@ void spea2::compute_spea2_fitness(std::vector<double> &F,
 {
 
 	const population::size_type NP = pop.size();
-	std::vector<int> S(NP, 0);
-
 
 	std::vector<fitness_vector> fit(NP);
-	std::vector<fitness_vector> cons(NP);
+	std::vector<constraint_vector> cons(NP);
 	for ( population::size_type i = 0; i<NP; i++ ) {
 		fit[i]	=	pop[i].f;
 		cons[i]	=	pop[i].c;
 	}
-	std::vector<std::vector<pagmo::population::size_type> > neighbours;
-	pagmo::util::neighbourhood::euclidian::compute_neighbours(neighbours, fit);
+	const util::multi_objective::fitness_matrix fit_matrix(fit);
+	const util::multi_objective::kd_tree tree(fit_matrix);
 
-	std::vector<std::vector<population::size_type> > domination_list = compute_domination_list(prob, fit,cons);
-
-	for(unsigned int i=0; i<NP; ++i) {
-		S[i] = domination_list[i].size();
-	}
+	std::vector<std::vector<population::size_type> > domination_list;
+	std::vector<population::size_type> domination_count;
+	util::multi_objective::domination_lists(domination_list, domination_count, prob, fit, cons);
 
 	std::fill(F.begin(), F.end(), 0);
 
+	//raw fitness: sum of the strengths (number of dominated individuals) of the dominators
 	for(unsigned int i=0; i<NP; ++i) {
 		for(unsigned int j=0; j<domination_list[i].size(); ++j) {
-			F[domination_list[i][j]] += S[i];
+			F[domination_list[i][j]] += domination_list[i].size();
 		}
 	}
 
+	//density: distance to the K-th nearest neighbour
 	for(unsigned int i=0; i<NP; ++i) {
-		F[i] = F[i] +
-				(1.0 / (pagmo::util::neighbourhood::euclidian::distance(fit[i], fit[neighbours[i][K]]) + 2));
+		F[i] = F[i] + (1.0 / (tree.kth_distance(i, K) + 2));
 	}
 }
 
@@ -379,60 +332,6 @@ pagmo::population::size_type spea2::tournament_selection(pagmo::population::size
 	return ((m_drng() > 0.5) ? idx1 : idx2);
 }
 
-std::vector<population::size_type> spea2::compute_domination_count(const std::vector<std::vector<population::size_type> > &dom_list) const
-{
-	std::vector<population::size_type> domination_count(dom_list.size(),0);
-	for(unsigned int i=0; i<dom_list.size(); ++i) {
-		for(unsigned int j = 0; j < dom_list[i].size(); ++j) {
-			domination_count[dom_list[i][j]]++;
-		}
-	}
-
-	return domination_count;
-}
-
-std::vector<population::size_type> spea2::compute_pareto_rank(const std::vector<std::vector<population::size_type> > &dom_list) const
-{
-	std::vector<population::size_type> pareto_rank(dom_list.size(),0);
-
-	// We define some utility vectors .....
-	std::vector<population::size_type> F,S;
-
-	// And make a copy of the domination count (number of individuals that dominating one individual)
-	std::vector<population::size_type> dom_count = compute_domination_count(dom_list);
-
-	// 1 - Find the first Pareto Front
-	for (population::size_type idx = 0; idx < dom_count.size(); ++idx){
-		if (dom_count[idx] == 0) {
-			F.push_back(idx);
-		}
-	}
-
-	unsigned int irank = 1;
-
-	// We loop to find subsequent fronts
-	while (F.size()!=0) {
-		//For each individual F in the current front
-		for (population::size_type i=0; i < F.size(); ++i) {
-			//For each individual dominated by F
-			for (population::size_type j=0; j<dom_list[F[i]].size(); ++j) {
-				dom_count[dom_list[F[i]][j]]--;
-				if (dom_count[dom_list[F[i]][j]] == 0){
-					S.push_back(dom_list[F[i]][j]);
-					pareto_rank[dom_list[F[i]][j]] = irank;
-				}
-			}
-		}
-		F = S;
-		S.clear();
-		irank++;
-	}
-
-	//std::cout << "pareto rank before return " << pareto_rank << std::endl;
-	return pareto_rank;
-}
-
-
 void spea2::crossover(decision_vector& child1, decision_vector& child2, pagmo::population::size_type parent1_idx, pagmo::population::size_type parent2_idx,
 					  const std::vector<spea2_individual> &pop, const pagmo::problem::base &prob) const
 {
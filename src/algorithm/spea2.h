@@ -27,41 +27,10 @@
 
 #include "../config.h"
 #include "../serialization.h"
-#include "../util/neighbourhood.h"
 #include "base.h"
 
 namespace pagmo { namespace algorithm {
 
-class  distance_sorter {
-public:
-	distance_sorter(const std::vector<std::vector<pagmo::population::size_type>  > &neighbours,
-					const std::vector<fitness_vector> &fit):
-		m_neighbours(neighbours),
-		m_fit(fit) {}
-	bool operator()(unsigned int a, unsigned int b) {
-		if(a>=m_fit.size() || a>=m_neighbours.size()){
-			pagmo_throw(value_error,"SPEA2 sorting of KNN values failure");
-		}
-		if(b>=m_fit.size() || b>=m_neighbours.size()){
-			pagmo_throw(value_error,"SPEA2 sorting of KNN values failure");
-		}
-		double delta_a, delta_b;
-		unsigned int i = 0;
-		do{
-			if(m_neighbours[b][i]>=m_fit.size() || m_neighbours[a][i]>=m_fit.size()){
-				pagmo_throw(value_error,"SPEA2 sorting of KNN values failure");
-			}
-			delta_a = pagmo::util::neighbourhood::euclidian::distance(m_fit[a], m_fit[m_neighbours[a][i]]);
-			delta_b = pagmo::util::neighbourhood::euclidian::distance(m_fit[b], m_fit[m_neighbours[b][i]]);
-			i++;
-		} while (i<m_neighbours[0].size() && delta_a == delta_b);
-		return delta_a > delta_b;
-	}
-private:
-	const std::vector<std::vector<pagmo::population::size_type>  > &m_neighbours;
-	const std::vector<fitness_vector> &m_fit;
-};
-
 /// "Strength Pareto Evolutionary Algorithm (SPEA2)"
 /**
  *
@@ -72,6 +41,9 @@ private:
  * The size of the archive is kept constant throughout the run by mean of a truncation operator taking into
  * consideration the distance of each individual to its closest neighbours.
  *
+ * The density estimate and the truncation operator are those of pagmo::util::multi_objective: the K-th neighbour is
+ * found with a KD-tree in objective space and the truncation sorts the neighbours of each individual only once.
+ *
  * @author Andrea Mambrini (andrea.mambrini@gmail.com)
  * @author Annalisa Riccardi (nina1983@gmail.com)
  *
@@ -98,13 +70,8 @@ private:
 				int K,
 				const std::vector<spea2_individual> &pop,
 				const pagmo::problem::base &prob) const;
-	std::vector<std::vector<population::size_type> > compute_domination_list(const pagmo::problem::base &,
-																			const std::vector<fitness_vector> &,
-																			const std::vector<constraint_vector> &) const;
-	std::vector<population::size_type> compute_pareto_rank(const std::vector<std::vector<population::size_type> > &) const;
 	pagmo::population::size_type tournament_selection(pagmo::population::size_type, pagmo::population::size_type,
 													  const std::vector<population::size_type> &) const;
-	std::vector<population::size_type> compute_domination_count(const std::vector<std::vector<population::size_type> > &) const;
 	void crossover(decision_vector&, decision_vector&, pagmo::population::size_type, pagmo::population::size_type,
 				   const std::vector<spea2_individual> &, const pagmo::problem::base &) const;
 	void mutate(decision_vector&, const pagmo::problem::base&) const;
@@ -359,19 +359,21 @@ void vega::evolve(population &pop) const
 		}
 		catch (const std::bad_cast& e)
 		{
-			//4 - Evaluate the new population (deterministic problem)
+			//4 - Evaluate the new population (deterministic problem) as a batch
+			prob.objfun_batch(fit,Xnew);
+			std::vector<decision_vector> Vnew(Xnew);
 			for (pagmo::population::size_type i=0; i < NP; i++) {
-				prob.objfun(fit[i],Xnew[i]);
-				dummy = Xnew[i];
-				std::transform(dummy.begin(), dummy.end(), pop.get_individual(i).cur_x.begin(), dummy.begin(),std::minus<double>());
-				//updates x and v (cache avoids to recompute the objective function and constraints)
-				pop.set_x(i,Xnew[i]);
-				pop.set_v(i,dummy);
+				std::transform(Vnew[i].begin(), Vnew[i].end(), pop.get_individual(i).cur_x.begin(), Vnew[i].begin(),std::minus<double>());
 				if (prob.compare_fitness(fit[i], bestfit)) {
 					bestfit = fit[i];
 					bestX = Xnew[i];
 				}
 			}
+			//updates x and v with the known fitness, the domination lists being rebuilt once
+			pop.set_xs(Xnew,fit);
+			for (pagmo::population::size_type i=0; i < NP; i++) {
+				pop.set_v(i,Vnew[i]);
+			}
 		}
 
 		// need to check if elitism is suitable with MO
@@ -31,6 +31,7 @@
 #include "algorithm/base.h"
 #include "algorithm/cs.h"
 #include "algorithm/de.h"
+#include "algorithm/de_async.h"
 #include "algorithm/de_1220.h"
 #include "algorithm/sea.h"
 #include "algorithm/jde.h"
@@ -39,6 +40,7 @@
 #include "algorithm/monte_carlo.h"
 #include "algorithm/null.h"
 #include "algorithm/pso.h"
+#include "algorithm/pso_async.h"
 #include "algorithm/pso_generational.h"
 #include "algorithm/pso_generational_racing.h"
 #include "algorithm/sa_corana.h"
@@ -24,12 +24,17 @@
 
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/random/uniform_int.hpp>
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/thread/barrier.hpp>
+#include <boost/thread/condition_variable.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/tuple/tuple_io.hpp>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/variate_generator.hpp>
 #include <cstddef>
+#include <deque>
 #include <iostream>
 #include <iterator>
 #include <sstream>
@@ -50,6 +55,15 @@
 
 namespace pagmo {
 
+// Default number of items kept in the migration history.
+static const std::size_t default_migr_hist_capacity = 10000u;
+
+// Ordering of the edges in the telemetry.
+static bool edge_telemetry_less(const archipelago::migr_edge_telemetry &e1, const archipelago::migr_edge_telemetry &e2)
+{
+	return e1.src < e2.src || (e1.src == e2.src && e1.dest < e2.dest);
+}
+
 // Check we are not using bogus values for the enums.
 void archipelago::check_migr_attributes() const
 {
@@ -67,7 +81,8 @@ void archipelago::check_migr_attributes() const
  */
 archipelago::archipelago(distribution_type dt, migration_direction md):m_islands_sync_point(),m_topology(new topology::unconnected()),
 	m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex(),
+	m_pool_mutex(),m_pool(0),m_telemetry_mutex(),m_migr_hist(default_migr_hist_capacity),m_migr_hist_total(0)
 {
 	check_migr_attributes();
 }
@@ -83,7 +98,8 @@ archipelago::archipelago(distribution_type dt, migration_direction md):m_islands
  */
 archipelago::archipelago(const topology::base &t, distribution_type dt, migration_direction md):
 	m_islands_sync_point(),m_topology(),m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex(),
+	m_pool_mutex(),m_pool(0),m_telemetry_mutex(),m_migr_hist(default_migr_hist_capacity),m_migr_hist_total(0)
 {
 	// NOTE: we cannot set the topology in the initialiser list directly,
 	// since we do not know if the topology is suitable. Set it here.
@@ -106,7 +122,8 @@ archipelago::archipelago(const topology::base &t, distribution_type dt, migratio
  */
 archipelago::archipelago(const algorithm::base &a, const problem::base &p, int n, int m, const topology::base &t, distribution_type dt, migration_direction md):
 	m_islands_sync_point(),m_topology(new topology::unconnected()),m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex(),
+	m_pool_mutex(),m_pool(0),m_telemetry_mutex(),m_migr_hist(default_migr_hist_capacity),m_migr_hist_total(0)
 {
 	check_migr_attributes();
 	for (size_type i = 0; i < boost::numeric_cast<size_type>(n); ++i) {
@@ -123,7 +140,7 @@ archipelago::archipelago(const algorithm::base &a, const problem::base &p, int n
  *
  * @param[in] a archipelago to be copied.
  */
-archipelago::archipelago(const archipelago &a)
+archipelago::archipelago(const archipelago &a):m_pool(0)
 {
 	a.join();
 	// Deep copy from islands pointers.
@@ -137,7 +154,12 @@ archipelago::archipelago(const archipelago &a)
 	m_migr_map = a.m_migr_map;
 	m_drng = a.m_drng;
 	m_urng = a.m_urng;
+	compile_topology();
+	lock_type lock(a.m_telemetry_mutex);
 	m_migr_hist = a.m_migr_hist;
+	m_migr_hist_total = a.m_migr_hist_total;
+	m_migr_edges = a.m_migr_edges;
+	m_isl_telemetry = a.m_isl_telemetry;
 }
 
 /// Assignment operator.
@@ -165,7 +187,25 @@ archipelago &archipelago::operator=(const archipelago &a)
 		m_migr_map = a.m_migr_map;
 		m_drng = a.m_drng;
 		m_urng = a.m_urng;
-		m_migr_hist = a.m_migr_hist;
+		compile_topology();
+		// NOTE: copy the telemetry of a under its lock only, then assign it under the lock of this, so that
+		// concurrent assignments in opposite directions cannot deadlock.
+		migr_hist_type migr_hist;
+		std::size_t migr_hist_total;
+		migr_edge_map_type migr_edges;
+		std::vector<island_telemetry> isl_telemetry;
+		{
+			lock_type lock(a.m_telemetry_mutex);
+			migr_hist = a.m_migr_hist;
+			migr_hist_total = a.m_migr_hist_total;
+			migr_edges = a.m_migr_edges;
+			isl_telemetry = a.m_isl_telemetry;
+		}
+		lock_type lock(m_telemetry_mutex);
+		m_migr_hist.swap(migr_hist);
+		m_migr_hist_total = migr_hist_total;
+		m_migr_edges.swap(migr_edges);
+		m_isl_telemetry.swap(isl_telemetry);
 	}
 	return *this;
 }
@@ -194,17 +234,56 @@ void archipelago::join() const
 
 archipelago::size_type archipelago::locate_island(const base_island &isl) const
 {
-	// TODO: iterate and increase a size type instead of using distance(), which returns a signed int.
-	// Also, assert the island is actually found here?
-	// TODO: also, this can be optimized with a hash table, if needed: build it at the beginning
-	// of the evolution, and destroy it at the end.
-	const_iterator it = m_container.begin();
-	for (; it != m_container.end(); ++it) {
-		if (&(*(*it)) == &isl) {
-			break;
+	// NOTE: the position of the islands is read from the snapshot built by compile_topology(),
+	// which is kept up to date whenever the islands or the topology change.
+	const boost::unordered_map<const base_island *,size_type>::const_iterator it = m_migr_graph.m_isl_idx.find(&isl);
+	if (it == m_migr_graph.m_isl_idx.end()) {
+		pagmo_throw(value_error,"the island does not belong to the archipelago");
+	}
+	return it->second;
+}
+
+// Compile the topology and the positions of the islands into the flat snapshot read by the migration methods. To be called
+// whenever the islands or the topology change, with the archipelago joined. The in-neighbours are obtained transposing the out-neighbours,
+// so that each edge is queried only once.
+void archipelago::compile_topology()
+{
+	const size_type n = m_container.size();
+	pagmo_assert(boost::numeric_cast<size_type>(m_topology->get_number_of_vertices()) == n);
+	migration_graph g;
+	g.m_out_offsets.reserve(n + 1);
+	g.m_out_offsets.push_back(0);
+	for (size_type i = 0; i < n; ++i) {
+		const topology::base::vertices_size_type v = boost::numeric_cast<topology::base::vertices_size_type>(i);
+		const std::vector<topology::base::vertices_size_type> adj_islands(m_topology->get_v_adjacent_vertices(v));
+		for (std::vector<topology::base::vertices_size_type>::size_type j = 0; j < adj_islands.size(); ++j) {
+			g.m_out_vertices.push_back(boost::numeric_cast<size_type>(adj_islands[j]));
+			g.m_out_weights.push_back(m_topology->get_weight(v,adj_islands[j]));
+		}
+		g.m_out_offsets.push_back(g.m_out_vertices.size());
+	}
+	// Count the in-neighbours of each island, then fill them in.
+	g.m_in_offsets.resize(n + 1,0);
+	for (size_type k = 0; k < g.m_out_vertices.size(); ++k) {
+		++g.m_in_offsets[g.m_out_vertices[k] + 1];
+	}
+	for (size_type i = 0; i < n; ++i) {
+		g.m_in_offsets[i + 1] += g.m_in_offsets[i];
+	}
+	g.m_in_vertices.resize(g.m_out_vertices.size());
+	g.m_in_weights.resize(g.m_out_weights.size());
+	std::vector<size_type> next(g.m_in_offsets.begin(),g.m_in_offsets.end() - 1);
+	for (size_type i = 0; i < n; ++i) {
+		for (size_type k = g.m_out_offsets[i]; k < g.m_out_offsets[i + 1]; ++k) {
+			const size_type pos = next[g.m_out_vertices[k]]++;
+			g.m_in_vertices[pos] = i;
+			g.m_in_weights[pos] = g.m_out_weights[k];
 		}
 	}
-	return std::distance(m_container.begin(),it);
+	for (size_type i = 0; i < n; ++i) {
+		g.m_isl_idx[m_container[i].get()] = i;
+	}
+	std::swap(m_migr_graph,g);
 }
 
 /// Add an island to the archipelago.
@@ -227,6 +306,9 @@ void archipelago::push_back(const base_island &isl)
 	m_container.back()->m_archi = this;
 	// Insert the island in the topology.
 	m_topology->push_back();
+	compile_topology();
+	lock_type lock(m_telemetry_mutex);
+	m_isl_telemetry.push_back(island_telemetry());
 }
 
 /// Set island algorithm.
@@ -305,14 +387,11 @@ void archipelago::set_topology(const topology::base &tp)
 	if (m_container.size() < boost::numeric_cast<size_type>(t->get_number_of_vertices())) {
 		pagmo_throw(value_error,"invalid topology, too many vertices");
 	}
-	// Push back the missing vertices, if any.
-	for (size_type i = boost::numeric_cast<size_type>(t->get_number_of_vertices());
-		i < m_container.size(); ++i)
-	{
-		t->push_back();
-	}
+	// Push back the missing vertices, if any, in a single pass.
+	t->push_back(boost::numeric_cast<topology::base::vertices_size_type>(m_container.size() - t->get_number_of_vertices()));
 	// The topology is ok, assign it.
 	m_topology = t;
+	compile_topology();
 }
 
 /// Return a copy of the distribution type.
@@ -431,6 +510,68 @@ void archipelago::set_seeds(unsigned int seed) {
 
 
 
+// Milliseconds elapsed since start.
+static double elapsed_ms(const boost::posix_time::ptime &start)
+{
+	const boost::posix_time::time_duration diff = boost::posix_time::microsec_clock::local_time() - start;
+	// Take care of negative timings with low-accuracy clocks.
+	return diff.is_negative() ? 0. : diff.total_microseconds() / 1000.;
+}
+
+class archipelago::migr_lock
+{
+	public:
+		migr_lock(boost::mutex &m, double &lock_time):m_lock(m,boost::defer_lock)
+		{
+			const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+			m_lock.lock();
+			lock_time += elapsed_ms(start);
+		}
+	private:
+		boost::unique_lock<boost::mutex> m_lock;
+};
+
+// Record in the telemetry an evolution of isl which took time milliseconds and fevals objective function evaluations.
+void archipelago::record_evolution(const base_island &isl, double time, std::size_t fevals)
+{
+	const size_type isl_idx = locate_island(isl);
+	lock_type lock(m_telemetry_mutex);
+	island_telemetry &t = m_isl_telemetry[isl_idx];
+	++t.n_evolutions;
+	t.fevals += fevals;
+	t.evolution_time += time;
+	t.last_evolution_time = time;
+}
+
+// Record the migration of n_immigrants individuals into island isl_idx, of which those in rec_history were accepted,
+// together with the time spent waiting for the migration lock.
+void archipelago::record_migration(const size_type &isl_idx, const std::vector<std::pair<population::size_type, size_type> > &rec_history,
+	std::size_t n_immigrants, double lock_time)
+{
+	lock_type lock(m_telemetry_mutex);
+	island_telemetry &t = m_isl_telemetry[isl_idx];
+	std::size_t n_accepted = 0;
+	for (std::vector<std::pair<population::size_type, size_type> >::size_type i = 0; i < rec_history.size(); ++i) {
+		m_migr_hist.push_back(boost::make_tuple(rec_history[i].first,rec_history[i].second,isl_idx));
+		std::pair<std::size_t,std::size_t> &edge = m_migr_edges[std::make_pair(rec_history[i].second,isl_idx)];
+		++edge.first;
+		edge.second += rec_history[i].first;
+		n_accepted += rec_history[i].first;
+	}
+	m_migr_hist_total += rec_history.size();
+	pagmo_assert(n_accepted <= n_immigrants);
+	t.migr_accepted += n_accepted;
+	t.migr_rejected += n_immigrants - n_accepted;
+	t.migr_lock_time += lock_time;
+}
+
+// Record the time spent by island isl_idx waiting for the migration lock.
+void archipelago::record_lock_time(const size_type &isl_idx, double lock_time)
+{
+	lock_type lock(m_telemetry_mutex);
+	m_isl_telemetry[isl_idx].migr_lock_time += lock_time;
+}
+
 // This method will be called by each island of the archipelago before starting evolution. Its task is
 // to select from the other islands, according to the topology and the migration/distribution type and direction,
 // the individuals that will migrate into the island.
@@ -443,12 +584,14 @@ void archipelago::pre_evolution(base_island &isl)
 	// Determine the island's index in the archipelago.
 	const size_type isl_idx = locate_island(isl);
 	pagmo_assert(isl_idx < m_container.size());
+	// Time spent waiting for the migration lock.
+	double lock_time = 0;
 	//1. Obtain immigrants.
 	std::vector<std::pair<population::size_type, individual_type> > immigrants;
 	switch (m_migr_dir) {
 		case source:
 		{
-			lock_type lock(m_migr_mutex);
+			const migr_lock lock(m_migr_mutex,lock_time);
 			// For source migration direction, migration map contains islands' "inboxes". Or, in other words, it contains
 			// the individuals that are destined to go into the island. Such inboxes have been assembled previously,
 			// during a post_evolution operation.
@@ -467,22 +610,23 @@ void archipelago::pre_evolution(base_island &isl)
 			// For destination migration direction, items in the migration map behave like "outboxes", i.e. each one is a
 			// "database of best individuals" seen in the islands of the archipelago.
 			// Get neighbours connecting into isl.
-			const std::vector<topology::base::vertices_size_type> inv_adj_islands(m_topology->get_v_inv_adjacent_vertices(boost::numeric_cast<topology::base::vertices_size_type>(isl_idx)));
+			const size_type in_begin = m_migr_graph.m_in_offsets[isl_idx], in_end = m_migr_graph.m_in_offsets[isl_idx + 1];
 			// Do something only if there are adjacent islands.
-			if (inv_adj_islands.size()) {
+			if (in_begin != in_end) {
 				switch (m_dist_type) {
 					case point_to_point:
 					{
-						lock_type lock(m_migr_mutex);
+						const migr_lock lock(m_migr_mutex,lock_time);
 						// Get the index of a random island connecting into isl.
-						boost::uniform_int<std::vector<topology::base::vertices_size_type>::size_type> u_int(0,inv_adj_islands.size() - 1);
-						const size_type rn_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands[u_int(m_urng)]);
+						boost::uniform_int<size_type> u_int(0,in_end - in_begin - 1);
+						const size_type rn_edge = in_begin + u_int(m_urng);
+						const size_type rn_isl_idx = m_migr_graph.m_in_vertices[rn_edge];
 						// Get the immigrants from the outbox of the random island. Note the redundant information in the last
 						// argument of the function.
 						pagmo_assert(m_migr_map[rn_isl_idx].size() <= 1);
 
 						double next_rng = m_drng();
-						double migr_prob = m_topology->get_weight(rn_isl_idx, isl_idx);
+						double migr_prob = m_migr_graph.m_in_weights[rn_edge];
 						if (next_rng < migr_prob) {
 							build_immigrants_vector(immigrants,*m_container[rn_isl_idx],isl,m_migr_map[rn_isl_idx][rn_isl_idx]);
 						}
@@ -490,13 +634,13 @@ void archipelago::pre_evolution(base_island &isl)
 					}
 					case broadcast:
 					{
-						lock_type lock(m_migr_mutex);
+						const migr_lock lock(m_migr_mutex,lock_time);
 						// For broadcast migration fetch immigrants from all neighbour islands' databases.
-						for (std::vector<topology::base::vertices_size_type>::size_type i = 0; i < inv_adj_islands.size(); ++i) {
-							const size_type src_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands[i]);
+						for (size_type i = in_begin; i < in_end; ++i) {
+							const size_type src_isl_idx = m_migr_graph.m_in_vertices[i];
 							pagmo_assert(m_migr_map[src_isl_idx].size() <= 1);
 							double next_rng = m_drng();
-							double migr_prob = m_topology->get_weight(src_isl_idx, isl_idx);
+							double migr_prob = m_migr_graph.m_in_weights[i];
 							if (next_rng < migr_prob) {
 								build_immigrants_vector(immigrants,*m_container[src_isl_idx],isl,m_migr_map[src_isl_idx][src_isl_idx]);
 							}
@@ -514,15 +658,10 @@ void archipelago::pre_evolution(base_island &isl)
 		// We then insert the incoming individuals into the population, storing how many from where
 		std::vector<std::pair<population::size_type, size_type> > rec_history;
 		rec_history = isl.accept_immigrants(immigrants);
-		lock_type lock(m_migr_mutex);
 		// Record the migration history.
-		for (size_t i =0; i< rec_history.size(); ++i) {
-			m_migr_hist.push_back( boost::make_tuple(
-				rec_history[i].first,
-				rec_history[i].second,
-				isl_idx)
-			);
-		}
+		record_migration(isl_idx,rec_history,immigrants.size(),lock_time);
+	} else {
+		record_lock_time(isl_idx,lock_time);
 	}
 }
 
@@ -538,14 +677,16 @@ void archipelago::post_evolution(base_island &isl)
 	// Determine the island's index in the archipelago.
 	const size_type isl_idx = locate_island(isl);
 	pagmo_assert(isl_idx < m_container.size());
+	// Time spent waiting for the migration lock.
+	double lock_time = 0;
 	// Create the vector of emigrants.
 	std::vector<individual_type> emigrants;
 	switch (m_migr_dir) {
 		case source:
 		{
 			// Get the islands to which isl connects.
-			const std::vector<topology::base::vertices_size_type> adj_islands(m_topology->get_v_adjacent_vertices(boost::numeric_cast<topology::base::vertices_size_type>(isl_idx)));
-			if (adj_islands.size()) {
+			const size_type out_begin = m_migr_graph.m_out_offsets[isl_idx], out_end = m_migr_graph.m_out_offsets[isl_idx + 1];
+			if (out_begin != out_end) {
 				emigrants = isl.get_emigrants();
 				// Do something only if we have emigrants.
 				if (emigrants.size()) {
@@ -553,12 +694,13 @@ void archipelago::post_evolution(base_island &isl)
 					{
 						case point_to_point:
 						{
-							lock_type lock(m_migr_mutex);
+							const migr_lock lock(m_migr_mutex,lock_time);
 							// For one-to-one migration choose a random neighbour island and put immigrants to its inbox.
-							boost::uniform_int<std::vector<topology::base::vertices_size_type>::size_type> u_int(0,adj_islands.size() - 1);
-							const size_type chosen_adj = boost::numeric_cast<size_type>(adj_islands[u_int(m_urng)]);
+							boost::uniform_int<size_type> u_int(0,out_end - out_begin - 1);
+							const size_type chosen_edge = out_begin + u_int(m_urng);
+							const size_type chosen_adj = m_migr_graph.m_out_vertices[chosen_edge];
 							double next_rng = m_drng();
-							double migr_prob = m_topology->get_weight(isl_idx, chosen_adj);
+							double migr_prob = m_migr_graph.m_out_weights[chosen_edge];
 							if (next_rng < migr_prob) {
 								m_migr_map[chosen_adj][isl_idx].insert(m_migr_map[chosen_adj][isl_idx].end(),emigrants.begin(),emigrants.end());
 							}
@@ -566,14 +708,15 @@ void archipelago::post_evolution(base_island &isl)
 						}
 						case broadcast:
 						{
-							lock_type lock(m_migr_mutex);
+							const migr_lock lock(m_migr_mutex,lock_time);
 							// For broadcast migration put immigrants to all neighbour islands' inboxes.
-							for (std::vector<topology::base::vertices_size_type>::size_type i = 0; i < adj_islands.size(); ++i) {
+							for (size_type i = out_begin; i < out_end; ++i) {
 								double next_rng = m_drng();
-								double migr_prob = m_topology->get_weight(isl_idx, adj_islands[i]);
+								double migr_prob = m_migr_graph.m_out_weights[i];
 								if (next_rng < migr_prob) {
-									m_migr_map[boost::numeric_cast<size_type>(adj_islands[i])][isl_idx]
-										.insert(m_migr_map[boost::numeric_cast<size_type>(adj_islands[i])][isl_idx].end(),
+									const size_type adj_isl_idx = m_migr_graph.m_out_vertices[i];
+									m_migr_map[adj_isl_idx][isl_idx]
+										.insert(m_migr_map[adj_isl_idx][isl_idx].end(),
 										emigrants.begin(),emigrants.end());
 								}
 							}
@@ -587,11 +730,12 @@ void archipelago::post_evolution(base_island &isl)
 		{
 			// For destination migration direction, migration map behaves like "outboxes", i.e. each is a "database of best individuals" for corresponding island.
 			emigrants = isl.get_emigrants();
-			lock_type lock(m_migr_mutex);
+			const migr_lock lock(m_migr_mutex,lock_time);
 			pagmo_assert(m_migr_map[isl_idx].size() <= 1);
 			m_migr_map[isl_idx][isl_idx].swap(emigrants);
 		}
 	}
+	record_lock_time(isl_idx,lock_time);
 }
 
 /// Run the evolution for the given number of iterations.
@@ -603,6 +747,7 @@ void archipelago::post_evolution(base_island &isl)
 void archipelago::evolve(int n)
 {
 	join();
+	compile_topology();
 	const iterator it_f = m_container.end();
 	// Reset thread barrier.
 	reset_barrier(m_container.size());
@@ -625,6 +770,7 @@ void archipelago::evolve(int n)
 void archipelago::evolve_batch(int n, unsigned int b, bool randomize)
 {
 	join();
+	compile_topology();
 	container_type::size_type arch_size = this->get_size();
 	// Order of populations to evolve, by default biased by the index (lowest first)
 	std::vector<population::size_type> pop_order(arch_size);
@@ -654,6 +800,165 @@ void archipelago::evolve_batch(int n, unsigned int b, bool randomize)
 	}
 }
 
+// Shared state of the threads of evolve_pool(): the threads themselves, the queue of islands waiting for their next
+// evolution, the number of evolutions left for each island and in total, and a flag to stop the threads early.
+struct archipelago::pool_state
+{
+	pool_state():m_pending(0),m_stop(false) {}
+	boost::thread_group		m_threads;
+	boost::mutex			m_mutex;
+	boost::condition_variable	m_cond;
+	std::deque<size_type>		m_queue;
+	std::vector<std::size_t>	m_remaining;
+	std::size_t			m_pending;
+	bool				m_stop;
+};
+
+// Body of the threads of evolve_pool(): keep pulling the next pending island from the queue and evolve it once.
+// An island is never in the queue while being evolved, and it is put back at the end of the queue if it has
+// evolutions left. Threads that find the queue empty wait for islands being evolved by other threads to be queued back.
+// As in the island evolvers, an interruption point is set after each evolution.
+void archipelago::pool_worker(pool_state *state)
+{
+	try {
+		while (true) {
+			size_type idx;
+			{
+				boost::unique_lock<boost::mutex> lock(state->m_mutex);
+				while (state->m_queue.empty() && state->m_pending && !state->m_stop) {
+					state->m_cond.wait(lock);
+				}
+				if (!state->m_pending || state->m_stop) {
+					return;
+				}
+				idx = state->m_queue.front();
+				state->m_queue.pop_front();
+			}
+			base_island &isl = *m_container[idx];
+			const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+			bool failed = false;
+			try {
+				isl.evolve_step_hooked();
+			} catch (const boost::thread_interrupted &) {
+				throw;
+			} catch (const std::exception &e) {
+				std::cout << "Error during island evolution using " << isl.m_algo->get_name() << ": " << e.what() << std::endl;
+				failed = true;
+			} catch (...) {
+				std::cout << "Error during island evolution using " << isl.m_algo->get_name() << ", unknown exception caught. :(" << std::endl;
+				failed = true;
+			}
+			// Take care of negative timings with low-accuracy clocks, as in the island evolvers.
+			const boost::posix_time::time_duration diff = boost::posix_time::microsec_clock::local_time() - start;
+			if (diff.total_milliseconds() >= 0) {
+				isl.m_evo_time += boost::numeric_cast<std::size_t>(diff.total_milliseconds());
+			}
+			{
+				lock_type lock(state->m_mutex);
+				// As in the island evolvers, an error ends the evolution of the island.
+				const std::size_t done = failed ? state->m_remaining[idx] : 1u;
+				state->m_remaining[idx] -= done;
+				state->m_pending -= done;
+				if (state->m_remaining[idx]) {
+					state->m_queue.push_back(idx);
+				}
+			}
+			state->m_cond.notify_all();
+			// Set the interruption point.
+			boost::this_thread::interruption_point();
+		}
+	} catch (const boost::thread_interrupted &) {
+		// In case of interruption, stop the other threads as well.
+		{
+			lock_type lock(state->m_mutex);
+			state->m_stop = true;
+		}
+		state->m_cond.notify_all();
+	}
+}
+
+/// Run the evolution for the given number of iterations with a pool of threads.
+/**
+ * Will evolve n times each island of the archipelago using a fixed pool of b threads. Each thread keeps pulling
+ * the next pending island from a queue and performs a single evolution on it (with migration before and after, as in evolve()),
+ * after which the island is queued back if it has evolutions left. As with evolve_batch(), at most b islands evolve at the same time, but
+ * no thread waits for the slowest island of a batch and no thread is created or barrier reset between batches.
+ * Islands evolve one at a time in turn, so that they progress at a similar pace and migration
+ * happens at each evolution boundary for any n.
+ *
+ * Contrary to evolve() and evolve_batch(), the islands' own threads are not used: the method returns only when all the
+ * evolutions have been performed, or when the evolution is stopped by a call to interrupt() from another thread (in which
+ * case the threads stop after the evolutions they are performing). In case of errors during the evolution of an island,
+ * the error is printed and no further evolution is performed on that island.
+ *
+ * \param[in] n number of time each island will be evolved.
+ * \param[in] b number of threads in the pool.
+ * \param[in] randomize determines whether islands are first queued in index-order (randomize=false) or in random order (randomize=true)
+ *
+ * @throws value_error if b is zero.
+ */
+void archipelago::evolve_pool(int n, unsigned int b, bool randomize)
+{
+	if (!b) {
+		pagmo_throw(value_error,"the number of threads in the pool must be positive");
+	}
+	const std::size_t n_evo = boost::numeric_cast<std::size_t>(n);
+	// The state is published before joining the ongoing evolutions, so that interrupt() reaches it from the start of
+	// the call: an interruption arriving before the threads are launched stops them before their first evolution.
+	pool_state state;
+	{
+		lock_type lock(m_pool_mutex);
+		m_pool = &state;
+	}
+	bool launched = true;
+	try {
+		join();
+		const size_type arch_size = get_size();
+		if (n_evo && arch_size) {
+			compile_topology();
+			state.m_remaining.resize(arch_size,n_evo);
+			for (size_type i = 0; i < arch_size; ++i) {
+				state.m_queue.push_back(i);
+			}
+			if (randomize) {
+				boost::uniform_int<int> pop_idx(0,arch_size-1);
+				boost::variate_generator<boost::mt19937 &, boost::uniform_int<int> > p_idx(m_urng,pop_idx);
+				std::random_shuffle(state.m_queue.begin(), state.m_queue.end(), p_idx);
+			}
+			{
+				lock_type lock(state.m_mutex);
+				state.m_pending = n_evo * arch_size;
+			}
+			const size_type n_threads = std::min<size_type>(b,arch_size);
+			try {
+				for (size_type i = 0; i < n_threads; ++i) {
+					state.m_threads.create_thread(boost::bind(&archipelago::pool_worker,this,&state));
+				}
+			} catch (...) {
+				// Let the threads already created terminate before throwing.
+				{
+					lock_type lock(state.m_mutex);
+					state.m_stop = true;
+				}
+				state.m_cond.notify_all();
+				launched = false;
+			}
+			state.m_threads.join_all();
+		}
+	} catch (...) {
+		lock_type lock(m_pool_mutex);
+		m_pool = 0;
+		throw;
+	}
+	{
+		lock_type lock(m_pool_mutex);
+		m_pool = 0;
+	}
+	if (!launched) {
+		pagmo_throw(std::runtime_error,"failed to launch the thread");
+	}
+}
+
 /// Run the evolution for a minimum amount of time.
 /**
  * Will iteratively call island::evolve_t(n) on each island of the archipelago and then return.
@@ -663,6 +968,7 @@ void archipelago::evolve_batch(int n, unsigned int b, bool randomize)
 void archipelago::evolve_t(int t)
 {
 	join();
+	compile_topology();
 	const iterator it_f = m_container.end();
 	reset_barrier(m_container.size());
 	for (iterator it = m_container.begin(); it != it_f; ++it) {
@@ -687,10 +993,23 @@ bool archipelago::busy() const
 
 /// Interrupt ongoing evolution.
 /**
- * Will iteratively called island::interrupt() on all the islands of the archipelago.
+ * Will interrupt the threads of an ongoing evolve_pool(), and then iteratively call island::interrupt() on all the islands
+ * of the archipelago. The threads of evolve_pool() stop after the evolutions they are performing, without waiting for them.
+ * If evolve_pool() has been called but its threads are not running yet, they will stop before performing any evolution.
  */
 void archipelago::interrupt()
 {
+	{
+		lock_type lock(m_pool_mutex);
+		if (m_pool) {
+			{
+				lock_type state_lock(m_pool->m_mutex);
+				m_pool->m_stop = true;
+			}
+			m_pool->m_cond.notify_all();
+			m_pool->m_threads.interrupt_all();
+		}
+	}
 	const iterator it_f = m_container.end();
 	for (iterator it = m_container.begin(); it != it_f; ++it) {
 		(*it)->interrupt();
@@ -737,6 +1056,10 @@ void archipelago::set_island(const size_type &idx, const base_island &isl)
 	m_container[idx] = isl.clone();
 	// Tell the island that it is living in an archipelago now.
 	m_container[idx]->m_archi = this;
+	compile_topology();
+	// The telemetry refers to the island being replaced.
+	lock_type lock(m_telemetry_mutex);
+	m_isl_telemetry[idx] = island_telemetry();
 }
 
 /// Get vector of islands in the archipelago.
@@ -757,19 +1080,28 @@ std::vector<base_island_ptr> archipelago::get_islands() const
 
 // Synchronise the start of evolution in each island so that all threads are created and initialised
 // before actually doing any computation.
-void archipelago::sync_island_start() const
+void archipelago::sync_island_start(const base_island &isl)
 {
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
 	m_islands_sync_point->wait();
+	const double time = elapsed_ms(start);
+	const size_type isl_idx = locate_island(isl);
+	lock_type lock(m_telemetry_mutex);
+	m_isl_telemetry[isl_idx].barrier_time += time;
 }
 
 /// Dumps the archipelago migration history
 /**
+ * Will synchronise the archipelago before dumping the history, which keeps only the most recent migrations, up to
+ * get_migr_history_capacity() items. Use get_telemetry() to monitor the archipelago while it is evolving.
+ *
  * @return A string formatted as follows: (x1,y1,z1)\n(x2,y2,z2)..... where x is the number of individuals
  * accepted in island z and coming from island y
  */
 std::string archipelago::dump_migr_history() const
 {
 	join();
+	lock_type lock(m_telemetry_mutex);
 	std::ostringstream oss;
 	for (migr_hist_type::const_iterator it = m_migr_hist.begin(); it != m_migr_hist.end(); ++it) {
 		oss << "(" << (*it).get<0>()
@@ -782,13 +1114,88 @@ std::string archipelago::dump_migr_history() const
 
 /// Clears the archipelago migration history
 /**
- * @return Empties the migration history. If dump_migr_history is called immediately after, 
+ * Will synchronise the archipelago before clearing the history.
+ *
+ * @return Empties the migration history and resets the migration counters of the edges. If dump_migr_history is called immediately after,
  * it will return an empty string
  */
 void archipelago::clear_migr_history()
 {
 	join();
+	lock_type lock(m_telemetry_mutex);
 	m_migr_hist.clear();
+	m_migr_edges.clear();
+	m_migr_hist_total = 0;
+}
+
+/// Get the capacity of the migration history.
+/**
+ * @return the maximum number of items kept in the migration history.
+ */
+archipelago::size_type archipelago::get_migr_history_capacity() const
+{
+	lock_type lock(m_telemetry_mutex);
+	return m_migr_hist.capacity();
+}
+
+/// Set the capacity of the migration history.
+/**
+ * Once the history is full, the oldest items are dropped as new migrations are recorded. If the history holds more than
+ * n items, the oldest ones are dropped immediately. The migration counters of the edges returned by get_telemetry() are not affected
+ * by the capacity.
+ *
+ * @param[in] n maximum number of items kept in the migration history.
+ */
+void archipelago::set_migr_history_capacity(const size_type &n)
+{
+	lock_type lock(m_telemetry_mutex);
+	m_migr_hist.rset_capacity(n);
+}
+
+/// Get a snapshot of the telemetry.
+/**
+ * The telemetry is updated by the islands after each evolution and whenever they migrate. This method does not wait for the evolution
+ * to end, so that the archipelago can be monitored from another thread while evolving.
+ *
+ * @return the current archipelago::telemetry.
+ */
+archipelago::telemetry archipelago::get_telemetry() const
+{
+	telemetry retval;
+	lock_type lock(m_telemetry_mutex);
+	retval.islands = m_isl_telemetry;
+	retval.edges.reserve(m_migr_edges.size());
+	for (migr_edge_map_type::const_iterator it = m_migr_edges.begin(); it != m_migr_edges.end(); ++it) {
+		migr_edge_telemetry e;
+		e.src = it->first.first;
+		e.dest = it->first.second;
+		e.n_migrations = it->second.first;
+		e.n_individuals = it->second.second;
+		retval.edges.push_back(e);
+	}
+	std::sort(retval.edges.begin(),retval.edges.end(),edge_telemetry_less);
+	retval.migr_history_size = m_migr_hist.size();
+	retval.migr_history_total = m_migr_hist_total;
+	return retval;
+}
+
+/// Default constructor.
+/**
+ * Initialises all the counters to zero.
+ */
+archipelago::island_telemetry::island_telemetry():n_evolutions(0),fevals(0),evolution_time(0),last_evolution_time(0),
+	migr_accepted(0),migr_rejected(0),migr_lock_time(0),barrier_time(0) {}
+
+/// Objective function evaluations per second.
+/**
+ * @return the number of objective function evaluations performed per second of evolution, or zero if no time was spent in evolution.
+ */
+double archipelago::island_telemetry::get_fevals_per_second() const
+{
+	if (evolution_time <= 0) {
+		return 0.;
+	}
+	return fevals / (evolution_time / 1000.);
 }
 
 /// Overload stream operator for pagmo::archipelago.
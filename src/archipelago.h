@@ -25,6 +25,7 @@
 #ifndef PAGMO_ARCHIPELAGO_H
 #define PAGMO_ARCHIPELAGO_H
 
+#include <boost/circular_buffer.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/thread/barrier.hpp>
 #include <boost/thread/locks.hpp>
@@ -105,6 +106,55 @@ class __PAGMO_VISIBLE archipelago
 			 */
 			destination = 1
 		};
+		/// Telemetry of an island.
+		/**
+		 * Counters accumulated by an island of the archipelago across all evolutions. Times are wall-clock times in milliseconds.
+		 */
+		struct __PAGMO_VISIBLE island_telemetry
+		{
+			island_telemetry();
+			double get_fevals_per_second() const;
+			/// Number of evolutions performed.
+			std::size_t	n_evolutions;
+			/// Number of objective function evaluations performed during the evolutions.
+			std::size_t	fevals;
+			/// Total time spent in the evolutions, migration included.
+			double		evolution_time;
+			/// Time spent in the last evolution, migration included.
+			double		last_evolution_time;
+			/// Number of immigrants accepted by the replacement policy.
+			std::size_t	migr_accepted;
+			/// Number of immigrants discarded by the replacement policy.
+			std::size_t	migr_rejected;
+			/// Total time spent waiting for the migration lock.
+			double		migr_lock_time;
+			/// Total time spent waiting for the other islands at the start of an evolution.
+			double		barrier_time;
+		};
+		/// Aggregated migration counters of a topology edge.
+		struct __PAGMO_VISIBLE migr_edge_telemetry
+		{
+			/// Island from which the individuals migrated.
+			size_type	src;
+			/// Island into which the individuals migrated.
+			size_type	dest;
+			/// Number of migrations recorded.
+			std::size_t	n_migrations;
+			/// Number of individuals accepted.
+			std::size_t	n_individuals;
+		};
+		/// Snapshot of the telemetry of the archipelago.
+		struct __PAGMO_VISIBLE telemetry
+		{
+			/// Telemetry of each island, in the order of the archipelago.
+			std::vector<island_telemetry>		islands;
+			/// Migration counters of the edges along which migration took place, sorted by source and destination.
+			std::vector<migr_edge_telemetry>	edges;
+			/// Number of migrations in the history.
+			std::size_t				migr_history_size;
+			/// Number of migrations recorded since the history was last cleared, including those dropped from the history.
+			std::size_t				migr_history_total;
+		};
 	private:
 		// Iterators.
 		typedef container_type::iterator iterator;
@@ -118,8 +168,10 @@ class __PAGMO_VISIBLE archipelago
 		typedef boost::lock_guard<boost::mutex> lock_type;
 		// Migration history item: (n_individuals,orig_island,dest_island) tuple.
 		typedef boost::tuple<population::size_type,size_type,size_type> migr_hist_item;
-		// Container of migration history: vector of history items.
-		typedef std::vector<migr_hist_item> migr_hist_type;
+		// Container of migration history: ring buffer of the most recent history items.
+		typedef boost::circular_buffer<migr_hist_item> migr_hist_type;
+		// Aggregated migration counters, (number of migrations,number of individuals), for each (orig_island,dest_island) edge.
+		typedef boost::unordered_map<std::pair<size_type,size_type>,std::pair<std::size_t,std::size_t> > migr_edge_map_type;
 	public:
 		explicit archipelago(distribution_type = point_to_point, migration_direction = destination);
 		explicit archipelago(const topology::base &, distribution_type = point_to_point, migration_direction = destination);
@@ -140,11 +192,15 @@ class __PAGMO_VISIBLE archipelago
 		void set_distribution_type(const distribution_type &);
 		void evolve(int = 1);
 		void evolve_batch(int, unsigned int, bool = true);
+		void evolve_pool(int, unsigned int, bool = true);
 		void evolve_t(int);
 		bool busy() const;
 		void interrupt();
 		std::string dump_migr_history() const;
 		void clear_migr_history();
+		size_type get_migr_history_capacity() const;
+		void set_migr_history_capacity(const size_type &);
+		telemetry get_telemetry() const;
 		void set_island(const size_type &, const base_island &);
 		std::vector<base_island_ptr> get_islands() const;
 		base_island_ptr get_island(const size_type &) const;
@@ -153,11 +209,20 @@ class __PAGMO_VISIBLE archipelago
 		void pre_evolution(base_island &);
 		void post_evolution(base_island &);
 		void reset_barrier(const size_type &);
+		void compile_topology();
+		// Shared state of the threads of evolve_pool().
+		struct pool_state;
+		void pool_worker(pool_state *);
 		void build_immigrants_vector(std::vector<std::pair<population::size_type, individual_type > > &,
 			const base_island &, base_island &,
 			const std::vector<individual_type> &) const;
 		void check_migr_attributes() const;
-		void sync_island_start() const;
+		void sync_island_start(const base_island &);
+		void record_evolution(const base_island &, double, std::size_t);
+		void record_migration(const size_type &, const std::vector<std::pair<population::size_type, size_type> > &, std::size_t, double);
+		void record_lock_time(const size_type &, double);
+		// Lock on the migration mutex measuring the time spent waiting for it.
+		class migr_lock;
 		size_type locate_island(const base_island &) const;
 		bool destruction_checks() const;
 		void reevaluate_immigrants(std::vector<std::pair<population::size_type, individual_type> > &,
@@ -191,8 +256,13 @@ class __PAGMO_VISIBLE archipelago
 			for (size_type i = 0; i < m_container.size(); ++i) {
 				m_container[i]->m_archi = this;
 			}
-			// NOTE: migr history is not saved, so upon loading we clear it.
+			compile_topology();
+			// NOTE: migr history and telemetry are not saved, so upon loading we reset them.
+			lock_type lock(m_telemetry_mutex);
 			m_migr_hist.clear();
+			m_migr_edges.clear();
+			m_migr_hist_total = 0;
+			m_isl_telemetry.assign(m_container.size(),island_telemetry());
 		}
 		// Container of islands.
 		container_type				m_container;
@@ -211,8 +281,34 @@ class __PAGMO_VISIBLE archipelago
 		rng_uint32					m_urng;
 		// Migration mutex.
 		boost::mutex				m_migr_mutex;
+		// Threads of the ongoing evolve_pool(), if any, reached by interrupt() through the mutex.
+		boost::mutex				m_pool_mutex;
+		pool_state				*m_pool;
+		// Mutex protecting the migration history and the telemetry, which can be read while the islands evolve.
+		mutable boost::mutex			m_telemetry_mutex;
 		// Migration history.
 		migr_hist_type				m_migr_hist;
+		// Number of migrations recorded since the history was last cleared.
+		std::size_t				m_migr_hist_total;
+		// Migration counters for each edge.
+		migr_edge_map_type			m_migr_edges;
+		// Telemetry of each island.
+		std::vector<island_telemetry>		m_isl_telemetry;
+		// Flat snapshot of the topology read by the migration methods, compiled by compile_topology() whenever the
+		// islands or the topology change: the neighbours of each island in compressed sparse row format (the neighbours of island n are
+		// in the range [offsets[n],offsets[n + 1]) of the vertices vector), together with the migration probabilities
+		// of the corresponding edges, and the position of each island in the archipelago.
+		struct migration_graph
+		{
+			std::vector<size_type>					m_out_offsets;
+			std::vector<size_type>					m_out_vertices;
+			std::vector<double>					m_out_weights;
+			std::vector<size_type>					m_in_offsets;
+			std::vector<size_type>					m_in_vertices;
+			std::vector<double>					m_in_weights;
+			boost::unordered_map<const base_island *,size_type>	m_isl_idx;
+		};
+		migration_graph				m_migr_graph;
 
 };
 
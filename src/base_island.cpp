@@ -233,6 +233,41 @@ struct base_island::raii_thread_hook
 	base_island *m_ptr;
 };
 
+// Perform a single evolution of the population, surrounded by the pre/post evolution hooks
+// of the archipelago (i.e., migration) and of the problem. The time and the objective function
+// evaluations spent are recorded in the telemetry of the archipelago.
+void base_island::evolve_step()
+{
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+	const unsigned int start_fevals = m_pop.problem().get_fevals();
+	// Call pre-evolve hooks.
+	if (m_archi) {
+		m_archi->pre_evolution(*this);
+	}
+	m_pop.problem().pre_evolution(m_pop);
+	// Call the evolution.
+	perform_evolution(*m_algo,m_pop);
+	// Post-evolve hooks.
+	if (m_archi) {
+		m_archi->post_evolution(*this);
+	}
+	m_pop.problem().post_evolution(m_pop);
+	if (m_archi) {
+		const boost::posix_time::time_duration diff = boost::posix_time::microsec_clock::local_time() - start;
+		// NOTE: the unsigned difference copes with the wrapping of the counter.
+		m_archi->record_evolution(*this,diff.is_negative() ? 0. : diff.total_microseconds() / 1000.,
+			m_pop.problem().get_fevals() - start_fevals);
+	}
+}
+
+// Same as evolve_step(), for threads not owned by the island (see archipelago::evolve_pool()):
+// the thread hooks are called around the evolution.
+void base_island::evolve_step_hooked()
+{
+	const raii_thread_hook hook(this);
+	evolve_step();
+}
+
 // Evolver thread object. This is a callable helper object used to launch an evolution for a given number of iterations.
 struct base_island::int_evolver {
 	int_evolver(base_island *i, const std::size_t &n):m_i(i),m_n(n) {}
@@ -247,22 +282,11 @@ void base_island::int_evolver::juice_impl(boost::posix_time::ptime &start)
 	start = boost::posix_time::microsec_clock::local_time();
 	// Synchronise start with all other threads if we are in an archi.
 	if (m_i->m_archi) {
-		m_i->m_archi->sync_island_start();
+		m_i->m_archi->sync_island_start(*m_i);
 	}
 	const raii_thread_hook hook(m_i);
 	for (std::size_t i = 0; i < m_n; ++i) {
-		// Call pre-evolve hooks.
-		if (m_i->m_archi) {
-			m_i->m_archi->pre_evolution(*m_i);
-		}
-		m_i->m_pop.problem().pre_evolution(m_i->m_pop);
-		// Call the evolution.
-		m_i->perform_evolution(*m_i->m_algo,m_i->m_pop);
-		// Post-evolve hooks.
-		if (m_i->m_archi) {
-			m_i->m_archi->post_evolution(*m_i);
-		}
-		m_i->m_pop.problem().post_evolution(m_i->m_pop);
+		m_i->evolve_step();
 		// Set the interruption point.
 		boost::this_thread::interruption_point();
 	}
@@ -331,19 +355,11 @@ void base_island::t_evolver::juice_impl(boost::posix_time::ptime &start)
 	start = boost::posix_time::microsec_clock::local_time();
 	// Synchronise start.
 	if (m_i->m_archi) {
-		m_i->m_archi->sync_island_start();
+		m_i->m_archi->sync_island_start(*m_i);
 	}
 	const raii_thread_hook hook(m_i);
 	do {
-		if (m_i->m_archi) {
-			m_i->m_archi->pre_evolution(*m_i);
-		}
-		m_i->m_pop.problem().pre_evolution(m_i->m_pop);
-		m_i->perform_evolution(*m_i->m_algo,m_i->m_pop);
-		if (m_i->m_archi) {
-			m_i->m_archi->post_evolution(*m_i);
-		}
-		m_i->m_pop.problem().post_evolution(m_i->m_pop);
+		m_i->evolve_step();
 		// Set the interruption point.
 		boost::this_thread::interruption_point();
 		diff = boost::posix_time::microsec_clock::local_time() - start;
@@ -28,6 +28,7 @@
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
+#include <cmath>
 #include <iterator>
 #include <sstream>
 #include <string>
@@ -40,6 +41,8 @@
 #include "population.h"
 #include "rng.h"
 #include "types.h"
+#include "util/discrepancy.h"
+#include "util/multi_objective.h"
 #include "util/racing.h"
 #include "util/race_pop.h"
 
@@ -94,6 +97,46 @@ population::population(const problem::base &p, int n, const boost::uint32_t &see
 	}
 }
 
+/// Constructor from problem::base, number of individuals and sampler.
+/**
+ * Will store a copy of the problem and will initialise the population to the next n points of the sampler (e.g. a
+ * util::discrepancy::sobol sequence), mapped from the unit hypercube onto the problem's bounds. The integer part
+ * of the chromosome is obtained splitting each coordinate in as many equal intervals as there are integers in the bounds.
+ * The velocities are initialised randomly, as in reinit().
+ *
+ * @param[in] p problem::base that will be associated to the population.
+ * @param[in] n integer number of individuals in the population.
+ * @param[in] sampler sequence of points in the unit hypercube, of the same dimension as the problem.
+ * @param[in] seed rng seed (used to initialize the velocities and in race)
+ *
+ * @throw value_error if n is negative or if the dimension of the sampler differs from the problem dimension.
+ */
+population::population(const problem::base &p, int n, util::discrepancy::base &sampler, const boost::uint32_t &seed):
+	m_prob(p.clone()), m_pareto_rank(n), m_crowding_d(n), m_drng(seed),m_urng(seed)
+{
+	if (n < 0) {
+		pagmo_throw(value_error,"number of individuals cannot be negative");
+	}
+	const decision_vector::size_type p_size = m_prob->get_dimension(), i_size = m_prob->get_i_dimension();
+	if (sampler.get_dimension() != p_size) {
+		pagmo_throw(value_error,"the dimension of the sampler must be equal to the problem dimension");
+	}
+	const decision_vector &lb = m_prob->get_lb(), &ub = m_prob->get_ub();
+	std::vector<double> block;
+	sampler.next_block(block,boost::numeric_cast<size_type>(n));
+	decision_vector x(p_size);
+	for (size_type i = 0; i < boost::numeric_cast<size_type>(n); ++i) {
+		const double *u = &block[i * p_size];
+		for (decision_vector::size_type j = 0; j < p_size - i_size; ++j) {
+			x[j] = std::min(lb[j] + u[j] * (ub[j] - lb[j]),ub[j]);
+		}
+		for (decision_vector::size_type j = p_size - i_size; j < p_size; ++j) {
+			x[j] = std::min(lb[j] + std::floor(u[j] * (ub[j] - lb[j] + 1)),ub[j]);
+		}
+		push_back(x);
+	}
+}
+
 /// Copy constructor.
 /**
  * Will perform a deep copy of all the elements.
@@ -179,6 +222,18 @@ void population::update_dom(const size_type &n)
 	}
 }
 
+// Rebuild from scratch the domination lists and the domination counts.
+void population::rebuild_dom()
+{
+	std::vector<fitness_vector> fit(m_container.size());
+	std::vector<constraint_vector> cons(m_container.size());
+	for (size_type i = 0; i < m_container.size(); ++i) {
+		fit[i] = m_container[i].best_f;
+		cons[i] = m_container[i].best_c;
+	}
+	util::multi_objective::domination_lists(m_dom_list,m_dom_count,*m_prob,fit,cons);
+}
+
 // Init randomly the velocity of the individual in position idx.
 void population::init_velocity(const size_type &idx)
 {
@@ -361,107 +416,21 @@ double population::get_crowding_d(const size_type &idx) const
 	return m_crowding_d[idx];
 }
 
-// This functor is used to sort (minimization assumed) along a particular fitness dimension.
-// Needed for the computations of the crowding distance
-struct one_dim_fit_comp {
-	one_dim_fit_comp(const population &pop, fitness_vector::size_type dim):m_pop(pop), m_dim(dim) {};
-	bool operator()(const population::size_type& idx1, const population::size_type& idx2) const
-	{
-		return m_pop.get_individual(idx1).cur_f[m_dim] < m_pop.get_individual(idx2).cur_f[m_dim];
-	}
-	const population& m_pop;
-	fitness_vector::size_type m_dim;
-};
-
-
 /// Update Pareto Information
 /**
  * Computes all pareto fronts, updates the pareto rank and the crowding distance of each individual.
- * Member variables for rank and crowding distance are set to zero and domination lists and
- * domination count are used to for the computation.
- */
-
-void population::update_pareto_information() const {
-	// Population size can change between calls and m_pareto_rank, m_crowding_d are updated if necessary
-	m_pareto_rank.resize(size());
-	m_crowding_d.resize(size());
-
-	// We initialize the ranks and all distances to zero
-	std::fill(m_pareto_rank.begin(), m_pareto_rank.end(), 0);
-	std::fill(m_crowding_d.begin(), m_crowding_d.end(), 0);
-
-	// We define some utility vectors .....
-	std::vector<population::size_type> F,S;
-
-	// And make a copy of the domination count (number of individuals that dominating one individual)
-	std::vector<population::size_type> dom_count_copy(m_dom_count);
-
-	// 1 - Find the first Pareto Front
-	for (population::size_type idx = 0; idx < m_container.size(); ++idx){
-		if (m_dom_count[idx] == 0) {
-			F.push_back(idx);
-		}
-	}
-
-	unsigned int irank = 1;
-
-	// We loop to find subsequent fronts
-	while (F.size()!=0) {
-		// update crowding distance of the current pareto front
-		population::update_crowding_d(F);
-		//For each individual F in the current front
-		for (population::size_type i=0; i < F.size(); ++i) {
-			//For each individual dominated by F
-			for (population::size_type j=0; j<m_dom_list[F[i]].size(); ++j) {
-				dom_count_copy[m_dom_list[F[i]][j]]--;
-				if (dom_count_copy[m_dom_list[F[i]][j]] == 0){
-					S.push_back(m_dom_list[F[i]][j]);
-					m_pareto_rank[m_dom_list[F[i]][j]] = irank;
-				}
-			}
-		}
-		F = S;
-		S.clear();
-		irank++;
-	}
-}
-
-
-/// Update Crowding Distance
-/**
- * This method computes the crowding distance of the entire population. This distance is saved
- * in the member variable m_crowding_d.
+ * The domination lists and domination count are used for the non-dominated sorting, the crowding distance
+ * is computed on the current fitness vectors.
  *
  * @see Deb, K. and Pratap, A. and Agarwal, S. and Meyarivan, T., "A fast and elitist multiobjective genetic algorithm: NSGA-II"
- *
- * @param[in] I indices of the individuals of the pareto front
- *
  */
-void population::update_crowding_d(std::vector<population::size_type> I) const {
-
-	size_type lastidx = I.size() - 1;
-
-	// we construct the comparison functor along the first fitness component
-		one_dim_fit_comp funct(*this,0);
-
-	// we loop along fitness components
-		for (fitness_vector::size_type i = 0; i < problem().get_f_dimension(); ++i) {
-			funct.m_dim = i;
-				// we sort I along the fitness_dimension i
-		std::sort(I.begin(),I.end(), funct );
-			// assign Inf to the boundaries
-			m_crowding_d[I[0]] = std::numeric_limits<double>::max();
-			m_crowding_d[I[lastidx]] = std::numeric_limits<double>::max();
-			//and compute the crowding distance
-			double df = get_individual(I[lastidx]).cur_f[i] - get_individual(I[0]).cur_f[i];
-			for (population::size_type j = 1; j < lastidx; ++j) {
-				if (df == 0.0) { 						// handles the case in which the pareto front collapses to one single point
-					m_crowding_d[I[j]] += 0.0;			// avoiding creation of nans that can't be serialized
-				} else {
-					m_crowding_d[I[j]] += (get_individual(I[j+1]).cur_f[i] - get_individual(I[j-1]).cur_f[i])/df;
-				}
-			}
-		}
+void population::update_pareto_information() const {
+	util::multi_objective::non_dominated_sort(m_pareto_rank, m_dom_list, m_dom_count);
+	std::vector<fitness_vector> fit(m_container.size());
+	for (size_type i = 0; i < m_container.size(); ++i) {
+		fit[i] = m_container[i].cur_f;
+	}
+	util::multi_objective::crowding_distance(m_crowding_d, util::multi_objective::fitness_matrix(fit), util::multi_objective::pareto_fronts(m_pareto_rank));
 }
 
 /// Computes and returns the population Pareto fronts
@@ -900,6 +869,105 @@ void population::set_x(const size_type &idx, const decision_vector &x)
 	m_prob->objfun(m_container[idx].cur_f,x);
 	// Update current constraints vector.
 	m_prob->compute_constraints(m_container[idx].cur_c,x);
+	update_bests(idx);
+}
+
+/// Set the decision vector of individual at position idx to x, with known fitness and constraint vectors.
+/**
+ * Same as set_x(const size_type &, const decision_vector &), but the fitness and constraint vectors are not computed: f and c
+ * must be the fitness and constraint vectors of x, e.g., computed on a clone of the problem by util::async_evaluator.
+ *
+ * @param[in] idx positional index of the individual to be set.
+ * @param[in] x decision vector to be set for the individual at position idx.
+ * @param[in] f fitness vector of x.
+ * @param[in] c constraint vector of x.
+ */
+void population::set_x(const size_type &idx, const decision_vector &x, const fitness_vector &f, const constraint_vector &c)
+{
+	if (idx >= size()) {
+		pagmo_throw(index_error,"invalid individual position");
+	}
+	if (!m_prob->verify_x(x)) {
+		pagmo_throw(value_error,"decision vector is not compatible with problem");
+	}
+	if (f.size() != m_prob->get_f_dimension() || c.size() != m_prob->get_c_dimension()) {
+		pagmo_throw(value_error,"fitness and/or constraint vectors are not compatible with problem");
+	}
+	m_container[idx].cur_x = x;
+	m_container[idx].cur_f = f;
+	m_container[idx].cur_c = c;
+	update_bests(idx);
+}
+
+/// Set the decision vectors of all individuals.
+/**
+ * Equivalent to calling set_x() on each individual, xs[i] being the decision vector of the individual at position i, but
+ * the fitness vectors are computed with a single call to problem::base::objfun_batch().
+ *
+ * @param[in] xs decision vectors, one per individual.
+ *
+ * @throws value_error if the size of xs differs from the size of the population or if problem::base::verify_x() fails on
+ * any of the decision vectors.
+ */
+void population::set_xs(const std::vector<decision_vector> &xs)
+{
+	if (xs.size() != size()) {
+		pagmo_throw(value_error,"the number of decision vectors must be equal to the size of the population");
+	}
+	for (size_type i = 0; i < xs.size(); ++i) {
+		if (!m_prob->verify_x(xs[i])) {
+			pagmo_throw(value_error,"decision vector is not compatible with problem");
+		}
+	}
+	std::vector<fitness_vector> fs;
+	m_prob->objfun_batch(fs,xs);
+	set_xs(xs,fs);
+}
+
+/// Set the decision vectors of all individuals, with known fitness vectors.
+/**
+ * Same as set_xs(const std::vector<decision_vector> &), but the fitness vectors are not computed: fs[i] must be the fitness
+ * vector of xs[i], e.g., computed by an algorithm evaluating its whole population at once. The constraint vectors are computed.
+ * Bests and champion are updated as by set_x(), while the domination lists are rebuilt only once, after all the individuals
+ * have been set.
+ *
+ * @param[in] xs decision vectors, one per individual.
+ * @param[in] fs fitness vectors of the decision vectors.
+ *
+ * @throws value_error if the sizes of xs or fs differ from the size of the population, or if problem::base::verify_x() fails on
+ * any of the decision vectors or any of the fitness vectors is not compatible with the problem.
+ */
+void population::set_xs(const std::vector<decision_vector> &xs, const std::vector<fitness_vector> &fs)
+{
+	if (xs.size() != size() || fs.size() != size()) {
+		pagmo_throw(value_error,"the number of decision and fitness vectors must be equal to the size of the population");
+	}
+	for (size_type i = 0; i < xs.size(); ++i) {
+		if (!m_prob->verify_x(xs[i])) {
+			pagmo_throw(value_error,"decision vector is not compatible with problem");
+		}
+		if (fs[i].size() != m_prob->get_f_dimension()) {
+			pagmo_throw(value_error,"fitness vector is not compatible with problem");
+		}
+	}
+	for (size_type i = 0; i < xs.size(); ++i) {
+		m_container[i].cur_x = xs[i];
+		m_container[i].cur_f = fs[i];
+		m_prob->compute_constraints(m_container[i].cur_c,xs[i]);
+		if (m_prob->compare_fc(m_container[i].cur_f,m_container[i].cur_c,m_container[i].best_f,m_container[i].best_c)) {
+			m_container[i].best_x = m_container[i].cur_x;
+			m_container[i].best_f = m_container[i].cur_f;
+			m_container[i].best_c = m_container[i].cur_c;
+		}
+		update_champion(i);
+	}
+	rebuild_dom();
+}
+
+// Update the best decision, fitness and constraint vectors of individual idx after a change of its current ones, together with the champion
+// and the domination lists.
+void population::update_bests(const size_type &idx)
+{
 	// If needed, update the best decision, fitness and constraint vectors for the individual.
 	// NOTE: we update the bests in two cases:
 	// - the bests are empty, meaning they are not defined and we are being called by push_back()
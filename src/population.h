@@ -49,6 +49,10 @@ class base;
 typedef boost::shared_ptr<base> base_ptr;
 }
 
+namespace util { namespace discrepancy {
+class base;
+}}
+
 /// Population class.
 /**
  * This class contains an instance of an optimisation problem and a group of candidate solutions represented by the class individual_type.
@@ -194,6 +198,7 @@ class __PAGMO_VISIBLE population
 		/// Const iterator.
 		typedef container_type::const_iterator const_iterator;
 		explicit population(const problem::base &, int = 0, const boost::uint32_t &seed = getSeed());
+		population(const problem::base &, int, util::discrepancy::base &, const boost::uint32_t &seed = getSeed());
         static boost::uint32_t getSeed(){
 			return rng_generator::get<rng_uint32>()();
 		}
@@ -220,6 +225,9 @@ class __PAGMO_VISIBLE population
 		std::vector<size_type> get_best_idx(const size_type & N) const;
 		size_type get_worst_idx() const;
 		void set_x(const size_type &, const decision_vector &);
+		void set_x(const size_type &, const decision_vector &, const fitness_vector &, const constraint_vector &);
+		void set_xs(const std::vector<decision_vector> &);
+		void set_xs(const std::vector<decision_vector> &, const std::vector<fitness_vector> &);
 		void set_v(const size_type &, const decision_vector &);
 		void push_back(const decision_vector &);
 		void erase(const size_type &);
@@ -261,12 +269,11 @@ class __PAGMO_VISIBLE population
 	private:
 		void init_velocity(const size_type &);
 		void update_champion(const size_type &);
-
-		// Multi-objective stuff
-		void update_crowding_d(std::vector<size_type>) const;
+		void update_bests(const size_type &);
 
 	protected:
 		void update_dom(const size_type &);
+		void rebuild_dom();
 
 	private:
 		// Data members + their serialization
@@ -23,10 +23,12 @@
  *****************************************************************************/
 
 #include <boost/math/constants/constants.hpp>
+#include <boost/numeric/conversion/cast.hpp>
 #include <cmath>
 #include <string>
 
 
+#include "../Eigen/Core"
 #include "../exceptions.h"
 #include "../types.h"
 #include "base.h"
@@ -73,13 +75,12 @@ void ackley::objfun_impl(fitness_vector &f, const decision_vector &x) const
 	f[0]=0;
 
 	double omega = 2.0 * M_PI;
-	double s1=0.0, s2=0.0;
 	double nepero=exp(1.0);
 
-	for (std::vector<double>::size_type i=0; i<n; i++){
-		s1 += x[i]*x[i];
-		s2 += cos(omega*x[i]);
-	}
+	// Vectorised sums over the components of x.
+	const Eigen::Map<const Eigen::ArrayXd> xa(&x[0],boost::numeric_cast<Eigen::ArrayXd::Index>(n));
+	const double s1 = xa.square().sum();
+	const double s2 = (omega*xa).cos().sum();
 	f[0] = -20*exp(-0.2 * sqrt(1.0/n * s1))-exp(1.0/n*s2)+ 20 + nepero;
 }
 
@@ -65,14 +65,11 @@ namespace problem {
 base::base(int n, int ni, int nf, int nc, int nic, const double &c_tol): //TODO should we use size_type directly?
 	m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 	m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
-	m_c_tol(nc,c_tol),
+	m_definition(new definition(std::vector<double>(nc,c_tol))),
 	m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
 	m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
 	m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
 	m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
-	m_best_x(0),
-	m_best_f(0),
-	m_best_c(0),
 	m_fevals(0),
 	m_cevals(0)
 {
@@ -83,10 +80,9 @@ base::base(int n, int ni, int nf, int nc, int nic, const double &c_tol): //TODO
 		pagmo_throw(value_error,"invalid dimension(s)");
 	}
 	const size_type size = boost::numeric_cast<size_type>(n);
-	m_lb.resize(size);
-	m_ub.resize(size);
-	std::fill(m_lb.begin(),m_lb.end(),0);
-	std::fill(m_ub.begin(),m_ub.end(),1);
+	definition &def = mutable_definition();
+	def.m_lb.resize(size,0);
+	def.m_ub.resize(size,1);
 	// Resize properly temporary fitness and constraint storage.
 	m_tmp_f1.resize(m_f_dimension);
 	m_tmp_f2.resize(m_f_dimension);
@@ -111,14 +107,11 @@ base::base(int n, int ni, int nf, int nc, int nic, const double &c_tol): //TODO
 base::base(int n, int ni, int nf, int nc, int nic, const std::vector<double> &c_tol): //TODO should we use size_type directly?
 	m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 	m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
-	m_c_tol(c_tol),
+	m_definition(new definition(c_tol)),
 	m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
 	m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
 	m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
 	m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
-	m_best_x(0),
-	m_best_f(0),
-	m_best_c(0),
 	m_fevals(0),
 	m_cevals(0)
 {
@@ -134,10 +127,9 @@ base::base(int n, int ni, int nf, int nc, int nic, const std::vector<double> &c_
 		pagmo_throw(value_error,"invalid dimension(s)");
 	}
 	const size_type size = boost::numeric_cast<size_type>(n);
-	m_lb.resize(size);
-	m_ub.resize(size);
-	std::fill(m_lb.begin(),m_lb.end(),0);
-	std::fill(m_ub.begin(),m_ub.end(),1);
+	definition &def = mutable_definition();
+	def.m_lb.resize(size,0);
+	def.m_ub.resize(size,1);
 	// Resize properly temporary fitness and constraint storage.
 	m_tmp_f1.resize(m_f_dimension);
 	m_tmp_f2.resize(m_f_dimension);
@@ -164,14 +156,11 @@ base::base(int n, int ni, int nf, int nc, int nic, const std::vector<double> &c_
 base::base(const double &l_value, const double &u_value, int n, int ni, int nf, int nc, int nic, const double &c_tol):
 	m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 	m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
-	m_c_tol(nc,c_tol),
+	m_definition(new definition(std::vector<double>(nc,c_tol))),
 	m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
 	m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
 	m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
 	m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
-	m_best_x(0),
-	m_best_f(0),
-	m_best_c(0),
 	m_fevals(0),
 	m_cevals(0)
 {
@@ -185,10 +174,9 @@ base::base(const double &l_value, const double &u_value, int n, int ni, int nf,
 		pagmo_throw(value_error,"value for lower bounds cannot be greater than value for upper bounds");
 	}
 	const size_type size = boost::numeric_cast<size_type>(n);
-	m_lb.resize(size);
-	m_ub.resize(size);
-	std::fill(m_lb.begin(),m_lb.end(),l_value);
-	std::fill(m_ub.begin(),m_ub.end(),u_value);
+	definition &def = mutable_definition();
+	def.m_lb.resize(size,l_value);
+	def.m_ub.resize(size,u_value);
 	// Resize properly temporary fitness and constraint storage.
 	m_tmp_f1.resize(m_f_dimension);
 	m_tmp_f2.resize(m_f_dimension);
@@ -215,14 +203,11 @@ base::base(const double &l_value, const double &u_value, int n, int ni, int nf,
 base::base(const decision_vector &lb, const decision_vector &ub, int ni, int nf, int nc, int nic, const double &c_tol):
 	m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 	m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
-	m_c_tol(nc,c_tol),
+	m_definition(new definition(std::vector<double>(nc,c_tol))),
 	m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
 	m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
 	m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
 	m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
-	m_best_x(0),
-	m_best_f(0),
-	m_best_c(0),
 	m_fevals(0),
 	m_cevals(0)
 {
@@ -261,20 +246,24 @@ std::string base::get_name() const
 
 /// Lower bounds getter.
 /**
+ * The reference is invalidated by the setters of the bounds.
+ *
  * @return const reference to the lower bounds vector.
  */
 const decision_vector &base::get_lb() const
 {
-	return m_lb;
+	return m_definition->m_lb;
 }
 
 /// Upper bounds getter.
 /**
+ * The reference is invalidated by the setters of the bounds.
+ *
  * @return const reference to the upper bounds vector.
  */
 const decision_vector &base::get_ub() const
 {
-	return m_ub;
+	return m_definition->m_ub;
 }
 
 /// Bounds setter from pagmo::decision_vector.
@@ -287,12 +276,13 @@ const decision_vector &base::get_ub() const
  */
 void base::set_bounds(const decision_vector &lb, const decision_vector &ub)
 {
-	if (lb.size() != ub.size() || lb.size() != m_lb.size()) {
+	if (lb.size() != ub.size() || lb.size() != m_definition->m_lb.size()) {
 		pagmo_throw(value_error,"invalid or inconsistent bounds dimensions in set_bounds()");
 	}
 	verify_bounds(lb.begin(),lb.end(),ub.begin(),ub.end());
-	m_lb = lb;
-	m_ub = ub;
+	definition &def = mutable_definition();
+	def.m_lb = lb;
+	def.m_ub = ub;
 	// Normalise bounds.
 	normalise_bounds();
 }
@@ -309,8 +299,9 @@ void base::set_bounds(const double &l_value, const double &u_value)
 	if (l_value > u_value) {
 		pagmo_throw(value_error,"lower bound cannot be greater than upper bound in set_bounds()");
 	}
-	std::fill(m_lb.begin(),m_lb.end(),l_value);
-	std::fill(m_ub.begin(),m_ub.end(),u_value);
+	definition &def = mutable_definition();
+	std::fill(def.m_lb.begin(),def.m_lb.end(),l_value);
+	std::fill(def.m_ub.begin(),def.m_ub.end(),u_value);
 	normalise_bounds();
 }
 
@@ -327,8 +318,9 @@ void base::set_bounds(int n, const double &l_value, const double &u_value)
 	if (l_value > u_value) {
 		pagmo_throw(value_error,"lower bound cannot be greater than upper bound in set_bounds()");
 	}
-	m_lb[n] = l_value;
-	m_ub[n] = u_value;
+	definition &def = mutable_definition();
+	def.m_lb[n] = l_value;
+	def.m_ub[n] = u_value;
 	// Normalise bounds.
 	normalise_bounds();
 }
@@ -341,11 +333,11 @@ void base::set_bounds(int n, const double &l_value, const double &u_value)
  */
 void base::set_lb(const decision_vector &lb)
 {
-	if (lb.size() != m_lb.size()) {
+	if (lb.size() != m_definition->m_lb.size()) {
 		pagmo_throw(value_error,"invalid bounds dimension in set_lb()");
 	}
-	verify_bounds(lb.begin(),lb.end(),m_ub.begin(),m_ub.end());
-	m_lb = lb;
+	verify_bounds(lb.begin(),lb.end(),m_definition->m_ub.begin(),m_definition->m_ub.end());
+	mutable_definition().m_lb = lb;
 	// Normalise bounds.
 	normalise_bounds();
 }
@@ -360,10 +352,10 @@ void base::set_lb(const decision_vector &lb)
 void base::set_lb(int n, const double &value)
 {
 	const size_type i = boost::numeric_cast<size_type>(n);
-	if (i >= m_lb.size() || m_ub[i] < value) {
+	if (i >= m_definition->m_lb.size() || m_definition->m_ub[i] < value) {
 		pagmo_throw(value_error,"invalid index and/or value for lower bound");
 	}
-	m_lb[i] = value;
+	mutable_definition().m_lb[i] = value;
 	// Normalise bounds.
 	normalise_bounds();
 }
@@ -376,12 +368,13 @@ void base::set_lb(int n, const double &value)
  */
 void base::set_lb(const double &value)
 {
-	for (size_type i = 0; i < m_lb.size(); ++i) {
-		if (m_ub[i] < value) {
+	for (size_type i = 0; i < m_definition->m_lb.size(); ++i) {
+		if (m_definition->m_ub[i] < value) {
 			pagmo_throw(value_error,"invalid value for lower bound");
 		}
 	}
-	std::fill(m_lb.begin(),m_lb.end(),value);
+	definition &def = mutable_definition();
+	std::fill(def.m_lb.begin(),def.m_lb.end(),value);
 	// Normalise bounds.
 	normalise_bounds();
 }
@@ -394,11 +387,11 @@ void base::set_lb(const double &value)
  */
 void base::set_ub(const decision_vector &ub)
 {
-	if (ub.size() != m_lb.size()) {
+	if (ub.size() != m_definition->m_lb.size()) {
 		pagmo_throw(value_error,"invalid bounds dimension in set_ub()");
 	}
-	verify_bounds(m_lb.begin(),m_lb.end(),ub.begin(),ub.end());
-	m_ub = ub;
+	verify_bounds(m_definition->m_lb.begin(),m_definition->m_lb.end(),ub.begin(),ub.end());
+	mutable_definition().m_ub = ub;
 	// Normalise bounds.
 	normalise_bounds();
 }
@@ -413,10 +406,10 @@ void base::set_ub(const decision_vector &ub)
 void base::set_ub(int n, const double &value)
 {
 	const size_type i = boost::numeric_cast<size_type>(n);
-	if (i >= m_lb.size() || m_lb[i] > value) {
+	if (i >= m_definition->m_lb.size() || m_definition->m_lb[i] > value) {
 		pagmo_throw(value_error,"invalid index and/or value for upper bound");
 	}
-	m_ub[i] = value;
+	mutable_definition().m_ub[i] = value;
 	// Normalise bounds.
 	normalise_bounds();
 }
@@ -429,12 +422,13 @@ void base::set_ub(int n, const double &value)
  */
 void base::set_ub(const double &value)
 {
-	for (size_type i = 0; i < m_lb.size(); ++i) {
-		if (m_lb[i] > value) {
+	for (size_type i = 0; i < m_definition->m_lb.size(); ++i) {
+		if (m_definition->m_lb[i] > value) {
 			pagmo_throw(value_error,"invalid value for upper bound");
 		}
 	}
-	std::fill(m_ub.begin(),m_ub.end(),value);
+	definition &def = mutable_definition();
+	std::fill(def.m_ub.begin(),def.m_ub.end(),value);
 	// Normalise bounds.
 	normalise_bounds();
 }
@@ -464,7 +458,7 @@ unsigned int base::get_cevals() const
  */
 base::size_type base::get_dimension() const
 {
-	return m_lb.size();
+	return m_definition->m_lb.size();
 }
 
 /// Return integer dimension.
@@ -509,7 +503,7 @@ base::c_size_type base::get_ic_dimension() const
  */
 const std::vector<double>& base::get_c_tol() const
 {
-	return m_c_tol;
+	return m_definition->m_c_tol;
 }
 
 /// Get the diameter of the problem.
@@ -520,9 +514,10 @@ const std::vector<double>& base::get_c_tol() const
  */
 double base::get_diameter() const
 {
+	const decision_vector &lb = m_definition->m_lb, &ub = m_definition->m_ub;
 	double retval = 0;
 	for (size_type i = 0; i < get_dimension(); ++i) {
-		retval += (m_ub[i] - m_lb[i]) * (m_ub[i] - m_lb[i]);
+		retval += (ub[i] - lb[i]) * (ub[i] - lb[i]);
 	}
 	return std::sqrt(retval);
 }
@@ -607,6 +602,110 @@ void base::objfun(fitness_vector &f, const decision_vector &x) const
 	}
 }
 
+/// Write the fitnesses of a block of pagmo::decision_vector into a block of pagmo::fitness_vector.
+/**
+ * Will call objfun_batch_impl() internally, after having checked the dimensions of all the decision vectors. The output
+ * block is resized to the number of decision vectors, and each fitness vector to the fitness dimension of the problem.
+ *
+ * Contrary to objfun(), the caching mechanism is bypassed: the whole block is handed to the implementation in one call,
+ * so that problems can evaluate it with vectorised kernels. The function evaluation counter is increased by the size
+ * of the block.
+ *
+ * @param[out] f block of fitness vectors to which the fitnesses will be written.
+ * @param[in] x block of decision vectors whose fitnesses will be calculated.
+ *
+ * @throws value_error if the dimension of any decision vector is different from the dimension of the problem.
+ */
+void base::objfun_batch(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		if (x[i].size() != get_dimension()) {
+			pagmo_throw(value_error,"wrong decision vector size when calling batch objective function");
+		}
+	}
+	f.resize(x.size());
+	for (std::vector<fitness_vector>::size_type i = 0; i < f.size(); ++i) {
+		f[i].resize(m_f_dimension);
+	}
+	if (x.empty()) {
+		return;
+	}
+	objfun_batch_impl(f,x);
+	m_fevals += boost::numeric_cast<unsigned int>(x.size());
+	for (std::vector<fitness_vector>::size_type i = 0; i < f.size(); ++i) {
+		if (f[i].size() != m_f_dimension) {
+			pagmo_throw(value_error,"fitness dimension was changed inside objfun_batch_impl()");
+		}
+	}
+}
+
+/// Batch objective function implementation.
+/**
+ * Default implementation will call objfun_impl() on each decision vector of the block. Problems whose objective function
+ * can be computed more efficiently on many decision vectors at once (e.g., through matrix-matrix products) can
+ * re-implement this method. On entry, f has the same size as x and each of its elements has the fitness dimension of the problem.
+ *
+ * @param[out] f block of fitness vectors into which the fitnesses will be written.
+ * @param[in] x block of decision vectors whose fitnesses will be calculated.
+ */
+void base::objfun_batch_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		objfun_impl(f[i],x[i]);
+	}
+}
+
+/// Gradient of the objective function.
+/**
+ * Will call objfun_gradient_impl() internally, after having checked the dimension of x. g is resized to the
+ * dimension of the problem.
+ *
+ * @param[out] g gradient of the objective function at x.
+ * @param[in] x decision vector.
+ *
+ * @throws value_error if the problem is not single-objective or if the dimension of x is different from the dimension of the problem.
+ */
+void base::objfun_gradient(decision_vector &g, const decision_vector &x) const
+{
+	if (m_f_dimension != 1) {
+		pagmo_throw(value_error,"the gradient of the objective function is defined only for single-objective problems");
+	}
+	if (x.size() != get_dimension()) {
+		pagmo_throw(value_error,"wrong decision vector size when calling the gradient of the objective function");
+	}
+	g.resize(get_dimension());
+	objfun_gradient_impl(g,x);
+	if (g.size() != get_dimension()) {
+		pagmo_throw(value_error,"gradient dimension was changed inside objfun_gradient_impl()");
+	}
+}
+
+/// Implementation of the gradient of the objective function.
+/**
+ * Default implementation computes the gradient by central differences, with relative step 1E-8, through objfun().
+ * Points outside the bounds may be evaluated. Problems whose gradient can be computed analytically can re-implement
+ * this method. On entry, g has the dimension of the problem.
+ *
+ * @param[out] g gradient of the objective function at x.
+ * @param[in] x decision vector.
+ */
+void base::objfun_gradient_impl(decision_vector &g, const decision_vector &x) const
+{
+	const double h0 = 1e-8;
+	decision_vector dx(x);
+	fitness_vector f(1);
+	for (size_type i = 0; i < dx.size(); ++i) {
+		const double h = h0 * std::max(1.,std::fabs(x[i]));
+		dx[i] = x[i] + h;
+		objfun(f,dx);
+		const double f_plus = f[0];
+		dx[i] = x[i] - h;
+		objfun(f,dx);
+		g[i] = (f_plus - f[0]) / 2 / h;
+		dx[i] = x[i];
+	}
+}
+
 /// Compare fitness vectors.
 /**
  * Will perform sanity checks on v_f1 and v_f2 and then will call base::compare_fitness_impl().
@@ -673,11 +772,11 @@ std::string base::human_readable() const
 	s << "\tConstraints dimension:\t\t\t" << m_c_dimension << '\n';
 	s << "\tInequality constraints dimension:\t" << m_ic_dimension << '\n';
 	s << "\tLower bounds: ";
-	s << m_lb << '\n';
+	s << m_definition->m_lb << '\n';
 	s << "\tUpper bounds: ";
-	s << m_ub << '\n';
+	s << m_definition->m_ub << '\n';
 	s << "\tConstraints tolerance: ";
-	s << m_c_tol << '\n';
+	s << m_definition->m_c_tol << '\n';
 	s << human_readable_extra();
 	return s.str();
 }
@@ -965,9 +1064,9 @@ bool base::test_constraint(const constraint_vector &c, const c_size_type &i) con
 	pagmo_assert(i < m_c_dimension);
 	if (i < m_c_dimension - m_ic_dimension) {
 		// Equality constraint testing.
-		return (std::abs(c[i]) <= m_c_tol[i]);
+		return (std::abs(c[i]) <= m_definition->m_c_tol[i]);
 	} else {
-		return c[i] <= m_c_tol[i];
+		return c[i] <= m_definition->m_c_tol[i];
 	}
 }
 
@@ -1112,7 +1211,7 @@ bool base::verify_x(const decision_vector &x) const
 		return false;
 	}
 	for (size_type i = 0; i < get_dimension(); ++i) {
-		if (x[i] < m_lb[i] || x[i] > m_ub[i]) {
+		if (x[i] < m_definition->m_lb[i] || x[i] > m_definition->m_ub[i]) {
 			return false;
 		}
 		// Check that, if this is an integer component, it is really an integer.
@@ -1123,55 +1222,84 @@ bool base::verify_x(const decision_vector &x) const
 	return true;
 }
 
-// This function will round to the nearest integer the upper/lower bounds of the integer part of the problem.
-// This should be called each time bounds are set.
-void base::normalise_bounds()
+// Return a modifiable reference to the problem definition, making a private copy of it first if it is shared
+// with other problems. Sharing can only happen through copies of this problem, so if this is the only owner
+// no other thread can start sharing the definition while it is being modified.
+base::definition &base::mutable_definition()
+{
+	if (!m_definition.unique()) {
+		m_definition.reset(new definition(*m_definition));
+	}
+	// NOTE: definitions are always created non-const, so casting away constness is safe.
+	return const_cast<definition &>(*m_definition);
+}
+
+// Normalise the bounds of a single variable, returning true if they had to be fixed.
+static bool normalise_bound_pair(double &lb, double &ub, bool integer)
 {
-	pagmo_assert(m_lb.size() >= m_i_dimension);
-	// Flag to be set if we had to fix the bounds.
 	bool bounds_fixed = false;
-	for (size_type i = 0; i < m_lb.size() - m_i_dimension; ++i) {
+	if (!integer) {
 		// Handle NaNs: if either lower/upper bound(s) are NaN, replace with 0 and 1 respectively.
-		if (boost::math::isnan(m_lb[i]) || boost::math::isnan(m_ub[i])) {
-			m_lb[i] = 0;
-			m_ub[i] = 1;
+		if (boost::math::isnan(lb) || boost::math::isnan(ub)) {
+			lb = 0;
+			ub = 1;
 			bounds_fixed = true;
 		}
 		// +-Infs are replaced by the highest/lowest values representable by double.
-		if (boost::math::isinf(m_lb[i])) {
-			m_lb[i] = (m_lb[i] > 0) ? boost::numeric::bounds<double>::highest() : boost::numeric::bounds<double>::lowest();
+		if (boost::math::isinf(lb)) {
+			lb = (lb > 0) ? boost::numeric::bounds<double>::highest() : boost::numeric::bounds<double>::lowest();
 			bounds_fixed = true;
 		}
-		if (boost::math::isinf(m_ub[i])) {
-			m_ub[i] = (m_ub[i] > 0) ? boost::numeric::bounds<double>::highest() : boost::numeric::bounds<double>::lowest();
+		if (boost::math::isinf(ub)) {
+			ub = (ub > 0) ? boost::numeric::bounds<double>::highest() : boost::numeric::bounds<double>::lowest();
 			bounds_fixed = true;
 		}
+		return bounds_fixed;
 	}
-	for (size_type i = m_lb.size() - m_i_dimension; i < m_lb.size(); ++i) {
-		// First let's make sure that integer bounds are in the allowed range.
-		if (m_lb[i] < INT_MIN) {
-			m_lb[i] = INT_MIN;
-			bounds_fixed = true;
-		}
-		if (m_lb[i] > INT_MAX) {
-			m_lb[i] = INT_MAX;
-			bounds_fixed = true;
-		}
-		if (m_ub[i] < INT_MIN) {
-			m_ub[i] = INT_MIN;
-			bounds_fixed = true;
-		}
-		if (m_ub[i] > INT_MAX) {
-			m_ub[i] = INT_MAX;
-			bounds_fixed = true;
-		}
-		// Then convert them to the nearest integer if necessary.
-		if (m_lb[i] != double_to_int::convert(m_lb[i])) {
-			m_lb[i] = double_to_int::convert(m_lb[i]);
-			bounds_fixed = true;
-		}
-		if (m_ub[i] != double_to_int::convert(m_ub[i])) {
-			m_ub[i] = double_to_int::convert(m_ub[i]);
+	// First let's make sure that integer bounds are in the allowed range.
+	if (lb < INT_MIN) {
+		lb = INT_MIN;
+		bounds_fixed = true;
+	}
+	if (lb > INT_MAX) {
+		lb = INT_MAX;
+		bounds_fixed = true;
+	}
+	if (ub < INT_MIN) {
+		ub = INT_MIN;
+		bounds_fixed = true;
+	}
+	if (ub > INT_MAX) {
+		ub = INT_MAX;
+		bounds_fixed = true;
+	}
+	// Then convert them to the nearest integer if necessary.
+	if (lb != double_to_int::convert(lb)) {
+		lb = double_to_int::convert(lb);
+		bounds_fixed = true;
+	}
+	if (ub != double_to_int::convert(ub)) {
+		ub = double_to_int::convert(ub);
+		bounds_fixed = true;
+	}
+	return bounds_fixed;
+}
+
+// This function will round to the nearest integer the upper/lower bounds of the integer part of the problem.
+// This should be called each time bounds are set. The definition is read through the shared pointer, and a
+// private copy of it is made only if some bound actually needs to be fixed.
+void base::normalise_bounds()
+{
+	const size_type size = m_definition->m_lb.size();
+	pagmo_assert(size >= m_i_dimension);
+	// Flag to be set if we had to fix the bounds.
+	bool bounds_fixed = false;
+	for (size_type i = 0; i < size; ++i) {
+		double lb = m_definition->m_lb[i], ub = m_definition->m_ub[i];
+		if (normalise_bound_pair(lb,ub,i >= size - m_i_dimension)) {
+			definition &def = mutable_definition();
+			def.m_lb[i] = lb;
+			def.m_ub[i] = ub;
 			bounds_fixed = true;
 		}
 	}
@@ -1239,7 +1367,7 @@ void base::estimate_sparsity(const decision_vector &x0, int& lenG, std::vector<i
 	if (!verify_x(x0)) {
 		pagmo_throw(value_error,"cannot estimate pattern from this decision vector: not compatible with problem");
 	}
-	size_type Dc = m_lb.size() - m_i_dimension;
+	size_type Dc = m_definition->m_lb.size() - m_i_dimension;
 	fitness_vector f0(m_f_dimension),f_new(m_f_dimension);
 	objfun(f0,x0);
 	constraint_vector c0(m_c_dimension),c_new(m_c_dimension);
@@ -1253,7 +1381,7 @@ void base::estimate_sparsity(const decision_vector &x0, int& lenG, std::vector<i
 		//to be 'just' a parameter ... in some problem implementations this is rather
 		//useful, but it also requires that the algorithm treat those variables accordingly (i.e.
 		//it does not allow them to be outside the box bounds)
-		if (m_ub[j] == m_lb[j]) continue;
+		if (m_definition->m_ub[j] == m_definition->m_lb[j]) continue;
 		x_new[j] = x0[j] +  std::max(std::fabs(x0[j]), 1.0) * 1e-8;
 		objfun(f_new,x_new);
 		compute_constraints(c_new,x_new);
@@ -1282,14 +1410,14 @@ void base::estimate_sparsity(const decision_vector &x0, int& lenG, std::vector<i
  */
 void base::estimate_sparsity(int& lenG, std::vector<int>& iGfun, std::vector<int>& jGvar) const {
 
-	size_type Dc = m_lb.size() - m_i_dimension;
+	size_type Dc = m_definition->m_lb.size() - m_i_dimension;
 	fitness_vector f0(m_f_dimension),f_new(m_f_dimension);
 	decision_vector x0(Dc);
 	// Double precision random number generator.
 	rng_double drng(rng_generator::get<rng_double>());
 
 	for (decision_vector::size_type i = 0; i<Dc;++i) {
-		x0[i] = boost::uniform_real<double>(m_lb[i],m_ub[i])(drng);
+		x0[i] = boost::uniform_real<double>(m_definition->m_lb[i],m_definition->m_ub[i])(drng);
 	}
 
 	objfun(f0,x0);
@@ -1304,8 +1432,8 @@ void base::estimate_sparsity(int& lenG, std::vector<int>& iGfun, std::vector<int
 		//to be 'just' a parameter ... in some problem implementations this is rather
 		//useful, but it also requires that the algorithm treat those variables accordingly (i.e.
 		//it does not allow them to go outside the box bounds)
-		if (m_ub[j] == m_lb[j]) continue;
-		x_new[j] = boost::uniform_real<double>(m_lb[j],m_ub[j])(drng);
+		if (m_definition->m_ub[j] == m_definition->m_lb[j]) continue;
+		x_new[j] = boost::uniform_real<double>(m_definition->m_lb[j],m_definition->m_ub[j])(drng);
 		objfun(f_new,x_new);
 		compute_constraints(c_new,x_new);
 		for (fitness_vector::size_type i=0;i<m_f_dimension;++i)
@@ -1330,20 +1458,21 @@ void base::set_best_x(const std::vector<decision_vector>& best_x)
 {
 	if(best_x.size() != 0){
 		size_type n_opts = best_x.size();
-		m_best_x.resize(n_opts);
-		m_best_f.resize(n_opts);
-		m_best_c.resize(n_opts);
+		definition &def = mutable_definition();
+		def.m_best_x.resize(n_opts);
+		def.m_best_f.resize(n_opts);
+		def.m_best_c.resize(n_opts);
 		for (size_type i=0; i<n_opts; i++){
 			if(best_x.at(i).size() != get_dimension())
 				pagmo_throw(value_error,"invalid size(s) for best known decision vector(s)");
 			else{
 				//save in the class data member the value of the decision variable of solution i
-				m_best_x.at(i) = best_x.at(i);
+				def.m_best_x.at(i) = best_x.at(i);
 				//save in the class data member the corresponding value of objective(s)
-				m_best_f.at(i) = objfun(best_x.at(i));
+				def.m_best_f.at(i) = objfun(best_x.at(i));
 				//save in the class data member the corresponding value of constraint(s)
 				if(m_c_dimension>0)
-					m_best_c.at(i) = compute_constraints(best_x.at(i));
+					def.m_best_c.at(i) = compute_constraints(best_x.at(i));
 			}
 		}
 	}
@@ -1356,7 +1485,7 @@ void base::set_best_x(const std::vector<decision_vector>& best_x)
  */
 const std::vector<constraint_vector>& base::get_best_c(void) const
 {
-	return m_best_c;
+	return m_definition->m_best_c;
 }
 
 /// Get the best known decision vector.
@@ -1366,7 +1495,7 @@ const std::vector<constraint_vector>& base::get_best_c(void) const
  */
 const std::vector<decision_vector>& base::get_best_x(void) const
 {
-	return m_best_x;
+	return m_definition->m_best_x;
 }
 
 /// Get the best known fitness vector.
@@ -1376,7 +1505,7 @@ const std::vector<decision_vector>& base::get_best_x(void) const
  */
 const std::vector<fitness_vector>& base::get_best_f(void) const
 {
-	return m_best_f;
+	return m_definition->m_best_f;
 }
 
 /// Pre-evolution hook.
@@ -51,6 +51,8 @@ namespace pagmo
 // Fwd declarations.
 class population;
 class island;
+namespace util { class async_evaluator; }
+namespace algorithm { class sa_corana; }
 
 /// Problem namespace.
 /**
@@ -108,7 +110,8 @@ typedef boost::shared_ptr<base> base_ptr;
  *   than the second one, false otherwise),
  * - compute_constraints_impl(), to calculate the constraint vector associated to a decision vector,
  * - compare_constraints_impl(), to compare two constraint vectors,
- * - compare_fc_impl(), to perform a simultaneous fitness/constraint vector pairs comparison.
+ * - compare_fc_impl(), to perform a simultaneous fitness/constraint vector pairs comparison,
+ * - objfun_gradient_impl(), to provide the exact gradient of a single-objective problem.
  *
  * Please note that while a problem is intended to provide methods for ranking decision and constraint vectors, such methods are not to be used
  * mandatorily by an algorithm: each algorithm can decide to use its own ranking schemes during an optimisation. The ranking methods provided
@@ -117,6 +120,11 @@ typedef boost::shared_ptr<base> base_ptr;
  * \section Caching
  * A caching mechanism is implemented to make sure the objective function is never evaluated twice on the very same chromosome
  *
+ * \section Copies
+ * Bounds, constraints tolerances and best known vectors are shared among the copies of a problem (such as the clones held by
+ * populations, islands and meta-problems) and duplicated only when one of the copies modifies them. Caches, temporary
+ * storage and evaluation counters are instead private to each copy, so that different copies can be evaluated concurrently.
+ *
  * \section Serialization
  * The problem classes are serialized for the purpose of transmitting their corresponding objects over a distributed environment, as being part of the population class.
  * Serializing a derived problem requires that the needed serialization libraries be declared in the header of the derived class.
@@ -149,6 +157,12 @@ class __PAGMO_VISIBLE base
 {
 		// Meta problems need to be able to access protected virtual functions
 		friend class base_meta;
+		// The asynchronous evaluator accounts for the evaluations performed on clones of the problem.
+		friend class util::async_evaluator;
+		// The robust meta-problem accounts for the evaluations performed on its copies of the original problem.
+		friend class robust;
+		// sa_corana accounts for the evaluations performed by its chains on clones of the problem.
+		friend class algorithm::sa_corana;
 		// Underlying containers used for caching decision and fitness vectors.
 		typedef boost::circular_buffer<decision_vector> decision_vector_cache_type;
 		typedef boost::circular_buffer<fitness_vector> fitness_vector_cache_type;
@@ -186,7 +200,7 @@ class __PAGMO_VISIBLE base
 		base(const double (&v1)[N], const double (&v2)[N], int ni = 0, int nf = 1, int nc = 0, int nic = 0, const double &c_tol = 0):
 			m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 			m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
-			m_c_tol(nc,c_tol),
+			m_definition(new definition(std::vector<double>(nc,c_tol))),
 			m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
 			m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
 			m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
@@ -202,7 +216,7 @@ class __PAGMO_VISIBLE base
 				pagmo_throw(value_error,"inequality constraints dimension must not be greater than global constraints dimension");
 			}
 			construct_from_iterators(v1,v1 + N,v2,v2 + N);
-			if (m_i_dimension > m_lb.size()) {
+			if (m_i_dimension > m_definition->m_lb.size()) {
 				pagmo_throw(value_error,"integer dimension must not be greater than global dimension");
 			}
 			// Resize properly temporary fitness and constraint storage.
@@ -235,7 +249,7 @@ class __PAGMO_VISIBLE base
 		base(Iterator1 start1, Iterator1 end1, Iterator2 start2, Iterator2 end2, int ni = 0, int nf = 1, int nc = 0, int nic = 0, const double &c_tol = 0):
 			m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 			m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
-			m_c_tol(nc,c_tol),
+			m_definition(new definition(std::vector<double>(nc,c_tol))),
 			m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
 			m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
 			m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
@@ -251,7 +265,7 @@ class __PAGMO_VISIBLE base
 				pagmo_throw(value_error,"inequality constraints dimension must not be greater than global constraints dimension");
 			}
 			construct_from_iterators(start1,end1,start2,end2);
-			if (m_i_dimension > m_lb.size()) {
+			if (m_i_dimension > m_definition->m_lb.size()) {
 				pagmo_throw(value_error,"integer dimension must not be greater than global dimension");
 			}
 			// Properly resize temporary fitness and constraint storage.
@@ -287,12 +301,13 @@ class __PAGMO_VISIBLE base
 			typedef typename std::iterator_traits<Iterator2>::difference_type d_type2;
 			const d_type1 d1 = std::distance(start1,end1);
 			const d_type2 d2 = std::distance(start2,end2);
-			if (d1 != d2 || d1 != std::distance(m_lb.begin(),m_lb.end())) {
+			if (d1 != d2 || d1 != std::distance(m_definition->m_lb.begin(),m_definition->m_lb.end())) {
 				pagmo_throw(value_error,"invalid or inconsistent bounds dimensions in set_bounds()");
 			}
 			verify_bounds(start1,end1,start2,end2);
-			std::copy(start1,end1,m_lb.begin());
-			std::copy(start2,end2,m_ub.begin());
+			definition &def = mutable_definition();
+			std::copy(start1,end1,def.m_lb.begin());
+			std::copy(start2,end2,def.m_ub.begin());
 			// Normalise bounds.
 			normalise_bounds();
 		}
@@ -307,12 +322,13 @@ class __PAGMO_VISIBLE base
 		template <std::size_t N>
 		void set_bounds(const double (&v1)[N], const double (&v2)[N])
 		{
-			if (m_lb.size() != N) {
+			if (m_definition->m_lb.size() != N) {
 				pagmo_throw(value_error,"invalid bounds dimensions in set_bounds()");
 			}
 			verify_bounds(v1,v1 + N,v2,v2 + N);
-			std::copy(v1,v1 + N,m_lb.begin());
-			std::copy(v2,v2 + N,m_ub.begin());
+			definition &def = mutable_definition();
+			std::copy(v1,v1 + N,def.m_lb.begin());
+			std::copy(v2,v2 + N,def.m_ub.begin());
 			// Normalise bounds.
 			normalise_bounds();
 		}
@@ -332,11 +348,11 @@ class __PAGMO_VISIBLE base
 		template <class Iterator>
 		void set_lb(Iterator start, Iterator end)
 		{
-			if (std::distance(start,end) != std::distance(m_lb.begin(),m_lb.end())) {
+			if (std::distance(start,end) != std::distance(m_definition->m_lb.begin(),m_definition->m_lb.end())) {
 				pagmo_throw(value_error,"invalid bounds dimension in set_lb()");
 			}
-			verify_bounds(start,end,m_ub.begin(),m_ub.end());
-			std::copy(start,end,m_lb.begin());
+			verify_bounds(start,end,m_definition->m_ub.begin(),m_definition->m_ub.end());
+			std::copy(start,end,mutable_definition().m_lb.begin());
 			// Normalise bounds.
 			normalise_bounds();
 		}
@@ -350,11 +366,11 @@ class __PAGMO_VISIBLE base
 		template <std::size_t N>
 		void set_lb(const double (&v)[N])
 		{
-			if (N != m_lb.size()) {
+			if (N != m_definition->m_lb.size()) {
 				pagmo_throw(value_error,"invalid bounds dimension in set_lb()");
 			}
-			verify_bounds(v,v + N,m_ub.begin(),m_ub.end());
-			std::copy(v,v + N,m_lb.begin());
+			verify_bounds(v,v + N,m_definition->m_ub.begin(),m_definition->m_ub.end());
+			std::copy(v,v + N,mutable_definition().m_lb.begin());
 			// Normalise bounds.
 			normalise_bounds();
 		}
@@ -372,11 +388,11 @@ class __PAGMO_VISIBLE base
 		template <class Iterator>
 		void set_ub(Iterator start, Iterator end)
 		{
-			if (std::distance(start,end) != std::distance(m_lb.begin(),m_lb.end())) {
+			if (std::distance(start,end) != std::distance(m_definition->m_lb.begin(),m_definition->m_lb.end())) {
 				pagmo_throw(value_error,"invalid bounds dimension in set_ub()");
 			}
-			verify_bounds(m_lb.begin(),m_lb.end(),start,end);
-			std::copy(start,end,m_ub.begin());
+			verify_bounds(m_definition->m_lb.begin(),m_definition->m_lb.end(),start,end);
+			std::copy(start,end,mutable_definition().m_ub.begin());
 			// Normalise bounds.
 			normalise_bounds();
 		}
@@ -390,11 +406,11 @@ class __PAGMO_VISIBLE base
 		template <std::size_t N>
 		void set_ub(const double (&v)[N])
 		{
-			if (N != m_lb.size()) {
+			if (N != m_definition->m_lb.size()) {
 				pagmo_throw(value_error,"invalid bounds dimension in set_ub()");
 			}
-			verify_bounds(m_lb.begin(),m_lb.end(),v,v + N);
-			std::copy(v,v + N,m_ub.begin());
+			verify_bounds(m_definition->m_lb.begin(),m_definition->m_lb.end(),v,v + N);
+			std::copy(v,v + N,mutable_definition().m_ub.begin());
 			// Normalise bounds.
 			normalise_bounds();
 		}
@@ -454,6 +470,8 @@ return base_ptr(new derived_problem(*this));
 		//@{
 		fitness_vector objfun(const decision_vector &) const;
 		void objfun(fitness_vector &, const decision_vector &) const;
+		void objfun_batch(std::vector<fitness_vector> &, const std::vector<decision_vector> &) const;
+		void objfun_gradient(decision_vector &, const decision_vector &) const;
 		bool compare_fitness(const fitness_vector &, const fitness_vector &) const;
 		void reset_caches() const;
 	public:
@@ -472,19 +490,42 @@ return base_ptr(new derived_problem(*this));
 		 * @param[in] x decision vector whose fitness will be calculated.
 		 */
 		virtual void objfun_impl(fitness_vector &f, const decision_vector &x) const = 0;
+		virtual void objfun_batch_impl(std::vector<fitness_vector> &, const std::vector<decision_vector> &) const;
+		virtual void objfun_gradient_impl(decision_vector &, const decision_vector &) const;
 		//@}
 	private:
+		// Problem definition: the data that does not change during evaluation. It is shared among the copies
+		// of a problem (i.e., among the clones held by populations, islands and meta-problems) and copied
+		// only when one of them modifies it (copy-on-write). Caches, temporary storage and counters are
+		// instead owned by each copy.
+		struct definition
+		{
+			definition() {}
+			explicit definition(const std::vector<double> &c_tol):m_c_tol(c_tol) {}
+			// Lower bounds.
+			decision_vector			m_lb;
+			// Upper bounds.
+			decision_vector			m_ub;
+			// Tolerance for constraints analysis.
+			std::vector<double>		m_c_tol;
+			// Best known vectors.
+			std::vector<decision_vector>	m_best_x;
+			std::vector<fitness_vector>	m_best_f;
+			std::vector<constraint_vector>	m_best_c;
+		};
+		definition &mutable_definition();
 		void normalise_bounds();
 		// Construct from iterators.
 		template <class Iterator1, class Iterator2>
 		void construct_from_iterators(Iterator1 start1, Iterator1 end1, Iterator2 start2, Iterator2 end2)
 		{
-			m_lb.insert(m_lb.end(),start1,end1);
-			m_ub.insert(m_ub.end(),start2,end2);
-			if (m_lb.size() != m_ub.size() || m_lb.size() == 0) {
+			definition &def = mutable_definition();
+			def.m_lb.insert(def.m_lb.end(),start1,end1);
+			def.m_ub.insert(def.m_ub.end(),start2,end2);
+			if (def.m_lb.size() != def.m_ub.size() || def.m_lb.size() == 0) {
 				pagmo_throw(value_error,"null or inconsistent dimension(s) for upper/lower bounds while constructing problem");
 			}
-			verify_bounds(m_lb.begin(),m_lb.end(),m_ub.begin(),m_ub.end());
+			verify_bounds(def.m_lb.begin(),def.m_lb.end(),def.m_ub.begin(),def.m_ub.end());
 		}
 		// Verify upper/lower bounds. This must be called only after having made sure that the iterator distances
 		// are consistent.
@@ -500,29 +541,57 @@ return base_ptr(new derived_problem(*this));
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void save(Archive &ar, const unsigned int) const
+		{
+			ar << m_i_dimension;
+			ar << m_f_dimension;
+			ar << m_c_dimension;
+			ar << m_ic_dimension;
+			ar << m_definition->m_lb;
+			ar << m_definition->m_ub;
+			ar << m_definition->m_c_tol;
+			ar << m_decision_vector_cache_f;
+			ar << m_fitness_vector_cache;
+			ar << m_decision_vector_cache_c;
+			ar << m_constraint_vector_cache;
+			ar << m_tmp_f1;
+			ar << m_tmp_f2;
+			ar << m_tmp_c1;
+			ar << m_tmp_c2;
+			ar << m_definition->m_best_x;
+			ar << m_definition->m_best_f;
+			ar << m_definition->m_best_c;
+			ar << m_fevals;
+			ar << m_cevals;
+		}
+		template <class Archive>
+		void load(Archive &ar, const unsigned int)
 		{
-			ar & const_cast<size_type &>(m_i_dimension);
-			ar & const_cast<f_size_type &>(m_f_dimension);
-			ar & const_cast<c_size_type &>(m_c_dimension);
-			ar & const_cast<c_size_type &>(m_ic_dimension);
-			ar & m_lb;
-			ar & m_ub;
-			ar & const_cast<std::vector<double> &>(m_c_tol);
-			ar & m_decision_vector_cache_f;
-			ar & m_fitness_vector_cache;
-			ar & m_decision_vector_cache_c;
-			ar & m_constraint_vector_cache;
-			ar & m_tmp_f1;
-			ar & m_tmp_f2;
-			ar & m_tmp_c1;
-			ar & m_tmp_c2;
-			ar & m_best_x;
-			ar & m_best_f;
-			ar & m_best_c;
-			ar & m_fevals;
-			ar & m_cevals;
+			// A loaded problem does not share its definition with any other problem.
+			boost::shared_ptr<definition> def(new definition());
+			ar >> const_cast<size_type &>(m_i_dimension);
+			ar >> const_cast<f_size_type &>(m_f_dimension);
+			ar >> const_cast<c_size_type &>(m_c_dimension);
+			ar >> const_cast<c_size_type &>(m_ic_dimension);
+			ar >> def->m_lb;
+			ar >> def->m_ub;
+			ar >> def->m_c_tol;
+			ar >> m_decision_vector_cache_f;
+			ar >> m_fitness_vector_cache;
+			ar >> m_decision_vector_cache_c;
+			ar >> m_constraint_vector_cache;
+			ar >> m_tmp_f1;
+			ar >> m_tmp_f2;
+			ar >> m_tmp_c1;
+			ar >> m_tmp_c2;
+			ar >> def->m_best_x;
+			ar >> def->m_best_f;
+			ar >> def->m_best_c;
+			ar >> m_fevals;
+			ar >> m_cevals;
+			m_definition = def;
 		}
+		BOOST_SERIALIZATION_SPLIT_MEMBER()
 
 		// Data members.
 		// Size of the integer part of the problem.
@@ -533,12 +602,8 @@ return base_ptr(new derived_problem(*this));
 		const c_size_type			m_c_dimension;
 		// Inequality constraints dimension
 		const c_size_type			m_ic_dimension;
-		// Lower bounds.
-		decision_vector				m_lb;
-		// Upper bounds.
-		decision_vector				m_ub;
-		// Tolerance for constraints analysis.
-		const std::vector<double>   m_c_tol;
+		// Shared problem definition.
+		boost::shared_ptr<const definition>	m_definition;
 		// Decision vector cache for fitness.
 		mutable decision_vector_cache_type	m_decision_vector_cache_f;
 		// Fitness vector cache.
@@ -554,11 +619,6 @@ return base_ptr(new derived_problem(*this));
 		mutable constraint_vector		m_tmp_c1;
 		mutable constraint_vector		m_tmp_c2;
 
-		// Best known vectors
-		std::vector<decision_vector> m_best_x;
-		std::vector<fitness_vector> m_best_f;
-		std::vector<constraint_vector> m_best_c;
-
 		// Number of function and constraints evaluations
 		mutable unsigned int                    m_fevals;
 		mutable unsigned int                    m_cevals;
@@ -0,0 +1,251 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <boost/numeric/conversion/cast.hpp>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+#include "../exceptions.h"
+#include "../types.h"
+#include "base.h"
+#include "base_meta.h"
+
+namespace pagmo { namespace problem {
+
+/// Compose with an inner affine transformation.
+/**
+ * After the call, the transformation is equivalent to applying first *this and then t.
+ * The projection flag is set if any of the two transformations projects.
+ *
+ * @param[in] t affine transformation applied after *this.
+ */
+void base_meta::affine_transform::compose(const affine_transform &t)
+{
+	if (t.m_A.size()) {
+		if (m_A.size()) {
+			m_A = t.m_A * m_A;
+		} else {
+			m_A = t.m_A * m_d.asDiagonal();
+		}
+		m_b = t.m_A * m_b + t.m_b;
+	} else {
+		if (m_A.size()) {
+			m_A = t.m_d.asDiagonal() * m_A;
+		} else {
+			m_d = t.m_d.cwiseProduct(m_d);
+		}
+		m_b = t.m_d.cwiseProduct(m_b) + t.m_b;
+	}
+	m_clip = m_clip || t.m_clip;
+}
+
+/// Apply the linear and translation parts of the transformation.
+/**
+ * The projection onto the bounds, if needed, is left to the caller, as it depends on the problem being fed.
+ *
+ * @param[out] y transformed decision vector, resized to the size of x.
+ * @param[in] x decision vector to be transformed.
+ */
+void base_meta::affine_transform::apply(decision_vector &y, const decision_vector &x) const
+{
+	y.resize(x.size());
+	Eigen::Map<const Eigen::VectorXd> x_vec(&x[0],x.size());
+	Eigen::Map<Eigen::VectorXd> y_vec(&y[0],y.size());
+	if (m_A.size()) {
+		y_vec.noalias() = m_A * x_vec;
+		y_vec += m_b;
+	} else {
+		y_vec = m_d.cwiseProduct(x_vec) + m_b;
+	}
+}
+
+/// Affine transformation of the decision vector applied by the meta-problem.
+/**
+ * Meta-problems whose objective function and constraints are those of the original problem evaluated at an affine
+ * transformation of the decision vector can re-implement this method, so that they can be fused with the other
+ * meta-problems in a stack. A diagonal transformation must map the bounds of the meta-problem onto the bounds of the
+ * original problem, since the projection of an outer meta-problem is carried through it.
+ *
+ * Default implementation returns false, i.e. the meta-problem is not an affine transformation.
+ *
+ * @param[out] t the affine transformation.
+ *
+ * @return true if the meta-problem is an affine transformation of the decision vector, false otherwise.
+ */
+bool base_meta::get_affine_transform(affine_transform &) const
+{
+	return false;
+}
+
+// Build (if needed) and return the fused transformation. Inner meta-problems are fused as long as they
+// are affine transformations and, once a projection is met, as long as they are diagonal (the projection
+// commutes only with transformations that map bounds onto bounds). Concurrent first calls may build it
+// more than once, the results being identical.
+boost::shared_ptr<const base_meta::fused_transform> base_meta::get_fused_transform() const
+{
+	boost::shared_ptr<const fused_transform> retval = boost::atomic_load(&m_fused);
+	if (!retval) {
+		boost::shared_ptr<fused_transform> fused(new fused_transform());
+		fused->m_depth = 0;
+		if (get_affine_transform(fused->m_transform)) {
+			fused->m_depth = 1;
+			const base_meta *cur = this;
+			while (true) {
+				const base_meta *inner = dynamic_cast<const base_meta *>(cur->m_original_problem.get());
+				affine_transform t;
+				if (!inner || !inner->get_affine_transform(t) || (fused->m_transform.m_clip && t.m_A.size())) {
+					break;
+				}
+				fused->m_transform.compose(t);
+				++fused->m_depth;
+				cur = inner;
+			}
+		}
+		retval = fused;
+		boost::atomic_store(&m_fused,retval);
+	}
+	return retval;
+}
+
+// Problem fed by the fused transformation.
+const base &base_meta::get_fused_target(const fused_transform &fused) const
+{
+	const base_meta *cur = this;
+	for (unsigned int i = 1; i < fused.m_depth; ++i) {
+		cur = static_cast<const base_meta *>(cur->m_original_problem.get());
+	}
+	return *cur->m_original_problem;
+}
+
+// Update the function (or constraints) evaluation counters of the problems traversed by the fused transformation,
+// as if the evaluations had been forwarded through the stack.
+void base_meta::count_fused_evaluations(const fused_transform &fused, unsigned int n, bool constraints) const
+{
+	const base_meta *cur = this;
+	for (unsigned int i = 0; i < fused.m_depth; ++i) {
+		base &inner = *cur->m_original_problem;
+		if (constraints) {
+			inner.m_cevals += n;
+		} else {
+			inner.m_fevals += n;
+		}
+		if (i + 1 < fused.m_depth) {
+			cur = static_cast<const base_meta *>(cur->m_original_problem.get());
+		}
+	}
+}
+
+// Clip a decision vector to the bounds of a problem.
+static void project_to_bounds(decision_vector &y, const base &p)
+{
+	const decision_vector &lb = p.get_lb(), &ub = p.get_ub();
+	for (decision_vector::size_type i = 0; i < y.size(); ++i) {
+		y[i] = std::min(std::max(y[i],lb[i]),ub[i]);
+	}
+}
+
+/// Objective function through the fused transformation.
+/**
+ * Applies the fused transformation of the stack of meta-problems to x and calls directly the objective function
+ * implementation of the problem it feeds, bypassing the caches and checks of the inner problems but updating their
+ * function evaluation counters. To be used by meta-problems re-implementing get_affine_transform().
+ *
+ * @param[out] f fitness vector.
+ * @param[in] x decision vector.
+ *
+ * @throws value_error if the meta-problem is not an affine transformation.
+ */
+void base_meta::fused_objfun(fitness_vector &f, const decision_vector &x) const
+{
+	const boost::shared_ptr<const fused_transform> fused_ptr = get_fused_transform();
+	const fused_transform &fused = *fused_ptr;
+	if (!fused.m_depth) {
+		pagmo_throw(value_error,"meta-problem is not an affine transformation of the decision vector");
+	}
+	const base &target = get_fused_target(fused);
+	decision_vector y;
+	fused.m_transform.apply(y,x);
+	if (fused.m_transform.m_clip) {
+		project_to_bounds(y,target);
+	}
+	target.objfun_impl(f,y);
+	count_fused_evaluations(fused,1,false);
+}
+
+/// Constraints computation through the fused transformation.
+/**
+ * Same as fused_objfun(), for the constraints.
+ *
+ * @param[out] c constraint vector.
+ * @param[in] x decision vector.
+ *
+ * @throws value_error if the meta-problem is not an affine transformation.
+ */
+void base_meta::fused_compute_constraints(constraint_vector &c, const decision_vector &x) const
+{
+	const boost::shared_ptr<const fused_transform> fused_ptr = get_fused_transform();
+	const fused_transform &fused = *fused_ptr;
+	if (!fused.m_depth) {
+		pagmo_throw(value_error,"meta-problem is not an affine transformation of the decision vector");
+	}
+	const base &target = get_fused_target(fused);
+	decision_vector y;
+	fused.m_transform.apply(y,x);
+	if (fused.m_transform.m_clip) {
+		project_to_bounds(y,target);
+	}
+	target.compute_constraints_impl(c,y);
+	count_fused_evaluations(fused,1,true);
+}
+
+/// Batch objective function implementation.
+/**
+ * If the meta-problem is an affine transformation, the whole block is transformed and handed to the batch
+ * implementation of the problem fed by the fused transformation. Otherwise, falls back to base::objfun_batch_impl().
+ *
+ * @param[out] f block of fitness vectors.
+ * @param[in] x block of decision vectors.
+ */
+void base_meta::objfun_batch_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	const boost::shared_ptr<const fused_transform> fused_ptr = get_fused_transform();
+	const fused_transform &fused = *fused_ptr;
+	if (!fused.m_depth) {
+		base::objfun_batch_impl(f,x);
+		return;
+	}
+	const base &target = get_fused_target(fused);
+	std::vector<decision_vector> y(x.size());
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		fused.m_transform.apply(y[i],x[i]);
+		if (fused.m_transform.m_clip) {
+			project_to_bounds(y[i],target);
+		}
+	}
+	target.objfun_batch_impl(f,y);
+	count_fused_evaluations(fused,boost::numeric_cast<unsigned int>(x.size()),false);
+}
+
+}}
@@ -26,11 +26,13 @@
 #define PAGMO_PROBLEM_BASE_META_H
 
 #include <string>
+#include <boost/shared_ptr.hpp>
 
 #include "../serialization.h"
 #include "ackley.h"
 #include "../types.h"
 #include "base.h"
+#include "../Eigen/Dense"
 
 namespace pagmo{ namespace problem {
 
@@ -44,6 +46,14 @@ namespace pagmo{ namespace problem {
  * the meta-problem will make use of it. The custom implementation, in this case, is expected to work
  * for generic dimensions of the fitness vector as metaproblems may transform this dimension at will.
  *
+ * Meta-problems that only apply an affine transformation to the decision vector (e.g. shifted, rotated, normalized)
+ * can describe it by re-implementing get_affine_transform() and evaluating through fused_objfun() and
+ * fused_compute_constraints(). A stack of such meta-problems is then flattened, on the first evaluation, into a
+ * single affine map that is applied once before calling directly the implementation of the innermost problem,
+ * thus skipping the intermediate temporaries, caches and decision vector checks (the decision vector has been
+ * checked by the outermost problem, and the transformed one has the dimension of the innermost problem by
+ * construction). The function evaluation counters of the inner problems are still updated.
+ *
  * @author Dario Izzo (dario,izzo@gmail.com)
  */
 
@@ -57,8 +67,32 @@ class __PAGMO_VISIBLE base_meta : public base
 				set_bounds(m_original_problem->get_lb(),m_original_problem->get_ub());
 			 }
 		/// Copy constructor
-		base_meta(const base_meta &p):base(p), m_original_problem(p.m_original_problem->clone()) {}
+		base_meta(const base_meta &p):base(p), m_original_problem(p.m_original_problem->clone()), m_fused(boost::atomic_load(&p.m_fused)) {}
 	protected:
+		/// Affine transformation of the decision vector.
+		/**
+		 * Maps a decision vector x of the meta-problem into the decision vector A*x + b of the original problem.
+		 * The linear part A is stored as the full matrix m_A or, when m_A is empty, as its diagonal m_d.
+		 * If m_clip is true the result is then projected onto the bounds of the original problem.
+		 */
+		struct affine_transform
+		{
+			affine_transform():m_clip(false) {}
+			void compose(const affine_transform &);
+			void apply(decision_vector &, const decision_vector &) const;
+			/// Full linear part (empty if diagonal).
+			Eigen::MatrixXd	m_A;
+			/// Diagonal of the linear part (used only if m_A is empty).
+			Eigen::VectorXd	m_d;
+			/// Translation.
+			Eigen::VectorXd	m_b;
+			/// Projection onto the bounds of the original problem.
+			bool		m_clip;
+		};
+		virtual bool get_affine_transform(affine_transform &) const;
+		void fused_objfun(fitness_vector &, const decision_vector &) const;
+		void fused_compute_constraints(constraint_vector &, const decision_vector &) const;
+		void objfun_batch_impl(std::vector<fitness_vector> &, const std::vector<decision_vector> &) const;
 		bool compare_fitness_impl(const fitness_vector &f1, const fitness_vector &f2) const 
 			{return m_original_problem->compare_fitness_impl(f1,f2);}
 		//NOTE: It is not possible to use the same trick for the other two virtual compares as they also depend from
@@ -68,16 +102,34 @@ class __PAGMO_VISIBLE base_meta : public base
 		bool compare_fc_impl(const fitness_vector &f1, const constraint_vector &c1, const fitness_vector &f2, const constraint_vector &c2) const
 			{return m_original_problem->compare_fc_impl(f1,c1,f2,c2);}
 	private:
+		// The fused transformation of a stack of meta-problems and the number of original problems
+		// to be traversed to reach the problem it feeds.
+		struct fused_transform
+		{
+			affine_transform	m_transform;
+			unsigned int		m_depth;
+		};
+		boost::shared_ptr<const fused_transform> get_fused_transform() const;
+		const base &get_fused_target(const fused_transform &) const;
+		void count_fused_evaluations(const fused_transform &, unsigned int, bool) const;
+
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
 		{
 			ar & boost::serialization::base_object<base>(*this);
 			ar & m_original_problem;
+			// The fused transformation is not serialized, it is rebuilt on the first evaluation.
+			boost::atomic_store(&m_fused,boost::shared_ptr<const fused_transform>());
 		}
 	protected:
 		/// Smart pointer to the original problem instance
 		base_ptr m_original_problem;
+	private:
+		// Immutable once built, hence shared among copies. It is built lazily, as the affine transformations
+		// are not available until the derived meta-problems are constructed, and it is always accessed through
+		// boost::atomic_load()/atomic_store(), as the first evaluations may happen concurrently.
+		mutable boost::shared_ptr<const fused_transform> m_fused;
 };
 
 }} //namespaces
@@ -22,8 +22,19 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <boost/thread/thread.hpp>
+#include <exception>
+#include <limits>
+#include <string>
+#include <vector>
+
 #include "base_stochastic.h"
+#include "../exceptions.h"
 #include "../serialization.h"
+#include "../types.h"
+#include "../util/discrepancy.h"
 
 namespace pagmo { namespace problem {
 
@@ -36,7 +47,8 @@ namespace pagmo { namespace problem {
  * @param[in] dim global dimension of the problem.
  * @param[in] seed random number generator seed
  */
-base_stochastic::base_stochastic(int dim, unsigned int seed) : base(dim), m_drng(seed), m_urng(seed), m_seed(seed)
+base_stochastic::base_stochastic(int dim, unsigned int seed) : base(dim), m_drng(seed), m_urng(seed), m_seed(seed),
+	m_sampling(SERIAL), m_crn(true), m_sampling_threads(1)
 {
 }
 
@@ -50,7 +62,8 @@ base_stochastic::base_stochastic(int dim, unsigned int seed) : base(dim), m_drng
  * @param[in] c_tol constraints tolerance (equal for all constraints)
  * @param[in] seed random number generator seed
 */
-base_stochastic::base_stochastic(int n, int ni, int nf, int nc, int nic, const double &c_tol, unsigned int seed): base((int)n, ni, nf, nc, nic, c_tol), m_drng(seed), m_urng(seed), m_seed(seed)
+base_stochastic::base_stochastic(int n, int ni, int nf, int nc, int nic, const double &c_tol, unsigned int seed): base((int)n, ni, nf, nc, nic, c_tol), m_drng(seed), m_urng(seed), m_seed(seed),
+	m_sampling(SERIAL), m_crn(true), m_sampling_threads(1)
 {
 }
 
@@ -64,7 +77,8 @@ base_stochastic::base_stochastic(int n, int ni, int nf, int nc, int nic, const d
  * @param[in] c_tol constraints tolerance std::vector
  * @param[in] seed random number generator seed
 */
-base_stochastic::base_stochastic(int n, int ni, int nf, int nc, int nic, const std::vector<double> &c_tol, unsigned int seed): base((int)n, ni, nf, nc, nic, c_tol), m_drng(seed), m_urng(seed), m_seed(seed)
+base_stochastic::base_stochastic(int n, int ni, int nf, int nc, int nic, const std::vector<double> &c_tol, unsigned int seed): base((int)n, ni, nf, nc, nic, c_tol), m_drng(seed), m_urng(seed), m_seed(seed),
+	m_sampling(SERIAL), m_crn(true), m_sampling_threads(1)
 {
 }
 
@@ -90,6 +104,176 @@ unsigned int base_stochastic::get_seed() const {
 	return m_seed;
 }
 
+/// Sets the Monte-Carlo sampling scheme
+/**
+ * In the PARALLEL and SOBOL schemes the samples of each trial are fixed by the seed of the problem, by the index
+ * of the trial and, if common random numbers are not used, by the decision vector. The estimate does therefore
+ * not depend on the number of threads, nor on the order in which the decision vectors are evaluated. With common
+ * random numbers, all decision vectors are evaluated on the same samples, which reduces the variance of the
+ * difference between two estimates and makes their comparison more reliable.
+ *
+ * Problems that do not support the PARALLEL and SOBOL schemes keep on using the SERIAL one.
+ *
+ * @param[in] type sampling scheme
+ * @param[in] crn true to use common random numbers
+ * @param[in] n_threads number of threads running the trials (0 means as many as the hardware supports)
+ *
+ * @throws value_error if the sampling scheme is not valid
+ */
+void base_stochastic::set_sampling(sampling_type type, bool crn, unsigned int n_threads)
+{
+	if (type != SERIAL && type != PARALLEL && type != SOBOL) {
+		pagmo_throw(value_error,"invalid sampling scheme");
+	}
+	m_sampling = type;
+	m_crn = crn;
+	m_sampling_threads = n_threads ? n_threads : std::max(boost::thread::hardware_concurrency(),1u);
+	// The estimates change with the sampling scheme.
+	reset_caches();
+}
+
+/// Gets the Monte-Carlo sampling scheme
+/**
+ * @return the sampling scheme
+ */
+base_stochastic::sampling_type base_stochastic::get_sampling() const
+{
+	return m_sampling;
+}
+
+/// Gets the common random numbers flag
+/**
+ * @return true if the samples do not depend on the decision vector
+ */
+bool base_stochastic::get_common_random_numbers() const
+{
+	return m_crn;
+}
+
+/// Gets the number of threads running the trials
+/**
+ * @return the number of threads
+ */
+unsigned int base_stochastic::get_sampling_threads() const
+{
+	return m_sampling_threads;
+}
+
+// Seed of the samples drawn at x.
+boost::uint32_t base_stochastic::get_sampling_seed(const decision_vector &x) const
+{
+	std::size_t seed = m_seed;
+	if (!m_crn) {
+		boost::hash_combine(seed,boost::hash<decision_vector>()(x));
+	}
+	return static_cast<boost::uint32_t>(seed);
+}
+
+/// Seed of a trial
+/**
+ * Seed of the trial_rng_type stream of trial i at x in the PARALLEL scheme.
+ *
+ * @param[in] i index of the trial
+ * @param[in] x decision vector
+ *
+ * @return the seed of the stream
+ */
+unsigned int base_stochastic::get_trial_seed(unsigned int i, const decision_vector &x) const
+{
+	std::size_t seed = get_sampling_seed(x);
+	boost::hash_combine(seed,i);
+	return static_cast<unsigned int>(seed);
+}
+
+/// Quasi-random samples of the trials
+/**
+ * Fills retval with the first n points of a scrambled Sobol' sequence of dimension dim, stored row by row (the
+ * row i holding the samples of trial i) and moved inside the open unit hypercube, so that they can be fed to
+ * inverse cumulative distribution functions. The scrambling is seeded as the streams of get_trial_seed().
+ *
+ * @param[out] retval n x dim matrix, row-major, resized as needed
+ * @param[in] n number of trials
+ * @param[in] dim number of samples per trial
+ * @param[in] x decision vector
+ *
+ * @throws value_error if dim is not in the range supported by util::discrepancy::sobol
+ */
+void base_stochastic::get_sobol_block(std::vector<double> &retval, unsigned int n, unsigned int dim, const decision_vector &x) const
+{
+	util::discrepancy::scrambled_sobol(dim,0,get_sampling_seed(x)).generate(retval,0,n);
+	const double eps = std::numeric_limits<double>::epsilon();
+	for (std::vector<double>::size_type i = 0; i < retval.size(); ++i) {
+		retval[i] = std::min(std::max(retval[i],eps),1. - eps);
+	}
+}
+
+struct base_stochastic::run_trials_task
+{
+	void operator()() const
+	{
+		try {
+			(*task)(chunk,first,n);
+		} catch (const std::exception &e) {
+			*err = e.what();
+			if (err->empty()) {
+				*err = "error while running the trials";
+			}
+		}
+	}
+	const trials_task *task;
+	unsigned int chunk;
+	unsigned int first;
+	unsigned int n;
+	std::string *err;
+};
+
+/// Number of chunks of trials
+/**
+ * @param[in] n number of trials
+ *
+ * @return the number of chunks into which run_trials() splits n trials.
+ */
+unsigned int base_stochastic::get_trial_chunks(unsigned int n) const
+{
+	return std::max(std::min(m_sampling_threads,n),1u);
+}
+
+/// Run the trials
+/**
+ * Splits the n trials in get_trial_chunks() contiguous chunks and runs task on each of them concurrently.
+ * With a single chunk, task is called once on the whole range from the calling thread.
+ *
+ * @param[in] n number of trials
+ * @param[in] task functor running a chunk of trials
+ *
+ * @throws value_error if task throws
+ */
+void base_stochastic::run_trials(unsigned int n, const trials_task &task) const
+{
+	if (n == 0) {
+		return;
+	}
+	const unsigned int n_threads = get_trial_chunks(n);
+	if (n_threads == 1) {
+		task(0,0,n);
+		return;
+	}
+	std::vector<std::string> err(n_threads);
+	boost::thread_group threads;
+	for (unsigned int t = 0; t < n_threads; ++t) {
+		const unsigned int begin = n / n_threads * t + std::min(t,n % n_threads);
+		const unsigned int size = n / n_threads + (t < n % n_threads ? 1u : 0u);
+		run_trials_task rt = {&task,t,begin,size,&err[t]};
+		threads.create_thread(rt);
+	}
+	threads.join_all();
+	for (unsigned int t = 0; t < n_threads; ++t) {
+		if (!err[t].empty()) {
+			pagmo_throw(value_error,err[t].c_str());
+		}
+	}
+}
+
 }} //namespaces
 
 //BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::base_stochastic);
@@ -25,9 +25,13 @@
 #ifndef PAGMO_PROBLEM_BASE_STOCHASTIC_H
 #define PAGMO_PROBLEM_BASE_STOCHASTIC_H
 
+#include <boost/random/taus88.hpp>
+#include <vector>
+
 #include "base.h"
 #include "../serialization.h"
 #include "../rng.h"
+#include "../types.h"
 
 namespace pagmo{ namespace problem {
 
@@ -50,6 +54,11 @@ namespace pagmo{ namespace problem {
  *
  * See pagmo::algorithm::pso_stochastic for a good example of such techniques.
  *
+ * The expected value is estimated by Monte-Carlo sampling. Besides the default SERIAL scheme, where the samples
+ * (trials) are drawn one after the other from m_drng, problems can support the schemes selected by set_sampling(),
+ * where each trial draws from its own stream (see get_trial_seed()) or from a scrambled Sobol' sequence
+ * (see get_sobol_block()), and the trials are dispatched to several threads through run_trials().
+ *
  * @author Dario Izzo (dario.izzo@gmail.com)
  */
 
@@ -60,17 +69,56 @@ class __PAGMO_VISIBLE base_stochastic : public base
 		base_stochastic(int, int, int, int, int, const double&, unsigned int);
 		base_stochastic(int, int, int, int, int, const std::vector<double>&, unsigned int);
 
+		/// Monte-Carlo sampling scheme.
+		enum sampling_type {
+			SERIAL = 0, ///< Trials drawn one after the other from the internal generator (default).
+			PARALLEL = 1, ///< Each trial draws from its own stream, trials evaluated as a batch on several threads.
+			SOBOL = 2 ///< As PARALLEL, with the random samples taken from a scrambled Sobol' sequence.
+		};
+		/// Random number generator of a single trial.
+		typedef boost::random::taus88 trial_rng_type;
+
 		unsigned int get_seed() const;
 		void set_seed(unsigned int) const; //This is marked const as m_seed is mutable (needs to be)
+		void set_sampling(sampling_type, bool = true, unsigned int = 1);
+		sampling_type get_sampling() const;
+		bool get_common_random_numbers() const;
+		unsigned int get_sampling_threads() const;
+	protected:
+		/// Chunk of trials.
+		/**
+		 * Functor called by run_trials() on contiguous chunks of trials, possibly from several threads at once.
+		 * Chunks are numbered from 0 and no two chunks with the same number run at the same time, so that a
+		 * task can keep per-chunk resources.
+		 */
+		struct trials_task
+		{
+			virtual ~trials_task() {}
+			/// Run the trials of indices first, first + 1, ..., first + n - 1, forming the chunk number chunk.
+			virtual void operator()(unsigned int chunk, unsigned int first, unsigned int n) const = 0;
+		};
+		unsigned int get_trial_seed(unsigned int, const decision_vector &) const;
+		void get_sobol_block(std::vector<double> &, unsigned int, unsigned int, const decision_vector &) const;
+		unsigned int get_trial_chunks(unsigned int) const;
+		void run_trials(unsigned int, const trials_task &) const;
 	private:
+		boost::uint32_t get_sampling_seed(const decision_vector &) const;
+		struct run_trials_task;
+
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void serialize(Archive &ar, const unsigned int version)
 		{
 			ar & boost::serialization::base_object<base>(*this);
 			ar & m_drng;
 			ar & m_urng; 
 			ar & m_seed;
+			// The sampling scheme was added in version 1.
+			if (version >= 1) {
+				ar & m_sampling;
+				ar & m_crn;
+				ar & m_sampling_threads;
+			}
 		}
 		
 	protected:
@@ -80,11 +128,18 @@ class __PAGMO_VISIBLE base_stochastic : public base
 		mutable rng_uint32	m_urng;
 		/// Seed of the random number generator
 		mutable unsigned int			m_seed;
+		/// Monte-Carlo sampling scheme.
+		sampling_type				m_sampling;
+		/// Common random numbers flag: if true, the samples do not depend on the decision vector.
+		bool					m_crn;
+		/// Number of threads running the trials.
+		unsigned int				m_sampling_threads;
 
 };
 
 }} //namespaces
 
 BOOST_SERIALIZATION_ASSUME_ABSTRACT(pagmo::problem::base_stochastic)
+BOOST_CLASS_VERSION(pagmo::problem::base_stochastic,1)
 
 #endif // PAGMO_PROBLEM_BASE_STOCHASTIC_H
@@ -22,16 +22,28 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <boost/cstdint.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <boost/math/constants/constants.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/numeric/conversion/cast.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/weak_ptr.hpp>
 #include <cmath>
+#include <cstring>
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <utility>
 #include <vector>
 #include <iterator>
 
 
+#include "../Eigen/Dense"
 #include "../exceptions.h"
 #include "../types.h"
 #include "cec2013.h"
@@ -42,6 +54,280 @@
 
 namespace pagmo { namespace problem {
 
+namespace {
+
+// Scratch space used by the test functions. It is kept per thread instead of as mutable members, so that
+// the same instance can be evaluated concurrently and clones do not need to carry it around.
+struct cec2013_scratch
+{
+	std::vector<double>	y;
+	std::vector<double>	z;
+	Eigen::MatrixXd		X;
+	Eigen::MatrixXd		Y;
+	Eigen::MatrixXd		Z;
+	Eigen::RowVectorXd	fit;
+};
+
+cec2013_scratch &get_scratch(int nx)
+{
+	static thread_local cec2013_scratch scratch;
+	if (scratch.y.size() < static_cast<std::vector<double>::size_type>(nx)) {
+		scratch.y.resize(nx);
+		scratch.z.resize(nx);
+	}
+	return scratch;
+}
+
+// Batch counterparts of cec2013's shiftfunc, rotatefunc, asyfunc and oszfunc. They operate on blocks
+// whose columns are decision vectors, and they mirror exactly the use of the scratch buffers made by the
+// single-vector versions (asyfunc, in particular, leaves untouched the non-positive components of its output).
+typedef Eigen::Map<const Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> > rotation_map;
+
+void shift_block(const Eigen::MatrixXd &X, Eigen::MatrixXd &Y, int nx, const double *Os)
+{
+	Y = X.colwise() - Eigen::Map<const Eigen::VectorXd>(Os,nx);
+}
+
+void rotate_block(const Eigen::MatrixXd &A, Eigen::MatrixXd &B, int nx, const double *Mr, int r_flag)
+{
+	if (r_flag==1) {
+		B.noalias() = rotation_map(Mr,nx,nx) * A;
+	} else {
+		B = A;
+	}
+}
+
+void asy_block(const Eigen::MatrixXd &A, Eigen::MatrixXd &B, int nx, double beta)
+{
+	for (Eigen::MatrixXd::Index j = 0; j < A.cols(); ++j) {
+		for (int i = 0; i < nx; ++i) {
+			if (A(i,j)>0)
+				B(i,j)=pow(A(i,j),1.0+beta*i/(nx-1)*pow(A(i,j),0.5));
+		}
+	}
+}
+
+double osz_component(double x)
+{
+	if (x==0) {
+		return 0.0;
+	}
+	const double xx=log(fabs(x));
+	const double c1 = x > 0 ? 10 : 5.5, c2 = x > 0 ? 7.9 : 3.1;
+	return (x > 0 ? 1 : -1)*exp(xx+0.049*(sin(c1*xx)+sin(c2*xx)));
+}
+
+void osz_block(const Eigen::MatrixXd &A, Eigen::MatrixXd &B, int nx)
+{
+	B = A;
+	for (Eigen::MatrixXd::Index j = 0; j < A.cols(); ++j) {
+		B(0,j) = osz_component(A(0,j));
+		B(nx-1,j) = osz_component(A(nx-1,j));
+	}
+}
+
+// Per-component scaling factors base^(i/(nx-1)/2), as used by several test functions.
+Eigen::ArrayXd cond_weights(int nx, double base)
+{
+	Eigen::ArrayXd retval(nx);
+	for (int i = 0; i < nx; ++i) {
+		retval(i) = pow(base,1.0*i/(nx-1)/2.0);
+	}
+	return retval;
+}
+
+// Evaluate the raw (unbiased) value of the basic function fun_id on the columns of s.X, writing the results in s.fit.
+// Returns false if there is no batch kernel for fun_id.
+bool batch_kernel(unsigned int fun_id, cec2013_scratch &s, int nx, const double *Os, const double *Mr)
+{
+	const double pi = boost::math::constants::pi<double>();
+	Eigen::MatrixXd &Y = s.Y, &Z = s.Z;
+	Eigen::RowVectorXd &fit = s.fit;
+	switch (fun_id) {
+	case 1:
+		// Sphere.
+		shift_block(s.X,Y,nx,Os);
+		fit = Y.colwise().squaredNorm();
+		return true;
+	case 2:
+	{
+		// Ellipsoidal.
+		shift_block(s.X,Y,nx,Os);
+		rotate_block(Y,Z,nx,Mr,1);
+		osz_block(Z,Y,nx);
+		Eigen::VectorXd w(nx);
+		for (int i=0; i<nx; i++)
+			w(i) = pow(10.0,6.0*i/(nx-1));
+		fit.noalias() = w.transpose() * Y.cwiseProduct(Y);
+		return true;
+	}
+	case 3:
+		// Bent cigar.
+		shift_block(s.X,Y,nx,Os);
+		rotate_block(Y,Z,nx,Mr,1);
+		asy_block(Z,Y,nx,0.5);
+		rotate_block(Y,Z,nx,&Mr[nx*nx],1);
+		fit = Z.row(0).cwiseAbs2() + pow(10.0,6.0) * Z.bottomRows(nx-1).colwise().squaredNorm();
+		return true;
+	case 4:
+		// Discus.
+		shift_block(s.X,Y,nx,Os);
+		rotate_block(Y,Z,nx,Mr,1);
+		osz_block(Z,Y,nx);
+		fit = pow(10.0,6.0) * Y.row(0).cwiseAbs2() + Y.bottomRows(nx-1).colwise().squaredNorm();
+		return true;
+	case 5:
+		// Different powers. NOTE: the integer division in the exponent is the same as in the reference implementation.
+		shift_block(s.X,Y,nx,Os);
+		fit.setZero(Y.cols());
+		for (Eigen::MatrixXd::Index j = 0; j < Y.cols(); ++j) {
+			for (int i=0; i<nx; i++)
+				fit(j) += pow(fabs(Y(i,j)),2+4*i/(nx-1));
+		}
+		fit = fit.cwiseSqrt();
+		return true;
+	case 6:
+	{
+		// Rosenbrock.
+		shift_block(s.X,Y,nx,Os);
+		Y *= 2.048/100;
+		rotate_block(Y,Z,nx,Mr,1);
+		Z.array() += 1;
+		const Eigen::ArrayXXd tmp1 = Z.topRows(nx-1).array().square() - Z.bottomRows(nx-1).array();
+		fit = (100.0*tmp1.square() + (Z.topRows(nx-1).array()-1.0).square()).colwise().sum();
+		return true;
+	}
+	case 8:
+		// Ackley.
+		shift_block(s.X,Y,nx,Os);
+		rotate_block(Y,Z,nx,Mr,1);
+		asy_block(Z,Y,nx,0.5);
+		Z = (Y.array().colwise() * cond_weights(nx,10.0)).matrix();
+		rotate_block(Z,Y,nx,&Mr[nx*nx],1);
+		fit = (E - 20.0*(-0.2*(Y.colwise().squaredNorm().array()/nx).sqrt()).exp()
+			- ((2.0*pi*Y.array()).cos().colwise().sum()/nx).exp() + 20.0).matrix();
+		return true;
+	case 10:
+	{
+		// Griewank.
+		shift_block(s.X,Y,nx,Os);
+		Y *= 600.0/100.0;
+		rotate_block(Y,Z,nx,Mr,1);
+		Z = (Z.array().colwise() * cond_weights(nx,100.0)).matrix();
+		Eigen::ArrayXd isqrt(nx);
+		for (int i=0; i<nx; i++)
+			isqrt(i) = 1.0/sqrt(1.0+i);
+		fit = (1.0 + Z.colwise().squaredNorm().array()/4000.0
+			- (Z.array().colwise() * isqrt).cos().colwise().prod()).matrix();
+		return true;
+	}
+	case 11:
+	case 12:
+	{
+		// Rastrigin, non-rotated (f11) and rotated (f12).
+		const int r_flag = (fun_id == 12);
+		shift_block(s.X,Y,nx,Os);
+		Y *= 5.12/100;
+		rotate_block(Y,Z,nx,Mr,r_flag);
+		osz_block(Z,Y,nx);
+		asy_block(Y,Z,nx,0.2);
+		rotate_block(Z,Y,nx,&Mr[nx*nx],r_flag);
+		Y = (Y.array().colwise() * cond_weights(nx,10.0)).matrix();
+		rotate_block(Y,Z,nx,Mr,r_flag);
+		fit = (Z.array().square() - 10.0*(2.0*pi*Z.array()).cos() + 10.0).colwise().sum().matrix();
+		return true;
+	}
+	case 14:
+	case 15:
+	{
+		// Schwefel, non-rotated (f14) and rotated (f15).
+		const int r_flag = (fun_id == 15);
+		shift_block(s.X,Y,nx,Os);
+		Y *= 1000/100;
+		rotate_block(Y,Z,nx,Mr,r_flag);
+		Y = (Z.array().colwise() * cond_weights(nx,10.0)).matrix();
+		Z = (Y.array() + 4.209687462275036e+002).matrix();
+		fit.resize(Z.cols());
+		for (Eigen::MatrixXd::Index j = 0; j < Z.cols(); ++j) {
+			double f = 0, tmp;
+			for (int i=0; i<nx; i++)
+			{
+				const double zi = Z(i,j);
+				if (zi>500)
+				{
+					f-=(500.0-fmod(zi,500))*sin(pow(500.0-fmod(zi,500),0.5));
+					tmp=(zi-500.0)/100;
+					f+= tmp*tmp/nx;
+				}
+				else if (zi<-500)
+				{
+					f-=(-500.0+fmod(fabs(zi),500))*sin(pow(500.0-fmod(fabs(zi),500),0.5));
+					tmp=(zi+500.0)/100;
+					f+= tmp*tmp/nx;
+				}
+				else
+					f-=zi*sin(pow(fabs(zi),0.5));
+			}
+			fit(j)=4.189828872724338e+002*nx+f;
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+}
+
+/// Read-only CEC2013 input data.
+/**
+ * The rotation matrices and the origin shifts point either into a memory-mapped binary file, or into
+ * the vectors owned by this structure when the data was parsed from the text files.
+ */
+struct cec2013::data
+{
+	data():m_rotation_matrix(0),m_rotation_size(0),m_origin_shift(0),m_shift_size(0),m_inline(false) {}
+	boost::shared_ptr<boost::interprocess::mapped_region>	m_region;
+	std::vector<double>					m_rotation_storage;
+	std::vector<double>					m_shift_storage;
+	const double						*m_rotation_matrix;
+	std::size_t						m_rotation_size;
+	const double						*m_origin_shift;
+	std::size_t						m_shift_size;
+	// True if the data was read from an archive rather than from the input files.
+	bool							m_inline;
+};
+
+namespace {
+
+// Header of the binary data files: magic string, followed by the number of doubles of the rotation matrices
+// and of the origin shifts. The doubles follow the header in native byte order.
+const char binary_magic[8] = {'P','G','C','E','C','1','3','\0'};
+
+struct binary_header
+{
+	char		magic[8];
+	boost::uint64_t	rotation_size;
+	boost::uint64_t	shift_size;
+};
+
+std::string binary_file_name(const std::string &dir, problem::base::size_type d)
+{
+	return dir + "cec2013_D" + boost::lexical_cast<std::string>(d) + ".bin";
+}
+
+std::vector<double> read_text_file(const std::string &data_file_name)
+{
+	std::ifstream data_file(data_file_name.c_str());
+	if (!data_file.is_open()) {
+		pagmo_throw(io_error, std::string("Error: file not found. I was looking for (") + data_file_name.c_str() + ")");
+	}
+	std::istream_iterator<double> start(data_file), end;
+	return std::vector<double>(start,end);
+}
+
+}
+
 /// Constructor
 /**
  * Will construct one of the 28 CEC2013 problems
@@ -49,50 +335,169 @@ namespace pagmo { namespace problem {
  * @param[in] fun_id The problem id. One of [1,2,...,28]
  * @param[in] d problem dimension. One of [2,5,10,20,30,...,100]
  * @param[in] dir The path where the CEC2013 input files are located.
- *                Two files are expected: "M_Dx.txt" and "shift_data.txt", where "x" is the problem dimension
+ *                Either the binary file "cec2013_Dx.bin" or the two text files "M_Dx.txt" and "shift_data.txt"
+ *                are expected, where "x" is the problem dimension
  *
  * @see http://web.mysites.ntu.edu.sg/epnsugan/PublicSite/Shared%20Documents/CEC2013/cec13-c-code.zip to find
  * the files
  * @throws io_error if the files are not found
  */
-cec2013::cec2013(unsigned int fun_id, problem::base::size_type d, const std::string& dir):base(d),m_problem_number(fun_id), m_y(d), m_z(d)
+cec2013::cec2013(unsigned int fun_id, problem::base::size_type d, const std::string& dir):base(d),m_problem_number(fun_id),m_dir(dir)
 {
 	if (!(d==2||d==5||d==10||d==20||d==30||d==40||d==50||d==60||d==70||d==80||d==90||d==100))
 	{
 		pagmo_throw(value_error, "Error: CEC2013 Test functions are only defined for dimensions 2,5,10,20,30,40,50,60,70,80,90,100.");
 	}
+	m_data = get_data(m_dir,d);
+	// Set bounds. All CEC2013 problems have the same bounds
+	set_bounds(-100,100);
+}
 
-	// We create the full file name for the rotation matrix
-	std::string data_file_name(dir);
-	data_file_name.append("M_D");
-	data_file_name.append(boost::lexical_cast<std::string>(d));
-	data_file_name.append(".txt");
-	// And we read all datas into m_rotation_matrix
-	{
-	std::ifstream data_file(data_file_name.c_str());
-	if (!data_file.is_open()) {
-		pagmo_throw(io_error, std::string("Error: file not found. I was looking for (") + data_file_name.c_str() + ")");
-	}
-	std::istream_iterator<double> start(data_file), end;
-	m_rotation_matrix = std::vector<double>(start,end);
-	data_file.close();
+/// Get the shared input data.
+/**
+ * Returns the data loaded from the folder dir for dimension d. The data is loaded only if no other instance
+ * is currently using it, otherwise the existing copy is returned.
+ *
+ * @param[in] dir The path where the CEC2013 input files are located.
+ * @param[in] d problem dimension.
+ *
+ * @return pointer to the read-only data.
+ * @throws io_error if the files are not found or are not valid.
+ */
+cec2013::data_ptr cec2013::get_data(const std::string &dir, problem::base::size_type d)
+{
+	typedef std::map<std::pair<std::string,problem::base::size_type>,boost::weak_ptr<const data> > store_type;
+	static store_type store;
+	static boost::mutex store_mutex;
+
+	boost::lock_guard<boost::mutex> lock(store_mutex);
+	boost::weak_ptr<const data> &entry = store[std::make_pair(dir,d)];
+	data_ptr retval = entry.lock();
+	if (!retval) {
+		retval = std::ifstream(binary_file_name(dir,d).c_str()).is_open() ? map_binary_data(dir,d) : read_text_data(dir,d);
+		// Composition functions use up to ten rotation matrices and origin shifts.
+		if (retval->m_rotation_size < 10 * d * d || retval->m_shift_size < 10 * d) {
+			pagmo_throw(io_error, "Error: the CEC2013 input data in (" + dir + ") is too short for the requested dimension.");
+		}
+		entry = retval;
 	}
+	return retval;
+}
 
-	// We create the full file name for the shift vector
-	data_file_name = dir;
-	data_file_name.append("shift_data.txt");
-	// And we read all data into m_origin_shift
+// Parse the text files M_Dx.txt and shift_data.txt.
+cec2013::data_ptr cec2013::read_text_data(const std::string &dir, problem::base::size_type d)
+{
+	boost::shared_ptr<data> retval(new data);
+	retval->m_rotation_storage = read_text_file(dir + "M_D" + boost::lexical_cast<std::string>(d) + ".txt");
+	retval->m_shift_storage = read_text_file(dir + "shift_data.txt");
+	retval->m_rotation_matrix = retval->m_rotation_storage.empty() ? 0 : &retval->m_rotation_storage[0];
+	retval->m_rotation_size = retval->m_rotation_storage.size();
+	retval->m_origin_shift = retval->m_shift_storage.empty() ? 0 : &retval->m_shift_storage[0];
+	retval->m_shift_size = retval->m_shift_storage.size();
+	return retval;
+}
+
+// Memory-map the binary file cec2013_Dx.bin.
+cec2013::data_ptr cec2013::map_binary_data(const std::string &dir, problem::base::size_type d)
+{
+	const std::string file_name = binary_file_name(dir,d);
+	boost::shared_ptr<data> retval(new data);
+	try {
+		boost::interprocess::file_mapping mapping(file_name.c_str(),boost::interprocess::read_only);
+		retval->m_region.reset(new boost::interprocess::mapped_region(mapping,boost::interprocess::read_only));
+	} catch (const boost::interprocess::interprocess_exception &) {
+		pagmo_throw(io_error, "Error: could not map the binary file (" + file_name + ")");
+	}
+	const char *begin = static_cast<const char *>(retval->m_region->get_address());
+	const std::size_t size = retval->m_region->get_size();
+	binary_header header;
+	if (size < sizeof(binary_header)) {
+		pagmo_throw(io_error, "Error: invalid binary file (" + file_name + ")");
+	}
+	std::memcpy(&header,begin,sizeof(binary_header));
+	if (std::memcmp(header.magic,binary_magic,sizeof(binary_magic)) ||
+		size != sizeof(binary_header) + (header.rotation_size + header.shift_size) * sizeof(double))
 	{
-	std::ifstream data_file(data_file_name.c_str());
+		pagmo_throw(io_error, "Error: invalid binary file (" + file_name + ")");
+	}
+	retval->m_rotation_matrix = reinterpret_cast<const double *>(begin + sizeof(binary_header));
+	retval->m_rotation_size = boost::numeric_cast<std::size_t>(header.rotation_size);
+	retval->m_origin_shift = retval->m_rotation_matrix + retval->m_rotation_size;
+	retval->m_shift_size = boost::numeric_cast<std::size_t>(header.shift_size);
+	return retval;
+}
+
+/// Write the binary data file.
+/**
+ * Converts the text files "M_Dx.txt" and "shift_data.txt" located in dir into the binary file "cec2013_Dx.bin",
+ * written in the same folder, where "x" is the problem dimension. The binary file is memory-mapped by all the
+ * subsequent constructions of the problem with the same folder and dimension, which is much faster than parsing the
+ * text files. The doubles are stored in the native byte order, so the binary file is not portable across architectures.
+ *
+ * @param[in] dir The path where the CEC2013 input files are located.
+ * @param[in] d problem dimension.
+ *
+ * @throws io_error if the text files are not found or if the binary file cannot be written.
+ */
+void cec2013::write_binary_data(const std::string &dir, problem::base::size_type d)
+{
+	const data_ptr text_data = read_text_data(dir,d);
+	binary_header header;
+	std::memcpy(header.magic,binary_magic,sizeof(binary_magic));
+	header.rotation_size = text_data->m_rotation_size;
+	header.shift_size = text_data->m_shift_size;
+	const std::string file_name = binary_file_name(dir,d);
+	std::ofstream data_file(file_name.c_str(),std::ios::binary | std::ios::trunc);
 	if (!data_file.is_open()) {
-		pagmo_throw(io_error, std::string("Error: file not found. I was looking for ").append(data_file_name.c_str()));
+		pagmo_throw(io_error, "Error: could not open the binary file (" + file_name + ") for writing");
 	}
-	std::istream_iterator<double> start(data_file), end;
-	m_origin_shift = std::vector<double>(start,end);
-	data_file.close();
+	data_file.write(reinterpret_cast<const char *>(&header),sizeof(binary_header));
+	data_file.write(reinterpret_cast<const char *>(text_data->m_rotation_matrix),text_data->m_rotation_size * sizeof(double));
+	data_file.write(reinterpret_cast<const char *>(text_data->m_origin_shift),text_data->m_shift_size * sizeof(double));
+	if (!data_file) {
+		pagmo_throw(io_error, "Error: could not write the binary file (" + file_name + ")");
 	}
-	// Set bounds. All CEC2013 problems have the same bounds
-	set_bounds(-100,100);
+}
+
+// True if the data was read from an archive rather than from the input files.
+bool cec2013::has_inline_data() const
+{
+	return m_data->m_inline;
+}
+
+// Copy the rotation matrices and origin shifts.
+void cec2013::copy_data(std::vector<double> &rotation_matrix, std::vector<double> &origin_shift) const
+{
+	rotation_matrix.assign(m_data->m_rotation_matrix,m_data->m_rotation_matrix + m_data->m_rotation_size);
+	origin_shift.assign(m_data->m_origin_shift,m_data->m_origin_shift + m_data->m_shift_size);
+}
+
+// Use a private copy of the rotation matrices and origin shifts read from an archive.
+void cec2013::set_inline_data(const std::vector<double> &rotation_matrix, const std::vector<double> &origin_shift)
+{
+	const problem::base::size_type d = get_dimension();
+	if (rotation_matrix.size() < 10 * d * d || origin_shift.size() < 10 * d) {
+		pagmo_throw(io_error, "Error: the archived CEC2013 input data is too short for the problem dimension.");
+	}
+	boost::shared_ptr<data> retval(new data);
+	retval->m_rotation_storage = rotation_matrix;
+	retval->m_shift_storage = origin_shift;
+	retval->m_rotation_matrix = &retval->m_rotation_storage[0];
+	retval->m_rotation_size = retval->m_rotation_storage.size();
+	retval->m_origin_shift = &retval->m_shift_storage[0];
+	retval->m_shift_size = retval->m_shift_storage.size();
+	retval->m_inline = true;
+	m_data = retval;
+}
+
+/// Returns the origin shift used by the problem
+/**
+ * @returns the origin shift
+ *
+ */
+std::vector<double> cec2013::origin_shift() const
+{
+	return std::vector<double>(m_data->m_origin_shift,m_data->m_origin_shift + m_data->m_shift_size);
 }
 
 /// Clone method.
@@ -108,115 +513,115 @@ void cec2013::objfun_impl(fitness_vector &f, const decision_vector &x) const
 	switch(m_problem_number)
 	{
 	case 1:
-		sphere_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		sphere_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,0);
 		f[0]+=-1400.0;
 		break;
 	case 2:
-		ellips_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		ellips_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=-1300.0;
 		break;
 	case 3:
-		bent_cigar_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		bent_cigar_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=-1200.0;
 		break;
 	case 4:
-		discus_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		discus_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=-1100.0;
 		break;
 	case 5:
-		dif_powers_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		dif_powers_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,0);
 		f[0]+=-1000.0;
 		break;
 	case 6:
-		rosenbrock_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		rosenbrock_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=-900.0;
 		break;
 	case 7:
-		schaffer_F7_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		schaffer_F7_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=-800.0;
 		break;
 	case 8:
-		ackley_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		ackley_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=-700.0;
 		break;
 	case 9:
-		weierstrass_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		weierstrass_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=-600.0;
 		break;
 	case 10:
-		griewank_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		griewank_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=-500.0;
 		break;
 	case 11:
-		rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		rastrigin_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,0);
 		f[0]+=-400.0;
 		break;
 	case 12:
-		rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		rastrigin_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=-300.0;
 		break;
 	case 13:
-		step_rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		step_rastrigin_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=-200.0;
 		break;
 	case 14:
-		schwefel_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		schwefel_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,0);
 		f[0]+=-100.0;
 		break;
 	case 15:
-		schwefel_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		schwefel_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=100.0;
 		break;
 	case 16:
-		katsuura_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		katsuura_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=200.0;
 		break;
 	case 17:
-		bi_rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		bi_rastrigin_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,0);
 		f[0]+=300.0;
 		break;
 	case 18:
-		bi_rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		bi_rastrigin_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=400.0;
 		break;
 	case 19:
-		grie_rosen_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		grie_rosen_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=500.0;
 		break;
 	case 20:
-		escaffer6_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		escaffer6_func(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=600.0;
 		break;
 	case 21:
-		cf01(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf01(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=700.0;
 		break;
 	case 22:
-		cf02(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		cf02(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,0);
 		f[0]+=800.0;
 		break;
 	case 23:
-		cf03(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf03(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=900.0;
 		break;
 	case 24:
-		cf04(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf04(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=1000.0;
 		break;
 	case 25:
-		cf05(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf05(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=1100.0;
 		break;
 	case 26:
-		cf06(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf06(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=1200.0;
 		break;
 	case 27:
-		cf07(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf07(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=1300.0;
 		break;
 	case 28:
-		cf08(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf08(&x[0],&f[0],nx,m_data->m_origin_shift,m_data->m_rotation_matrix,1);
 		f[0]+=1400.0;
 		break;
 	default:
@@ -226,6 +631,32 @@ void cec2013::objfun_impl(fitness_vector &f, const decision_vector &x) const
 
 }
 
+/// Implementation of the batch objective function.
+/**
+ * The decision vectors are packed as the columns of a matrix, so that shifts and rotations are performed
+ * as matrix-matrix products over the whole block. Functions without a batch kernel are evaluated one decision
+ * vector at a time.
+ */
+void cec2013::objfun_batch_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	// Bias of each test function, as in objfun_impl().
+	static const double bias[28] = {-1400,-1300,-1200,-1100,-1000,-900,-800,-700,-600,-500,-400,-300,-200,-100,
+		100,200,300,400,500,600,700,800,900,1000,1100,1200,1300,1400};
+	const int nx = boost::numeric_cast<int>(get_dimension());
+	cec2013_scratch &scratch = get_scratch(nx);
+	scratch.X.resize(nx,boost::numeric_cast<Eigen::MatrixXd::Index>(x.size()));
+	for (std::vector<decision_vector>::size_type j = 0; j < x.size(); ++j) {
+		scratch.X.col(j) = Eigen::Map<const Eigen::VectorXd>(&x[j][0],nx);
+	}
+	if (!batch_kernel(m_problem_number,scratch,nx,m_data->m_origin_shift,m_data->m_rotation_matrix)) {
+		base::objfun_batch_impl(f,x);
+		return;
+	}
+	for (std::vector<fitness_vector>::size_type j = 0; j < f.size(); ++j) {
+		f[j][0] = scratch.fit(j) + bias[m_problem_number - 1];
+	}
+}
+
 std::string cec2013::get_name() const
 {
 	std::string retval("CEC2013 - f");
@@ -326,33 +757,37 @@ std::string cec2013::get_name() const
 
 void cec2013::sphere_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Sphere */
 {
-	shiftfunc(x, &m_y[0], nx, Os);
+	cec2013_scratch &scratch = get_scratch(nx);
+	double *y = &scratch.y[0], *z = &scratch.z[0];
+	shiftfunc(x, y, nx, Os);
 	if (r_flag==1)
-		rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+		rotatefunc(y, z, nx, Mr);
 	else
 	for (int i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 	f[0] = 0.0;
 	for (int i=0; i<nx; i++)
 	{
-		f[0] += m_z[i]*m_z[i];
+		f[0] += z[i]*z[i];
 	}
 }
 
 void cec2013::ellips_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Ellipsoidal */
 {
 	int i;
-	shiftfunc(x, &m_y[0], nx, Os);
+	cec2013_scratch &scratch = get_scratch(nx);
+	double *y = &scratch.y[0], *z = &scratch.z[0];
+	shiftfunc(x, y, nx, Os);
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(y, z, nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
-	oszfunc (&m_z[0], &m_y[0], nx);
+		z[i]=y[i];
+	oszfunc (z, y, nx);
 	f[0] = 0.0;
 	for (i=0; i<nx; i++)
 	{
-		f[0] += pow(10.0,6.0*i/(nx-1))*m_y[i]*m_y[i];
+		f[0] += pow(10.0,6.0*i/(nx-1))*y[i]*y[i];
 	}
 }
 
@@ -360,57 +795,63 @@ void cec2013::bent_cigar_func (const double *x, double *f, int nx, const double
 {
 	int i;
 	double beta=0.5;
-	shiftfunc(x, &m_y[0], nx, Os);
+	cec2013_scratch &scratch = get_scratch(nx);
+	double *y = &scratch.y[0], *z = &scratch.z[0];
+	shiftfunc(x, y, nx, Os);
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(y, z, nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
-	asyfunc (&m_z[0], &m_y[0], nx,beta);
+		z[i]=y[i];
+	asyfunc (z, y, nx,beta);
 	if (r_flag==1)
-		rotatefunc(&m_y[0], &m_z[0], nx, &Mr[nx*nx]);
+		rotatefunc(y, z, nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
-	f[0] = m_z[0]*m_z[0];
+	f[0] = z[0]*z[0];
 	for (i=1; i<nx; i++)
 	{
-		f[0] += pow(10.0,6.0)*m_z[i]*m_z[i];
+		f[0] += pow(10.0,6.0)*z[i]*z[i];
 	}
 }
 
 void cec2013::discus_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Discus */
 {
 	int i;
-	shiftfunc(x, &m_y[0], nx, Os);
+	cec2013_scratch &scratch = get_scratch(nx);
+	double *y = &scratch.y[0], *z = &scratch.z[0];
+	shiftfunc(x, y, nx, Os);
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(y, z, nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
-	oszfunc (&m_z[0], &m_y[0], nx);
+		z[i]=y[i];
+	oszfunc (z, y, nx);
 
-	f[0] = pow(10.0,6.0)*m_y[0]*m_y[0];
+	f[0] = pow(10.0,6.0)*y[0]*y[0];
 	for (i=1; i<nx; i++)
 	{
-		f[0] += m_y[i]*m_y[i];
+		f[0] += y[i]*y[i];
 	}
 }
 
 void cec2013::dif_powers_func (const double *x, double *f, int nx, const double *Os,const double *Mr,int r_flag) const /* Different Powers */
 {
 	int i;
-	shiftfunc(x, &m_y[0], nx, Os);
+	cec2013_scratch &scratch = get_scratch(nx);
+	double *y = &scratch.y[0], *z = &scratch.z[0];
+	shiftfunc(x, y, nx, Os);
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(y, z, nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 	f[0] = 0.0;
 	for (i=0; i<nx; i++)
 	{
-		f[0] += pow(fabs(m_z[i]),2+4*i/(nx-1));
+		f[0] += pow(fabs(z[i]),2+4*i/(nx-1));
 	}
 	f[0]=pow(f[0],0.5);
 }
@@ -419,26 +860,28 @@ void cec2013::rosenbrock_func (const double *x, double *f, int nx, const double
 {
 	int i;
 	double tmp1,tmp2;
-	shiftfunc(x, &m_y[0], nx, Os);//shift
+	cec2013_scratch &scratch = get_scratch(nx);
+	double *y = &scratch.y[0], *z = &scratch.z[0];
+	shiftfunc(x, y, nx, Os);//shift
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]=m_y[i]*2.048/100;
+		y[i]=y[i]*2.048/100;
 	}
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);//rotate
+	rotatefunc(y, z, nx, Mr);//rotate
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 	for (i=0; i<nx; i++)//shift to orgin
 	{
-		m_z[i]=m_z[i]+1;
+		z[i]=z[i]+1;
 	}
 
 	f[0] = 0.0;
 	for (i=0; i<nx-1; i++)
 	{
-		tmp1=m_z[i]*m_z[i]-m_z[i+1];
-		tmp2=m_z[i]-1.0;
+		tmp1=z[i]*z[i]-z[i+1];
+		tmp2=z[i]-1.0;
 		f[0] += 100.0*tmp1*tmp1 +tmp2*tmp2;
 	}
 }
@@ -447,28 +890,30 @@ void cec2013::schaffer_F7_func (const double *x, double *f, int nx, const double
 {
 	int i;
 	double tmp;
-	shiftfunc(x, &m_y[0], nx, Os);
+	cec2013_scratch &scratch = get_scratch(nx);
+	double *y = &scratch.y[0], *z = &scratch.z[0];
+	shiftfunc(x, y, nx, Os);
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(y, z, nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
-	asyfunc (&m_z[0], &m_y[0], nx, 0.5);
+		z[i]=y[i];
+	asyfunc (z, y, nx, 0.5);
 	for (i=0; i<nx; i++)
-		m_z[i] = m_y[i]*pow(10.0,1.0*i/(nx-1)/2.0);
+		z[i] = y[i]*pow(10.0,1.0*i/(nx-1)/2.0);
 	if (r_flag==1)
-	rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx*nx]);
+	rotatefunc(z, y, nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_y[i]=m_z[i];
+		y[i]=z[i];
 
 	for (i=0; i<nx-1; i++)
-		m_z[i]=pow(m_y[i]*m_y[i]+m_y[i+1]*m_y[i+1],0.5);
+		z[i]=pow(y[i]*y[i]+y[i+1]*y[i+1],0.5);
 	f[0] = 0.0;
 	for (i=0; i<nx-1; i++)
 	{
-	  tmp=sin(50.0*pow(m_z[i],0.2));
-	  f[0] += pow(m_z[i],0.5)+pow(m_z[i],0.5)*tmp*tmp ;
+	  tmp=sin(50.0*pow(z[i],0.2));
+	  f[0] += pow(z[i],0.5)+pow(z[i],0.5)*tmp*tmp ;
 	}
 	f[0] = f[0]*f[0]/(nx-1)/(nx-1);
 }
@@ -477,29 +922,31 @@ void cec2013::ackley_func (const double *x, double *f, int nx, const double *Os,
 {
 	int i;
 	double sum1, sum2;
+	cec2013_scratch &scratch = get_scratch(nx);
+	double *y = &scratch.y[0], *z = &scratch.z[0];
 
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, y, nx, Os);
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(y, z, nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
-	asyfunc (&m_z[0], &m_y[0], nx, 0.5);
+	asyfunc (z, y, nx, 0.5);
 	for (i=0; i<nx; i++)
-		m_z[i] = m_y[i]*pow(10.0,1.0*i/(nx-1)/2.0);
+		z[i] = y[i]*pow(10.0,1.0*i/(nx-1)/2.0);
 	if (r_flag==1)
-	rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx*nx]);
+	rotatefunc(z, y, nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_y[i]=m_z[i];
+		y[i]=z[i];
 
 	sum1 = 0.0;
 	sum2 = 0.0;
 	for (i=0; i<nx; i++)
 	{
-		sum1 += m_y[i]*m_y[i];
-		sum2 += cos(2.0*boost::math::constants::pi<double>()*m_y[i]);
+		sum1 += y[i]*y[i];
+		sum2 += cos(2.0*boost::math::constants::pi<double>()*y[i]);
 	}
 	sum1 = -0.2*sqrt(sum1/nx);
 	sum2 /= nx;
@@ -510,26 +957,28 @@ void cec2013::weierstrass_func (const double *x, double *f, int nx, const double
 {
 	int i,j,k_max;
 	double sum=0,sum2=0, a, b;
+	cec2013_scratch &scratch = get_scratch(nx);
+	double *y = &scratch.y[0], *z = &scratch.z[0];
 
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, y, nx, Os);
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]=m_y[i]*0.5/100;
+		y[i]=y[i]*0.5/100;
 	}
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(y, z, nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
-	asyfunc (&m_z[0], &m_y[0], nx, 0.5);
+	asyfunc (z, y, nx, 0.5);
 	for (i=0; i<nx; i++)
-		m_z[i] = m_y[i]*pow(10.0,1.0*i/(nx-1)/2.0);
+		z[i] = y[i]*pow(10.0,1.0*i/(nx-1)/2.0);
 	if (r_flag==1)
-	rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx*nx]);
+	rotatefunc(z, y, nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_y[i]=m_z[i];
+		y[i]=z[i];
 
 	a = 0.5;
 	b = 3.0;
@@ -541,7 +990,7 @@ void cec2013::weierstrass_func (const double *x, double *f, int nx, const double
 		sum2 = 0.0;
 		for (j=0; j<=k_max; j++)
 		{
-			sum += pow(a,j)*cos(2.0*boost::math::constants::pi<double>()*pow(b,j)*(m_y[i]+0.5));
+			sum += pow(a,j)*cos(2.0*boost::math::constants::pi<double>()*pow(b,j)*(y[i]+0.5));
 			sum2 += pow(a,j)*cos(2.0*boost::math::constants::pi<double>()*pow(b,j)*0.5);
 		}
 		f[0] += sum;
@@ -553,28 +1002,30 @@ void cec2013::griewank_func (const double *x, double *f, int nx, const double *O
 {
 	int i;
 	double s, p;
+	cec2013_scratch &scratch = get_scratch(nx);
+	double *y = &scratch.y[0], *z = &scratch.z[0];
 
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, y, nx, Os);
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]=m_y[i]*600.0/100.0;
+		y[i]=y[i]*600.0/100.0;
 	}
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(y, z, nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	for (i=0; i<nx; i++)
-		m_z[i] = m_z[i]*pow(100.0,1.0*i/(nx-1)/2.0);
+		z[i] = z[i]*pow(100.0,1.0*i/(nx-1)/2.0);
 
 
 	s = 0.0;
 	p = 1.0;
 	for (i=0; i<nx; i++)
 	{
-		s += m_z[i]*m_z[i];
-		p *= cos(m_z[i]/sqrt(1.0+i));
+		s += z[i]*z[i];
+		p *= cos(z[i]/sqrt(1.0+i));
 	}
 	f[0] = 1.0 + s/4000.0 - p;
 }
@@ -583,42 +1034,44 @@ void cec2013::rastrigin_func (const double *x, double *f, int nx, const double *
 {
 	int i;
 	double alpha=10.0,beta=0.2;
-	shiftfunc(x, &m_y[0], nx, Os);
+	cec2013_scratch &scratch = get_scratch(nx);
+	double *y = &scratch.y[0], *z = &scratch.z[0];
+	shiftfunc(x, y, nx, Os);
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]=m_y[i]*5.12/100;
+		y[i]=y[i]*5.12/100;
 	}
 
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(y, z, nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
-	oszfunc (&m_z[0], &m_y[0], nx);
-	asyfunc (&m_y[0], &m_z[0], nx, beta);
+	oszfunc (z, y, nx);
+	asyfunc (y, z, nx, beta);
 
 	if (r_flag==1)
-	rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx*nx]);
+	rotatefunc(z, y, nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_y[i]=m_z[i];
+		y[i]=z[i];
 
 	for (i=0; i<nx; i++)
 	{
-		m_y[i]*=pow(alpha,1.0*i/(nx-1)/2);
+		y[i]*=pow(alpha,1.0*i/(nx-1)/2);
 	}
 
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(y, z, nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	f[0] = 0.0;
 	for (i=0; i<nx; i++)
 	{
-		f[0] += (m_z[i]*m_z[i] - 10.0*cos(2.0*boost::math::constants::pi<double>()*m_z[i]) + 10.0);
+		f[0] += (z[i]*z[i] - 10.0*cos(2.0*boost::math::constants::pi<double>()*z[i]) + 10.0);
 	}
 }
 
@@ -626,48 +1079,50 @@ void cec2013::step_rastrigin_func (const double *x, double *f, int nx, const dou
 {
 	int i;
 	double alpha=10.0,beta=0.2;
-	shiftfunc(x, &m_y[0], nx, Os);
+	cec2013_scratch &scratch = get_scratch(nx);
+	double *y = &scratch.y[0], *z = &scratch.z[0];
+	shiftfunc(x, y, nx, Os);
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]=m_y[i]*5.12/100;
+		y[i]=y[i]*5.12/100;
 	}
 
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(y, z, nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	for (i=0; i<nx; i++)
 	{
-		if (fabs(m_z[i])>0.5)
-		m_z[i]=floor(2*m_z[i]+0.5)/2;
+		if (fabs(z[i])>0.5)
+		z[i]=floor(2*z[i]+0.5)/2;
 	}
 
-	oszfunc (&m_z[0], &m_y[0], nx);
-	asyfunc (&m_y[0], &m_z[0], nx, beta);
+	oszfunc (z, y, nx);
+	asyfunc (y, z, nx, beta);
 
 	if (r_flag==1)
-	rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx*nx]);
+	rotatefunc(z, y, nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_y[i]=m_z[i];
+		y[i]=z[i];
 
 	for (i=0; i<nx; i++)
 	{
-		m_y[i]*=pow(alpha,1.0*i/(nx-1)/2);
+		y[i]*=pow(alpha,1.0*i/(nx-1)/2);
 	}
 
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(y, z, nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	f[0] = 0.0;
 	for (i=0; i<nx; i++)
 	{
-		f[0] += (m_z[i]*m_z[i] - 10.0*cos(2.0*boost::math::constants::pi<double>()*m_z[i]) + 10.0);
+		f[0] += (z[i]*z[i] - 10.0*cos(2.0*boost::math::constants::pi<double>()*z[i]) + 10.0);
 	}
 }
 
@@ -675,40 +1130,42 @@ void cec2013::schwefel_func (const double *x, double *f, int nx, const double *O
 {
 	int i;
 	double tmp;
-	shiftfunc(x, &m_y[0], nx, Os);
+	cec2013_scratch &scratch = get_scratch(nx);
+	double *y = &scratch.y[0], *z = &scratch.z[0];
+	shiftfunc(x, y, nx, Os);
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]*=1000/100;
+		y[i]*=1000/100;
 	}
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(y, z, nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	for (i=0; i<nx; i++)
-		m_y[i] = m_z[i]*pow(10.0,1.0*i/(nx-1)/2.0);
+		y[i] = z[i]*pow(10.0,1.0*i/(nx-1)/2.0);
 
 	for (i=0; i<nx; i++)
-		m_z[i] = m_y[i]+4.209687462275036e+002;
+		z[i] = y[i]+4.209687462275036e+002;
 
 	f[0]=0;
 	for (i=0; i<nx; i++)
 	{
-		if (m_z[i]>500)
+		if (z[i]>500)
 		{
-			f[0]-=(500.0-fmod(m_z[i],500))*sin(pow(500.0-fmod(m_z[i],500),0.5));
-			tmp=(m_z[i]-500.0)/100;
+			f[0]-=(500.0-fmod(z[i],500))*sin(pow(500.0-fmod(z[i],500),0.5));
+			tmp=(z[i]-500.0)/100;
 			f[0]+= tmp*tmp/nx;
 		}
-		else if (m_z[i]<-500)
+		else if (z[i]<-500)
 		{
-			f[0]-=(-500.0+fmod(fabs(m_z[i]),500))*sin(pow(500.0-fmod(fabs(m_z[i]),500),0.5));
-			tmp=(m_z[i]+500.0)/100;
+			f[0]-=(-500.0+fmod(fabs(z[i]),500))*sin(pow(500.0-fmod(fabs(z[i]),500),0.5));
+			tmp=(z[i]+500.0)/100;
 			f[0]+= tmp*tmp/nx;
 		}
 		else
-			f[0]-=m_z[i]*sin(pow(fabs(m_z[i]),0.5));
+			f[0]-=z[i]*sin(pow(fabs(z[i]),0.5));
 	}
 	f[0]=4.189828872724338e+002*nx+f[0];
 }
@@ -718,25 +1175,27 @@ void cec2013::katsuura_func (const double *x, double *f, int nx, const double *O
 	int i,j;
 	double temp,tmp1,tmp2,tmp3;
 	tmp3=pow(1.0*nx,1.2);
-	shiftfunc(x, &m_y[0], nx, Os);
+	cec2013_scratch &scratch = get_scratch(nx);
+	double *y = &scratch.y[0], *z = &scratch.z[0];
+	shiftfunc(x, y, nx, Os);
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]*=5.0/100.0;
+		y[i]*=5.0/100.0;
 	}
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(y, z, nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	for (i=0; i<nx; i++)
-		m_z[i] *=pow(100.0,1.0*i/(nx-1)/2.0);
+		z[i] *=pow(100.0,1.0*i/(nx-1)/2.0);
 
 	if (r_flag==1)
-	rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx*nx]);
+	rotatefunc(z, y, nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_y[i]=m_z[i];
+		y[i]=z[i];
 
 	f[0]=1.0;
 	for (i=0; i<nx; i++)
@@ -745,7 +1204,7 @@ void cec2013::katsuura_func (const double *x, double *f, int nx, const double *O
 		for (j=1; j<=32; j++)
 		{
 			tmp1=pow(2.0,j);
-			tmp2=tmp1*m_y[i];
+			tmp2=tmp1*y[i];
 			temp += fabs(tmp2-floor(tmp2+0.5))/tmp1;
 		}
 		f[0] *= pow(1.0+(i+1)*temp,10.0/tmp3);
@@ -763,38 +1222,40 @@ void cec2013::bi_rastrigin_func (const double *x, double *f, int nx, const doubl
 	tmpx=(double *)malloc(sizeof(double)  *  nx);
 	s=1.0-1.0/(2.0*pow(nx+20.0,0.5)-8.2);
 	mu1=-pow((mu0*mu0-d)/s,0.5);
+	cec2013_scratch &scratch = get_scratch(nx);
+	double *y = &scratch.y[0], *z = &scratch.z[0];
 
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, y, nx, Os);
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]*=10.0/100.0;
+		y[i]*=10.0/100.0;
 	}
 
 	for (i = 0; i < nx; i++)
 	{
-		tmpx[i]=2*m_y[i];
+		tmpx[i]=2*y[i];
 		if (Os[i] < 0.)
 			tmpx[i] *= -1.;
 	}
 
 	for (i=0; i<nx; i++)
 	{
-		m_z[i]=tmpx[i];
+		z[i]=tmpx[i];
 		tmpx[i] += mu0;
 	}
 	if (r_flag==1)
-		rotatefunc(&m_z[0], &m_y[0], nx, Mr);
+		rotatefunc(z, y, nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_y[i]=m_z[i];
+		y[i]=z[i];
 
 	for (i=0; i<nx; i++)
-		m_y[i] *=pow(100.0,1.0*i/(nx-1)/2.0);
+		y[i] *=pow(100.0,1.0*i/(nx-1)/2.0);
 	if (r_flag==1)
-		rotatefunc(&m_y[0], &m_z[0], nx, &Mr[nx*nx]);
+		rotatefunc(y, z, nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	tmp1=0.0;tmp2=0.0;
 	for (i=0; i<nx; i++)
@@ -809,7 +1270,7 @@ void cec2013::bi_rastrigin_func (const double *x, double *f, int nx, const doubl
 	tmp=0;
 	for (i=0; i<nx; i++)
 	{
-		tmp+=cos(2.0*boost::math::constants::pi<double>()*m_z[i]);
+		tmp+=cos(2.0*boost::math::constants::pi<double>()*z[i]);
 	}
 
 	if(tmp1<tmp2)
@@ -824,33 +1285,35 @@ void cec2013::grie_rosen_func (const double *x, double *f, int nx, const double
 {
 	int i;
 	double temp,tmp1,tmp2;
+	cec2013_scratch &scratch = get_scratch(nx);
+	double *y = &scratch.y[0], *z = &scratch.z[0];
 
-	shiftfunc(x, &m_y[0], nx, Os);
+	shiftfunc(x, y, nx, Os);
 	for (i=0; i<nx; i++)//shrink to the orginal search range
 	{
-		m_y[i]=m_y[i]*5/100;
+		y[i]=y[i]*5/100;
 	}
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(y, z, nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	for (i=0; i<nx; i++)//shift to orgin
 	{
-		m_z[i]=m_y[i]+1;
+		z[i]=y[i]+1;
 	}
 
 	f[0]=0.0;
 	for (i=0; i<nx-1; i++)
 	{
-		tmp1 = m_z[i]*m_z[i]-m_z[i+1];
-		tmp2 = m_z[i]-1.0;
+		tmp1 = z[i]*z[i]-z[i+1];
+		tmp2 = z[i]-1.0;
 		temp = 100.0*tmp1*tmp1 + tmp2*tmp2;
 		 f[0] += (temp*temp)/4000.0 - cos(temp) + 1.0;
 	}
-	tmp1 = m_z[nx-1]*m_z[nx-1]-m_z[0];
-	tmp2 = m_z[nx-1]-1.0;
+	tmp1 = z[nx-1]*z[nx-1]-z[0];
+	tmp2 = z[nx-1]-1.0;
 	temp = 100.0*tmp1*tmp1 + tmp2*tmp2;;
 	 f[0] += (temp*temp)/4000.0 - cos(temp) + 1.0 ;
 }
@@ -859,31 +1322,33 @@ void cec2013::escaffer6_func (const double *x, double *f, int nx, const double *
 {
 	int i;
 	double temp1, temp2;
-	shiftfunc(x, &m_y[0], nx, Os);
+	cec2013_scratch &scratch = get_scratch(nx);
+	double *y = &scratch.y[0], *z = &scratch.z[0];
+	shiftfunc(x, y, nx, Os);
 	if (r_flag==1)
-	rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+	rotatefunc(y, z, nx, Mr);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
-	asyfunc (&m_z[0], &m_y[0], nx, 0.5);
+	asyfunc (z, y, nx, 0.5);
 	if (r_flag==1)
-		rotatefunc(&m_y[0], &m_z[0], nx, &Mr[nx*nx]);
+		rotatefunc(y, z, nx, &Mr[nx*nx]);
 	else
 	for (i=0; i<nx; i++)
-		m_z[i]=m_y[i];
+		z[i]=y[i];
 
 	f[0] = 0.0;
 	for (i=0; i<nx-1; i++)
 	{
-		temp1 = sin(sqrt(m_z[i]*m_z[i]+m_z[i+1]*m_z[i+1]));
+		temp1 = sin(sqrt(z[i]*z[i]+z[i+1]*z[i+1]));
 		temp1 =temp1*temp1;
-		temp2 = 1.0 + 0.001*(m_z[i]*m_z[i]+m_z[i+1]*m_z[i+1]);
+		temp2 = 1.0 + 0.001*(z[i]*z[i]+z[i+1]*z[i+1]);
 		f[0] += 0.5 + (temp1-0.5)/(temp2*temp2);
 	}
-	temp1 = sin(sqrt(m_z[nx-1]*m_z[nx-1]+m_z[0]*m_z[0]));
+	temp1 = sin(sqrt(z[nx-1]*z[nx-1]+z[0]*z[0]));
 	temp1 =temp1*temp1;
-	temp2 = 1.0 + 0.001*(m_z[nx-1]*m_z[nx-1]+m_z[0]*m_z[0]);
+	temp2 = 1.0 + 0.001*(z[nx-1]*z[nx-1]+z[0]*z[0]);
 	f[0] += 0.5 + (temp1-0.5)/(temp2*temp2);
 }
 
@@ -25,7 +25,9 @@
 #ifndef PAGMO_PROBLEM_CEC2013_H
 #define PAGMO_PROBLEM_CEC2013_H
 
+#include <boost/shared_ptr.hpp>
 #include <string>
+#include <vector>
 
 #include "../serialization.h"
 #include "../types.h"
@@ -44,8 +46,20 @@ namespace pagmo{ namespace problem {
  * upon construction, it expects to find in the folder indicated by
  * the constructor argument std::string for two files named M_Dxx.txt and shift_data.txt.
  *
+ * The input data is loaded once per process: all the instances (and clones) constructed from the same folder
+ * and dimension share a single read-only copy of it. If the folder contains a binary data file named
+ * cec2013_Dxx.bin (see write_binary_data()), it is memory-mapped instead of parsing the text files. When
+ * serialized, only the folder and the dimension are stored, and the data is loaded again upon deserialization:
+ * the input files must thus be available wherever the problem is deserialized. Archives written before the data
+ * was shared, which hold a copy of it, can still be loaded: the instance then keeps its own copy.
+ *
  * NOTE 2: all problems are unconstrained continuous single objective problems.
  *
+ * NOTE 3: the scratch space used during evaluation is thread-local, so that the same instance can be evaluated
+ * concurrently. Blocks of decision vectors passed to objfun_batch() are shifted and rotated with one matrix-matrix
+ * product per transformation stage for the basic functions (f1-f6, f8, f10-f12, f14-f15). The remaining functions
+ * are evaluated one decision vector at a time.
+ *
  * @see http://www.ntu.edu.sg/home/EPNSugan/index_files/CEC2013/CEC2013.htm
  *
  * @author Dario Izzo (dario.izzo@gmail.com)
@@ -65,10 +79,12 @@ class __PAGMO_VISIBLE cec2013 : public base
 		 * @returns the origin shift
 		 *
 		 */
-		std::vector<double> origin_shift() const {return m_origin_shift;}
+		std::vector<double> origin_shift() const;
 		//@}
+		static void write_binary_data(const std::string &, problem::base::size_type);
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
+		void objfun_batch_impl(std::vector<fitness_vector> &, const std::vector<decision_vector> &) const;
 	private:
 		void sphere_func (const double *, double *, int , const double *,const double *, int) const; /* Sphere */
 		void ellips_func(const double *, double *, int , const double *,const double *, int) const; /* Ellipsoidal */
@@ -101,26 +117,67 @@ class __PAGMO_VISIBLE cec2013 : public base
 		void oszfunc (const double *, double *, int) const;
 		void cf_cal(const double *, double *, int, const double *,double *,double *,double *,int) const;
 
+		// Read-only input data, shared by all the instances using the same files.
+		struct data;
+		typedef boost::shared_ptr<const data> data_ptr;
+		static data_ptr get_data(const std::string &, problem::base::size_type);
+		static data_ptr read_text_data(const std::string &, problem::base::size_type);
+		static data_ptr map_binary_data(const std::string &, problem::base::size_type);
+		bool has_inline_data() const;
+		void copy_data(std::vector<double> &, std::vector<double> &) const;
+		void set_inline_data(const std::vector<double> &, const std::vector<double> &);
+
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void save(Archive &ar, const unsigned int) const
 		{
-			ar & boost::serialization::base_object<base>(*this);
-			ar & const_cast<unsigned int&>(m_problem_number);
-			ar & m_rotation_matrix;
-			ar & m_origin_shift;
+			ar << boost::serialization::base_object<base>(*this);
+			ar << m_problem_number;
+			ar << m_dir;
+			// Data read from an archive of version 0 has no input files to be loaded from, and is stored inline.
+			const bool inline_data = has_inline_data();
+			ar << inline_data;
+			if (inline_data) {
+				std::vector<double> rotation_matrix, origin_shift;
+				copy_data(rotation_matrix,origin_shift);
+				ar << rotation_matrix;
+				ar << origin_shift;
+			}
 		}
+		template <class Archive>
+		void load(Archive &ar, const unsigned int version)
+		{
+			ar >> boost::serialization::base_object<base>(*this);
+			ar >> const_cast<unsigned int&>(m_problem_number);
+			if (version == 0) {
+				// Version 0 stored a copy of the input data in place of the folder.
+				std::vector<double> rotation_matrix, origin_shift;
+				ar >> rotation_matrix;
+				ar >> origin_shift;
+				set_inline_data(rotation_matrix,origin_shift);
+				return;
+			}
+			ar >> m_dir;
+			bool inline_data;
+			ar >> inline_data;
+			if (inline_data) {
+				std::vector<double> rotation_matrix, origin_shift;
+				ar >> rotation_matrix;
+				ar >> origin_shift;
+				set_inline_data(rotation_matrix,origin_shift);
+			} else {
+				m_data = get_data(m_dir,get_dimension());
+			}
+		}
+		BOOST_SERIALIZATION_SPLIT_MEMBER()
 	const unsigned int m_problem_number;
-	std::vector<double> m_rotation_matrix;
-	std::vector<double> m_origin_shift;
-
-	// These are pre-allocated for speed, need not to be serialized
-	mutable std::vector<double> m_y;
-	mutable std::vector<double> m_z;
+	std::string m_dir;
+	data_ptr m_data;
 };
 
 }} //namespaces
 
 BOOST_CLASS_EXPORT_KEY(pagmo::problem::cec2013)
+BOOST_CLASS_VERSION(pagmo::problem::cec2013,1)
 
 #endif
@@ -23,8 +23,10 @@
  *****************************************************************************/
 
 #include <boost/math/constants/constants.hpp>
+#include <boost/numeric/conversion/cast.hpp>
 #include <cmath>
 
+#include "../Eigen/Core"
 #include "../exceptions.h"
 #include "../types.h"
 #include "base.h"
@@ -59,10 +61,10 @@ void griewank::objfun_impl(fitness_vector &f, const decision_vector &x) const
 	pagmo_assert(f.size() == 1);
 	decision_vector::size_type n = x.size();
 	double fr=4000.0;
-	double retval = 0.0;
+	const Eigen::Map<const Eigen::ArrayXd> xa(&x[0],boost::numeric_cast<Eigen::ArrayXd::Index>(n));
+	double retval = xa.square().sum();
 	double p = 1.0;
 
-	for (decision_vector::size_type i=0; i<n; i++){ retval += x[i]*x[i];}
 	for (decision_vector::size_type i=0; i<n; i++){ p *= cos(x[i]/sqrt(i+1.0));}
 	f[0] = (retval/fr - p + 1);
 }
@@ -22,6 +22,10 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <vector>
+
 #include "../population.h"
 #include "../rng.h"
 #include "../types.h"
@@ -42,8 +46,58 @@ base_ptr inventory::clone() const
 	return base_ptr(new inventory(*this));
 }
 
+// Cost of a chunk of scenarios, whose demands are taken either from a Sobol' block or from the streams of the trials.
+struct inventory::scenario_costs: base_stochastic::trials_task
+{
+	scenario_costs(const inventory *p, const decision_vector *x_, const std::vector<double> *u_, std::vector<double> *costs_):
+		prob(p),x(x_),u(u_),costs(costs_) {}
+	void operator()(unsigned int, unsigned int first, unsigned int n) const
+	{
+		const double c=1.0,b=1.5,h=0.1;
+		const decision_vector::size_type weeks = x->size();
+		std::vector<double> d(weeks);
+		boost::random::uniform_real_distribution<double> uniform(0.,1.);
+		for (unsigned int i = first; i < first + n; ++i) {
+			if (u->empty()) {
+				trial_rng_type trng(prob->get_trial_seed(i,*x));
+				for (decision_vector::size_type j = 0; j<weeks; ++j) {
+					d[j] = uniform(trng) * 100;
+				}
+			} else {
+				for (decision_vector::size_type j = 0; j<weeks; ++j) {
+					d[j] = (*u)[i * weeks + j] * 100;
+				}
+			}
+			double I=0, retval=0;
+			for (decision_vector::size_type j = 0; j<weeks; ++j) {
+				retval += c * (*x)[j] + b * std::max<double>(d[j]-I-(*x)[j],0) + h * std::max<double>(I+(*x)[j]-d[j],0);
+				I = std::max<double>(0, I + (*x)[j] - d[j]);
+			}
+			(*costs)[i] = retval;
+		}
+	}
+	const inventory *prob;
+	const decision_vector *x;
+	const std::vector<double> *u;
+	std::vector<double> *costs;
+};
+
 void inventory::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
+	if (m_sampling != SERIAL) {
+		const unsigned int n = boost::numeric_cast<unsigned int>(m_sample_size);
+		std::vector<double> u, costs(n);
+		if (m_sampling == SOBOL) {
+			get_sobol_block(u,n,boost::numeric_cast<unsigned int>(x.size()),x);
+		}
+		run_trials(n,scenario_costs(this,&x,&u,&costs));
+		double retval=0;
+		for (unsigned int i = 0; i < n; ++i) {
+			retval += costs[i];
+		}
+		f[0] = retval / m_sample_size;
+		return;
+	}
 	m_drng.seed(m_seed);
 	const double c=1.0,b=1.5,h=0.1;
 	double retval=0;
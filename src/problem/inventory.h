@@ -58,6 +58,10 @@ namespace problem {
  *	J(\mathbf x, \mathbf d) = c \sum_{i=1}^N x_i+ b \sum_{i=1}^N [d_i - I_i - x_i]_+ + h \sum_{i=1}^N [I_i + x_i - d_i]_+
  * \f]
  *
+ * The weekly demands are uniformly distributed in [0,100]. In the PARALLEL and SOBOL schemes of
+ * base_stochastic::set_sampling(), the scenarios are split among threads, and the demands of each scenario
+ * are drawn from its own stream or from a scrambled Sobol' sequence.
+ *
  * @see www2.isye.gatech.edu/people/faculty/Alex_Shapiro/SPbook.pdf
  *
  * @author Dario Izzo (dario.izzo@esa.int)
@@ -85,6 +89,8 @@ class __PAGMO_VISIBLE inventory: public base_stochastic
 		std::string human_readable_extra() const;
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 	private:
+		struct scenario_costs;
+
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
@@ -22,9 +22,13 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
-#include <boost/math/constants/constants.hpp>
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <limits>
+#include <sstream>
 #include <string>
+#include <typeinfo>
 #include <vector>
 
 #include "../exceptions.h"
@@ -39,14 +43,18 @@ namespace pagmo { namespace problem {
  * Will construct a Lennard-Jones problem
  *
  * @param[in] atoms number of atoms
+ * @param[in] cutoff cutoff radius of the potential (zero for the exact potential)
  *
  * @see problem::base constructors.
  */
-lennard_jones::lennard_jones(int atoms):base(3*atoms-6)
+lennard_jones::lennard_jones(int atoms, double cutoff):base(3*atoms-6),m_cutoff(cutoff)
 {
 	if (atoms <= 0 || atoms < 3) {
 		pagmo_throw(value_error,"number of atoms for lennard-jones problem must be positive and greater than 2");
 	}
+	if (!(cutoff >= 0)) {
+		pagmo_throw(value_error,"cutoff radius for lennard-jones problem must be non-negative");
+	}
 	for (int i = 0; i < 3*atoms-6; i++) {
 		if ( (i != 0) && (i % 3) == 0 ) {
 			set_lb(i,0.0);
@@ -64,50 +72,185 @@ base_ptr lennard_jones::clone() const
 	return base_ptr(new lennard_jones(*this));
 }
 
-/// Helper function that transforms the decision vector x in atoms positions r
-double lennard_jones::r(const int& atom, const int& coord, const std::vector<double>& x) {
-	if(atom == 0) { //x1,y1,z1 fixed
-		return 0.0;
-	} else if(atom == 1) {
-		if(coord < 2) { //x2,y2    fixed
-			return 0.0;
-		} else { //z2 is a variable
-			return x[0];
+// Pair energies (divided by 4) between the atom at (xi,yi,zi) and the n atoms whose coordinates are in px,py,pz,
+// for the pairs closer than sqrt(rc2). The loop is free of branches, so that it can be vectorised. If Grad is true,
+// the gradient is added to gi (for the first atom) and to gx,gy,gz (for the others). Overlapping atoms are counted
+// in overlaps and left out.
+template <bool Grad>
+static double pair_energies(double xi, double yi, double zi, const double *px, const double *py, const double *pz, std::size_t n,
+	double rc2, double shift, double *gi, double *gx, double *gy, double *gz, std::size_t &overlaps)
+{
+	double e = 0, gxi = 0, gyi = 0, gzi = 0;
+	std::size_t zeros = 0;
+	for (std::size_t j = 0; j < n; ++j) {
+		const double dx = xi - px[j], dy = yi - py[j], dz = zi - pz[j];
+		const double r2 = dx * dx + dy * dy + dz * dz;
+		const bool in = (r2 > 0.) & (r2 < rc2);
+		zeros += (r2 == 0.);
+		const double inv2 = 1. / (in ? r2 : 1.);
+		const double sixth = in ? inv2 * inv2 * inv2 : 0.;	//rij^-6
+		e += sixth * sixth - sixth - (in ? shift : 0.);
+		if (Grad) {
+			const double c = -24. * inv2 * sixth * (2. * sixth - 1.);
+			gxi += c * dx;
+			gyi += c * dy;
+			gzi += c * dz;
+			gx[j] -= c * dx;
+			gy[j] -= c * dy;
+			gz[j] -= c * dz;
 		}
-	} else if(atom == 2) {
-		if(coord == 0) { //x3	   fixed
-			return 0.0;
-		} else { //y3 and x3 are variables
-			return x[coord];
+	}
+	if (Grad) {
+		gi[0] += gxi;
+		gi[1] += gyi;
+		gi[2] += gzi;
+	}
+	overlaps += zeros;
+	return e;
+}
+
+// Pairs between atom i and the atoms [begin,end) of the structure-of-arrays coordinates p (and gradient g) of n atoms.
+static double row(const std::vector<double> &p, std::vector<double> *g, std::size_t n, std::size_t i, std::size_t begin, std::size_t end,
+	double rc2, double shift, std::size_t &overlaps)
+{
+	const double *px = &p[0], *py = px + n, *pz = py + n;
+	if (!g) {
+		return pair_energies<false>(px[i],py[i],pz[i],px + begin,py + begin,pz + begin,end - begin,rc2,shift,0,0,0,0,overlaps);
+	}
+	double *gx = &(*g)[0], *gy = gx + n, *gz = gy + n;
+	double gi[3] = {0,0,0};
+	const double e = pair_energies<true>(px[i],py[i],pz[i],px + begin,py + begin,pz + begin,end - begin,rc2,shift,gi,gx + begin,gy + begin,gz + begin,overlaps);
+	gx[i] += gi[0];
+	gy[i] += gi[1];
+	gz[i] += gi[2];
+	return e;
+}
+
+// Energy of the cluster at x, and its gradient with respect to x if g is not null.
+double lennard_jones::energy(const decision_vector &x, decision_vector *g) const
+{
+	const std::size_t atoms = (x.size() + 6) / 3;
+	// Transform the decision vector x in atoms positions, stored in structure-of-arrays layout
+	// (x1,y1,z1 fixed, x2,y2 fixed, x3 fixed).
+	std::vector<double> p(3 * atoms,0.);
+	p[2 * atoms + 1] = x[0];
+	p[atoms + 2] = x[1];
+	p[2 * atoms + 2] = x[2];
+	for (std::size_t a = 3; a < atoms; ++a) {
+		for (std::size_t c = 0; c < 3; ++c) {
+			p[c * atoms + a] = x[3 * (a - 2) + c];
+		}
+	}
+	std::vector<double> gp(g ? 3 * atoms : 0,0.);
+	std::size_t overlaps = 0;
+	double e = 0;
+
+	if (m_cutoff == 0) {
+		for (std::size_t i = 0; i + 1 < atoms; ++i) {
+			e += row(p,g ? &gp : 0,atoms,i,i + 1,atoms,std::numeric_limits<double>::max(),0.,overlaps);
 		}
 	} else {
-		return x[3 * (atom - 2) + coord];
+		const double rc2 = m_cutoff * m_cutoff, sixth_c = 1. / (rc2 * rc2 * rc2), shift = sixth_c * sixth_c - sixth_c;
+		// Grid of cells of side at least the cutoff radius over the bounding box of the cluster.
+		std::size_t nc[3];
+		double lo[3], side[3];
+		for (std::size_t c = 0; c < 3; ++c) {
+			const double *pc = &p[c * atoms];
+			lo[c] = *std::min_element(pc,pc + atoms);
+			const double extent = *std::max_element(pc,pc + atoms) - lo[c];
+			nc[c] = std::max<std::size_t>(1,std::min<std::size_t>(32,static_cast<std::size_t>(extent / m_cutoff)));
+			side[c] = extent / nc[c];
+		}
+		std::vector<std::size_t> cell(atoms), start(nc[0] * nc[1] * nc[2] + 1,0), order(atoms);
+		for (std::size_t a = 0; a < atoms; ++a) {
+			std::size_t idx[3];
+			for (std::size_t c = 0; c < 3; ++c) {
+				idx[c] = (nc[c] == 1) ? 0 : std::min(nc[c] - 1,static_cast<std::size_t>((p[c * atoms + a] - lo[c]) / side[c]));
+			}
+			cell[a] = (idx[0] * nc[1] + idx[1]) * nc[2] + idx[2];
+			++start[cell[a] + 1];
+		}
+		for (std::size_t k = 1; k < start.size(); ++k) {
+			start[k] += start[k - 1];
+		}
+		// Sort the atoms by cell, so that the atoms of each cell are contiguous.
+		std::vector<std::size_t> fill(start.begin(),start.end() - 1);
+		for (std::size_t a = 0; a < atoms; ++a) {
+			order[fill[cell[a]]++] = a;
+		}
+		std::vector<double> sp(3 * atoms), sgp(g ? 3 * atoms : 0,0.);
+		for (std::size_t k = 0; k < atoms; ++k) {
+			for (std::size_t c = 0; c < 3; ++c) {
+				sp[c * atoms + k] = p[c * atoms + order[k]];
+			}
+		}
+		// Each pair of neighbouring cells is visited once, from the cell with the lower index.
+		for (std::size_t ix = 0; ix < nc[0]; ++ix) {
+			for (std::size_t iy = 0; iy < nc[1]; ++iy) {
+				for (std::size_t iz = 0; iz < nc[2]; ++iz) {
+					const std::size_t k = (ix * nc[1] + iy) * nc[2] + iz;
+					for (std::size_t i = start[k]; i < start[k + 1]; ++i) {
+						e += row(sp,g ? &sgp : 0,atoms,i,i + 1,start[k + 1],rc2,shift,overlaps);
+						for (int dx = -1; dx <= 1; ++dx) {
+							for (int dy = -1; dy <= 1; ++dy) {
+								for (int dz = -1; dz <= 1; ++dz) {
+									const std::size_t jx = ix + dx, jy = iy + dy, jz = iz + dz;
+									if (jx >= nc[0] || jy >= nc[1] || jz >= nc[2]) {
+										continue;
+									}
+									const std::size_t l = (jx * nc[1] + jy) * nc[2] + jz;
+									if (l > k) {
+										e += row(sp,g ? &sgp : 0,atoms,i,start[l],start[l + 1],rc2,shift,overlaps);
+									}
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+		if (g) {
+			for (std::size_t k = 0; k < atoms; ++k) {
+				for (std::size_t c = 0; c < 3; ++c) {
+					gp[c * atoms + order[k]] = sgp[c * atoms + k];
+				}
+			}
+		}
+	}
+
+	if (g) {
+		(*g)[0] = gp[2 * atoms + 1];
+		(*g)[1] = gp[atoms + 2];
+		(*g)[2] = gp[2 * atoms + 2];
+		for (std::size_t a = 3; a < atoms; ++a) {
+			for (std::size_t c = 0; c < 3; ++c) {
+				(*g)[3 * (a - 2) + c] = gp[c * atoms + a];
+			}
+		}
+	}
+	if (overlaps) {
+		e = 1e+20;	//penalty
 	}
+	return 4 * e;
 }
 
 /// Implementation of the objective function.
 void lennard_jones::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	pagmo_assert(f.size() == 1);
-	std::vector<double>::size_type n = x.size();
-	int atoms = (n + 6) / 3;
-	double sixth, dist;
-
-	f[0] = 0;
-	//We evaluate the potential
-	for ( int i=0; i<(atoms-1); i++ ) {
-		for ( int j=(i+1); j<atoms; j++ ) {
-			dist = pow(r(i, 0, x) - r(j, 0, x), 2) + pow(r(i, 1, x) - r(j, 1, x), 2) + pow(r(i, 2, x) - r(j, 2, x), 2);  //rij^2
-			if ( dist == 0.0 ) {
-				f[0] = 1e+20;	//penalty
-			}
-			else {
-				sixth = pow(dist, -3);	//rij^-6
-				f[0] += (pow(sixth, 2) - sixth);
-			}
-		}
-	}
-	f[0] = 4 * f[0];
+	f[0] = energy(x,0);
+}
+
+/// Exact gradient of the objective function.
+/**
+ * Pairs of overlapping atoms do not contribute to the gradient.
+ *
+ * @param[out] g gradient of the objective function at x.
+ * @param[in] x decision vector.
+ */
+void lennard_jones::objfun_gradient_impl(decision_vector &g, const decision_vector &x) const
+{
+	energy(x,&g);
 }
 
 std::string lennard_jones::get_name() const
@@ -115,6 +258,31 @@ std::string lennard_jones::get_name() const
 	return "Lennard-Jones";
 }
 
+/// Return the cutoff radius (zero if the potential is exact).
+double lennard_jones::get_cutoff() const
+{
+	return m_cutoff;
+}
+
+/// Extra human readable info for the problem.
+/**
+ * Will return a formatted string containing the cutoff radius, if any.
+ */
+std::string lennard_jones::human_readable_extra() const
+{
+	std::ostringstream oss;
+	if (m_cutoff > 0) {
+		oss << "\n\tCutoff radius: " << m_cutoff << '\n';
+	}
+	return oss.str();
+}
+
+bool lennard_jones::equality_operator_extra(const base &other) const
+{
+	pagmo_assert(typeid(*this) == typeid(other));
+	return (m_cutoff == dynamic_cast<lennard_jones const &>(other).m_cutoff);
+}
+
 }}//namespaces
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::lennard_jones)
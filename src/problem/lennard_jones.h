@@ -43,6 +43,12 @@ namespace pagmo{ namespace problem {
  * atoms, the global optima will be different. In the link below a database containing all
  * putative global optima is given.
  *
+ * The pair energies are computed by a kernel running over the coordinates of the atoms in structure-of-arrays
+ * layout, and the exact gradient is provided (see problem::base::objfun_gradient()), for the benefit of the
+ * gradient-based local solvers. For large clusters a cutoff radius can be set: the potential is then truncated
+ * and shifted, so that it stays continuous, and only the pairs of atoms in neighbouring cells of a grid of side
+ * the cutoff radius are visited.
+ *
  * @see http://physchem.ox.ac.uk/~doye/jon/structures/LJ/tables.150.html
  * @author Dario Izzo (dario.izzo@esa.int)
  */
@@ -50,23 +56,36 @@ namespace pagmo{ namespace problem {
 class __PAGMO_VISIBLE lennard_jones : public base
 {
 	public:
-		lennard_jones(int = 3);
+		lennard_jones(int = 3, double = 0);
 		base_ptr clone() const;
 		std::string get_name() const;
+		double get_cutoff() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
+		void objfun_gradient_impl(decision_vector &, const decision_vector &) const;
+		std::string human_readable_extra() const;
+		bool equality_operator_extra(const base &) const;
 	private:
-		static double r(const int& atom, const int& coord, const std::vector <double>& x);
+		double energy(const decision_vector &, decision_vector *) const;
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void serialize(Archive &ar, const unsigned int version)
 		{
 			ar & boost::serialization::base_object<base>(*this);
+			// The cutoff was added in version 1.
+			if (version >= 1) {
+				ar & const_cast<double &>(m_cutoff);
+			} else {
+				const_cast<double &>(m_cutoff) = 0;
+			}
 		}
+		// Cutoff radius (zero for none).
+		const double m_cutoff;
 };
 
 }} //namespaces
 
 BOOST_CLASS_EXPORT_KEY(pagmo::problem::lennard_jones)
+BOOST_CLASS_VERSION(pagmo::problem::lennard_jones,1)
 
 #endif // PAGMO_PROBLEM_LENNARD_JONES_H
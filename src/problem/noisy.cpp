@@ -22,9 +22,14 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <vector>
 #include <boost/functional/hash.hpp>
+#include <boost/math/special_functions/erf.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
 
 #include "../exceptions.h"
 #include "../types.h"
@@ -129,6 +134,16 @@ double noisy::get_param_second() const
 /// Add noises to the computed fitness vector.
 void noisy::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
+	if (m_sampling != SERIAL) {
+		// The noise is additive: the original problem needs to be evaluated only once.
+		std::vector<fitness_vector> tmp;
+		m_original_problem->objfun_batch(tmp,std::vector<decision_vector>(1,x));
+		average_noise(f,x);
+		for (fitness_vector::size_type i=0; i<f.size();++i) {
+			f[i] += tmp[0][i];
+		}
+		return;
+	}
 	//1 - Initialize a temporary fitness vector storing one trial result
 	//and we use it also to init the return value 
 	fitness_vector tmp(f.size(),0.0);
@@ -149,6 +164,15 @@ void noisy::objfun_impl(fitness_vector &f, const decision_vector &x) const
 /// Add noises to the computed constraint vector.
 void noisy::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
 {
+	if (m_sampling != SERIAL) {
+		constraint_vector tmp(c.size(),0.0);
+		m_original_problem->compute_constraints(tmp, x);
+		average_noise(c,x);
+		for (constraint_vector::size_type i=0; i<c.size();++i) {
+			c[i] += tmp[i];
+		}
+		return;
+	}
 	//1 - Initialize a temporary constraint vector storing one trial result
 	//and we use it also to init the return value 
 	constraint_vector tmp(c.size(),0.0);
@@ -191,6 +215,42 @@ void noisy::inject_noise_c(constraint_vector& c) const
 	}
 }
 
+// Average of the noise over the trials in the PARALLEL and SOBOL schemes. The noise of each trial is drawn from
+// its own stream or, in the SOBOL scheme, by inverting the cumulative distribution function of the noise.
+void noisy::average_noise(std::vector<double> &noise, const decision_vector &x) const
+{
+	const std::vector<double>::size_type k = noise.size();
+	std::fill(noise.begin(),noise.end(),0.);
+	std::vector<double> u;
+	if (m_sampling == SOBOL && k) {
+		get_sobol_block(u,m_trials,boost::numeric_cast<unsigned int>(k),x);
+	} else {
+		u.resize(m_trials * k);
+		boost::random::uniform_real_distribution<double> uniform(0.,1.);
+		boost::random::normal_distribution<double> normal(0.,1.);
+		for (unsigned int j=0; j< m_trials; ++j) {
+			trial_rng_type trng(get_trial_seed(j,x));
+			for (std::vector<double>::size_type i=0; i<k; ++i) {
+				// Store directly the standardised noise, see below.
+				u[j * k + i] = (m_noise_type == NORMAL) ? normal(trng) : uniform(trng);
+			}
+		}
+	}
+	for (unsigned int j=0; j< m_trials; ++j) {
+		for (std::vector<double>::size_type i=0; i<k; ++i) {
+			double z = u[j * k + i];
+			if (m_noise_type == NORMAL) {
+				if (m_sampling == SOBOL) {
+					z = std::sqrt(2.) * boost::math::erf_inv(2. * z - 1.);
+				}
+				noise[i] += (z*m_param_second+m_param_first) / (double)m_trials;
+			} else {
+				noise[i] += (z*(m_param_second-m_param_first)+m_param_first) / (double)m_trials;
+			}
+		}
+	}
+}
+
 std::string noisy::get_name() const
 {
 	return m_original_problem->get_name() + " [Noisy]"; 
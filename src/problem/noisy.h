@@ -26,6 +26,7 @@
 #define PAGMO_PROBLEM_NOISY_H
 
 #include <string>
+#include <vector>
 #include <boost/functional/hash.hpp>
 #include <boost/random/normal_distribution.hpp>
 #include <boost/random/uniform_real_distribution.hpp>
@@ -49,6 +50,9 @@ namespace pagmo{ namespace problem {
  * NOTE: for m_trials->infinity one recovers a deterministic problem, but the objective function computation
  * soon becomes very expensive. The trade-off is to keep m_trials small, while being able to get good convergence. 
  *
+ * In the PARALLEL and SOBOL schemes of base_stochastic::set_sampling(), the original problem is evaluated once,
+ * bypassing its cache, and the noise of each trial is drawn from its own stream or from a scrambled Sobol' sequence.
+ *
  * @author Yung-Siang Liau (liauys@gmail.com)
  * @author Dario Izzo (dario.izzo@gmail.com)
  */
@@ -86,6 +90,7 @@ class __PAGMO_VISIBLE noisy : public base_stochastic
 	private:
 		void inject_noise_f(fitness_vector&) const;
 		void inject_noise_c(constraint_vector&) const;
+		void average_noise(std::vector<double> &, const decision_vector &) const;
 
 		friend class boost::serialization::access;
 		template <class Archive>
@@ -83,20 +83,26 @@ decision_vector normalized::denormalize(const decision_vector& x) const
 	return retval;
 }
 
+/// The de-normalization as an affine transformation: diagonal scaling plus translation
+bool normalized::get_affine_transform(affine_transform &t) const
+{
+	t.m_d = Eigen::Map<const Eigen::VectorXd>(&m_normalization_scale[0],m_normalization_scale.size());
+	t.m_b = Eigen::Map<const Eigen::VectorXd>(&m_normalization_center[0],m_normalization_center.size());
+	return true;
+}
+
 /// Implementation of the objective function.
-/// (Wraps over the original implementation with translated input x)
+/// (Wraps over the original implementation with de-normalized input x, fused with the other affine meta-problems)
 void normalized::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	decision_vector x_original = denormalize(x);
-	m_original_problem->objfun(f, x_original);
+	fused_objfun(f, x);
 }
 
 /// Implementation of the constraints computation.
-/// (Wraps over the original implementation with translated input x)
+/// (Wraps over the original implementation with de-normalized input x, fused with the other affine meta-problems)
 void normalized::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
 {
-	decision_vector x_original = denormalize(x);
-	m_original_problem->compute_constraints(c, x_original);
+	fused_compute_constraints(c, x);
 }
 
 
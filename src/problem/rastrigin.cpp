@@ -23,9 +23,11 @@
  *****************************************************************************/
 
 #include <boost/math/constants/constants.hpp>
+#include <boost/numeric/conversion/cast.hpp>
 #include <cmath>
 #include <string>
 
+#include "../Eigen/Core"
 #include "../exceptions.h"
 #include "../types.h"
 #include "base.h"
@@ -59,11 +61,10 @@ void rastrigin::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	pagmo_assert(f.size() == 1);
 	const double omega = 2.0 * boost::math::constants::pi<double>();
-	f[0] = 0;
 	const decision_vector::size_type n = x.size();
-	for (decision_vector::size_type i = 0; i < n; ++i) {
-		f[0] += x[i] * x[i] - 10.0 * std::cos(omega * x[i]);
-	}
+	// Vectorised sum over the components of x.
+	const Eigen::Map<const Eigen::ArrayXd> xa(&x[0],boost::numeric_cast<Eigen::ArrayXd::Index>(n));
+	f[0] = (xa.square() - 10.0 * (omega * xa).cos()).sum();
 	f[0] += 10.0 * n;
 }
 
@@ -22,9 +22,14 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <vector>
 #include <boost/functional/hash.hpp>
+#include <boost/math/special_functions/erf.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
 
 #include "../exceptions.h"
 #include "../types.h"
@@ -98,10 +103,59 @@ double robust::get_rho() const
 	return m_rho;
 }
 
+// Evaluates a chunk of perturbed decision vectors. The first chunk runs on the original problem, the others on the
+// copies kept in m_trial_problems.
+struct robust::objfun_trials: base_stochastic::trials_task
+{
+	objfun_trials(const robust *p, const std::vector<decision_vector> *x, std::vector<fitness_vector> *f):prob(p),xs(x),fs(f) {}
+	void operator()(unsigned int chunk, unsigned int first, unsigned int n) const
+	{
+		const std::vector<decision_vector> chunk_xs(xs->begin() + first, xs->begin() + first + n);
+		std::vector<fitness_vector> tmp;
+		if (chunk == 0) {
+			prob->m_original_problem->objfun_batch(tmp,chunk_xs);
+		} else {
+			prob->m_trial_problems[chunk - 1]->objfun_batch(tmp,chunk_xs);
+		}
+		std::copy(tmp.begin(),tmp.end(),fs->begin() + first);
+	}
+	const robust *prob;
+	const std::vector<decision_vector> *xs;
+	std::vector<fitness_vector> *fs;
+};
+
 /// Implementation of the objective function.
 /// Add noises to the decision vector before calling the actual objective function.
 void robust::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
+	if (m_sampling != SERIAL) {
+		std::vector<decision_vector> xs;
+		get_trial_points(xs,x);
+		std::vector<fitness_vector> fs(m_trials);
+		// The copies of the original problem are made once and kept across calls. The evaluations performed on
+		// them are added back to the counter of the original problem.
+		const unsigned int n_chunks = get_trial_chunks(m_trials);
+		while (m_trial_problems.size() + 1 < n_chunks) {
+			m_trial_problems.push_back(m_original_problem->clone());
+		}
+		std::vector<unsigned int> fevals(m_trial_problems.size());
+		for (std::vector<base_ptr>::size_type i = 0; i < m_trial_problems.size(); ++i) {
+			fevals[i] = m_trial_problems[i]->get_fevals();
+		}
+		const objfun_trials task(this,&xs,&fs);
+		run_trials(m_trials,task);
+		for (std::vector<base_ptr>::size_type i = 0; i < m_trial_problems.size(); ++i) {
+			m_original_problem->m_fevals += m_trial_problems[i]->get_fevals() - fevals[i];
+		}
+		std::fill(f.begin(),f.end(),0.);
+		for(unsigned int i = 0; i < m_trials; ++i){
+			for(fitness_vector::size_type j = 0; j < f.size(); ++j){
+				f[j] += fs[i][j] / (double)m_trials;
+			}
+		}
+		return;
+	}
+
 	// Temporary storage used for averaging
 	fitness_vector tmp(f.size(),0.0);
 	f = tmp;
@@ -124,6 +178,20 @@ void robust::objfun_impl(fitness_vector &f, const decision_vector &x) const
 /// Add noises to the decision vector before calling the actual constraint function.
 void robust::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
 {
+	if (m_sampling != SERIAL) {
+		std::vector<decision_vector> xs;
+		get_trial_points(xs,x);
+		constraint_vector tmp(c.size(), 0.0);
+		std::fill(c.begin(),c.end(),0.);
+		for(unsigned int i = 0; i < m_trials; ++i){
+			m_original_problem->compute_constraints(tmp, xs[i]);
+			for(constraint_vector::size_type j = 0; j < c.size(); ++j){
+				c[j] += tmp[j] / (double)m_trials;
+			}
+		}
+		return;
+	}
+
 	// Temporary storage used for averaging
 	constraint_vector tmp(c.size(), 0.0);
 	c = tmp;
@@ -172,6 +240,46 @@ void robust::inject_noise_x(decision_vector &x) const
 	}
 }
 
+// Perturbed decision vectors of all trials in the PARALLEL and SOBOL schemes. Each one is drawn uniformly in the
+// ball of radius rho centred on x (and clipped to the bounds) from the samples of its own trial: the radius from
+// a uniform sample, the direction from dim normal samples (obtained, in the SOBOL scheme, by inverting the normal
+// cumulative distribution function).
+void robust::get_trial_points(std::vector<decision_vector> &xs, const decision_vector &x) const
+{
+	const size_type n = x.size();
+	xs.assign(m_trials,x);
+	std::vector<double> u, z(n);
+	if (m_sampling == SOBOL) {
+		get_sobol_block(u,m_trials,boost::numeric_cast<unsigned int>(n + 1),x);
+	}
+	for(unsigned int i = 0; i < m_trials; ++i){
+		double u_radius;
+		if (m_sampling == SOBOL) {
+			const double *row = &u[i * (n + 1)];
+			u_radius = row[0];
+			for(size_type j = 0; j < n; ++j){
+				z[j] = std::sqrt(2.) * boost::math::erf_inv(2. * row[j + 1] - 1.);
+			}
+		} else {
+			trial_rng_type trng(get_trial_seed(i,x));
+			boost::random::uniform_real_distribution<double> uniform(0.,1.);
+			boost::random::normal_distribution<double> normal(0.,1.);
+			u_radius = uniform(trng);
+			for(size_type j = 0; j < n; ++j){
+				z[j] = normal(trng);
+			}
+		}
+		double c2 = 0;
+		for(size_type j = 0; j < n; ++j){
+			c2 += z[j]*z[j];
+		}
+		const double scale = c2 > 0 ? m_rho * pow(u_radius,1.0/n) / sqrt(c2) : 0.;
+		for(size_type j = 0; j < n; ++j){
+			xs[i][j] = std::min(std::max(x[j] + z[j] * scale, get_lb()[j]), get_ub()[j]);
+		}
+	}
+}
+
 std::string robust::get_name() const
 {
 	return m_original_problem->get_name() + " [Robust]";
@@ -26,6 +26,7 @@
 #define PAGMO_PROBLEM_ROBUST_H
 
 #include <string>
+#include <vector>
 #include <boost/functional/hash.hpp>
 #include <boost/random/normal_distribution.hpp>
 #include <boost/random/uniform_real_distribution.hpp>
@@ -44,6 +45,9 @@ namespace pagmo{ namespace problem {
  * chromosome. The solution to the resulting problem is robust
  * to input noises in the given neighbourhood.
  *
+ * Besides the default SERIAL sampling, the PARALLEL and SOBOL schemes of base_stochastic::set_sampling()
+ * are supported: the perturbed decision vectors of all trials are evaluated as a batch, split among threads.
+ *
  * @author Yung-Siang Liau (liauys@gmail.com)
  * @author Dario Izzo (dario.izzo@gmail.com)
  *
@@ -73,6 +77,8 @@ class __PAGMO_VISIBLE robust : public base_stochastic
 
 	private:
 		void inject_noise_x(decision_vector &) const;
+		void get_trial_points(std::vector<decision_vector> &, const decision_vector &) const;
+		struct objfun_trials;
 
 		friend class boost::serialization::access;
 		template <class Archive>
@@ -87,6 +93,9 @@ class __PAGMO_VISIBLE robust : public base_stochastic
 		}
 
 		base_ptr m_original_problem;
+		// Copies of the original problem evaluating the trials of the chunks other than the first one in the
+		// PARALLEL and SOBOL schemes. Built on demand, not copied nor serialized.
+		mutable std::vector<base_ptr> m_trial_problems;
 		mutable boost::normal_distribution<double> m_normal_dist;
 		mutable boost::random::uniform_real_distribution<double> m_uniform_dist;
 		unsigned int m_trials;
@@ -22,8 +22,10 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <boost/numeric/conversion/cast.hpp>
 #include <string>
 
+#include "../Eigen/Core"
 #include "../exceptions.h"
 #include "../types.h"
 #include "base.h"
@@ -56,10 +58,10 @@ base_ptr rosenbrock::clone() const
 void rosenbrock::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	const decision_vector::size_type n = x.size();
-	f[0]=0;
-	for (decision_vector::size_type i=0; i<n-1; ++i){
-		f[0] += 100 * (x[i]*x[i] -x[i+1])*(x[i]*x[i] -x[i+1]) + (x[i]-1)*(x[i]-1);
-	}
+	// Vectorised sum over the pairs of consecutive components of x.
+	const Eigen::Map<const Eigen::ArrayXd> xa(&x[0],boost::numeric_cast<Eigen::ArrayXd::Index>(n));
+	const Eigen::ArrayXd::Index m = xa.size() - 1;
+	f[0] = (100.0 * (xa.head(m).square() - xa.tail(m)).square() + (xa.head(m) - 1.0).square()).sum();
 }
 
 std::string rosenbrock::get_name() const
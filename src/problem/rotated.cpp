@@ -51,17 +51,12 @@ rotated::rotated(const base &p, const Eigen::MatrixXd &rotation ):
 		 p.get_c_dimension(),
 		 p.get_ic_dimension(),
 		 p.get_c_tol()),
-	m_Rotate(rotation), m_normalize_translation(), m_normalize_scale()
+	m_Rotate(), m_normalize_translation(), m_normalize_scale()
 {
-	m_InvRotate = m_Rotate.transpose();
-	
-	Eigen::MatrixXd check = m_InvRotate * m_Rotate;
-	if(!check.isIdentity(1e-5)){
-		pagmo_throw(value_error,"The input matrix seems not to be orthonormal (to a tolerance of 1e-5)");
-	}
 	if(p.get_i_dimension()>0){
 		pagmo_throw(value_error,"Input problem has an integer dimension. Cannot rotate it.");
 	}
+	set_rotation_matrix(rotation);
 	configure_new_bounds();
 }
 
@@ -91,21 +86,16 @@ rotated::rotated(const base &p,
 	if(p.get_i_dimension()>0){
 		pagmo_throw(value_error,"Input problem has an integer dimension. Cannot rotate it.");
 	}
-	m_Rotate.resize(rotation.size(),rotation.size());
+	Eigen::MatrixXd tmp(rotation.size(),rotation.size());
 	for (base::size_type i = 0; i < rotation.size(); ++i) {
 		if(!(rotation.size()==rotation[i].size())){
 			pagmo_throw(value_error,"The input matrix seems not to be square");
 		}
 		for (base::size_type j = 0; j < rotation[i].size(); ++j) {
-			m_Rotate(i,j) = rotation[i][j];
+			tmp(i,j) = rotation[i][j];
 		}
 	}
-	m_InvRotate = m_Rotate.transpose();
-	
-	Eigen::MatrixXd check = m_InvRotate * m_Rotate;
-	if(!check.isIdentity(1e-5)){
-		pagmo_throw(value_error,"The input matrix seems not to be orthonormal (to a tolerance of 1e-5)");
-	}
+	set_rotation_matrix(tmp);
 	configure_new_bounds();
 }
 
@@ -126,17 +116,11 @@ rotated::rotated(const base &p):
 		 p.get_c_tol()),
 	m_normalize_translation(), m_normalize_scale()
 {
-	size_type dim = p.get_dimension();
-	m_Rotate = Eigen::MatrixXd::Random(dim, dim).householderQr().householderQ();
-	m_InvRotate = m_Rotate.transpose();
-
-	Eigen::MatrixXd check = m_InvRotate * m_Rotate;
-	if(!check.isIdentity(1e-5)){
-		pagmo_throw(value_error,"The input matrix seems not to be orthonormal (to a tolerance of 1e-5)");
-	}
 	if(p.get_i_dimension()>0){
 		pagmo_throw(value_error,"Input problem has an integer dimension. Cannot rotate it.");
 	}
+	size_type dim = p.get_dimension();
+	set_rotation_matrix(Eigen::MatrixXd::Random(dim, dim).householderQr().householderQ());
 	configure_new_bounds();
 }
 
@@ -146,6 +130,23 @@ base_ptr rotated::clone() const
 	return base_ptr(new rotated(*this));
 }
 
+/// Checks and stores the rotation matrix
+/**
+ * The matrix is stored once and shared among all copies of the problem.
+ *
+ * @param[in] rotation Eigen::MatrixXd expressing the problem rotation
+ *
+ * @throws value_error if the matrix is not orthonormal (to a tolerance of 1e-5)
+ */
+void rotated::set_rotation_matrix(const Eigen::MatrixXd &rotation)
+{
+	Eigen::MatrixXd check = rotation.transpose() * rotation;
+	if(!check.isIdentity(1e-5)){
+		pagmo_throw(value_error,"The input matrix seems not to be orthonormal (to a tolerance of 1e-5)");
+	}
+	m_Rotate.reset(new Eigen::MatrixXd(rotation));
+}
+
 /// Update the new bounds due to the rotation transformation
 // Slight twist here: Rotation causes the new bounds to be
 // not seperable w.r.t the axes. Here, the approach taken
@@ -222,7 +223,7 @@ decision_vector rotated::derotate(const decision_vector& x_normed) const
 	for(base::size_type i = 0; i < x_normed.size(); i++){
 		x_normed_vec(i) = x_normed[i];	
 	}
-	x_derotated_vec = m_InvRotate * x_normed_vec;
+	x_derotated_vec = m_Rotate->transpose() * x_normed_vec;
 
 	// 2. De-normalize the de-rotated vector to the original bounds
 	decision_vector x_derotated(x_normed.size(), 0);
@@ -237,18 +238,29 @@ decision_vector rotated::derotate(const decision_vector& x_normed) const
 	return x;
 }
 
+/// The de-rotation as an affine transformation: inverse rotation and de-normalization,
+/// followed by the projection onto the original bounds
+bool rotated::get_affine_transform(affine_transform &t) const
+{
+	Eigen::Map<const Eigen::VectorXd> scale(&m_normalize_scale[0],m_normalize_scale.size());
+	t.m_A = scale.asDiagonal() * m_Rotate->transpose();
+	t.m_b = Eigen::Map<const Eigen::VectorXd>(&m_normalize_translation[0],m_normalize_translation.size());
+	t.m_clip = true;
+	return true;
+}
+
 /// Implementation of the objective function.
-/// (Wraps over the original implementation with de-rotated input)
+/// (Wraps over the original implementation with de-rotated input, fused with the other affine meta-problems)
 void rotated::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	m_original_problem->objfun(f, derotate(x));
+	fused_objfun(f, x);
 }
 
 /// Implementation of the constraints computation.
-/// (Wraps over the original implementation with de-rotated input)
+/// (Wraps over the original implementation with de-rotated input, fused with the other affine meta-problems)
 void rotated::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
 {
-	m_original_problem->compute_constraints(c, derotate(x));
+	fused_compute_constraints(c, x);
 }
 
 /// Extra human readable info for the problem.
@@ -260,12 +272,12 @@ std::string rotated::human_readable_extra() const
 	std::ostringstream oss;
 	oss << m_original_problem->human_readable_extra() << std::endl;
 	oss << "\n\tRotation matrix: " << std::endl;
-	if (m_Rotate.cols() > 5) {
-		oss << m_Rotate.block(0,0,5,5) << std::endl;
+	if (m_Rotate->cols() > 5) {
+		oss << m_Rotate->block(0,0,5,5) << std::endl;
 		oss << "..." << std::endl;
 	}
 	else {
-		oss << m_Rotate << std::endl;
+		oss << *m_Rotate << std::endl;
 	}
 	return oss.str();
 }
@@ -281,7 +293,7 @@ std::string rotated::get_name() const
  * @return an orthonormal Eigen::MatrixXd defining part of the transformation applied to the original problem
  */
 const Eigen::MatrixXd& rotated::get_rotation_matrix() const {
-	return m_Rotate;
+	return *m_Rotate;
 }
 
 }}
@@ -26,6 +26,7 @@
 #define PAGMO_PROBLEM_ROTATED_H
 
 #include <string>
+#include <boost/shared_ptr.hpp>
 
 #include "../serialization.h"
 #include "../types.h"
@@ -40,6 +41,11 @@ namespace pagmo{ namespace problem {
  * Implements a meta-problem class that wraps some other problems,
  * resulting in a rotated version of the underlying problem.
  *
+ * NOTE: the rotation matrix is immutable once constructed and is therefore shared (by reference count)
+ * between all the copies of the problem (e.g. the clones held by populations and islands).
+ * Only the inverse rotation is needed in the evaluation and it is taken as a transposed view,
+ * so that no second D x D matrix is stored.
+ *
  * @author Yung-Siang Liau (liauys@gmail.com)
  */
 
@@ -61,6 +67,7 @@ class __PAGMO_VISIBLE rotated : public base_meta
 		std::string human_readable_extra() const;
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 		void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
+		bool get_affine_transform(affine_transform &) const;
 
 	private:
 		void configure_new_bounds();
@@ -71,16 +78,32 @@ class __PAGMO_VISIBLE rotated : public base_meta
 	
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void save(Archive &ar, const unsigned int) const
+		{
+			ar << boost::serialization::base_object<base_meta>(*this);
+			// The inverse rotation is still written to keep the archive layout unchanged.
+			const Eigen::MatrixXd rotate(*m_Rotate), inv_rotate(m_Rotate->transpose());
+			ar << rotate;
+			ar << inv_rotate;
+			ar << m_normalize_translation;
+			ar << m_normalize_scale;
+		}
+		template <class Archive>
+		void load(Archive &ar, const unsigned int)
 		{
-			ar & boost::serialization::base_object<base_meta>(*this);
-			ar & m_Rotate;
-			ar & m_InvRotate;
-			ar & m_normalize_translation;
-			ar & m_normalize_scale;
+			ar >> boost::serialization::base_object<base_meta>(*this);
+			Eigen::MatrixXd rotate, inv_rotate;
+			ar >> rotate;
+			ar >> inv_rotate;
+			m_Rotate.reset(new Eigen::MatrixXd(rotate));
+			ar >> m_normalize_translation;
+			ar >> m_normalize_scale;
 		}
-		Eigen::MatrixXd m_Rotate;
-		Eigen::MatrixXd m_InvRotate;
+		BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+		void set_rotation_matrix(const Eigen::MatrixXd &);
+
+		boost::shared_ptr<const Eigen::MatrixXd> m_Rotate;
 		decision_vector m_normalize_translation;
 		decision_vector m_normalize_scale;
 
@@ -23,9 +23,11 @@
  *****************************************************************************/
 
 #include <boost/math/constants/constants.hpp>
+#include <boost/numeric/conversion/cast.hpp>
 #include <cmath>
 #include <string>
 
+#include "../Eigen/Core"
 #include "../exceptions.h"
 #include "../types.h"
 #include "base.h"
@@ -59,12 +61,11 @@ void schwefel::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	pagmo_assert(f.size() == 1);
 	std::vector<double>::size_type n = x.size();
-	double value=0;
 
-	for (std::vector<double>::size_type i=0; i<n; i++){
-		value += x[i] * sin(sqrt(fabs(x[i])));
-		}
-		f[0] = 418.9828872724338 * n - value;
+	// Vectorised sum over the components of x.
+	const Eigen::Map<const Eigen::ArrayXd> xa(&x[0],boost::numeric_cast<Eigen::ArrayXd::Index>(n));
+	const double value = (xa * xa.abs().sqrt().sin()).sum();
+	f[0] = 418.9828872724338 * n - value;
 }
 
 std::string schwefel::get_name() const
@@ -143,20 +143,26 @@ decision_vector shifted::deshift(const decision_vector& x) const
 	return x_translated;
 }
 
+/// The shift as an affine transformation: identity plus translation
+bool shifted::get_affine_transform(affine_transform &t) const
+{
+	t.m_d = Eigen::VectorXd::Ones(m_translation.size());
+	t.m_b = -Eigen::Map<const Eigen::VectorXd>(&m_translation[0],m_translation.size());
+	return true;
+}
+
 /// Implementation of the objective function.
-/// (Wraps over the original implementation with translated input x)
+/// (Wraps over the original implementation with translated input x, fused with the other affine meta-problems)
 void shifted::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	decision_vector x_translated = deshift(x);
-	m_original_problem->objfun(f, x_translated);
+	fused_objfun(f, x);
 }
 
 /// Implementation of the constraints computation.
-/// (Wraps over the original implementation with translated input x)
+/// (Wraps over the original implementation with translated input x, fused with the other affine meta-problems)
 void shifted::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
 {
-	decision_vector x_translated = deshift(x);
-	m_original_problem->compute_constraints(c, x_translated);
+	fused_compute_constraints(c, x);
 }
 
 /**
@@ -60,6 +60,7 @@ class __PAGMO_VISIBLE shifted : public base_meta
 		std::string human_readable_extra() const;
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 		void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
+		bool get_affine_transform(affine_transform &) const;
 	private:
 		void configure_shifted_bounds(const decision_vector &);
 
@@ -22,16 +22,17 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
-#include<gsl/gsl_odeiv2.h>
-#include<gsl/gsl_errno.h>
 #include<cmath>
+#include<cstddef>
 #include<algorithm>
+#include<vector>
 
 #include "../exceptions.h"
 #include "../types.h"
 #include "../population.h"
 #include "base_stochastic.h"
 #include "spheres.h"
+#include "../util/batch_rk.h"
 
 static const int nr_input = 8;
 static const int nr_output = 3;
@@ -50,34 +51,17 @@ spheres::spheres(int n_evaluations, int n_hidden_neurons,
 	m_ffnn(nr_input,n_hidden_neurons,nr_output), m_n_evaluations(n_evaluations),
 	m_n_hidden_neurons(n_hidden_neurons), m_numerical_precision(numerical_precision),
 	m_ic(nr_eq), m_symm(symmetric), m_sim_time(sim_time), m_sides(sides) {
+	if (!(numerical_precision >= 0)) {
+		pagmo_throw(value_error,"the precision of the ode-solver must be non-negative");
+	}
 	// Here we set the bounds for the problem decision vector, i.e. the nn weights
 	set_lb(-1);
 	set_ub(1);
-	// We then instantiate the ode integrator system using gsl
-	gsl_odeiv2_system sys = {ode_func,NULL,nr_eq,&m_ffnn};
-	m_sys = sys;
-	m_gsl_drv_pntr = gsl_odeiv2_driver_alloc_y_new(&m_sys, gsl_odeiv2_step_rk8pd, 1e-6,m_numerical_precision,0.0);
 	// And make sure the three sides are ordered and squared here
 	std::sort(m_sides.begin(),m_sides.end());
 	m_sides[0]*=m_sides[0];	m_sides[1]*=m_sides[1];	m_sides[2]*=m_sides[2];
 }
 
-spheres::spheres(const spheres &other):
-	base_stochastic(other),
-	m_ffnn(other.m_ffnn),
-	m_n_evaluations(other.m_n_evaluations),m_n_hidden_neurons(other.m_n_hidden_neurons),
-	m_numerical_precision(other.m_numerical_precision),m_ic(other.m_ic), m_symm(other.m_symm), m_sim_time(other.m_sim_time),m_sides(other.m_sides)
-{
-	// Here we set the bounds for the problem decision vector, i.e. the nn weights
-	gsl_odeiv2_system sys = {ode_func,NULL,nr_eq,&m_ffnn};
-	m_sys = sys;
-	m_gsl_drv_pntr = gsl_odeiv2_driver_alloc_y_new(&m_sys, gsl_odeiv2_step_rk8pd, 1e-6,m_numerical_precision,0.0);
-}
-
-spheres::~spheres(){
-	gsl_odeiv2_driver_free(m_gsl_drv_pntr);
-}
-
 /// Clone method.
 base_ptr spheres::clone() const
 {
@@ -141,45 +125,58 @@ double spheres::single_fitness( const std::vector<double> &y, const ffnn& neural
 	return fit;
 }
 
-int spheres::ode_func( double t, const double y[], double f[], void *params ) {
-	(void)t;
-	// Here we recover the neural network
-	ffnn	*ptr_ffnn = (ffnn*)params;
-
-	// The fixed-size vector context represent the sensory data perceived from each sphere. These are
-	// the body axis components of the relative positions of the other spheres, and their modules
-	double  context[nr_input];
-	double  out[nr_output];
-
-	// Here are some counters
-	int  k;
-
-
-	for( int i = 0; i < nr_spheres; i++ ){	// i - is the sphere counter 0 .. 1 .. 2 ..
-		k = 0;
-
-		// we now load in context the perceived data (as decoded from the world state y)
-		for( int n = 1; n <= nr_spheres - 1; n++ ){				// consider the vector from each other sphere
-			for( int j = 0; j < 3; j++ ){				// consider each component from the vectors
-				context[k++] = y[i*3 + j] - y[ (i*3 + j + n*3) % 9 ];
+// The state of the simulations is stored in structure-of-arrays layout (see util::batch_rk), so that the
+// perception of each sphere and the neural network are computed on all the simulations at once.
+struct spheres::dynamics: util::batch_rk::system
+{
+	explicit dynamics(const ffnn &net):m_net(net) {}
+	void operator()(double *dydt, const double *y, std::size_t n, std::size_t stride) const
+	{
+		m_context.resize(nr_input * n);
+		m_out.resize(nr_output * n);
+		m_hidden.resize(m_net.m_n_hidden * n);
+		for( int i = 0; i < nr_spheres; i++ ){	// i - is the sphere counter 0 .. 1 .. 2 ..
+			int k = 0;
+			// we now load in context the perceived data (as decoded from the world state y)
+			for( int l = 1; l <= nr_spheres - 1; l++ ){		// consider the vector from each other sphere
+				for( int j = 0; j < 3; j++ ){			// consider each component from the vectors
+					const double *a = y + (i*3 + j) * stride, *b = y + ((i*3 + j + l*3) % 9) * stride;
+					double *c = &m_context[(k++) * n];
+					for (std::size_t s = 0; s < n; ++s) {
+						c[s] = a[s] - b[s];
+					}
+				}
+			}
+			// context now contains the relative position vectors (6 components) in the absolute frame
+			// we write, on the last two components of context, the norms of these relative positions
+			for (int l = 0; l < 2; ++l) {
+				const double *c0 = &m_context[(l*3) * n], *c1 = &m_context[(l*3 + 1) * n], *c2 = &m_context[(l*3 + 2) * n];
+				double *d = &m_context[(6 + l) * n];
+				for (std::size_t s = 0; s < n; ++s) {
+					d[s] = c0[s]*c0[s] + c1[s]*c1[s] + c2[s]*c2[s];
+				}
+			}
+			//We evaluate the output from the neural net
+			m_net.eval_batch(&m_out[0], &m_context[0], n, n, &m_hidden[0]);
+			//Here we set the dynamics transforming the nn output [0,1] in desired velocities [-0/3,0.3]
+			for (int j = 0; j < 3; ++j) {
+				const double *o = &m_out[j * n];
+				double *f = dydt + (i*3 + j) * stride;
+				for (std::size_t s = 0; s < n; ++s) {
+					f[s] = o[s] * 0.3 * 2 - 0.3;
+				}
 			}
 		}
-
-		// context now contains the relative position vectors (6 components) in the absolute frame
-		// we write, on the last two components of context, the norms of these relative positions
-		context[6] = context[0]*context[0] + context[1]*context[1] + context[2]*context[2];
-		context[7] = context[3]*context[3] + context[4]*context[4] + context[5]*context[5];
-
-		//We evaluate the output from the neural net
-		ptr_ffnn->eval(out, context);
-
-		//Here we set the dynamics transforming the nn output [0,1] in desired velocities [-0/3,0.3]
-		f[i*3] = out[0] * 0.3 * 2 - 0.3;
-		f[i*3+1] = out[1] * 0.3 * 2 - 0.3;
-		f[i*3+2] = out[2] * 0.3 * 2 - 0.3;
-
 	}
-	return GSL_SUCCESS;
+	const ffnn &m_net;
+	mutable std::vector<double> m_context, m_out, m_hidden;
+};
+
+// Integrates the n simulations stored (in structure-of-arrays layout) in y from t0 to tf.
+void spheres::integrate(std::vector<double> &y, std::size_t n, double t0, double tf) const
+{
+	const util::batch_rk rk(nr_eq, m_numerical_precision, m_numerical_precision > 0 ? 1e-6 : 1e-2);
+	rk.integrate(dynamics(m_ffnn), y, n, t0, tf);
 }
 
 spheres::ffnn::ffnn(const unsigned int n_inputs, const unsigned int n_hidden,const unsigned int n_outputs) :
@@ -227,38 +224,77 @@ void spheres::ffnn::eval(double out[], const double in[]) const {
 	}
 }
 
+// Evaluates the network on n inputs at once: input j of sample s is in[j * in_stride + s], output i is written
+// in out[i * n + s]. hidden is a buffer of m_n_hidden * n elements.
+void spheres::ffnn::eval_batch(double *out, const double *in, std::size_t in_stride, std::size_t n, double *hidden) const {
+	// Offset for the weights to the output nodes
+	const unsigned int offset = m_n_hidden * (m_n_inputs + 1);
+
+	for( unsigned int i = 0; i < m_n_hidden; i++ ){
+		const double *w = &m_weights[i * (m_n_inputs + 1)];
+		double *h = hidden + i * n;
+		for (std::size_t s = 0; s < n; ++s) {
+			h[s] = w[0];
+		}
+		for( unsigned int j = 0; j < m_n_inputs; j++ ){
+			const double wj = w[j + 1];
+			const double *x = in + j * in_stride;
+			for (std::size_t s = 0; s < n; ++s) {
+				h[s] += wj * x[s];
+			}
+		}
+		for (std::size_t s = 0; s < n; ++s) {
+			h[s] = 1.0 / ( 1 + std::exp( -h[s] ));
+		}
+	}
+
+	for( unsigned int i = 0; i < m_n_outputs; i++ ){
+		const double *w = &m_weights[offset + i * (m_n_hidden + 1)];
+		double *o = out + i * n;
+		for (std::size_t s = 0; s < n; ++s) {
+			o[s] = w[0];
+		}
+		for( unsigned int j = 0; j < m_n_hidden; j++ ){
+			const double wj = w[j + 1];
+			const double *h = hidden + j * n;
+			for (std::size_t s = 0; s < n; ++s) {
+				o[s] += wj * h[s];
+			}
+		}
+		for (std::size_t s = 0; s < n; ++s) {
+			o[s] = 1.0 / ( 1 + std::exp( -o[s] ));
+		}
+	}
+}
+
 void spheres::objfun_impl(fitness_vector &f, const decision_vector &x) const {
 	f[0]=0;
 	// Make sure the pseudorandom sequence will always be the same
 	m_drng.seed(m_seed);
 	// Set the ffnn weights from x, by accounting for symmetries in neurons weights
 	set_nn_weights(x);
-	// Loop over the number of repetitions
-	for (int count=0;count<m_n_evaluations;++count) {
-		// Creates the initial conditions at random
+	// Creates the initial conditions of all the repetitions at random, simulation count in column count
+	const std::size_t n = m_n_evaluations;
+	std::vector<double> y(nr_eq * n);
+	for (std::size_t count=0;count<n;++count) {
 		// Positions starts in a [-1,1] box
 		for (int i=0; i<6; ++i) {
-			m_ic[i] = (m_drng()*2 - 1);
+			y[i*n + count] = (m_drng()*2 - 1);
 		}
 
 		// Centered around the origin
-		m_ic[6] = - (m_ic[0] + m_ic[3]);
-		m_ic[7] = - (m_ic[1] + m_ic[4]);
-		m_ic[8] = - (m_ic[2] + m_ic[5]);
-
-		// Integrate the system
-		double t0 = 0.0;
-		double tf = m_sim_time;
-		//gsl_odeiv2_driver_set_hmin (m_gsl_drv_pntr, 1e-6);
-		int status = gsl_odeiv2_driver_apply( m_gsl_drv_pntr, &t0, tf, &m_ic[0] );
-		// Not sure if this help or what it does ....
-		gsl_odeiv2_driver_reset (m_gsl_drv_pntr);
-		if( status != GSL_SUCCESS ){
-			printf ("ERROR: gsl_odeiv2_driver_apply returned value = %d\n", status);
-			break;
+		y[6*n + count] = - (y[count] + y[3*n + count]);
+		y[7*n + count] = - (y[n + count] + y[4*n + count]);
+		y[8*n + count] = - (y[2*n + count] + y[5*n + count]);
+	}
+
+	// Integrate all the systems at once
+	integrate(y, n, 0.0, m_sim_time);
+	for (std::size_t count=0;count<n;++count) {
+		for (int i=0; i<nr_eq; ++i) {
+			m_ic[i] = y[i*n + count];
 		}
 		f[0] += single_fitness(m_ic,m_ffnn);
-
 	}
 	f[0] /= m_n_evaluations;
 }
@@ -272,36 +308,31 @@ std::vector<std::vector<double> > spheres::post_evaluate(const decision_vector &
 	m_drng.seed(seed);
 	// Set the ffnn weights
 	set_nn_weights(x);
-	// Loop over the number of repetitions
-	for (int count=0;count<N;++count) {
-		// Creates the initial conditions at random
-
+	// Creates the initial conditions at random
+	const std::size_t n = N;
+	std::vector<double> y(nr_eq * n);
+	for (std::size_t count=0;count<n;++count) {
 		// Position starts in a [-1,1] box (evolution is in [-2,2])
 		for (int i=0; i<6; ++i) {
-		m_ic[i] = (m_drng()*2 - 1);
+			y[i*n + count] = (m_drng()*2 - 1);
 		}
 		// Centered around the origin
-		m_ic[6] = - (m_ic[0] + m_ic[3]);
-		m_ic[7] = - (m_ic[1] + m_ic[4]);
-		m_ic[8] = - (m_ic[2] + m_ic[5]);
+		y[6*n + count] = - (y[count] + y[3*n + count]);
+		y[7*n + count] = - (y[n + count] + y[4*n + count]);
+		y[8*n + count] = - (y[2*n + count] + y[5*n + count]);
 
 		for (int i=0; i<9; ++i) {
-			one_row[i] = m_ic[i];
+			ret[count][i] = y[i*n + count];
 		}
+	}
 
-		// Integrate the system
-		double t0 = 0.0;
-		double tf = m_sim_time;
-		//gsl_odeiv2_driver_set_hmin (m_gsl_drv_pntr, 1e-6);
-		int status = gsl_odeiv2_driver_apply( m_gsl_drv_pntr, &t0, tf, &m_ic[0] );
-		// Not sure if this help or what it does ....
-		//gsl_odeiv2_driver_reset (m_gsl_drv_pntr);
-		if( status != GSL_SUCCESS ){
-			printf ("ERROR: gsl_odeiv2_driver_apply returned value = %d\n", status);
-			break;
+	// Integrate all the systems at once
+	integrate(y, n, 0.0, m_sim_time);
+	for (std::size_t count=0;count<n;++count) {
+		for (int i=0; i<nr_eq; ++i) {
+			m_ic[i] = y[i*n + count];
 		}
-		one_row[9] = single_fitness(m_ic,m_ffnn);
-		ret[count] = one_row;
+		ret[count][9] = single_fitness(m_ic,m_ffnn);
 	}
 	// sorting by fitness
 	std::sort (ret.begin(), ret.end(), my_sort_function);
@@ -357,18 +388,13 @@ std::vector<std::vector<double> > spheres::simulate(const decision_vector &x, co
 
 	for( int i = 1; i <= N; i++ ){
 		ti = i * tf / N;
-		int status = gsl_odeiv2_driver_apply( m_gsl_drv_pntr, &t0, ti, &y0[0] );
+		integrate(y0, 1, t0, ti);
+		t0 = ti;
 		//pushing_back the result
 		one_row[0] = ti;
 		std::copy(y0.begin(),y0.end(),one_row.begin()+1);
 		ret.push_back(one_row);
-		if( status != GSL_SUCCESS ){
-			printf ("ERROR: gsl_odeiv2_driver_apply returned value = %d\n", status);
-			break;
-		}
 	}
-	//Not sure if this help or what it does ....
-	//gsl_odeiv2_driver_reset (m_gsl_drv_pntr);
 	return ( ret );
 }
 
@@ -25,15 +25,16 @@
 #ifndef PAGMO_SPHERES_H
 #define PAGMO_SPHERES_H
 
+#include <cstddef>
 #include <string>
 #include <vector>
-#include <gsl/gsl_odeiv2.h>
 
 #include "../config.h"
 #include "../serialization.h"
 #include "../types.h"
 #include "base_stochastic.h"
 #include "../rng.h"
+#include "../util/batch_rk.h"
 
 namespace pagmo { namespace problem {
 
@@ -45,8 +46,7 @@ namespace pagmo { namespace problem {
  *
  * This problem (a stochastic optimization problem) aims at 'evolving' an artificial neural network
  * able to steer the positions of three satellites representing the SPHERES MIT test-bed
- * on-board of the ISS. It requies GSL libraries and thus it is compiled only if that
- * option is activated when compiling pagmo.
+ * on-board of the ISS.
  *
  * The objective function is the average over multiple runs of the following fitness
  * \f[
@@ -64,12 +64,14 @@ namespace pagmo { namespace problem {
  * orientation!!!). In pagmo::problem::spheres_q such a bias is removed by defining perception and action
  * in the sphere's body frame.
  *
+ * The simulations started from all the initial conditions are integrated together by util::batch_rk,
+ * an adaptive Dormand-Prince 5(4) integrator, evaluating the neural network on all of them at once.
+ *
  * @author Dario Izzo (dario.izzo@esa.int)
  */
 
 class __PAGMO_VISIBLE spheres: public base_stochastic
 {
-	static int ode_func( double t, const double y[], double f[], void *params );
 	public:
 		/// Constructor
 		/**
@@ -77,7 +79,7 @@ class __PAGMO_VISIBLE spheres: public base_stochastic
 		 *
 		 * @param[in] n_evaluations Number of initial conditions each neural network fitness is evaluated upon
 		 * @param[in] n_hidden number of hidden neurons in the neural net
-		 * @param[in] ode_prec precision requested to adapt the ode-solver step size
+		 * @param[in] ode_prec precision requested to adapt the ode-solver step size (if zero, a fixed step of 1E-2 is used)
 		 * @param[in] seed seed used to produce all random initial conditions
 		 * @param[in] symmetric a boolean value that, if true, indicates that the neural network
 		 * does not distinguish among permutations of its input values due to sphere ID exchange.
@@ -87,18 +89,6 @@ class __PAGMO_VISIBLE spheres: public base_stochastic
 */
 		spheres(int n_evaluations = 10, int n_hidden = 10, double ode_prec = 1E-6, unsigned int seed = 0, bool symmetric = false, double sim_time = 50.0, const std::vector<double>& sides = std::vector<double>(3,0.5));
 
-		/// Copy Constructor
-		/**
-		 * Necessary to properly handle the gsl variables (pointers!!!)
-		 */
-		spheres(const spheres &);
-
-		/// Destructor
-		/**
-		 * Necessary to properly clear memory allocated by gsl routines
-		 */
-		~spheres();
-
 		/// Post evaluation of the neural controller
 		/**
 		 * It tests a given neural controller over a large set of initial conditions (different from those
@@ -137,6 +127,7 @@ class __PAGMO_VISIBLE spheres: public base_stochastic
 			public:
 				ffnn(const unsigned int, const unsigned int,const unsigned int);
 				void eval(double[], const double[]) const;
+				void eval_batch(double *, const double *, std::size_t, std::size_t, double *) const;
 				void set_weights(const std::vector<double> &);
 			private:
 				friend class boost::serialization::access;
@@ -155,8 +146,11 @@ class __PAGMO_VISIBLE spheres: public base_stochastic
 				std::vector<double> m_weights;
 				mutable std::vector<double> m_hidden;
 		};
+		// Right-hand side of the equations of motion of a batch of simulations.
+		struct dynamics;
 		void set_nn_weights(const decision_vector& x) const;
 		double single_fitness( const std::vector<double> &, const ffnn& ) const;
+		void integrate(std::vector<double> &, std::size_t, double, double) const;
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
@@ -171,8 +165,6 @@ class __PAGMO_VISIBLE spheres: public base_stochastic
 			ar & m_sim_time;
 			ar & m_sides;
 		}
-		gsl_odeiv2_driver*				m_gsl_drv_pntr;
-		gsl_odeiv2_system				m_sys;
 		mutable ffnn					m_ffnn;
 		int								m_n_evaluations;
 		int								m_n_hidden_neurons;
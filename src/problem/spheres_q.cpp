@@ -22,15 +22,16 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
-#include<gsl/gsl_odeiv2.h>
-#include<gsl/gsl_errno.h>
 #include<cmath>
+#include<cstddef>
+#include<vector>
 
 #include "../exceptions.h"
 #include "../types.h"
 #include "../population.h"
 #include "base_stochastic.h"
 #include "spheres_q.h"
+#include "../util/batch_rk.h"
 
 static const int nr_input = 8;
 static const int nr_output = 3;
@@ -132,26 +133,9 @@ spheres_q::spheres_q(int n_evaluations, int n_hidden_neurons,
 	// Here we set the bounds for the problem decision vector, i.e. the nn weights
 	set_lb(-1);
 	set_ub(1);
-	// We then instantiate the ode integrator system using gsl
-	gsl_odeiv2_system sys = {ode_func,NULL,nr_eq,&m_ffnn};
-	m_sys = sys;
-	m_gsl_drv_pntr = gsl_odeiv2_driver_alloc_y_new(&m_sys, gsl_odeiv2_step_rk8pd, 1e-6,m_numerical_precision,0.0);
-}
-
-spheres_q::spheres_q(const spheres_q &other):
-	base_stochastic(other),
-	m_ffnn(other.m_ffnn),
-	m_n_evaluations(other.m_n_evaluations),m_n_hidden_neurons(other.m_n_hidden_neurons),
-	m_numerical_precision(other.m_numerical_precision),m_ic(other.m_ic)
-{
-	// Here we set the bounds for the problem decision vector, i.e. the nn weights
-	gsl_odeiv2_system sys = {ode_func,NULL,nr_eq,&m_ffnn};
-	m_sys = sys;
-	m_gsl_drv_pntr = gsl_odeiv2_driver_alloc_y_new(&m_sys, gsl_odeiv2_step_rk8pd, 1e-6,m_numerical_precision,0.0);
-}
-
-spheres_q::~spheres_q(){
-	gsl_odeiv2_driver_free(m_gsl_drv_pntr);
+	if (numerical_precision < 0) {
+		pagmo_throw(value_error,"the precision of the ode solver must be non-negative");
+	}
 }
 
 /// Clone method.
@@ -205,10 +189,10 @@ double spheres_q::single_fitness( const std::vector<double> &y, const ffnn& neur
 	return (fit / 2);
 }
 
-int spheres_q::ode_func( double t, const double y[], double f[], void *params ) {
+void spheres_q::ode_func( const double y[], double f[], const void *params ) {
 
 	// Here we recover the neural network
-	ffnn	*ptr_ffnn = (ffnn*)params;
+	const ffnn	*ptr_ffnn = static_cast<const ffnn *>(params);
 
 	// The fixed-size vector context represent the sensory data perceived from each sphere. These are
 	// the body axis components of the relative positions of the other spheres, and their modules
@@ -261,7 +245,34 @@ int spheres_q::ode_func( double t, const double y[], double f[], void *params )
 		f[9+i*4] = 0; f[10+i*4] = 0; f[11+i*4] = 0; f[12+i*4] = 0;
 
 	}
-	return GSL_SUCCESS;
+}
+
+// The equations of motion are evaluated one simulation at a time, gathering each column of the
+// structure-of-arrays state of util::batch_rk.
+struct spheres_q::dynamics: util::batch_rk::system
+{
+	explicit dynamics(const ffnn &net):m_net(net) {}
+	void operator()(double *dydt, const double *y, std::size_t n, std::size_t stride) const
+	{
+		double y_k[nr_eq], f_k[nr_eq];
+		for (std::size_t k = 0; k < n; ++k) {
+			for (int i = 0; i < nr_eq; ++i) {
+				y_k[i] = y[i*stride + k];
+			}
+			ode_func(y_k,f_k,&m_net);
+			for (int i = 0; i < nr_eq; ++i) {
+				dydt[i*stride + k] = f_k[i];
+			}
+		}
+	}
+	const ffnn &m_net;
+};
+
+// Integrate from t0 to tf the n simulations stored in y.
+void spheres_q::integrate(std::vector<double> &y, std::size_t n, double t0, double tf) const
+{
+	const util::batch_rk rk(nr_eq, m_numerical_precision, m_numerical_precision > 0 ? 1e-6 : 1e-2);
+	rk.integrate(dynamics(m_ffnn), y, n, t0, tf);
 }
 
 spheres_q::ffnn::ffnn(const unsigned int n_inputs, const unsigned int n_hidden,const unsigned int n_outputs) :
@@ -318,13 +329,13 @@ void spheres_q::objfun_impl(fitness_vector &f, const decision_vector &x) const {
 	// Set the ffnn weights
 	m_ffnn.set_weights(x);
 
-	// Loop over the number of repetitions
-	for (int count=0;count<m_n_evaluations;++count) {
-
-		// Creates the initial conditions at random
+	// Creates the initial conditions at random, one column per repetition
+	const std::size_t n = m_n_evaluations;
+	std::vector<double> y(nr_eq * n);
+	for (std::size_t count=0;count<n;++count) {
 		// Position starts in a [-2,2] box
 		for (int i=0; i<9; ++i) {
-			m_ic[i] = (m_drng()*4 - 2);
+			y[i*n + count] = (m_drng()*4 - 2);
 		}
 
 		// randomly initialize Spheres' quaternion using the equations in
@@ -334,26 +345,21 @@ void spheres_q::objfun_impl(fitness_vector &f, const decision_vector &x) const {
 			double u2 = m_drng();
 			double u3 = m_drng();
 			double radice = sqrt(1-u1);
-			m_ic[9 + 4*it] = radice*sin(2*u2*M_PI);
-			m_ic[10 + 4*it] = radice*cos(2*u2*M_PI);
+			y[(9 + 4*it)*n + count] = radice*sin(2*u2*M_PI);
+			y[(10 + 4*it)*n + count] = radice*cos(2*u2*M_PI);
 			radice = sqrt(u1);
-			m_ic[11 + 4*it] = radice*sin(2*u3*M_PI);
-			m_ic[12 + 4*it] = radice*cos(2*u3*M_PI);
+			y[(11 + 4*it)*n + count] = radice*sin(2*u3*M_PI);
+			y[(12 + 4*it)*n + count] = radice*cos(2*u3*M_PI);
 		}
+	}
 
-		// Integrate the system
-		double t0 = 0.0;
-		double tf = 50.0;
-		//gsl_odeiv2_driver_set_hmin (m_gsl_drv_pntr, 1e-6);
-		int status = gsl_odeiv2_driver_apply( m_gsl_drv_pntr, &t0, tf, &m_ic[0] );
-		// Not sure if this help or what it does ....
-		gsl_odeiv2_driver_reset (m_gsl_drv_pntr);
-		if( status != GSL_SUCCESS ){
-			printf ("ERROR: gsl_odeiv2_driver_apply returned value = %d\n", status);
-			break;
+	// Integrate all the systems at once
+	integrate(y, n, 0.0, 50.0);
+	for (std::size_t count=0;count<n;++count) {
+		for (int i=0; i<nr_eq; ++i) {
+			m_ic[i] = y[i*n + count];
 		}
 		f[0] += single_fitness(m_ic,m_ffnn);
-
 	}
 	f[0] /= m_n_evaluations;
 }
@@ -367,13 +373,14 @@ std::vector<std::vector<double> > spheres_q::post_evaluate(const decision_vector
 	m_drng.seed(seed);
 	// Set the ffnn weights
 	m_ffnn.set_weights(x);
-	// Loop over the number of repetitions
-	for (int count=0;count<N;++count) {
-		// Creates the initial conditions at random
+	// Creates the initial conditions at random, one column per repetition
+	const std::size_t n = N;
+	std::vector<double> y(nr_eq * n);
+	for (std::size_t count=0;count<n;++count) {
 		// Position starts in a [-1,1] box (evolution is in [-2,2])
 		for (int i=0; i<9; ++i) {
-			m_ic[i] = (m_drng()*2 - 1);
-			one_row[i] = m_ic[i];
+			y[i*n + count] = (m_drng()*2 - 1);
+			ret[count][i] = y[i*n + count];
 		}
 
 		// randomly initialize Spheres' quaternion using the equations in
@@ -383,31 +390,24 @@ std::vector<std::vector<double> > spheres_q::post_evaluate(const decision_vector
 			double u2 = m_drng();
 			double u3 = m_drng();
 			double radice = sqrt(1-u1);
-			m_ic[9 + 4*it] = radice*sin(2*u2*M_PI);
-			m_ic[10 + 4*it] = radice*cos(2*u2*M_PI);
+			y[(9 + 4*it)*n + count] = radice*sin(2*u2*M_PI);
+			y[(10 + 4*it)*n + count] = radice*cos(2*u2*M_PI);
 			radice = sqrt(u1);
-			m_ic[11 + 4*it] = radice*sin(2*u3*M_PI);
-			m_ic[12 + 4*it] = radice*cos(2*u3*M_PI);
-			one_row[9+ 4*it] = m_ic[9 + 4*it];
-			one_row[10+ 4*it] = m_ic[10 + 4*it];
-			one_row[11+ 4*it] = m_ic[11 + 4*it];
-			one_row[12+ 4*it] = m_ic[12 + 4*it];
+			y[(11 + 4*it)*n + count] = radice*sin(2*u3*M_PI);
+			y[(12 + 4*it)*n + count] = radice*cos(2*u3*M_PI);
+			for (int j = 9 + 4*it; j < 13 + 4*it; ++j) {
+				ret[count][j] = y[j*n + count];
+			}
 		}
+	}
 
-
-		// Integrate the system
-		double t0 = 0.0;
-		double tf = 50.0;
-		//gsl_odeiv2_driver_set_hmin (m_gsl_drv_pntr, 1e-6);
-		int status = gsl_odeiv2_driver_apply( m_gsl_drv_pntr, &t0, tf, &m_ic[0] );
-		// Not sure if this help or what it does ....
-		//gsl_odeiv2_driver_reset (m_gsl_drv_pntr);
-		if( status != GSL_SUCCESS ){
-			printf ("ERROR: gsl_odeiv2_driver_apply returned value = %d\n", status);
-			break;
+	// Integrate all the systems at once
+	integrate(y, n, 0.0, 50.0);
+	for (std::size_t count=0;count<n;++count) {
+		for (int i=0; i<nr_eq; ++i) {
+			m_ic[i] = y[i*n + count];
 		}
-		one_row[nr_eq] = single_fitness(m_ic,m_ffnn);
-		ret[count] = one_row;
+		ret[count][nr_eq] = single_fitness(m_ic,m_ffnn);
 	}
 	// sorting by fitness
 	std::sort (ret.begin(), ret.end(), my_sort_function);
@@ -431,15 +431,12 @@ std::vector<std::vector<double> > spheres_q::simulate(const decision_vector &x,
 
 	for( int i = 1; i <= N; i++ ){
 		ti = i * tf / N;
-		int status = gsl_odeiv2_driver_apply( m_gsl_drv_pntr, &t0, ti, &y0[0] );
+		integrate(y0, 1, t0, ti);
+		t0 = ti;
 		//pushing_back the result
 		one_row[0] = ti;
 		std::copy(y0.begin(),y0.end(),one_row.begin()+1);
 		ret.push_back(one_row);
-		if( status != GSL_SUCCESS ){
-			printf ("ERROR: gsl_odeiv2_driver_apply returned value = %d\n", status);
-			break;
-		}
 	}
 	return ( ret );
 }
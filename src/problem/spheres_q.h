@@ -25,15 +25,16 @@
 #ifndef PAGMO_SPHERES_Q_H
 #define PAGMO_SPHERES_Q_H
 
+#include <cstddef>
 #include <string>
 #include <vector>
-#include <gsl/gsl_odeiv2.h>
 
 #include "../config.h"
 #include "../serialization.h"
 #include "../types.h"
 #include "base_stochastic.h"
 #include "../rng.h"
+#include "../util/batch_rk.h"
 
 namespace pagmo { namespace problem {
 
@@ -45,8 +46,8 @@ namespace pagmo { namespace problem {
  *
  * This problem (a stochastic optimization problem) aims at 'evolving' an artificial neural network
  * able to steer the positions of three satellites representing the SPHERES MIT test-bed
- * on-board of the ISS. It requies GSL libraries and thus it is compiled only if that
- * option is activated when compiling pagmo.
+ * on-board of the ISS. The equations of motion of all the initial conditions are integrated together
+ * by pagmo::util::batch_rk.
  *
  * The objective function is the average over multiple runs of the following fitness
  * \f[
@@ -65,7 +66,7 @@ namespace pagmo { namespace problem {
 
 class __PAGMO_VISIBLE spheres_q: public base_stochastic
 {
-	static int ode_func( double t, const double y[], double f[], void *params );
+	static void ode_func( const double y[], double f[], const void *params );
 	public:
 		/// Constructor
 		/**
@@ -78,18 +79,6 @@ class __PAGMO_VISIBLE spheres_q: public base_stochastic
 		 */
 		spheres_q(int n_evaluations = 10, int n_hidden = 10, double ode_prec = 1E-3, unsigned int seed = 0);
 
-		/// Copy Constructor
-		/**
-		 * Necessary to properly handle the gsl variables (pointers!!!)
-		 */
-		spheres_q(const spheres_q &);
-
-		/// Destructor
-		/**
-		 * Necessary to properly clear memory allocated by gsl routines
-		 */
-		~spheres_q();
-
 		/// Post evaluation of the neural controller
 		/**
 		 * It tests a given neural controller over a large set of initial conditions (different from those
@@ -143,6 +132,8 @@ class __PAGMO_VISIBLE spheres_q: public base_stochastic
 				mutable std::vector<double> m_hidden;
 		};
 		double single_fitness( const std::vector<double> &, const ffnn& ) const;
+		struct dynamics;
+		void integrate(std::vector<double> &, std::size_t, double, double) const;
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
@@ -154,8 +145,6 @@ class __PAGMO_VISIBLE spheres_q: public base_stochastic
 			ar & const_cast<double &>(m_numerical_precision);
 			ar & m_ic;
 		}
-		gsl_odeiv2_driver*				m_gsl_drv_pntr;
-		gsl_odeiv2_system				m_sys;
 		mutable ffnn					m_ffnn;
 		int 						m_n_evaluations;
 		int 						m_n_hidden_neurons;
@@ -80,12 +80,8 @@
 #include "problem/noisy.h"
 #include "problem/robust.h"
 #include "problem/con2uncon.h"
-
-// GSL problems.
-#ifdef PAGMO_ENABLE_GSL
-	#include "problem/spheres.h"
-//	#include "problem/spheres_q.h"
-#endif
+#include "problem/spheres.h"
+//#include "problem/spheres_q.h"
 
 #ifdef PAGMO_ENABLE_KEP_TOOLBOX
         #include "problem/cassini_1.h"
@@ -35,6 +35,7 @@
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
+#include <boost/serialization/array.hpp>
 #include <boost/serialization/assume_abstract.hpp>
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/export.hpp>
@@ -110,6 +111,31 @@ void custom_vector_double_load(Archive &ar, std::vector<double> &v, const unsign
 	}
 }
 
+/// Binary save of a vector of doubles.
+/**
+ * Binary archives store the bit patterns of the elements, so inf and NaN need no special treatment and
+ * the content can be written as a single raw block.
+ */
+inline void custom_vector_double_save(boost::archive::binary_oarchive &ar, const std::vector<double> &v, const unsigned int)
+{
+	const std::vector<double>::size_type size = v.size();
+	ar << size;
+	if (size) {
+		ar << boost::serialization::make_array(&v[0],size);
+	}
+}
+
+/// Binary load of a vector of doubles.
+inline void custom_vector_double_load(boost::archive::binary_iarchive &ar, std::vector<double> &v, const unsigned int)
+{
+	std::vector<double>::size_type size = 0;
+	ar >> size;
+	v.resize(size);
+	if (size) {
+		ar >> boost::serialization::make_array(&v[0],size);
+	}
+}
+
 }
 
 namespace boost { namespace serialization {
@@ -175,6 +175,61 @@ void ageing_clustered_ba::connect(const vertices_size_type &idx)
 	}
 }
 
+// Bulk insertion: after the kernel is completed, the vertices are drawn with probability proportional to their degree
+// from a degree_tree, restricted to the vertices younger than the maximum age, instead of scanning all the vertices for each new edge.
+void ageing_clustered_ba::push_back_bulk(const vertices_size_type &n)
+{
+	vertices_size_type i = 0;
+	// The kernel is built one vertex at a time.
+	for (; i < n && get_number_of_vertices() < m_m0; ++i) {
+		push_back();
+	}
+	if (i == n) {
+		return;
+	}
+	degree_tree degrees(*this);
+	boost::uniform_int<edges_size_type> uni_int2(1,m_m);
+	std::vector<vertices_size_type> adj_idx;
+	for (; i < n; ++i) {
+		add_vertex();
+		degrees.add_vertex();
+		const vertices_size_type idx = get_number_of_vertices() - 1;
+		// Vertices before min_idx are too old to be connected to.
+		const vertices_size_type min_idx = (idx > static_cast<vertices_size_type>(m_a)) ? idx - m_a : 0;
+		// j is a random integer in the range 1 to m.
+		const std::size_t j = uni_int2(m_urng);
+		adj_idx.clear();
+		while (adj_idx.size() < j) {
+			// Draw among the vertices in [min_idx,idx).
+			const edges_size_type min_n_edges = degrees.prefix(min_idx), n_edges = degrees.prefix(idx);
+			if (min_n_edges >= n_edges) {
+				// No young vertex can be connected to.
+				break;
+			}
+			boost::uniform_int<edges_size_type> uni_int(min_n_edges,n_edges - 1);
+			const vertices_size_type rnd = degrees.find(uni_int(m_urng));
+			// If the candidate was not already connected, then add it.
+			if (!are_adjacent(idx,rnd)) {
+				// Connect to nodes that are already adjacent to idx with probability p.
+				for (std::vector<vertices_size_type>::size_type k = 0; k < adj_idx.size(); ++k) {
+					if (m_drng() < m_p && adj_idx[k] != rnd && !are_adjacent(adj_idx[k],rnd)) {
+						add_edge(adj_idx[k],rnd);
+						add_edge(rnd,adj_idx[k]);
+						degrees.increment(adj_idx[k]);
+						degrees.increment(rnd);
+					}
+				}
+				// Connect to idx
+				add_edge(rnd,idx);
+				add_edge(idx,rnd);
+				degrees.increment(rnd);
+				degrees.increment(idx);
+				adj_idx.push_back(rnd);
+			}
+		}
+	}
+}
+
 /// Topology-specific human readable info.
 /**
  * Will return a formatted string containing the size of the kernel, the maximum number of connections for newly-inserted nodes,
@@ -59,6 +59,7 @@ class __PAGMO_VISIBLE ageing_clustered_ba : public base
 		std::string get_name() const;
 	protected:
 		void connect(const vertices_size_type &);
+		void push_back_bulk(const vertices_size_type &);
 		std::string human_readable_extra() const;
 	private:
 		friend class boost::serialization::access;
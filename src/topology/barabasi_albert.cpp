@@ -141,6 +141,42 @@ void barabasi_albert::connect(const vertices_size_type &idx)
 	}
 }
 
+// Bulk insertion: after the kernel is completed, the vertices are drawn with probability proportional to their degree
+// from a degree_tree, instead of scanning all the vertices for each new edge.
+void barabasi_albert::push_back_bulk(const vertices_size_type &n)
+{
+	vertices_size_type i = 0;
+	// The kernel is built one vertex at a time.
+	for (; i < n && get_number_of_vertices() < m_m0; ++i) {
+		push_back();
+	}
+	if (i == n) {
+		return;
+	}
+	degree_tree degrees(*this);
+	for (; i < n; ++i) {
+		add_vertex();
+		degrees.add_vertex();
+		const vertices_size_type idx = get_number_of_vertices() - 1;
+		std::size_t j = 0;
+		while (j < m_m) {
+			// Draw among the vertices before idx, i.e., excluding idx itself.
+			const edges_size_type n_edges = degrees.prefix(idx);
+			pagmo_assert(n_edges > 0);
+			boost::uniform_int<edges_size_type> uni_int(0,n_edges - 1);
+			const vertices_size_type rnd = degrees.find(uni_int(m_urng));
+			// If the candidate was not already connected, then add it.
+			if (!are_adjacent(idx,rnd)) {
+				add_edge(rnd,idx);
+				add_edge(idx,rnd);
+				degrees.increment(rnd);
+				degrees.increment(idx);
+				++j;
+			}
+		}
+	}
+}
+
 /// Topology-specific human readable info.
 /**
  * Will return a formatted string containing the size of the kernel and the number of connections for newly-inserted nodes.
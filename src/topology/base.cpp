@@ -23,11 +23,16 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <boost/bind.hpp>
 #include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/johnson_all_pairs_shortest.hpp>
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/ref.hpp>
+#include <boost/thread/thread.hpp>
+#include <cstddef>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <typeinfo>
@@ -35,6 +40,7 @@
 #include <vector>
 
 #include "../exceptions.h"
+#include "../rng.h"
 #include "base.h"
 
 namespace pagmo { namespace topology {
@@ -447,79 +453,264 @@ base::edges_size_type base::get_number_of_edges() const
 	return boost::num_edges(m_graph);
 }
 
+// Flat (CSR) copy of the adjacency structure of the graph: the vertices adjacent to vertex n are
+// in the range [offsets[n],offsets[n + 1]) of adj.
+void base::get_csr(std::vector<vertices_size_type> &offsets, std::vector<vertices_size_type> &adj) const
+{
+	const vertices_size_type n = get_number_of_vertices();
+	offsets.resize(n + 1);
+	adj.clear();
+	adj.reserve(boost::numeric_cast<std::vector<vertices_size_type>::size_type>(get_number_of_edges()));
+	offsets[0] = 0;
+	for (vertices_size_type i = 0; i < n; ++i) {
+		const std::pair<a_iterator,a_iterator> a_vertices = boost::adjacent_vertices(boost::vertex(i,m_graph),m_graph);
+		adj.insert(adj.end(),a_vertices.first,a_vertices.second);
+		offsets[i + 1] = adj.size();
+	}
+}
+
+// Return n_samples distinct random vertices drawn with the given seed, or all the vertices if n_samples
+// is zero or not smaller than the number of vertices.
+std::vector<base::vertices_size_type> base::sample_vertices(const vertices_size_type &n_samples, unsigned int seed) const
+{
+	const vertices_size_type n = get_number_of_vertices();
+	std::vector<vertices_size_type> retval(n);
+	for (vertices_size_type i = 0; i < n; ++i) {
+		retval[i] = i;
+	}
+	if (n_samples && n_samples < n) {
+		// Partial Fisher-Yates shuffle.
+		rng_uint32 urng(seed);
+		for (vertices_size_type i = 0; i < n_samples; ++i) {
+			boost::uniform_int<vertices_size_type> uni_int(i,n - 1);
+			std::swap(retval[i],retval[uni_int(urng)]);
+		}
+		retval.resize(n_samples);
+	}
+	return retval;
+}
+
+namespace {
+
+typedef base::vertices_size_type vertices_size_type;
+
+// Resolve the number of threads to be used for the graph metrics.
+unsigned int metric_threads(unsigned int n_threads, std::size_t n_tasks)
+{
+	if (!n_threads) {
+		n_threads = std::max(boost::thread::hardware_concurrency(),1u);
+	}
+	return static_cast<unsigned int>(std::min<std::size_t>(n_threads,std::max<std::size_t>(n_tasks,1u)));
+}
+
+// Run task(t,n_threads,retval[t]) for t in [0,n_threads), in parallel if n_threads > 1.
+template <class Task>
+void run_metric_threads(const Task &task, std::vector<double> &retval)
+{
+	const unsigned int n_threads = static_cast<unsigned int>(retval.size());
+	if (n_threads == 1) {
+		task(0u,1u,retval[0]);
+		return;
+	}
+	boost::thread_group threads;
+	for (unsigned int t = 0; t < n_threads; ++t) {
+		threads.create_thread(boost::bind(task,t,n_threads,boost::ref(retval[t])));
+	}
+	threads.join_all();
+}
+
+// Sum of the lengths of the shortest paths from the sources with index t, t + n_threads, ..., computed with breadth-first searches.
+// Unreachable vertices count as the largest int, as in Johnson's algorithm with int weights.
+struct path_length_task
+{
+	typedef void result_type;
+	path_length_task(const std::vector<vertices_size_type> &offsets, const std::vector<vertices_size_type> &adj,
+		const std::vector<vertices_size_type> &sources):m_offsets(offsets),m_adj(adj),m_sources(sources) {}
+	void operator()(unsigned int t, unsigned int n_threads, double &retval) const
+	{
+		const vertices_size_type n = m_offsets.size() - 1;
+		std::vector<int> dist(n,-1);
+		std::vector<vertices_size_type> queue(n);
+		retval = 0;
+		for (std::vector<vertices_size_type>::size_type s = t; s < m_sources.size(); s += n_threads) {
+			std::fill(dist.begin(),dist.end(),-1);
+			vertices_size_type head = 0, tail = 0;
+			queue[tail++] = m_sources[s];
+			dist[m_sources[s]] = 0;
+			while (head != tail) {
+				const vertices_size_type v = queue[head++];
+				for (vertices_size_type k = m_offsets[v]; k < m_offsets[v + 1]; ++k) {
+					const vertices_size_type w = m_adj[k];
+					if (dist[w] < 0) {
+						dist[w] = dist[v] + 1;
+						retval += dist[w];
+						queue[tail++] = w;
+					}
+				}
+			}
+			retval += static_cast<double>(n - tail) * std::numeric_limits<int>::max();
+		}
+	}
+	const std::vector<vertices_size_type>	&m_offsets;
+	const std::vector<vertices_size_type>	&m_adj;
+	const std::vector<vertices_size_type>	&m_sources;
+};
+
+// Sum of the clustering coefficients of the vertices with index t, t + n_threads, ... The neighbours of a vertex
+// are marked with their position in its adjacency list, so that the edges among them are counted in a single pass
+// over their own adjacency lists.
+struct clustering_task
+{
+	typedef void result_type;
+	clustering_task(const std::vector<vertices_size_type> &offsets, const std::vector<vertices_size_type> &adj,
+		const std::vector<vertices_size_type> &vertices):m_offsets(offsets),m_adj(adj),m_vertices(vertices) {}
+	void operator()(unsigned int t, unsigned int n_threads, double &retval) const
+	{
+		std::vector<vertices_size_type> pos(m_offsets.size() - 1,0);
+		retval = 0;
+		for (std::vector<vertices_size_type>::size_type s = t; s < m_vertices.size(); s += n_threads) {
+			const vertices_size_type v = m_vertices[s], begin = m_offsets[v], deg = m_offsets[v + 1] - begin;
+			if (deg <= 1) {
+				// In the case that a node only has one neighbour the node has a clustering coefficient of 1.
+				retval += 1;
+				continue;
+			}
+			for (vertices_size_type i = 0; i < deg; ++i) {
+				pos[m_adj[begin + i]] = i + 1;
+			}
+			// Count the edges from the i-th to the j-th neighbour, with i < j.
+			std::size_t n_links = 0;
+			for (vertices_size_type i = 0; i < deg; ++i) {
+				const vertices_size_type u = m_adj[begin + i];
+				for (vertices_size_type k = m_offsets[u]; k < m_offsets[u + 1]; ++k) {
+					if (pos[m_adj[k]] > i + 1) {
+						++n_links;
+					}
+				}
+			}
+			for (vertices_size_type i = 0; i < deg; ++i) {
+				pos[m_adj[begin + i]] = 0;
+			}
+			retval += 2.0 * static_cast<double>(n_links) / (static_cast<double>(deg) * (deg - 1));
+		}
+	}
+	const std::vector<vertices_size_type>	&m_offsets;
+	const std::vector<vertices_size_type>	&m_adj;
+	const std::vector<vertices_size_type>	&m_vertices;
+};
+
+}
+
 /// Calculate average path length.
 /**
- * Calculate and return the average path length of the underlying graph representation using Johnson's all pairs shortest paths
- * algorithm. All edges are given equal weight 1. If a node is unconnected, its distance from any other node will be the highest
- * value representable by the C++ int type. The average path length is calculated as the mean value of the shortest paths between
- * all pairs of vertices.
+ * Calculate and return the average path length of the underlying graph representation. All edges are given equal weight 1.
+ * If a node is unconnected, its distance from any other node will be the highest value representable by the C++ int type.
+ * The average path length is calculated as the mean value of the shortest paths between all pairs of vertices.
  *
- * @return the average path length for the topology.
+ * Equivalent to get_average_shortest_path_length(0,0), i.e., computed exactly using all the available cores.
  *
- * @see http://en.wikipedia.org/wiki/Johnson's_algorithm
- * @see http://www.boost.org/doc/libs/release/libs/graph/doc/johnson_all_pairs_shortest.html
+ * @return the average path length for the topology.
  */
 double base::get_average_shortest_path_length() const
 {
-	std::map<e_descriptor, int> map;
-	boost::associative_property_map<std::map<e_descriptor, int> > map2(map);
-	std::pair<e_iterator, e_iterator> es = boost::edges(m_graph);
-	for(; es.first != es.second; ++es.first) {
-		map2[(*es.first)] = 1;
-	}
+	return get_average_shortest_path_length(0,0);
+}
 
-	// Output matrix.
-	std::vector<std::vector<int> > D(boost::numeric_cast<std::vector<std::vector<int> >::size_type>(get_number_of_vertices()),
-		std::vector<int>(boost::numeric_cast<std::vector<int>::size_type>(get_number_of_vertices())));
-	boost::johnson_all_pairs_shortest_paths(m_graph, D, weight_map(map2));
-	double retval = 0;
-	for (std::vector<std::vector<int> >::size_type i = 0; i < D.size(); ++i) {
-		for (std::vector<int>::size_type j = 0; j < D[i].size(); ++j) {
-			retval += D[i][j];
-		}
-	}
-	if (get_number_of_vertices() < 2) {
+/// Estimate average path length.
+/**
+ * Equivalent to get_average_shortest_path_length(n_samples,n_threads,seed), with the seed drawn from pagmo::rng_generator.
+ *
+ * @param[in] n_samples number of source vertices (0 to use all vertices).
+ * @param[in] n_threads number of threads (0 to use the number of available cores).
+ *
+ * @return the (estimated) average path length for the topology.
+ */
+double base::get_average_shortest_path_length(const vertices_size_type &n_samples, unsigned int n_threads) const
+{
+	return get_average_shortest_path_length(n_samples,n_threads,rng_generator::get<rng_uint32>()());
+}
+
+/// Calculate (or estimate) average path length.
+/**
+ * The shortest paths are computed with a breadth-first search from each source vertex, in O(V + E) time and O(V) memory per
+ * source, with the sources split among n_threads threads. If n_samples is not zero and smaller than the number of vertices,
+ * only n_samples randomly chosen source vertices are used, and the result is an unbiased estimate of the average path length.
+ * The sources depend only on seed.
+ *
+ * @param[in] n_samples number of source vertices (0 to use all vertices).
+ * @param[in] n_threads number of threads (0 to use the number of available cores).
+ * @param[in] seed seed of the random choice of the source vertices.
+ *
+ * @return the (estimated) average path length for the topology.
+ */
+double base::get_average_shortest_path_length(const vertices_size_type &n_samples, unsigned int n_threads, unsigned int seed) const
+{
+	const vertices_size_type n = get_number_of_vertices();
+	if (n < 2) {
 		return 0;
-	} else {
-		return retval / (static_cast<double>(get_number_of_vertices()) * (get_number_of_vertices() - 1));
 	}
+	std::vector<vertices_size_type> offsets, adj;
+	get_csr(offsets,adj);
+	const std::vector<vertices_size_type> sources(sample_vertices(n_samples,seed));
+	std::vector<double> partial(metric_threads(n_threads,sources.size()));
+	run_metric_threads(path_length_task(offsets,adj,sources),partial);
+	double retval = 0;
+	for (std::vector<double>::size_type t = 0; t < partial.size(); ++t) {
+		retval += partial[t];
+	}
+	return retval / (static_cast<double>(sources.size()) * (n - 1));
 }
 
 /// Calculate clustering coefficient
+/**
+ * Equivalent to get_clustering_coefficient(0,0), i.e., computed exactly using all the available cores.
+ *
+ * @return the average clustering coefficient of the topology.
+ */
 double base::get_clustering_coefficient() const
 {
-        // Output value.
-        double cc = 0.0;
-        // Get the vertices.
-        std::pair<v_iterator, v_iterator> vertices;
-        std::vector<base::vertices_size_type> adj_vertices;
-        vertices  = get_vertices();
-        // Loop through vertices and calculate individual clustering coeffient.
-        for(; vertices.first != vertices.second; vertices.first++) {
-                adj_vertices = get_v_adjacent_vertices(*vertices.first);
-                if(adj_vertices.size() > 1) {
-                        // Count the number of nodes in adj_vertices that are adjacent to one another.
-                        for(unsigned int i = 0; i < adj_vertices.size()-1; i++) {
-                                for(unsigned int j = i; j < adj_vertices.size(); j++) {
-                                        if(i != j && are_adjacent(adj_vertices[i],adj_vertices[j])) {
-                                                cc += 2.0/(adj_vertices.size() * (adj_vertices.size() - 1));
-                                        }
-                                }
-                        }
-                        // Now get the clustering coefficient of the node by dividing by...
-                        //c /= adj_vertices.size() * (adj_vertices.size() - 1);
-                } else {
-                    // In the case that a node only has one neighbour
-                    // the node has a clustering coefficient of 1.
-                    cc += 1.0;
-                }
-                // Update the network clustering coefficient
-                //cc += c;
-        }
-        // Average clustering coefficient
-        cc /= get_number_of_vertices();
-        // Output
-        return cc;
+	return get_clustering_coefficient(0,0);
+}
+
+/// Estimate clustering coefficient
+/**
+ * Equivalent to get_clustering_coefficient(n_samples,n_threads,seed), with the seed drawn from pagmo::rng_generator.
+ *
+ * @param[in] n_samples number of vertices (0 to use all vertices).
+ * @param[in] n_threads number of threads (0 to use the number of available cores).
+ *
+ * @return the (estimated) average clustering coefficient of the topology.
+ */
+double base::get_clustering_coefficient(const vertices_size_type &n_samples, unsigned int n_threads) const
+{
+	return get_clustering_coefficient(n_samples,n_threads,rng_generator::get<rng_uint32>()());
+}
+
+/// Calculate (or estimate) clustering coefficient
+/**
+ * The clustering coefficient of a vertex with k > 1 adjacent vertices is the number of edges among them divided by k(k-1)/2, while the
+ * clustering coefficient of a vertex with at most one adjacent vertex is 1. The vertices are split among n_threads threads.
+ * If n_samples is not zero and smaller than the number of vertices, the coefficient is averaged over n_samples randomly chosen vertices.
+ * The vertices depend only on seed.
+ *
+ * @param[in] n_samples number of vertices (0 to use all vertices).
+ * @param[in] n_threads number of threads (0 to use the number of available cores).
+ * @param[in] seed seed of the random choice of the vertices.
+ *
+ * @return the (estimated) average clustering coefficient of the topology.
+ */
+double base::get_clustering_coefficient(const vertices_size_type &n_samples, unsigned int n_threads, unsigned int seed) const
+{
+	std::vector<vertices_size_type> offsets, adj;
+	get_csr(offsets,adj);
+	const std::vector<vertices_size_type> vertices(sample_vertices(n_samples,seed));
+	std::vector<double> partial(metric_threads(n_threads,vertices.size()));
+	run_metric_threads(clustering_task(offsets,adj,vertices),partial);
+	double retval = 0;
+	for (std::vector<double>::size_type t = 0; t < partial.size(); ++t) {
+		retval += partial[t];
+	}
+	return retval / static_cast<double>(vertices.size());
 }
 
 /// Constructs the Degree Distribution
@@ -557,6 +748,97 @@ void base::push_back()
 	connect(get_number_of_vertices() - 1);
 }
 
+/// Push back n vertices.
+/**
+ * The result is equivalent to calling push_back() n times, but topologies can build the new part of the graph in one pass
+ * by re-implementing push_back_bulk().
+ *
+ * @param[in] n number of vertices to be added.
+ */
+void base::push_back(const vertices_size_type &n)
+{
+	push_back_bulk(n);
+}
+
+/// Add vertices in bulk.
+/**
+ * Called by push_back(const vertices_size_type &). The default implementation calls push_back() n times. Topologies whose
+ * construction is costly when growing one vertex at a time can re-implement this method to connect all the new
+ * vertices in a single pass.
+ *
+ * @param[in] n number of vertices to be added.
+ */
+void base::push_back_bulk(const vertices_size_type &n)
+{
+	for (vertices_size_type i = 0; i < n; ++i) {
+		push_back();
+	}
+}
+
+/// Build from the current out-degrees of the vertices of a topology.
+/**
+ * @param[in] t topology whose vertices' degrees are used.
+ */
+base::degree_tree::degree_tree(const base &t):m_tree(1,0)
+{
+	const vertices_size_type n = t.get_number_of_vertices();
+	m_tree.reserve(n + 1);
+	for (vertices_size_type i = 0; i < n; ++i) {
+		add_vertex();
+		const edges_size_type deg = t.get_num_adjacent_vertices(i);
+		for (edges_size_type j = 0; j < deg; ++j) {
+			increment(i);
+		}
+	}
+}
+
+/// Append a vertex with no adjacent vertices.
+void base::degree_tree::add_vertex()
+{
+	// The new node covers the range (i - lowbit(i),i], whose sum is prefix(i - 1) - prefix(i - lowbit(i)),
+	// since the new degree is zero.
+	const vertices_size_type i = m_tree.size();
+	m_tree.push_back(prefix(i - 1) - prefix(i - (i & (~i + 1))));
+}
+
+/// Increment by one the degree of vertex idx.
+void base::degree_tree::increment(const vertices_size_type &idx)
+{
+	for (vertices_size_type i = idx + 1; i < m_tree.size(); i += i & (~i + 1)) {
+		++m_tree[i];
+	}
+}
+
+/// Sum of the degrees of the vertices with index smaller than n.
+base::edges_size_type base::degree_tree::prefix(const vertices_size_type &n) const
+{
+	edges_size_type retval = 0;
+	for (vertices_size_type i = n; i > 0; i -= i & (~i + 1)) {
+		retval += m_tree[i];
+	}
+	return retval;
+}
+
+/// Vertex v such that prefix(v) <= k < prefix(v + 1).
+/**
+ * Drawing k uniformly in [prefix(a),prefix(b)) yields a vertex in [a,b) with probability proportional to its degree.
+ */
+base::vertices_size_type base::degree_tree::find(const edges_size_type &k) const
+{
+	vertices_size_type pos = 0, step = 1;
+	while (step * 2 < m_tree.size()) {
+		step *= 2;
+	}
+	edges_size_type rem = k;
+	for (; step; step /= 2) {
+		if (pos + step < m_tree.size() && m_tree[pos + step] <= rem) {
+			pos += step;
+			rem -= m_tree[pos];
+		}
+	}
+	return pos;
+}
+
 /// Overload stream insertion operator for topology::base.
 /**
  * Will print to stream the output of topology::base::human_readable().
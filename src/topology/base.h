@@ -140,8 +140,13 @@ class __PAGMO_VISIBLE base
 		vertices_size_type get_number_of_vertices() const;
 		edges_size_type get_number_of_edges() const;
 		void push_back();
+		void push_back(const vertices_size_type &);
 		double get_average_shortest_path_length() const;
+		double get_average_shortest_path_length(const vertices_size_type &, unsigned int = 0) const;
+		double get_average_shortest_path_length(const vertices_size_type &, unsigned int, unsigned int) const;
 		double get_clustering_coefficient() const;
+		double get_clustering_coefficient(const vertices_size_type &, unsigned int = 0) const;
+		double get_clustering_coefficient(const vertices_size_type &, unsigned int, unsigned int) const;
 		std::vector<double> get_degree_distribution() const;
 		bool are_adjacent(const vertices_size_type &, const vertices_size_type &) const;
 		bool are_inv_adjacent(const vertices_size_type &,const vertices_size_type &) const;
@@ -172,10 +177,30 @@ class __PAGMO_VISIBLE base
 		 * @param[in] idx index of the newly-added vertex.
 		 */
 		virtual void connect(const vertices_size_type &idx) = 0;
+		virtual void push_back_bulk(const vertices_size_type &);
 		//@}
+		/// Fenwick tree of the vertices' out-degrees.
+		/**
+		 * Helper for the bulk generation of preferential attachment topologies: it allows to draw a vertex with probability proportional
+		 * to its number of adjacent vertices, and to update the degrees, in logarithmic time.
+		 */
+		class degree_tree
+		{
+			public:
+				explicit degree_tree(const base &);
+				void add_vertex();
+				void increment(const vertices_size_type &);
+				edges_size_type prefix(const vertices_size_type &) const;
+				vertices_size_type find(const edges_size_type &) const;
+			private:
+				// 1-based Fenwick tree, m_tree[0] is unused.
+				std::vector<edges_size_type> m_tree;
+		};
 		virtual std::string human_readable_extra() const;
 	private:
 		void check_vertex_index(const vertices_size_type &) const;
+		void get_csr(std::vector<vertices_size_type> &, std::vector<vertices_size_type> &) const;
+		std::vector<vertices_size_type> sample_vertices(const vertices_size_type &, unsigned int) const;
 		void set_weight(const e_descriptor &, double);
 		double get_weight(const e_descriptor &) const;
 		friend class boost::serialization::access;
@@ -22,6 +22,7 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <cmath>
 #include <sstream>
 #include <string>
 
@@ -63,6 +64,34 @@ void erdos_renyi::connect(const vertices_size_type &n)
 	}
 }
 
+// Bulk insertion: each new vertex is connected to the vertices before it. Instead of testing every pair, the
+// number of vertices skipped before the next connection is drawn from the geometric distribution, so that the
+// cost is proportional to the number of vertices plus the number of edges.
+void erdos_renyi::push_back_bulk(const vertices_size_type &n)
+{
+	if (m_prob == 0 || m_prob == 1) {
+		base::push_back_bulk(n);
+		return;
+	}
+	const double log_q = std::log(1. - m_prob);
+	for (vertices_size_type i = 0; i < n; ++i) {
+		add_vertex();
+		const vertices_size_type idx = get_number_of_vertices() - 1;
+		vertices_size_type j = 0;
+		while (true) {
+			// 1 - m_drng() is in (0,1], so that the logarithm is finite.
+			const double skip = std::floor(std::log(1. - m_drng()) / log_q);
+			if (skip >= static_cast<double>(idx - j)) {
+				break;
+			}
+			j += static_cast<vertices_size_type>(skip);
+			add_edge(idx,j);
+			add_edge(j,idx);
+			++j;
+		}
+	}
+}
+
 std::string erdos_renyi::human_readable_extra() const
 {
 	std::ostringstream oss;
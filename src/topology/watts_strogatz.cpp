@@ -154,6 +154,21 @@ void watts_strogatz::connect(const vertices_size_type &n)
 	}
 }
 
+// Bulk insertion: once the kernel size is exceeded each push_back() rewires the whole model, so the vertices are
+// added first and the model is rewired only once.
+void watts_strogatz::push_back_bulk(const vertices_size_type &n)
+{
+	if (get_number_of_vertices() + n <= m_k + 1) {
+		base::push_back_bulk(n);
+		return;
+	}
+	for (vertices_size_type i = 0; i < n; ++i) {
+		add_vertex();
+	}
+	remove_all_edges();
+	rewire();
+}
+
 std::string watts_strogatz::get_name() const
 {
 	return "Watts-Strogatz";
@@ -62,6 +62,7 @@ class __PAGMO_VISIBLE watts_strogatz: public base
 		std::string get_name() const;
 	protected:
 		void connect(const vertices_size_type &);
+		void push_back_bulk(const vertices_size_type &);
 	private:
 		void rewire();
 		friend class boost::serialization::access;
@@ -0,0 +1,232 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/thread/locks.hpp>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+#include "../exceptions.h"
+#include "../problem/base.h"
+#include "../types.h"
+#include "async_evaluator.h"
+
+namespace pagmo { namespace util {
+
+/// Constructor.
+/**
+ * Starts the worker threads, each one with its own clone of the problem.
+ *
+ * @param[in] p problem to be evaluated. It must outlive the evaluator.
+ * @param[in] n_threads number of worker threads. If zero, the number of hardware threads is used.
+ * @param[in] capacity maximum number of decision vectors waiting to be evaluated. If zero, it is set to the number of worker threads.
+ *
+ * @throws std::runtime_error if the threads cannot be started.
+ */
+async_evaluator::async_evaluator(const problem::base &p, unsigned int n_threads, std::size_t capacity):
+	m_prob(p),m_capacity(capacity ? capacity : (n_threads ? n_threads : std::max(boost::thread::hardware_concurrency(),1u))),
+	m_n_pending(0),m_stop(false),m_n_threads(n_threads ? n_threads : std::max(boost::thread::hardware_concurrency(),1u))
+{
+	try {
+		for (std::size_t i = 0; i < m_n_threads; ++i) {
+			m_workers.create_thread(boost::bind(&async_evaluator::worker,this,p.clone()));
+		}
+	} catch (...) {
+		{
+			boost::lock_guard<boost::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_task_cond.notify_all();
+		m_workers.join_all();
+		pagmo_throw(std::runtime_error,"failed to launch the thread");
+	}
+}
+
+/// Destructor.
+/**
+ * Decision vectors waiting to be evaluated are discarded. Waits for the ongoing evaluations to end.
+ */
+async_evaluator::~async_evaluator()
+{
+	{
+		boost::lock_guard<boost::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_task_cond.notify_all();
+	m_workers.join_all();
+}
+
+// Body of the worker threads: evaluate the queued decision vectors on prob until the evaluator is destroyed.
+void async_evaluator::worker(problem::base_ptr prob)
+{
+	while (true) {
+		task t;
+		{
+			boost::unique_lock<boost::mutex> lock(m_mutex);
+			while (m_tasks.empty() && !m_stop) {
+				m_task_cond.wait(lock);
+			}
+			if (m_stop) {
+				return;
+			}
+			t.tag = m_tasks.front().tag;
+			t.x.swap(m_tasks.front().x);
+			m_tasks.pop_front();
+		}
+		m_done_cond.notify_all();
+		result r;
+		r.tag = t.tag;
+		std::string error;
+		try {
+			r.f = prob->objfun(t.x);
+			r.c = prob->compute_constraints(t.x);
+		} catch (const std::exception &e) {
+			error = e.what();
+		} catch (...) {
+			error = "unknown exception caught";
+		}
+		r.x.swap(t.x);
+		{
+			boost::lock_guard<boost::mutex> lock(m_mutex);
+			m_results.push_back(r);
+			m_errors.push_back(error);
+		}
+		m_done_cond.notify_all();
+	}
+}
+
+/// Submit a decision vector.
+/**
+ * The decision vector is queued for evaluation. If the queue is full, waits until a worker takes the first decision vector in the queue.
+ *
+ * @param[in] x decision vector to be evaluated.
+ * @param[in] tag value returned with the result, e.g., to identify the individual being evaluated.
+ *
+ * @throws value_error if the dimension of x is not the dimension of the problem.
+ */
+void async_evaluator::submit(const decision_vector &x, std::size_t tag)
+{
+	if (x.size() != m_prob.get_dimension()) {
+		pagmo_throw(value_error,"wrong decision vector size when submitting to the asynchronous evaluator");
+	}
+	task t;
+	t.tag = tag;
+	t.x = x;
+	{
+		boost::unique_lock<boost::mutex> lock(m_mutex);
+		while (m_tasks.size() >= m_capacity) {
+			m_done_cond.wait(lock);
+		}
+		m_tasks.push_back(t);
+		++m_n_pending;
+	}
+	m_task_cond.notify_one();
+}
+
+// Pop the first result, with the lock held, updating the counters of the problem.
+void async_evaluator::collect(result &r)
+{
+	pagmo_assert(!m_results.empty() && m_results.size() == m_errors.size() && m_n_pending);
+	std::string error;
+	error.swap(m_errors.front());
+	m_errors.pop_front();
+	r.tag = m_results.front().tag;
+	r.x.swap(m_results.front().x);
+	r.f.swap(m_results.front().f);
+	r.c.swap(m_results.front().c);
+	m_results.pop_front();
+	--m_n_pending;
+	if (!error.empty()) {
+		pagmo_throw(std::runtime_error,"error during asynchronous evaluation: " + error);
+	}
+	++m_prob.m_fevals;
+	if (m_prob.get_c_dimension()) {
+		++m_prob.m_cevals;
+	}
+}
+
+/// Get the next result.
+/**
+ * Waits until an evaluation is completed and returns its result. Results are returned in order of completion.
+ *
+ * @param[out] r result of the evaluation.
+ *
+ * @throws value_error if there are no pending evaluations.
+ * @throws std::runtime_error if the evaluation raised an exception.
+ */
+void async_evaluator::get(result &r)
+{
+	boost::unique_lock<boost::mutex> lock(m_mutex);
+	if (!m_n_pending) {
+		pagmo_throw(value_error,"no pending evaluations in the asynchronous evaluator");
+	}
+	while (m_results.empty()) {
+		m_done_cond.wait(lock);
+	}
+	collect(r);
+}
+
+/// Get the next result, if available.
+/**
+ * Same as get(), but does not wait for an evaluation to be completed.
+ *
+ * @param[out] r result of the evaluation, if any.
+ *
+ * @return true if a result was available, false otherwise.
+ *
+ * @throws std::runtime_error if the evaluation raised an exception.
+ */
+bool async_evaluator::try_get(result &r)
+{
+	boost::lock_guard<boost::mutex> lock(m_mutex);
+	if (m_results.empty()) {
+		return false;
+	}
+	collect(r);
+	return true;
+}
+
+/// Number of worker threads.
+/**
+ * @return the number of worker threads.
+ */
+std::size_t async_evaluator::get_n_threads() const
+{
+	return m_n_threads;
+}
+
+/// Number of pending evaluations.
+/**
+ * @return the number of submitted decision vectors whose result has not been retrieved yet.
+ */
+std::size_t async_evaluator::get_n_pending() const
+{
+	boost::lock_guard<boost::mutex> lock(m_mutex);
+	return m_n_pending;
+}
+
+}}
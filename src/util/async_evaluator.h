@@ -0,0 +1,108 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_ASYNC_EVALUATOR_H
+#define PAGMO_UTIL_ASYNC_EVALUATOR_H
+
+#include <boost/noncopyable.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "../config.h"
+#include "../problem/base.h"
+#include "../types.h"
+
+namespace pagmo { namespace util {
+
+/// Asynchronous evaluation of decision vectors.
+/**
+ * Evaluates decision vectors on a pool of worker threads, each one owning a clone of the problem. Decision vectors are
+ * submitted to a bounded queue and their fitness and constraint vectors are returned, in order of completion, as soon as
+ * each evaluation is over. Algorithms built on top of this class do not wait for a whole generation to be evaluated:
+ * whenever a result is retrieved a new decision vector can be submitted, so that all the workers stay busy even if the cost of
+ * the evaluations varies widely.
+ *
+ * The objective function and constraints evaluations performed by the workers are added to the counters of the problem passed
+ * upon construction as the results are retrieved.
+ *
+ * The methods of this class are meant to be called from a single thread.
+ */
+class __PAGMO_VISIBLE async_evaluator: private boost::noncopyable
+{
+	public:
+		/// Result of an evaluation.
+		struct result
+		{
+			/// Tag given upon submission.
+			std::size_t		tag;
+			/// Decision vector.
+			decision_vector		x;
+			/// Fitness vector.
+			fitness_vector		f;
+			/// Constraint vector.
+			constraint_vector	c;
+		};
+		explicit async_evaluator(const problem::base &, unsigned int = 0, std::size_t = 0);
+		~async_evaluator();
+		void submit(const decision_vector &, std::size_t = 0);
+		void get(result &);
+		bool try_get(result &);
+		std::size_t get_n_threads() const;
+		std::size_t get_n_pending() const;
+	private:
+		struct task
+		{
+			std::size_t		tag;
+			decision_vector		x;
+		};
+		void worker(problem::base_ptr);
+		void collect(result &);
+		// Problem whose counters are updated.
+		const problem::base			&m_prob;
+		// Maximum number of decision vectors waiting to be evaluated.
+		const std::size_t			m_capacity;
+		mutable boost::mutex			m_mutex;
+		// Signalled when a task is queued or the workers must stop.
+		boost::condition_variable		m_task_cond;
+		// Signalled when a task is taken by a worker or a result is ready.
+		boost::condition_variable		m_done_cond;
+		std::deque<task>			m_tasks;
+		std::deque<result>			m_results;
+		// Error raised by the evaluation of one of the results, to be thrown upon retrieval.
+		std::deque<std::string>			m_errors;
+		// Number of submitted decision vectors whose result has not been retrieved yet.
+		std::size_t				m_n_pending;
+		bool					m_stop;
+		boost::thread_group			m_workers;
+		std::size_t				m_n_threads;
+};
+
+}}
+
+#endif
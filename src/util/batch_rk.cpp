@@ -0,0 +1,195 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "../exceptions.h"
+#include "batch_rk.h"
+
+namespace pagmo{ namespace util {
+
+// Dormand-Prince 5(4) tableau. Row s of a holds the coefficients of stage s + 2, the last row being the
+// weights of the fifth order solution (which is also the point where the first stage of the next step is
+// evaluated). e holds the differences between the weights of the fifth and fourth order solutions.
+static const double a[6][6] = {
+	{1./5.},
+	{3./40., 9./40.},
+	{44./45., -56./15., 32./9.},
+	{19372./6561., -25360./2187., 64448./6561., -212./729.},
+	{9017./3168., -355./33., 46732./5247., 49./176., -5103./18656.},
+	{35./384., 0., 500./1113., 125./192., -2187./6784., 11./84.}
+};
+static const double e[7] = {71./57600., 0., -71./16695., 71./1920., -17253./339200., 22./525., -1./40.};
+
+/// Constructor.
+/**
+ * @param[in] dim dimension of the system.
+ * @param[in] tol absolute tolerance on the local error of each component. If zero, the integration
+ * proceeds with the fixed step h.
+ * @param[in] h initial (or fixed) step size.
+ *
+ * @throws value_error if dim is zero, tol is negative or h is not positive.
+ */
+batch_rk::batch_rk(unsigned int dim, double tol, double h):m_dim(dim),m_tol(tol),m_h(h)
+{
+	if (dim == 0) {
+		pagmo_throw(value_error,"the dimension of the system must be positive");
+	}
+	if (!(tol >= 0)) {
+		pagmo_throw(value_error,"the tolerance must be non-negative");
+	}
+	if (!(h > 0)) {
+		pagmo_throw(value_error,"the step size must be positive");
+	}
+}
+
+/// Integrate a batch of systems.
+/**
+ * Advances the n systems whose initial states are in y from t0 to tf.
+ *
+ * @param[in] f right-hand side of the system.
+ * @param[in,out] y dim x n matrix of the states (component i of system k being y[i * n + k]), overwritten
+ * with the final states.
+ * @param[in] n number of systems.
+ * @param[in] t0 initial time.
+ * @param[in] tf final time.
+ *
+ * @throws value_error if the size of y is not dim * n, if tf < t0 or if the adaptive step size underflows.
+ */
+void batch_rk::integrate(const system &f, std::vector<double> &y, std::size_t n, double t0, double tf) const
+{
+	const std::size_t dim = m_dim, stride = n, size = dim * n;
+	if (y.size() != size) {
+		pagmo_throw(value_error,"the size of the states is not consistent with the dimension and the number of systems");
+	}
+	if (!(tf >= t0)) {
+		pagmo_throw(value_error,"the final time must not be smaller than the initial time");
+	}
+	if (n == 0 || tf == t0) {
+		return;
+	}
+	// Working copy of the states, kept compact as the systems leave the batch: column k holds the system idx[k].
+	std::vector<double> cur(y), tmp(size), k(7 * size);
+	std::vector<double> t(n,t0), h(n,m_h), step(n);
+	std::vector<std::size_t> idx(n);
+	for (std::size_t j = 0; j < n; ++j) {
+		idx[j] = j;
+	}
+	std::size_t n_act = n;
+	f(&k[0],&cur[0],n_act,stride);
+	while (n_act) {
+		for (std::size_t j = 0; j < n_act; ++j) {
+			step[j] = std::min(h[j],tf - t[j]);
+		}
+		// Stages 2 to 7. After the loop, tmp holds the fifth order solution.
+		for (std::size_t s = 1; s < 7; ++s) {
+			for (std::size_t i = 0; i < dim; ++i) {
+				double *out = &tmp[i * stride];
+				const double *y0 = &cur[i * stride];
+				for (std::size_t j = 0; j < n_act; ++j) {
+					out[j] = 0;
+				}
+				for (std::size_t l = 0; l < s; ++l) {
+					const double c = a[s - 1][l];
+					const double *kl = &k[l * size + i * stride];
+					for (std::size_t j = 0; j < n_act; ++j) {
+						out[j] += c * kl[j];
+					}
+				}
+				for (std::size_t j = 0; j < n_act; ++j) {
+					out[j] = y0[j] + step[j] * out[j];
+				}
+			}
+			f(&k[s * size],&tmp[0],n_act,stride);
+		}
+		for (std::size_t j = 0; j < n_act; ++j) {
+			if (m_tol > 0) {
+				double ratio = 0;
+				for (std::size_t i = 0; i < dim; ++i) {
+					double err = 0;
+					for (std::size_t l = 0; l < 7; ++l) {
+						err += e[l] * k[l * size + i * stride + j];
+					}
+					ratio = std::max(ratio,std::abs(step[j] * err) / m_tol);
+				}
+				if (ratio > 1) {
+					// Reject the step.
+					h[j] = step[j] * std::max(0.2,0.9 * std::pow(ratio,-0.25));
+					if (h[j] < 16 * std::numeric_limits<double>::epsilon() * std::max(std::abs(t[j]),1.)) {
+						pagmo_throw(value_error,"step size underflow during the integration");
+					}
+					continue;
+				}
+				h[j] = step[j] * (ratio > 0 ? std::min(5.,0.9 * std::pow(ratio,-0.2)) : 5.);
+			}
+			t[j] = (step[j] == tf - t[j]) ? tf : t[j] + step[j];
+			for (std::size_t i = 0; i < dim; ++i) {
+				cur[i * stride + j] = tmp[i * stride + j];
+				// First same as last.
+				k[i * stride + j] = k[6 * size + i * stride + j];
+			}
+		}
+		// Systems that reached the final time leave the batch, replaced by the last active one.
+		for (std::size_t j = 0; j < n_act;) {
+			if (t[j] < tf) {
+				++j;
+				continue;
+			}
+			const std::size_t last = n_act - 1;
+			for (std::size_t i = 0; i < dim; ++i) {
+				y[i * stride + idx[j]] = cur[i * stride + j];
+				cur[i * stride + j] = cur[i * stride + last];
+				k[i * stride + j] = k[i * stride + last];
+			}
+			t[j] = t[last];
+			h[j] = h[last];
+			idx[j] = idx[last];
+			--n_act;
+		}
+	}
+}
+
+/// Dimension of the system.
+unsigned int batch_rk::get_dimension() const
+{
+	return m_dim;
+}
+
+/// Absolute tolerance (zero for fixed step integration).
+double batch_rk::get_tolerance() const
+{
+	return m_tol;
+}
+
+/// Initial (or fixed) step size.
+double batch_rk::get_step() const
+{
+	return m_h;
+}
+
+}}
@@ -0,0 +1,80 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_BATCH_RK_H
+#define PAGMO_UTIL_BATCH_RK_H
+
+#include <cstddef>
+#include <vector>
+
+#include "../config.h"
+
+namespace pagmo{ namespace util {
+
+/// Batched Runge-Kutta integrator
+/**
+ * Integrates at once n copies of an autonomous system of ordinary differential equations of dimension dim,
+ * started from different initial conditions, with the Dormand-Prince 5(4) embedded pair. States are stored in
+ * structure-of-arrays layout: component i of system k is y[i * stride + k]. The right-hand side is evaluated on
+ * the whole batch at once, with loops over the systems running on contiguous memory that the compiler can
+ * vectorise.
+ *
+ * With a positive tolerance each system advances with its own adaptive step, controlled so that the estimated
+ * local error on each component stays below the tolerance. Systems reaching the final time leave the batch,
+ * which is kept compact. With a zero tolerance, all systems advance with the same fixed step.
+ *
+ * The integrator holds no state besides its settings, so that the same object can be used concurrently.
+ */
+class __PAGMO_VISIBLE batch_rk
+{
+	public:
+		/// Right-hand side of a batch of systems.
+		struct system
+		{
+			virtual ~system() {}
+			/// Derivatives of the systems.
+			/**
+			 * @param[out] dydt derivatives of the n systems, in structure-of-arrays layout.
+			 * @param[in] y states of the n systems, in structure-of-arrays layout.
+			 * @param[in] n number of systems.
+			 * @param[in] stride distance between two components of the same system in y and dydt.
+			 */
+			virtual void operator()(double *dydt, const double *y, std::size_t n, std::size_t stride) const = 0;
+		};
+
+		batch_rk(unsigned int, double, double = 1E-6);
+		void integrate(const system &, std::vector<double> &, std::size_t, double, double) const;
+		unsigned int get_dimension() const;
+		double get_tolerance() const;
+		double get_step() const;
+
+	private:
+		unsigned int	m_dim;
+		double		m_tol;
+		double		m_h;
+};
+
+}}
+
+#endif
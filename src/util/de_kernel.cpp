@@ -0,0 +1,371 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <boost/numeric/conversion/cast.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "../exceptions.h"
+#include "../rng.h"
+#include "../types.h"
+#include "de_kernel.h"
+
+namespace pagmo { namespace util {
+
+// Maximum number of random members per trial.
+static const unsigned int max_members = 7;
+
+// The classic DE variants. The exponential and binomial versions of each strategy are consecutive.
+static const de_kernel::scheme classic_variants[18] = {
+	// DE/best/1
+	{de_kernel::best,1,{de_kernel::r2},{de_kernel::r3},de_kernel::exponential},
+	// DE/rand/1
+	{de_kernel::r1,1,{de_kernel::r2},{de_kernel::r3},de_kernel::exponential},
+	// DE/rand-to-best/1
+	{de_kernel::current,2,{de_kernel::best,de_kernel::r1},{de_kernel::current,de_kernel::r2},de_kernel::exponential},
+	// DE/best/2
+	{de_kernel::best,2,{de_kernel::r1,de_kernel::r2},{de_kernel::r3,de_kernel::r4},de_kernel::exponential},
+	// DE/rand/2
+	{de_kernel::r5,2,{de_kernel::r1,de_kernel::r2},{de_kernel::r3,de_kernel::r4},de_kernel::exponential},
+	{de_kernel::best,1,{de_kernel::r2},{de_kernel::r3},de_kernel::binomial},
+	{de_kernel::r1,1,{de_kernel::r2},{de_kernel::r3},de_kernel::binomial},
+	{de_kernel::current,2,{de_kernel::best,de_kernel::r1},{de_kernel::current,de_kernel::r2},de_kernel::binomial},
+	{de_kernel::best,2,{de_kernel::r1,de_kernel::r2},{de_kernel::r3,de_kernel::r4},de_kernel::binomial},
+	{de_kernel::r5,2,{de_kernel::r1,de_kernel::r2},{de_kernel::r3,de_kernel::r4},de_kernel::binomial},
+	// DE/best/3
+	{de_kernel::best,3,{de_kernel::r1,de_kernel::r3,de_kernel::r5},{de_kernel::r2,de_kernel::r4,de_kernel::r6},de_kernel::exponential},
+	{de_kernel::best,3,{de_kernel::r1,de_kernel::r3,de_kernel::r5},{de_kernel::r2,de_kernel::r4,de_kernel::r6},de_kernel::binomial},
+	// DE/rand/3
+	{de_kernel::r7,3,{de_kernel::r1,de_kernel::r3,de_kernel::r5},{de_kernel::r2,de_kernel::r4,de_kernel::r6},de_kernel::exponential},
+	{de_kernel::r7,3,{de_kernel::r1,de_kernel::r3,de_kernel::r5},{de_kernel::r2,de_kernel::r4,de_kernel::r6},de_kernel::binomial},
+	// DE/rand-to-current/2
+	{de_kernel::r7,2,{de_kernel::r1,de_kernel::r3},{de_kernel::current,de_kernel::r4},de_kernel::exponential},
+	{de_kernel::r7,2,{de_kernel::r1,de_kernel::r3},{de_kernel::current,de_kernel::r4},de_kernel::binomial},
+	// DE/rand-to-best-and-current/2
+	{de_kernel::r7,2,{de_kernel::r1,de_kernel::best},{de_kernel::current,de_kernel::r4},de_kernel::exponential},
+	{de_kernel::r7,2,{de_kernel::r1,de_kernel::best},{de_kernel::current,de_kernel::r4},de_kernel::binomial}
+};
+
+/// Classic DE variant.
+/**
+ * Returns the mutation and crossover scheme of the variants used by algorithm::de, algorithm::jde and algorithm::de_1220:
+ * 1 - DE/best/1/exp, 2 - DE/rand/1/exp, 3 - DE/rand-to-best/1/exp, 4 - DE/best/2/exp, 5 - DE/rand/2/exp,
+ * 6 ... 10 - the same strategies with binomial crossover, 11 - DE/best/3/exp, 12 - DE/best/3/bin, 13 - DE/rand/3/exp,
+ * 14 - DE/rand/3/bin, 15 - DE/rand-to-current/2/exp, 16 - DE/rand-to-current/2/bin, 17 - DE/rand-to-best-and-current/2/exp,
+ * 18 - DE/rand-to-best-and-current/2/bin.
+ *
+ * @param[in] variant index of the variant, in [1,18].
+ *
+ * @return const reference to the scheme of the variant.
+ *
+ * @throws value_error if variant is not in [1,18].
+ */
+const de_kernel::scheme &de_kernel::get_variant(int variant)
+{
+	if (variant < 1 || variant > 18) {
+		pagmo_throw(value_error,"variant index must be one of 1 ... 18");
+	}
+	return classic_variants[variant - 1];
+}
+
+/// Constructor.
+/**
+ * The population matrix is initialised to zero, and the donors to the targets.
+ *
+ * @param[in] np population size.
+ * @param[in] lb lower bounds of the decision vectors.
+ * @param[in] ub upper bounds of the decision vectors.
+ * @param[in] dc number of evolved components (at the beginning of the decision vectors).
+ *
+ * @throws value_error if the bounds have different sizes or if dc is zero or larger than the dimension.
+ */
+de_kernel::de_kernel(std::size_t np, const decision_vector &lb, const decision_vector &ub, std::size_t dc):
+	m_np(np),m_dim(lb.size()),m_dc(dc),m_lb(lb),m_ub(ub),m_x((np + 1) * lb.size()),m_members(np * max_members),
+	m_donors(np),m_u_cross(np * dc),m_u_bounds(np * dc),m_start(np),m_trials(np,decision_vector(lb.size()))
+{
+	if (lb.size() != ub.size()) {
+		pagmo_throw(value_error,"lower and upper bounds must have the same size");
+	}
+	if (dc == 0 || dc > lb.size()) {
+		pagmo_throw(value_error,"the number of evolved components must be in [1,dimension]");
+	}
+	for (std::size_t i = 0; i < np; ++i) {
+		m_donors[i] = i;
+	}
+}
+
+/// Set a member of the population.
+/**
+ * @param[in] i position of the member.
+ * @param[in] x decision vector.
+ */
+void de_kernel::set_x(std::size_t i, const decision_vector &x)
+{
+	pagmo_assert(i < m_np && x.size() == m_dim);
+	std::copy(x.begin(),x.end(),m_x.begin() + i * m_dim);
+}
+
+/// Get a member of the population.
+/**
+ * @param[in] i position of the member.
+ *
+ * @return pointer to the first component of the member.
+ */
+const double *de_kernel::get_x(std::size_t i) const
+{
+	pagmo_assert(i < m_np);
+	return &m_x[i * m_dim];
+}
+
+/// Set the best decision vector.
+/**
+ * @param[in] x best decision vector, used by the schemes involving de_kernel::best.
+ */
+void de_kernel::set_best(const decision_vector &x)
+{
+	pagmo_assert(x.size() == m_dim);
+	std::copy(x.begin(),x.end(),m_x.begin() + m_np * m_dim);
+}
+
+/// Draw the random members.
+/**
+ * For each trial, draws n distinct members of the population, all different from the target.
+ *
+ * @param[in] n number of members per trial, at most 7.
+ * @param[in] urng random number generator.
+ *
+ * @throws value_error if n is larger than 7 or if the population has less than n + 1 members.
+ */
+void de_kernel::draw_members(unsigned int n, rng_uint32 &urng)
+{
+	if (n > max_members) {
+		pagmo_throw(value_error,"at most 7 random members can be drawn");
+	}
+	if (m_np <= n) {
+		pagmo_throw(value_error,"population is too small to draw the random members");
+	}
+	for (std::size_t i = 0; i < m_np; ++i) {
+		draw_trial_members(i,n,urng);
+	}
+}
+
+// Draw n distinct members of the population, all different from target i.
+void de_kernel::draw_trial_members(std::size_t i, unsigned int n, rng_uint32 &urng)
+{
+	boost::uniform_int<int> p_idx(0,boost::numeric_cast<int>(m_np) - 1);
+	std::size_t *r = &m_members[i * max_members];
+	for (unsigned int k = 0; k < n; ++k) {
+		bool taken;
+		do {
+			r[k] = p_idx(urng);
+			taken = (r[k] == i);
+			for (unsigned int l = 0; l < k; ++l) {
+				taken = taken || (r[k] == r[l]);
+			}
+		} while (taken);
+	}
+}
+
+/// Random member of a trial.
+/**
+ * Can be used to set the members of a trial directly, instead of drawing them with draw_members().
+ *
+ * @param[in] i position of the trial.
+ * @param[in] k index of the member (de_kernel::r1 is 0).
+ *
+ * @return reference to the position in the population of the member.
+ */
+std::size_t &de_kernel::member(std::size_t i, unsigned int k)
+{
+	pagmo_assert(i < m_np && k < max_members);
+	return m_members[i * max_members + k];
+}
+
+/// Random member of a trial.
+/**
+ * @param[in] i position of the trial.
+ * @param[in] k index of the member (de_kernel::r1 is 0).
+ *
+ * @return position in the population of the member.
+ */
+std::size_t de_kernel::member(std::size_t i, unsigned int k) const
+{
+	pagmo_assert(i < m_np && k < max_members);
+	return m_members[i * max_members + k];
+}
+
+/// Set the donor of a trial.
+/**
+ * The components of trial i which are not taken from the mutant are taken from member j of the population.
+ *
+ * @param[in] i position of the trial.
+ * @param[in] j position of the donor.
+ */
+void de_kernel::set_donor(std::size_t i, std::size_t j)
+{
+	pagmo_assert(i < m_np && j < m_np);
+	m_donors[i] = j;
+}
+
+// Row of the population matrix corresponding to an operand of trial i.
+const double *de_kernel::row(operand op, std::size_t i) const
+{
+	switch (op) {
+		case current:
+			return &m_x[i * m_dim];
+		case best:
+			return &m_x[m_np * m_dim];
+		default:
+			return &m_x[m_members[i * max_members + op] * m_dim];
+	}
+}
+
+/// Build the trial vectors.
+/**
+ * The random numbers needed by crossover and bounds handling are drawn first: the starting components of the
+ * crossovers from urng, then two blocks of np * dc uniform numbers from drng. Mutation, crossover and bounds handling
+ * are then run row by row.
+ *
+ * @param[in] schemes scheme of each trial.
+ * @param[in] F scale factor of each trial.
+ * @param[in] CR crossover probability of each trial.
+ * @param[in] drng random number generator for the real numbers.
+ * @param[in] urng random number generator for the starting components of the crossovers.
+ */
+void de_kernel::make_trials(const std::vector<const scheme *> &schemes, const std::vector<double> &F, const std::vector<double> &CR,
+	rng_double &drng, rng_uint32 &urng)
+{
+	pagmo_assert(schemes.size() == m_np && F.size() == m_np && CR.size() == m_np);
+	boost::uniform_int<int> c_idx(0,boost::numeric_cast<int>(m_dc) - 1);
+	for (std::size_t i = 0; i < m_np; ++i) {
+		m_start[i] = c_idx(urng);
+	}
+	for (std::size_t k = 0; k < m_u_cross.size(); ++k) {
+		m_u_cross[k] = drng();
+	}
+	for (std::size_t k = 0; k < m_u_bounds.size(); ++k) {
+		m_u_bounds[k] = drng();
+	}
+	for (std::size_t i = 0; i < m_np; ++i) {
+		build_trial(i,*schemes[i],F[i],CR[i]);
+	}
+}
+
+/// Build a single trial vector.
+/**
+ * Used by the steady-state algorithms, which build a new trial vector for a target as soon as the previous one has been
+ * evaluated. Draws the n random members of trial i, the starting component of its crossover from urng and dc uniform
+ * numbers for crossover and dc for bounds handling from drng, then builds the trial as make_trials() does. The other
+ * trial vectors are left untouched.
+ *
+ * @param[in] i position of the trial.
+ * @param[in] n number of random members of the trial, at most 7.
+ * @param[in] s scheme of the trial.
+ * @param[in] F scale factor of the trial.
+ * @param[in] CR crossover probability of the trial.
+ * @param[in] drng random number generator for the real numbers.
+ * @param[in] urng random number generator for the members and the starting component of the crossover.
+ *
+ * @return const reference to the trial vector.
+ *
+ * @throws value_error if n is larger than 7 or if the population has less than n + 1 members.
+ */
+const decision_vector &de_kernel::make_trial(std::size_t i, unsigned int n, const scheme &s, double F, double CR, rng_double &drng, rng_uint32 &urng)
+{
+	pagmo_assert(i < m_np);
+	if (n > max_members) {
+		pagmo_throw(value_error,"at most 7 random members can be drawn");
+	}
+	if (m_np <= n) {
+		pagmo_throw(value_error,"population is too small to draw the random members");
+	}
+	draw_trial_members(i,n,urng);
+	m_start[i] = boost::uniform_int<int>(0,boost::numeric_cast<int>(m_dc) - 1)(urng);
+	for (std::size_t j = 0; j < m_dc; ++j) {
+		m_u_cross[i * m_dc + j] = drng();
+	}
+	for (std::size_t j = 0; j < m_dc; ++j) {
+		m_u_bounds[i * m_dc + j] = drng();
+	}
+	build_trial(i,s,F,CR);
+	return m_trials[i];
+}
+
+// Mutation, crossover and bounds handling of trial i, using the random numbers already drawn.
+void de_kernel::build_trial(std::size_t i, const scheme &s, double f, double cr)
+{
+	const std::size_t dc = m_dc;
+	const double *lb = &m_lb[0], *ub = &m_ub[0];
+	double *t = &m_trials[i][0];
+	// Mutation.
+	const double *b = row(s.base,i);
+	for (std::size_t j = 0; j < dc; ++j) {
+		t[j] = b[j];
+	}
+	for (unsigned int k = 0; k < s.n_pairs; ++k) {
+		const double *p = row(s.plus[k],i), *q = row(s.minus[k],i);
+		for (std::size_t j = 0; j < dc; ++j) {
+			t[j] += f * (p[j] - q[j]);
+		}
+	}
+	// Crossover: component start is always taken from the mutant.
+	const double *d = &m_x[m_donors[i] * m_dim], *u = &m_u_cross[i * dc];
+	const std::size_t n = m_start[i];
+	if (s.crossover == binomial) {
+		for (std::size_t j = 0; j < dc; ++j) {
+			t[j] = (u[j] < cr || j == n) ? t[j] : d[j];
+		}
+	} else {
+		std::size_t L = 1;
+		while (L < dc && u[L - 1] < cr) {
+			++L;
+		}
+		for (std::size_t j = 0; j < dc; ++j) {
+			t[j] = ((j >= n ? j - n : j + dc - n) < L) ? t[j] : d[j];
+		}
+	}
+	// Bounds handling.
+	const double *v = &m_u_bounds[i * dc];
+	for (std::size_t j = 0; j < dc; ++j) {
+		t[j] = (t[j] < lb[j] || t[j] > ub[j]) ? lb[j] + v[j] * (ub[j] - lb[j]) : t[j];
+	}
+	// The remaining components are those of the target.
+	const double *x = &m_x[i * m_dim];
+	for (std::size_t j = dc; j < m_dim; ++j) {
+		t[j] = x[j];
+	}
+}
+
+/// Get the trial vectors.
+/**
+ * @return const reference to the trial vectors built by the last calls to make_trials() and make_trial().
+ */
+const std::vector<decision_vector> &de_kernel::get_trials() const
+{
+	return m_trials;
+}
+
+}}
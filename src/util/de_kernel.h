@@ -0,0 +1,157 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_DE_KERNEL_H
+#define PAGMO_UTIL_DE_KERNEL_H
+
+#include <cstddef>
+#include <vector>
+
+#include "../config.h"
+#include "../rng.h"
+#include "../types.h"
+
+namespace pagmo{ namespace util {
+
+/// Generation kernel of differential evolution
+/**
+ * Builds at once the trial vectors of a whole generation of a differential evolution algorithm. The population is stored
+ * in a contiguous matrix, one decision vector per row, followed by the best decision vector. Each trial vector is obtained
+ * from its target (the member of the population in the same position) by:
+ *
+ * - mutation, i.e., a base vector plus the sum of up to three scaled differences of vectors (see de_kernel::scheme),
+ * - exponential or binomial crossover of the mutant with a donor (by default the target itself),
+ * - re-initialisation, uniformly within the bounds, of the components falling outside the bounds.
+ *
+ * Only the first Dc components (the continuous part of the decision vector) are evolved, the remaining ones are copied
+ * from the target. The random numbers needed by crossover and bounds handling are drawn in blocks before building the
+ * trials, so that mutation, crossover and bounds handling run on whole rows with branch-free loops the compiler can
+ * vectorise. The trial vectors can then be evaluated with a single call to problem::base::objfun_batch(). Steady-state
+ * algorithms can instead build the trial vectors one at a time with make_trial().
+ */
+class __PAGMO_VISIBLE de_kernel
+{
+	public:
+		/// Vectors entering a mutation scheme.
+		enum operand {
+			r1 = 0,		///< First random member of the population.
+			r2,		///< Second random member of the population.
+			r3,		///< Third random member of the population.
+			r4,		///< Fourth random member of the population.
+			r5,		///< Fifth random member of the population.
+			r6,		///< Sixth random member of the population.
+			r7,		///< Seventh random member of the population.
+			current,	///< The target.
+			best		///< The best decision vector.
+		};
+		/// Crossover types.
+		enum crossover_type {
+			exponential = 0,	///< A run of consecutive components is taken from the mutant.
+			binomial = 1		///< Each component is taken from the mutant independently.
+		};
+		/// Mutation and crossover scheme.
+		/**
+		 * The mutant is base + F * (plus[0] - minus[0]) + ... + F * (plus[n_pairs - 1] - minus[n_pairs - 1]).
+		 */
+		struct scheme
+		{
+			/// Base vector.
+			operand		base;
+			/// Number of differences.
+			unsigned int	n_pairs;
+			/// Positive terms of the differences.
+			operand		plus[3];
+			/// Negative terms of the differences.
+			operand		minus[3];
+			/// Crossover type.
+			crossover_type	crossover;
+		};
+		static const scheme &get_variant(int);
+
+		de_kernel(std::size_t, const decision_vector &, const decision_vector &, std::size_t);
+		void set_x(std::size_t, const decision_vector &);
+		const double *get_x(std::size_t) const;
+		void set_best(const decision_vector &);
+		void draw_members(unsigned int, rng_uint32 &);
+		std::size_t &member(std::size_t, unsigned int);
+		std::size_t member(std::size_t, unsigned int) const;
+		void set_donor(std::size_t, std::size_t);
+		void make_trials(const std::vector<const scheme *> &, const std::vector<double> &, const std::vector<double> &, rng_double &, rng_uint32 &);
+		const decision_vector &make_trial(std::size_t, unsigned int, const scheme &, double, double, rng_double &, rng_uint32 &);
+		const std::vector<decision_vector> &get_trials() const;
+		/// Apply a scheme to a parameter.
+		/**
+		 * Used by the self-adaptive algorithms to evolve their parameters along with the decision vectors: the value
+		 * of the parameter for trial i is v(base) + 0.5 * N(0,1) * (v(plus[0]) - v(minus[0])) + ..., where v are the values
+		 * of the parameter for the members of the population and for the best decision vector.
+		 *
+		 * @param[in] s scheme of the trial.
+		 * @param[in] i position of the trial.
+		 * @param[in] v values of the parameter for the members of the population.
+		 * @param[in] v_best value of the parameter for the best decision vector.
+		 * @param[in] normal generator of standard normal numbers.
+		 *
+		 * @return the value of the parameter for trial i.
+		 */
+		template <class Normal>
+		double mutate_parameter(const scheme &s, std::size_t i, const std::vector<double> &v, double v_best, Normal &normal) const
+		{
+			double retval = value(s.base,i,v,v_best);
+			for (unsigned int k = 0; k < s.n_pairs; ++k) {
+				retval += normal() * 0.5 * (value(s.plus[k],i,v,v_best) - value(s.minus[k],i,v,v_best));
+			}
+			return retval;
+		}
+
+	private:
+		void draw_trial_members(std::size_t, unsigned int, rng_uint32 &);
+		void build_trial(std::size_t, const scheme &, double, double);
+		const double *row(operand, std::size_t) const;
+		double value(operand op, std::size_t i, const std::vector<double> &v, double v_best) const
+		{
+			return (op == current) ? v[i] : ((op == best) ? v_best : v[member(i,op)]);
+		}
+
+		// Population size, dimension and size of the evolved part of the decision vectors.
+		const std::size_t		m_np;
+		const std::size_t		m_dim;
+		const std::size_t		m_dc;
+		const decision_vector		m_lb;
+		const decision_vector		m_ub;
+		// Population matrix, with the best decision vector in the last row.
+		std::vector<double>		m_x;
+		// Random members, seven per trial.
+		std::vector<std::size_t>	m_members;
+		// Donors of the components not taken from the mutants.
+		std::vector<std::size_t>	m_donors;
+		// Blocks of random numbers.
+		std::vector<double>		m_u_cross;
+		std::vector<double>		m_u_bounds;
+		std::vector<std::size_t>	m_start;
+		std::vector<decision_vector>	m_trials;
+};
+
+}}
+
+#endif
@@ -6,6 +6,9 @@
 # include <ctime>
 # include <cstring>
 
+# include <boost/thread/thread.hpp>
+# include <climits>
+
 # include "discrepancy.h"
 
 using namespace std;
@@ -13,6 +16,125 @@ namespace pagmo{ namespace util {namespace discrepancy {
 
 base::~base() {}
 
+// Fills a chunk of a block, keeping the error message (if any) to be re-thrown by the calling thread.
+struct base::fill_task
+{
+	void operator()() const
+	{
+		try {
+			gen->fill(retval,first,n);
+		} catch (const std::exception &e) {
+			*err = e.what();
+			if (err->empty()) {
+				*err = "error while generating the block";
+			}
+		}
+	}
+	const base *gen;
+	double *retval;
+	unsigned long long first;
+	unsigned long long n;
+	std::string *err;
+};
+
+/// Block of points
+/**
+ * Fills retval with the n points of indices first, first + 1, ..., first + n - 1 (the index of a point being the one
+ * accepted by operator()(unsigned int)), stored row by row in an n x dim matrix. The state of the sequence is not modified.
+ *
+ * The block is split in n_threads contiguous chunks generated concurrently, each one starting from its own index.
+ * The result does not depend on the number of threads.
+ *
+ * @param[out] retval n x dim matrix, row-major, resized as needed
+ * @param[in] first index of the first point
+ * @param[in] n number of points
+ * @param[in] n_threads number of threads (0 means as many as the hardware supports)
+ *
+ * @throws value_error if the sequence cannot generate the requested points
+ */
+void base::generate(std::vector<double> &retval, unsigned long long first, unsigned long long n, unsigned int n_threads) const
+{
+	retval.resize(n * m_dim);
+	if (n == 0 || m_dim == 0) {
+		return;
+	}
+	if (n_threads == 0) {
+		n_threads = std::max(boost::thread::hardware_concurrency(),1u);
+	}
+	if (n < n_threads) {
+		n_threads = static_cast<unsigned int>(n);
+	}
+	if (n_threads == 1) {
+		fill(&retval[0],first,n);
+		return;
+	}
+	std::vector<std::string> err(n_threads);
+	boost::thread_group threads;
+	for (unsigned int t = 0; t < n_threads; ++t) {
+		const unsigned long long begin = n / n_threads * t + std::min<unsigned long long>(t,n % n_threads);
+		const unsigned long long size = n / n_threads + (t < n % n_threads ? 1 : 0);
+		fill_task task = {this,&retval[0] + begin * m_dim,first + begin,size,&err[t]};
+		threads.create_thread(task);
+	}
+	threads.join_all();
+	for (unsigned int t = 0; t < n_threads; ++t) {
+		if (!err[t].empty()) {
+			pagmo_throw(value_error,err[t].c_str());
+		}
+	}
+}
+
+/// Next block of points
+/**
+ * Block version of operator()(): fills retval with the next n points in the sequence (see generate()) and moves
+ * the sequence past them.
+ *
+ * @param[out] retval n x dim matrix, row-major, resized as needed
+ * @param[in] n number of points
+ * @param[in] n_threads number of threads (0 means as many as the hardware supports)
+ */
+void base::next_block(std::vector<double> &retval, unsigned long long n, unsigned int n_threads)
+{
+	unsigned long long &pos = position();
+	generate(retval,pos,n,n_threads);
+	pos += n;
+}
+
+/// Fill a chunk of a block
+/**
+ * Writes the n points starting from index first in retval, row by row. Must be safe to call concurrently on
+ * the same object. The default implementation calls operator()(unsigned int) on a clone of the sequence, and
+ * should be re-implemented by sequences allowing to compute a point directly from its index.
+ *
+ * @param[out] retval pointer to the first element of the chunk
+ * @param[in] first index of the first point
+ * @param[in] n number of points
+ *
+ * @throws value_error if the indices do not fit in an unsigned int
+ */
+void base::fill(double *retval, unsigned long long first, unsigned long long n) const
+{
+	if (first + n - 1 > UINT_MAX) {
+		pagmo_throw(value_error,"this sequence can only generate points of index up to UINT_MAX");
+	}
+	base_ptr tmp = clone();
+	for (unsigned long long k = 0; k < n; ++k) {
+		const std::vector<double> x = (*tmp)(static_cast<unsigned int>(first + k));
+		std::copy(x.begin(),x.end(),retval + k * m_dim);
+	}
+}
+
+/// Position of the sequence
+/**
+ * Returns a reference to the index of the point operator()() would return next.
+ *
+ * @return reference to m_count
+ */
+unsigned long long &base::position()
+{
+	return m_count;
+}
+
 /// Van Der Corput sequence
 /**
  * Returns the n-th number in the Halton sequence
@@ -23,13 +145,13 @@ base::~base() {}
  *
  * @see http://en.wikipedia.org/wiki/Van_der_Corput_sequence
 **/
-double van_der_corput(unsigned int n, unsigned int base) {
+double van_der_corput(unsigned long long n, unsigned int base) {
 	double retval = 0;
 	double f = 1.0 / base;
-	unsigned int i = n;
+	unsigned long long i = n;
 	while (i > 0) {
 		retval += f * (i % base);
-		i = floor(i / base);
+		i = i / base;
 		f = f / base;
 	}
 	return retval;
@@ -14678,6 +14800,19 @@ std::vector<double> halton::operator()(unsigned int n) {
 	return retval;
 }
 
+// Each coordinate is a van der Corput number of the index, hence a point costs O(log n).
+void halton::fill(double *retval, unsigned long long first, unsigned long long n) const
+{
+	if (first == 0) {
+		pagmo_throw(value_error,"Halton sequence first point id is 1");
+	}
+	for (unsigned long long k = 0; k < n; ++k) {
+		for (unsigned int i = 0; i < m_dim; ++i) {
+			retval[k * m_dim + i] = van_der_corput(first + k,m_primes[i]);
+		}
+	}
+}
+
 
 
 /// Constructor
@@ -14692,6 +14827,21 @@ faure::faure(unsigned int dim, unsigned int count) : base(dim, count), m_coef(NU
 			pagmo_throw(value_error,"Faure sequences can have dimension [2,23]");
 		}
 	}
+/// Copy constructor.
+/**
+ * The coefficient tables are not shared: the copy builds its own when first used.
+ *
+ * @param[in] other the faure sequence to copy
+ */
+faure::faure(const faure &other) : base(other), m_coef(NULL), m_hisum_save(-1), m_qs(-1), m_ytemp(NULL) {}
+
+/// Destructor.
+faure::~faure()
+{
+	delete [] m_coef;
+	delete [] m_ytemp;
+}
+
 /// Clone method.
 base_ptr faure::clone() const
 {
@@ -14705,7 +14855,9 @@ base_ptr faure::clone() const
  */
 std::vector<double> faure::operator()() {
 	std::vector<double> retval(m_dim,0.0);
-	faure_orig(m_dim, &m_count, &retval[0]);
+	unsigned int seed = static_cast<unsigned int>(m_count);
+	faure_orig(m_dim, &seed, &retval[0]);
+	m_count = seed;
 	return retval;
 }
 /// Operator (unsigned int n)
@@ -14716,9 +14868,10 @@ std::vector<double> faure::operator()() {
  * @return an std::vector<double> containing the n-th point
  */
 std::vector<double> faure::operator()(unsigned int n) {
-	m_count = n;
+	unsigned int seed = n;
 	std::vector<double> retval(m_dim,0.0);
-	faure_orig(m_dim, &m_count, &retval[0]);
+	faure_orig(m_dim, &seed, &retval[0]);
+	m_count = seed;
 	return retval;
 }
 
@@ -14750,9 +14903,8 @@ base_ptr simplex::clone() const
  * @return an std::vector<double> containing the next point
  */
 std::vector<double> simplex::operator()() {
-	std::vector<double> tmp = m_generator();
-//std::cout << tmp[0] << " " << tmp[1] << " " << std::endl;
-	std::vector<double> retval = m_projector(tmp);
+	std::vector<double> retval = m_projector(m_generator(static_cast<unsigned int>(m_count)));
+	++m_count;
 	return retval;
 }
 /// Operator (unsigned int n)
@@ -14764,6 +14916,7 @@ std::vector<double> simplex::operator()() {
  */
 std::vector<double> simplex::operator()(unsigned int n) {
 	std::vector<double> retval = m_projector(m_generator(n));
+	m_count = static_cast<unsigned long long>(n) + 1;
 	return retval;
 }
 
@@ -14777,10 +14930,14 @@ std::vector<double> simplex::operator()(unsigned int n) {
  * @param[in] count starting point of the sequence. choosing 0 wil add the point x=0
  * @throws value_error if dim not in [1,1111]
 */
-sobol::sobol(unsigned int dim, unsigned int count) : base(dim, count), m_dim_num_save(0), m_initialized(false), m_maxcol(62), m_seed_save(-1), recipd(0), lastq(), poly(), v(){
+sobol::sobol(unsigned int dim, unsigned long long count) : base(dim, count), m_dim_num_save(0), m_initialized(false), m_maxcol(62), m_seed_save(-1), recipd(0), lastq(), poly(), v(), m_shift(){
 		if (dim >1111 || dim <1) {
 			pagmo_throw(value_error,"This Sobol sequence can have dimensions [1,1111]");
 		}
+		// Builds the table of direction numbers.
+		long long int seed = 0;
+		std::vector<double> tmp(m_dim);
+		i8_sobol(m_dim, &seed, &tmp[0]);
 	}
 /// Clone method.
 base_ptr sobol::clone() const
@@ -14795,9 +14952,8 @@ base_ptr sobol::clone() const
  */
 std::vector<double> sobol::operator()() {
 	std::vector<double> retval(m_dim,0.0);
-	signed long long int seed= (signed long long int) m_count;
-	i8_sobol(m_dim, &seed, &retval[0]);
-	m_count= (unsigned short int) seed;
+	fill(&retval[0], m_count, 1);
+	++m_count;
 	return retval;
 }
 /// Operator (unsigned int n)
@@ -14808,21 +14964,111 @@ std::vector<double> sobol::operator()() {
  * @return an std::vector<double> containing the n-th point
  */
 std::vector<double> sobol::operator()(unsigned int n) {
-	m_count = n;
-	signed long long int seed= (signed long long int) m_count;
 	std::vector<double> retval(m_dim,0.0);
-	i8_sobol(m_dim, &seed, &retval[0]);
-	m_count= (unsigned short int) seed;
+	fill(&retval[0], n, 1);
+	m_count = static_cast<unsigned long long>(n) + 1;
 	return retval;
 }
 
+// The point of index s is the XOR of the direction numbers selected by the bits of the Gray code of s. Two
+// consecutive Gray codes differ in one bit (the lowest zero bit of the smaller index), so that after the
+// skip-ahead to the first point, each following one costs a single XOR per dimension.
+void sobol::fill(double *retval, unsigned long long first, unsigned long long n) const
+{
+	if (n == 0) {
+		return;
+	}
+	if (first >= (1ull << m_maxcol) || n > (1ull << m_maxcol) - first) {
+		pagmo_throw(value_error,"too many Sobol points requested (the limit is 2^62)");
+	}
+	std::vector<unsigned long long> x(m_shift);
+	x.resize(m_dim,0);
+	const unsigned long long gray = first ^ (first >> 1);
+	for (int j = 0; j < m_maxcol; ++j) {
+		if ((gray >> j) & 1) {
+			for (unsigned int i = 0; i < m_dim; ++i) {
+				x[i] ^= v[i][j];
+			}
+		}
+	}
+	for (unsigned long long k = 0; k < n; ++k) {
+		for (unsigned int i = 0; i < m_dim; ++i) {
+			retval[k * m_dim + i] = x[i] * recipd;
+		}
+		if (k + 1 < n) {
+			unsigned long long idx = first + k;
+			int j = 0;
+			while (idx & 1) {
+				idx >>= 1;
+				++j;
+			}
+			for (unsigned int i = 0; i < m_dim; ++i) {
+				x[i] ^= v[i][j];
+			}
+		}
+	}
+}
+
+// Linear matrix scrambling: the digits of each direction number are multiplied by a random lower triangular
+// binary matrix with unit diagonal (digit r of the result is the parity of digits 0..r, selected by row r).
+// A random digital shift is then applied to all points.
+void sobol::scramble(boost::uint32_t seed)
+{
+	rng_uint32 rng(seed);
+	const unsigned long long mask = (1ull << m_maxcol) - 1;
+	std::vector<unsigned long long> rows(m_maxcol);
+	m_shift.resize(m_dim);
+	for (unsigned int i = 0; i < m_dim; ++i) {
+		// Row p acts on the digit stored in bit p, the most significant digits being in the highest bits.
+		for (int p = 0; p < m_maxcol; ++p) {
+			const unsigned long long r = (static_cast<unsigned long long>(rng()) << 32) | rng();
+			rows[p] = ((r & mask) >> (p + 1) << (p + 1)) | (1ull << p);
+		}
+		for (int j = 0; j < m_maxcol; ++j) {
+			const unsigned long long x = static_cast<unsigned long long>(v[i][j]);
+			unsigned long long y = 0;
+			for (int p = 0; p < m_maxcol; ++p) {
+				unsigned long long b = rows[p] & x;
+				// Parity of b.
+				b ^= b >> 32;
+				b ^= b >> 16;
+				b ^= b >> 8;
+				b ^= b >> 4;
+				b ^= b >> 2;
+				b ^= b >> 1;
+				y |= (b & 1) << p;
+			}
+			v[i][j] = static_cast<long long int>(y);
+		}
+		m_shift[i] = ((static_cast<unsigned long long>(rng()) << 32) | rng()) & mask;
+	}
+}
+
+/// Constructor
+/**
+ * @param[in] dim dimension of the hypercube
+ * @param[in] count starting point of the sequence
+ * @param[in] seed seed of the random scrambling
+ * @throws value_error if dim not in [1,1111]
+*/
+scrambled_sobol::scrambled_sobol(unsigned int dim, unsigned long long count, boost::uint32_t seed) : sobol(dim, count)
+{
+	scramble(seed);
+}
+
+/// Clone method.
+base_ptr scrambled_sobol::clone() const
+{
+	return base_ptr(new scrambled_sobol(*this));
+}
+
 
 /// Constructor
 /**
  * @param[in] dim dimension of the hypercube
  * @param[in] number of points to sample
 */
-lhs::lhs(unsigned int dim, unsigned int count) :  base(dim, count), m_initialised(false), m_set(), m_next(0) {
+lhs::lhs(unsigned int dim, unsigned int count) :  base(dim, count), m_set(latin_random(dim,count)), m_next(0) {
 	}
 /// Clone method.
 base_ptr lhs::clone() const
@@ -14837,14 +15083,7 @@ base_ptr lhs::clone() const
  */
 std::vector<double> lhs::operator()() {
 	std::vector<double> retval(m_dim,0.0);
-	if (!m_initialised){
-		m_set=latin_random(m_dim,m_count);
-		m_initialised=true;
-		m_next=0;
-	}
-	for (size_t i=0;i<m_dim;i++){
-		retval[i]=m_set[i+m_next*m_dim];
-	}
+	fill(&retval[0],m_next,1);
 	m_next++;
 	return retval;
 }
@@ -14858,14 +15097,27 @@ std::vector<double> lhs::operator()() {
 std::vector<double> lhs::operator()(unsigned int n) {
 	std::vector<double> retval(m_dim,0.0);
 	m_next = n;
-	if (!m_initialised){
-		m_set=latin_random(m_dim,m_count);
-		m_initialised=true;
-	}
-	for (size_t i=0;i<m_dim;i++){
-		retval[i]=m_set[i+m_next*m_dim];
-	}
+	fill(&retval[0],m_next,1);
 	m_next++;
 	return retval;
 }
+
+// The set is stored dimension by dimension (see latin_random()).
+void lhs::fill(double *retval, unsigned long long first, unsigned long long n) const
+{
+	if (first > m_count || n > m_count - first) {
+		pagmo_throw(value_error,"the points requested exceed the size of the latin hypercube");
+	}
+	for (unsigned long long k = 0; k < n; ++k) {
+		for (unsigned int i = 0; i < m_dim; ++i) {
+			retval[k * m_dim + i] = m_set[i * m_count + first + k];
+		}
+	}
+}
+
+// The position in the set is kept in m_next, m_count being the size of the set.
+unsigned long long &lhs::position()
+{
+	return m_next;
+}
 }}} //namespaces
@@ -29,7 +29,9 @@
 #include <vector>
 #include <math.h>
 #include <algorithm>
+#include <boost/cstdint.hpp>
 #include <boost/shared_ptr.hpp>
+#include <string>
 
 #include "../config.h"
 #include "../exceptions.h"
@@ -47,7 +49,7 @@ namespace pagmo{ namespace util {
 namespace discrepancy {
 
 //! @cond
-double van_der_corput(unsigned int n, unsigned int base);
+double van_der_corput(unsigned long long n, unsigned int base);
 unsigned int prime ( int n );
 unsigned int prime_ge ( unsigned int n );
 class __PAGMO_VISIBLE project_2_simplex
@@ -83,7 +85,7 @@ public:
 	 * @param[in] dim hypercube dimension
 	 * @param[in] count starting point of the sequence
 	*/
-	base(unsigned int dim, unsigned int count = 1) : m_dim(dim), m_count(count) {}
+	base(unsigned int dim, unsigned long long count = 1) : m_dim(dim), m_count(count) {}
 	/// Operator ()
 	/**
 	 * Returns the next point in the sequence. Must be implemented in the derived class
@@ -103,11 +105,19 @@ public:
 	virtual base_ptr clone() const = 0;
 	/// Virtual destructor. Required as the class contains pure virtual methods
 	virtual~base();
+	void generate(std::vector<double> &, unsigned long long, unsigned long long, unsigned int = 1) const;
+	void next_block(std::vector<double> &, unsigned long long, unsigned int = 1);
+	/// Getter for the hypercube dimension
+	unsigned int get_dimension() const { return m_dim; }
 protected:
+	virtual void fill(double *, unsigned long long, unsigned long long) const;
+	virtual unsigned long long &position();
 	/// Hypercube dimension where sampling with low-discrepancy
 	unsigned int m_dim;
 	/// Starting point of the sequence (can be used to skip initial values)
-	unsigned int m_count;
+	unsigned long long m_count;
+private:
+	struct fill_task;
 };
 
 //---------------------------------------------------------
@@ -129,6 +139,8 @@ class __PAGMO_VISIBLE halton : public base
 		base_ptr clone() const;
 		std::vector<double> operator()();
 		std::vector<double> operator()(unsigned int n);
+	protected:
+		void fill(double *, unsigned long long, unsigned long long) const;
 	private:
 		std::vector<unsigned int> m_primes;
 };
@@ -146,10 +158,13 @@ class __PAGMO_VISIBLE faure : public base
 {
 	public:
 	faure(unsigned int dim, unsigned int count = 1);
+	faure(const faure &);
+	~faure();
 	base_ptr clone() const;
 	std::vector<double> operator()();
 	std::vector<double> operator()(unsigned int n);
 	private:
+		faure &operator=(const faure &);
 		int *binomial_table ( int qs, int m, int n );
 		void faure_orig ( unsigned int dim_num, unsigned int *seed, double quasi[] );
 		double *faure_generate ( int dim_num, int n, int skip );
@@ -190,7 +205,8 @@ private:
 /**
  * Class that generates a quasi-random sequence of
  * points in the unit hyper cube using the Sobol sequence.
- * The code wraps original routines from the link below.
+ * The code wraps original routines from the link below for the direction numbers; points are then
+ * computed from the Gray code of their index, so that any point can be reached in O(log n) operations.
  *
  * @see http://people.sc.fsu.edu/~jburkardt/cpp_src/sobol/sobol.html
  * @author c.ortega.absil@gmail.com
@@ -198,10 +214,13 @@ private:
 class __PAGMO_VISIBLE sobol : public base
 {
 	public:
-		sobol(unsigned int dim, unsigned int count);
+		sobol(unsigned int dim, unsigned long long count);
 		base_ptr clone() const;
 		std::vector<double> operator()();
 		std::vector<double> operator()(unsigned int n);
+	protected:
+		void fill(double *, unsigned long long, unsigned long long) const;
+		void scramble(boost::uint32_t);
 	private:
 		int i8_bit_lo0 ( long long int n );
 		void i8_sobol ( unsigned int dim_num, long long int *seed, double quasi[ ] );
@@ -214,6 +233,22 @@ class __PAGMO_VISIBLE sobol : public base
 		long long int lastq[1111]; //1111 is maximum dimension.
 		long long int poly[1111];
 		long long int v[1111][62]; //2^62 is approx. limit of points requested.
+		std::vector<unsigned long long> m_shift;
+};
+
+/// Scrambled Sobol quasi-random point sequence
+/**
+ * Sobol sequence randomised with a linear matrix scrambling of the direction numbers followed
+ * by a random digital shift. The scrambled sequence keeps the stratification properties of the Sobol
+ * sequence while removing its regular structure (e.g. the point x=0 is no longer generated).
+ *
+ * @see J. Matousek, "On the L2-discrepancy for anchored boxes", Journal of Complexity 14, 1998.
+*/
+class __PAGMO_VISIBLE scrambled_sobol : public sobol
+{
+	public:
+		scrambled_sobol(unsigned int dim, unsigned long long count, boost::uint32_t seed);
+		base_ptr clone() const;
 };
 
 /// Latin Hypercube Sampling
@@ -234,13 +269,15 @@ class __PAGMO_VISIBLE lhs : public base
 		base_ptr clone() const;
 		std::vector<double> operator()();
 		std::vector<double> operator()(unsigned int n);
+	protected:
+		void fill(double *, unsigned long long, unsigned long long) const;
+		unsigned long long &position();
 	private:
 		std::vector<double> latin_random ( unsigned int dim_num, unsigned int point_num);
 		unsigned int *perm_uniform ( unsigned int n);
 	private:
-		bool m_initialised;
 		std::vector<double> m_set;
-		unsigned int m_next;
+		unsigned long long m_next;
 };
 
 }}} //namespace discrepancy
@@ -39,9 +39,11 @@ namespace pagmo { namespace util { namespace hv_algorithm {
  * @param[in] delta_multiplier factor with which delta diminishes each round
  * @param[in] initial_delta_coeff initial coefficient multiplied by the delta at round 0
  * @param[in] alpha coefficicient stating how accurately current lowest contributor should be sampled
+ * @param[in] n_threads number of threads sampling the boxes of the points in each round. If zero, the number of hardware threads is used.
+ *            The result does not depend on the number of threads.
  */
-bf_approx::bf_approx(const bool use_exact, const unsigned int trivial_subcase_size, const double eps, const double delta, const double delta_multiplier, const double alpha, const double initial_delta_coeff, const double gamma)
-	: m_use_exact(use_exact), m_trivial_subcase_size(trivial_subcase_size), m_eps(eps), m_delta(delta), m_delta_multiplier(delta_multiplier), m_alpha(alpha), m_initial_delta_coeff(initial_delta_coeff), m_gamma(gamma) { }
+bf_approx::bf_approx(const bool use_exact, const unsigned int trivial_subcase_size, const double eps, const double delta, const double delta_multiplier, const double alpha, const double initial_delta_coeff, const double gamma, const unsigned int n_threads)
+	: m_use_exact(use_exact), m_trivial_subcase_size(trivial_subcase_size), m_eps(eps), m_delta(delta), m_delta_multiplier(delta_multiplier), m_alpha(alpha), m_initial_delta_coeff(initial_delta_coeff), m_gamma(gamma), m_n_threads(n_threads), m_seed(0) { }
 
 double bf_approx::lc_end_condition(unsigned int idx, unsigned int LC, std::vector<double> &approx_volume, std::vector<double> &point_delta)
 {
@@ -122,6 +124,11 @@ unsigned int bf_approx::approx_extreme_contributor(std::vector<fitness_vector> &
 	m_point_delta = std::vector<double>(points.size(), 0.0);
 	m_boxes = std::vector<fitness_vector>(points.size());
 	m_box_points = std::vector<std::vector<unsigned int> >(points.size());
+	m_box_soa = std::vector<std::vector<double> >(points.size());
+
+	// every call draws its own seed, the sampling streams of the boxes derive from it
+	m_seed = (static_cast<boost::uint64_t>(m_drng() * 4294967296.0) << 32) ^ static_cast<boost::uint64_t>(m_drng() * 4294967296.0);
+	const mc_sampler sampler(m_n_threads);
 
 	// precomputed log factor for the point delta computation
 	const double log_factor = log (2. * points.size() * (1. + m_gamma) / (m_delta * m_gamma) );
@@ -172,6 +179,7 @@ unsigned int bf_approx::approx_extreme_contributor(std::vector<fitness_vector> &
 				}
 			}
 		}
+		mc_sampler::to_soa(m_box_soa[idx], points, m_box_points[idx]);
 	}
 
 	// decrease the initial maximum volume by a constant factor
@@ -182,10 +190,9 @@ unsigned int bf_approx::approx_extreme_contributor(std::vector<fitness_vector> &
 		r_delta *= m_delta_multiplier;
 		++round_no;
 
-		for(unsigned int _i = 0 ; _i < m_point_set.size() ; ++_i) {
-			unsigned int idx = m_point_set[_i];
-			sampling_round(points, r_delta , round_no, idx, log_factor);
-		}
+		// the rounds of the points are independent, sample them in parallel
+		const round_task task = {*this, points, r_delta, round_no, log_factor};
+		sampler.run(m_point_set.size(), task);
 
 		// sample the extreme contributor
 		sampling_round(points, m_alpha * r_delta , round_no, EC, log_factor);
@@ -278,51 +285,18 @@ void bf_approx::sampling_round(const std::vector<fitness_vector> &points, const
 	double tmp = m_box_volume[idx] / delta;
 	double required_no_samples = 0.5 * ( (1. + m_gamma) * log( round ) + log_factor ) * tmp * tmp;
 
-	while(m_no_samples[idx] < required_no_samples) {
-		++m_no_samples[idx];
-		if (sample_successful(points, idx)) {
-			++m_no_succ_samples[idx];
-		}
+	if (m_no_samples[idx] < required_no_samples) {
+		// sample whole blocks, the stream of the box continues from the last block sampled in the previous rounds
+		const unsigned long long first_block = m_no_samples[idx] / mc_sampler::block_size;
+		const unsigned long long n_blocks = static_cast<unsigned long long>(std::ceil((required_no_samples - m_no_samples[idx]) / mc_sampler::block_size));
+		m_no_succ_samples[idx] += mc_sampler::count_uncovered(points[idx], m_boxes[idx], m_box_soa[idx], m_seed, idx, first_block, n_blocks, m_no_ops[idx]);
+		m_no_samples[idx] += n_blocks * mc_sampler::block_size;
 	}
 
 	m_approx_volume[idx] = static_cast<double>(m_no_succ_samples[idx]) / static_cast<double>(m_no_samples[idx]) * m_box_volume[idx];
 	m_point_delta[idx] = compute_point_delta(round, idx, log_factor) * m_box_volume[idx];
 }
 
-/// samples the bounding box and returns true if it fell into the exclusive hypervolume
-bool bf_approx::sample_successful(const std::vector<fitness_vector> &points, const unsigned int idx) const
-{
-	const fitness_vector &lb = points[idx];
-	const fitness_vector &ub = m_boxes[idx];
-	fitness_vector rnd_p(lb.size(), 0.0);
-	for(unsigned int i = 0 ; i < lb.size() ; ++ i) {
-		rnd_p[i] = lb[i] + m_drng()*(ub[i]-lb[i]);
-	}
-
-	for(unsigned int i = 0 ; i < m_box_points[idx].size() ; ++i) {
-
-		// box_p is a point overlapping the bounding box volume
-		const fitness_vector &box_p = points[m_box_points[idx][i]];
-
-		// assume that box_p DOMINATES the random point and try to prove it otherwise below
-		bool dominates = true;
-
-		// increase the number of operations by the dimension size
-		m_no_ops[idx] += box_p.size() + 1;
-		for(unsigned int d_idx = 0 ; d_idx < box_p.size() ; ++d_idx) {
-			if(rnd_p[d_idx] < box_p[d_idx]) { // box_p does not dominate rnd_p
-				dominates=false;
-				break;
-			}
-		}
-		// if the box_p dominated the rnd_p return the sample as false
-		if (dominates) {
-			return false;
-		}
-	}
-	return true;
-}
-
 /// Compute delta for given point
 /**
  * Uses chernoff inequality as it was proposed in the article by Bringmann and Friedrich
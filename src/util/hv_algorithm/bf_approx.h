@@ -33,6 +33,7 @@
 #include "../../rng.h"
 
 #include "base.h"
+#include "mc_sampler.h"
 
 #include "../hypervolume.h"
 
@@ -50,7 +51,7 @@ namespace pagmo { namespace util { namespace hv_algorithm {
 class __PAGMO_VISIBLE bf_approx : public base
 {
 public:
-	bf_approx(const bool use_exact = true, const unsigned int trivial_subcase_size = 1, const double eps = 1e-2, const double delta = 1e-6, const double delta_multiplier = 0.775, const double m_alpha = 0.2, const double initial_delta_coeff = 0.1, const double gamma = 0.25);
+	bf_approx(const bool use_exact = true, const unsigned int trivial_subcase_size = 1, const double eps = 1e-2, const double delta = 1e-6, const double delta_multiplier = 0.775, const double m_alpha = 0.2, const double initial_delta_coeff = 0.1, const double gamma = 0.25, const unsigned int n_threads = 1);
 	double compute(std::vector<fitness_vector> &, const fitness_vector &) const;
 	unsigned int least_contributor(std::vector<fitness_vector> &, const fitness_vector &) const;
 	unsigned int greatest_contributor(std::vector<fitness_vector> &, const fitness_vector &) const;
@@ -62,8 +63,21 @@ private:
 	inline double compute_point_delta(const unsigned int, const unsigned int, const double) const;
 	inline fitness_vector compute_bounding_box(const std::vector<fitness_vector> &, const fitness_vector &, const unsigned int) const;
 	inline int point_in_box(const fitness_vector &p, const fitness_vector &a, const fitness_vector &b) const;
-	inline void sampling_round(const std::vector<fitness_vector>&, const double, const unsigned int, const unsigned int, const double) const;
-	inline bool sample_successful(const std::vector<fitness_vector> &, const unsigned int) const;
+	void sampling_round(const std::vector<fitness_vector>&, const double, const unsigned int, const unsigned int, const double) const;
+
+	// sampling round of the point at index m_point_set[i]
+	struct round_task
+	{
+		void operator()(unsigned int i) const
+		{
+			algo.sampling_round(points, delta, round, algo.m_point_set[i], log_factor);
+		}
+		const bf_approx &algo;
+		const std::vector<fitness_vector> &points;
+		const double delta;
+		const unsigned int round;
+		const double log_factor;
+	};
 
 	enum extreme_contrib_type {
 		LEAST = 1,
@@ -103,6 +117,9 @@ private:
 	// constant used for the computation of point delta
 	const double m_gamma;
 
+	// number of threads sampling the boxes
+	const unsigned int m_n_threads;
+
 	mutable rng_double	m_drng;
 
 	/**
@@ -138,13 +155,19 @@ private:
 	// list of indices of points that overlap the bounding box of each point
 	// during monte carlo sampling it suffices to check only these points when deciding whether the sampling was "successful"
 	mutable std::vector<std::vector<unsigned int> > m_box_points;
+
+	// coordinates of the points overlapping the bounding box of each point, stored by mc_sampler::to_soa
+	mutable std::vector<std::vector<double> > m_box_soa;
+
+	// seed of the sampling streams
+	mutable boost::uint64_t m_seed;
 	/**
 	 * End of 'least_contributor' method variables section
 	 */
 
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & boost::serialization::base_object<base>(*this);
 		ar & const_cast<bool &>(m_use_exact);
@@ -155,6 +178,10 @@ private:
 		ar & const_cast<double &>(m_alpha);
 		ar & const_cast<double &>(m_initial_delta_coeff);
 		ar & const_cast<double &>(m_gamma);
+		// The number of threads was added in version 1.
+		if (version >= 1) {
+			ar & const_cast<unsigned int &>(m_n_threads);
+		}
 		ar & m_drng;
 	}
 };
@@ -162,5 +189,6 @@ private:
 } } }
 
 BOOST_CLASS_EXPORT_KEY(pagmo::util::hv_algorithm::bf_approx)
+BOOST_CLASS_VERSION(pagmo::util::hv_algorithm::bf_approx,1)
 
 #endif
@@ -34,8 +34,10 @@ namespace pagmo { namespace util { namespace hv_algorithm {
  *
  * @param[in] eps accuracy of the approximation
  * @param[in] delta confidence of the approximation
+ * @param[in] n_threads number of threads drawing the samples. If zero, the number of hardware threads is used.
+ *            The result does not depend on the number of threads.
  */
-bf_fpras::bf_fpras(const double eps, const double delta) : m_eps(eps), m_delta(delta) { }
+bf_fpras::bf_fpras(const double eps, const double delta, const unsigned int n_threads) : m_eps(eps), m_delta(delta), m_n_threads(n_threads) { }
 
 /// Verify before compute
 /**
@@ -55,6 +57,11 @@ void bf_fpras::verify_before_compute(const std::vector<fitness_vector> &points,
 /**
  * Compute the hypervolume using FPRAS.
  *
+ * Each sample is drawn in a box chosen with probability proportional to its volume, after which boxes are picked uniformly at random
+ * until one of them contains the sample. The approximation depends on the number of samples completed within T such trials.
+ * Samples are drawn in blocks by a mc_sampler, in parallel; the numbers of trials are then accumulated sample by sample, in block order,
+ * so the result is the same as the one of a sequential run over the same random streams.
+ *
  * @see "Approximating the volume of unions and intersections of high-dimensional geometric objects", Karl Bringmann, Tobias Friedrich.
  *
  * @param[in] points vector of fitness_vectors for which the hypervolume is computed
@@ -71,48 +78,68 @@ double bf_fpras::compute(std::vector<fitness_vector> &points, const fitness_vect
 	// Partial sums of consecutive boxes
 	std::vector<double> sums(n, 0.0);
 
-	// points iterator
-	std::vector<fitness_vector>::iterator it_p;
-
-	// volume iterator - used for finding the contributor using std::lower_bound
-	std::vector<double>::iterator it_sums;
-
-	unsigned int i = 0;
+	// Points stored contiguously, as the trials access them at random
+	std::vector<double> flat_points(n * dim);
 
 	// Total sum of every box
 	double V = 0.0;
-	for(it_p = points.begin() ; it_p != points.end() ; ++it_p) {
-		V = (sums[i++] = V + base::volume_between(*it_p, r_point));
+	for(unsigned int i = 0 ; i < n ; ++i) {
+		V = (sums[i] = V + base::volume_between(points[i], r_point));
+		std::copy(points[i].begin(), points[i].end(), flat_points.begin() + i * dim);
 	}
 
+	const mc_sampler sampler(m_n_threads);
+	const boost::uint64_t seed = (static_cast<boost::uint64_t>(m_drng() * 4294967296.0) << 32) ^ static_cast<boost::uint64_t>(m_drng() * 4294967296.0);
+	const unsigned int n_blocks = 4 * sampler.get_n_threads();
+	std::vector<boost::uint_fast64_t> trials(n_blocks * mc_sampler::block_size);
+
 	unsigned long long M = 0; // Round counter
-	unsigned long long M_sum = 0; // Total number of samples over every round so far
+	boost::uint_fast64_t M_sum = 0; // Total number of trials over every round so far
+	for (unsigned long long first_block = 0 ; ; first_block += n_blocks) {
+		const block_task task = {flat_points, sums, r_point, seed, first_block, T, trials};
+		sampler.run(n_blocks, task);
+		for (std::vector<boost::uint_fast64_t>::const_iterator it = trials.begin() ; it != trials.end() ; ++it) {
+			if (M_sum + *it > T) {
+				return (T * V) / static_cast<double>(n * M);
+			}
+			M_sum += *it;
+			++M;
+		}
+	}
+}
 
-	// Container for the random point
+/// Samples of a block
+void bf_fpras::block_task::operator()(unsigned int b) const
+{
+	const unsigned int n = sums.size();
+	const unsigned int dim = r_point.size();
+	const double V = sums.back();
+	mc_sampler::stream rng(seed, 0, first_block + b);
 	fitness_vector rnd_point(dim, 0.0);
-
-	while(true) {
+	for (unsigned int k = 0 ; k < mc_sampler::block_size ; ++k) {
 		// Get the random volume in-between [0, V] range, in order to choose the box with probability sums[i] / V
-		double r = m_drng() * V;
-
+		const double r = rng() * V;
 		// Find the contributor using binary search
-		it_sums = std::lower_bound(sums.begin(), sums.end(), r);
-		i = std::distance(sums.begin(), it_sums);
-
+		const unsigned int i = std::distance(sums.begin(), std::lower_bound(sums.begin(), sums.end(), r));
 		// Sample a point inside the 'box' (r_point, points[i])
-		for(unsigned int d_idx = 0 ; d_idx < dim ; ++d_idx) {
-			rnd_point[d_idx] = (points[i][d_idx] + m_drng() * (r_point[d_idx] - points[i][d_idx]));
+		for (unsigned int d_idx = 0 ; d_idx < dim ; ++d_idx) {
+			rnd_point[d_idx] = points[i * dim + d_idx] + rng() * (r_point[d_idx] - points[i * dim + d_idx]);
 		}
-
-		unsigned int j = 0;
-		do {
-			if ( M_sum >= T ) {
-				return (T * V) / static_cast<double>(n * M);
+		// Pick boxes until one contains the sample, no need to go beyond the total number of trials
+		boost::uint_fast64_t t = 0;
+		bool covered = false;
+		while (!covered && t <= max_trials) {
+			const double *p = &points[static_cast<unsigned int>(n * rng()) * dim];
+			++t;
+			covered = true;
+			for (unsigned int d_idx = 0 ; d_idx < dim ; ++d_idx) {
+				if (p[d_idx] > rnd_point[d_idx]) {
+					covered = false;
+					break;
+				}
 			}
-			j = static_cast<unsigned int>(n * m_drng());
-			++M_sum;
-		} while (!(base::dom_cmp(rnd_point, points[j]) == base::DOM_CMP_B_DOMINATES_A));
-		++M;
+		}
+		trials[b * mc_sampler::block_size + k] = t;
 	}
 }
 
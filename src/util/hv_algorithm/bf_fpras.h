@@ -32,6 +32,7 @@
 #include "../../rng.h"
 
 #include "base.h"
+#include "mc_sampler.h"
 
 #include "../hypervolume.h"
 
@@ -48,7 +49,7 @@ namespace pagmo { namespace util { namespace hv_algorithm {
 class __PAGMO_VISIBLE bf_fpras : public base
 {
 public:
-	bf_fpras(const double eps = 1e-2, const double delta = 1e-2);
+	bf_fpras(const double eps = 1e-2, const double delta = 1e-2, const unsigned int n_threads = 1);
 
 	double compute(std::vector<fitness_vector> &, const fitness_vector &) const;
 
@@ -62,20 +63,40 @@ public:
 	std::string get_name() const;
 
 private:
+	// draws the samples of a range of blocks, storing the number of trials needed by each sample
+	struct block_task
+	{
+		void operator()(unsigned int) const;
+		const std::vector<double> &points;
+		const std::vector<double> &sums;
+		const fitness_vector &r_point;
+		const boost::uint64_t seed;
+		const unsigned long long first_block;
+		const boost::uint_fast64_t max_trials;
+		std::vector<boost::uint_fast64_t> &trials;
+	};
+
 	// error of the approximation
 	const double m_eps;
 	// probabiltiy of error
 	const double m_delta;
 
+	// number of threads drawing the samples
+	const unsigned int m_n_threads;
+
 	mutable rng_double m_drng;
 
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & boost::serialization::base_object<base>(*this);
 		ar & const_cast<double &>(m_eps);
 		ar & const_cast<double &>(m_delta);
+		// The number of threads was added in version 1.
+		if (version >= 1) {
+			ar & const_cast<unsigned int &>(m_n_threads);
+		}
 		ar & m_drng;
 	}
 };
@@ -83,5 +104,6 @@ private:
 } } }
 
 BOOST_CLASS_EXPORT_KEY(pagmo::util::hv_algorithm::bf_fpras)
+BOOST_CLASS_VERSION(pagmo::util::hv_algorithm::bf_fpras,1)
 
 #endif
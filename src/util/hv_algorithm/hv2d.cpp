@@ -134,8 +134,8 @@ std::vector<double> hv2d::contributions(std::vector<fitness_vector> &points, con
 		new_points[i][1] = points[i][1];
 		new_points[i][2] = 0.0;
 	}
-	// Set sorting to off since contributions are sorted by third dimension
-	return hv3d(false).contributions(new_points, new_r);
+	// Keep the sorting on: with the third dimension flat, hv3d orders the points by the second and the first one
+	return hv3d().contributions(new_points, new_r);
 }
 
 
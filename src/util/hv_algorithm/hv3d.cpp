@@ -24,7 +24,6 @@
 
 
 #include "hv3d.h"
-#include "wfg.h"
 
 namespace pagmo { namespace util { namespace hv_algorithm {
 
@@ -38,14 +37,175 @@ namespace pagmo { namespace util { namespace hv_algorithm {
  */
 hv3d::hv3d(bool initial_sorting) : m_initial_sorting(initial_sorting) { }
 
+/// Sweeping front of the hv3d algorithms
+/**
+ * Staircase of the points that are non-dominated in the xy-plane, ordered ascending by the first coordinate.
+ * Instead of a balanced tree of fitness vectors, the front is a doubly linked list over the indices of a flat array of points,
+ * and the ordered searches go through a Fenwick tree over the ranks of the points by their first coordinate.
+ * Every operation takes O(log n) time and no memory is allocated during the sweep.
+ *
+ * The last two points of the flat array are the sentinels (-INF, r[1], .) and (r[0], -INF, .), which are in the front from the start.
+ */
+class hv3d::sweep_front
+{
+public:
+	sweep_front(const std::vector<double> &, unsigned int);
+	unsigned int prev_lower(unsigned int) const;
+	/// Point following i in the front
+	unsigned int next(unsigned int i) const { return m_next[i]; }
+	void insert_after(unsigned int, unsigned int);
+	void erase(unsigned int);
+
+private:
+	struct x_cmp
+	{
+		x_cmp(const std::vector<double> &p) : m_p(p) { }
+		bool operator()(unsigned int a, unsigned int b) const { return m_p[3 * a] < m_p[3 * b]; }
+		const std::vector<double> &m_p;
+	};
+	void add(unsigned int, int);
+	unsigned int count_below(unsigned int) const;
+	unsigned int select(unsigned int) const;
+
+	std::vector<unsigned int> m_rank;
+	std::vector<unsigned int> m_first_rank;
+	std::vector<unsigned int> m_at_rank;
+	std::vector<unsigned int> m_next;
+	std::vector<unsigned int> m_prev;
+	std::vector<int> m_tree;
+	unsigned int m_step;
+};
+
+/// Constructor
+/**
+ * @param[in] p flat array of n + 2 three-dimensional points, sentinels included
+ * @param[in] n number of points, sentinels excluded
+ */
+hv3d::sweep_front::sweep_front(const std::vector<double> &p, unsigned int n)
+	: m_rank(n + 2), m_first_rank(n + 2), m_at_rank(n + 2), m_next(n + 2), m_prev(n + 2), m_tree(n + 3, 0), m_step(1)
+{
+	const unsigned int size = n + 2;
+	for (unsigned int i = 0; i < size; ++i) {
+		m_at_rank[i] = i;
+	}
+	std::sort(m_at_rank.begin(), m_at_rank.end(), x_cmp(p));
+	for (unsigned int k = 0; k < size; ++k) {
+		m_rank[m_at_rank[k]] = k;
+		m_first_rank[m_at_rank[k]] = (k > 0 && p[3 * m_at_rank[k]] == p[3 * m_at_rank[k - 1]]) ? m_first_rank[m_at_rank[k - 1]] : k;
+	}
+	while (2 * m_step <= size) {
+		m_step *= 2;
+	}
+	m_next[n] = n + 1;
+	m_prev[n + 1] = n;
+	add(m_rank[n], 1);
+	add(m_rank[n + 1], 1);
+}
+
+/// Last point of the front whose first coordinate is strictly lower than the one of point i
+unsigned int hv3d::sweep_front::prev_lower(unsigned int i) const
+{
+	return m_at_rank[select(count_below(m_first_rank[i]) - 1)];
+}
+
+/// Link point i right after point j
+void hv3d::sweep_front::insert_after(unsigned int j, unsigned int i)
+{
+	m_next[i] = m_next[j];
+	m_prev[i] = j;
+	m_prev[m_next[j]] = i;
+	m_next[j] = i;
+	add(m_rank[i], 1);
+}
+
+/// Unlink point i
+void hv3d::sweep_front::erase(unsigned int i)
+{
+	m_next[m_prev[i]] = m_next[i];
+	m_prev[m_next[i]] = m_prev[i];
+	add(m_rank[i], -1);
+}
+
+void hv3d::sweep_front::add(unsigned int rank, int delta)
+{
+	for (unsigned int j = rank + 1; j < m_tree.size(); j += j & (~j + 1)) {
+		m_tree[j] += delta;
+	}
+}
+
+// Number of points in the front with rank lower than the given one.
+unsigned int hv3d::sweep_front::count_below(unsigned int rank) const
+{
+	int count = 0;
+	for (unsigned int j = rank; j > 0; j -= j & (~j + 1)) {
+		count += m_tree[j];
+	}
+	return count;
+}
+
+// Rank of the k-th (starting from 0) point of the front.
+unsigned int hv3d::sweep_front::select(unsigned int k) const
+{
+	unsigned int pos = 0;
+	int rem = k + 1;
+	for (unsigned int step = m_step; step > 0; step /= 2) {
+		if (pos + step < m_tree.size() && m_tree[pos + step] < rem) {
+			pos += step;
+			rem -= m_tree[pos];
+		}
+	}
+	return pos;
+}
+
+/// Comparator method for the initial sorting of the points
+bool hv3d::zyx_cmp::operator()(unsigned int a, unsigned int b) const
+{
+	const fitness_vector &pa = m_points[a], &pb = m_points[b];
+	if (pa[2] != pb[2]) {
+		return pa[2] < pb[2];
+	}
+	if (pa[1] != pb[1]) {
+		return pa[1] < pb[1];
+	}
+	return pa[0] < pb[0];
+}
+
+/// Flatten the points
+/**
+ * Copies the points into a flat array (three coordinates per point), sorted ascending by the third, second and first coordinate
+ * unless the initial sorting was disabled, and appends the two sentinels of the sweeping front.
+ *
+ * @param[out] p flat array of points
+ * @param[out] order original index of every point of the flat array
+ * @param[in] points vector of points containing the 3-dimensional points
+ * @param[in] r_point reference point for the points
+ */
+void hv3d::flatten(std::vector<double> &p, std::vector<unsigned int> &order, const std::vector<fitness_vector> &points, const fitness_vector &r_point) const
+{
+	const unsigned int n = points.size();
+	order.resize(n);
+	for (unsigned int i = 0; i < n; ++i) {
+		order[i] = i;
+	}
+	if (m_initial_sorting) {
+		std::sort(order.begin(), order.end(), zyx_cmp(points));
+	}
+	const double INF = std::numeric_limits<double>::max();
+	p.resize(3 * (n + 2));
+	for (unsigned int i = 0; i < n; ++i) {
+		std::copy(points[order[i]].begin(), points[order[i]].begin() + 3, p.begin() + 3 * i);
+	}
+	p[3 * n] = -INF; p[3 * n + 1] = r_point[1]; p[3 * n + 2] = r_point[2];
+	p[3 * n + 3] = r_point[0]; p[3 * n + 4] = -INF; p[3 * n + 5] = r_point[2];
+}
+
 /// Compute hypervolume
 /**
  * This method should be used both as a solution to 3D cases, and as a general termination method for algorithms that reduce D-dimensional problem to 3-dimensional one.
  *
  * This is the implementation of the algorithm for computing hypervolume as it was presented by Nicola Beume et al.
- * The implementation uses std::multiset (which is based on red-black tree data structure) as a container for the sweeping front.
- * Original implementation by Beume et. al uses AVL-tree.
- * The difference is insiginificant as the important characteristics (maintaining order when traversing, self-balancing) of both structures and the asymptotic times (O(log n) updates) are guaranteed.
+ * Original implementation by Beume et. al uses AVL-tree for the sweeping front, here it is kept in a hv3d::sweep_front.
+ * The important characteristics (maintaining order when traversing, O(log n) updates) are the same.
  * Computational complexity: O(n*log(n))
  *
  * @param[in] points vector of points containing the 3-dimensional points for which we compute the hypervolume
@@ -55,80 +215,73 @@ hv3d::hv3d(bool initial_sorting) : m_initial_sorting(initial_sorting) { }
  */
 double hv3d::compute(std::vector<fitness_vector> &points, const fitness_vector &r_point) const
 {
-	if (m_initial_sorting) {
-		sort(points.begin(), points.end(), fitness_vector_cmp(2,'<'));
+	std::vector<double> p;
+	std::vector<unsigned int> order;
+	flatten(p, order, points, r_point);
+	return sweep_volume(p, points.size(), r_point);
+}
+
+/// Hypervolume of a flat array of points
+/**
+ * @param[in] p flat array of n points sorted ascending by the third coordinate, followed by the sentinels
+ * @param[in] n number of points
+ * @param[in] r_point reference point for the points
+ *
+ * @return hypervolume.
+ */
+double hv3d::sweep_volume(const std::vector<double> &p, unsigned int n, const fitness_vector &r_point)
+{
+	if (n == 0) {
+		return 0.0;
 	}
+	sweep_front front(p, n);
+	const double r1 = r_point[1];
 	double V = 0.0; // hypervolume
 	double A = 0.0; // area of the sweeping plane
-	std::multiset<fitness_vector, fitness_vector_cmp> T(fitness_vector_cmp(0, '>'));
-
-	// sentinel points (r_point[0], -INF, r_point[2]) and (-INF, r_point[1], r_point[2])
-	const double INF = std::numeric_limits<double>::max();
-	fitness_vector sA(r_point.begin(), r_point.end()); sA[1] = -INF;
-	fitness_vector sB(r_point.begin(), r_point.end()); sB[0] = -INF;
-
-	T.insert(sA);
-	T.insert(sB);
-	double z3 = points[0][2];
-	T.insert(points[0]);
-	A = fabs((points[0][0] - r_point[0]) * (points[0][1] - r_point[1]));
-
-	std::multiset<fitness_vector>::iterator p;
-	std::multiset<fitness_vector>::iterator q;
-	for(std::vector<fitness_vector>::size_type idx = 1 ; idx < points.size() ; ++idx) {
-		p = T.insert(points[idx]);
-		q = (p);
-		++q; //setup q to be a successor of p
-		if ( (*q)[1] <= (*p)[1] ) { // current point is dominated
-			T.erase(p); // disregard the point from further calculation
-		} else {
-			V += A * fabs(z3 - (*p)[2]);
-			z3 = (*p)[2];
-			std::multiset<fitness_vector>::reverse_iterator rev_it(q);
-			++rev_it;
-
-			std::multiset<fitness_vector>::reverse_iterator erase_begin (rev_it);
-			std::multiset<fitness_vector>::reverse_iterator rev_it_pred;
-			while((*rev_it)[1] >= (*p)[1] ) {
-				rev_it_pred = rev_it;
-				++rev_it_pred;
-				A -= fabs(((*rev_it)[0] - (*rev_it_pred)[0])*((*rev_it)[1] - (*q)[1]));
-				++rev_it;
-			}
-			A += fabs(((*p)[0] - (*(rev_it))[0])*((*p)[1] - (*q)[1]));
-			T.erase(rev_it.base(),erase_begin.base());
+	double z3 = p[2];
+	for (unsigned int i = 0; i < n; ++i) {
+		const double *pi = &p[3 * i];
+		const unsigned int t = front.prev_lower(i);
+		unsigned int s = front.next(t);
+		// current point is dominated
+		if (p[3 * t + 1] <= pi[1] || (p[3 * s] == pi[0] && p[3 * s + 1] <= pi[1])) {
+			continue;
 		}
+		V += A * (pi[2] - z3);
+		z3 = pi[2];
+		// t now covers the plane only up to the current point
+		A -= (p[3 * s] - pi[0]) * (r1 - p[3 * t + 1]);
+		// points dominated by the current one in the xy-plane leave the front
+		while (p[3 * s + 1] >= pi[1]) {
+			const unsigned int s_next = front.next(s);
+			A -= (p[3 * s_next] - p[3 * s]) * (r1 - p[3 * s + 1]);
+			front.erase(s);
+			s = s_next;
+		}
+		A += (p[3 * s] - pi[0]) * (r1 - pi[1]);
+		front.insert_after(t, i);
 	}
-	V += A * fabs(z3 - r_point[2]);
-
+	V += A * (r_point[2] - z3);
 	return V;
 }
 
-/// Comparator method for hycon3d algorithm's tree structure
-bool hv3d::hycon3d_tree_cmp::operator()(const std::pair<fitness_vector, int> &a, const std::pair<fitness_vector, int> &b)
-{
-	return a.first[0] > b.first[0];
-}
-
 /// Box volume method
 /**
- * Returns the volume of the box3d object
+ * Returns the volume of the box3d object closed at the level uz.
  */
-double hv3d::box_volume(const box3d &b)
+double hv3d::box_volume(const box3d &b, double uz)
 {
-	return fabs((b.ux - b.lx) * (b.uy - b.ly) * (b.uz - b.lz));
-}
-
-/// Comparator method for the hycon3d algorithm's sorting procedure
-bool hv3d::hycon3d_sort_cmp(const std::pair<fitness_vector, unsigned int> &a, const std::pair<fitness_vector, unsigned int> &b)
-{
-	return a.first[2] < b.first[2];
+	return (b.ux - b.lx) * (b.uy - b.ly) * (uz - b.lz);
 }
 
 /// Contributions method
-/*
+/**
  * This method is the implementation of the HyCon3D algorithm.
  * This algorithm computes the exclusive contribution to the hypervolume by every point, using an efficient HyCon3D algorithm by Emmerich and Fonseca.
+ * Computational complexity: O(n*log(n))
+ *
+ * HyCon3D requires a non-dominated set of points. When a dominated point (or a duplicate) is met, the contributions are computed instead
+ * from the limited sets of every point (see hv3d::limited_contributions), in O(n^2*log(n)) time.
  *
  * @see "Computing hypervolume contribution in low dimensions: asymptotically optimal algorithm and complexity results", Michael T. M. Emmerich, Carlos M. Fonseca
  *
@@ -138,138 +291,158 @@ bool hv3d::hycon3d_sort_cmp(const std::pair<fitness_vector, unsigned int> &a, co
  */
 std::vector<double> hv3d::contributions(std::vector<fitness_vector> &points, const fitness_vector &r_point) const
 {
-	// Make a copy of the original set of points
-	std::vector<fitness_vector> p(points.begin(), points.end());
-
-	std::vector<std::pair<fitness_vector, unsigned int> > point_pairs;
-	point_pairs.reserve(p.size());
-	for(unsigned int i = 0 ; i < p.size() ; ++i) {
-		point_pairs.push_back(std::make_pair(p[i], i));
-	}
-	if (m_initial_sorting) {
-		sort(point_pairs.begin(), point_pairs.end(), hycon3d_sort_cmp);
-	}
-	for(unsigned int i = 0 ; i < p.size() ; ++i) {
-		p[i] = point_pairs[i].first;
+	const unsigned int n = points.size();
+	std::vector<double> p;
+	std::vector<unsigned int> order;
+	flatten(p, order, points, r_point);
+
+	std::vector<double> c;
+	if (!sweep_contributions(p, n, r_point, c)) {
+		limited_contributions(p, n, r_point, c);
 	}
 
+	// Fix the indices
+	std::vector<double> contribs(n, 0.0);
+	for (unsigned int i = 0; i < n; ++i) {
+		contribs[order[i]] = c[i];
+	}
+	return contribs;
+}
 
-	typedef std::multiset<std::pair<fitness_vector, int>, hycon3d_tree_cmp > tree_t;
-
-	unsigned int n = p.size();
-	const double INF = std::numeric_limits<double>::max();
-
-	// Placeholder value for undefined lower z value.
-	const double NaN = INF;
-
-	// Contributions
-	std::vector<double> c(n, 0.0);
-
-	// Sentinel points
-	fitness_vector s_x(3, -INF); s_x[0] = r_point[0]; // (r,oo,oo)
-	fitness_vector s_y(3, -INF); s_y[1] = r_point[1]; // (oo,r,oo)
-	fitness_vector s_z(3, -INF); s_z[2] = r_point[2]; // (oo,oo,r)
-
-	p.push_back(s_z); // p[n]
-	p.push_back(s_x); // p[n + 1]
-	p.push_back(s_y); // p[n + 2]
-
-	tree_t T;
-	T.insert(std::make_pair(p[0], 0));
-	T.insert(std::make_pair(s_x, n + 1));
-	T.insert(std::make_pair(s_y, n + 2));
-
-	// Boxes
-	std::vector<std::deque<box3d> > L(n + 3);
-
-	box3d b(r_point[0], r_point[1], NaN, p[0][0], p[0][1], p[0][2]);
-	L[0].push_front(b);
-
-	for (unsigned int i = 1 ; i < n + 1 ; ++i) {
-		std::pair<fitness_vector, int> pi(p[i], i);
-
-		tree_t::iterator it = T.lower_bound(pi);
-
+/// HyCon3D sweep over a flat array of points
+/**
+ * The exclusive region of every point of the front is split into boxes in the xy-plane, opened at the level of the sweep at which they were created.
+ * When a point enters the front, the boxes of its neighbours and of the points it dominates in the xy-plane are closed, fully or in part, and their volume
+ * is added to the contribution of their owner. Boxes are stored in a single pool: the boxes of a point are created all at once and contiguously when the point enters the front,
+ * and later on they can only be removed from either end, or replaced at the front, so every point owns a [head, tail) range of the pool.
+ *
+ * @param[in] p flat array of n points sorted ascending by the third coordinate, followed by the sentinels
+ * @param[in] n number of points
+ * @param[in] r_point reference point for the points
+ * @param[out] c contributions of the points
+ *
+ * @return false if a dominated point was found, in which case c is meaningless.
+ */
+bool hv3d::sweep_contributions(const std::vector<double> &p, unsigned int n, const fitness_vector &r_point, std::vector<double> &c)
+{
+	c.assign(n + 2, 0.0);
+	sweep_front front(p, n);
+	std::vector<box3d> boxes;
+	boxes.reserve(2 * n + 1);
+	std::vector<unsigned int> head(n + 2, 0), tail(n + 2, 0), d;
+
+	for (unsigned int i = 0; i < n; ++i) {
+		const double *pi = &p[3 * i];
+		const double z = pi[2];
+		const unsigned int t = front.prev_lower(i);
+		unsigned int s = front.next(t);
 		// Point is dominated
-		if (p[i][1] >= (*it).first[1]) {
-			return wfg(2).contributions(points, r_point);
+		if (p[3 * t + 1] <= pi[1] || (p[3 * s] == pi[0] && p[3 * s + 1] <= pi[1])) {
+			return false;
 		}
-
-		tree_t::reverse_iterator r_it(it);
-
-		std::vector<int> d;
-
-		while((*r_it).first[1] > p[i][1]) {
-			d.push_back((*r_it).second);
-			++r_it;
+		// Points dominated in the xy-plane, region M
+		d.clear();
+		while (p[3 * s + 1] >= pi[1]) {
+			if (p[3 * s + 2] == z) {
+				return false;
+			}
+			d.push_back(s);
+			s = front.next(s);
 		}
-
-		int r = (*it).second;
-		int t = (*r_it).second;
-
-		T.erase(r_it.base(), it);
-
-		// Process right neighbor region, region R
-		while(!L[r].empty()) {
-			box3d& b = L[r].front();
-			if(b.ux >= p[i][0]) {
-				b.lz = p[i][2];
-				c[r] += box_volume(b);
-				L[r].pop_front();
-			} else if(b.lx > p[i][0]) {
-				b.lz = p[i][2];
-				c[r] += box_volume(b);
-				b.lx = p[i][0];
-				b.uz = p[i][2];
-				b.lz = NaN;
-				break;
+		const unsigned int b = s;
+
+		// Process left neighbour region: boxes at the right of the current point are covered
+		while (head[t] != tail[t]) {
+			box3d &bx = boxes[tail[t] - 1];
+			if (bx.lx >= pi[0]) {
+				c[t] += box_volume(bx, z);
+				--tail[t];
 			} else {
+				if (bx.ux > pi[0]) {
+					c[t] += box_volume(bx, z);
+					bx.ux = pi[0];
+					bx.lz = z;
+				}
 				break;
 			}
 		}
 
-		// Process dominated points, region M
-		double xleft = p[t][0];
-		std::vector<int>::reverse_iterator r_it_idx = d.rbegin();
-		std::vector<int>::reverse_iterator r_it_idx_e = d.rend();
-		for(;r_it_idx != r_it_idx_e ; ++r_it_idx) {
-			int jdom = *r_it_idx;
-			while(!L[jdom].empty()) {
-				box3d& b = L[jdom].front();
-				b.lz = p[i][2];
-				c[jdom] += box_volume(b);
-				L[jdom].pop_front();
+		// Process dominated points and open the boxes of the current point, ascending in the first coordinate
+		double xl = pi[0], yu = p[3 * t + 1];
+		head[i] = boxes.size();
+		for (std::vector<unsigned int>::const_iterator it = d.begin(); it != d.end(); ++it) {
+			for (unsigned int k = head[*it]; k < tail[*it]; ++k) {
+				c[*it] += box_volume(boxes[k], z);
 			}
-			L[i].push_back(box3d(xleft, p[jdom][1], NaN, p[jdom][0], p[i][1], p[i][2]));
-			xleft = p[jdom][0];
-		}
-		L[i].push_back(box3d(xleft, p[r][1], NaN, p[i][0], p[i][1], p[i][2]));
-		xleft = p[t][0];
-
-		// Process left neighbor region, region L
-		while(!L[t].empty()) {
-			box3d &b = L[t].back();
-			if(b.ly > p[i][1]) {
-				b.lz = p[i][2];
-				c[t] += box_volume(b);
-				xleft = b.lx;
-				L[t].pop_back();
-			} else {
-				break;
+			tail[*it] = head[*it];
+			if (p[3 * *it] > xl) {
+				boxes.push_back(box3d(xl, pi[1], z, p[3 * *it], yu));
 			}
+			xl = p[3 * *it];
+			yu = p[3 * *it + 1];
+			front.erase(*it);
+		}
+		if (p[3 * b] > xl) {
+			boxes.push_back(box3d(xl, pi[1], z, p[3 * b], yu));
+		}
+		tail[i] = boxes.size();
+
+		// Process right neighbour region: boxes above the current point are covered
+		double xr = p[3 * b];
+		while (head[b] != tail[b] && boxes[head[b]].uy > pi[1]) {
+			c[b] += box_volume(boxes[head[b]], z);
+			xr = boxes[head[b]].ux;
+			++head[b];
 		}
-		if (xleft > p[t][0]) {
-			L[t].push_back(box3d(xleft, p[i][1], NaN, p[t][0], p[t][1], p[i][2]));
+		if (xr > p[3 * b]) {
+			--head[b];
+			boxes[head[b]] = box3d(p[3 * b], p[3 * b + 1], z, xr, pi[1]);
 		}
-		T.insert(std::make_pair(p[i], i));
+
+		front.insert_after(t, i);
 	}
 
-	// Fix the indices
-	std::vector<double> contribs(n, 0.0);
-	for(unsigned int i=0;i < c.size();++i) {
-		contribs[point_pairs[i].second] = c[i];
+	// Close the remaining boxes at the reference point
+	for (unsigned int i = 0; i < n; ++i) {
+		for (unsigned int k = head[i]; k < tail[i]; ++k) {
+			c[i] += box_volume(boxes[k], r_point[2]);
+		}
+	}
+	c.resize(n);
+	return true;
+}
+
+/// Contributions through the limited sets
+/**
+ * The exclusive contribution of the point p is the volume of its box minus the hypervolume of the set {max(p, q) : q != p}, i.e. the rest of the points limited to the box of p.
+ * This holds for any set of points, including the dominated ones and the duplicates.
+ * The limited sets of a set sorted ascending by the third coordinate are sorted as well, so every one of them costs a single sweep.
+ *
+ * @param[in] p flat array of n points sorted ascending by the third coordinate, followed by the sentinels
+ * @param[in] n number of points
+ * @param[in] r_point reference point for the points
+ * @param[out] c contributions of the points
+ */
+void hv3d::limited_contributions(const std::vector<double> &p, unsigned int n, const fitness_vector &r_point, std::vector<double> &c)
+{
+	c.assign(n, 0.0);
+	std::vector<double> q(3 * (n + 1));
+	std::copy(p.end() - 6, p.end(), q.end() - 6);
+	for (unsigned int i = 0; i < n; ++i) {
+		const double *pi = &p[3 * i];
+		const double vol = (r_point[0] - pi[0]) * (r_point[1] - pi[1]) * (r_point[2] - pi[2]);
+		if (vol == 0.0) {
+			continue;
+		}
+		for (unsigned int j = 0, k = 0; j < n; ++j) {
+			if (j != i) {
+				for (unsigned int f = 0; f < 3; ++f, ++k) {
+					q[k] = std::max(pi[f], p[3 * j + f]);
+				}
+			}
+		}
+		c[i] = std::max(0.0, vol - sweep_volume(q, n - 1, r_point));
 	}
-	return contribs;
 }
 
 /// Verify before compute
@@ -42,7 +42,8 @@ namespace pagmo { namespace util { namespace hv_algorithm {
  * This class contains the implementation of efficient algorithms for the hypervolume computation in 3-dimensions.
  *
  * 'compute' method relies on the efficient algorithm as it was presented by Nicola Beume et al.
- * 'least[greatest]_contributor' methods rely on the HyCon3D algorithm by Emmerich and Fonseca.
+ * 'contributions' and 'least[greatest]_contributor' methods rely on the HyCon3D algorithm by Emmerich and Fonseca.
+ * Both sweeps keep the points in a flat array and the sweeping front in an index-based structure (see hv3d::sweep_front).
  *
  * @see "On the Complexity of Computing the Hypervolume Indicator", Nicola Beume, Carlos M. Fonseca, Manuel Lopez-Ibanez, Luis Paquete, Jan Vahrenhold. IEEE TRANSACTIONS ON EVOLUTIONARY COMPUTATION, VOL. 13, NO. 5, OCTOBER 2009
  * @see "Computing hypervolume contribution in low dimensions: asymptotically optimal algorithm and complexity results", Michael T. M. Emmerich, Carlos M. Fonseca
@@ -64,25 +65,33 @@ private:
 	// flag stating whether the points should be sorted in the first step of the algorithm
 	const bool m_initial_sorting;
 
+	// Box in the xy-plane, opened at the level lz of the sweep.
 	struct box3d
 	{
-		box3d(double _lx, double _ly, double _lz, double _ux, double _uy, double _uz)
-			: lx(_lx), ly(_ly), lz(_lz), ux(_ux), uy(_uy), uz(_uz) { }
+		box3d(double _lx, double _ly, double _lz, double _ux, double _uy)
+			: lx(_lx), ly(_ly), lz(_lz), ux(_ux), uy(_uy) { }
 		double lx;
 		double ly;
 		double lz;
 		double ux;
 		double uy;
-		double uz;
 	};
 
-	struct hycon3d_tree_cmp
+	class sweep_front;
+
+	// lexicographic comparison of the points by the third, second and first coordinate
+	struct zyx_cmp
 	{
-		bool operator()(const std::pair<fitness_vector, int> &, const std::pair<fitness_vector, int> &);
+		zyx_cmp(const std::vector<fitness_vector> &points) : m_points(points) { }
+		bool operator()(unsigned int, unsigned int) const;
+		const std::vector<fitness_vector> &m_points;
 	};
 
-	static bool hycon3d_sort_cmp(const std::pair<fitness_vector, unsigned int> &, const std::pair<fitness_vector, unsigned int> &);
-	static double box_volume(const box3d &b);
+	void flatten(std::vector<double> &, std::vector<unsigned int> &, const std::vector<fitness_vector> &, const fitness_vector &) const;
+	static double sweep_volume(const std::vector<double> &, unsigned int, const fitness_vector &);
+	static bool sweep_contributions(const std::vector<double> &, unsigned int, const fitness_vector &, std::vector<double> &);
+	static void limited_contributions(const std::vector<double> &, unsigned int, const fitness_vector &, std::vector<double> &);
+	static double box_volume(const box3d &, double);
 
 	friend class boost::serialization::access;
 	template <class Archive>
@@ -54,6 +54,71 @@ double hv4d::compute(std::vector<fitness_vector> &points, const fitness_vector &
 	return hv;
 }
 
+/// Contributions method
+/**
+ * The exclusive contribution of the point p is the volume of its box minus the hypervolume of its limited set {max(p, q) : q != p}.
+ * The limited sets are built one after the other in a single flat buffer, keeping only their non-dominated points, which are usually
+ * few as the points far from p collapse onto the boundary of its box. The four-dimensional sweep runs then on a small set, so for
+ * well spread fronts the whole computation takes O(n^2) time, instead of the n + 1 full hypervolume computations of the naive approach.
+ * As the limited sets are exact for any set of points, dominated points and duplicates are handled as well (their contribution is 0).
+ *
+ * @param[in] points vector of points containing the 4-dimensional points for which we compute the contributions
+ * @param[in] r_point reference point for the points
+ *
+ * @return vector of exclusive contributions by every point
+ */
+std::vector<double> hv4d::contributions(std::vector<fitness_vector> &points, const fitness_vector &r_point) const
+{
+	const unsigned int n = points.size();
+	std::vector<double> c(n, 0.0);
+	std::vector<double> p(n * 4), data(n * 4);
+	for (unsigned int p_idx = 0 ; p_idx < n ; ++p_idx) {
+		std::copy(points[p_idx].begin(), points[p_idx].begin() + 4, p.begin() + p_idx * 4);
+	}
+	double refpoint[4];
+	std::copy(r_point.begin(), r_point.begin() + 4, refpoint);
+
+	for (unsigned int p_idx = 0 ; p_idx < n ; ++p_idx) {
+		const double *pi = &p[p_idx * 4];
+		const double vol = volume_between(points[p_idx], r_point);
+		if (vol == 0.0) {
+			continue;
+		}
+		unsigned int n_limited = 0;
+		for (unsigned int q_idx = 0 ; q_idx < n ; ++q_idx) {
+			if (q_idx == p_idx) {
+				continue;
+			}
+			double q[4];
+			for (unsigned int d_idx = 0 ; d_idx < 4 ; ++d_idx) {
+				q[d_idx] = std::max(pi[d_idx], p[q_idx * 4 + d_idx]);
+			}
+			// Compare against the non-dominated points of the limited set found so far
+			bool dominated = false;
+			unsigned int k = 0;
+			while (k < n_limited) {
+				const double *l = &data[k * 4];
+				if (l[0] <= q[0] && l[1] <= q[1] && l[2] <= q[2] && l[3] <= q[3]) {
+					dominated = true;
+					break;
+				}
+				if (q[0] <= l[0] && q[1] <= l[1] && q[2] <= l[2] && q[3] <= l[3]) {
+					--n_limited;
+					std::copy(data.begin() + n_limited * 4, data.begin() + n_limited * 4 + 4, data.begin() + k * 4);
+				} else {
+					++k;
+				}
+			}
+			if (!dominated) {
+				std::copy(q, q + 4, data.begin() + n_limited * 4);
+				++n_limited;
+			}
+		}
+		c[p_idx] = std::max(0.0, vol - guerreiro_hv4d(&data[0], n_limited, refpoint));
+	}
+	return c;
+}
+
 /// Verify before compute
 /**
  * Verifies whether given algorithm suits the requested data.
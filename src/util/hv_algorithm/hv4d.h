@@ -25,6 +25,7 @@
 #ifndef PAGMO_UTIL_HV_ALGORITHM_HV4D_H
 #define PAGMO_UTIL_HV_ALGORITHM_HV4D_H
 
+#include <algorithm>
 #include <vector>
 
 #include <stdlib.h>
@@ -47,10 +48,8 @@ namespace pagmo { namespace util { namespace hv_algorithm {
  * - name of the main method was changed from "hv4d" to "guerreiro_hv4d" in order to distinguish it from the name of this class.
  * - main method was altered to return 0 hypervolume BEFORE allocating any memory in case of an empty set of points.
  *
- * Note: As of yet, only the compute method is available.
- * This is due to the fact that the original implementation assumes certain property about the input, namely that the available set of points is a non-dominated one.
- * In order to provide accurate answers to any of the hypervolume features involving exclusive contribution by given point, we need to allow for the input to have dominated points.
- * Since this is not possible, we cannot rely on the hv4d algorithm in those cases - remaining methods, which perform "naive" implementation of said features using the "compute" method, were overloaded to raise an exception.
+ * The original implementation assumes a non-dominated set of points, yet the sweep discards the dominated points it meets, so it can be fed with any set.
+ * Exclusive contributions rely on that: 'contributions' (and thus 'least_contributor' and 'greatest_contributor') computes them through the limited sets of the points.
  *
  * @see Andreia P. Guerreiro, Carlos M. Fonseca, Michael T. Emmerich, "A Fast Dimension-Sweep Algorithm for the Hypervolume Indicator in Four Dimensions", CCCG 2012, Charlottetown, P.E.I., August 8–10, 2012.
  *
@@ -61,6 +60,7 @@ class __PAGMO_VISIBLE hv4d : public base
 {
 public:
 	double compute(std::vector<fitness_vector> &, const fitness_vector &) const;
+	std::vector<double> contributions(std::vector<fitness_vector> &, const fitness_vector &) const;
 
 	void verify_before_compute(const std::vector<fitness_vector> &, const fitness_vector &) const;
 	base_ptr clone() const;
@@ -0,0 +1,137 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include "mc_sampler.h"
+
+namespace pagmo { namespace util { namespace hv_algorithm {
+
+/// Constructor
+/**
+ * @param[in] seed seed of the sampling run
+ * @param[in] id identifier of the stream within the run
+ * @param[in] block index of the block within the stream
+ */
+mc_sampler::stream::stream(boost::uint64_t seed, boost::uint64_t id, boost::uint64_t block)
+	: m_state(mix(seed ^ mix(id + mix(block + 0x9e3779b97f4a7c15ULL))))
+{}
+
+/// Constructor
+/**
+ * @param[in] n_threads number of threads running the tasks. If zero, the number of hardware threads is used.
+ */
+mc_sampler::mc_sampler(unsigned int n_threads)
+	: m_n_threads(n_threads ? n_threads : std::max(boost::thread::hardware_concurrency(), 1u))
+{}
+
+/// Number of threads running the tasks.
+unsigned int mc_sampler::get_n_threads() const
+{
+	return m_n_threads;
+}
+
+/// Structure of arrays
+/**
+ * Stores the coordinates of a subset of points dimension by dimension: coordinate d of the i-th point goes to soa[d * idx.size() + i].
+ *
+ * @param[out] soa coordinates of the points
+ * @param[in] points set of points
+ * @param[in] idx indices of the points to be stored
+ */
+void mc_sampler::to_soa(std::vector<double> &soa, const std::vector<fitness_vector> &points, const std::vector<unsigned int> &idx)
+{
+	const unsigned int n = idx.size();
+	const unsigned int dim = n ? points[idx[0]].size() : 0;
+	soa.resize(n * dim);
+	for (unsigned int i = 0; i < n; ++i) {
+		for (unsigned int d = 0; d < dim; ++d) {
+			soa[d * n + i] = points[idx[i]][d];
+		}
+	}
+}
+
+/// Count the samples of a box that are not dominated by a set of points
+/**
+ * Draws n_blocks * block_size samples uniformly in the box [lb, ub] and tests them against the points, one point at a time and a whole
+ * block of samples at once. The samples dominated by a point are dropped from the block before testing the next one. A sample is checked against the points in order until one of them dominates it, and each check is counted
+ * as dim + 1 elementary operations.
+ *
+ * @param[in] lb lower corner of the box
+ * @param[in] ub upper corner of the box
+ * @param[in] soa coordinates of the points, as stored by to_soa()
+ * @param[in] seed seed of the sampling run
+ * @param[in] id identifier of the stream
+ * @param[in] first_block index of the first block
+ * @param[in] n_blocks number of blocks
+ * @param[in,out] n_ops counter of elementary operations
+ *
+ * @return number of samples not dominated by any of the points.
+ */
+unsigned long long mc_sampler::count_uncovered(const fitness_vector &lb, const fitness_vector &ub, const std::vector<double> &soa, boost::uint64_t seed, boost::uint64_t id,
+	unsigned long long first_block, unsigned long long n_blocks, unsigned long long &n_ops)
+{
+	const unsigned int dim = lb.size();
+	const unsigned int n_points = soa.size() / dim;
+	std::vector<double> x(dim * block_size);
+	std::vector<unsigned char> dom(block_size);
+	unsigned long long retval = 0;
+	for (unsigned long long b = first_block; b < first_block + n_blocks; ++b) {
+		stream rng(seed, id, b);
+		for (unsigned int k = 0; k < block_size; ++k) {
+			for (unsigned int d = 0; d < dim; ++d) {
+				x[d * block_size + k] = lb[d] + rng() * (ub[d] - lb[d]);
+			}
+		}
+		// the first n_alive samples of the block are the ones not dominated so far
+		unsigned int n_alive = block_size;
+		for (unsigned int j = 0; j < n_points && n_alive; ++j) {
+			n_ops += static_cast<unsigned long long>(dim + 1) * n_alive;
+			std::fill(dom.begin(), dom.begin() + n_alive, 1);
+			for (unsigned int d = 0; d < dim; ++d) {
+				const double p = soa[d * n_points + j];
+				const double *xd = &x[d * block_size];
+				for (unsigned int k = 0; k < n_alive; ++k) {
+					dom[k] &= (xd[k] >= p);
+				}
+			}
+			// compact the samples still alive
+			unsigned int n_next = 0;
+			for (unsigned int k = 0; k < n_alive; ++k) {
+				if (!dom[k]) {
+					if (n_next != k) {
+						for (unsigned int d = 0; d < dim; ++d) {
+							x[d * block_size + n_next] = x[d * block_size + k];
+						}
+					}
+					++n_next;
+				}
+			}
+			n_alive = n_next;
+		}
+		retval += n_alive;
+	}
+	return retval;
+}
+
+} } }
@@ -0,0 +1,125 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_UTIL_HV_ALGORITHM_MC_SAMPLER_H
+#define PAGMO_UTIL_HV_ALGORITHM_MC_SAMPLER_H
+
+#include <algorithm>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "../../config.h"
+#include "../../types.h"
+
+namespace pagmo { namespace util { namespace hv_algorithm {
+
+/// Monte-Carlo sampling engine of the hypervolume approximations
+/**
+ * Samples are drawn in blocks of mc_sampler::block_size. Every block takes its random numbers from its own stream, identified by
+ * a seed, a stream id (e.g., the index of the box being sampled) and the index of the block, so that the outcome of a block does not
+ * depend on which thread computes it nor on the blocks computed before. Results are reduced in block order by the caller, hence a
+ * fixed seed gives the same approximation for any number of threads.
+ *
+ * The coordinates of the samples of a block (and those of the points tested against them) are stored dimension by dimension
+ * (structure of arrays), so that the dominance tests run over contiguous arrays of samples and are vectorised by the compiler.
+ */
+class __PAGMO_VISIBLE mc_sampler
+{
+public:
+	/// Number of samples in a block.
+	static const unsigned int block_size = 128;
+
+	/// Random stream of a block
+	/**
+	 * Counter-based generator (SplitMix64): seeding is free, so that every block can have its own stream.
+	 */
+	class __PAGMO_VISIBLE stream
+	{
+	public:
+		stream(boost::uint64_t, boost::uint64_t, boost::uint64_t);
+		/// Uniform random number in [0, 1).
+		double operator()()
+		{
+			m_state += 0x9e3779b97f4a7c15ULL;
+			return static_cast<double>(mix(m_state) >> 11) * (1.0 / 9007199254740992.0);
+		}
+	private:
+		static boost::uint64_t mix(boost::uint64_t z)
+		{
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+			return z ^ (z >> 31);
+		}
+		boost::uint64_t m_state;
+	};
+
+	explicit mc_sampler(unsigned int = 1);
+	unsigned int get_n_threads() const;
+
+	static void to_soa(std::vector<double> &, const std::vector<fitness_vector> &, const std::vector<unsigned int> &);
+	static unsigned long long count_uncovered(const fitness_vector &, const fitness_vector &, const std::vector<double> &, boost::uint64_t, boost::uint64_t,
+		unsigned long long, unsigned long long, unsigned long long &);
+
+	/// Run task(i) for i in [0, n_tasks)
+	/**
+	 * Tasks are dealt to the threads in a round-robin fashion. They must not throw, and must write their results to separate locations.
+	 *
+	 * @param[in] n_tasks number of tasks
+	 * @param[in] task functor called with the index of the task
+	 */
+	template <class Task>
+	void run(unsigned int n_tasks, const Task &task) const
+	{
+		const unsigned int n_threads = std::min(m_n_threads, n_tasks);
+		if (n_threads <= 1) {
+			for (unsigned int i = 0; i < n_tasks; ++i) {
+				task(i);
+			}
+			return;
+		}
+		boost::thread_group threads;
+		for (unsigned int t = 0; t < n_threads; ++t) {
+			threads.create_thread(boost::bind(&mc_sampler::run_slice<Task>, boost::cref(task), t, n_threads, n_tasks));
+		}
+		threads.join_all();
+	}
+
+private:
+	template <class Task>
+	static void run_slice(const Task &task, unsigned int t, unsigned int n_threads, unsigned int n_tasks)
+	{
+		for (unsigned int i = t; i < n_tasks; i += n_threads) {
+			task(i);
+		}
+	}
+
+	unsigned int m_n_threads;
+};
+
+} } }
+
+#endif
@@ -202,6 +202,8 @@ hv_algorithm::base_ptr hypervolume::get_best_contributions(const fitness_vector
 		return hv_algorithm::hv2d().clone();
 	} else if (fdim == 3) {
 		return hv_algorithm::hv3d().clone();
+	} else if (fdim == 4) {
+		return hv_algorithm::hv4d().clone();
 	} else {
 		return hv_algorithm::wfg().clone();
 	}
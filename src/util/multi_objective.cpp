@@ -0,0 +1,409 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "../exceptions.h"
+#include "../problem/base.h"
+#include "../types.h"
+#include "multi_objective.h"
+
+namespace pagmo{ namespace util { namespace multi_objective {
+
+/// Constructor from fitness vectors.
+/**
+ * @param[in] fit fitness vectors, all of the same size.
+ *
+ * @throws value_error if the fitness vectors do not have all the same size.
+ */
+fitness_matrix::fitness_matrix(const std::vector<fitness_vector> &fit):m_size(fit.size()),m_f_dim(fit.size() ? fit[0].size() : 0)
+{
+	m_data.reserve(m_size * m_f_dim);
+	for (size_type i = 0; i < m_size; ++i) {
+		if (fit[i].size() != m_f_dim) {
+			pagmo_throw(value_error,"fitness vectors must all have the same size");
+		}
+		m_data.insert(m_data.end(),fit[i].begin(),fit[i].end());
+	}
+}
+
+/// Squared euclidean distance between two rows.
+/**
+ * @param[in] i first row.
+ * @param[in] j second row.
+ *
+ * @return the squared euclidean distance between the fitness vectors of individuals i and j.
+ */
+double fitness_matrix::distance2(size_type i, size_type j) const
+{
+	const double *a = (*this)[i], *b = (*this)[j];
+	double retval = 0;
+	for (size_type k = 0; k < m_f_dim; ++k) {
+		retval += (a[k] - b[k]) * (a[k] - b[k]);
+	}
+	return retval;
+}
+
+// Orders indices along one objective, ties being broken by index so that the result does not depend on the initial order.
+struct objective_comp {
+	objective_comp(const fitness_matrix &f, size_type dim):m_f(f),m_dim(dim) {}
+	bool operator()(size_type a, size_type b) const
+	{
+		return m_f[a][m_dim] < m_f[b][m_dim] || (m_f[a][m_dim] == m_f[b][m_dim] && a < b);
+	}
+	const fitness_matrix	&m_f;
+	size_type		m_dim;
+};
+
+/// Constructor.
+/**
+ * The tree keeps a reference to the fitness matrix, which must outlive it.
+ *
+ * @param[in] f points to be stored in the tree.
+ */
+kd_tree::kd_tree(const fitness_matrix &f):m_f(f),m_perm(f.size()),m_split(f.size(),0)
+{
+	for (size_type i = 0; i < m_perm.size(); ++i) {
+		m_perm[i] = i;
+	}
+	build(0,m_perm.size());
+}
+
+// Build the subtree of the points in m_perm[lo,hi).
+void kd_tree::build(size_type lo, size_type hi)
+{
+	if (hi - lo < 2) {
+		return;
+	}
+	// Split along the coordinate of largest spread.
+	size_type dim = 0;
+	double spread = -1;
+	for (size_type k = 0; k < m_f.get_f_dimension(); ++k) {
+		double min = m_f[m_perm[lo]][k], max = min;
+		for (size_type i = lo + 1; i < hi; ++i) {
+			min = std::min(min,m_f[m_perm[i]][k]);
+			max = std::max(max,m_f[m_perm[i]][k]);
+		}
+		if (max - min > spread) {
+			spread = max - min;
+			dim = k;
+		}
+	}
+	const size_type mid = lo + (hi - lo) / 2;
+	std::nth_element(m_perm.begin() + lo,m_perm.begin() + mid,m_perm.begin() + hi,objective_comp(m_f,dim));
+	m_split[mid] = dim;
+	build(lo,mid);
+	build(mid + 1,hi);
+}
+
+// Collect in the max-heap best the k smallest squared distances from point p to the points in m_perm[lo,hi), p excluded.
+void kd_tree::search(size_type p, size_type k, size_type lo, size_type hi, std::vector<double> &best) const
+{
+	if (lo >= hi) {
+		return;
+	}
+	const size_type mid = lo + (hi - lo) / 2, q = m_perm[mid];
+	if (q != p) {
+		const double d2 = m_f.distance2(p,q);
+		if (best.size() < k) {
+			best.push_back(d2);
+			std::push_heap(best.begin(),best.end());
+		} else if (d2 < best.front()) {
+			std::pop_heap(best.begin(),best.end());
+			best.back() = d2;
+			std::push_heap(best.begin(),best.end());
+		}
+	}
+	if (hi - lo == 1) {
+		return;
+	}
+	const double diff = m_f[p][m_split[mid]] - m_f[q][m_split[mid]];
+	// Visit first the side containing p, then the other one if it can still contain closer points.
+	if (diff < 0) {
+		search(p,k,lo,mid,best);
+		if (best.size() < k || diff * diff < best.front()) {
+			search(p,k,mid + 1,hi,best);
+		}
+	} else {
+		search(p,k,mid + 1,hi,best);
+		if (best.size() < k || diff * diff < best.front()) {
+			search(p,k,lo,mid,best);
+		}
+	}
+}
+
+/// Distance to the k-th nearest neighbour.
+/**
+ * @param[in] i index of the point.
+ * @param[in] k rank of the neighbour, 1 being the nearest one. The point itself is not counted.
+ *
+ * @return the euclidean distance between point i and its k-th nearest neighbour.
+ *
+ * @throws index_error if i is out of range.
+ * @throws value_error if k is zero or not smaller than the number of points.
+ */
+double kd_tree::kth_distance(size_type i, size_type k) const
+{
+	if (i >= m_perm.size()) {
+		pagmo_throw(index_error,"point index out of range");
+	}
+	if (k == 0 || k >= m_perm.size()) {
+		pagmo_throw(value_error,"the rank of the neighbour must be between 1 and the number of other points");
+	}
+	std::vector<double> best;
+	best.reserve(k);
+	search(i,k,0,m_perm.size(),best);
+	return std::sqrt(best.front());
+}
+
+/// Domination lists.
+/**
+ * Individual i dominates individual j if the problem's compare_fc() prefers i to j.
+ *
+ * @param[out] dom_list indices of the individuals dominated by each individual, in increasing order.
+ * @param[out] dom_count number of individuals dominating each individual.
+ * @param[in] prob problem defining the domination.
+ * @param[in] fit fitness vectors.
+ * @param[in] cons constraint vectors.
+ */
+void domination_lists(std::vector<std::vector<size_type> > &dom_list, std::vector<size_type> &dom_count, const problem::base &prob,
+	const std::vector<fitness_vector> &fit, const std::vector<constraint_vector> &cons)
+{
+	pagmo_assert(fit.size() == cons.size());
+	const size_type n = fit.size();
+	dom_list.assign(n,std::vector<size_type>());
+	dom_count.assign(n,0);
+	for (size_type i = 0; i < n; ++i) {
+		for (size_type j = 0; j < n; ++j) {
+			if (i != j && prob.compare_fc(fit[i],cons[i],fit[j],cons[j])) {
+				dom_list[i].push_back(j);
+				++dom_count[j];
+			}
+		}
+	}
+}
+
+/// Non-dominated sorting.
+/**
+ * Peels the Pareto fronts one after the other, following the domination lists.
+ *
+ * @see Deb, K. and Pratap, A. and Agarwal, S. and Meyarivan, T., "A fast and elitist multiobjective genetic algorithm: NSGA-II"
+ *
+ * @param[out] rank Pareto rank of each individual, 0 being the non-dominated front.
+ * @param[in] dom_list indices of the individuals dominated by each individual.
+ * @param[in] dom_count number of individuals dominating each individual.
+ */
+void non_dominated_sort(std::vector<size_type> &rank, const std::vector<std::vector<size_type> > &dom_list, const std::vector<size_type> &dom_count)
+{
+	pagmo_assert(dom_list.size() == dom_count.size());
+	rank.assign(dom_list.size(),0);
+	std::vector<size_type> count(dom_count), F, S;
+	for (size_type i = 0; i < count.size(); ++i) {
+		if (count[i] == 0) {
+			F.push_back(i);
+		}
+	}
+	for (size_type irank = 1; F.size(); ++irank) {
+		for (size_type i = 0; i < F.size(); ++i) {
+			const std::vector<size_type> &dominated = dom_list[F[i]];
+			for (size_type j = 0; j < dominated.size(); ++j) {
+				if (--count[dominated[j]] == 0) {
+					S.push_back(dominated[j]);
+					rank[dominated[j]] = irank;
+				}
+			}
+		}
+		F.swap(S);
+		S.clear();
+	}
+}
+
+/// Pareto fronts.
+/**
+ * @param[in] rank Pareto rank of each individual.
+ *
+ * @return for each Pareto front, the indices of the individuals belonging to it, in increasing order.
+ */
+std::vector<std::vector<size_type> > pareto_fronts(const std::vector<size_type> &rank)
+{
+	std::vector<std::vector<size_type> > retval;
+	for (size_type i = 0; i < rank.size(); ++i) {
+		if (rank[i] >= retval.size()) {
+			retval.resize(rank[i] + 1);
+		}
+		retval[rank[i]].push_back(i);
+	}
+	return retval;
+}
+
+/// Crowding distance.
+/**
+ * Computes the crowding distance of each individual within its Pareto front. The extremes of a front along any objective
+ * get the largest representable distance. If a front collapses along one objective, that objective does not contribute.
+ *
+ * @see Deb, K. and Pratap, A. and Agarwal, S. and Meyarivan, T., "A fast and elitist multiobjective genetic algorithm: NSGA-II"
+ *
+ * @param[out] crowding_d crowding distance of each individual.
+ * @param[in] f fitness matrix.
+ * @param[in] fronts Pareto fronts, as returned by pareto_fronts().
+ */
+void crowding_distance(std::vector<double> &crowding_d, const fitness_matrix &f, const std::vector<std::vector<size_type> > &fronts)
+{
+	crowding_d.assign(f.size(),0);
+	std::vector<size_type> I;
+	for (size_type k = 0; k < fronts.size(); ++k) {
+		if (fronts[k].empty()) {
+			continue;
+		}
+		I = fronts[k];
+		const size_type last = I.size() - 1;
+		for (size_type dim = 0; dim < f.get_f_dimension(); ++dim) {
+			std::sort(I.begin(),I.end(),objective_comp(f,dim));
+			crowding_d[I[0]] = std::numeric_limits<double>::max();
+			crowding_d[I[last]] = std::numeric_limits<double>::max();
+			// A collapsed front would give NaNs, which can't be serialized.
+			const double df = f[I[last]][dim] - f[I[0]][dim];
+			if (df == 0.0) {
+				continue;
+			}
+			for (size_type j = 1; j < last; ++j) {
+				crowding_d[I[j]] += (f[I[j + 1]][dim] - f[I[j - 1]][dim]) / df;
+			}
+		}
+	}
+}
+
+// Skip the removed individuals at the beginning of a row of sorted neighbours.
+static inline size_type skip_removed(const std::vector<std::pair<double,size_type> > &nb, size_type pos, size_type end, const std::vector<char> &removed)
+{
+	while (pos < end && removed[nb[pos].second]) {
+		++pos;
+	}
+	return pos;
+}
+
+/// SPEA2 archive truncation.
+/**
+ * Removes one individual at a time until n are left. The individual removed is the one having the smallest distance to
+ * its nearest neighbour, ties being broken by the distance to the second nearest neighbour and so on, and then by index.
+ *
+ * Each individual keeps the list of its neighbours sorted once by distance, built in O(N^2 log N). Removed individuals are
+ * skipped lazily, so that a removal costs a scan of the nearest neighbours plus the comparison of the individuals sharing the
+ * smallest nearest-neighbour distance, which seldom go beyond the first few neighbours.
+ *
+ * @see Eckart Zitzler, Marco Laumanns, and Lothar Thiele -- "SPEA2: Improving the Strength Pareto Evolutionary Algorithm"
+ *
+ * @param[in] f fitness matrix.
+ * @param[in] n number of individuals to keep.
+ *
+ * @return the indices of the surviving individuals, in increasing order.
+ */
+std::vector<size_type> spea2_truncation(const fitness_matrix &f, size_type n)
+{
+	const size_type N = f.size();
+	std::vector<size_type> retval;
+	if (n == 0) {
+		return retval;
+	}
+	if (n >= N) {
+		for (size_type i = 0; i < N; ++i) {
+			retval.push_back(i);
+		}
+		return retval;
+	}
+	// Row i of nb holds the other N - 1 individuals sorted by distance from i (squared distances sort the same way).
+	const size_type row = N - 1;
+	std::vector<std::pair<double,size_type> > nb(N * row);
+	for (size_type i = 0; i < N; ++i) {
+		std::pair<double,size_type> *r = &nb[0] + i * row;
+		for (size_type j = 0, c = 0; j < N; ++j) {
+			if (j != i) {
+				r[c++] = std::make_pair(f.distance2(i,j),j);
+			}
+		}
+		std::sort(r,r + row);
+	}
+	std::vector<char> removed(N,0);
+	// Position, in each row, of the nearest individual not yet removed.
+	std::vector<size_type> head(N);
+	for (size_type i = 0; i < N; ++i) {
+		head[i] = i * row;
+	}
+	std::vector<size_type> candidates;
+	for (size_type alive = N; alive > n; --alive) {
+		// Individuals with the smallest nearest-neighbour distance.
+		candidates.clear();
+		double min = std::numeric_limits<double>::infinity();
+		for (size_type i = 0; i < N; ++i) {
+			if (removed[i]) {
+				continue;
+			}
+			head[i] = skip_removed(nb,head[i],(i + 1) * row,removed);
+			const double d = nb[head[i]].first;
+			if (d < min) {
+				min = d;
+				candidates.clear();
+			}
+			if (d == min) {
+				candidates.push_back(i);
+			}
+		}
+		// Among them, the lexicographically smallest sequence of distances (the first one on ties).
+		size_type worst = candidates[0];
+		for (size_type c = 1; c < candidates.size(); ++c) {
+			const size_type i = candidates[c];
+			size_type pi = head[i], pw = head[worst];
+			const size_type ei = (i + 1) * row, ew = (worst + 1) * row;
+			while (true) {
+				pi = skip_removed(nb,pi,ei,removed);
+				pw = skip_removed(nb,pw,ew,removed);
+				if (pi == ei || pw == ew) {
+					break;
+				}
+				if (nb[pi].first != nb[pw].first) {
+					if (nb[pi].first < nb[pw].first) {
+						worst = i;
+					}
+					break;
+				}
+				++pi;
+				++pw;
+			}
+		}
+		removed[worst] = 1;
+	}
+	for (size_type i = 0; i < N; ++i) {
+		if (!removed[i]) {
+			retval.push_back(i);
+		}
+	}
+	return retval;
+}
+
+}}}
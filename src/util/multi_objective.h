@@ -0,0 +1,112 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_UTIL_MULTI_OBJECTIVE_H
+#define PAGMO_UTIL_MULTI_OBJECTIVE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "../config.h"
+#include "../problem/base.h"
+#include "../types.h"
+
+namespace pagmo{ namespace util {
+
+/// Multi-objective utilities.
+/**
+ * Non-dominated sorting, crowding distance and nearest-neighbour density estimation, shared by the population and by
+ * the multi-objective algorithms. Distances in objective space are computed on a fitness_matrix, where the fitness
+ * vectors are stored one after the other in a single block of memory.
+ */
+namespace multi_objective {
+
+/// Type for the indices of the individuals.
+typedef std::vector<double>::size_type size_type;
+
+/// Flat fitness matrix.
+/**
+ * Row i holds the fitness vector of individual i.
+ */
+class __PAGMO_VISIBLE fitness_matrix
+{
+	public:
+		explicit fitness_matrix(const std::vector<fitness_vector> &);
+		/// Number of rows.
+		size_type size() const
+		{
+			return m_size;
+		}
+		/// Number of objectives.
+		size_type get_f_dimension() const
+		{
+			return m_f_dim;
+		}
+		/// Fitness vector of individual i.
+		const double *operator[](size_type i) const
+		{
+			return &m_data[0] + i * m_f_dim;
+		}
+		double distance2(size_type, size_type) const;
+
+	private:
+		size_type		m_size;
+		size_type		m_f_dim;
+		std::vector<double>	m_data;
+};
+
+/// KD-tree for nearest-neighbour queries in objective space.
+/**
+ * The tree is built once in O(N log N) by splitting the points at the median of the coordinate of largest spread. Queries
+ * for the k-th nearest neighbour of one of the points are then answered visiting only the cells that can contain
+ * points closer than the current k candidates.
+ */
+class __PAGMO_VISIBLE kd_tree
+{
+	public:
+		explicit kd_tree(const fitness_matrix &);
+		double kth_distance(size_type, size_type) const;
+
+	private:
+		void build(size_type, size_type);
+		void search(size_type, size_type, size_type, size_type, std::vector<double> &) const;
+
+		const fitness_matrix	&m_f;
+		// Permutation of the points: the point at the middle of each range is the node splitting the range.
+		std::vector<size_type>	m_perm;
+		// Splitting coordinate of each node, indexed as m_perm.
+		std::vector<size_type>	m_split;
+};
+
+void domination_lists(std::vector<std::vector<size_type> > &, std::vector<size_type> &, const problem::base &,
+	const std::vector<fitness_vector> &, const std::vector<constraint_vector> &);
+void non_dominated_sort(std::vector<size_type> &, const std::vector<std::vector<size_type> > &, const std::vector<size_type> &);
+std::vector<std::vector<size_type> > pareto_fronts(const std::vector<size_type> &);
+void crowding_distance(std::vector<double> &, const fitness_matrix &, const std::vector<std::vector<size_type> > &);
+std::vector<size_type> spea2_truncation(const fitness_matrix &, size_type);
+
+}}}
+
+#endif
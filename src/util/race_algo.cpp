@@ -3,6 +3,10 @@
 #include "../problem/base_stochastic.h"
 
 #include <algorithm>
+#include <string>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 
 namespace pagmo { namespace util { namespace racing {
 
@@ -51,7 +55,7 @@ static problem::base::c_size_type get_max_ic_dimension(const std::vector<problem
 class standard : public problem::base_stochastic
 {
 	public:
-		standard(const std::vector<problem::base_ptr> &probs = std::vector<problem::base_ptr>(), const std::vector<algorithm::base_ptr> &algos = std::vector<algorithm::base_ptr>(), unsigned int seed = 0, unsigned int pop_size = 100);
+		standard(const std::vector<problem::base_ptr> &probs = std::vector<problem::base_ptr>(), const std::vector<algorithm::base_ptr> &algos = std::vector<algorithm::base_ptr>(), unsigned int seed = 0, unsigned int pop_size = 100, unsigned int n_threads = 1);
 
 	protected:
 		//copy constructor
@@ -59,6 +63,7 @@ class standard : public problem::base_stochastic
 		problem::base_ptr clone() const;
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 		void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
+		void objfun_batch_impl(std::vector<fitness_vector> &, const std::vector<decision_vector> &) const;
 	
 	private:
 
@@ -70,16 +75,23 @@ class standard : public problem::base_stochastic
 			ar & m_algos;
 			ar & m_probs;
 			ar & m_pop_size;
+			ar & m_n_threads;
 		}
 
 		void setup(const std::vector<problem::base_ptr> &probs, const std::vector<algorithm::base_ptr> &algos);
 		constraint_vector zero_pad_constraint(const constraint_vector&, problem::base::c_size_type) const;	
 		
 		void evaluate_algorithm(unsigned int) const;
+		void evaluate_algorithms(const std::vector<unsigned int> &) const;
+		unsigned int sample_problem() const;
+		void run_trial(unsigned int, unsigned int, fitness_vector &, constraint_vector &) const;
+
+		struct trial_queue;
 
 		std::vector<algorithm::base_ptr> m_algos;
 		std::vector<problem::base_ptr> m_probs;
 		unsigned int m_pop_size;
+		unsigned int m_n_threads;
 
 		// To avoid inefficiency resulted from the decoupled fitness and
 		// constraint computation
@@ -102,11 +114,12 @@ class standard : public problem::base_stochastic
  * @param[in] algos std::vector of pagmo::algorithm::base_ptr
  * @param[in] seed Seed to be used internally as a stochastic problem
  * @param[in] pop_size Size of the population to be evolved
+ * @param[in] n_threads Number of threads running the trials of a batch evaluation (0 means as many as the hardware supports)
  *
  * @throws value_error if there are incompatible algorithms or problems in the supplied sets (multi-objective algorithms not supported yet).
  *
  */
-standard::standard(const std::vector<problem::base_ptr> &probs, const std::vector<algorithm::base_ptr> &algos, unsigned int seed, unsigned int pop_size): base_stochastic(1, 1, probs.front()->get_f_dimension(), get_max_c_dimension(probs), get_max_ic_dimension(probs), 0, seed), m_pop_size(pop_size), m_is_first_evaluation(algos.size(), true), m_database_seed(algos.size()), m_database_f(algos.size()), m_database_c(algos.size())
+standard::standard(const std::vector<problem::base_ptr> &probs, const std::vector<algorithm::base_ptr> &algos, unsigned int seed, unsigned int pop_size, unsigned int n_threads): base_stochastic(1, 1, probs.front()->get_f_dimension(), get_max_c_dimension(probs), get_max_ic_dimension(probs), 0, seed), m_pop_size(pop_size), m_n_threads(n_threads), m_is_first_evaluation(algos.size(), true), m_database_seed(algos.size()), m_database_f(algos.size()), m_database_c(algos.size())
 {
 	setup(probs, algos);
 }
@@ -149,6 +162,7 @@ standard::standard(const standard &standard_copy):
 	m_algos(standard_copy.m_algos),
 	m_probs(standard_copy.m_probs),
 	m_pop_size(standard_copy.m_pop_size),
+	m_n_threads(standard_copy.m_n_threads),
 	m_is_first_evaluation(standard_copy.m_is_first_evaluation),
 	m_database_seed(standard_copy.m_database_seed),
 	m_database_f(standard_copy.m_database_f),
@@ -185,6 +199,26 @@ void standard::compute_constraints_impl(constraint_vector &c, const decision_vec
 	c = m_database_c[x[0]];
 }
 
+/// The performance of a set of algorithms
+/**
+ * All the algorithms requested are run under the current seed, each trial on
+ * its own copies of the algorithm and of the population. The trials are
+ * independent and are scheduled on the threads of the meta-problem, the
+ * results being the same as the ones obtained calling objfun_impl() on each
+ * algorithm.
+ */
+void standard::objfun_batch_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	std::vector<unsigned int> algo_idx(x.size());
+	for(std::vector<decision_vector>::size_type i = 0; i < x.size(); i++){
+		algo_idx[i] = x[i][0];
+	}
+	evaluate_algorithms(algo_idx);
+	for(std::vector<decision_vector>::size_type i = 0; i < x.size(); i++){
+		f[i] = m_database_f[algo_idx[i]];
+	}
+}
+
 /// Pad constraint vector with non-violating values (i.e. 0)
 /**
  * This is necessary when the underlying problems have different dimension. The
@@ -226,31 +260,124 @@ void standard::evaluate_algorithm(unsigned int algo_idx) const
 		return;
 	}
 
-	// Seeding control
-	for(unsigned int i = 0; i < m_algos.size(); i++){
-		m_algos[i]->reset_rngs(m_seed);
+	// Store the data, to be retrieved by objfun_impl() or compute_constraints_impl()
+	run_trial(algo_idx, sample_problem(), m_database_f[algo_idx], m_database_c[algo_idx]);
+	m_is_first_evaluation[algo_idx] = false;
+	m_database_seed[algo_idx] = m_seed;
+}
+
+// Trials of a batch, handed out one at a time to the worker threads.
+struct standard::trial_queue
+{
+	trial_queue(const standard &metrics, const std::vector<unsigned int> &algo_idx, unsigned int prob_idx):
+		m_metrics(metrics), m_algo_idx(algo_idx), m_prob_idx(prob_idx), m_next(0), m_f(algo_idx.size()), m_c(algo_idx.size()) {}
+	void operator()()
+	{
+		while(true){
+			std::vector<unsigned int>::size_type i;
+			{
+				boost::lock_guard<boost::mutex> lock(m_mutex);
+				if(m_next == m_algo_idx.size() || !m_error.empty()){
+					return;
+				}
+				i = m_next++;
+			}
+			try{
+				m_metrics.run_trial(m_algo_idx[i], m_prob_idx, m_f[i], m_c[i]);
+			}
+			catch(const std::exception &e){
+				boost::lock_guard<boost::mutex> lock(m_mutex);
+				m_error = e.what();
+				if(m_error.empty()){
+					m_error = "error while running a trial";
+				}
+			}
+		}
 	}
-	m_drng.seed(m_seed);
+	const standard &m_metrics;
+	const std::vector<unsigned int> &m_algo_idx;
+	const unsigned int m_prob_idx;
+	std::vector<unsigned int>::size_type m_next;
+	std::vector<fitness_vector> m_f;
+	std::vector<constraint_vector> m_c;
+	std::string m_error;
+	boost::mutex m_mutex;
+};
 
-	// Randomly sample a problem if required
-	unsigned int prob_idx;
-	if(m_probs.size() == 1){
-		prob_idx = 0;
+/// Evaluate a set of algorithms under the current seed
+/**
+ * Batch version of evaluate_algorithm(): the algorithms whose data is not
+ * ready are run on up to m_n_threads threads, each thread picking the next
+ * pending trial as soon as it is done with the previous one.
+ */
+void standard::evaluate_algorithms(const std::vector<unsigned int> &algo_idx) const
+{
+	std::vector<unsigned int> pending;
+	for(unsigned int i = 0; i < algo_idx.size(); i++){
+		if(algo_idx[i] >= m_algos.size()){
+			pagmo_throw(value_error, "Out of bound algorithm index");
+		}
+		if((m_is_first_evaluation[algo_idx[i]] || m_database_seed[algo_idx[i]] != m_seed) &&
+			std::find(pending.begin(), pending.end(), algo_idx[i]) == pending.end()){
+			pending.push_back(algo_idx[i]);
+		}
+	}
+	if(pending.empty()){
+		return;
+	}
+	unsigned int n_threads = m_n_threads;
+	if(n_threads == 0){
+		n_threads = std::max(boost::thread::hardware_concurrency(), 1u);
+	}
+	n_threads = std::min<unsigned int>(n_threads, pending.size());
+	trial_queue queue(*this, pending, sample_problem());
+	if(n_threads == 1){
+		queue();
 	}
 	else{
-		prob_idx = (unsigned int)(m_drng() * 100000) % m_probs.size();
+		boost::thread_group threads;
+		for(unsigned int t = 0; t < n_threads; t++){
+			threads.create_thread(boost::ref(queue));
+		}
+		threads.join_all();
 	}
+	if(!queue.m_error.empty()){
+		pagmo_throw(value_error, queue.m_error.c_str());
+	}
+	for(unsigned int i = 0; i < pending.size(); i++){
+		m_database_f[pending[i]] = queue.m_f[i];
+		m_database_c[pending[i]] = queue.m_c[i];
+		m_is_first_evaluation[pending[i]] = false;
+		m_database_seed[pending[i]] = m_seed;
+	}
+}
 
-	// Fitness defined as the quality of the champion in the evolved
-	// population, evolved by the selected algorithm
-	population pop(*m_probs[prob_idx], m_pop_size, m_seed);
-	m_algos[algo_idx]->evolve(pop);
+/// Randomly sample a problem (based on the current seed) if required
+unsigned int standard::sample_problem() const
+{
+	if(m_probs.size() == 1){
+		return 0;
+	}
+	m_drng.seed(m_seed);
+	return (unsigned int)(m_drng() * 100000) % m_probs.size();
+}
 
-	// Store the data, to be retrieved by objfun_impl() or compute_constraints_impl()
-	m_is_first_evaluation[algo_idx] = false;
-	m_database_seed[algo_idx] = m_seed;
-	m_database_f[algo_idx] = pop.champion().f;
-	m_database_c[algo_idx] = zero_pad_constraint(pop.champion().c, m_probs[prob_idx]->get_ic_dimension());
+/// Run a single trial
+/**
+ * Fitness is defined as the quality of the champion in the population
+ * evolved by the selected algorithm. The trial works on its own copy of the
+ * algorithm, and both the algorithm and the population are seeded with the
+ * current seed: the result depends only on the algorithm, the problem and
+ * the seed, so that trials can run concurrently.
+ */
+void standard::run_trial(unsigned int algo_idx, unsigned int prob_idx, fitness_vector &f, constraint_vector &c) const
+{
+	algorithm::base_ptr algo = m_algos[algo_idx]->clone();
+	algo->reset_rngs(m_seed);
+	population pop(*m_probs[prob_idx], m_pop_size, m_seed);
+	algo->evolve(pop);
+	f = pop.champion().f;
+	c = zero_pad_constraint(pop.champion().c, m_probs[prob_idx]->get_ic_dimension());
 }
 
 
@@ -265,8 +392,9 @@ void standard::evaluate_algorithm(unsigned int algo_idx) const
  * @param[in] prob The problem to be considered
  * @param[in] pop_size The size of the population that the algorithms will be evolving
  * @param[in] seed Seed to be used in racing mechanisms
+ * @param[in] n_threads Number of threads running the trials of each round (0 means as many as the hardware supports)
  */
-race_algo::race_algo(const std::vector<algorithm::base_ptr> &algos, const problem::base &prob, unsigned int pop_size, unsigned int seed): m_pop_size(pop_size), m_seed(seed)
+race_algo::race_algo(const std::vector<algorithm::base_ptr> &algos, const problem::base &prob, unsigned int pop_size, unsigned int seed, unsigned int n_threads): m_pop_size(pop_size), m_seed(seed), m_n_threads(n_threads)
 {
 	for(unsigned int i = 0; i < algos.size(); i++){
 		m_algos.push_back(algos[i]->clone());
@@ -282,8 +410,9 @@ race_algo::race_algo(const std::vector<algorithm::base_ptr> &algos, const proble
  * @param[in] probs The set of problems to be considered
  * @param[in] pop_size The size of the population that the algorithms will be evolving
  * @param[in] seed Seed to be used in racing mechanisms
+ * @param[in] n_threads Number of threads running the trials of each round (0 means as many as the hardware supports)
  */
-race_algo::race_algo(const std::vector<algorithm::base_ptr> &algos, const std::vector<problem::base_ptr> &probs, unsigned int pop_size, unsigned int seed): m_pop_size(pop_size), m_seed(seed)
+race_algo::race_algo(const std::vector<algorithm::base_ptr> &algos, const std::vector<problem::base_ptr> &probs, unsigned int pop_size, unsigned int seed, unsigned int n_threads): m_pop_size(pop_size), m_seed(seed), m_n_threads(n_threads)
 {
 	for(unsigned int i = 0; i < algos.size(); i++){
 		m_algos.push_back(algos[i]->clone());
@@ -330,8 +459,8 @@ std::pair<std::vector<unsigned int>, unsigned int> race_algo::run(
 
 	// Construct an internal population, such that the winners of the race in
 	// this population corresponds to the winning algorithm
-	metrics_algos::standard metrics(m_probs, m_algos, m_seed, m_pop_size);
-	population algos_pop(metrics);
+	metrics_algos::standard metrics(m_probs, m_algos, m_seed, m_pop_size, m_n_threads);
+	population algos_pop(metrics, 0, m_seed);
 	for(unsigned int i = 0; i < m_algos.size(); i++){
 		decision_vector algo_idx(1);
 		algo_idx[0] = i;
@@ -157,13 +157,15 @@ std::vector<population::size_type> race_pop::construct_output_list(
 // The resulting population is aligned with the racers, i.e. m_pop[0]
 // corresponds to racers[0], storing the newest fitness and constraint vector
 // evaluated under the new seed. Evaluation data can come from cache or fresh
-// computation.
+// computation. The individuals to be re-evaluated are evaluated as a block,
+// through the batch objective function of the problem (which, e.g., lets
+// race_algo run the trials of a round concurrently).
 // 
 // @return The number of objective function calls made
 unsigned int race_pop::prepare_population_friedman(const std::vector<population::size_type>& in_race, unsigned int count_iter)
 {
-	unsigned int count_nfes = 0;
-	// Perform re-evaluation on necessary individuals under current seed
+	std::vector<population::size_type> to_evaluate;
+	std::vector<decision_vector> x;
 	for(std::vector<population::size_type>::const_iterator it = in_race.begin(); it != in_race.end(); ++it) {
 		// Case 1: Current racer has previous data that can be reused, no
 		// need to be evaluated with this seed
@@ -174,16 +176,20 @@ unsigned int race_pop::prepare_population_friedman(const std::vector<population:
 		// Case 2: No previous data can be reused, perform actual
 		// re-evaluation and update the cache
 		else{
-			count_nfes++;
-			const population::individual_type &ind = m_pop.get_individual(*it);
-			fitness_vector f_vec = m_pop.problem().objfun(ind.cur_x);
-			constraint_vector c_vec = m_pop.problem().compute_constraints(ind.cur_x);
-			m_pop.set_fc(*it, f_vec, c_vec);
-			if(m_use_caching)
-				cache_insert_data(*it, f_vec, c_vec);
+			to_evaluate.push_back(*it);
+			x.push_back(m_pop.get_individual(*it).cur_x);
 		}
 	}
-	return count_nfes;
+	// Perform re-evaluation on necessary individuals under current seed
+	std::vector<fitness_vector> f;
+	m_pop.problem().objfun_batch(f, x);
+	for(std::vector<population::size_type>::size_type i = 0; i < to_evaluate.size(); i++){
+		constraint_vector c_vec = m_pop.problem().compute_constraints(x[i]);
+		m_pop.set_fc(to_evaluate[i], f[i], c_vec);
+		if(m_use_caching)
+			cache_insert_data(to_evaluate[i], f[i], c_vec);
+	}
+	return to_evaluate.size();
 }
 
 /// Update m_pop_wilcoxon to contain evaluation data required for Wilcoxon test
@@ -97,10 +97,18 @@ int main()
 	algos_new.push_back(algorithm::bee_colony().clone());
 	algos.push_back(algorithm::cmaes(gen,0.5, 0.5, 0.5, 0.5, 0.7, 1e-5, 1e-5, false).clone());
 	algos_new.push_back(algorithm::cmaes().clone());
+	algos.push_back(algorithm::cmaes(gen,-1, -1, -1, -1, 0.7, 1e-5, 1e-5, true, algorithm::cmaes::variant::SEPARABLE).clone());
+	algos_new.push_back(algorithm::cmaes().clone());
+	algos.push_back(algorithm::cmaes(gen,-1, -1, -1, -1, 0.7, 1e-5, 1e-5, true, algorithm::cmaes::variant::LIMITED_MEMORY, 6).clone());
+	algos_new.push_back(algorithm::cmaes().clone());
+	algos.push_back(algorithm::cmaes(gen,-1, -1, -1, -1, 0.7, 1e-5, 1e-5, true, algorithm::cmaes::variant::FULL, -1, algorithm::cmaes::restart::BIPOP, 2).clone());
+	algos_new.push_back(algorithm::cmaes().clone());
 	algos.push_back(algorithm::cs(gen*10,0.02,0.3,0.3).clone());
 	algos_new.push_back(algorithm::cs().clone());
 	algos.push_back(algorithm::de(gen,0.9,0.9,3).clone());
 	algos_new.push_back(algorithm::de().clone());
+	algos.push_back(algorithm::de_async(gen,0.9,0.9,3,1e-6,1e-6,1).clone());
+	algos_new.push_back(algorithm::de_async().clone());
 	algos.push_back(algorithm::de_1220(1,2,std::vector<int>(1,9),false,1e-5,1e-5).clone());
 	algos_new.push_back(algorithm::de_1220().clone());
 	algos.push_back(algorithm::ihs(gen,0.2,0.2,0.2,0.2,0.2).clone());
@@ -109,22 +117,30 @@ int main()
 	algos_new.push_back(algorithm::jde().clone());
 	algos.push_back(algorithm::mbh(algorithm::de(gen),2,0.03).clone());
 	algos_new.push_back(algorithm::mbh().clone());
+	algos.push_back(algorithm::mbh(algorithm::cs(),3,0.1,4,2).clone());
+	algos_new.push_back(algorithm::mbh().clone());
 	algos.push_back(algorithm::mde_pbx(gen,0.5,0.5,1e-10,1e-10).clone());
 	algos_new.push_back(algorithm::mde_pbx().clone());
 	algos.push_back(algorithm::monte_carlo(gen).clone());
 	algos_new.push_back(algorithm::monte_carlo().clone());
 	algos.push_back(algorithm::ms(algorithm::monte_carlo(gen),5).clone());
 	algos_new.push_back(algorithm::ms().clone());
+	algos.push_back(algorithm::ms(algorithm::monte_carlo(gen),5,3).clone());
+	algos_new.push_back(algorithm::ms().clone());
 	algos.push_back(algorithm::null().clone());
 	algos_new.push_back(algorithm::null().clone());
-	algos.push_back(algorithm::pso(gen,0.5,0.5,0.5,0.5,3,3,3).clone());
+	algos.push_back(algorithm::pso(gen,0.5,0.5,0.5,0.5,3,3,3,true,4).clone());
 	algos_new.push_back(algorithm::pso().clone());
-	algos.push_back(algorithm::pso_generational(gen,0.5,0.5,0.5,0.5,3,3,3).clone());
+	algos.push_back(algorithm::pso_async(gen,0.5,0.5,0.5,0.5,3,3,3,1).clone());
+	algos_new.push_back(algorithm::pso_async().clone());
+	algos.push_back(algorithm::pso_generational(gen,0.5,0.5,0.5,0.5,3,3,3,2).clone());
 	algos_new.push_back(algorithm::pso_generational().clone());
 	//algos.push_back(algorithm::pso_generational_racing(gen,0.5,0.5,0.5,0.5,3,3,3).clone());
 	//algos_new.push_back(algorithm::pso_generational_racing().clone());
 	algos.push_back(algorithm::sa_corana(gen*1000,5.0,1e-5,25,10,0.5).clone());
 	algos_new.push_back(algorithm::sa_corana().clone());
+	algos.push_back(algorithm::sa_corana(gen*1000,5.0,1e-5,25,10,0.5,4,2).clone());
+	algos_new.push_back(algorithm::sa_corana().clone());
 	algos.push_back(algorithm::sga(gen,.9, .021, 5, algorithm::sga::mutation::RANDOM, 0.3, algorithm::sga::selection::BEST20, algorithm::sga::crossover::BINOMIAL).clone());
 	algos_new.push_back(algorithm::sga().clone());
 	algos.push_back(algorithm::sga_gray(gen,.9, .021, 5, algorithm::sga_gray::mutation::UNIFORM, algorithm::sga_gray::selection::BEST20, algorithm::sga_gray::crossover::SINGLE_POINT).clone());
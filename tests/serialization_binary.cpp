@@ -0,0 +1,207 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the binary archives: vectors of doubles (including inf and NaN), populations and
+// archipelagos must survive a round-trip through a binary archive exactly, and their binary archive
+// must be more compact than the text one.
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Bitwise comparison, so that NaNs compare equal to themselves.
+static bool same_vector(const std::vector<double> &a, const std::vector<double> &b)
+{
+	return a.size() == b.size() && (a.empty() || std::memcmp(&a[0],&b[0],a.size() * sizeof(double)) == 0);
+}
+
+static bool same_population(const population &a, const population &b)
+{
+	if (a.size() != b.size() || a.problem() != b.problem()) {
+		return false;
+	}
+	for (population::size_type i = 0; i < a.size(); ++i) {
+		const population::individual_type &ia = a.get_individual(i), &ib = b.get_individual(i);
+		if (!same_vector(ia.cur_x,ib.cur_x) || !same_vector(ia.cur_v,ib.cur_v) || !same_vector(ia.cur_f,ib.cur_f) ||
+			!same_vector(ia.cur_c,ib.cur_c) || !same_vector(ia.best_x,ib.best_x) || !same_vector(ia.best_f,ib.best_f) ||
+			!same_vector(ia.best_c,ib.best_c))
+		{
+			return false;
+		}
+	}
+	return same_vector(a.champion().x,b.champion().x) && same_vector(a.champion().f,b.champion().f) &&
+		same_vector(a.champion().c,b.champion().c);
+}
+
+template <class T>
+static std::string text_dump(const T &x)
+{
+	std::ostringstream ss;
+	{
+		boost::archive::text_oarchive oa(ss);
+		oa << x;
+	}
+	return ss.str();
+}
+
+template <class T>
+static std::string binary_dump(const T &x)
+{
+	std::ostringstream ss;
+	{
+		boost::archive::binary_oarchive oa(ss);
+		oa << x;
+	}
+	return ss.str();
+}
+
+template <class T>
+static void binary_load(T &x, const std::string &str)
+{
+	std::istringstream ss(str);
+	boost::archive::binary_iarchive ia(ss);
+	ia >> x;
+}
+
+template <class T>
+static void text_load(T &x, const std::string &str)
+{
+	std::istringstream ss(str);
+	boost::archive::text_iarchive ia(ss);
+	ia >> x;
+}
+
+int test_special_values()
+{
+	std::cout << std::setw(40) << "inf and nan";
+	std::vector<double> v;
+	v.push_back(1. / 3.);
+	v.push_back(std::numeric_limits<double>::infinity());
+	v.push_back(-std::numeric_limits<double>::infinity());
+	v.push_back(std::numeric_limits<double>::quiet_NaN());
+	v.push_back(-0.);
+	v.push_back(std::numeric_limits<double>::denorm_min());
+	boost::circular_buffer<std::vector<double> > cb(3), cb_new;
+	cb.push_back(v);
+	cb.push_back(std::vector<double>());
+	cb.push_back(v);
+	binary_load(cb_new,binary_dump(cb));
+	if (cb_new.capacity() != cb.capacity() || cb_new.size() != cb.size()) {
+		std::cout << " capacity or size FAILED" << std::endl;
+		return 1;
+	}
+	for (unsigned int i = 0; i < cb.size(); ++i) {
+		if (!same_vector(cb[i],cb_new[i])) {
+			std::cout << " content FAILED" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << " pass" << std::endl;
+	return 0;
+}
+
+int test_population(const problem::base &prob)
+{
+	std::cout << std::setw(40) << prob.get_name();
+	population pop(prob,32,123);
+	// Evolve a bit, so that current and best individuals differ.
+	algorithm::monte_carlo algo(50);
+	algo.evolve(pop);
+	const std::string bin = binary_dump(pop), txt = text_dump(pop);
+	population pop_bin(prob,0), pop_txt(prob,0);
+	binary_load(pop_bin,bin);
+	text_load(pop_txt,txt);
+	if (!same_population(pop,pop_bin)) {
+		std::cout << " binary round-trip FAILED" << std::endl;
+		return 1;
+	}
+	if (!same_population(pop,pop_txt)) {
+		std::cout << " text round-trip FAILED" << std::endl;
+		return 1;
+	}
+	if (bin.size() >= txt.size()) {
+		std::cout << " binary archive is not smaller than text archive (" << bin.size() << " vs " << txt.size() << ") FAILED" << std::endl;
+		return 1;
+	}
+	// The random number generators must be restored as well.
+	population pop_next(pop), pop_bin_next(pop_bin);
+	algo.reset_rngs(42);
+	algo.evolve(pop_next);
+	algo.reset_rngs(42);
+	algo.evolve(pop_bin_next);
+	if (!same_population(pop_next,pop_bin_next)) {
+		std::cout << " evolution after round-trip FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << " pass (" << bin.size() << " vs " << txt.size() << " bytes)" << std::endl;
+	return 0;
+}
+
+int test_archipelago()
+{
+	std::cout << std::setw(40) << "archipelago";
+	archipelago archi(algorithm::de(10),problem::ackley(10),4,20,topology::ring());
+	archi.evolve(1);
+	archi.join();
+	archipelago archi_new;
+	binary_load(archi_new,binary_dump(archi));
+	if (archi_new.get_size() != archi.get_size() || archi_new.get_topology()->get_number_of_edges() != archi.get_topology()->get_number_of_edges()) {
+		std::cout << " size or topology FAILED" << std::endl;
+		return 1;
+	}
+	for (archipelago::size_type i = 0; i < archi.get_size(); ++i) {
+		if (!same_population(archi.get_island(i)->get_population(),archi_new.get_island(i)->get_population()) ||
+			archi.get_island(i)->get_algorithm()->human_readable() != archi_new.get_island(i)->get_algorithm()->human_readable())
+		{
+			std::cout << " island " << i << " FAILED" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << " pass" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_special_values() ||
+		test_population(problem::ackley(10)) ||
+		test_population(problem::zdt(1,10)) ||
+		test_population(problem::cec2006(7)) ||
+		test_population(problem::robust(problem::ackley(5),10,0.1,123)) ||
+		test_population(problem::shifted(problem::rosenbrock(8))) ||
+		test_archipelago();
+}
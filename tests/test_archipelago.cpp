@@ -29,10 +29,34 @@
 #include <cmath>
 #include <vector>
 #include <cassert>
+#include <atomic>
+#include <numeric>
 #include "../src/pagmo.h"
 
 using namespace pagmo;
 
+// Number of evaluations of interrupting_problem.
+std::atomic<unsigned int> n_fevals(0);
+
+// Sphere problem interrupting the archipelago once n_fevals reaches a threshold.
+class interrupting_problem: public problem::base {
+	public:
+		interrupting_problem(archipelago *a, unsigned int threshold):problem::base(10),m_arch(a),m_threshold(threshold) {}
+		problem::base_ptr clone() const {
+			return problem::base_ptr(new interrupting_problem(*this));
+		}
+	protected:
+		void objfun_impl(fitness_vector &f, const decision_vector &x) const {
+			f[0] = std::inner_product(x.begin(), x.end(), x.begin(), 0.);
+			if(++n_fevals == m_threshold) {
+				m_arch->interrupt();
+			}
+		}
+	private:
+		archipelago *m_arch;
+		unsigned int m_threshold;
+};
+
 int test_distribution_type() {
 	std::vector<archipelago::distribution_type> types = {
 		archipelago::distribution_type::point_to_point,
@@ -50,6 +74,114 @@ int test_distribution_type() {
 	return 0;
 }
 
+int test_evolve_pool() {
+	archipelago a(algorithm::de(10), problem::ackley(10), 7, 20, topology::ring());
+	std::vector<double> before;
+	for(archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		before.push_back(a.get_island(i)->get_population().champion().f[0]);
+	}
+	a.evolve_pool(3, 3);
+	if(a.busy() || a.dump_migr_history().empty()) {
+		return 1;
+	}
+	for(archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		if(a.get_island(i)->get_population().champion().f[0] > before[i]) {
+			return 1;
+		}
+	}
+	try {
+		a.evolve_pool(1, 0);
+		return 1;
+	} catch (const value_error &) {}
+	// An interruption from another thread stops the pool after the evolutions being performed. Each evolution
+	// of de(1) evaluates the 20 trial vectors of an island, so at most 30 evolutions are over when the interruption
+	// arrives, and at most one more per thread is performed afterwards.
+	const topology::ring ring;
+	archipelago b(ring);
+	for(int i = 0; i < 7; ++i) {
+		b.push_back(island(algorithm::de(1), interrupting_problem(&b, 30 * 20), 20));
+	}
+	n_fevals = 0;
+	b.evolve_pool(1000000, 3);
+	const archipelago::telemetry t = b.get_telemetry();
+	std::size_t n_evolutions = 0;
+	for(std::size_t i = 0; i < t.islands.size(); ++i) {
+		n_evolutions += t.islands[i].n_evolutions;
+	}
+	if(n_evolutions > 30 + 3) {
+		std::cout << "evolve_pool performed " << n_evolutions << " evolutions after being interrupted" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Migration must happen along the edges of the topology according to their weights (migration probabilities),
+// for all the distribution types and migration directions.
+int test_migration_weights() {
+	const archipelago::distribution_type types[] = {archipelago::point_to_point, archipelago::broadcast};
+	const archipelago::migration_direction dirs[] = {archipelago::source, archipelago::destination};
+	for(int t = 0; t < 2; ++t) {
+		for(int d = 0; d < 2; ++d) {
+			for(int w = 0; w < 2; ++w) {
+				topology::ring topo;
+				archipelago a(algorithm::de(5), problem::ackley(10), 6, 20, topo, types[t], dirs[d]);
+				topology::base_ptr weighted = a.get_topology();
+				weighted->set_weight(static_cast<double>(w));
+				a.set_topology(*weighted);
+				a.evolve(5);
+				a.join();
+				if(a.dump_migr_history().empty() == static_cast<bool>(w)) {
+					return 1;
+				}
+			}
+		}
+	}
+	return 0;
+}
+
+// The telemetry must account for all the evolutions and migrations, and the migration history must not
+// exceed its capacity.
+int test_telemetry() {
+	archipelago a(algorithm::de(5), problem::ackley(10), 4, 20, topology::ring());
+	a.set_migr_history_capacity(3);
+	a.evolve(10);
+	// Polling while evolving must not block.
+	a.get_telemetry();
+	a.join();
+	const archipelago::telemetry t = a.get_telemetry();
+	if(t.islands.size() != 4 || t.migr_history_size > 3 || t.migr_history_total < t.migr_history_size) {
+		return 1;
+	}
+	std::size_t n_accepted = 0, n_edge_individuals = 0, n_edge_migrations = 0;
+	for(std::size_t i = 0; i < t.islands.size(); ++i) {
+		if(t.islands[i].n_evolutions != 10 || !t.islands[i].fevals || t.islands[i].evolution_time < 0 ||
+			t.islands[i].last_evolution_time > t.islands[i].evolution_time)
+		{
+			return 1;
+		}
+		n_accepted += t.islands[i].migr_accepted;
+	}
+	for(std::size_t i = 0; i < t.edges.size(); ++i) {
+		// Migration takes place only along the ring.
+		if((t.edges[i].src + 1) % 4 != t.edges[i].dest && (t.edges[i].dest + 1) % 4 != t.edges[i].src) {
+			return 1;
+		}
+		n_edge_individuals += t.edges[i].n_individuals;
+		n_edge_migrations += t.edges[i].n_migrations;
+	}
+	if(n_accepted != n_edge_individuals || n_edge_migrations != t.migr_history_total) {
+		return 1;
+	}
+	a.clear_migr_history();
+	if(!a.dump_migr_history().empty() || a.get_telemetry().edges.size() || a.get_telemetry().islands[0].n_evolutions != 10) {
+		return 1;
+	}
+	return 0;
+}
+
 int main() {
-	return test_distribution_type();
+	return test_distribution_type() ||
+		test_evolve_pool() ||
+		test_migration_weights() ||
+		test_telemetry();
 }
@@ -0,0 +1,190 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the asynchronous evaluator and the asynchronous steady-state algorithms
+
+#include <iostream>
+#include <cmath>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/async_evaluator.h"
+#include "test.h"
+
+using namespace pagmo;
+
+const double EPS = 1E-9;
+
+// Box-constrained problem whose objective function throws in the upper half of the first variable.
+class throwing_problem: public problem::base
+{
+	public:
+		throwing_problem():problem::base(2) {}
+		problem::base_ptr clone() const
+		{
+			return problem::base_ptr(new throwing_problem(*this));
+		}
+	protected:
+		void objfun_impl(fitness_vector &f, const decision_vector &x) const
+		{
+			if (x[0] > 0.5) {
+				throw std::invalid_argument("out of domain");
+			}
+			f[0] = x[0] + x[1];
+		}
+};
+
+// Results must match the objective function, be tagged correctly, and be counted in the problem's fevals.
+int test_results()
+{
+	problem::ackley prob(5);
+	const unsigned int n = 50;
+	std::vector<decision_vector> xs;
+	population pop(prob,n);
+	for (unsigned int i = 0; i < n; ++i) {
+		xs.push_back(pop.get_individual(i).cur_x);
+	}
+	const unsigned int fevals = prob.get_fevals();
+	std::set<std::size_t> tags;
+	{
+		util::async_evaluator ev(prob,4,2);
+		if (ev.get_n_threads() != 4) {
+			std::cout << "wrong number of threads: " << ev.get_n_threads() << std::endl;
+			return 1;
+		}
+		util::async_evaluator::result r;
+		for (unsigned int i = 0; i < n; ++i) {
+			ev.submit(xs[i],i);
+			// Interleave retrievals with submissions.
+			if (i % 3 == 0) {
+				ev.get(r);
+				if (r.x != xs[r.tag] || std::fabs(r.f[0] - prob.objfun(xs[r.tag])[0]) > EPS) {
+					std::cout << "wrong result for tag " << r.tag << std::endl;
+					return 1;
+				}
+				tags.insert(r.tag);
+			}
+		}
+		while (ev.get_n_pending()) {
+			ev.get(r);
+			if (r.x != xs[r.tag] || std::fabs(r.f[0] - prob.objfun(xs[r.tag])[0]) > EPS) {
+				std::cout << "wrong result for tag " << r.tag << std::endl;
+				return 1;
+			}
+			tags.insert(r.tag);
+		}
+		if (ev.try_get(r)) {
+			std::cout << "unexpected result" << std::endl;
+			return 1;
+		}
+		try {
+			ev.get(r);
+			std::cout << "get() with no pending evaluations did not throw" << std::endl;
+			return 1;
+		} catch (const value_error &) {}
+		try {
+			ev.submit(decision_vector(3));
+			std::cout << "submit() with a wrong dimension did not throw" << std::endl;
+			return 1;
+		} catch (const value_error &) {}
+	}
+	if (tags.size() != n) {
+		std::cout << "missing results: " << tags.size() << std::endl;
+		return 1;
+	}
+	// n evaluations by the workers, n by the checks above.
+	if (prob.get_fevals() != fevals + 2 * n) {
+		std::cout << "wrong number of fevals: " << prob.get_fevals() - fevals << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Exceptions thrown by the objective function are reported upon retrieval, and the evaluator stays usable.
+int test_errors()
+{
+	throwing_problem prob;
+	util::async_evaluator ev(prob,2);
+	util::async_evaluator::result r;
+	decision_vector x(2,0.1);
+	ev.submit(x,0);
+	x[0] = 0.9;
+	ev.submit(x,1);
+	unsigned int n_errors = 0;
+	for (int i = 0; i < 2; ++i) {
+		try {
+			ev.get(r);
+			if (r.tag != 0 || std::fabs(r.f[0] - 0.2) > EPS) {
+				std::cout << "wrong result" << std::endl;
+				return 1;
+			}
+		} catch (const std::runtime_error &) {
+			++n_errors;
+		}
+	}
+	if (n_errors != 1 || ev.get_n_pending()) {
+		std::cout << "exception not propagated" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// The asynchronous algorithms must perform the expected number of evaluations and improve the population.
+int test_algorithm(const algorithm::base &algo, unsigned int expected_fevals)
+{
+	problem::ackley prob(10);
+	population pop(prob,20);
+	const double before = pop.champion().f[0];
+	const unsigned int fevals = pop.problem().get_fevals();
+	algo.evolve(pop);
+	if (pop.problem().get_fevals() - fevals != expected_fevals) {
+		std::cout << algo.get_name() << ": wrong number of fevals " << pop.problem().get_fevals() - fevals << std::endl;
+		return 1;
+	}
+	if (!(pop.champion().f[0] < before) || pop.champion().f[0] > 1) {
+		std::cout << algo.get_name() << ": no improvement " << before << " -> " << pop.champion().f[0] << std::endl;
+		return 1;
+	}
+	// The stored fitness must be the one of the stored decision vector.
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		if (std::fabs(prob.objfun(pop.get_individual(i).cur_x)[0] - pop.get_individual(i).cur_f[0]) > EPS ||
+			std::fabs(prob.objfun(pop.get_individual(i).best_x)[0] - pop.get_individual(i).best_f[0]) > EPS)
+		{
+			std::cout << algo.get_name() << ": inconsistent individual " << i << std::endl;
+			return 1;
+		}
+	}
+	std::cout << algo.get_name() << ": " << before << " -> " << pop.champion().f[0] << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_results() || test_errors() ||
+		test_algorithm(algorithm::de_async(500,0.8,0.9,2,0,0,4),500 * 20) ||
+		test_algorithm(algorithm::pso_async(500,0.7298,2.05,2.05,0.5,5,2,4,4),500 * 20) ||
+		test_algorithm(algorithm::pso_async(500,0.7298,2.05,2.05,0.5,5,4,4,3),500 * 20);
+}
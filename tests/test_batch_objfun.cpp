@@ -0,0 +1,169 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test code for the batch objective function
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include "../src/pagmo.h"
+#include "../src/Eigen/Dense"
+#include "test.h"
+
+using namespace pagmo;
+
+const double EPS = 10e-9;
+
+// Writes synthetic (random but well-formed) CEC2013 input files for dimension dim in the directory dir.
+void write_cec2013_data(const std::string &dir, int dim, rng_double &drng)
+{
+	std::ofstream m_file((dir + "M_D" + boost::lexical_cast<std::string>(dim) + ".txt").c_str());
+	m_file << std::setprecision(17);
+	for (int k = 0; k < 10; ++k) {
+		Eigen::MatrixXd m = Eigen::MatrixXd::Random(dim,dim).householderQr().householderQ();
+		for (int i = 0; i < dim; ++i) {
+			for (int j = 0; j < dim; ++j) {
+				m_file << m(i,j) << " ";
+			}
+			m_file << "\n";
+		}
+	}
+	std::ofstream s_file((dir + "shift_data.txt").c_str());
+	s_file << std::setprecision(17);
+	for (int i = 0; i < 10 * 100; ++i) {
+		s_file << (drng() * 160. - 80.) << " ";
+	}
+}
+
+// Checks that objfun_batch() returns the same fitnesses as objfun() called on each decision vector,
+// and that it counts the function evaluations. Points are sampled in [lb,ub].
+int test_batch(const problem::base &prob, const decision_vector &lb, const decision_vector &ub, unsigned int n_points, rng_double &drng)
+{
+	std::cout << std::setw(40) << prob.get_name();
+	std::vector<decision_vector> xs(n_points, decision_vector(prob.get_dimension()));
+	for (unsigned int i = 0; i < n_points; ++i) {
+		for (unsigned int j = 0; j < prob.get_dimension(); ++j) {
+			xs[i][j] = lb[j] + drng() * (ub[j] - lb[j]);
+		}
+	}
+	problem::base_ptr batch_prob = prob.clone();
+	std::vector<fitness_vector> fs;
+	batch_prob->objfun_batch(fs, xs);
+	if (fs.size() != n_points || batch_prob->get_fevals() != prob.get_fevals() + n_points) {
+		std::cout << " batch size or fevals failed!" << std::endl;
+		return 1;
+	}
+	for (unsigned int i = 0; i < n_points; ++i) {
+		fitness_vector f = prob.objfun(xs[i]);
+		for (fitness_vector::size_type k = 0; k < f.size(); ++k) {
+			if (!is_eq(f[k], fs[i][k], EPS * std::max(1., std::fabs(f[k])))) {
+				std::cout << " fitness failed!" << std::endl;
+				PRINT_VEC(f);
+				PRINT_VEC(fs[i]);
+				return 1;
+			}
+		}
+	}
+	std::cout << " passed." << std::endl;
+	return 0;
+}
+
+// Checks that population::set_xs() leaves the population in the same state as set_x() called on each individual.
+int test_set_xs(const problem::base &prob, rng_double &drng)
+{
+	std::cout << std::setw(40) << prob.get_name() << " (set_xs)";
+	population pop(prob, 20, 42), pop_ref(pop);
+	std::vector<decision_vector> xs(pop.size(), decision_vector(prob.get_dimension()));
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		for (unsigned int j = 0; j < prob.get_dimension(); ++j) {
+			xs[i][j] = prob.get_lb()[j] + drng() * (prob.get_ub()[j] - prob.get_lb()[j]);
+		}
+		pop_ref.set_x(i, xs[i]);
+	}
+	pop.set_xs(xs);
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		const population::individual_type &ind = pop.get_individual(i), &ind_ref = pop_ref.get_individual(i);
+		if (ind.cur_x != ind_ref.cur_x || ind.cur_f != ind_ref.cur_f || ind.cur_c != ind_ref.cur_c || ind.best_x != ind_ref.best_x ||
+			pop.get_domination_count(i) != pop_ref.get_domination_count(i)) {
+			std::cout << " individual " << i << " failed!" << std::endl;
+			return 1;
+		}
+	}
+	if (pop.champion().x != pop_ref.champion().x || pop.problem().get_fevals() != pop_ref.problem().get_fevals()) {
+		std::cout << " champion or fevals failed!" << std::endl;
+		return 1;
+	}
+	std::cout << " passed." << std::endl;
+	return 0;
+}
+
+// The CEC2013 input files are written in the scratch directory passed as first argument (see CMakeLists.txt),
+// so that they do not clash with the files of other tests.
+int main(int argc, char **argv)
+{
+	const std::string dir = (argc > 1) ? std::string(argv[1]) + "/" : std::string("./");
+	rng_double drng(rng_generator::get<rng_double>());
+	const int dimension = 10;
+	std::vector<problem::base_ptr> probs;
+	probs.push_back(problem::ackley(dimension).clone());
+	probs.push_back(problem::rastrigin(dimension).clone());
+	probs.push_back(problem::griewank(dimension).clone());
+	probs.push_back(problem::schwefel(dimension).clone());
+	probs.push_back(problem::rosenbrock(dimension).clone());
+	probs.push_back(problem::zdt(1,dimension).clone());
+	for (unsigned int i = 0; i < probs.size(); ++i) {
+		if (test_batch(*probs[i], probs[i]->get_lb(), probs[i]->get_ub(), 25, drng)) {
+			return 1;
+		}
+	}
+	probs.push_back(problem::cec2006(5).clone());
+	for (unsigned int i = 0; i < probs.size(); ++i) {
+		if (test_set_xs(*probs[i], drng)) {
+			return 1;
+		}
+	}
+	// The CEC2013 functions are sampled close to their optimum: far from it some of them (e.g., f8) are so
+	// ill-conditioned that a different summation order in the rotations changes the result.
+	write_cec2013_data(dir, dimension, drng);
+	int retval = 0;
+	for (unsigned int i = 1; i <= 28 && !retval; ++i) {
+		problem::cec2013 prob(i, dimension, dir);
+		const std::vector<double> shift = prob.origin_shift();
+		decision_vector lb(shift.begin(), shift.begin() + dimension), ub(lb);
+		for (int j = 0; j < dimension; ++j) {
+			lb[j] -= 1;
+			ub[j] += 1;
+		}
+		retval = test_batch(prob, lb, ub, 25, drng);
+	}
+	std::remove((dir + "M_D" + boost::lexical_cast<std::string>(dimension) + ".txt").c_str());
+	std::remove((dir + "shift_data.txt").c_str());
+	return retval;
+}
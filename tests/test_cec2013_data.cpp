@@ -0,0 +1,176 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test code for the shared CEC2013 input data
+
+#include <cstdio>
+#include <iostream>
+#include <iomanip>
+#include <iterator>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/lexical_cast.hpp>
+#include "../src/pagmo.h"
+#include "../src/Eigen/Dense"
+#include "test.h"
+
+using namespace pagmo;
+
+const int dimension = 10;
+const unsigned int n_points = 10;
+
+// Writes synthetic (random but well-formed) CEC2013 input files for dimension dim in the current directory.
+void write_cec2013_data(int dim, rng_double &drng)
+{
+	std::ofstream m_file(("M_D" + boost::lexical_cast<std::string>(dim) + ".txt").c_str());
+	m_file << std::setprecision(17);
+	for (int k = 0; k < 10; ++k) {
+		Eigen::MatrixXd m = Eigen::MatrixXd::Random(dim,dim).householderQr().householderQ();
+		for (int i = 0; i < dim; ++i) {
+			for (int j = 0; j < dim; ++j) {
+				m_file << m(i,j) << " ";
+			}
+			m_file << "\n";
+		}
+	}
+	std::ofstream s_file("shift_data.txt");
+	s_file << std::setprecision(17);
+	for (int i = 0; i < 10 * 100; ++i) {
+		s_file << (drng() * 160. - 80.) << " ";
+	}
+}
+
+// Stand-in writing the archive layout of cec2013 before the input data was shared (class version 0), which stored
+// the rotation matrices and origin shifts in place of the folder.
+struct cec2013_v0: problem::cec2013
+{
+	cec2013_v0(unsigned int id):problem::cec2013(id, dimension, "./"),m_id(id)
+	{
+		std::ifstream m_file(("M_D" + boost::lexical_cast<std::string>(dimension) + ".txt").c_str());
+		std::ifstream s_file("shift_data.txt");
+		m_rotation_matrix.assign(std::istream_iterator<double>(m_file),std::istream_iterator<double>());
+		m_origin_shift.assign(std::istream_iterator<double>(s_file),std::istream_iterator<double>());
+	}
+	template <class Archive>
+	void serialize(Archive &ar, const unsigned int)
+	{
+		ar & boost::serialization::base_object<problem::base>(*this);
+		ar & m_id;
+		ar & m_rotation_matrix;
+		ar & m_origin_shift;
+	}
+	unsigned int m_id;
+	std::vector<double> m_rotation_matrix;
+	std::vector<double> m_origin_shift;
+};
+
+int main()
+{
+	rng_double drng(rng_generator::get<rng_double>());
+	// Remove the binary file left by a previous run, it would take precedence over the text files.
+	std::remove(("cec2013_D" + boost::lexical_cast<std::string>(dimension) + ".bin").c_str());
+	write_cec2013_data(dimension, drng);
+	std::vector<decision_vector> xs(n_points, decision_vector(dimension));
+	for (unsigned int i = 0; i < n_points; ++i) {
+		for (int j = 0; j < dimension; ++j) {
+			xs[i][j] = drng() * 200. - 100.;
+		}
+	}
+	std::vector<std::vector<fitness_vector> > fs(28);
+	// Text data: clones and deserialized instances must share it and evaluate identically.
+	for (unsigned int id = 1; id <= 28; ++id) {
+		problem::cec2013 prob(id, dimension, "./");
+		problem::base_ptr prob_clone = prob.clone();
+		std::stringstream ss;
+		{
+			boost::archive::text_oarchive oa(ss);
+			oa << prob;
+		}
+		// Only the folder is serialized, not the rotation matrices.
+		if (ss.str().size() >= 10 * dimension * dimension * sizeof(double)) {
+			std::cout << prob.get_name() << " serialization too large: " << ss.str().size() << " bytes." << std::endl;
+			return 1;
+		}
+		problem::cec2013 prob_loaded(id % 28 + 1, dimension, "./");
+		{
+			boost::archive::text_iarchive ia(ss);
+			ia >> prob_loaded;
+		}
+		for (unsigned int i = 0; i < n_points; ++i) {
+			fs[id - 1].push_back(prob.objfun(xs[i]));
+			if (fs[id - 1].back() != prob_clone->objfun(xs[i]) || fs[id - 1].back() != prob_loaded.objfun(xs[i])) {
+				std::cout << prob.get_name() << " clone or deserialized fitness failed!" << std::endl;
+				return 1;
+			}
+		}
+		std::cout << std::setw(40) << prob.get_name() << " text data passed." << std::endl;
+	}
+	// Archives of version 0: the data stored in the archive is used, and saved again along with the problem.
+	for (unsigned int id = 1; id <= 28; ++id) {
+		std::stringstream ss_old, ss_new;
+		{
+			const cec2013_v0 prob_old(id);
+			boost::archive::text_oarchive oa(ss_old);
+			oa << prob_old;
+		}
+		problem::cec2013 prob_loaded(id % 28 + 1, dimension, "./"), prob_reloaded(id % 28 + 1, dimension, "./");
+		{
+			boost::archive::text_iarchive ia(ss_old);
+			ia >> prob_loaded;
+			boost::archive::text_oarchive oa(ss_new);
+			oa << prob_loaded;
+		}
+		{
+			boost::archive::text_iarchive ia(ss_new);
+			ia >> prob_reloaded;
+		}
+		for (unsigned int i = 0; i < n_points; ++i) {
+			if (fs[id - 1][i] != prob_loaded.objfun(xs[i]) || fs[id - 1][i] != prob_reloaded.objfun(xs[i])) {
+				std::cout << prob_loaded.get_name() << " version 0 archive fitness failed!" << std::endl;
+				return 1;
+			}
+		}
+		std::cout << std::setw(40) << prob_loaded.get_name() << " version 0 archive passed." << std::endl;
+	}
+	// Binary data: once all the instances using the text data are gone, the binary file is mapped.
+	problem::cec2013::write_binary_data("./", dimension);
+	for (unsigned int id = 1; id <= 28; ++id) {
+		problem::cec2013 prob(id, dimension, "./");
+		for (unsigned int i = 0; i < n_points; ++i) {
+			if (fs[id - 1][i] != prob.objfun(xs[i])) {
+				std::cout << prob.get_name() << " binary data fitness failed!" << std::endl;
+				PRINT_VEC(fs[id - 1][i]);
+				PRINT_VEC(prob.objfun(xs[i]));
+				return 1;
+			}
+		}
+		std::cout << std::setw(40) << prob.get_name() << " binary data passed." << std::endl;
+	}
+	return 0;
+}
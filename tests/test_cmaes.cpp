@@ -0,0 +1,221 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the covariance models of CMA-ES
+
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <cstddef>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../src/pagmo.h"
+#include "test.h"
+
+using namespace pagmo;
+
+// Run cmaes on prob with the given covariance model, checking that the champion reaches the target fitness.
+int test_variant(const problem::base &prob, algorithm::cmaes::variant::type var, int gen, double sigma0, double target)
+{
+	algorithm::cmaes algo(gen,-1,-1,-1,-1,sigma0,1e-15,1e-15,true,var);
+	population pop(prob,20);
+	algo.evolve(pop);
+	std::cout << prob.get_name() << " (" << prob.get_dimension() << "), variant " << var << ": " << pop.champion().f[0] << std::endl;
+	if (!(pop.champion().f[0] < target)) {
+		std::cout << "target " << target << " not reached" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Calling evolve several times with memory must be equivalent to a single call.
+int test_memory(algorithm::cmaes::variant::type var)
+{
+	problem::rosenbrock prob(10);
+	population pop1(prob,20), pop2(pop1);
+	algorithm::cmaes algo1(50,-1,-1,-1,-1,0.5,1e-15,1e-15,true,var), algo2(algo1);
+	algo1.set_gen(100);
+	algo1.evolve(pop1);
+	algo2.evolve(pop2);
+	algo2.evolve(pop2);
+	if (pop1.champion().f != pop2.champion().f) {
+		std::cout << "memory is not preserved by variant " << var << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Restarts on a multimodal problem, using all the evaluation budget.
+int test_restart(algorithm::cmaes::restart::type rst)
+{
+	problem::rastrigin prob(10);
+	algorithm::cmaes algo(2000,-1,-1,-1,-1,0.5,1e-12,1e-12,false,algorithm::cmaes::variant::FULL,-1,rst,1);
+	population pop(prob,10);
+	const unsigned int fevals = pop.problem().get_fevals();
+	algo.evolve(pop);
+	const unsigned int n_evals = pop.problem().get_fevals() - fevals;
+	std::cout << "Rastrigin (10), restart " << rst << ": " << pop.champion().f[0] << ", " << n_evals << " evaluations" << std::endl;
+	if (pop.size() != 10 || n_evals > 2000 * 10 || n_evals < 2000 * 10 / 2) {
+		std::cout << "wrong population size or number of evaluations" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// The offspring evaluated on a pool of threads must give the same result as the serial evaluation.
+int test_threads(algorithm::cmaes::restart::type rst)
+{
+	problem::rastrigin prob(10);
+	population pop1(prob,10), pop2(pop1);
+	algorithm::cmaes algo1(500,-1,-1,-1,-1,0.5,1e-12,1e-12,false,algorithm::cmaes::variant::FULL,-1,rst,1), algo2(algo1);
+	algo2.set_threads(4);
+	algo1.evolve(pop1);
+	algo2.evolve(pop2);
+	if (pop1.champion().f != pop2.champion().f || pop1.get_individual(0).cur_x != pop2.get_individual(0).cur_x) {
+		std::cout << "parallel evaluation changes the result" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Stand-in writing the archive layout of cmaes before the covariance models were added (class version 0),
+// which stored the offspring as a vector of columns.
+struct cmaes_v0: algorithm::cmaes
+{
+	cmaes_v0(int gen, double sigma, int N, std::size_t lam):algorithm::cmaes(gen,-1,-1,-1,-1,sigma),
+		m_gen(gen),m_cc(-1),m_cs(-1),m_c1(-1),m_cmu(-1),m_sigma(sigma),m_xtol(1e-6),m_ftol(1e-6),m_memory(true),
+		m_mean(Eigen::VectorXd::Zero(N)),m_variation(Eigen::VectorXd::Zero(N)),m_newpop(lam,Eigen::VectorXd::Zero(N)),
+		m_B(Eigen::MatrixXd::Identity(N,N)),m_D(Eigen::MatrixXd::Identity(N,N)),m_C(Eigen::MatrixXd::Identity(N,N)),
+		m_invsqrtC(Eigen::MatrixXd::Identity(N,N)),m_pc(Eigen::VectorXd::Zero(N)),m_ps(Eigen::VectorXd::Zero(N)),
+		m_counteval(0),m_eigeneval(0) {}
+	template <class Archive>
+	void serialize(Archive &ar, const unsigned int)
+	{
+		ar & boost::serialization::base_object<algorithm::base>(*this);
+		ar & m_gen;
+		ar & m_cc;
+		ar & m_cs;
+		ar & m_c1;
+		ar & m_cmu;
+		ar & m_sigma;
+		ar & m_xtol;
+		ar & m_ftol;
+		ar & m_memory;
+		ar & m_mean;
+		ar & m_variation;
+		ar & m_newpop;
+		ar & m_B;
+		ar & m_D;
+		ar & m_C;
+		ar & m_invsqrtC;
+		ar & m_pc;
+		ar & m_ps;
+		ar & m_counteval;
+		ar & m_eigeneval;
+	}
+	std::size_t m_gen;
+	double m_cc, m_cs, m_c1, m_cmu, m_sigma, m_xtol, m_ftol;
+	bool m_memory;
+	Eigen::VectorXd m_mean, m_variation;
+	std::vector<Eigen::VectorXd> m_newpop;
+	Eigen::MatrixXd m_B, m_D, m_C, m_invsqrtC;
+	Eigen::VectorXd m_pc, m_ps;
+	int m_counteval, m_eigeneval;
+};
+
+// Archives of version 0 are loaded with the default covariance model, no restarts and one thread, and
+// the memory they store is used by the next call to evolve. The restart state of the loaded algorithm is reset.
+int test_archive_v0()
+{
+	problem::rosenbrock prob(10);
+	population pop1(prob,20), pop2(pop1), pop3(pop1);
+	std::stringstream ss_old, ss_new;
+	{
+		const cmaes_v0 algo_old(50,0.3,10,20);
+		boost::archive::text_oarchive oa(ss_old);
+		oa << algo_old;
+	}
+	const std::string archive_old = ss_old.str();
+	// An algorithm which has restarted with larger offspring sizes, with limited-memory evolution paths.
+	algorithm::cmaes algo_restarted(200,-1,-1,-1,-1,0.5,1e-3,1e-3,true,algorithm::cmaes::variant::LIMITED_MEMORY,-1,algorithm::cmaes::restart::BIPOP);
+	{
+		population pop(problem::rastrigin(10),20);
+		algo_restarted.evolve(pop);
+		std::istringstream ss(archive_old);
+		boost::archive::text_iarchive ia(ss);
+		ia >> algo_restarted;
+	}
+	algorithm::cmaes algo_loaded, algo_reloaded;
+	{
+		boost::archive::text_iarchive ia(ss_old);
+		ia >> algo_loaded;
+		boost::archive::text_oarchive oa(ss_new);
+		oa << algo_loaded;
+	}
+	{
+		boost::archive::text_iarchive ia(ss_new);
+		ia >> algo_reloaded;
+	}
+	if (algo_loaded.get_gen() != 50 || algo_loaded.get_sigma() != 0.3 || algo_loaded.get_variant() != algorithm::cmaes::variant::FULL ||
+		algo_loaded.get_restart() != algorithm::cmaes::restart::NONE || algo_loaded.get_threads() != 1)
+	{
+		std::cout << "version 0 archive: wrong parameters" << std::endl;
+		return 1;
+	}
+	algo_loaded.evolve(pop1);
+	algo_reloaded.evolve(pop2);
+	algo_restarted.evolve(pop3);
+	if (pop1.champion().f != pop2.champion().f || pop1.get_individual(0).cur_x != pop2.get_individual(0).cur_x) {
+		std::cout << "version 0 archive: the memory is not preserved" << std::endl;
+		return 1;
+	}
+	if (pop1.champion().f != pop3.champion().f || pop1.get_individual(0).cur_x != pop3.get_individual(0).cur_x) {
+		std::cout << "version 0 archive: the restart state is not reset" << std::endl;
+		return 1;
+	}
+	std::cout << "version 0 archive passed" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	int retval = 0;
+	retval |= test_variant(problem::dejong(10),algorithm::cmaes::variant::FULL,1000,0.5,1e-10);
+	retval |= test_variant(problem::dejong(10),algorithm::cmaes::variant::SEPARABLE,1000,0.5,1e-10);
+	retval |= test_variant(problem::dejong(10),algorithm::cmaes::variant::LIMITED_MEMORY,1000,0.5,1e-10);
+	// Large scale: the full variant would need a 2000 x 2000 covariance matrix and its eigen decomposition
+	// (the initial fitness is around 17000).
+	retval |= test_variant(problem::dejong(2000),algorithm::cmaes::variant::SEPARABLE,1000,0.05,2000);
+	retval |= test_variant(problem::dejong(2000),algorithm::cmaes::variant::LIMITED_MEMORY,1000,0.05,2000);
+	retval |= test_memory(algorithm::cmaes::variant::FULL);
+	retval |= test_memory(algorithm::cmaes::variant::SEPARABLE);
+	retval |= test_memory(algorithm::cmaes::variant::LIMITED_MEMORY);
+	retval |= test_restart(algorithm::cmaes::restart::IPOP);
+	retval |= test_restart(algorithm::cmaes::restart::BIPOP);
+	retval |= test_threads(algorithm::cmaes::restart::NONE);
+	retval |= test_threads(algorithm::cmaes::restart::BIPOP);
+	retval |= test_archive_v0();
+	return retval;
+}
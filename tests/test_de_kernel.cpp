@@ -0,0 +1,194 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the generation kernel of differential evolution and the algorithms using it
+
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/de_kernel.h"
+
+using namespace pagmo;
+
+// Mutation, crossover and bounds handling of the kernel, checked component by component.
+int test_kernel()
+{
+	const std::size_t NP = 20, D = 12, Dc = 10;
+	const decision_vector lb(D,-1), ub(D,1);
+	rng_double drng(42);
+	rng_uint32 urng(42);
+	util::de_kernel kernel(NP,lb,ub,Dc);
+	for (std::size_t i = 0; i < NP; ++i) {
+		decision_vector x(D);
+		for (std::size_t j = 0; j < D; ++j) {
+			x[j] = 2 * drng() - 1;
+		}
+		kernel.set_x(i,x);
+	}
+	kernel.set_best(decision_vector(D,0.5));
+	for (int variant = 1; variant <= 18; ++variant) {
+		const util::de_kernel::scheme &s = util::de_kernel::get_variant(variant);
+		const std::vector<const util::de_kernel::scheme *> schemes(NP,&s);
+		// With CR = 1 the whole continuous part comes from the mutant.
+		kernel.draw_members(7,urng);
+		kernel.make_trials(schemes,std::vector<double>(NP,0.1),std::vector<double>(NP,1),drng,urng);
+		for (std::size_t i = 0; i < NP; ++i) {
+			const decision_vector &t = kernel.get_trials()[i];
+			const double *b = (s.base == util::de_kernel::current) ? kernel.get_x(i) : ((s.base == util::de_kernel::best) ? 0 : kernel.get_x(kernel.member(i,s.base)));
+			for (std::size_t j = 0; j < D; ++j) {
+				if (t[j] < lb[j] || t[j] > ub[j]) {
+					std::cout << "variant " << variant << ": bounds FAILED" << std::endl;
+					return 1;
+				}
+				if (j >= Dc && t[j] != kernel.get_x(i)[j]) {
+					std::cout << "variant " << variant << ": integer part FAILED" << std::endl;
+					return 1;
+				}
+			}
+			// Check the mutant on the rand/1 variants, where it is within the bounds.
+			if (variant == 2 || variant == 7) {
+				const double *p = kernel.get_x(kernel.member(i,1)), *q = kernel.get_x(kernel.member(i,2));
+				for (std::size_t j = 0; j < Dc; ++j) {
+					const double v = b[j] + 0.1 * (p[j] - q[j]);
+					if (v >= lb[j] && v <= ub[j] && std::abs(t[j] - v) > 1E-15) {
+						std::cout << "variant " << variant << ": mutation FAILED" << std::endl;
+						return 1;
+					}
+				}
+			}
+		}
+		// With CR = 0 exactly one component comes from the mutant, the others from the donor.
+		for (std::size_t i = 0; i < NP; ++i) {
+			kernel.set_donor(i,(i + 1) % NP);
+		}
+		kernel.draw_members(7,urng);
+		kernel.make_trials(schemes,std::vector<double>(NP,0.1),std::vector<double>(NP,0),drng,urng);
+		for (std::size_t i = 0; i < NP; ++i) {
+			const decision_vector &t = kernel.get_trials()[i];
+			const double *d = kernel.get_x((i + 1) % NP);
+			unsigned int n = 0;
+			for (std::size_t j = 0; j < Dc; ++j) {
+				n += (t[j] != d[j]);
+			}
+			if (n > 1) {
+				std::cout << "variant " << variant << ": crossover FAILED" << std::endl;
+				return 1;
+			}
+		}
+		for (std::size_t i = 0; i < NP; ++i) {
+			kernel.set_donor(i,i);
+		}
+	}
+	std::cout << std::setw(40) << "kernel" << ": passed" << std::endl;
+	return 0;
+}
+
+// A single trial vector is built with the scheme of the batch ones, and leaves the other trials untouched.
+int test_single_trial()
+{
+	const std::size_t NP = 20, D = 12, Dc = 10;
+	const decision_vector lb(D,-1), ub(D,1);
+	rng_double drng(42);
+	rng_uint32 urng(42);
+	util::de_kernel kernel(NP,lb,ub,Dc);
+	for (std::size_t i = 0; i < NP; ++i) {
+		decision_vector x(D);
+		for (std::size_t j = 0; j < D; ++j) {
+			x[j] = 2 * drng() - 1;
+		}
+		kernel.set_x(i,x);
+	}
+	kernel.set_best(decision_vector(D,0.5));
+	const util::de_kernel::scheme &s = util::de_kernel::get_variant(7);
+	kernel.draw_members(5,urng);
+	kernel.make_trials(std::vector<const util::de_kernel::scheme *>(NP,&s),std::vector<double>(NP,0.1),std::vector<double>(NP,1),drng,urng);
+	const std::vector<decision_vector> trials = kernel.get_trials();
+	for (std::size_t i = 0; i < NP; i += 3) {
+		const decision_vector &t = kernel.make_trial(i,5,s,0.1,1,drng,urng);
+		const double *b = kernel.get_x(kernel.member(i,0)), *p = kernel.get_x(kernel.member(i,1)), *q = kernel.get_x(kernel.member(i,2));
+		for (std::size_t j = 0; j < D; ++j) {
+			const double v = b[j] + 0.1 * (p[j] - q[j]);
+			if (t[j] < lb[j] || t[j] > ub[j] || (j >= Dc && t[j] != kernel.get_x(i)[j]) ||
+				(j < Dc && v >= lb[j] && v <= ub[j] && std::abs(t[j] - v) > 1E-15))
+			{
+				std::cout << "single trial FAILED" << std::endl;
+				return 1;
+			}
+		}
+		for (std::size_t k = 0; k < NP; ++k) {
+			if (k % 3 && kernel.get_trials()[k] != trials[k]) {
+				std::cout << "single trial changed the other trials" << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << std::setw(40) << "single trial" << ": passed" << std::endl;
+	return 0;
+}
+
+// The algorithms must improve the population and use gen * NP evaluations.
+int test_algorithm(const algorithm::base &algo, const problem::base &prob, int gen)
+{
+	std::cout << std::setw(40) << algo.get_name() + " on " + prob.get_name() << ": ";
+	population pop(prob,20,42);
+	const double start = pop.champion().f[0];
+	const unsigned int fevals = pop.problem().get_fevals();
+	algorithm::base_ptr a = algo.clone();
+	a->reset_rngs(123);
+	a->evolve(pop);
+	if (!(pop.champion().f[0] < start)) {
+		std::cout << "FAILED" << std::endl;
+		return 1;
+	}
+	if (pop.problem().get_fevals() - fevals > static_cast<unsigned int>(gen * 20)) {
+		std::cout << "fevals FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << start << " -> " << pop.champion().f[0] << std::endl;
+	return 0;
+}
+
+int main()
+{
+	const problem::rastrigin rastrigin(10);
+	const problem::rosenbrock rosenbrock(10);
+	int retval = test_kernel() + test_single_trial();
+	for (int strategy = 1; strategy <= 10; ++strategy) {
+		retval += test_algorithm(algorithm::de(200,0.8,0.9,strategy,0,0),rastrigin,200);
+		retval += test_algorithm(algorithm::de_async(200,0.8,0.9,strategy,0,0,2),rastrigin,200);
+	}
+	for (int variant = 1; variant <= 18; ++variant) {
+		retval += test_algorithm(algorithm::jde(200,variant,1 + variant % 2,0,0),rosenbrock,200);
+	}
+	std::vector<int> variants;
+	for (int variant = 1; variant <= 18; ++variant) {
+		variants.push_back(variant);
+	}
+	retval += test_algorithm(algorithm::de_1220(200,1,variants,false,0,0),rastrigin,200);
+	retval += test_algorithm(algorithm::de_1220(200,2,variants,false,0,0),rastrigin,200);
+	retval += test_algorithm(algorithm::mde_pbx(200,0.15,1.5,0,0),rosenbrock,200);
+	return retval;
+}
@@ -0,0 +1,170 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the block generation of low-discrepancy sequences
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/discrepancy.h"
+
+using namespace pagmo;
+using namespace pagmo::util::discrepancy;
+
+// A block must contain the same points as the sequence generated one point at a time, for any number of threads.
+int test_block(base &seq, unsigned long long first, unsigned long long n, const std::string &name)
+{
+	const unsigned int dim = seq.get_dimension();
+	std::vector<double> block;
+	seq.generate(block, first, n);
+	for (unsigned long long k = 0; k < n; ++k) {
+		const std::vector<double> x = seq(static_cast<unsigned int>(first + k));
+		for (unsigned int i = 0; i < dim; ++i) {
+			if (x[i] != block[k * dim + i]) {
+				std::cout << name << ": point " << first + k << " differs from the block" << std::endl;
+				return 1;
+			}
+		}
+	}
+	for (unsigned int n_threads = 2; n_threads <= 5; ++n_threads) {
+		std::vector<double> block_mt;
+		seq.generate(block_mt, first, n, n_threads);
+		if (block_mt != block) {
+			std::cout << name << ": block generated with " << n_threads << " threads differs" << std::endl;
+			return 1;
+		}
+	}
+	// The block version of operator()() continues the sequence.
+	base_ptr tmp = seq.clone();
+	(*tmp)(static_cast<unsigned int>(first));
+	std::vector<double> next;
+	tmp->next_block(next, n - 1);
+	if (!std::equal(next.begin(), next.end(), block.begin() + dim) || (*tmp)() != seq(static_cast<unsigned int>(first + n))) {
+		std::cout << name << ": next_block does not continue the sequence" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Each of the first 2^m points of a (scrambled) Sobol sequence falls in a different interval [i / 2^m, (i + 1) / 2^m) in each dimension.
+// The same holds for each dimension of a latin hypercube of 2^m points.
+int test_strata(const base &seq, unsigned int m, const std::string &name)
+{
+	const unsigned int dim = seq.get_dimension(), n = 1u << m;
+	std::vector<double> block;
+	seq.generate(block, 0, n, 3);
+	for (unsigned int i = 0; i < dim; ++i) {
+		std::vector<int> count(n, 0);
+		for (unsigned int k = 0; k < n; ++k) {
+			const double x = block[k * dim + i];
+			if (x < 0 || x >= 1 || ++count[static_cast<unsigned int>(std::floor(x * n))] > 1) {
+				std::cout << name << ": dimension " << i << " is not stratified" << std::endl;
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+int test_sobol()
+{
+	int retval = 0;
+	sobol seq(7, 1);
+	retval |= test_block(seq, 0, 1000, "sobol");
+	retval |= test_block(seq, 65530, 20, "sobol");
+	// Skip-ahead beyond 32 bits.
+	std::vector<double> a, b;
+	seq.generate(a, (1ull << 40) + 3, 100);
+	seq.generate(b, (1ull << 40) - 5, 108, 4);
+	if (!std::equal(a.begin(), a.end(), b.begin() + 8 * 7) || b.back() < 0 || b.back() >= 1) {
+		std::cout << "sobol: skip-ahead differs from the sequential generation" << std::endl;
+		retval |= 1;
+	}
+	// The sequence must not wrap after 65535 points.
+	seq(65535);
+	const std::vector<double> next = seq();
+	if (next != seq(65536) || next == seq(0)) {
+		std::cout << "sobol: the sequence wraps after 65535 points" << std::endl;
+		retval |= 1;
+	}
+	retval |= test_strata(seq, 10, "sobol");
+	scrambled_sobol sseq(7, 0, 42);
+	retval |= test_block(sseq, 0, 1000, "scrambled_sobol");
+	retval |= test_strata(sseq, 10, "scrambled_sobol");
+	if (sseq(0) == seq(0)) {
+		std::cout << "scrambled_sobol: the sequence is not scrambled" << std::endl;
+		retval |= 1;
+	}
+	return retval;
+}
+
+int test_others()
+{
+	int retval = 0;
+	halton hseq(5, 1);
+	retval |= test_block(hseq, 1, 1000, "halton");
+	faure fseq(5, 1);
+	retval |= test_block(fseq, 1, 200, "faure");
+	simplex sseq(4, 1);
+	retval |= test_block(sseq, 1, 200, "simplex");
+	lhs lseq(6, 1024);
+	retval |= test_block(lseq, 0, 1000, "lhs");
+	retval |= test_strata(lseq, 10, "lhs");
+	return retval;
+}
+
+// A population initialised from a sampler contains the mapped points of the sequence.
+int test_population()
+{
+	problem::ackley prob(5);
+	sobol seq(5, 1);
+	population pop(prob, 64, seq);
+	sobol ref(5, 1);
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		const std::vector<double> u = ref();
+		for (unsigned int j = 0; j < 5; ++j) {
+			const double x = prob.get_lb()[j] + u[j] * (prob.get_ub()[j] - prob.get_lb()[j]);
+			if (std::abs(pop.get_individual(i).cur_x[j] - x) > 1e-12) {
+				std::cout << "population: individual " << i << " is not the mapped Sobol point" << std::endl;
+				return 1;
+			}
+		}
+	}
+	// The sampler is moved past the points used.
+	if (seq() != ref()) {
+		std::cout << "population: the sampler was not advanced" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int main()
+{
+	int retval = 0;
+	retval |= test_sobol();
+	retval |= test_others();
+	retval |= test_population();
+	return retval;
+}
@@ -0,0 +1,112 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the Monte-Carlo hypervolume approximations
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real.hpp>
+#include "../src/pagmo.h"
+#include "../src/util/hv_algorithm/bf_approx.h"
+#include "../src/util/hv_algorithm/bf_fpras.h"
+#include "../src/util/hv_algorithm/wfg.h"
+
+using namespace pagmo;
+
+// Random non-dominated points on the unit sphere.
+std::vector<fitness_vector> random_front(unsigned int n, unsigned int dim)
+{
+	boost::mt19937 rng(42);
+	boost::uniform_real<double> uni(0.0, 1.0);
+	std::vector<fitness_vector> points(n, fitness_vector(dim));
+	for (unsigned int i = 0; i < n; ++i) {
+		double norm = 0.0;
+		for (unsigned int j = 0; j < dim; ++j) {
+			points[i][j] = uni(rng);
+			norm += points[i][j] * points[i][j];
+		}
+		for (unsigned int j = 0; j < dim; ++j) {
+			points[i][j] /= std::sqrt(norm);
+		}
+	}
+	return points;
+}
+
+// FPRAS must be within its accuracy from the exact hypervolume, and give the same result for any number of threads.
+int test_fpras(unsigned int n, unsigned int dim)
+{
+	std::vector<fitness_vector> points = random_front(n, dim), points_cpy(points);
+	const fitness_vector r_point(dim, 1.1);
+	const double exact = util::hv_algorithm::wfg().compute(points_cpy, r_point);
+	const util::hv_algorithm::bf_fpras algo1(0.05, 0.01, 1), algo4(0.05, 0.01, 4);
+	points_cpy = points;
+	const double approx1 = util::hv_algorithm::bf_fpras(algo1).compute(points_cpy, r_point);
+	points_cpy = points;
+	const double approx4 = util::hv_algorithm::bf_fpras(algo4).compute(points_cpy, r_point);
+	std::cout << "bf_fpras, " << n << " points in " << dim << " dimensions: " << approx1 << " (exact " << exact << ")" << std::endl;
+	if (approx1 != approx4) {
+		std::cout << "result depends on the number of threads: " << approx4 << std::endl;
+		return 1;
+	}
+	if (std::fabs(approx1 - exact) > 0.05 * exact) {
+		std::cout << "approximation out of bounds" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// The approximated extreme contributors must match the exact ones, and not depend on the number of threads.
+int test_approx(unsigned int n, unsigned int dim)
+{
+	std::vector<fitness_vector> points = random_front(n, dim), points_cpy(points);
+	const fitness_vector r_point(dim, 1.1);
+	const std::vector<double> c = util::hv_algorithm::wfg().contributions(points_cpy, r_point);
+	const unsigned int lc = std::min_element(c.begin(), c.end()) - c.begin();
+	const unsigned int gc = std::max_element(c.begin(), c.end()) - c.begin();
+	for (unsigned int n_threads = 1; n_threads <= 4; n_threads *= 2) {
+		util::hv_algorithm::bf_approx algo(false, 1, 1e-2, 1e-6, 0.775, 0.2, 0.1, 0.25, n_threads);
+		points_cpy = points;
+		const unsigned int lc_approx = algo.least_contributor(points_cpy, r_point);
+		points_cpy = points;
+		const unsigned int gc_approx = algo.greatest_contributor(points_cpy, r_point);
+		if (lc_approx != lc || gc_approx != gc) {
+			std::cout << "bf_approx, " << n << " points in " << dim << " dimensions, " << n_threads << " threads: extreme contributors "
+				<< lc_approx << ", " << gc_approx << " instead of " << lc << ", " << gc << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+int main()
+{
+	int retval = 0;
+	retval |= test_fpras(20, 3);
+	retval |= test_fpras(50, 8);
+	retval |= test_approx(20, 3);
+	retval |= test_approx(30, 6);
+	return retval;
+}
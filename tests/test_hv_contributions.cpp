@@ -0,0 +1,114 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the exclusive contributions in three and four dimensions
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real.hpp>
+#include "../src/pagmo.h"
+#include "../src/util/hypervolume.h"
+#include "../src/util/hv_algorithm/hv3d.h"
+#include "../src/util/hv_algorithm/hv4d.h"
+#include "../src/util/hv_algorithm/wfg.h"
+
+using namespace pagmo;
+
+boost::mt19937 rng(42);
+
+// Random points on the unit sphere (non-dominated), or on a coarse grid (dominated points, duplicates and ties).
+std::vector<fitness_vector> random_points(unsigned int n, unsigned int dim, bool grid)
+{
+	boost::uniform_real<double> uni(0.0, 1.0);
+	std::vector<fitness_vector> points(n, fitness_vector(dim));
+	for (unsigned int i = 0; i < n; ++i) {
+		double norm = 0.0;
+		for (unsigned int j = 0; j < dim; ++j) {
+			points[i][j] = grid ? std::floor(uni(rng) * 5) / 5 : uni(rng);
+			norm += points[i][j] * points[i][j];
+		}
+		if (!grid) {
+			for (unsigned int j = 0; j < dim; ++j) {
+				points[i][j] /= std::sqrt(norm);
+			}
+		}
+	}
+	return points;
+}
+
+// Contributions by the given algorithm must match the ones by wfg.
+int test_contributions(const util::hv_algorithm::base &algo, unsigned int n, unsigned int dim, bool grid)
+{
+	std::vector<fitness_vector> points = random_points(n, dim, grid);
+	fitness_vector r_point(dim, 1.1);
+	std::vector<fitness_vector> points_cpy(points);
+	const double hv = util::hv_algorithm::wfg().compute(points_cpy, r_point);
+	points_cpy = points;
+	const std::vector<double> expected = util::hv_algorithm::wfg().contributions(points_cpy, r_point);
+	points_cpy = points;
+	const std::vector<double> c = algo.contributions(points_cpy, r_point);
+	for (unsigned int i = 0; i < n; ++i) {
+		if (std::fabs(c[i] - expected[i]) > 1e-10 * hv) {
+			std::cout << algo.get_name() << ", " << n << " points" << (grid ? " on a grid" : "") << ": contribution of point " << i
+				<< " is " << c[i] << " instead of " << expected[i] << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// The hypervolume object picks the dedicated algorithms for the least and the greatest contributors.
+int test_extreme_contributors(unsigned int dim)
+{
+	std::vector<fitness_vector> points = random_points(50, dim, false);
+	fitness_vector r_point(dim, 1.1);
+	util::hypervolume hv(points, false);
+	util::hv_algorithm::wfg algo;
+	if (hv.least_contributor(r_point) != hv.least_contributor(r_point, algo.clone()) ||
+		hv.greatest_contributor(r_point) != hv.greatest_contributor(r_point, algo.clone())) {
+		std::cout << "wrong extreme contributor in " << dim << " dimensions" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int main()
+{
+	int retval = 0;
+	for (unsigned int n = 1; n <= 100; n *= 10) {
+		for (int grid = 0; grid < 2; ++grid) {
+			retval |= test_contributions(util::hv_algorithm::hv3d(), n, 3, grid);
+			retval |= test_contributions(util::hv_algorithm::hv4d(), n, 4, grid);
+		}
+	}
+	retval |= test_contributions(util::hv_algorithm::hv3d(), 500, 3, false);
+	retval |= test_contributions(util::hv_algorithm::hv3d(), 500, 3, true);
+	retval |= test_extreme_contributors(3);
+	retval |= test_extreme_contributors(4);
+	return retval;
+}
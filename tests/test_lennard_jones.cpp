@@ -0,0 +1,104 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the pair kernel, the cell list and the gradient of the Lennard-Jones problem
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <vector>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Reference energy, by a scalar loop over all the pairs of atoms, with the potential truncated and shifted at rc (if positive).
+double reference_energy(const decision_vector &x, double rc)
+{
+	const int atoms = (x.size() + 6) / 3;
+	std::vector<double> p(3 * atoms,0.);
+	p[5] = x[0];
+	p[7] = x[1];
+	p[8] = x[2];
+	for (int i = 3; i < atoms; ++i) {
+		for (int c = 0; c < 3; ++c) {
+			p[3 * i + c] = x[3 * (i - 2) + c];
+		}
+	}
+	const double shift = rc > 0 ? std::pow(rc,-12) - std::pow(rc,-6) : 0;
+	double e = 0;
+	for (int i = 0; i < atoms - 1; ++i) {
+		for (int j = i + 1; j < atoms; ++j) {
+			const double r2 = std::pow(p[3 * i] - p[3 * j],2) + std::pow(p[3 * i + 1] - p[3 * j + 1],2) + std::pow(p[3 * i + 2] - p[3 * j + 2],2);
+			if (rc == 0 || r2 < rc * rc) {
+				e += std::pow(r2,-6) - std::pow(r2,-3) - shift;
+			}
+		}
+	}
+	return 4 * e;
+}
+
+int test_lennard_jones(int atoms, double rc)
+{
+	std::cout << std::setw(4) << atoms << " atoms, cutoff " << rc << ": ";
+	problem::lennard_jones prob(atoms,rc);
+	population pop(prob,5,42);
+	for (population::size_type k = 0; k < pop.size(); ++k) {
+		const decision_vector &x = pop.get_individual(k).cur_x;
+		const double f = prob.objfun(x)[0], f_ref = reference_energy(x,rc);
+		if (std::fabs(f - f_ref) > 1E-10 * std::max(1.,std::fabs(f_ref))) {
+			std::cout << "energy FAILED " << f << " " << f_ref << std::endl;
+			return 1;
+		}
+		// The gradient must agree with central differences.
+		decision_vector g, dx(x);
+		prob.objfun_gradient(g,x);
+		double err = 0, norm = 0;
+		for (decision_vector::size_type i = 0; i < x.size(); ++i) {
+			const double h = 1E-7 * std::max(1.,std::fabs(x[i]));
+			dx[i] = x[i] + h;
+			const double f_plus = reference_energy(dx,rc);
+			dx[i] = x[i] - h;
+			const double f_minus = reference_energy(dx,rc);
+			dx[i] = x[i];
+			err += std::pow(g[i] - (f_plus - f_minus) / (2 * h),2);
+			norm += g[i] * g[i];
+		}
+		if (std::sqrt(err) > 1E-5 * std::max(1.,std::sqrt(norm))) {
+			std::cout << "gradient FAILED " << std::sqrt(err) << " " << std::sqrt(norm) << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "passed" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_lennard_jones(5,0) +
+		test_lennard_jones(38,0) +
+		test_lennard_jones(150,0) +
+		test_lennard_jones(38,2.5) +
+		test_lennard_jones(150,2.5) +
+		test_lennard_jones(150,1.2);
+}
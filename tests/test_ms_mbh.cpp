@@ -0,0 +1,71 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the parallel starts of ms and the parallel chains of mbh
+
+#include <iostream>
+#include <iomanip>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Evolve a population with a copy of algo seeded with 123, starting from the same seed.
+population run(const algorithm::base &algo, const problem::base &prob)
+{
+	population pop(prob,8,42);
+	algorithm::base_ptr a = algo.clone();
+	a->reset_rngs(123);
+	a->evolve(pop);
+	return pop;
+}
+
+// With several threads, the results must not depend on their number. With any number of threads, the results
+// must not be worse than the starting population.
+int test_threads(const algorithm::base &serial, const algorithm::base &parallel1, const algorithm::base &parallel2, const problem::base &prob)
+{
+	std::cout << std::setw(40) << serial.get_name() + " on " + prob.get_name() << ": ";
+	const population start(prob,8,42), p0 = run(serial,prob), p1 = run(parallel1,prob), p2 = run(parallel2,prob);
+	for (population::size_type i = 0; i < p1.size(); ++i) {
+		if (p1.get_individual(i).cur_x != p2.get_individual(i).cur_x || p1.get_individual(i).cur_f != p2.get_individual(i).cur_f) {
+			std::cout << "threads FAILED" << std::endl;
+			return 1;
+		}
+	}
+	if (prob.compare_fitness(start.champion().f,p0.champion().f) || prob.compare_fitness(start.champion().f,p1.champion().f)) {
+		std::cout << "champion FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << start.champion().f[0] << " -> " << p0.champion().f[0] << ", " << p1.champion().f[0] << std::endl;
+	return 0;
+}
+
+int main()
+{
+	const problem::rastrigin rastrigin(10);
+	const problem::lennard_jones lj(5);
+	return test_threads(algorithm::ms(algorithm::de(50),10,1),algorithm::ms(algorithm::de(50),10,2),algorithm::ms(algorithm::de(50),10,4),rastrigin) +
+		test_threads(algorithm::ms(algorithm::cs(),10,1),algorithm::ms(algorithm::cs(),10,3),algorithm::ms(algorithm::cs(),10,2),lj) +
+		test_threads(algorithm::mbh(algorithm::cs(),5,0.05,4,1),algorithm::mbh(algorithm::cs(),5,0.05,4,2),algorithm::mbh(algorithm::cs(),5,0.05,4,4),rastrigin) +
+		test_threads(algorithm::mbh(algorithm::cs(),5,0.1,3,1),algorithm::mbh(algorithm::cs(),5,0.1,3,3),algorithm::mbh(algorithm::cs(),5,0.1,3,2),lj);
+}
@@ -0,0 +1,192 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the multi-objective utilities
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/multi_objective.h"
+
+using namespace pagmo;
+using namespace pagmo::util::multi_objective;
+
+// Random points in [0,1]^dim, with a few duplicates.
+std::vector<fitness_vector> random_points(size_type n, size_type dim, rng_double &drng)
+{
+	std::vector<fitness_vector> retval(n,fitness_vector(dim));
+	for (size_type i = 0; i < n; ++i) {
+		for (size_type j = 0; j < dim; ++j) {
+			retval[i][j] = drng();
+		}
+	}
+	for (size_type i = 0; i + 7 < n; i += 7) {
+		retval[i + 3] = retval[i];
+	}
+	return retval;
+}
+
+// The KD-tree must give the same k-th neighbour distances as a brute force search.
+int test_kd_tree(size_type n, size_type dim, rng_double &drng)
+{
+	const std::vector<fitness_vector> points = random_points(n,dim,drng);
+	const fitness_matrix f(points);
+	const kd_tree tree(f);
+	for (size_type i = 0; i < n; ++i) {
+		std::vector<double> d;
+		for (size_type j = 0; j < n; ++j) {
+			if (j != i) {
+				d.push_back(std::sqrt(f.distance2(i,j)));
+			}
+		}
+		std::sort(d.begin(),d.end());
+		for (size_type k = 1; k < n; k += 1 + k / 2) {
+			if (tree.kth_distance(i,k) != d[k - 1]) {
+				std::cout << "kd_tree FAILED on n=" << n << " dim=" << dim << std::endl;
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+// Reference truncation: remove repeatedly the first individual with the lexicographically smallest sorted distances.
+std::vector<size_type> reference_truncation(const fitness_matrix &f, size_type n)
+{
+	std::vector<size_type> alive;
+	for (size_type i = 0; i < f.size(); ++i) {
+		alive.push_back(i);
+	}
+	while (alive.size() > n) {
+		std::vector<std::vector<double> > d(alive.size());
+		for (size_type a = 0; a < alive.size(); ++a) {
+			for (size_type b = 0; b < alive.size(); ++b) {
+				if (a != b) {
+					d[a].push_back(f.distance2(alive[a],alive[b]));
+				}
+			}
+			std::sort(d[a].begin(),d[a].end());
+		}
+		alive.erase(alive.begin() + (std::min_element(d.begin(),d.end()) - d.begin()));
+	}
+	return alive;
+}
+
+int test_truncation(size_type n, size_type dim, size_type keep, rng_double &drng)
+{
+	const fitness_matrix f(random_points(n,dim,drng));
+	if (spea2_truncation(f,keep) != reference_truncation(f,keep)) {
+		std::cout << "spea2_truncation FAILED on n=" << n << " dim=" << dim << " keep=" << keep << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Pareto ranks must satisfy their recursive definition and the crowding distance must match its definition.
+int test_population(const problem::base &prob)
+{
+	population pop(prob,60,42);
+	pop.update_pareto_information();
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		population::size_type rank = 0;
+		bool dominated = false;
+		for (population::size_type j = 0; j < pop.size(); ++j) {
+			if (prob.compare_fc(pop.get_individual(j).best_f,pop.get_individual(j).best_c,pop.get_individual(i).best_f,pop.get_individual(i).best_c)) {
+				rank = std::max(rank,pop.get_pareto_rank(j));
+				dominated = true;
+			}
+		}
+		if (pop.get_pareto_rank(i) != (dominated ? rank + 1 : 0)) {
+			std::cout << "pareto rank FAILED on " << prob.get_name() << std::endl;
+			return 1;
+		}
+		double crowding_d = 0;
+		for (fitness_vector::size_type k = 0; k < prob.get_f_dimension(); ++k) {
+			const double fi = pop.get_individual(i).cur_f[k];
+			double lower = -std::numeric_limits<double>::max(), upper = std::numeric_limits<double>::max(), min = fi, max = fi;
+			for (population::size_type j = 0; j < pop.size(); ++j) {
+				if (pop.get_pareto_rank(j) != pop.get_pareto_rank(i)) {
+					continue;
+				}
+				const double fj = pop.get_individual(j).cur_f[k];
+				min = std::min(min,fj);
+				max = std::max(max,fj);
+				if (fj < fi || (fj == fi && j < i)) {
+					lower = std::max(lower,fj);
+				}
+				if (fj > fi || (fj == fi && j > i)) {
+					upper = std::min(upper,fj);
+				}
+			}
+			if (lower == -std::numeric_limits<double>::max() || upper == std::numeric_limits<double>::max()) {
+				crowding_d = std::numeric_limits<double>::max();
+				break;
+			}
+			crowding_d += (upper - lower) / (max - min);
+		}
+		if (std::abs(pop.get_crowding_d(i) - crowding_d) > 1e-12 * std::max(1.,crowding_d)) {
+			std::cout << "crowding distance FAILED on " << prob.get_name() << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// The algorithms must keep the size of the population and move it towards the Pareto front.
+int test_algorithm(const algorithm::base &algo, const problem::base &prob)
+{
+	population pop(prob,40,42);
+	const population start(pop);
+	algorithm::base_ptr a = algo.clone();
+	a->reset_rngs(123);
+	a->evolve(pop);
+	if (pop.size() != start.size() || pop.compute_pareto_fronts()[0].empty()) {
+		std::cout << algo.get_name() << " FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << std::setw(60) << algo.get_name() + " on " + prob.get_name() << ": " << start.compute_pareto_fronts()[0].size() << " -> " << pop.compute_pareto_fronts()[0].size() << " non-dominated" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	rng_double drng(42);
+	int retval = 0;
+	for (size_type dim = 1; dim <= 5; dim += 2) {
+		retval += test_kd_tree(2,dim,drng) + test_kd_tree(150,dim,drng);
+		retval += test_truncation(60,dim,20,drng) + test_truncation(30,dim,29,drng) + test_truncation(30,dim,1,drng);
+	}
+	retval += test_population(problem::zdt(1,10)) + test_population(problem::dtlz(2,10,3));
+	retval += test_algorithm(algorithm::spea2(20),problem::zdt(1,10)) + test_algorithm(algorithm::spea2(20,0.95,10,0.01,50,20),problem::dtlz(2,10,3)) +
+		test_algorithm(algorithm::nspso(20),problem::zdt(1,10)) + test_algorithm(algorithm::nspso(20,0.4,1.0,2.0,2.0,1.0,0.5,10,algorithm::nspso::NICHE_COUNT),problem::zdt(2,10)) +
+		test_algorithm(algorithm::vega(20),problem::zdt(1,10));
+	if (!retval) {
+		std::cout << "passed" << std::endl;
+	}
+	return retval;
+}
@@ -42,7 +42,9 @@ rng_uint32 rng_seed_provider;
 // noise_mean, noise_stddev: Params of the noise distribution
 // num_trials: How many samples to take for calculating the expected value of the noise a some point.
 // tol: Tolerance for the closeness
-int test_noisy(const std::vector<problem::base_ptr> & probs, double noise_mean, double noise_stddev, int num_trials, double tol)
+// sampling: Monte-Carlo sampling scheme of the meta-problem
+int test_noisy(const std::vector<problem::base_ptr> & probs, double noise_mean, double noise_stddev, int num_trials, double tol,
+	problem::base_stochastic::sampling_type sampling = problem::base_stochastic::SERIAL)
 {
 	
 	std::cout << "Start batch testing with noise_mean = " << noise_mean << " and " 
@@ -58,6 +60,7 @@ int test_noisy(const std::vector<problem::base_ptr> & probs, double noise_mean,
 										 noise_stddev,
 										 pagmo::problem::noisy::NORMAL,
 										 i*177 + 23);
+		prob_noisy.set_sampling(sampling);
 
 		std::cout<< std::setw(40) << prob_noisy.get_name();
 
@@ -124,7 +127,8 @@ int test_noisy(const std::vector<problem::base_ptr> & probs, double noise_mean,
 // Run the batch test by constructing noisy meta-problems against probs given the parameters.
 // Test similar to above, except that now the two noise params are interpreted as the lower
 // and upper bounds of the uniform noise. The sanity check is thus a bit different.
-int test_noisy_uniform(const std::vector<problem::base_ptr> & probs, double noise_lb, double noise_ub, int num_trials, double tol)
+int test_noisy_uniform(const std::vector<problem::base_ptr> & probs, double noise_lb, double noise_ub, int num_trials, double tol,
+	problem::base_stochastic::sampling_type sampling = problem::base_stochastic::SERIAL)
 {
 	
 	std::cout << "Start batch testing with noise_lb = " << noise_lb << " and " 
@@ -140,6 +144,7 @@ int test_noisy_uniform(const std::vector<problem::base_ptr> & probs, double nois
 										 noise_ub,
 										 pagmo::problem::noisy::UNIFORM,
 										 i*177 + 23);
+		prob_noisy.set_sampling(sampling);
 
 		std::cout<< std::setw(40) << prob_noisy.get_name();
 
@@ -208,5 +213,9 @@ int main()
 	return test_noisy(probs, 0.0, 0.1, 5000, 0.01) ||
 		   test_noisy(probs, 3.14, 0.1, 5000, 0.01) ||
 		   test_noisy_uniform(probs, 0.0, 0.1, 5000, 0.01) ||
-		   test_noisy_uniform(probs, -0.2, 0.2, 5000, 0.01);
+		   test_noisy_uniform(probs, -0.2, 0.2, 5000, 0.01) ||
+		   test_noisy(probs, 3.14, 0.1, 5000, 0.01, problem::base_stochastic::PARALLEL) ||
+		   test_noisy(probs, 3.14, 0.1, 5000, 0.01, problem::base_stochastic::SOBOL) ||
+		   test_noisy_uniform(probs, -0.2, 0.2, 5000, 0.01, problem::base_stochastic::PARALLEL) ||
+		   test_noisy_uniform(probs, -0.2, 0.2, 5000, 0.01, problem::base_stochastic::SOBOL);
 }
@@ -0,0 +1,107 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the batch evaluation of the swarm in pso and pso_generational
+
+#include <iostream>
+#include <iomanip>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Evolve a population with a copy of algo seeded with 123, starting from the same seed.
+population run(const algorithm::base &algo, const problem::base &prob)
+{
+	population pop(prob,20,42);
+	algorithm::base_ptr a = algo.clone();
+	a->reset_rngs(123);
+	a->evolve(pop);
+	return pop;
+}
+
+// The results must not depend on the number of threads, the known fitness written back must be the actual
+// fitness of the particles and the champion must not be worse than the starting one.
+int test_threads(const algorithm::base &serial, const algorithm::base &parallel, const problem::base &prob)
+{
+	std::cout << std::setw(40) << serial.get_name() + " on " + prob.get_name() << ": ";
+	const population start(prob,20,42), p1 = run(serial,prob), p4 = run(parallel,prob);
+	for (population::size_type i = 0; i < p1.size(); ++i) {
+		const population::individual_type &ind1 = p1.get_individual(i), &ind4 = p4.get_individual(i);
+		if (ind1.cur_x != ind4.cur_x || ind1.cur_f != ind4.cur_f || ind1.best_x != ind4.best_x || ind1.cur_v != ind4.cur_v) {
+			std::cout << "threads FAILED" << std::endl;
+			return 1;
+		}
+		if (ind1.cur_f != prob.objfun(ind1.cur_x) || ind1.best_f != prob.objfun(ind1.best_x)) {
+			std::cout << "fitness FAILED" << std::endl;
+			return 1;
+		}
+	}
+	if (prob.compare_fitness(start.champion().f,p1.champion().f)) {
+		std::cout << "champion FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << start.champion().f[0] << " -> " << p1.champion().f[0] << std::endl;
+	return 0;
+}
+
+// Setting the decision vectors with their known fitness must give the same population as evaluating them.
+int test_set_xs(const problem::base &prob)
+{
+	std::cout << std::setw(40) << "set_xs on " + prob.get_name() << ": ";
+	population p1(prob,20,42), p2(p1), donor(prob,20,43);
+	std::vector<decision_vector> xs;
+	std::vector<fitness_vector> fs;
+	for (population::size_type i = 0; i < donor.size(); ++i) {
+		xs.push_back(donor.get_individual(i).cur_x);
+		fs.push_back(donor.get_individual(i).cur_f);
+	}
+	p1.set_xs(xs);
+	p2.set_xs(xs,fs);
+	for (population::size_type i = 0; i < p1.size(); ++i) {
+		if (p1.get_individual(i).cur_f != p2.get_individual(i).cur_f || p1.get_individual(i).best_x != p2.get_individual(i).best_x ||
+			p1.get_domination_count(i) != p2.get_domination_count(i) || p1.get_domination_list(i) != p2.get_domination_list(i)) {
+			std::cout << "FAILED" << std::endl;
+			return 1;
+		}
+	}
+	if (p1.champion().x != p2.champion().x || p1.get_best_idx() != p2.get_best_idx()) {
+		std::cout << "champion FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << "passed" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	const problem::rastrigin rastrigin(10);
+	const problem::rosenbrock rosenbrock(10);
+	const problem::zdt zdt(1,10);
+	return test_set_xs(rastrigin) + test_set_xs(zdt) +
+		test_threads(algorithm::pso(30,0.7298,2.05,2.05,0.5,5,2,4,true,1),algorithm::pso(30,0.7298,2.05,2.05,0.5,5,2,4,true,4),rastrigin) +
+		test_threads(algorithm::pso(30,0.7298,2.05,2.05,0.5,6,1,4,true,1),algorithm::pso(30,0.7298,2.05,2.05,0.5,6,1,4,true,0),rosenbrock) +
+		test_threads(algorithm::pso(30),algorithm::pso(30,0.7298,2.05,2.05,0.5,5,2,4,false,4),rastrigin) +
+		test_threads(algorithm::pso_generational(30,0.7298,2.05,2.05,0.5,5,2,4,1),algorithm::pso_generational(30,0.7298,2.05,2.05,0.5,5,2,4,4),rastrigin) +
+		test_threads(algorithm::pso_generational(30,0.7298,2.05,2.05,0.5,1,4,4,1),algorithm::pso_generational(30,0.7298,2.05,2.05,0.5,1,4,4,0),rosenbrock);
+}
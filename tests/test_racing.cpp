@@ -32,6 +32,7 @@
 #include <numeric>
 
 #include "../src/pagmo.h"
+#include "../src/util/race_algo.h"
 #include "../src/util/race_pop.h"
 
 using namespace pagmo;
@@ -406,6 +407,40 @@ int test_race_pop_constructor(const problem::base_ptr& prob)
 	return 0;
 }
 
+/// Racing of algorithms must give the same outcome for any number of threads
+int test_race_algo_threads()
+{
+	std::cout << "Testing race_algo with several threads" << std::endl;
+
+	std::vector<algorithm::base_ptr> algos;
+	for(int gen = 1; gen <= 36; gen += 5){
+		algos.push_back(algorithm::de(gen).clone());
+	}
+	std::vector<problem::base_ptr> probs;
+	probs.push_back(problem::ackley(5).clone());
+	probs.push_back(problem::rosenbrock(5).clone());
+
+	std::pair<std::vector<unsigned int>, unsigned int> res_serial;
+	for(unsigned int n_threads = 1; n_threads <= 4; n_threads += 3){
+		race_algo race(algos, probs, 20, 123, n_threads);
+		std::pair<std::vector<unsigned int>, unsigned int> res = race.run(2, 2, 100, 0.05, std::vector<unsigned int>(), true, false);
+		if(n_threads == 1){
+			res_serial = res;
+		}
+		else if(res.first != res_serial.first || res.second != res_serial.second){
+			std::cout << "\tFAILED: the race with " << n_threads << " threads differs from the serial race" << std::endl;
+			return 1;
+		}
+	}
+	// The algorithm with the fewest generations cannot win
+	if(std::find(res_serial.first.begin(), res_serial.first.end(), 0u) != res_serial.first.end()){
+		std::cout << "\tFAILED: de with one generation won the race" << std::endl;
+		return 1;
+	}
+
+	std::cout << "\tPASSED race_algo with several threads." << std::endl;
+	return 0;
+}
 
 int main()
 {
@@ -446,5 +481,7 @@ int main()
 
 		   test_racing_get_mean_fitness(prob_ackley) ||
 
-		   test_race_pop_constructor(prob_ackley);
+		   test_race_pop_constructor(prob_ackley) ||
+
+		   test_race_algo_threads();
 }
@@ -68,12 +68,14 @@ const double EPS = 1e-8;
 
 // Test strategy:
 // Use white_box problem to probe and check if the perturbation is as expected
-int test_robust(unsigned int dim, unsigned int n_trials, double rho, unsigned int seed = 0)
+int test_robust(unsigned int dim, unsigned int n_trials, double rho, unsigned int seed = 0,
+	problem::base_stochastic::sampling_type sampling = problem::base_stochastic::SERIAL)
 {
-	std::cout << "[START] Testing robust meta-problem using white_box (rho = " << rho << ")" << std::endl;
+	std::cout << "[START] Testing robust meta-problem using white_box (rho = " << rho << ", sampling = " << sampling << ")" << std::endl;
 
 	problem::white_box prob_white_box(dim);
 	problem::robust robust_white_box(prob_white_box, n_trials, rho, seed);
+	robust_white_box.set_sampling(sampling);
 
 	const unsigned int num_points = 500;
 
@@ -141,5 +143,9 @@ int main()
 	return test_robust(10, 1, 0.001) ||
 		   test_robust(20, 1, 0.01) ||
 		   test_robust(30, 1, 0.1) ||
-		   test_robust(40, 5, 0.5);
+		   test_robust(40, 5, 0.5) ||
+		   test_robust(10, 1, 0.001, 0, problem::base_stochastic::PARALLEL) ||
+		   test_robust(40, 5, 0.5, 0, problem::base_stochastic::PARALLEL) ||
+		   test_robust(10, 1, 0.001, 0, problem::base_stochastic::SOBOL) ||
+		   test_robust(40, 5, 0.5, 0, problem::base_stochastic::SOBOL);
 }
@@ -92,6 +92,13 @@ int test_rotated(
 		}
 		std::cout << " bounds passed. ";
 
+		// Check that copies share the (immutable) rotation matrix
+		problem::base_ptr prob_copy = prob_rotated.clone();
+		if(&dynamic_cast<const problem::rotated &>(*prob_copy).get_rotation_matrix() != &prob_rotated.get_rotation_matrix()){
+			std::cout<<" sharing failed!"<<std::endl;
+			return 1;
+		}
+
 		decision_vector p_rotated_space = construct_test_point(prob_rotated.clone(), d_from_center);
 
 		// Obtain the corresponding point in the original space
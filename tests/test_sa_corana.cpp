@@ -0,0 +1,87 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the parallel tempering mode of sa_corana
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Evolve a population with n_chains chains on n_threads threads, starting from the same seeds.
+population run(const problem::base &prob, unsigned int n_chains, unsigned int n_threads)
+{
+	population pop(prob,8,42);
+	algorithm::sa_corana algo(20000,10,.01,1,20,1,n_chains,n_threads);
+	algo.reset_rngs(123);
+	algo.evolve(pop);
+	return pop;
+}
+
+int test_chains(const problem::base &prob)
+{
+	std::cout << std::setw(30) << prob.get_name() << ": ";
+	const population start(prob,8,42), single = run(prob,1,1), pt1 = run(prob,4,1), pt4 = run(prob,4,4);
+	// The chains must not depend on the number of threads running them.
+	for (population::size_type i = 0; i < pt1.size(); ++i) {
+		if (pt1.get_individual(i).cur_x != pt4.get_individual(i).cur_x) {
+			std::cout << "threads FAILED" << std::endl;
+			return 1;
+		}
+	}
+	// The evaluations of the chains, run on clones of the problem, are accounted for in the population problem
+	// (not exactly four times those of a single chain, as the evaluations hitting the cache are not counted).
+	if (pt1.problem().get_fevals() <= single.problem().get_fevals()) {
+		std::cout << "fevals FAILED" << std::endl;
+		return 1;
+	}
+	// Each chain writes back to its own slot, and no slot gets worse.
+	const std::vector<population::size_type> best = start.get_best_idx(4);
+	unsigned int improved = 0;
+	for (population::size_type i = 0; i < pt1.size(); ++i) {
+		if (prob.compare_fitness(start.get_individual(i).cur_f,pt1.get_individual(i).cur_f)) {
+			std::cout << "slot " << i << " FAILED" << std::endl;
+			return 1;
+		}
+		if (pt1.get_individual(i).cur_x != start.get_individual(i).cur_x) {
+			if (std::find(best.begin(),best.end(),i) == best.end()) {
+				std::cout << "slot " << i << " FAILED" << std::endl;
+				return 1;
+			}
+			++improved;
+		}
+	}
+	std::cout << "single chain " << single.champion().f[0] << ", 4 chains " << pt1.champion().f[0] << " (" << improved << " slots improved)" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_chains(problem::lennard_jones(5)) +
+		test_chains(problem::rastrigin(10)) +
+		test_chains(problem::ackley(10));
+}
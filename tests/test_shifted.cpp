@@ -158,6 +158,67 @@ int shifted_test4(){
 	return 0;
 }
 
+// Stack of affine meta-problems, evaluated through the fused transformation, against
+// the layer by layer transformation of the decision vector
+int shifted_test5(){
+	pagmo::problem::ackley prob(10);
+	pagmo::problem::shifted inner(prob, 1.5);
+	pagmo::problem::normalized norm(inner);
+	pagmo::problem::rotated rot(norm);
+	pagmo::problem::shifted outer(rot, -0.3);
+	pagmo::problem::rotated rot_outer(outer);
+	for (int k = 0; k < 20; ++k) {
+		decision_vector x(rot_outer.get_dimension());
+		for (unsigned int i = 0; i < x.size(); ++i) {
+			// Up to the relaxed bounds of the rotation, so that the projection is also tested
+			x[i] = (2 * ((double) rand() / (RAND_MAX)) - 1) * 1.4;
+		}
+		decision_vector y = inner.deshift(norm.denormalize(rot.derotate(outer.deshift(rot_outer.derotate(x)))));
+		fitness_vector f_expected = prob.objfun(y);
+		fitness_vector f_fused = rot_outer.objfun(x);
+		if(!is_eq_vector(f_fused, f_expected, EPS)){
+			std::cout<<rot_outer.get_name()<<" fitness failed!"<<std::endl;
+			PRINT_VEC(f_expected);
+			PRINT_VEC(f_fused);
+			return 1;
+		}
+		std::vector<fitness_vector> f_batch;
+		rot_outer.objfun_batch(f_batch, std::vector<decision_vector>(1, x));
+		if(!is_eq_vector(f_batch[0], f_expected, EPS)){
+			std::cout<<rot_outer.get_name()<<" batch fitness failed!"<<std::endl;
+			PRINT_VEC(f_expected);
+			PRINT_VEC(f_batch[0]);
+			return 1;
+		}
+	}
+	std::cout<<rot_outer.get_name()<<" fused stack passes."<<std::endl;
+	return 0;
+}
+
+// Copies of a meta-problem share its definition until one of them modifies it, while
+// the evaluation counters are private to each copy
+int shifted_test6(){
+	pagmo::problem::ackley prob(10);
+	pagmo::problem::shifted prob_shifted(prob, 1.5);
+	problem::base_ptr copy = prob_shifted.clone();
+	population pop(prob_shifted, 5);
+	if(&copy->get_lb() != &prob_shifted.get_lb() || &pop.problem().get_ub() != &prob_shifted.get_ub()){
+		std::cout<<prob_shifted.get_name()<<" copies do not share the bounds!"<<std::endl;
+		return 1;
+	}
+	if(prob_shifted.get_fevals() != 0 || pop.problem().get_fevals() != 5){
+		std::cout<<prob_shifted.get_name()<<" copies share the evaluation counters!"<<std::endl;
+		return 1;
+	}
+	copy->set_lb(0, 0.);
+	if(&copy->get_lb() == &prob_shifted.get_lb() || prob_shifted.get_lb()[0] != -13.5 || copy->get_lb()[0] != 0.){
+		std::cout<<prob_shifted.get_name()<<" modifying a copy changed the original!"<<std::endl;
+		return 1;
+	}
+	std::cout<<prob_shifted.get_name()<<" copies pass."<<std::endl;
+	return 0;
+}
+
 // Construct a test point in the new transformed space
 decision_vector construct_test_point(const problem::base_ptr &prob, double d_from_center)
 {
@@ -243,6 +304,8 @@ int main()
 		   shifted_test2() ||
 		   shifted_test3() ||
 		   shifted_test4() ||
+		   shifted_test5() ||
+		   shifted_test6() ||
 		   test_shifted(probs, 0.2, 999) ||
 		   test_shifted(probs, 0.2, -999) ||
 		   test_shifted(probs, -0.2, 0) ||
@@ -0,0 +1,127 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the batched ode integrator and the spheres problem
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/batch_rk.h"
+
+using namespace pagmo;
+
+// Harmonic oscillators with different pulsations: y0' = y1, y1' = -y2^2 y0, y2' = 0.
+struct oscillators: util::batch_rk::system
+{
+	void operator()(double *dydt, const double *y, std::size_t n, std::size_t stride) const
+	{
+		// The batch is compacted as the systems finish: the pulsation travels with the state.
+		for (std::size_t k = 0; k < n; ++k) {
+			dydt[k] = y[stride + k];
+			dydt[stride + k] = - y[2 * stride + k] * y[2 * stride + k] * y[k];
+			dydt[2 * stride + k] = 0;
+		}
+	}
+};
+
+// Integrate n oscillators together with the given tolerance, and compare with the analytical solution.
+int test_oscillators(double tol, double h, double max_err)
+{
+	std::cout << "batch_rk tol " << std::setw(8) << tol << ": ";
+	const std::size_t n = 7;
+	std::vector<double> w(n), y(3 * n);
+	for (std::size_t k = 0; k < n; ++k) {
+		w[k] = 0.5 + 0.3 * k;
+		y[k] = 1;
+		y[n + k] = 0;
+		y[2 * n + k] = w[k];
+	}
+	const util::batch_rk rk(3,tol,h);
+	const double tf = 10;
+	rk.integrate(oscillators(),y,n,0,tf);
+	double err = 0;
+	for (std::size_t k = 0; k < n; ++k) {
+		err = std::max(err,std::fabs(y[k] - std::cos(w[k] * tf)));
+		err = std::max(err,std::fabs(y[n + k] + w[k] * std::sin(w[k] * tf)));
+	}
+	// A single system integrated alone must follow the same steps as in the batch (up to the rounding
+	// differences between the vectorised and scalar loops).
+	std::vector<double> y_single(3);
+	y_single[0] = 1; y_single[1] = 0; y_single[2] = w[n - 1];
+	rk.integrate(oscillators(),y_single,1,0,tf);
+	if (err > max_err || std::fabs(y_single[0] - y[n - 1]) > 1E-12 || std::fabs(y_single[1] - y[2 * n - 1]) > 1E-12) {
+		std::cout << "FAILED, error " << err << std::endl;
+		return 1;
+	}
+	std::cout << "passed, error " << err << std::endl;
+	return 0;
+}
+
+int test_spheres()
+{
+	std::cout << "spheres: ";
+	problem::spheres prob(10,10,1E-6,123);
+	population pop(prob,3,42);
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		const decision_vector &x = pop.get_individual(i).cur_x;
+		const fitness_vector f = prob.objfun(x);
+		// Evaluation must be deterministic and survive copies.
+		problem::base_ptr p_copy = prob.clone();
+		if (!(std::fabs(f[0]) < 1E10) || p_copy->objfun(x) != f || prob.objfun(x) != f) {
+			std::cout << "objfun FAILED" << std::endl;
+			return 1;
+		}
+		// Simulating by intervals must reach the same final state as a single interval.
+		std::vector<double> ic(9);
+		for (int j = 0; j < 9; ++j) {
+			ic[j] = 0.1 * (j - 4);
+		}
+		const std::vector<std::vector<double> > t1 = prob.simulate(x,ic,1), t10 = prob.simulate(x,ic,10);
+		for (int j = 1; j < 10; ++j) {
+			if (std::fabs(t1.back()[j] - t10.back()[j]) > 1E-3) {
+				std::cout << "simulate FAILED" << std::endl;
+				return 1;
+			}
+		}
+	}
+	// The post evaluation returns the initial conditions sorted by fitness.
+	const std::vector<std::vector<double> > post = prob.post_evaluate(pop.get_individual(0).cur_x,20,7);
+	for (std::size_t i = 1; i < post.size(); ++i) {
+		if (post[i].back() < post[i - 1].back()) {
+			std::cout << "post_evaluate FAILED" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "passed" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_oscillators(1E-10,1E-6,1E-7) +
+		test_oscillators(0,1E-2,1E-9) +
+		test_spheres();
+}
@@ -0,0 +1,125 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the Monte-Carlo sampling schemes of the stochastic problems
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <vector>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+typedef problem::base_stochastic::sampling_type sampling_type;
+
+// Sample variance of the estimate of f at x (or of the difference f(x) - f(y) if y is not empty) over n_seeds seeds.
+double estimate_variance(const problem::base_stochastic &prob, const decision_vector &x, const decision_vector &y, unsigned int n_seeds)
+{
+	problem::base_ptr p = prob.clone();
+	problem::base_stochastic &sp = dynamic_cast<problem::base_stochastic &>(*p);
+	double mean = 0, mean2 = 0;
+	for (unsigned int s = 0; s < n_seeds; ++s) {
+		sp.set_seed(1000 + 17 * s);
+		double v = p->objfun(x)[0];
+		if (!y.empty()) {
+			v -= p->objfun(y)[0];
+		}
+		mean += v / n_seeds;
+		mean2 += v * v / n_seeds;
+	}
+	return (mean2 - mean * mean) * n_seeds / (n_seeds - 1);
+}
+
+// The estimates must not depend on the number of threads, nor on the order of the evaluations.
+int test_threads(const problem::base_stochastic &prob, sampling_type sampling)
+{
+	std::cout << std::setw(40) << prob.get_name() << " sampling " << sampling << ": threads";
+	problem::base_ptr p1 = prob.clone(), p4 = prob.clone();
+	dynamic_cast<problem::base_stochastic &>(*p1).set_sampling(sampling,true,1);
+	dynamic_cast<problem::base_stochastic &>(*p4).set_sampling(sampling,true,4);
+	population pop(prob,20,42);
+	std::vector<fitness_vector> f1;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		f1.push_back(p1->objfun(pop.get_individual(i).cur_x));
+	}
+	for (population::size_type i = pop.size(); i > 0; --i) {
+		if (p4->objfun(pop.get_individual(i - 1).cur_x) != f1[i - 1]) {
+			std::cout << " FAILED" << std::endl;
+			return 1;
+		}
+	}
+	// The sampling scheme must survive copies.
+	problem::base_ptr p4_copy = p4->clone();
+	if (dynamic_cast<problem::base_stochastic &>(*p4_copy).get_sampling() != sampling ||
+		dynamic_cast<problem::base_stochastic &>(*p4_copy).get_sampling_threads() != 4u ||
+		p4_copy->objfun(pop.get_individual(0).cur_x) != f1[0])
+	{
+		std::cout << " copy FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << " passed." << std::endl;
+	return 0;
+}
+
+// Sobol' sampling must reduce the variance of the estimates, common random numbers the variance of the
+// difference between the estimates at two close points.
+int test_variance(problem::base_stochastic &prob, const decision_vector &x, const decision_vector &y)
+{
+	std::cout << std::setw(40) << prob.get_name() << ": variance";
+	prob.set_sampling(problem::base_stochastic::PARALLEL,true);
+	const double var_parallel = estimate_variance(prob,x,decision_vector(),50);
+	const double var_diff_crn = estimate_variance(prob,x,y,50);
+	prob.set_sampling(problem::base_stochastic::PARALLEL,false);
+	const double var_diff_indep = estimate_variance(prob,x,y,50);
+	prob.set_sampling(problem::base_stochastic::SOBOL,true);
+	const double var_sobol = estimate_variance(prob,x,decision_vector(),50);
+	std::cout << " parallel " << var_parallel << ", sobol " << var_sobol << ", difference with crn " << var_diff_crn
+		<< ", difference without crn " << var_diff_indep;
+	if (!(var_sobol < var_parallel) || !(var_diff_crn < var_diff_indep)) {
+		std::cout << " FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << " passed." << std::endl;
+	return 0;
+}
+
+int main()
+{
+	problem::robust robust_ackley(problem::ackley(10),50,0.5,7);
+	problem::inventory inv(8,200,3);
+	problem::noisy noisy_ackley(problem::ackley(10),20,0.,1.,problem::noisy::NORMAL,5);
+
+	problem::robust robust_dejong(problem::dejong(5),64,1.,11);
+	problem::inventory inv_var(6,64,13);
+	decision_vector x_dejong(5,2.), y_dejong(5,2.1), x_inv(6,50.), y_inv(6,52.);
+
+	return test_threads(robust_ackley,problem::base_stochastic::PARALLEL) ||
+		test_threads(robust_ackley,problem::base_stochastic::SOBOL) ||
+		test_threads(inv,problem::base_stochastic::PARALLEL) ||
+		test_threads(inv,problem::base_stochastic::SOBOL) ||
+		test_threads(noisy_ackley,problem::base_stochastic::SOBOL) ||
+		test_variance(robust_dejong,x_dejong,y_dejong) ||
+		test_variance(inv_var,x_inv,y_inv);
+}
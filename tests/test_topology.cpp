@@ -0,0 +1,163 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the topology metrics and the bulk insertion of vertices
+
+#include <iostream>
+#include <cmath>
+#include <string>
+#include "../src/pagmo.h"
+#include "test.h"
+
+using namespace pagmo;
+
+const double EPS = 1E-9;
+
+// Check that all the edges of t are bidirectional, and that all vertices have at least min_deg adjacent vertices.
+int check_graph(const topology::base &t, const topology::base::vertices_size_type &n, const topology::base::edges_size_type &min_deg)
+{
+	if (t.get_number_of_vertices() != n) {
+		std::cout << t.get_name() << ": wrong number of vertices " << t.get_number_of_vertices() << " vs " << n << std::endl;
+		return 1;
+	}
+	for (topology::base::vertices_size_type i = 0; i < n; ++i) {
+		const std::vector<topology::base::vertices_size_type> adj = t.get_v_adjacent_vertices(i);
+		if (adj.size() < min_deg) {
+			std::cout << t.get_name() << ": vertex " << i << " has only " << adj.size() << " adjacent vertices" << std::endl;
+			return 1;
+		}
+		for (std::vector<topology::base::vertices_size_type>::size_type j = 0; j < adj.size(); ++j) {
+			if (adj[j] == i || !t.are_adjacent(adj[j],i)) {
+				std::cout << t.get_name() << ": invalid edge " << i << " -> " << adj[j] << std::endl;
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+// Compare the exact metrics with known values.
+int test_metrics()
+{
+	// Bidirectional ring of 10 vertices: distances from each vertex are 1,1,2,2,3,3,4,4,5.
+	topology::ring r;
+	r.push_back(10);
+	if (std::abs(r.get_average_shortest_path_length() - 25. / 9.) > EPS ||
+		std::abs(r.get_average_shortest_path_length(0,1) - 25. / 9.) > EPS ||
+		std::abs(r.get_clustering_coefficient()) > EPS)
+	{
+		std::cout << "wrong metrics for the ring: " << r.get_average_shortest_path_length() << ", " << r.get_clustering_coefficient() << std::endl;
+		return 1;
+	}
+	// Every vertex in a ring sees the same distances, so sampling must not change the result.
+	if (std::abs(r.get_average_shortest_path_length(3) - 25. / 9.) > EPS) {
+		std::cout << "wrong sampled path length for the ring: " << r.get_average_shortest_path_length(3) << std::endl;
+		return 1;
+	}
+	topology::fully_connected fc;
+	fc.push_back(8);
+	if (std::abs(fc.get_average_shortest_path_length() - 1.) > EPS ||
+		std::abs(fc.get_clustering_coefficient() - 1.) > EPS ||
+		std::abs(fc.get_clustering_coefficient(4,2) - 1.) > EPS)
+	{
+		std::cout << "wrong metrics for the fully connected topology: " << fc.get_average_shortest_path_length() << ", "
+			<< fc.get_clustering_coefficient() << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// The sampled metrics depend only on the seed, not on the number of threads or on the global rng.
+int test_seeded_sampling()
+{
+	topology::barabasi_albert ba(3,2);
+	ba.push_back(200);
+	const double apl = ba.get_average_shortest_path_length(20,1,42), cc = ba.get_clustering_coefficient(20,1,42);
+	ba.get_average_shortest_path_length(20);
+	ba.get_clustering_coefficient(20);
+	if (ba.get_average_shortest_path_length(20,1,42) != apl || std::abs(ba.get_average_shortest_path_length(20,4,42) - apl) > EPS ||
+		ba.get_clustering_coefficient(20,1,42) != cc || std::abs(ba.get_clustering_coefficient(20,4,42) - cc) > EPS)
+	{
+		std::cout << "sampled metrics depend on more than the seed" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Grow the topologies in bulk, on top of an existing part built one vertex at a time.
+int test_bulk()
+{
+	const topology::base::vertices_size_type n = 500;
+	topology::barabasi_albert ba(3,2);
+	topology::clustered_ba cba(3,2,0.5);
+	topology::ageing_clustered_ba acba(3,2,0.5,100);
+	topology::erdos_renyi er(0.05);
+	topology::watts_strogatz ws(4,0.1,0);
+	topology::base *tops[] = {&ba,&cba,&acba,&er,&ws};
+	const topology::base::edges_size_type min_deg[] = {2,1,0,0,2};
+	topology::base::edges_size_type kernel_edges = 0;
+	for (std::size_t i = 0; i < sizeof(tops) / sizeof(tops[0]); ++i) {
+		for (int j = 0; j < 5; ++j) {
+			tops[i]->push_back();
+			if (j == 2 && i == 0) {
+				kernel_edges = ba.get_number_of_edges();
+			}
+		}
+		tops[i]->push_back(n - 5);
+		if (check_graph(*tops[i],n,min_deg[i])) {
+			return 1;
+		}
+		std::cout << tops[i]->get_name() << ": " << tops[i]->get_number_of_edges() << " edges, average path length "
+			<< tops[i]->get_average_shortest_path_length(50) << ", clustering coefficient " << tops[i]->get_clustering_coefficient(50) << std::endl;
+	}
+	// Barabasi-Albert adds exactly m bidirectional edges per vertex after the kernel.
+	if (ba.get_number_of_edges() != kernel_edges + (n - 3) * 2 * 2) {
+		std::cout << "wrong number of edges for Barabasi-Albert: " << ba.get_number_of_edges() << std::endl;
+		return 1;
+	}
+	// Watts-Strogatz preserves the number of edges of the ring lattice.
+	if (ws.get_number_of_edges() != n * 4) {
+		std::cout << "wrong number of edges for Watts-Strogatz: " << ws.get_number_of_edges() << std::endl;
+		return 1;
+	}
+	// Erdos-Renyi with unitary probability is fully connected.
+	topology::erdos_renyi er1(1);
+	er1.push_back(20);
+	if (er1.get_number_of_edges() != 20 * 19) {
+		std::cout << "wrong number of edges for Erdos-Renyi: " << er1.get_number_of_edges() << std::endl;
+		return 1;
+	}
+	// Archipelagos pick up the bulk insertion when setting the topology.
+	archipelago a(algorithm::null(),problem::ackley(2),200,2,topology::barabasi_albert(3,2));
+	if (a.get_topology()->get_number_of_vertices() != 200) {
+		std::cout << "wrong number of vertices in the archipelago topology" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int main()
+{
+	return test_metrics() || test_seeded_sampling() || test_bulk();
+}